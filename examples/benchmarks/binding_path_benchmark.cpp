@@ -0,0 +1,213 @@
+/**
+ * @file binding_path_benchmark.cpp
+ * @brief 绑定路径解析与默认类型转换基准测试
+ *
+ * 模拟一个数据网格：每个单元格绑定到行对象的 "Quote.Price"（double → float）。
+ * 对比：
+ * - Legacy：原先的解析方式（每一段按名称查找访问器、经 std::function 调用 getter，
+ *   再由 TryDefaultConvert 逐个比较目标类型）
+ * - Current：Phase 5.1 的编译路径（缓存的访问器链 + RegisterMember 生成的类型化访问函数）
+ *   与 DefaultConverterCache
+ *
+ * 最后测量通过 BindingExpression::UpdateTarget 刷新整个网格的耗时，
+ * 并检查 TwoWay 写回能到达按值持有的源对象。
+ *
+ * 用法：binding_path_benchmark [单元格数量] [刷新次数]
+ */
+
+#include <fk/binding/BindingExpression.h>
+#include <fk/binding/BindingPath.h>
+#include <fk/binding/DependencyObject.h>
+#include <fk/binding/ValueConverters.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fk::binding;
+
+namespace {
+
+struct Quote {
+    double price{0.0};
+    std::string symbol;
+};
+
+struct Row {
+    std::shared_ptr<Quote> quote;
+
+    std::shared_ptr<Quote> GetQuote() const { return quote; }
+};
+
+// 按值放进 std::any 的源对象，用于检查写回
+struct Counter {
+    double value{1.0};
+};
+
+// 与 Row/Quote 结构相同，但通过原先的 lambda 接口注册
+struct LegacyQuote {
+    double price{0.0};
+};
+
+struct LegacyRow {
+    std::shared_ptr<LegacyQuote> quote;
+};
+
+void RegisterAccessors() {
+    PropertyAccessorRegistry::RegisterMember<&Row::GetQuote>("Quote");
+    PropertyAccessorRegistry::RegisterMember<&Quote::price>("Price");
+    PropertyAccessorRegistry::RegisterMember<&Counter::value>("Value");
+
+    PropertyAccessorRegistry::RegisterPropertyGetter<LegacyRow>("Quote",
+        [](const LegacyRow& row) { return row.quote; });
+    PropertyAccessorRegistry::RegisterProperty<LegacyQuote>("Price",
+        [](const LegacyQuote& quote) { return quote.price; },
+        [](LegacyQuote& quote, const std::any& value) { quote.price = std::any_cast<double>(value); });
+}
+
+// 原先 BindingPath::Resolve 的实现（只保留属性段）
+bool LegacyResolve(const BindingPath& path, const std::any& source, std::any& result) {
+    std::any current = source;
+    for (const auto& segment : path.Segments()) {
+        if (!current.has_value()) {
+            return false;
+        }
+        const auto* accessor = PropertyAccessorRegistry::FindAccessor(std::type_index(current.type()), segment.name);
+        if (!accessor || !accessor->getter) {
+            return false;
+        }
+        std::any nextValue;
+        if (!accessor->getter(current, nextValue)) {
+            return false;
+        }
+        current = std::move(nextValue);
+    }
+    result = current;
+    return true;
+}
+
+class Cell : public DependencyObject {
+public:
+    static const DependencyProperty& PriceProperty() {
+        static const auto& property = DependencyProperty::Register(
+            "Price", typeid(float), typeid(Cell), {0.0f});
+        return property;
+    }
+};
+
+volatile float g_sink = 0.0f;
+
+template<typename Fn>
+double MeasureNs(std::size_t count, int repeats, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (std::size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(count) * repeats);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t cellCount = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 5000;
+    const int refreshes = argc > 2 ? std::atoi(argv[2]) : 100;
+
+    RegisterAccessors();
+
+    std::vector<std::any> rows;
+    std::vector<std::any> legacyRows;
+    rows.reserve(cellCount);
+    legacyRows.reserve(cellCount);
+    for (std::size_t i = 0; i < cellCount; ++i) {
+        auto quote = std::make_shared<Quote>();
+        quote->price = static_cast<double>(i) * 0.25;
+        quote->symbol = "SYM" + std::to_string(i);
+        auto row = std::make_shared<Row>();
+        row->quote = quote;
+        rows.emplace_back(row);
+
+        auto legacyQuote = std::make_shared<LegacyQuote>();
+        legacyQuote->price = quote->price;
+        auto legacyRow = std::make_shared<LegacyRow>();
+        legacyRow->quote = legacyQuote;
+        legacyRows.emplace_back(legacyRow);
+    }
+
+    const std::type_index targetType(typeid(float));
+    std::printf("Binding path benchmark (%zu cells, %d refreshes)\n\n", cellCount, refreshes);
+
+    // ========== 路径解析 + 默认转换 ==========
+    const BindingPath legacyPath("Quote.Price");
+    const double legacyNs = MeasureNs(cellCount, refreshes, [&](std::size_t i) {
+        std::any value;
+        std::any converted;
+        if (LegacyResolve(legacyPath, legacyRows[i], value) && TryDefaultConvert(value, targetType, converted)) {
+            g_sink = std::any_cast<float>(converted);
+        }
+    });
+
+    const BindingPath currentPath("Quote.Price");
+    DefaultConverterCache converterCache;
+    const double currentNs = MeasureNs(cellCount, refreshes, [&](std::size_t i) {
+        std::any value;
+        std::any converted;
+        if (currentPath.Resolve(rows[i], value) && converterCache.Convert(value, targetType, converted)) {
+            g_sink = std::any_cast<float>(converted);
+        }
+    });
+
+    std::printf("resolve + convert  legacy %8.1f ns/cell   current %8.1f ns/cell   x%.2f\n",
+                legacyNs, currentNs, legacyNs / currentNs);
+
+    // ========== 通过 BindingExpression 刷新整个网格 ==========
+    std::vector<std::unique_ptr<Cell>> cells;
+    std::vector<std::shared_ptr<BindingExpression>> expressions;
+    cells.reserve(cellCount);
+    expressions.reserve(cellCount);
+    for (std::size_t i = 0; i < cellCount; ++i) {
+        auto cell = std::make_unique<Cell>();
+        Binding binding;
+        binding.Path("Quote.Price").Source(rows[i]);
+        cell->SetBinding(Cell::PriceProperty(), binding);
+        expressions.push_back(cell->GetBinding(Cell::PriceProperty()));
+        cells.push_back(std::move(cell));
+    }
+
+    // 每次刷新修改价格，使目标值真正变化
+    int refresh = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (refresh = 0; refresh < refreshes; ++refresh) {
+        for (std::size_t i = 0; i < cellCount; ++i) {
+            auto row = std::any_cast<std::shared_ptr<Row>>(rows[i]);
+            row->quote->price += 1.0;
+            expressions[i]->UpdateTarget();
+        }
+    }
+    const double refreshMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / refreshes;
+
+    const auto lastRow = std::any_cast<std::shared_ptr<Row>>(rows.back());
+    const float lastValue = cells.back()->GetValue<float>(Cell::PriceProperty());
+    const bool correct = lastValue == static_cast<float>(lastRow->quote->price);
+
+    std::printf("UpdateTarget grid  %8.3f ms/refresh (%.1f ns/cell)\n",
+                refreshMs, refreshMs * 1e6 / static_cast<double>(cellCount));
+    std::printf("target value       %s\n", correct ? "ok" : "MISMATCH");
+
+    // ========== TwoWay 写回按值持有的源 ==========
+    std::any valueSource = Counter{};
+    const BindingPath valuePath("Value");
+    const bool written = valuePath.SetValue(valueSource, std::any(5.0));
+    std::any readBack;
+    const bool writeBackOk = written && valuePath.Resolve(valueSource, readBack) &&
+                             std::any_cast<double>(readBack) == 5.0;
+    std::printf("value source write %s\n", writeBackOk ? "ok" : "FAILED");
+
+    return correct && writeBackOk ? 0 : 1;
+}
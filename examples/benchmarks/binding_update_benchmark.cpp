@@ -0,0 +1,186 @@
+/**
+ * @file binding_update_benchmark.cpp
+ * @brief 绑定更新合并基准测试
+ *
+ * 模拟行情界面：若干工作线程高频修改 ViewModel 的价格并触发 PropertyChanged，
+ * UI 线程以固定帧率处理 Dispatcher 任务。对比：
+ * - Immediate：原先的行为（每次通知立即在通知线程执行 UpdateTarget）
+ * - Coalesced：Phase 5.1 的 BindingUpdateQueue（封送到 UI 线程，每帧每个绑定最多更新一次）
+ * - Marshalled：ViewModel 使用 PropertyNotificationMode::Dispatcher，通知本身经无锁队列
+ *   封送到 UI 线程并按（对象，属性）合并，绑定在 UI 线程收到通知
+ *
+ * 报告生产者耗时、目标实际更新次数，以及最终目标值是否与源一致。
+ *
+ * 用法：binding_update_benchmark [绑定数量] [工作线程数] [每线程修改次数]
+ */
+
+#include <fk/binding/BindingExpression.h>
+#include <fk/binding/BindingUpdateQueue.h>
+#include <fk/binding/DependencyObject.h>
+#include <fk/binding/ObservableObject.h>
+#include <fk/binding/PropertyChangedMarshaller.h>
+#include <fk/core/Dispatcher.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace fk::binding;
+
+namespace {
+
+class QuoteViewModel : public ObservableObject {
+public:
+    explicit QuoteViewModel(PropertyNotificationMode mode) : ObservableObject(mode) {}
+
+    double GetPrice() const { return price_.load(std::memory_order_relaxed); }
+
+    void SetPrice(double price) {
+        price_.store(price, std::memory_order_relaxed);
+        RaisePropertyChanged(std::string_view("Price"));
+    }
+
+private:
+    std::atomic<double> price_{0.0};
+};
+
+class PriceCell : public DependencyObject {
+public:
+    static const DependencyProperty& PriceProperty() {
+        static const auto& property = DependencyProperty::Register(
+            "Price", typeid(double), typeid(PriceCell), {0.0});
+        return property;
+    }
+};
+
+struct Grid {
+    std::vector<std::shared_ptr<QuoteViewModel>> models;
+    std::vector<std::unique_ptr<PriceCell>> cells;
+    std::atomic<std::size_t> targetUpdates{0};
+
+    Grid(std::size_t count, PropertyNotificationMode mode) {
+        models.reserve(count);
+        cells.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto model = std::make_shared<QuoteViewModel>(mode);
+            auto cell = std::make_unique<PriceCell>();
+            Binding binding;
+            // 以接口类型作为源，BindingExpression 才能订阅 PropertyChanged
+            binding.Path("Price").Source(std::static_pointer_cast<INotifyPropertyChanged>(model));
+            cell->SetBinding(PriceCell::PriceProperty(), binding);
+            cell->PropertyChanged += [this](const DependencyProperty&, const std::any&, const std::any&, ValueSource, ValueSource) {
+                targetUpdates.fetch_add(1, std::memory_order_relaxed);
+            };
+            models.push_back(std::move(model));
+            cells.push_back(std::move(cell));
+        }
+    }
+
+    bool Consistent() const {
+        for (std::size_t i = 0; i < models.size(); ++i) {
+            if (cells[i]->GetValue<double>(PriceCell::PriceProperty()) != models[i]->GetPrice()) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void RegisterAccessors() {
+    PropertyAccessorRegistry::RegisterPropertyGetter<INotifyPropertyChanged>("Price",
+        [](const INotifyPropertyChanged& source) { return static_cast<const QuoteViewModel&>(source).GetPrice(); });
+}
+
+// 每个工作线程负责一部分行，轮流修改价格
+void RunProducers(Grid& grid, int threadCount, int ticksPerThread) {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&grid, t, threadCount, ticksPerThread]() {
+            const std::size_t count = grid.models.size();
+            for (int tick = 0; tick < ticksPerThread; ++tick) {
+                const std::size_t index = (static_cast<std::size_t>(tick) * threadCount + t) % count;
+                grid.models[index]->SetPrice(static_cast<double>(tick) + 0.5);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t bindingCount = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 1000;
+    const int threadCount = argc > 2 ? std::atoi(argv[2]) : 4;
+    const int ticksPerThread = argc > 3 ? std::atoi(argv[3]) : 200000;
+    const std::size_t notifications = static_cast<std::size_t>(threadCount) * ticksPerThread;
+
+    RegisterAccessors();
+    std::printf("Binding update benchmark (%zu bindings, %d producer threads, %zu notifications)\n\n",
+                bindingCount, threadCount, notifications);
+
+    // ========== Immediate：没有调度器时每次通知立即更新 ==========
+    // 原先的实现在通知线程上直接写目标；这里单线程生产以保持结果确定
+    {
+        Grid grid(bindingCount, PropertyNotificationMode::Direct);
+        grid.targetUpdates = 0;
+        auto start = std::chrono::steady_clock::now();
+        RunProducers(grid, 1, static_cast<int>(notifications));
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("immediate  %10.2f ms   target updates %10zu   %s\n",
+                    ms, grid.targetUpdates.load(), grid.Consistent() ? "consistent" : "MISMATCH");
+    }
+
+    // ========== UI 线程：约 240 Hz 的消息循环 ==========
+    auto dispatcher = std::make_shared<fk::core::Dispatcher>("UI");
+    dispatcher->BindToCurrentThread();
+    auto& queue = BindingUpdateQueue::Instance();
+    auto& marshaller = PropertyChangedMarshaller::Instance();
+    queue.SetDispatcher(dispatcher);
+    marshaller.SetDispatcher(dispatcher);
+
+    bool consistent = true;
+    auto runFrames = [&](const char* name, PropertyNotificationMode mode) {
+        Grid grid(bindingCount, mode);
+        grid.targetUpdates = 0;
+        std::atomic<bool> done{false};
+        double producerMs = 0.0;
+        std::thread producers([&]() {
+            auto start = std::chrono::steady_clock::now();
+            RunProducers(grid, threadCount, ticksPerThread);
+            producerMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            done = true;
+        });
+
+        std::size_t frames = 0;
+        while (!done.load()) {
+            dispatcher->ProcessPendingTasks();
+            ++frames;
+            std::this_thread::sleep_for(std::chrono::microseconds(4000));
+        }
+        producers.join();
+        // 处理剩余任务（通知投递后可能产生新的绑定更新）
+        while (dispatcher->ProcessPendingTasks() > 0) {
+        }
+        ++frames;
+
+        const bool ok = grid.Consistent();
+        consistent = consistent && ok;
+        std::printf("%-10s %10.2f ms   target updates %10zu   %s   (%zu frames)\n",
+                    name, producerMs, grid.targetUpdates.load(), ok ? "consistent" : "MISMATCH", frames);
+    };
+
+    // Coalesced：通知在工作线程触发，绑定更新由 BindingUpdateQueue 合并
+    runFrames("coalesced", PropertyNotificationMode::Direct);
+    // Marshalled：通知本身封送到 UI 线程并合并
+    runFrames("marshalled", PropertyNotificationMode::Dispatcher);
+
+    queue.SetDispatcher(nullptr);
+    marshaller.SetDispatcher(nullptr);
+    return consistent ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+/**
+ * @file dispatcher_benchmark.cpp
+ * @brief core::Dispatcher 跨线程投递基准测试
+ *
+ * N 个生产者线程同时向一个 Dispatcher 投递任务，调度线程运行 Run()。对比：
+ * - Legacy：原先的实现（一个互斥量保护 std::deque，每次投递都通知条件变量，
+ *   BeginInvoke 为每个操作 make_shared 一个带互斥量和条件变量的状态对象）
+ * - Current：Phase 5.1 的实现（按优先级的无锁环形队列、对象池分配的操作状态）
+ *
+ * 另外测试 PostDelayed：大量随机延迟的定时任务是否提前执行，并输出
+ * GetStatistics() 的队列深度与等待时间。执行顺序直接在 TimingWheel 上检查，
+ * 那里每个条目的到期时间由测试给定，而不是 PostDelayed 内部读取的时钟。
+ *
+ * 用法：dispatcher_benchmark [生产者线程数] [每线程任务数]
+ */
+
+#include <fk/core/Dispatcher.h>
+#include <fk/core/TimingWheel.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fk::core;
+using Clock = std::chrono::steady_clock;
+
+// 统计堆分配次数
+static std::atomic<std::size_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 原先 Dispatcher 的立即任务路径
+class LegacyDispatcher {
+public:
+    using Task = std::function<void()>;
+
+    struct OperationState {
+        std::atomic<int> status{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    void Post(Task task) { Enqueue(std::move(task), nullptr); }
+
+    std::shared_ptr<OperationState> BeginInvoke(Task task) {
+        auto state = std::make_shared<OperationState>();
+        Enqueue(std::move(task), state);
+        return state;
+    }
+
+    void Run() {
+        running_ = true;
+        while (running_.load()) {
+            QueuedTask task;
+            {
+                std::unique_lock lock(mutex_);
+                cv_.wait(lock, [this]() { return !tasks_.empty() || !running_.load(); });
+                if (tasks_.empty()) {
+                    continue;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task.task();
+            if (task.state) {
+                task.state->status.store(2);
+                task.state->cv.notify_all();
+            }
+        }
+    }
+
+    void Shutdown() {
+        running_ = false;
+        cv_.notify_one();
+    }
+
+private:
+    struct QueuedTask {
+        Task task;
+        std::shared_ptr<OperationState> state;
+        std::size_t sequence{0};
+    };
+
+    void Enqueue(Task task, std::shared_ptr<OperationState> state) {
+        {
+            std::lock_guard lock(mutex_);
+            tasks_.push_back(QueuedTask{std::move(task), std::move(state), sequence_++});
+        }
+        cv_.notify_one();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<QueuedTask> tasks_;
+    std::size_t sequence_{0};
+    std::atomic<bool> running_{false};
+};
+
+struct Result {
+    double producerMs;
+    double totalMs;
+    double allocationsPerTask;
+};
+
+// 启动调度线程与生产者线程，等待所有任务执行完毕
+template<typename DispatcherT, typename PostFn>
+Result RunProducers(DispatcherT& dispatcher, int producers, int tasksPerProducer, PostFn&& post) {
+    const long long total = static_cast<long long>(producers) * tasksPerProducer;
+    std::atomic<long long> remaining{total};
+    std::thread consumer([&]() { dispatcher.Run(); });
+
+    const std::size_t allocationsBefore = g_allocations.load();
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < tasksPerProducer; ++i) {
+                post(dispatcher, [&remaining]() { remaining.fetch_sub(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double producerMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    while (remaining.load(std::memory_order_relaxed) > 0) {
+        std::this_thread::yield();
+    }
+    const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    const double allocations = static_cast<double>(g_allocations.load() - allocationsBefore) / static_cast<double>(total);
+
+    dispatcher.Shutdown();
+    consumer.join();
+    return Result{producerMs, totalMs, allocations};
+}
+
+void Report(const char* name, const Result& legacy, const Result& current, long long total) {
+    std::printf("%-12s legacy  %8.2f ms total (%6.2f Mops/s)  producers %8.2f ms  %5.2f alloc/task\n",
+                name, legacy.totalMs, total / legacy.totalMs / 1000.0, legacy.producerMs, legacy.allocationsPerTask);
+    std::printf("%-12s current %8.2f ms total (%6.2f Mops/s)  producers %8.2f ms  %5.2f alloc/task   x%.2f\n",
+                "", current.totalMs, total / current.totalMs / 1000.0, current.producerMs, current.allocationsPerTask,
+                legacy.totalMs / current.totalMs);
+}
+
+void PrintStatistics(const Dispatcher& dispatcher) {
+    const auto stats = dispatcher.GetStatistics();
+    std::printf("             posted %llu  executed %llu  max depth %zu  avg latency %.1f us  max latency %.1f us\n",
+                static_cast<unsigned long long>(stats.posted), static_cast<unsigned long long>(stats.executed),
+                stats.maxQueueDepth, stats.averageLatency.count() / 1000.0, stats.maxLatency.count() / 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int producers = argc > 1 ? std::atoi(argv[1]) : 4;
+    const int tasksPerProducer = argc > 2 ? std::atoi(argv[2]) : 250000;
+    const long long total = static_cast<long long>(producers) * tasksPerProducer;
+
+    std::printf("Dispatcher benchmark (%d producers, %lld tasks)\n\n", producers, total);
+
+    // ========== Post ==========
+    {
+        LegacyDispatcher legacy;
+        auto legacyResult = RunProducers(legacy, producers, tasksPerProducer,
+            [](LegacyDispatcher& d, auto&& task) { d.Post(task); });
+        Dispatcher current("Bench");
+        auto currentResult = RunProducers(current, producers, tasksPerProducer,
+            [](Dispatcher& d, auto&& task) { d.Post(task); });
+        Report("Post", legacyResult, currentResult, total);
+        PrintStatistics(current);
+    }
+
+    // ========== BeginInvoke（每个任务一个操作状态） ==========
+    {
+        LegacyDispatcher legacy;
+        auto legacyResult = RunProducers(legacy, producers, tasksPerProducer,
+            [](LegacyDispatcher& d, auto&& task) { d.BeginInvoke(task); });
+        Dispatcher current("Bench");
+        auto currentResult = RunProducers(current, producers, tasksPerProducer,
+            [](Dispatcher& d, auto&& task) { d.BeginInvoke(task); });
+        Report("BeginInvoke", legacyResult, currentResult, total);
+        PrintStatistics(current);
+    }
+
+    // ========== 优先级：High 任务先于已排队的 Normal 任务执行 ==========
+    bool priorityOk = true;
+    {
+        Dispatcher dispatcher("Priority");
+        dispatcher.BindToCurrentThread();
+        std::vector<int> order;
+        dispatcher.Post([&]() { order.push_back(1); }, Dispatcher::Priority::Low);
+        dispatcher.Post([&]() { order.push_back(2); }, Dispatcher::Priority::Normal);
+        dispatcher.Post([&]() { order.push_back(3); }, Dispatcher::Priority::High);
+        dispatcher.ProcessPendingTasks();
+        priorityOk = order == std::vector<int>{3, 2, 1};
+        std::printf("\npriority order %s\n", priorityOk ? "ok" : "WRONG");
+    }
+
+    // ========== PostDelayed：时间轮 ==========
+    bool delayedOk = true;
+    {
+        constexpr int kTimers = 100000;
+        Dispatcher dispatcher("Timers");
+        dispatcher.BindToCurrentThread();
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> delay(0, 500);
+
+        // PostDelayed 内部自己读取时钟，存入时间轮的到期时间不早于投递前的 now + delay，
+        // 因此早于这个下界执行的任务一定提前了
+        std::vector<Clock::time_point> earliestDue(kTimers);
+        std::vector<DispatcherOperation> operations;
+        operations.reserve(kTimers);
+        int early = 0;
+        int fired = 0;
+
+        auto start = Clock::now();
+        for (int i = 0; i < kTimers; ++i) {
+            const auto ms = std::chrono::milliseconds(delay(rng));
+            earliestDue[i] = Clock::now() + ms;
+            operations.push_back(dispatcher.PostDelayed([&, i]() {
+                if (Clock::now() < earliestDue[i]) {
+                    ++early;
+                }
+                ++fired;
+            }, ms));
+        }
+        const double scheduleNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / kTimers;
+
+        // 取消十分之一
+        int canceled = 0;
+        for (int i = 0; i < kTimers; i += 10) {
+            if (operations[i].Cancel()) {
+                ++canceled;
+            }
+        }
+
+        while (fired + canceled < kTimers) {
+            dispatcher.WaitForEvents(std::chrono::milliseconds(50));
+            dispatcher.ProcessPendingTasks();
+        }
+        delayedOk = early == 0 && fired == kTimers - canceled;
+        std::printf("PostDelayed  %d timers: %.1f ns/schedule, fired %d, canceled %d, early %d\n",
+                    kTimers, scheduleNs, fired, canceled, early);
+        PrintStatistics(dispatcher);
+    }
+
+    // ========== TimingWheel：相同与相邻到期时间的执行顺序 ==========
+    bool wheelOrderOk = true;
+    {
+        using namespace std::chrono_literals;
+        const auto t0 = Clock::now();
+        TimingWheel<char> wheel(t0);
+        std::array<Clock::time_point, 128> dueOf{};
+        std::string order;
+        int wheelEarly = 0;
+        auto now = t0;
+        auto schedule = [&](char label, Clock::time_point due) {
+            dueOf[static_cast<std::size_t>(label)] = due;
+            wheel.Schedule(due, label);
+        };
+        auto advanceTo = [&](Clock::time_point until) {
+            while (now < until) {
+                now += 1ms;
+                wheel.Advance(now, [&](char label) {
+                    if (now < dueOf[static_cast<std::size_t>(label)]) {
+                        ++wheelEarly;
+                    }
+                    order.push_back(label);
+                });
+            }
+        };
+
+        schedule('A', t0 + 5ms);
+        schedule('B', t0 + 5ms);        // 与 A 相同：按加入顺序
+        schedule('C', t0 + 5ms - 1ns);  // 同一刻度、早 1ns：先于 A
+        schedule('D', t0 + 4ms);        // 前一刻度
+        schedule('E', t0 + 5ms + 1ns);  // 向上取整到下一刻度
+        schedule('F', t0 + 300ms);      // 先放在第 1 层，256ms 时下放
+        advanceTo(t0 + 100ms);
+        schedule('G', t0 + 300ms);      // 与 F 相同，但直接进第 0 层
+        advanceTo(t0 + 400ms);
+
+        wheelOrderOk = order == "DCABEFG" && wheelEarly == 0 && wheel.Empty();
+        std::printf("TimingWheel  equal/adjacent deadlines fired \"%s\" %s\n", order.c_str(), wheelOrderOk ? "ok" : "WRONG");
+    }
+
+    // ========== TimingWheel：随机到期时间，按 (到期时间, 序号) 检查每次执行 ==========
+    {
+        using namespace std::chrono_literals;
+        constexpr int kEntries = 100000;
+        const auto t0 = Clock::now();
+        TimingWheel<int> wheel(t0);
+        std::mt19937 rng(11);
+        // 毫秒 + 少量固定的亚毫秒偏移，制造大量相同和相邻的到期时间
+        std::uniform_int_distribution<int> delayMs(0, 600);
+        std::uniform_int_distribution<int> subMs(0, 3);
+        constexpr std::chrono::nanoseconds kSubOffsets[] = {0ns, 1ns, 500us, 999999ns};
+        std::vector<Clock::time_point> dueOf;
+        dueOf.reserve(kEntries);
+        auto now = t0;
+        auto schedule = [&]() {
+            // 排在当前时刻之后，保证与已执行的条目之间有确定的先后
+            const auto due = now + 1ms + std::chrono::milliseconds(delayMs(rng)) + kSubOffsets[subMs(rng)];
+            dueOf.push_back(due);
+            wheel.Schedule(due, static_cast<int>(dueOf.size() - 1));
+        };
+        for (int i = 0; i < kEntries / 2; ++i) {
+            schedule();
+        }
+
+        int fired = 0;
+        int early = 0;
+        int outOfOrder = 0;
+        int last = -1;
+        std::uniform_int_distribution<int> step(0, 3);
+        while (!wheel.Empty() || static_cast<int>(dueOf.size()) < kEntries) {
+            now += std::chrono::milliseconds(step(rng));
+            // 推进过程中继续加入，覆盖下放后与直接放入第 0 层的条目相遇的情况
+            for (int i = 0; i < 50 && static_cast<int>(dueOf.size()) < kEntries; ++i) {
+                schedule();
+            }
+            wheel.Advance(now, [&](int sequence) {
+                if (now < dueOf[sequence]) {
+                    ++early;
+                }
+                if (last >= 0 && (dueOf[sequence] < dueOf[last] || (dueOf[sequence] == dueOf[last] && sequence < last))) {
+                    ++outOfOrder;
+                }
+                last = sequence;
+                ++fired;
+            });
+        }
+        const bool ok = fired == kEntries && early == 0 && outOfOrder == 0;
+        wheelOrderOk = wheelOrderOk && ok;
+        std::printf("TimingWheel  %d entries: fired %d, early %d, out of order %d %s\n",
+                    kEntries, fired, early, outOfOrder, ok ? "ok" : "WRONG");
+    }
+
+    return priorityOk && delayedOk && wheelOrderOk ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file event_benchmark.cpp
+ * @brief core::Event 触发开销基准测试
+ *
+ * 对比三种实现在 0、1、8 个监听器时触发一次事件的耗时与堆分配次数：
+ * - Legacy：原先的实现（每次触发在读锁下复制整个监听器列表，包括每个 std::function）
+ * - Current：Phase 5.1 的写时复制实现（触发只增加一次引用计数）
+ * - SingleThreaded：Phase 5.1 的单线程模式（不加锁）
+ *
+ * 同时报告构造一个事件的分配次数（原先每个事件构造时都 make_shared 一次状态），
+ * 并检查监听器在触发过程中销毁事件所有者时一次性监听器仍被正确移除。
+ *
+ * 用法：event_benchmark [迭代次数]
+ */
+
+#include <fk/core/Event.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <shared_mutex>
+#include <vector>
+
+// 统计堆分配次数
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 原先 core::Event 的存储与触发路径（省略 Connection 与优先级插入）
+template<typename... Args>
+class LegacyEvent {
+public:
+    using Handler = std::function<void(Args...)>;
+
+    LegacyEvent() : state_(std::make_shared<State>()) {}
+
+    void Add(const Handler& handler) {
+        std::unique_lock lock(state_->mutex);
+        state_->listeners.push_back(ListenerEntry{nextId_++, 0, false, handler});
+    }
+
+    void operator()(Args... args) const {
+        std::vector<ListenerEntry> snapshot;
+        auto state = state_;
+        {
+            std::shared_lock lock(state->mutex);
+            snapshot = state->listeners;
+        }
+
+        std::vector<std::size_t> onceIds;
+        onceIds.reserve(snapshot.size());
+        for (const auto& entry : snapshot) {
+            if (entry.handler) {
+                entry.handler(args...);
+                if (entry.once) {
+                    onceIds.push_back(entry.id);
+                }
+            }
+        }
+    }
+
+private:
+    struct ListenerEntry {
+        std::size_t id;
+        int priority;
+        bool once;
+        Handler handler;
+    };
+
+    struct State {
+        mutable std::shared_mutex mutex;
+        std::vector<ListenerEntry> listeners;
+    };
+
+    std::shared_ptr<State> state_;
+    std::size_t nextId_{1};
+};
+
+struct Result {
+    double nsPerOp;
+    double allocationsPerOp;
+};
+
+template<typename Fn>
+Result Measure(int iterations, Fn&& fn) {
+    const std::size_t allocationsBefore = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return Result{
+        std::chrono::duration<double, std::nano>(elapsed).count() / iterations,
+        static_cast<double>(g_allocations - allocationsBefore) / iterations,
+    };
+}
+
+void Report(const char* name, const Result& legacy, const Result& current, const Result& single) {
+    std::printf("%-18s legacy %7.2f ns %5.2f alloc   current %7.2f ns %5.2f alloc   single-threaded %7.2f ns %5.2f alloc   x%.2f\n",
+                name, legacy.nsPerOp, legacy.allocationsPerOp,
+                current.nsPerOp, current.allocationsPerOp,
+                single.nsPerOp, single.allocationsPerOp, legacy.nsPerOp / single.nsPerOp);
+}
+
+// 防止编译器优化掉监听器
+volatile int g_sink = 0;
+
+void RunRaise(int iterations, int listenerCount) {
+    LegacyEvent<int, float> legacy;
+    fk::core::Event<int, float> current;
+    fk::core::Event<int, float> single(fk::core::EventThreading::SingleThreaded);
+
+    for (int i = 0; i < listenerCount; ++i) {
+        auto handler = [i](int value, float scale) { g_sink = g_sink + value * i + static_cast<int>(scale); };
+        legacy.Add(handler);
+        current.Add(handler);
+        single.Add(handler);
+    }
+
+    auto legacyResult = Measure(iterations, [&](int i) { legacy(i, 1.0f); });
+    auto currentResult = Measure(iterations, [&](int i) { current(i, 1.0f); });
+    auto singleResult = Measure(iterations, [&](int i) { single(i, 1.0f); });
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "raise (%d listeners)", listenerCount);
+    Report(name, legacyResult, currentResult, singleResult);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000000;
+
+    std::printf("core::Event benchmark (%d iterations)\n\n", iterations);
+
+    RunRaise(iterations, 0);
+    RunRaise(iterations, 1);
+    RunRaise(iterations, 8);
+
+    // 构造与析构：DependencyObject 每个实例都有三个事件，多数从未添加监听器
+    const int constructIterations = iterations / 4;
+    auto legacyConstruct = Measure(constructIterations, [&](int) {
+        LegacyEvent<int, float> event;
+        event(0, 0.0f);
+    });
+    auto currentConstruct = Measure(constructIterations, [&](int) {
+        fk::core::Event<int, float> event;
+        event(0, 0.0f);
+    });
+    auto singleConstruct = Measure(constructIterations, [&](int) {
+        fk::core::Event<int, float> event(fk::core::EventThreading::SingleThreaded);
+        event(0, 0.0f);
+    });
+    Report("construct + raise", legacyConstruct, currentConstruct, singleConstruct);
+
+    std::printf("\nsizeof: legacy %zu bytes, current %zu bytes\n",
+                sizeof(LegacyEvent<int, float>), sizeof(fk::core::Event<int, float>));
+
+    // 监听器销毁事件所有者，之后还要移除一次性监听器
+    struct Owner {
+        fk::core::Event<> closed;
+    };
+    auto* owner = new Owner();
+    int onceCalls = 0;
+    owner->closed.ConnectOnce([&]() { ++onceCalls; }).Disconnect();
+    auto onceConnection = owner->closed.ConnectOnce([&]() { ++onceCalls; });
+    owner->closed += [&]() { delete owner; owner = nullptr; };
+    owner->closed();
+    const bool selfDestructOk = owner == nullptr && onceCalls == 1 && !onceConnection.IsConnected();
+    std::printf("owner destroyed in handler: %s\n", selfDestructOk ? "ok" : "FAILED");
+    return selfDestructOk ? 0 : 1;
+}
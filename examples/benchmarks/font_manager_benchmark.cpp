@@ -0,0 +1,173 @@
+/**
+ * @file font_manager_benchmark.cpp
+ * @brief FontManager 字体索引与回退链基准测试
+ *
+ * - Startup：冷启动（无磁盘缓存，逐个文件用 FreeType 读取）与热启动（读取磁盘缓存，
+ *   只比较文件大小与修改时间）建立索引的耗时
+ * - Resolve：(字体族, 字重, 样式) 解析的单次耗时，对比旧实现每次拼接 "字体族_字号" 键
+ *   查找字符串哈希表
+ * - Fallback：按码位块解析好的回退字体查找字符所在字体，对比逐个字体调用 FT_Get_Char_Index
+ *
+ * 耗时与构建配置关系很大，输出第一行注明是否为优化构建（NDEBUG）。
+ *
+ * 用法：font_manager_benchmark [查找次数]
+ */
+
+#include "fk/render/FontManager.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace fk::render;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 拉丁、西里尔、希腊、符号、CJK、emoji 混合的测试字符
+const std::vector<char32_t>& SampleCodepoints() {
+    static const std::vector<char32_t> codepoints = {
+        U'A', U'z', U'0', U'é', U'Ж', U'Ω', U'→', U'€', U'∑', U'█', U'中', U'文', U'あ', U'한', U'😀', U'✓',
+    };
+    return codepoints;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int lookups = argc > 1 ? std::atoi(argv[1]) : 1000000;
+#ifdef NDEBUG
+    const char* buildConfig = "NDEBUG";
+#else
+    const char* buildConfig = "assertions enabled, not a release build";
+#endif
+    std::printf("Font manager benchmark (%d lookups, %s)\n\n", lookups, buildConfig);
+    bool ok = true;
+
+    auto& manager = FontManager::Instance();
+    const std::string cachePath =
+        (std::filesystem::temp_directory_path() / "fk_font_manager_benchmark.bin").string();
+    std::filesystem::remove(cachePath);
+    manager.SetCachePath(cachePath);
+
+    // ========== Startup：冷启动与缓存热启动 ==========
+    manager.Initialize();
+    const auto cold = manager.GetStatistics();
+    manager.Rescan();
+    manager.Initialize();
+    const auto warm = manager.GetStatistics();
+    ok = ok && cold.faces > 0 && warm.faces == cold.faces && warm.filesScanned == 0;
+    std::printf("Startup    cold %8.3f ms (%zu files scanned), cached %8.3f ms (%zu files scanned)\n",
+                cold.scanMilliseconds, cold.filesScanned, warm.scanMilliseconds, warm.filesScanned);
+    std::printf("           %zu faces in %zu families from %zu files\n", warm.faces, warm.families, warm.files);
+    if (warm.faces == 0) {
+        std::printf("No fonts found\n");
+        return 1;
+    }
+
+    // ========== Resolve：O(1) 样式槽 ==========
+    const char* families[] = {"sans-serif", "Segoe UI", "monospace", "serif"};
+    const int weights[] = {400, 700, 300, 900};
+    FontFaceId sink = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        sink += manager.Resolve(families[i & 3], weights[(i >> 2) & 3], (i & 16) != 0);
+    }
+    const double resolveNs = ElapsedMs(start) * 1e6 / lookups;
+
+    // 旧实现：每次拼接键再查找字符串哈希表
+    std::unordered_map<std::string, int> stringCache;
+    start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        const std::string key = std::string(families[i & 3]) + "_" + std::to_string(14 + (i & 7));
+        auto [it, inserted] = stringCache.try_emplace(key, i);
+        sink += it->second;
+    }
+    const double stringNs = ElapsedMs(start) * 1e6 / lookups;
+    std::printf("Resolve    %8.1f ns/call (string key lookup %8.1f ns/call)\n", resolveNs, stringNs);
+
+    const auto* regular = manager.GetFace(manager.Resolve("sans-serif"));
+    const auto* bold = manager.GetFace(manager.Resolve("sans-serif", 700));
+    if (regular && bold) {
+        std::printf("           sans-serif -> %s (%u), bold -> %s (%u)\n", regular->path.c_str(), regular->weight,
+                    bold->path.c_str(), bold->weight);
+    }
+
+    // ========== Fallback：回退链与逐个字体探测 ==========
+    const FontFaceId primary = manager.Resolve("sans-serif");
+    const auto& samples = SampleCodepoints();
+    start = Clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        sink += manager.FindFaceForCodepoint(samples[i % samples.size()], primary);
+    }
+    const double chainNs = ElapsedMs(start) * 1e6 / lookups;
+
+    // 逐个打开的字体调用 FT_Get_Char_Index（旧的回退方式，字体已全部打开，下标即 FontFaceId）
+    FT_Library library = nullptr;
+    FT_Init_FreeType(&library);
+    std::vector<FT_Face> faces;
+    for (FontFaceId id = 0; manager.GetFace(id); ++id) {
+        const auto* info = manager.GetFace(id);
+        FT_Face face = nullptr;
+        if (FT_New_Face(library, info->path.c_str(), info->faceIndex, &face) != 0) {
+            face = nullptr;
+        }
+        faces.push_back(face);
+    }
+    auto hasChar = [&](FontFaceId id, char32_t c) {
+        return id >= 0 && faces[static_cast<std::size_t>(id)] &&
+               FT_Get_Char_Index(faces[static_cast<std::size_t>(id)], c) != 0;
+    };
+
+    // 回退链的结果必须与逐个探测一致：都找不到，或找到的字体确实包含该字符
+    std::size_t mismatches = 0;
+    for (char32_t c : samples) {
+        bool anyFace = false;
+        for (FontFaceId id = 0; id < static_cast<FontFaceId>(faces.size()) && !anyFace; ++id) {
+            anyFace = hasChar(id, c);
+        }
+        const FontFaceId chained = manager.FindFaceForCodepoint(c, -1);
+        if (anyFace != (chained >= 0) || (chained >= 0 && !hasChar(chained, c))) {
+            ++mismatches;
+        }
+    }
+    start = Clock::now();
+    const int probeLookups = lookups / 10 + 1;
+    for (int i = 0; i < probeLookups; ++i) {
+        const char32_t c = samples[i % samples.size()];
+        for (FontFaceId id = 0; id < static_cast<FontFaceId>(faces.size()); ++id) {
+            if (hasChar(id, c)) {
+                sink += id;
+                break;
+            }
+        }
+    }
+    const double probeNs = ElapsedMs(start) * 1e6 / probeLookups;
+    for (FT_Face face : faces) {
+        if (face) {
+            FT_Done_Face(face);
+        }
+    }
+    FT_Done_FreeType(library);
+
+    ok = ok && mismatches == 0;
+    std::printf("Fallback   %8.1f ns/lookup via block tables, %8.1f ns/lookup probing %zu faces\n", chainNs, probeNs,
+                faces.size());
+    std::printf("           coverage agrees with FreeType for %zu/%zu sample characters\n",
+                samples.size() - mismatches, samples.size());
+
+    std::filesystem::remove(cachePath);
+    std::printf("\n(checksum %d)\n", sink);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file headless_render_benchmark.cpp
+ * @brief 无头渲染帧耗时基准与像素对比回归检查
+ *
+ * 在无头窗口（SoftwareRenderer，不需要显示设备和 GPU）中构建一个包含
+ * Border、StackPanel、TextBlock 和各类 Shape 的界面，分别测量：
+ * - 整帧重绘：每帧切换窗口背景色，强制整帧重绘
+ * - 增量重绘：每帧只修改一个 TextBlock 的文本，只重绘损坏区域
+ *
+ * 用法：headless_render_benchmark [帧数] [--save 输出.png] [--golden 基准.png] [--tolerance N]
+ *
+ * 指定 --golden 时，将首帧与基准图像逐像素比较（单通道容差默认为 2），
+ * 不一致时返回非零退出码，可直接作为 CI 中的回归检查。
+ */
+
+#include "fk/ui/Window.h"
+#include "fk/ui/controls/Border.h"
+#include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/text/TextBlock.h"
+#include "fk/ui/graphics/Shape.h"
+#include "fk/ui/graphics/Brush.h"
+#include "fk/render/SoftwareRenderer.h"
+
+#include "stb_image.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fk::ui;
+
+namespace {
+
+struct Options {
+    int frames{200};
+    std::string savePath;
+    std::string goldenPath;
+    int tolerance{2};
+};
+
+Options ParseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            options.savePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            options.goldenPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            options.tolerance = std::atoi(argv[++i]);
+        } else {
+            options.frames = std::max(1, std::atoi(argv[i]));
+        }
+    }
+    return options;
+}
+
+// 构建测试界面，返回每帧修改文本的 TextBlock
+TextBlock* BuildScene(Window& window) {
+    auto* root = new StackPanel();
+    root->SetOrient(Orientation::Vertical)->Spacing(12.0f)->Margin(16.0f);
+
+    auto* title = new TextBlock();
+    title->Text("Headless render benchmark")
+         ->FontSize(24.0f)
+         ->Foreground(new SolidColorBrush(Color::FromRGB(20, 20, 20, 255)));
+    root->AddChild(title);
+
+    auto* counter = new TextBlock();
+    counter->Text("Frame 0")
+           ->FontSize(16.0f)
+           ->Foreground(new SolidColorBrush(Color::FromRGB(200, 40, 40, 255)));
+    root->AddChild(counter);
+
+    // 一排带圆角和描边的卡片
+    auto* cards = new StackPanel();
+    cards->SetOrient(Orientation::Horizontal)->SetSpacing(10.0f);
+    for (int i = 0; i < 6; ++i) {
+        auto* card = new Border();
+        card->SetBackground(new SolidColorBrush(Color::FromRGB(
+            static_cast<std::uint8_t>(60 + i * 30), 140, static_cast<std::uint8_t>(220 - i * 25), 255)));
+        card->SetBorderBrush(new SolidColorBrush(Color::FromRGB(30, 30, 60, 255)));
+        card->SetBorderThickness(Thickness(2));
+        card->SetCornerRadius(CornerRadius(8));
+        card->SetPadding(Thickness(8));
+        card->SetWidth(110);
+        card->SetHeight(70);
+
+        auto* label = new TextBlock();
+        label->Text("Card " + std::to_string(i + 1))
+             ->FontSize(14.0f)
+             ->Foreground(new SolidColorBrush(Color::FromRGB(255, 255, 255, 255)));
+        card->SetChild(label);
+        cards->AddChild(card);
+    }
+    root->AddChild(cards);
+
+    // 形状：矩形、椭圆、多边形、路径（含圆弧和贝塞尔曲线）
+    auto* shapes = new StackPanel();
+    shapes->SetOrient(Orientation::Horizontal)->SetSpacing(16.0f);
+
+    auto* rectangle = new Rectangle();
+    rectangle->RadiusX(12)->RadiusY(6);
+    rectangle->Width(120)->Height(80);
+    rectangle->Fill(new SolidColorBrush(Color::FromRGB(250, 200, 80, 255)))
+             ->Stroke(new SolidColorBrush(Color::FromRGB(120, 80, 0, 255)))
+             ->StrokeThickness(3.0f);
+    shapes->AddChild(rectangle);
+
+    auto* ellipse = new Ellipse();
+    ellipse->Width(100)->Height(80);
+    ellipse->Fill(new SolidColorBrush(Color::FromRGB(120, 200, 120, 255)))
+           ->Stroke(new SolidColorBrush(Color::FromRGB(20, 90, 20, 255)))
+           ->StrokeThickness(2.0f);
+    shapes->AddChild(ellipse);
+
+    auto* polygon = new Polygon();
+    polygon->Points({Point(50, 0), Point(100, 80), Point(0, 80)});
+    polygon->Width(100)->Height(80);
+    polygon->Fill(new SolidColorBrush(Color::FromRGB(90, 120, 230, 255)));
+    shapes->AddChild(polygon);
+
+    auto* path = new Path();
+    path->Width(160)->Height(80);
+    path->MoveTo(10, 70)
+        ->ArcTo(Point(90, 70), 40, 40, 0, false, true)
+        ->CubicTo(110, 10, 140, 10, 150, 70)
+        ->Close()
+        ->Fill(new SolidColorBrush(Color::FromRGB(230, 120, 200, 180)))
+        ->Stroke(new SolidColorBrush(Color::FromRGB(120, 20, 90, 255)))
+        ->StrokeThickness(3.0f);
+    shapes->AddChild(path);
+
+    root->AddChild(shapes);
+
+    window.Content(root);
+    return counter;
+}
+
+// 将首帧与基准图像比较
+bool CompareWithGolden(const fk::render::SoftwareRenderer& renderer, const Options& options) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* golden = stbi_load(options.goldenPath.c_str(), &width, &height, &channels, 4);
+    if (!golden) {
+        std::printf("Cannot load golden image: %s\n", options.goldenPath.c_str());
+        return false;
+    }
+
+    const auto size = renderer.GetSize();
+    bool matched = false;
+    if (static_cast<std::uint32_t>(width) != size.width || static_cast<std::uint32_t>(height) != size.height) {
+        std::printf("Golden image size mismatch: %dx%d vs %ux%u\n", width, height, size.width, size.height);
+    } else {
+        const std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+        const std::size_t differing = fk::render::SoftwareRenderer::CompareImages(
+            renderer.GetPixels().data(), golden, pixelCount, options.tolerance);
+        std::printf("Golden comparison: %zu of %zu pixels differ (tolerance %d)\n",
+                    differing, pixelCount, options.tolerance);
+        matched = differing == 0;
+    }
+    stbi_image_free(golden);
+    return matched;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options options = ParseOptions(argc, argv);
+
+    auto window = std::make_shared<Window>();
+    window->Title("Headless benchmark")
+          ->Width(800)
+          ->Height(480)
+          ->Background(new SolidColorBrush(Color::FromRGB(245, 245, 250, 255)));
+    window->SetHeadless(true);
+    auto* counter = BuildScene(*window);
+    window->Show();
+
+    // 首帧：布局 + 整帧绘制
+    auto start = std::chrono::steady_clock::now();
+    window->RenderFrame();
+    const double firstFrameMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    auto* renderer = window->GetHeadlessRenderer();
+    if (!options.savePath.empty()) {
+        std::printf("Saved first frame to %s: %s\n", options.savePath.c_str(),
+                    renderer->SavePng(options.savePath) ? "ok" : "failed");
+    }
+    int exitCode = 0;
+    if (!options.goldenPath.empty() && !CompareWithGolden(*renderer, options)) {
+        exitCode = 1;
+    }
+
+    // 整帧重绘：背景色变化使所有像素失效
+    auto* backgroundA = new SolidColorBrush(Color::FromRGB(245, 245, 250, 255));
+    auto* backgroundB = new SolidColorBrush(Color::FromRGB(235, 240, 250, 255));
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.frames; ++i) {
+        window->SetBackground(i % 2 == 0 ? backgroundB : backgroundA);
+        window->RenderFrame();
+    }
+    const double fullMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / options.frames;
+
+    // 增量重绘：只有计数文本变化
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.frames; ++i) {
+        counter->Text("Frame " + std::to_string(i + 1));
+        window->RenderFrame();
+    }
+    const double incrementalMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / options.frames;
+
+    // 无变化时不需要渲染
+    const bool idle = !window->NeedsRender();
+
+    const auto size = renderer->GetSize();
+    std::printf("Headless render benchmark (%ux%u, %d frames)\n\n", size.width, size.height, options.frames);
+    std::printf("first frame        %8.3f ms\n", firstFrameMs);
+    std::printf("full redraw        %8.3f ms/frame\n", fullMs);
+    std::printf("incremental redraw %8.3f ms/frame   x%.2f\n", incrementalMs, fullMs / incrementalMs);
+    std::printf("idle after frames  %s\n", idle ? "yes" : "no");
+    std::printf("frames rendered    %llu\n", static_cast<unsigned long long>(renderer->GetFrameCount()));
+
+    window->Close();
+    return exitCode;
+}
@@ -0,0 +1,220 @@
+/**
+ * @file hit_test_benchmark.cpp
+ * @brief 指针命中测试基准测试
+ *
+ * 在一个包含大量矩形的画布上模拟鼠标扫过，对比：
+ * - Linear：原先的实现（逐个子元素 dynamic_cast 并测试，从后向前）
+ * - Indexed：Phase 5.1 的 InputManager（子元素较多时使用 HitTestIndex 网格索引）
+ *
+ * 同时逐点比较两者的结果，覆盖 RenderTransform、重叠元素的 z 序，
+ * 以及移动部分元素后索引的增量更新。
+ *
+ * 用法：hit_test_benchmark [矩形数量] [采样点数]
+ */
+
+#include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/graphics/Shape.h"
+#include "fk/ui/graphics/Transform.h"
+#include "fk/ui/input/InputManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace fk::ui;
+
+namespace {
+
+constexpr float kCellSize = 10.0f;
+constexpr float kShapeSize = 8.0f;
+
+// 按网格位置排列子元素的画布（偏移量可单独修改，用于测试增量更新）
+// 派生自 StackPanel 以复用已实例化的 Panel<StackPanel>，只替换布局逻辑
+class GridCanvas : public StackPanel {
+public:
+    explicit GridCanvas(int columns) : columns_(columns) {}
+
+    void SetOffset(std::size_t index, Point offset) {
+        if (offsets_.size() <= index) {
+            offsets_.resize(index + 1);
+        }
+        offsets_[index] = offset;
+        InvalidateArrange();
+    }
+
+protected:
+    Size MeasureOverride(const Size& availableSize) override {
+        for (auto* child : children_) {
+            child->Measure(Size(kShapeSize, kShapeSize));
+        }
+        const int rows = (static_cast<int>(children_.size()) + columns_ - 1) / columns_;
+        (void)availableSize;
+        return Size(columns_ * kCellSize, rows * kCellSize);
+    }
+
+    Size ArrangeOverride(const Size& finalSize) override {
+        for (std::size_t i = 0; i < children_.size(); ++i) {
+            Point offset = i < offsets_.size() ? offsets_[i] : Point(0, 0);
+            const float x = static_cast<float>(i % columns_) * kCellSize + offset.x;
+            const float y = static_cast<float>(i / columns_) * kCellSize + offset.y;
+            children_[i]->Arrange(Rect(x, y, kShapeSize, kShapeSize));
+        }
+        return finalSize;
+    }
+
+private:
+    int columns_;
+    std::vector<Point> offsets_;
+};
+
+// 原先的递归命中测试
+UIElement* LinearHitTest(UIElement* element, const Point& localPoint) {
+    if (element->GetVisibility() != Visibility::Visible || !element->GetIsEnabled()) {
+        return nullptr;
+    }
+    Rect bounds(0, 0, element->GetRenderSize().width, element->GetRenderSize().height);
+    if (!bounds.Contains(localPoint)) {
+        return nullptr;
+    }
+    for (int i = static_cast<int>(element->GetVisualChildrenCount()) - 1; i >= 0; --i) {
+        auto* child = dynamic_cast<UIElement*>(element->GetVisualChild(i));
+        if (!child) {
+            continue;
+        }
+        Rect layout = child->GetLayoutRect();
+        Point childPoint(localPoint.x - layout.x, localPoint.y - layout.y);
+        if (Transform* transform = child->GetRenderTransform()) {
+            childPoint = transform->GetInverseMatrix().TransformPoint(childPoint);
+        }
+        if (UIElement* hit = LinearHitTest(child, childPoint)) {
+            return hit;
+        }
+    }
+    return element;
+}
+
+template<typename Fn>
+double MeasureNs(std::size_t count, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(count);
+}
+
+// 线性实现很慢，只等间隔抽取部分采样点比较
+constexpr std::size_t kVerifySamples = 2000;
+
+std::size_t CountMismatches(InputManager& input, GridCanvas& canvas, const std::vector<Point>& points) {
+    const std::size_t stride = std::max<std::size_t>(1, points.size() / kVerifySamples);
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i < points.size(); i += stride) {
+        if (input.HitTest(points[i]) != LinearHitTest(&canvas, points[i])) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int shapeCount = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const std::size_t sampleCount = argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : 20000;
+    const int columns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(shapeCount))));
+
+    auto* canvas = new GridCanvas(columns);
+    std::vector<Rectangle*> shapes;
+    shapes.reserve(static_cast<std::size_t>(shapeCount));
+    for (int i = 0; i < shapeCount; ++i) {
+        auto* shape = new Rectangle();
+        shape->Width(kShapeSize)->Height(kShapeSize);
+        canvas->AddChild(shape);
+        shapes.push_back(shape);
+    }
+
+    // 每 97 个元素旋转一个，每 131 个元素偏移到与相邻元素重叠
+    for (int i = 0; i < shapeCount; i += 97) {
+        shapes[i]->SetRenderTransform(new RotateTransform(30.0f, kShapeSize / 2, kShapeSize / 2));
+    }
+    for (int i = 0; i < shapeCount; i += 131) {
+        canvas->SetOffset(static_cast<std::size_t>(i), Point(5.0f, 3.0f));
+    }
+
+    const Size canvasSize(columns * kCellSize, std::ceil(static_cast<float>(shapeCount) / columns) * kCellSize);
+    canvas->Measure(canvasSize);
+    canvas->Arrange(Rect(0, 0, canvasSize.width, canvasSize.height));
+
+    InputManager input;
+    input.SetRoot(canvas);
+
+    // 模拟鼠标扫过：随机起点的连续短位移
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> startX(0.0f, canvasSize.width);
+    std::uniform_real_distribution<float> startY(0.0f, canvasSize.height);
+    std::uniform_real_distribution<float> step(-6.0f, 6.0f);
+    std::vector<Point> points;
+    points.reserve(sampleCount);
+    Point cursor(startX(rng), startY(rng));
+    for (std::size_t i = 0; i < sampleCount; ++i) {
+        if (i % 200 == 0) {
+            cursor = Point(startX(rng), startY(rng));
+        }
+        cursor.x = std::clamp(cursor.x + step(rng), 0.0f, canvasSize.width);
+        cursor.y = std::clamp(cursor.y + step(rng), 0.0f, canvasSize.height);
+        points.push_back(cursor);
+    }
+
+    std::printf("Hit-test benchmark (%d shapes, %zu pointer samples)\n\n", shapeCount, sampleCount);
+
+    // 首次查询会建立索引，计入构建耗时后单独报告
+    auto buildStart = std::chrono::steady_clock::now();
+    input.HitTest(points[0]);
+    const double buildMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - buildStart).count();
+
+    std::size_t mismatches = CountMismatches(input, *canvas, points);
+
+    // 线性实现太慢，只取部分采样点计时
+    const std::size_t linearSamples = std::min<std::size_t>(sampleCount, 500);
+    volatile std::uintptr_t sink = 0;
+    const double linearNs = MeasureNs(linearSamples, [&](std::size_t i) {
+        sink = reinterpret_cast<std::uintptr_t>(LinearHitTest(canvas, points[i]));
+    });
+    const double indexedNs = MeasureNs(sampleCount, [&](std::size_t i) {
+        sink = reinterpret_cast<std::uintptr_t>(input.HitTest(points[i]));
+    });
+    const double hoverNs = MeasureNs(sampleCount, [&](std::size_t i) {
+        input.UpdateMouseOver(points[i]);
+    });
+
+    std::printf("index build        %10.3f ms\n", buildMs);
+    std::printf("HitTest linear     %10.1f ns/op\n", linearNs);
+    std::printf("HitTest indexed    %10.1f ns/op   x%.1f\n", indexedNs, linearNs / indexedNs);
+    std::printf("UpdateMouseOver    %10.1f ns/op\n", hoverNs);
+
+    // 移动一部分元素并修改变换（RenderTransform 原地修改），验证增量更新
+    for (int i = 7; i < shapeCount; i += 503) {
+        canvas->SetOffset(static_cast<std::size_t>(i), Point(-4.0f, 6.0f));
+    }
+    canvas->Arrange(Rect(0, 0, canvasSize.width, canvasSize.height));
+    for (int i = 0; i < shapeCount; i += 97 * 5) {
+        static_cast<RotateTransform*>(shapes[i]->GetRenderTransform())->SetAngle(60.0f);
+    }
+    const double updateNs = MeasureNs(sampleCount, [&](std::size_t i) {
+        sink = reinterpret_cast<std::uintptr_t>(input.HitTest(points[i]));
+    });
+    mismatches += CountMismatches(input, *canvas, points);
+
+    std::printf("HitTest after move %10.1f ns/op\n", updateNs);
+    std::printf("mismatches         %10zu\n", mismatches);
+
+    delete canvas;
+    return mismatches == 0 ? 0 : 1;
+}
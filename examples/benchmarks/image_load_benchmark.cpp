@@ -0,0 +1,167 @@
+/**
+ * @file image_load_benchmark.cpp
+ * @brief render::ImageCache 异步解码基准测试
+ *
+ * 生成若干张大尺寸 BMP，对比：
+ * - Sync：没有 Dispatcher，Load 在调用线程（UI 线程）解码
+ * - Async：解码在 TaskPool 中执行，结果通过 Dispatcher 回到 UI 线程；
+ *   统计 UI 线程单次调用的最长阻塞时间
+ * - Downscaled：按 256x256 的显示尺寸缩小解码后的纹理字节数
+ *
+ * 纹理上传需要 OpenGL 上下文，这里只按上传预算估算需要的帧数。
+ *
+ * 用法：image_load_benchmark [图片数量] [边长]
+ */
+
+#include <fk/core/Dispatcher.h>
+#include <fk/render/ImageCache.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fk;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void WriteLittleEndian(std::ofstream& out, std::uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// 24 位 BMP（stb_image 支持，无需额外的编码库）
+void WriteBmp(const std::string& path, int size, int seed) {
+    const int rowBytes = (size * 3 + 3) & ~3;
+    const std::uint32_t imageBytes = static_cast<std::uint32_t>(rowBytes) * size;
+    std::ofstream out(path, std::ios::binary);
+    out.put('B');
+    out.put('M');
+    WriteLittleEndian(out, 54 + imageBytes, 4);
+    WriteLittleEndian(out, 0, 4);
+    WriteLittleEndian(out, 54, 4);
+    WriteLittleEndian(out, 40, 4);
+    WriteLittleEndian(out, static_cast<std::uint32_t>(size), 4);
+    WriteLittleEndian(out, static_cast<std::uint32_t>(size), 4);
+    WriteLittleEndian(out, 1, 2);
+    WriteLittleEndian(out, 24, 2);
+    for (int i = 0; i < 6; ++i) {
+        WriteLittleEndian(out, 0, 4);
+    }
+
+    std::vector<char> row(rowBytes, 0);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            row[x * 3 + 0] = static_cast<char>((x + seed) & 0xFF);
+            row[x * 3 + 1] = static_cast<char>((y * 3) & 0xFF);
+            row[x * 3 + 2] = static_cast<char>((x ^ y) & 0xFF);
+        }
+        out.write(row.data(), rowBytes);
+    }
+}
+
+std::size_t TextureBytes(const render::ImageResource& resource) {
+    return static_cast<std::size_t>(resource.Width()) * resource.Height() * 4;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int count = argc > 1 ? std::atoi(argv[1]) : 8;
+    const int size = argc > 2 ? std::atoi(argv[2]) : 2048;
+
+    const auto directory = std::filesystem::temp_directory_path() / "fk_image_load_benchmark";
+    std::filesystem::create_directories(directory);
+    std::vector<std::string> paths;
+    for (int i = 0; i < count; ++i) {
+        paths.push_back((directory / ("image" + std::to_string(i) + ".bmp")).string());
+        WriteBmp(paths.back(), size, i);
+    }
+
+    auto& cache = render::ImageCache::Instance();
+    std::printf("ImageCache benchmark (%d images, %dx%d)\n\n", count, size, size);
+    bool ok = true;
+
+    // ========== Sync：在 UI 线程解码 ==========
+    double syncMaxMs = 0.0;
+    {
+        cache.SetDispatcher(nullptr);
+        std::vector<std::shared_ptr<render::ImageResource>> resources;
+        auto start = Clock::now();
+        for (const auto& path : paths) {
+            const auto callStart = Clock::now();
+            resources.push_back(cache.Load(path));
+            syncMaxMs = std::max(syncMaxMs, ElapsedMs(callStart));
+        }
+        std::printf("Sync         total %8.2f ms, longest UI-thread call %8.2f ms\n", ElapsedMs(start), syncMaxMs);
+    }
+
+    // ========== Async：TaskPool 解码，Dispatcher 回到 UI 线程 ==========
+    auto ui = std::make_shared<core::Dispatcher>("UI");
+    ui->BindToCurrentThread();
+    cache.SetDispatcher(ui);
+
+    auto loadAll = [&](int decodeSize, const char* name) {
+        std::vector<std::shared_ptr<render::ImageResource>> resources;
+        double maxCallMs = 0.0;
+        auto start = Clock::now();
+        for (const auto& path : paths) {
+            const auto callStart = Clock::now();
+            resources.push_back(cache.Load(path, decodeSize, decodeSize));
+            maxCallMs = std::max(maxCallMs, ElapsedMs(callStart));
+        }
+        auto pending = [&]() {
+            return std::any_of(resources.begin(), resources.end(), [](const auto& resource) {
+                return resource->GetState() == render::ImageLoadState::Decoding;
+            });
+        };
+        while (pending()) {
+            ui->WaitForEvents(std::chrono::milliseconds(5));
+            const auto callStart = Clock::now();
+            ui->ProcessPendingTasks();
+            maxCallMs = std::max(maxCallMs, ElapsedMs(callStart));
+        }
+        const double totalMs = ElapsedMs(start);
+
+        std::size_t bytes = 0;
+        for (const auto& resource : resources) {
+            ok = ok && resource->GetState() == render::ImageLoadState::Uploading &&
+                 resource->SourceWidth() == size;
+            bytes += TextureBytes(*resource);
+        }
+        const std::size_t budget = cache.GetUploadBudget();
+        std::printf("%-12s total %8.2f ms, longest UI-thread call %8.3f ms, texture %6.1f MB (%zu frames at %zu MB/frame)\n",
+                    name, totalMs, maxCallMs, bytes / (1024.0 * 1024.0), (bytes + budget - 1) / budget,
+                    budget / (1024 * 1024));
+        return maxCallMs;
+    };
+
+    const double asyncMaxMs = loadAll(0, "Async");
+    loadAll(256, "Downscaled");
+
+    // ========== 共享：相同（路径，解码尺寸）返回同一个资源 ==========
+    {
+        auto first = cache.Load(paths[0], 300, 300);
+        auto second = cache.Load(paths[0], 400, 400);  // 同属 512 档
+        const bool shared = first == second;
+        ok = ok && shared;
+        std::printf("\nshared resource for same source and size bucket: %s\n", shared ? "ok" : "WRONG");
+    }
+
+    cache.SetDispatcher(nullptr);
+    std::filesystem::remove_all(directory);
+    std::printf("UI-thread stall reduced x%.0f\n", asyncMaxMs > 0 ? syncMaxMs / asyncMaxMs : 0.0);
+    return ok ? 0 : 1;
+}
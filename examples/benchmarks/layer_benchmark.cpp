@@ -0,0 +1,213 @@
+/**
+ * @file layer_benchmark.cpp
+ * @brief 离屏透明度图层与 CacheMode 基准测试
+ *
+ * 透明度图层整体合成后，颜色不再预乘祖先的不透明度：
+ * - Record：面板淡入淡出时收集绘制命令的耗时。子元素的命令与透明度无关，
+ *   可以直接复用上一帧；对比每帧重新生成所有子元素命令（旧行为）
+ * - Version：CacheMode::BitmapCache 的图层内容版本只在内容变化时递增，
+ *   淡入淡出与平移时 GlRenderer 直接合成缓存的位图
+ * - Overlap：无头窗口（SoftwareRenderer）中半透明面板内重叠的子元素不会互相透出，
+ *   逐帧淡入淡出的结果与直接渲染最终状态一致
+ *
+ * 用法：layer_benchmark [帧数] [子元素数量]
+ */
+
+#include "fk/ui/Window.h"
+#include "fk/ui/layouts/Grid.h"
+#include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/graphics/Shape.h"
+#include "fk/ui/graphics/Brush.h"
+#include "fk/render/RenderContext.h"
+#include "fk/render/RenderList.h"
+#include "fk/render/SoftwareRenderer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace fk;
+using namespace fk::ui;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief 不经过窗口收集绘制命令（与 Window 相同地交替使用两个渲染列表）
+ */
+class Recorder {
+public:
+    explicit Recorder(UIElement* root) : root_(root) {}
+
+    void Frame() {
+        std::swap(current_, previous_);
+        current_->Clear();
+        render::RenderContext context(current_.get(), nullptr);
+        context.SetPreviousFrame(previous_.get());
+        root_->CollectDrawCommands(context);
+    }
+
+    // 第一个缓存图层的内容版本
+    std::uint64_t LayerVersion() const {
+        for (const auto& command : current_->GetCommands()) {
+            const auto* payload = std::get_if<render::LayerPayload>(&command.payload);
+            if (payload && payload->cacheId != 0) {
+                return payload->contentVersion;
+            }
+        }
+        return 0;
+    }
+
+private:
+    UIElement* root_;
+    std::unique_ptr<render::RenderList> current_{std::make_unique<render::RenderList>()};
+    std::unique_ptr<render::RenderList> previous_{std::make_unique<render::RenderList>()};
+};
+
+void Layout(UIElement* root) {
+    root->Measure(Size(1280, 4000));
+    root->Arrange(Rect(0, 0, 1280, 4000));
+}
+
+// 两个重叠的矩形：红色铺满，蓝色覆盖左上角
+Grid* BuildOverlap(float opacity) {
+    auto* grid = new Grid();
+    grid->Width(100)->Height(100);
+    auto* red = new Rectangle();
+    red->Width(100)->Height(100);
+    red->Fill(new SolidColorBrush(255, 0, 0, 255));
+    grid->AddChild(red);
+    auto* blue = new Rectangle();
+    blue->Width(50)->Height(50);
+    blue->Fill(new SolidColorBrush(0, 0, 255, 255));
+    grid->AddChild(blue);
+    grid->SetOpacity(opacity);
+    return grid;
+}
+
+std::shared_ptr<Window> ShowHeadless(UIElement* content) {
+    auto window = std::make_shared<Window>();
+    window->Width(200)->Height(200)->Background(new SolidColorBrush(255, 255, 255, 255));
+    window->SetHeadless(true);
+    window->Content(content);
+    window->Show();
+    window->RenderFrame();
+    return window;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int children = argc > 2 ? std::atoi(argv[2]) : 2000;
+    std::printf("Layer benchmark (%d frames, %d children)\n\n", frames, children);
+    bool ok = true;
+
+    // ========== Record：淡入淡出时的命令收集 ==========
+    {
+        auto* root = new StackPanel();
+        auto* spacer = new Rectangle();
+        spacer->Width(10)->Height(0);
+        root->AddChild(spacer);
+
+        auto* panel = new StackPanel();
+        panel->SetOrient(Orientation::Vertical);
+        std::vector<Rectangle*> items;
+        for (int i = 0; i < children; ++i) {
+            auto* item = new Rectangle();
+            item->Width(200)->Height(2);
+            item->Fill(new SolidColorBrush(static_cast<std::uint8_t>(i * 7), 120, 200, 255));
+            panel->AddChild(item);
+            items.push_back(item);
+        }
+        root->AddChild(panel);
+        Layout(root);
+
+        Recorder recorder(root);
+        recorder.Frame();
+        recorder.Frame();
+
+        auto start = Clock::now();
+        for (int i = 0; i < frames; ++i) {
+            panel->SetOpacity(0.2f + 0.6f * static_cast<float>(i % 10) / 10.0f);
+            recorder.Frame();
+        }
+        const double fadeMs = ElapsedMs(start) / frames;
+
+        // 旧行为：透明度预乘进颜色，每个子元素的命令都要重新生成
+        start = Clock::now();
+        for (int i = 0; i < frames; ++i) {
+            panel->SetOpacity(0.2f + 0.6f * static_cast<float>(i % 10) / 10.0f);
+            for (auto* item : items) {
+                item->InvalidateVisual();
+            }
+            recorder.Frame();
+        }
+        const double rerecordMs = ElapsedMs(start) / frames;
+        std::printf("Record     fade %8.3f ms/frame, re-record all children %8.3f ms/frame   x%.1f\n",
+                    fadeMs, rerecordMs, fadeMs > 0 ? rerecordMs / fadeMs : 0.0);
+
+        // ========== Version：缓存位图的内容版本 ==========
+        panel->SetCacheMode(CacheMode::BitmapCache);
+        recorder.Frame();
+        const std::uint64_t initial = recorder.LayerVersion();
+
+        panel->SetOpacity(0.5f);
+        recorder.Frame();
+        const bool fadeKeeps = recorder.LayerVersion() == initial;
+
+        spacer->Height(40);
+        Layout(root);
+        recorder.Frame();
+        const bool moveKeeps = recorder.LayerVersion() == initial;
+
+        items[children / 2]->Fill(new SolidColorBrush(0, 0, 0, 255));
+        recorder.Frame();
+        const bool changeBumps = recorder.LayerVersion() != initial;
+
+        ok = ok && initial != 0 && fadeKeeps && moveKeeps && changeBumps;
+        std::printf("Version    fade keeps bitmap %s, move keeps bitmap %s, content change invalidates %s\n",
+                    fadeKeeps ? "ok" : "WRONG", moveKeeps ? "ok" : "WRONG", changeBumps ? "ok" : "WRONG");
+        delete root;
+    }
+
+    // ========== Overlap：重叠的子元素整体合成 ==========
+    {
+        auto window = ShowHeadless(BuildOverlap(0.5f));
+        const auto* renderer = window->GetHeadlessRenderer();
+        const auto background = renderer->GetPixel(150, 150);
+        const auto overlap = renderer->GetPixel(25, 25);
+        // 蓝色与白色背景各占一半，红色不应透出
+        const bool noBleed = overlap[0] <= background[0] / 2 + 1 && overlap[2] > 250;
+        ok = ok && noBleed;
+        std::printf("\nOverlap    blue over red at 50%%: (%d, %d, %d) %s\n", overlap[0], overlap[1], overlap[2],
+                    noBleed ? "ok" : "WRONG");
+
+        auto* faded = BuildOverlap(1.0f);
+        auto fading = ShowHeadless(faded);
+        for (int i = 1; i <= 10; ++i) {
+            faded->SetOpacity(1.0f - 0.05f * i);
+            fading->RenderFrame();
+        }
+        auto direct = ShowHeadless(BuildOverlap(0.5f));
+        const std::size_t diff = render::SoftwareRenderer::CompareImages(
+            fading->GetHeadlessRenderer()->GetPixels().data(), direct->GetHeadlessRenderer()->GetPixels().data(),
+            200 * 200, 0);
+        ok = ok && diff == 0;
+        std::printf("Fade       incremental frames match direct render: %zu pixels differ\n", diff);
+
+        window->Close();
+        fading->Close();
+        direct->Close();
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file property_store_benchmark.cpp
+ * @brief PropertyStore 读写吞吐量基准测试
+ *
+ * 对比两种实现：
+ * - Legacy：原先的布局（unordered_map + 每个条目五个 std::any，读取经过 std::any_cast）
+ * - Current：Phase 5.1 的 PropertyStore（按类型共享的索引表 + 小型 POD 内联槽）
+ *
+ * 用法：property_store_benchmark [每组迭代次数]
+ */
+
+#include <fk/binding/DependencyObject.h>
+#include <fk/ui/text/TextBlock.h>
+
+#include <any>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace fk::binding;
+
+// 统计堆分配次数
+static std::size_t g_allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+enum class Alignment { Start, Center, End, Stretch };
+
+struct Insets {
+    float left;
+    float top;
+    float right;
+    float bottom;
+
+    // 与 Thickness 一样按成员比较
+    bool operator==(const Insets& other) const = default;
+};
+
+// 原先 PropertyStore 的存储布局（只保留本地值的读写、类型校验与变更通知路径）
+class LegacyStore {
+public:
+    using Callback = std::function<void(const DependencyProperty&, const std::any&, const std::any&)>;
+
+    explicit LegacyStore(Callback callback) : callback_(std::move(callback)) {}
+
+    const std::any& GetValue(const DependencyProperty& property) const {
+        auto it = entries_.find(property.Id());
+        if (it == entries_.end() || !it->second.hasEffective) {
+            return property.Metadata().defaultValue;
+        }
+        return it->second.effectiveValue;
+    }
+
+    void SetValue(const DependencyProperty& property, std::any value) {
+        if (property.PropertyType() != std::type_index(value.type())) {
+            throw std::invalid_argument("Value type mismatch");
+        }
+        auto& entry = entries_[property.Id()];
+        entry.local.hasValue = true;
+        entry.local.value = std::move(value);
+
+        const std::any oldValue = entry.hasEffective ? entry.effectiveValue : property.Metadata().defaultValue;
+        entry.effectiveValue = entry.local.value;
+        entry.hasEffective = true;
+
+        if (!AreEquivalent(oldValue, entry.effectiveValue) && callback_) {
+            callback_(property, oldValue, entry.effectiveValue);
+        }
+    }
+
+private:
+    struct Layer {
+        bool hasValue{false};
+        std::any value;
+    };
+
+    struct Entry {
+        Layer local;
+        Layer binding;
+        Layer style;
+        Layer inherited;
+        std::any effectiveValue;
+        bool hasEffective{false};
+    };
+
+    // 原实现只比较 int/bool/double/string/float，其余类型一律视为已变化
+    static bool AreEquivalent(const std::any& lhs, const std::any& rhs) {
+        if (lhs.type() != rhs.type()) {
+            return false;
+        }
+        if (lhs.type() == typeid(float)) {
+            return std::any_cast<float>(lhs) == std::any_cast<float>(rhs);
+        }
+        if (lhs.type() == typeid(double)) {
+            return std::any_cast<double>(lhs) == std::any_cast<double>(rhs);
+        }
+        if (lhs.type() == typeid(bool)) {
+            return std::any_cast<bool>(lhs) == std::any_cast<bool>(rhs);
+        }
+        return false;
+    }
+
+    Callback callback_;
+    std::unordered_map<std::size_t, Entry> entries_;
+};
+
+class BenchObject : public DependencyObject {
+public:
+    BenchObject() = default;
+};
+
+struct BenchProperties {
+    const DependencyProperty& width;
+    const DependencyProperty& opacity;
+    const DependencyProperty& visible;
+    const DependencyProperty& alignment;
+    const DependencyProperty& margin;
+    const DependencyProperty& unset;  // 从未设置，读取默认值
+};
+
+BenchProperties RegisterProperties() {
+    return BenchProperties{
+        DependencyProperty::Register("Width", typeid(float), typeid(BenchObject), {100.0f}),
+        DependencyProperty::Register("Opacity", typeid(double), typeid(BenchObject), {1.0}),
+        DependencyProperty::Register("Visible", typeid(bool), typeid(BenchObject), {true}),
+        DependencyProperty::Register("Alignment", typeid(Alignment), typeid(BenchObject), {Alignment::Stretch}),
+        DependencyProperty::Register("Margin", typeid(Insets), typeid(BenchObject), {Insets{0, 0, 0, 0}}),
+        DependencyProperty::Register("Unset", typeid(float), typeid(BenchObject), {0.0f}),
+    };
+}
+
+// 防止编译器优化掉读取结果
+volatile float g_sink = 0.0f;
+
+struct Result {
+    double nsPerOp;
+    double allocationsPerOp;
+};
+
+template<typename Fn>
+Result Measure(int iterations, int opsPerIteration, Fn&& fn) {
+    const std::size_t allocationsBefore = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    const double ops = static_cast<double>(iterations) * opsPerIteration;
+    return Result{
+        std::chrono::duration<double, std::nano>(elapsed).count() / ops,
+        static_cast<double>(g_allocations - allocationsBefore) / ops,
+    };
+}
+
+void Report(const char* name, const Result& legacy, const Result& current) {
+    std::printf("%-26s legacy %7.2f ns/op %5.2f alloc/op   current %7.2f ns/op %5.2f alloc/op   x%.2f\n",
+                name, legacy.nsPerOp, legacy.allocationsPerOp,
+                current.nsPerOp, current.allocationsPerOp, legacy.nsPerOp / current.nsPerOp);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    const auto props = RegisterProperties();
+
+    // 变更时与 DependencyObject 一样触发 PropertyChanged 事件
+    BenchObject legacyOwner;
+    LegacyStore legacy([&](const DependencyProperty& property, const std::any& oldValue, const std::any& newValue) {
+        legacyOwner.PropertyChanged(property, oldValue, newValue, ValueSource::Local, ValueSource::Local);
+    });
+    BenchObject current;
+
+    // 模拟一个设置了若干属性的元素：填充一些无关属性，使查找表规模接近真实控件
+    for (int i = 0; i < 24; ++i) {
+        const auto& property = DependencyProperty::Register(
+            "Filler" + std::to_string(i), typeid(float), typeid(BenchObject), {0.0f});
+        legacy.SetValue(property, std::any(static_cast<float>(i)));
+        current.SetValue(property, static_cast<float>(i));
+    }
+
+    legacy.SetValue(props.width, std::any(120.0f));
+    legacy.SetValue(props.opacity, std::any(0.5));
+    legacy.SetValue(props.visible, std::any(true));
+    legacy.SetValue(props.alignment, std::any(Alignment::Center));
+    legacy.SetValue(props.margin, std::any(Insets{1, 2, 3, 4}));
+
+    current.SetValue(props.width, 120.0f);
+    current.SetValue(props.opacity, 0.5);
+    current.SetValue(props.visible, true);
+    current.SetValue(props.alignment, Alignment::Center);
+    current.SetValue(props.margin, Insets{1, 2, 3, 4});
+
+    std::printf("PropertyStore benchmark (%d iterations)\n\n", iterations);
+
+    // ========== GetValue ==========
+
+    auto legacyGet = Measure(iterations, 5, [&](int) {
+        float sum = std::any_cast<float>(legacy.GetValue(props.width));
+        sum += static_cast<float>(std::any_cast<double>(legacy.GetValue(props.opacity)));
+        sum += std::any_cast<bool>(legacy.GetValue(props.visible)) ? 1.0f : 0.0f;
+        sum += static_cast<float>(std::any_cast<Alignment>(legacy.GetValue(props.alignment)));
+        sum += std::any_cast<Insets>(legacy.GetValue(props.margin)).left;
+        g_sink = sum;
+    });
+    auto currentGet = Measure(iterations, 5, [&](int) {
+        float sum = current.GetValue<float>(props.width);
+        sum += static_cast<float>(current.GetValue<double>(props.opacity));
+        sum += current.GetValue<bool>(props.visible) ? 1.0f : 0.0f;
+        sum += static_cast<float>(current.GetValue<Alignment>(props.alignment));
+        sum += current.GetValue<Insets>(props.margin).left;
+        g_sink = sum;
+    });
+    Report("GetValue<T> (set values)", legacyGet, currentGet);
+
+    auto legacyDefault = Measure(iterations, 1, [&](int) {
+        g_sink = std::any_cast<float>(legacy.GetValue(props.unset));
+    });
+    auto currentDefault = Measure(iterations, 1, [&](int) {
+        g_sink = current.GetValue<float>(props.unset);
+    });
+    Report("GetValue<T> (default)", legacyDefault, currentDefault);
+
+    // ========== SetValue ==========
+    // 每次写入不同的值，保证变更通知路径也被计入
+
+    const int setIterations = iterations / 4;
+    auto legacySet = Measure(setIterations, 2, [&](int i) {
+        legacy.SetValue(props.width, std::any(static_cast<float>(i)));
+        legacy.SetValue(props.margin, std::any(Insets{static_cast<float>(i), 0, 0, 0}));
+    });
+    auto currentSet = Measure(setIterations, 2, [&](int i) {
+        current.SetValue(props.width, static_cast<float>(i));
+        current.SetValue(props.margin, Insets{static_cast<float>(i), 0, 0, 0});
+    });
+    Report("SetValue<T> (changed)", legacySet, currentSet);
+
+    auto legacySame = Measure(setIterations, 1, [&](int) {
+        legacy.SetValue(props.margin, std::any(Insets{1, 2, 3, 4}));
+    });
+    auto currentSame = Measure(setIterations, 1, [&](int) {
+        current.SetValue(props.margin, Insets{1, 2, 3, 4});
+    });
+    Report("SetValue<T> (unchanged)", legacySame, currentSame);
+
+    // ========== 正确性 ==========
+    bool ok = true;
+
+    // 未变化的枚举与结构体不触发 PropertyChanged，也不装箱
+    std::size_t notifications = 0;
+    auto connection = current.PropertyChanged.Connect(
+        [&](const DependencyProperty&, const std::any&, const std::any&, ValueSource, ValueSource) { ++notifications; });
+    current.SetValue(props.alignment, Alignment::Center);
+    current.SetValue(props.margin, Insets{1, 2, 3, 4});
+    // 计时循环的第一次写入改变了值，允许这一次装箱
+    const bool unchangedQuiet = notifications == 0 && currentSame.allocationsPerOp * setIterations <= 1.0;
+    current.SetValue(props.alignment, Alignment::End);
+    const bool changedNotified = notifications == 1;
+    connection.Disconnect();
+    ok = ok && unchangedQuiet && changedNotified;
+    std::printf("\nUnchanged  enum/struct sets raise no PropertyChanged: %s, changed enum notifies: %s\n",
+                unchangedQuiet ? "ok" : "FAILED", changedNotified ? "ok" : "FAILED");
+
+    // 基类构造函数中写入的条目在构造完成后迁移到最终类型的索引表
+    {
+        auto* textBlock = new fk::ui::TextBlock();
+        textBlock->Text(std::string("Hello"));
+        const auto& textBlockTable = PropertyIndexTable::ForType(typeid(fk::ui::TextBlock));
+        const auto& elementTable = PropertyIndexTable::ForType(typeid(fk::ui::UIElement));
+        const bool perType = textBlockTable.Find(fk::ui::TextBlock::TextProperty().Id()) >= 0 &&
+                             textBlockTable.Find(fk::ui::UIElement::VisibilityProperty().Id()) >= 0 &&
+                             elementTable.Find(fk::ui::TextBlock::TextProperty().Id()) < 0 &&
+                             textBlock->GetText() == "Hello";
+        ok = ok && perType;
+        std::printf("Tables     TextBlock uses the TextBlock index table: %s\n", perType ? "ok" : "FAILED");
+        delete textBlock;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file scroll_benchmark.cpp
+ * @brief ScrollContentPresenter 合成滚动基准测试
+ *
+ * 在长文档中平滑滚动（每帧移动几个像素），测量每帧布局与收集绘制命令的耗时：
+ * - Arrange：旧行为，偏移变化时重新排列内容并重新生成可见区域的命令
+ * - Composited：只移动内容并平移保留的命令，视口移出记录窗口时才重新记录
+ * - Pixels：无头窗口（SoftwareRenderer）中逐帧滚动的结果与直接渲染最终位置一致
+ *
+ * 用法：scroll_benchmark [帧数] [行数]
+ */
+
+#include "fk/ui/Window.h"
+#include "fk/ui/controls/Border.h"
+#include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/scrolling/ScrollContentPresenter.h"
+#include "fk/ui/graphics/Shape.h"
+#include "fk/ui/graphics/Brush.h"
+#include "fk/render/RenderContext.h"
+#include "fk/render/RenderList.h"
+#include "fk/render/ScrollLayer.h"
+#include "fk/render/SoftwareRenderer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <utility>
+
+using namespace fk;
+using namespace fk::ui;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr float kViewportWidth = 800.0f;
+constexpr float kViewportHeight = 600.0f;
+constexpr double kScrollStep = 6.5;  // 触控板平滑滚动每帧的位移
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 每行：色块 + 带边框的条目
+StackPanel* BuildDocument(int rows) {
+    auto* document = new StackPanel();
+    for (int i = 0; i < rows; ++i) {
+        auto* row = new StackPanel();
+        row->SetOrient(Orientation::Horizontal);
+        auto* swatch = new Rectangle();
+        swatch->Width(24)->Height(24);
+        swatch->Fill(new SolidColorBrush(static_cast<std::uint8_t>(i * 37), 120, 200, 255));
+        row->AddChild(swatch);
+        auto* bar = new Rectangle();
+        bar->Width(200.0f + static_cast<float>((i * 53) % 400))->Height(24);
+        bar->Fill(new SolidColorBrush(230, 230, static_cast<std::uint8_t>(i * 11), 255));
+        auto* item = new Border();
+        item->Child(bar);
+        item->BorderBrush(new SolidColorBrush(0, 0, 0, 255));
+        item->BorderThickness(1.0f);
+        row->AddChild(item);
+        document->AddChild(row);
+    }
+    return document;
+}
+
+struct ScrollResult {
+    double msPerFrame{0.0};
+    std::size_t commandsPerFrame{0};
+    std::size_t records{0};
+};
+
+ScrollResult Scroll(bool composited, int frames, int rows) {
+    auto presenter = std::make_unique<ScrollContentPresenter<>>();
+    presenter->SetCompositedScrolling(composited);
+    presenter->Content(static_cast<UIElement*>(BuildDocument(rows)));
+    presenter->Measure(Size(kViewportWidth, kViewportHeight));
+    presenter->Arrange(Rect(0, 0, kViewportWidth, kViewportHeight));
+
+    // 与 Window 相同地交替使用两个渲染列表
+    auto current = std::make_unique<render::RenderList>();
+    auto previous = std::make_unique<render::RenderList>();
+    auto frame = [&]() {
+        std::swap(current, previous);
+        current->Clear();
+        render::RenderContext context(current.get(), nullptr);
+        context.SetPreviousFrame(previous.get());
+        presenter->CollectDrawCommands(context);
+    };
+    frame();
+
+    ScrollResult result;
+    auto start = Clock::now();
+    for (int i = 0; i < frames; ++i) {
+        presenter->SetVerticalOffset(presenter->GetVerticalOffset() + kScrollStep);
+        presenter->Measure(Size(kViewportWidth, kViewportHeight));
+        presenter->Arrange(Rect(0, 0, kViewportWidth, kViewportHeight));
+        frame();
+        result.commandsPerFrame += current->GetCommandCount();
+    }
+    result.msPerFrame = ElapsedMs(start) / frames;
+    result.commandsPerFrame /= static_cast<std::size_t>(frames);
+    if (const auto* layer = presenter->GetScrollLayer()) {
+        result.records = layer->GetRecordCount();
+    }
+    return result;
+}
+
+void PrintScroll(const char* name, const ScrollResult& result) {
+    std::printf("%-11s %8.3f ms/frame  %6zu commands/frame  %4zu content records\n", name, result.msPerFrame,
+                result.commandsPerFrame, result.records);
+}
+
+std::shared_ptr<Window> ShowDocument(bool composited, double offset, ScrollContentPresenter<>*& presenter) {
+    auto window = std::make_shared<Window>();
+    window->Width(320)->Height(240)->Background(new SolidColorBrush(255, 255, 255, 255));
+    window->SetHeadless(true);
+    presenter = new ScrollContentPresenter<>();
+    presenter->SetCompositedScrolling(composited);
+    presenter->Content(static_cast<UIElement*>(BuildDocument(200)));
+    window->Content(presenter);
+    window->Show();
+    window->RenderFrame();
+    presenter->SetVerticalOffset(offset);
+    window->RenderFrame();
+    return window;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 400;
+    const int rows = argc > 2 ? std::atoi(argv[2]) : 5000;
+    std::printf("Scroll benchmark (%d frames, %d rows, %.1f px/frame)\n\n", frames, rows, kScrollStep);
+    bool ok = true;
+
+    // ========== 布局 + 命令收集 ==========
+    const auto arranged = Scroll(false, frames, rows);
+    PrintScroll("Arrange", arranged);
+    const auto composited = Scroll(true, frames, rows);
+    PrintScroll("Composited", composited);
+    std::printf("speedup x%.1f\n", composited.msPerFrame > 0 ? arranged.msPerFrame / composited.msPerFrame : 0.0);
+    ok = ok && composited.records > 0 && composited.records < static_cast<std::size_t>(frames) / 4;
+
+    // ========== 逐帧滚动与直接渲染对比 ==========
+    for (bool mode : {false, true}) {
+        ScrollContentPresenter<>* scrolled = nullptr;
+        auto window = ShowDocument(mode, 0.0, scrolled);
+        for (int i = 0; i < 150; ++i) {
+            scrolled->SetVerticalOffset(scrolled->GetVerticalOffset() + (i < 100 ? 7.3 : -11.1));
+            window->RenderFrame();
+        }
+        ScrollContentPresenter<>* direct = nullptr;
+        auto reference = ShowDocument(mode, scrolled->GetVerticalOffset(), direct);
+        const std::size_t diff = render::SoftwareRenderer::CompareImages(
+            window->GetHeadlessRenderer()->GetPixels().data(), reference->GetHeadlessRenderer()->GetPixels().data(),
+            320 * 240, 0);
+        ok = ok && diff == 0;
+        std::printf("Pixels     %-10s scrolled frames match direct render: %zu pixels differ\n",
+                    mode ? "composited" : "arrange", diff);
+        window->Close();
+        reference->Close();
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file sdf_text_benchmark.cpp
+ * @brief 距离场字形（GlyphRenderMode::SignedDistanceField）基准测试
+ *
+ * 无头窗口（SoftwareRenderer）中显示多行文本：
+ * - Zoom：FontSize 从 12 逐帧增大到 48 的字号动画，对比位图字形（每个像素字号重新栅格化）
+ *   与距离场字形（每个字形只生成一次）的帧耗时和字形生成次数
+ * - Startup：首帧耗时与生成的字形数，对比按需生成与加载预烘焙的常用字符集
+ * - Quality：24px 文本的距离场渲染与位图渲染的墨迹量（覆盖率总和）对比
+ *
+ * 用法：sdf_text_benchmark [行数]
+ */
+
+#include "fk/ui/Window.h"
+#include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/text/TextBlock.h"
+#include "fk/ui/graphics/Brush.h"
+#include "fk/render/FontManager.h"
+#include "fk/render/IRenderer.h"
+#include "fk/render/SdfGlyphSet.h"
+#include "fk/render/SoftwareRenderer.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fk;
+using namespace fk::ui;
+using fk::render::GlyphRenderMode;
+using fk::render::SdfGlyphSet;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr float kWindowWidth = 800.0f;
+constexpr float kWindowHeight = 600.0f;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Document {
+    std::shared_ptr<Window> window;
+    std::vector<TextBlock*> blocks;
+};
+
+Document ShowDocument(GlyphRenderMode mode, int lines, float fontSize) {
+    Document document;
+    document.window = std::make_shared<Window>();
+    document.window->Width(kWindowWidth)->Height(kWindowHeight)->Background(new SolidColorBrush(255, 255, 255, 255));
+    document.window->SetHeadless(true);
+    document.window->SetGlyphRenderMode(mode);
+
+    auto* panel = new StackPanel();
+    for (int i = 0; i < lines; ++i) {
+        auto* block = new TextBlock();
+        block->Text("Line " + std::to_string(i) + ": The quick brown fox jumps over the lazy dog");
+        block->FontSize(fontSize);
+        block->Foreground(new SolidColorBrush(0, 0, 0, 255));
+        panel->AddChild(block);
+        document.blocks.push_back(block);
+    }
+    document.window->Content(panel);
+    document.window->Show();
+    return document;
+}
+
+void SetFontSize(const Document& document, float fontSize) {
+    for (auto* block : document.blocks) {
+        block->FontSize(fontSize);
+        block->InvalidateMeasure();
+    }
+}
+
+// 帧缓冲中的墨迹量：白色背景上黑色文本的覆盖率总和（像素）
+double Ink(const Document& document) {
+    const auto& pixels = document.window->GetHeadlessRenderer()->GetPixels();
+    double ink = 0.0;
+    for (std::size_t i = 0; i < pixels.size(); i += 4) {
+        ink += (255 - pixels[i]) / 255.0;
+    }
+    return ink;
+}
+
+struct ZoomResult {
+    double msPerFrame{0.0};
+    std::size_t glyphs{0};
+};
+
+ZoomResult Zoom(GlyphRenderMode mode, int lines, const std::string& sdfKey) {
+    SdfGlyphSet::ClearRegistry();
+    auto document = ShowDocument(mode, lines, 12.0f);
+    document.window->RenderFrame();
+
+    int frames = 0;
+    const auto start = Clock::now();
+    for (float size = 12.5f; size <= 48.0f; size += 0.5f, ++frames) {
+        SetFontSize(document, size);
+        document.window->RenderFrame();
+    }
+    ZoomResult result;
+    result.msPerFrame = ElapsedMs(start) / frames;
+    if (mode == GlyphRenderMode::SignedDistanceField) {
+        const auto set = SdfGlyphSet::FindRegistered(sdfKey);
+        result.glyphs = set ? set->GetGeneratedCount() : 0;
+    } else {
+        result.glyphs = document.window->GetHeadlessRenderer()->GetRasterizedGlyphCount();
+    }
+    document.window->Close();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int lines = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::printf("SDF text benchmark (%d lines)\n\n", lines);
+    bool ok = true;
+
+    // 渲染器解析到的默认字体；空字符集的烘焙结果只用于取得字形集标识
+    auto& manager = render::FontManager::Instance();
+    const auto* face = manager.GetFace(manager.Resolve("sans-serif"));
+    const auto probe = face ? SdfGlyphSet::BakeFont(face->path, face->faceIndex, U"") : nullptr;
+    if (!probe) {
+        std::printf("No scalable default font\n");
+        return 1;
+    }
+    const std::string key = probe->GetKey();
+    std::printf("Font       %s (%s)\n", key.c_str(), face->path.c_str());
+
+    // ========== Zoom：字号动画 ==========
+    const auto bitmap = Zoom(GlyphRenderMode::Bitmap, lines, key);
+    const auto sdf = Zoom(GlyphRenderMode::SignedDistanceField, lines, key);
+    ok = ok && sdf.glyphs > 0 && sdf.glyphs < bitmap.glyphs;
+    std::printf("Zoom       bitmap %8.3f ms/frame, %6zu glyphs rasterized\n", bitmap.msPerFrame, bitmap.glyphs);
+    std::printf("           sdf    %8.3f ms/frame, %6zu glyphs generated\n", sdf.msPerFrame, sdf.glyphs);
+
+    // ========== Startup：预烘焙的常用字符集 ==========
+    const std::string bakedPath = (std::filesystem::temp_directory_path() / "fk_sdf_benchmark.fksd").string();
+    auto start = Clock::now();
+    const auto baked = SdfGlyphSet::BakeFont(face->path, face->faceIndex, SdfGlyphSet::CommonCodepoints());
+    const double bakeMs = ElapsedMs(start);
+    ok = ok && baked && baked->Save(bakedPath);
+
+    SdfGlyphSet::ClearRegistry();
+    auto cold = ShowDocument(GlyphRenderMode::SignedDistanceField, lines, 24.0f);
+    start = Clock::now();
+    cold.window->RenderFrame();
+    const double coldMs = ElapsedMs(start);
+    const auto coldSet = SdfGlyphSet::FindRegistered(key);
+    const std::size_t coldGlyphs = coldSet ? coldSet->GetGeneratedCount() : 0;
+
+    SdfGlyphSet::ClearRegistry();
+    start = Clock::now();
+    const auto loaded = SdfGlyphSet::Load(bakedPath);
+    SdfGlyphSet::Register(loaded);
+    const double loadMs = ElapsedMs(start);
+    auto warm = ShowDocument(GlyphRenderMode::SignedDistanceField, lines, 24.0f);
+    start = Clock::now();
+    warm.window->RenderFrame();
+    const double warmMs = ElapsedMs(start);
+    const std::size_t warmGlyphs = loaded ? loaded->GetGeneratedCount() : 0;
+    ok = ok && loaded && loaded->GetGlyphCount() == baked->GetGlyphCount() && warmGlyphs == 0;
+    std::printf("Startup    bake %zu glyphs %8.3f ms, load %8.3f ms\n", baked ? baked->GetGlyphCount() : 0, bakeMs,
+                loadMs);
+    std::printf("           first frame %8.3f ms generating %zu glyphs, %8.3f ms with prebaked set (%zu generated)\n",
+                coldMs, coldGlyphs, warmMs, warmGlyphs);
+
+    // 预烘焙字形与按需生成的字形渲染结果相同
+    const std::size_t diff = render::SoftwareRenderer::CompareImages(
+        cold.window->GetHeadlessRenderer()->GetPixels().data(),
+        warm.window->GetHeadlessRenderer()->GetPixels().data(),
+        static_cast<std::size_t>(kWindowWidth * kWindowHeight), 0);
+    ok = ok && diff == 0;
+    std::printf("           prebaked glyphs match generated glyphs: %zu pixels differ\n", diff);
+
+    // 损坏或截断的字形集文件返回 nullptr，不因文件中的字形数分配大量内存
+    bool rejectsCorrupt = false;
+    if (baked) {
+        std::ifstream bakedFile(bakedPath, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(bakedFile)), std::istreambuf_iterator<char>());
+        const std::size_t countOffset = 8 + 4 + baked->GetFamily().size() + 4 + baked->GetStyle().size() + 8;
+        const std::string corruptPath = bakedPath + ".corrupt";
+        std::string inflated = bytes;
+        inflated.replace(countOffset, 4, "\xff\xff\xff\x7f");
+        std::ofstream(corruptPath, std::ios::binary | std::ios::trunc).write(inflated.data(),
+                                                                           static_cast<std::streamsize>(inflated.size()));
+        const bool inflatedRejected = SdfGlyphSet::Load(corruptPath) == nullptr;
+        std::ofstream(corruptPath, std::ios::binary | std::ios::trunc).write(bytes.data(),
+                                                                           static_cast<std::streamsize>(bytes.size() / 2));
+        const bool truncatedRejected = SdfGlyphSet::Load(corruptPath) == nullptr;
+        std::filesystem::remove(corruptPath);
+        rejectsCorrupt = inflatedRejected && truncatedRejected;
+    }
+    ok = ok && rejectsCorrupt;
+    std::printf("           corrupt and truncated files rejected: %s\n", rejectsCorrupt ? "ok" : "FAILED");
+
+    // ========== Quality：距离场与位图的墨迹量 ==========
+    auto reference = ShowDocument(GlyphRenderMode::Bitmap, lines, 24.0f);
+    reference.window->RenderFrame();
+    const double bitmapInk = Ink(reference);
+    const double sdfInk = Ink(warm);
+    const double ratio = bitmapInk > 0.0 ? sdfInk / bitmapInk : 0.0;
+    ok = ok && std::abs(ratio - 1.0) < 0.1;
+    std::printf("Quality    24px ink: bitmap %.0f px, sdf %.0f px (ratio %.3f)\n", bitmapInk, sdfInk, ratio);
+
+    cold.window->Close();
+    warm.window->Close();
+    reference.window->Close();
+    std::filesystem::remove(bakedPath);
+    return ok ? 0 : 1;
+}
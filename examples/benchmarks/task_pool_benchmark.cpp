@@ -0,0 +1,179 @@
+/**
+ * @file task_pool_benchmark.cpp
+ * @brief core::TaskPool 基准测试
+ *
+ * - Throughput：UI 线程投递大量小任务，测量吞吐量与窃取次数
+ * - Fork-join：任务递归拆分并等待子任务（工作线程等待时执行其他任务）
+ * - Frame：模拟 64 个约 4ms 的解码任务。对比在 UI 线程同步执行，
+ *   与在线程池执行、通过 Then(dispatcher, ...) 回到 UI 线程时的最长帧时间
+ * - Continuation：检查失败与取消沿 Then 传递
+ *
+ * 用法：task_pool_benchmark [工作线程数]
+ */
+
+#include <fk/core/Dispatcher.h>
+#include <fk/core/TaskPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace fk::core;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+volatile std::uint64_t g_sink = 0;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 模拟解码：约 duration 的纯计算
+std::uint64_t Burn(std::chrono::microseconds duration) {
+    const auto end = Clock::now() + duration;
+    std::uint64_t value = 0x9e3779b97f4a7c15ULL;
+    while (Clock::now() < end) {
+        for (int i = 0; i < 256; ++i) {
+            value ^= value << 13;
+            value ^= value >> 7;
+            value ^= value << 17;
+        }
+    }
+    return value;
+}
+
+std::uint64_t ParallelSum(TaskPool& pool, const std::uint32_t* data, std::size_t count) {
+    if (count <= 16384) {
+        return std::accumulate(data, data + count, std::uint64_t{0});
+    }
+    const std::size_t half = count / 2;
+    auto left = pool.Run([&pool, data, half]() { return ParallelSum(pool, data, half); });
+    const std::uint64_t right = ParallelSum(pool, data + half, count - half);
+    return left.Get() + right;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t workers = argc > 1 ? static_cast<std::size_t>(std::atoi(argv[1])) : 0;
+    TaskPool pool(workers, "Bench");
+    std::printf("TaskPool benchmark (%zu workers)\n\n", pool.WorkerCount());
+    bool ok = true;
+
+    // ========== Throughput ==========
+    {
+        constexpr int kTasks = 200000;
+        std::atomic<int> remaining{kTasks};
+        auto start = Clock::now();
+        for (int i = 0; i < kTasks; ++i) {
+            pool.Post([&remaining]() { remaining.fetch_sub(1, std::memory_order_acq_rel); });
+        }
+        while (remaining.load(std::memory_order_acquire) > 0) {
+            std::this_thread::yield();
+        }
+        const double ms = ElapsedMs(start);
+        std::printf("Throughput   %d tasks: %8.2f ms (%.1f ns/task)\n", kTasks, ms, ms * 1e6 / kTasks);
+    }
+
+    // ========== Fork-join ==========
+    {
+        std::vector<std::uint32_t> data(1 << 24);
+        std::iota(data.begin(), data.end(), 0u);
+        auto start = Clock::now();
+        const auto serial = std::accumulate(data.begin(), data.end(), std::uint64_t{0});
+        const double serialMs = ElapsedMs(start);
+
+        start = Clock::now();
+        const auto parallel = pool.Run([&]() { return ParallelSum(pool, data.data(), data.size()); }).Get();
+        const double parallelMs = ElapsedMs(start);
+        ok = ok && serial == parallel;
+        std::printf("Fork-join    serial %8.2f ms  pool %8.2f ms  %s\n", serialMs, parallelMs,
+                    serial == parallel ? "ok" : "MISMATCH");
+    }
+
+    // ========== Frame：UI 线程的最长帧时间 ==========
+    {
+        constexpr int kImages = 64;
+        constexpr auto kDecode = std::chrono::microseconds(4000);
+
+        // 同步：全部在 UI 线程执行
+        auto start = Clock::now();
+        std::uint64_t sink = 0;
+        for (int i = 0; i < kImages; ++i) {
+            sink += Burn(kDecode);
+        }
+        const double syncFrameMs = ElapsedMs(start);
+
+        // 异步：线程池解码，结果回到 UI 线程
+        auto ui = std::make_shared<Dispatcher>("UI");
+        ui->BindToCurrentThread();
+        int delivered = 0;
+        bool onUiThread = true;
+        start = Clock::now();
+        for (int i = 0; i < kImages; ++i) {
+            pool.Run([]() { return Burn(kDecode); })
+                .Then(ui, [&](std::uint64_t& value) {
+                    onUiThread = onUiThread && ui->HasThreadAccess();
+                    sink += value;
+                    ++delivered;
+                });
+        }
+        double maxFrameMs = ElapsedMs(start);
+        int frames = 0;
+        while (delivered < kImages) {
+            const auto frameStart = Clock::now();
+            ui->ProcessPendingTasks();
+            maxFrameMs = std::max(maxFrameMs, ElapsedMs(frameStart));
+            ++frames;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double totalMs = ElapsedMs(start);
+        ok = ok && onUiThread;
+        std::printf("Frame        %d x %lldus decode: sync blocks UI %8.2f ms | pool %8.2f ms total, "
+                    "longest UI frame %.3f ms over %d frames, continuations on UI thread %s\n",
+                    kImages, static_cast<long long>(kDecode.count()), syncFrameMs, totalMs, maxFrameMs, frames,
+                    onUiThread ? "ok" : "WRONG");
+        g_sink = sink;
+    }
+
+    // ========== Continuation：失败与取消的传递 ==========
+    {
+        auto faulted = pool.Run([]() -> int { throw std::runtime_error("decode failed"); })
+                           .Then([](int& value) { return value * 2; });
+        faulted.Wait();
+        bool faultOk = faulted.GetStatus() == TaskStatus::Faulted;
+
+        bool observed = false;
+        auto handled = pool.Run([]() -> int { throw std::runtime_error("decode failed"); })
+                           .Then([&](TaskHandle<int> antecedent) {
+                               observed = antecedent.GetStatus() == TaskStatus::Faulted;
+                               return 0;
+                           });
+        handled.Wait();
+        faultOk = faultOk && observed && handled.GetStatus() == TaskStatus::Completed;
+
+        // 关闭的线程池：任务与后续任务都被取消
+        TaskPool stopped(1, "Stopped");
+        stopped.Shutdown();
+        auto canceled = stopped.Run([]() { return 1; });
+        auto next = canceled.Then([](int& value) { return value; });
+        next.Wait();
+        const bool cancelOk = canceled.GetStatus() == TaskStatus::Canceled && next.GetStatus() == TaskStatus::Canceled;
+
+        ok = ok && faultOk && cancelOk;
+        std::printf("Continuation fault propagation %s, cancel propagation %s\n", faultOk ? "ok" : "WRONG",
+                    cancelOk ? "ok" : "WRONG");
+    }
+
+    const auto stats = pool.GetStatistics();
+    std::printf("\nsubmitted %llu  executed %llu  stolen %llu\n", static_cast<unsigned long long>(stats.submitted),
+                static_cast<unsigned long long>(stats.executed), static_cast<unsigned long long>(stats.stolen));
+    return ok ? 0 : 1;
+}
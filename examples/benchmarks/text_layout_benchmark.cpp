@@ -0,0 +1,182 @@
+/**
+ * @file text_layout_benchmark.cpp
+ * @brief TextBlock 共享排版（render::TextLayout）基准测试
+ *
+ * 无头窗口（SoftwareRenderer）中显示大量自动换行的段落：
+ * - Recolor：每帧改变所有段落的颜色（重新收集绘制命令并重绘），排版结果应全部复用，
+ *   对比每帧为每个段落排版两次（旧行为：测量一次，渲染器绘制时再分行、换行一次）的耗时
+ * - Change：只修改一个段落的文本时，只有这个段落重新排版
+ * - Pixels：逐帧变色的结果与直接渲染最终状态一致
+ *
+ * 用法：text_layout_benchmark [帧数] [段落数]
+ */
+
+#include "fk/ui/Window.h"
+#include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/text/TextBlock.h"
+#include "fk/ui/graphics/Brush.h"
+#include "fk/render/SoftwareRenderer.h"
+#include "fk/render/TextLayout.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace fk;
+using namespace fk::ui;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr float kWindowWidth = 640.0f;
+constexpr float kWindowHeight = 480.0f;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string Paragraph(int index) {
+    std::string text = "Paragraph " + std::to_string(index) + ": ";
+    for (int i = 0; i < 6; ++i) {
+        text += "The quick brown fox jumps over the lazy dog. ";
+    }
+    if (index % 4 == 0) {
+        text += "\nSecond line after a hard break.";
+    }
+    return text;
+}
+
+struct Document {
+    std::shared_ptr<Window> window;
+    std::vector<TextBlock*> blocks;
+};
+
+Document ShowDocument(int paragraphs) {
+    Document document;
+    document.window = std::make_shared<Window>();
+    document.window->Width(kWindowWidth)->Height(kWindowHeight)->Background(new SolidColorBrush(255, 255, 255, 255));
+    document.window->SetHeadless(true);
+
+    auto* panel = new StackPanel();
+    for (int i = 0; i < paragraphs; ++i) {
+        auto* block = new TextBlock();
+        block->Text(Paragraph(i));
+        block->FontSize(14.0f);
+        block->TextWrapping(ui::TextWrapping::Wrap);
+        block->Width(300.0f + static_cast<float>(i % 3) * 50.0f);
+        block->Foreground(new SolidColorBrush(0, 0, 0, 255));
+        panel->AddChild(block);
+        document.blocks.push_back(block);
+    }
+    document.window->Content(panel);
+    document.window->Show();
+    document.window->RenderFrame();
+    return document;
+}
+
+void Recolor(const Document& document, int frame) {
+    const auto shade = static_cast<std::uint8_t>((frame * 37) % 200);
+    for (auto* block : document.blocks) {
+        block->Foreground(new SolidColorBrush(shade, 0, 0, 255));
+        block->InvalidateVisual();
+    }
+}
+
+// 排版结果与上次记录不同的段落数
+std::size_t CountRelayouts(const Document& document, std::vector<const render::TextLayout*>& layouts) {
+    std::size_t changed = 0;
+    layouts.resize(document.blocks.size(), nullptr);
+    for (std::size_t i = 0; i < document.blocks.size(); ++i) {
+        const auto* layout = document.blocks[i]->GetTextLayout().get();
+        if (layout != layouts[i]) {
+            ++changed;
+            layouts[i] = layout;
+        }
+    }
+    return changed;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 100;
+    const int paragraphs = argc > 2 ? std::atoi(argv[2]) : 200;
+    std::printf("Text layout benchmark (%d frames, %d paragraphs)\n\n", frames, paragraphs);
+    bool ok = true;
+
+    auto document = ShowDocument(paragraphs);
+    auto* provider = document.window->GetHeadlessRenderer()->GetGlyphMetrics();
+    std::vector<const render::TextLayout*> layouts;
+    CountRelayouts(document, layouts);
+
+    // ========== Recolor：排版结果跨帧复用 ==========
+    std::size_t relayouts = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < frames; ++i) {
+        Recolor(document, i);
+        document.window->RenderFrame();
+        relayouts += CountRelayouts(document, layouts);
+    }
+    const double sharedMs = ElapsedMs(start) / frames;
+
+    // 旧行为每帧多出的排版：测量与绘制各一次
+    start = Clock::now();
+    std::size_t glyphs = 0;
+    for (int i = 0; i < frames; ++i) {
+        for (auto* block : document.blocks) {
+            const auto& layout = block->GetTextLayout();
+            for (int pass = 0; pass < 2; ++pass) {
+                const auto relaid = render::TextLayout::Create(*provider, layout->GetFontId(), layout->GetFontFamily(),
+                                                               layout->GetText(), layout->GetFontSize(),
+                                                               block->GetRenderSize().width);
+                glyphs += relaid->GetGlyphs().size();
+            }
+        }
+    }
+    const double relayoutMs = ElapsedMs(start) / frames;
+    ok = ok && relayouts == 0;
+    std::printf("Recolor    %8.3f ms/frame, %zu re-layouts over %d frames\n", sharedMs, relayouts, frames);
+    std::printf("Re-layout  %8.3f ms/frame extra when laying out twice per frame (%zu glyphs/frame)\n", relayoutMs,
+                glyphs / static_cast<std::size_t>(frames));
+
+    // ========== Change：只有修改的段落重新排版 ==========
+    document.blocks[paragraphs / 2]->Text(std::string("Changed paragraph"));
+    document.window->RenderFrame();
+    const std::size_t changed = CountRelayouts(document, layouts);
+    ok = ok && changed == 1;
+    std::printf("Change     one paragraph edited: %zu re-layouts %s\n", changed, changed == 1 ? "ok" : "WRONG");
+
+    // ========== Remeasure：经属性系统（绑定、样式）改字号也会重新测量 ==========
+    auto* resized = document.blocks[1];
+    const float oldHeight = resized->GetDesiredSize().height;
+    resized->SetValue(TextBlock::FontSizeProperty(), 28.0f);
+    document.window->RenderFrame();
+    const float newHeight = resized->GetDesiredSize().height;
+    resized->SetValue(TextBlock::FontSizeProperty(), 14.0f);
+    document.window->RenderFrame();
+    const bool remeasured = newHeight > oldHeight && resized->GetDesiredSize().height == oldHeight;
+    ok = ok && remeasured;
+    std::printf("Remeasure  font size set through the property system: %s\n", remeasured ? "ok" : "WRONG");
+
+    // ========== Pixels：逐帧变色与直接渲染一致 ==========
+    auto reference = ShowDocument(paragraphs);
+    document.blocks[paragraphs / 2]->Text(Paragraph(paragraphs / 2));
+    Recolor(document, frames);
+    document.window->RenderFrame();
+    Recolor(reference, frames);
+    reference.window->RenderFrame();
+    const std::size_t diff = render::SoftwareRenderer::CompareImages(
+        document.window->GetHeadlessRenderer()->GetPixels().data(),
+        reference.window->GetHeadlessRenderer()->GetPixels().data(),
+        static_cast<std::size_t>(kWindowWidth * kWindowHeight), 0);
+    ok = ok && diff == 0;
+    std::printf("Pixels     recolored frames match direct render: %zu pixels differ\n", diff);
+
+    document.window->Close();
+    reference.window->Close();
+    return ok ? 0 : 1;
+}
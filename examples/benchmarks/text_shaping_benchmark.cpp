@@ -0,0 +1,192 @@
+/**
+ * @file text_shaping_benchmark.cpp
+ * @brief 文本整形与整形缓存（render::ShapeRunCache）基准测试
+ *
+ * 使用 SoftwareRenderer 的字形缓存作为度量来源：
+ * - Kerning：字距调整后的行宽（AV、To 等字偶）与不调整时对比
+ * - Ligatures：拉丁文 fi/fl 连字与阿拉伯文连接形式、lam-alef 连字
+ * - Bidi：混合从左到右与从右到左文本的视觉顺序
+ * - Cache：大量段落以不同宽度重新排版，对比整形缓存命中与每次重新整形的耗时
+ *
+ * 用法：text_shaping_benchmark [重复次数] [段落数]
+ */
+
+#include "fk/render/SoftwareRenderer.h"
+#include "fk/render/TextLayout.h"
+#include "fk/render/TextShaping.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace fk::render;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+std::string Paragraph(int index) {
+    static const char* sentences[] = {
+        "The quick brown fox jumps over the lazy dog. ",
+        "AVATAR Today: WAVE office traffic flows officially. ",
+        "مرحبا بالعالم السلام عليكم ",
+        "Version 2.5 costs $30 (approx.) per seat. ",
+    };
+    std::string text = "Paragraph " + std::to_string(index) + ": ";
+    for (int i = 0; i < 6; ++i) {
+        text += sentences[(index + i) % 4];
+    }
+    return text;
+}
+
+std::size_t CountGlyphs(const TextLayout& layout, char32_t first, char32_t last) {
+    std::size_t count = 0;
+    for (const auto& glyph : layout.GetGlyphs()) {
+        count += glyph.codepoint >= first && glyph.codepoint <= last ? 1 : 0;
+    }
+    return count;
+}
+
+// HarfBuzz 整形（FK_HAS_HARFBUZZ）以字形索引输出连字与上下文形式
+std::size_t CountGlyphIndices(const TextLayout& layout) {
+    std::size_t count = 0;
+    for (const auto& glyph : layout.GetGlyphs()) {
+        count += IsGlyphIndex(glyph.codepoint) ? 1 : 0;
+    }
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 20;
+    const int paragraphs = argc > 2 ? std::atoi(argv[2]) : 200;
+    std::printf("Text shaping benchmark (%d iterations, %d paragraphs)\n\n", iterations, paragraphs);
+    bool ok = true;
+
+    SoftwareRenderer renderer;
+    RendererInitParams params;
+    params.initialSize.width = 64;
+    params.initialSize.height = 64;
+    renderer.Initialize(params);
+    auto& provider = *renderer.GetGlyphMetrics();
+    const int fontId = provider.ResolveFont("sans-serif", 16.0f, 400, false);
+    if (fontId < 0) {
+        std::printf("No fonts found\n");
+        return 1;
+    }
+    auto layout = [&](const std::string& text, ShapingFeatures features, float maxWidth = 0.0f) {
+        return TextLayout::Create(provider, fontId, "sans-serif", text, 16.0f, maxWidth, features);
+    };
+
+    // ========== Kerning：字偶间距 ==========
+    const std::string kernText = "AVATAR To Ty WAVE";
+    const float kerned = layout(kernText, ShapingFeatures::Kerning)->GetWidth();
+    const float plain = layout(kernText, ShapingFeatures::None)->GetWidth();
+    ok = ok && kerned < plain;
+    std::printf("Kerning    \"%s\": %.2f px kerned, %.2f px without kerning\n", kernText.c_str(), kerned, plain);
+
+    // ========== Ligatures：拉丁文连字与阿拉伯文连接形式 ==========
+    const auto latin = layout("office fluffy flow", ShapingFeatures::Default);
+    const std::size_t latinLigatures = CountGlyphs(*latin, 0xFB00, 0xFB04);
+    const auto arabic = layout("السلام عليكم", ShapingFeatures::Default);
+    const std::size_t arabicForms = CountGlyphs(*arabic, 0xFE70, 0xFEFC);
+    const std::size_t lamAlef = CountGlyphs(*arabic, 0xFEF5, 0xFEFC);
+    const std::size_t arabicBase = CountGlyphs(*arabic, 0x0621, 0x064A);
+    const std::size_t latinIndices = CountGlyphIndices(*latin);
+    const std::size_t arabicIndices = CountGlyphIndices(*arabic);
+    if (latinIndices + arabicIndices > 0) {
+        // 连字合并字符，阿拉伯文的连接形式来自字体的 GSUB
+        const bool merged = latin->GetGlyphs().size() < std::string_view("office fluffy flow").size();
+        ok = ok && merged && arabicIndices > 0;
+        std::printf("Ligatures  HarfBuzz: \"office fluffy flow\" %zu glyphs, \"السلام عليكم\" %zu substituted glyphs\n",
+                    latin->GetGlyphs().size(), arabicIndices);
+    } else {
+        ok = ok && latinLigatures == 4 && lamAlef == 1 && arabicBase == 0;
+        std::printf("Ligatures  \"office fluffy flow\": %zu ligature glyphs\n", latinLigatures);
+        std::printf("           \"السلام عليكم\": %zu presentation forms (%zu lam-alef), %zu unjoined letters\n",
+                    arabicForms, lamAlef, arabicBase);
+    }
+
+    // ========== Marks：组合标记 ==========
+    // 组合标记不前进；HarfBuzz 整形时按 GPOS（或回退的标记定位）给出相对笔位置的偏移
+    const auto marked = layout("q\u0301", ShapingFeatures::Default);
+    const auto& markGlyphs = marked->GetGlyphs();
+    bool markPlaced = markGlyphs.size() == 2 && markGlyphs[1].cluster == 1 && markGlyphs[1].advance == 0.0f;
+    const bool markOffset = markPlaced && (markGlyphs[1].xOffset != 0.0f || markGlyphs[1].yOffset != 0.0f);
+    const bool harfBuzz = CountGlyphIndices(*latin) + CountGlyphIndices(*arabic) > 0;
+    markPlaced = markPlaced && (harfBuzz ? markOffset : !markOffset);
+    ok = ok && markPlaced;
+    std::printf("Marks      \"q\u0301\": mark attached to its base: %s (offset %.2f, %.2f px)\n",
+                markPlaced ? "yes" : "NO", markGlyphs.size() == 2 ? markGlyphs[1].xOffset : 0.0f,
+                markGlyphs.size() == 2 ? markGlyphs[1].yOffset : 0.0f);
+
+    // ========== Bidi：视觉顺序 ==========
+    // 阿拉伯文单词内字符的视觉位置随逻辑顺序递减，拉丁文递增，阿拉伯文单词整体位于两个拉丁文单词之间
+    const auto mixed = layout("Hello مرحبا world", ShapingFeatures::Default);
+    const auto& glyphs = mixed->GetGlyphs();
+    bool visualOrder = mixed->GetLines().size() == 1 && mixed->GetLines()[0].direction == TextDirection::LeftToRight;
+    for (std::size_t i = 1; i < glyphs.size(); ++i) {
+        visualOrder = visualOrder && glyphs[i].x >= glyphs[i - 1].x;
+        const bool rightToLeft = glyphs[i].cluster >= 6 && glyphs[i].cluster < 11;
+        const bool previousRightToLeft = glyphs[i - 1].cluster >= 6 && glyphs[i - 1].cluster < 11;
+        if (rightToLeft && previousRightToLeft) {
+            visualOrder = visualOrder && glyphs[i].cluster < glyphs[i - 1].cluster;
+        } else {
+            visualOrder = visualOrder && glyphs[i].cluster > glyphs[i - 1].cluster;
+        }
+    }
+    const auto hebrew = layout("שלום (world) 123", ShapingFeatures::Default);
+    const bool hebrewBase = hebrew->GetLines()[0].direction == TextDirection::RightToLeft;
+    ok = ok && visualOrder && hebrewBase;
+    std::printf("Bidi       mixed paragraph in visual order: %s, Hebrew paragraph direction: %s\n",
+                visualOrder ? "yes" : "NO", hebrewBase ? "right-to-left" : "WRONG");
+
+    // ========== Cache：重新排版时复用整形结果 ==========
+    std::vector<std::string> texts;
+    for (int i = 0; i < paragraphs; ++i) {
+        texts.push_back(Paragraph(i));
+    }
+    auto relayout = [&]() {
+        std::size_t lines = 0;
+        for (int pass = 0; pass < iterations; ++pass) {
+            const float width = 240.0f + static_cast<float>(pass % 5) * 40.0f;
+            for (const auto& text : texts) {
+                lines += layout(text, ShapingFeatures::Default, width)->GetLines().size();
+            }
+        }
+        return lines;
+    };
+
+    auto& cache = provider.GetShapeCache();
+    cache.Clear();
+    relayout();  // 预热字形缓存
+    const auto hitsBefore = cache.GetHits();
+    const auto missesBefore = cache.GetMisses();
+    auto start = Clock::now();
+    const std::size_t cachedLines = relayout();
+    const double cachedMs = ElapsedMs(start) / iterations;
+    const auto hits = cache.GetHits() - hitsBefore;
+    const auto misses = cache.GetMisses() - missesBefore;
+    const std::size_t runs = cache.GetSize();
+
+    cache.SetCapacity(0);
+    start = Clock::now();
+    const std::size_t uncachedLines = relayout();
+    const double uncachedMs = ElapsedMs(start) / iterations;
+    cache.SetCapacity(ShapeRunCache::kDefaultCapacity);
+
+    ok = ok && cachedLines == uncachedLines && misses == 0;
+    std::printf("Cache      %8.3f ms/pass with shape cache (%llu hits, %llu misses, %zu runs)\n", cachedMs,
+                static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses), runs);
+    std::printf("           %8.3f ms/pass shaping every run\n", uncachedMs);
+
+    renderer.Shutdown();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file texture_manager_benchmark.cpp
+ * @brief render::TextureManager 基准测试
+ *
+ * TextureManager 只做记账，不调用 OpenGL，这里用假的纹理 ID 模拟：
+ * - Scroll：在包含大量不同 CJK 字形和图片的长列表中滚动，每帧使用一屏内容。
+ *   对比不限预算（旧行为：纹理只增不减）与 64MB 预算时的驻留字节数
+ * - Pinned：被渲染列表引用（AddRef）的纹理在超出预算时也不会被淘汰
+ * - Retire：退役的纹理等引用归零后才删除
+ * - Touch：每次 Touch 的开销
+ *
+ * 用法：texture_manager_benchmark [帧数]
+ */
+
+#include <fk/render/TextureManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+using namespace fk::render;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr std::size_t kMB = 1024 * 1024;
+constexpr std::size_t kGlyphPageBytes = 1024 * 1024;         // 1024x1024 灰度图集页
+constexpr int kGlyphsPerPage = 3600;                          // 16px CJK 字形约 17x17
+constexpr std::size_t kImageBytes = 512 * 512 * 4;            // 512x512 RGBA 缩略图
+constexpr int kRowsPerScreen = 20;
+constexpr int kGlyphsPerRow = 40;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+/**
+ * @brief 模拟字形图集与图片缓存：纹理不存在时"上传"并登记，被淘汰时清除
+ */
+class Scene {
+public:
+    explicit Scene(TextureManager& manager) : manager_(manager) {}
+
+    ~Scene() {
+        for (const auto& [key, id] : resident_) {
+            manager_.Unregister(id);
+        }
+    }
+
+    // 返回纹理 ID，必要时创建
+    std::uint32_t Use(std::uint64_t key, std::size_t bytes) {
+        auto it = resident_.find(key);
+        if (it == resident_.end()) {
+            const std::uint32_t id = nextId_++;
+            it = resident_.emplace(key, id).first;
+            manager_.Register(id, bytes, [this, key](std::uint32_t) { resident_.erase(key); });
+            manager_.RecordUpload(bytes);
+            ++uploads_;
+        }
+        manager_.Touch(it->second);
+        return it->second;
+    }
+
+    std::size_t Uploads() const { return uploads_; }
+
+private:
+    TextureManager& manager_;
+    std::unordered_map<std::uint64_t, std::uint32_t> resident_;
+    std::uint32_t nextId_{1};
+    std::size_t uploads_{0};
+};
+
+struct ScrollResult {
+    std::size_t peakBytes{0};
+    std::size_t finalBytes{0};
+    std::size_t maxUploadPerFrame{0};
+    std::size_t uploads{0};
+    std::uint64_t evictions{0};
+};
+
+ScrollResult Scroll(TextureManager& manager, std::size_t budget, int frames) {
+    const auto before = manager.GetStatistics();
+    manager.SetBudget(budget);
+    ScrollResult result;
+    {
+        Scene scene(manager);
+        for (int frame = 0; frame < frames; ++frame) {
+            // 每帧滚动半行：每行一张图片和一段文字，文字中的字形逐行变化
+            const int firstRow = frame / 2;
+            for (int row = firstRow; row < firstRow + kRowsPerScreen; ++row) {
+                scene.Use((1ull << 40) | static_cast<std::uint64_t>(row), kImageBytes);
+                for (int i = 0; i < kGlyphsPerRow; ++i) {
+                    const int glyph = row * kGlyphsPerRow / 2 + i;
+                    scene.Use(static_cast<std::uint64_t>(glyph / kGlyphsPerPage), kGlyphPageBytes);
+                }
+            }
+            manager.EndFrame();
+            const auto stats = manager.GetStatistics();
+            result.peakBytes = std::max(result.peakBytes, stats.residentBytes);
+            result.maxUploadPerFrame = std::max(result.maxUploadPerFrame, stats.uploadBytesLastFrame);
+        }
+        result.finalBytes = manager.GetResidentBytes();
+        result.uploads = scene.Uploads();
+    }
+    result.evictions = manager.GetStatistics().evictions - before.evictions;
+    return result;
+}
+
+void PrintScroll(const char* name, const ScrollResult& result) {
+    std::printf("%-10s peak %8.1f MB  final %8.1f MB  uploads %6zu  evictions %6llu  max upload/frame %5.1f MB\n",
+                name, result.peakBytes / double(kMB), result.finalBytes / double(kMB), result.uploads,
+                static_cast<unsigned long long>(result.evictions), result.maxUploadPerFrame / double(kMB));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::atoi(argv[1]) : 20000;
+    auto& manager = TextureManager::Instance();
+    std::printf("TextureManager benchmark (%d frames, %d rows x %d glyphs per screen)\n\n", frames,
+                kRowsPerScreen, kGlyphsPerRow);
+    bool ok = true;
+
+    // ========== Scroll ==========
+    const auto unbounded = Scroll(manager, static_cast<std::size_t>(-1), frames);
+    PrintScroll("Unbounded", unbounded);
+    const auto bounded = Scroll(manager, 64 * kMB, frames);
+    PrintScroll("64MB", bounded);
+    ok = ok && bounded.peakBytes <= 64 * kMB + kImageBytes && unbounded.evictions == 0;
+
+    // ========== Pinned：渲染列表引用的纹理不被淘汰 ==========
+    {
+        manager.SetBudget(4 * kMB);
+        bool pinnedEvicted = false;
+        bool unpinnedEvicted = false;
+        manager.Register(1, 8 * kMB, [&](std::uint32_t) { pinnedEvicted = true; });
+        manager.Register(2, 8 * kMB, [&](std::uint32_t) { unpinnedEvicted = true; });
+        manager.AddRef(1);
+        manager.EndFrame();
+        manager.EndFrame();
+        const bool pinnedOk = !pinnedEvicted && unpinnedEvicted && manager.IsResident(1);
+        manager.Release(1);
+        manager.EndFrame();
+        const bool releasedOk = pinnedEvicted && !manager.IsResident(1);
+        ok = ok && pinnedOk && releasedOk;
+        std::printf("\nPinned     referenced texture kept %s, evicted after release %s\n", pinnedOk ? "ok" : "WRONG",
+                    releasedOk ? "ok" : "WRONG");
+    }
+
+    // ========== Retire：引用归零后才删除 ==========
+    {
+        manager.SetBudget(64 * kMB);
+        int deleted = 0;
+        manager.Register(3, kMB, [&](std::uint32_t) { ++deleted; });
+        manager.AddRef(3);
+        manager.AddRef(3);
+        manager.Retire(3);
+        const bool deferred = deleted == 0 && manager.IsResident(3);
+        manager.Release(3);
+        manager.Release(3);
+        const bool retireOk = deferred && deleted == 1 && !manager.IsResident(3);
+        ok = ok && retireOk;
+        std::printf("Retire     deleted after last reference %s\n", retireOk ? "ok" : "WRONG");
+    }
+
+    // ========== Touch 开销 ==========
+    {
+        constexpr std::uint32_t kTextures = 4096;
+        constexpr int kTouches = 4000000;
+        for (std::uint32_t id = 100; id < 100 + kTextures; ++id) {
+            manager.Register(id, 4096, nullptr);
+        }
+        auto start = Clock::now();
+        std::uint32_t id = 0;
+        for (int i = 0; i < kTouches; ++i) {
+            id = (id * 1103515245u + 12345u);
+            manager.Touch(100 + (id >> 8) % kTextures);
+            if ((i & 1023) == 0) {
+                manager.EndFrame();
+            }
+        }
+        const double ms = ElapsedMs(start);
+        for (std::uint32_t texture = 100; texture < 100 + kTextures; ++texture) {
+            manager.Unregister(texture);
+        }
+        std::printf("Touch      %.1f ns/call over %u textures\n", ms * 1e6 / kTouches, kTextures);
+    }
+
+    const auto stats = manager.GetStatistics();
+    std::printf("\nresident %zu bytes, %zu textures, total uploaded %.1f MB\n", stats.residentBytes,
+                stats.textureCount, stats.uploadBytesTotal / double(kMB));
+    return ok ? 0 : 1;
+}
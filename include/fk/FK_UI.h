@@ -37,6 +37,7 @@
 #include "fk/ui/base/Visual.h"
 #include "fk/ui/base/UIElement.h"
 #include "fk/ui/base/FrameworkElement.h"
+#include "fk/ui/base/LayoutManager.h"
 
 // UI 模块
 #include "fk/Controls"
@@ -26,6 +26,9 @@ public:
     
     // 清除所有动画
     void Clear();
+    
+    // 是否存在正在运行（未暂停）的动画，用于判断消息循环能否进入空闲等待
+    bool HasActiveAnimations() const;
 
 private:
     AnimationManager() = default;
@@ -35,7 +38,7 @@ private:
     AnimationManager& operator=(const AnimationManager&) = delete;
     
     std::vector<Timeline*> activeTimelines_;
-    std::mutex mutex_;
+    mutable std::mutex mutex_;
     std::chrono::steady_clock::time_point lastUpdateTime_;
     bool initialized_{false};
 };
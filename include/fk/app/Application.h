@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "fk/core/Event.h"
+#include "fk/core/Dispatcher.h"
 #include "fk/ui/Window.h"
 
 namespace fk {
@@ -47,10 +48,18 @@ public:
     ui::WindowPtr GetWindow(const std::string& name) const;
     ui::WindowPtr GetMainWindow() const { return mainWindow_; }
 
+    /**
+     * @brief 获取 UI 线程调度器
+     * 
+     * 由消息循环驱动：投递的任务和到期的定时器会唤醒空闲等待并在下一帧之前执行
+     */
+    const std::shared_ptr<core::Dispatcher>& GetDispatcher() const { return dispatcher_; }
+
 private:
     static Application* instance_;
     std::unordered_map<std::string, ui::WindowPtr> windows_;
     ui::WindowPtr mainWindow_;
+    std::shared_ptr<core::Dispatcher> dispatcher_;
     bool isRunning_;
 };
 
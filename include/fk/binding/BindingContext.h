@@ -27,7 +27,7 @@ public:
     void SetParent(BindingContext* parent);
     BindingContext* Parent() const noexcept { return parent_; }
 
-    DataContextChangedEvent DataContextChanged;
+    DataContextChangedEvent DataContextChanged{core::EventThreading::SingleThreaded};
 
 private:
     void UpdateEffective();
@@ -4,9 +4,11 @@
 #include "fk/binding/BindingPath.h"
 #include "fk/binding/DependencyObject.h"
 #include "fk/binding/INotifyPropertyChanged.h"
+#include "fk/binding/ValueConverters.h"
 #include "fk/core/Event.h"
 
 #include <any>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,7 +41,12 @@ public:
     ValidationErrorsChangedEvent ValidationErrorsChanged;
 
 private:
+    friend class BindingUpdateQueue;
+
     void EnsureTargetAlive() const;
+    // 源/目标变化时调用：异步绑定或非 UI 线程时排队，否则立即更新
+    void RequestTargetUpdate();
+    void RequestSourceUpdate();
     void InitializeEffectiveSettings();
     void Subscribe();
     void Unsubscribe();
@@ -49,6 +56,7 @@ private:
     bool ShouldListenToSource() const;
     bool ShouldSubscribeToTargetChanges() const;
     void RefreshSourceSubscription();
+    bool QueueIfOffUiThread(bool targetUpdate);
     INotifyPropertyChanged* TryGetNotifier(std::any& holder);
     bool ValidateBeforeSet(const std::any& candidate);
     void SetValidationErrors(std::vector<ValidationResult> errors);
@@ -76,8 +84,12 @@ private:
     std::shared_ptr<INotifyPropertyChanged> sharedNotifierHolder_{};
     INotifyPropertyChanged* rawNotifier_{nullptr};
     std::vector<ValidationResult> validationErrors_{};
-    bool hasPendingTargetUpdate_{false};
-    bool hasPendingSourceUpdate_{false};
+    // 是否已在 BindingUpdateQueue 中排队（可能由工作线程设置）
+    std::atomic<bool> hasPendingTargetUpdate_{false};
+    std::atomic<bool> hasPendingSourceUpdate_{false};
+    // Phase 5.1: 分别缓存源→目标、目标→源方向上选出的默认转换函数
+    DefaultConverterCache targetConverterCache_{};
+    DefaultConverterCache sourceConverterCache_{};
 };
 
 } // namespace fk::binding
@@ -21,14 +21,54 @@ public:
     struct Accessor {
         using Getter = std::function<bool(const std::any&, std::any&)>;
         using Setter = std::function<bool(std::any&, const std::any&)>;
+        using GetterThunk = bool (*)(const std::any&, std::any&);
+        using SetterThunk = bool (*)(std::any&, const std::any&);
 
         Getter getter{};
         Setter setter{};
+
+        // Phase 5.1: RegisterMember 生成的类型化访问函数（普通函数指针，不经过 std::function）
+        GetterThunk getterThunk{nullptr};
+        SetterThunk setterThunk{nullptr};
+
+        bool Get(const std::any& instance, std::any& outValue) const {
+            return getterThunk ? getterThunk(instance, outValue) : getter(instance, outValue);
+        }
+
+        bool Set(std::any& instance, const std::any& value) const {
+            return setterThunk ? setterThunk(instance, value) : setter(instance, value);
+        }
+
+        bool CanGet() const { return getterThunk || getter; }
+        bool CanSet() const { return setterThunk || setter; }
     };
 
+    /**
+     * @brief 注册访问器
+     *
+     * 返回的 Accessor 指针在程序生命周期内保持有效；再次注册同名访问器时原地替换，
+     * 已编译的绑定路径会自动使用新的 getter/setter。
+     */
     static void RegisterAccessor(std::type_index ownerType, std::string name, const Accessor& accessor);
     static const Accessor* FindAccessor(std::type_index ownerType, std::string_view name);
 
+    /**
+     * @brief 通过成员指针注册属性（Phase 5.1）
+     *
+     * Getter 可以是数据成员指针（同时生成 setter）或 const 成员函数指针；
+     * Setter 可以是接受一个参数的成员函数指针。为每种持有方式（值、指针、
+     * shared_ptr、weak_ptr、reference_wrapper）分别生成类型化的访问函数，
+     * 读取时只需一次 any_cast，不经过 std::function。
+     *
+     * 示例：
+     * @code
+     * PropertyAccessorRegistry::RegisterMember<&Cell::value>("Value");
+     * PropertyAccessorRegistry::RegisterMember<&Person::GetName, &Person::SetName>("Name");
+     * @endcode
+     */
+    template<auto Getter, auto Setter = nullptr>
+    static void RegisterMember(std::string name);
+
     template<typename Owner, typename Getter>
     static void RegisterPropertyGetter(std::string name, Getter getter);
 
@@ -51,6 +91,9 @@ private:
     template<typename Owner, typename Func>
     static bool VisitInstance(std::any& instance, Func&& func);
 
+    template<typename Owner, typename Holder, auto Getter, auto Setter>
+    static void RegisterMemberVariant(const std::string& name);
+
     template<typename Owner>
     static constexpr std::type_index TypeIndex() {
         return std::type_index(typeid(Owner));
@@ -88,16 +131,28 @@ public:
     [[nodiscard]] const std::vector<Segment>& Segments() const noexcept { return segments_; }
     [[nodiscard]] const std::string& Raw() const noexcept { return raw_; }
 
+    /**
+     * @brief 沿路径解析源对象上的值
+     *
+     * Phase 5.1: 路径按 (源类型, 路径) 编译为逐段解析好的访问器链并缓存，
+     * 之后只需在每一段比较值类型，不再按名称查找访问器。
+     */
     bool Resolve(const std::any& source, std::any& result) const;
     bool SetValue(std::any& source, const std::any& value) const;
 
 private:
+    struct CompiledPath;
+
     static std::vector<Segment> Parse(const std::string& path);
     static Segment MakePropertySegment(const std::string& token);
     static Segment MakeIndexSegment(std::string_view token);
 
+    bool ResolveSegment(const Segment& segment, const std::any& current, std::any& next) const;
+    bool CompileAndResolve(const std::any& source, std::any& result) const;
+
     std::string raw_;
     std::vector<Segment> segments_;
+    mutable std::shared_ptr<const CompiledPath> compiled_;  // 最近一次使用的编译结果
 };
 
 // Template implementations
@@ -129,6 +184,95 @@ struct MemberFunctionTraits<Return (Owner::*)(Args...) noexcept> : MemberFunctio
 template<typename Owner, typename Return, typename... Args>
 struct MemberFunctionTraits<Return (Owner::*)(Args...) const noexcept> : MemberFunctionTraits<Return (Owner::*)(Args...) const> {};
 
+template<typename Pointer>
+struct MemberDataTraits;
+
+template<typename Owner, typename Value>
+struct MemberDataTraits<Value Owner::*> {
+    using OwnerType = Owner;
+    using ValueType = Value;
+};
+
+// 成员指针（数据成员或成员函数）所属的类型
+template<auto Member, typename Pointer = decltype(Member)>
+using MemberOwner = typename std::conditional_t<std::is_member_function_pointer_v<Pointer>,
+    MemberFunctionTraits<Pointer>, MemberDataTraits<Pointer>>::OwnerType;
+
+// 从 std::any 中的持有者（值、指针、智能指针、引用包装）取得对象并调用 func
+template<typename Owner, typename Holder, typename Func>
+bool VisitHolder(Holder& holder, Func&& func) {
+    using Raw = std::remove_const_t<Holder>;
+    if constexpr (std::is_same_v<Raw, Owner>) {
+        func(holder);
+        return true;
+    } else if constexpr (std::is_pointer_v<Raw>) {
+        if (!holder) {
+            return false;
+        }
+        func(*holder);
+        return true;
+    } else if constexpr (std::is_same_v<Raw, std::shared_ptr<Owner>> ||
+                         std::is_same_v<Raw, std::shared_ptr<const Owner>>) {
+        if (!holder) {
+            return false;
+        }
+        func(*holder);
+        return true;
+    } else if constexpr (std::is_same_v<Raw, std::weak_ptr<Owner>> ||
+                         std::is_same_v<Raw, std::weak_ptr<const Owner>>) {
+        auto locked = holder.lock();
+        if (!locked) {
+            return false;
+        }
+        func(*locked);
+        return true;
+    } else {
+        func(holder.get());
+        return true;
+    }
+}
+
+template<typename Owner, typename Holder, auto Getter, auto Setter>
+struct MemberThunks {
+    static bool Get(const std::any& instance, std::any& outValue) {
+        const auto* holder = std::any_cast<Holder>(&instance);
+        if (!holder) {
+            return false;
+        }
+        return VisitHolder<Owner>(*holder, [&](const Owner& owner) {
+            outValue = std::any(std::invoke(Getter, owner));
+        });
+    }
+
+    static bool Set(std::any& instance, const std::any& value) {
+        auto* holder = std::any_cast<Holder>(&instance);
+        if (!holder) {
+            return false;
+        }
+        bool assigned = false;
+        const bool visited = VisitHolder<Owner>(*holder, [&](auto& owner) {
+            if constexpr (!std::is_const_v<std::remove_reference_t<decltype(owner)>>) {
+                if constexpr (std::is_null_pointer_v<decltype(Setter)>) {
+                    // 数据成员直接赋值
+                    using ValueType = typename MemberDataTraits<decltype(Getter)>::ValueType;
+                    if (const auto* typed = std::any_cast<ValueType>(&value)) {
+                        owner.*Getter = *typed;
+                        assigned = true;
+                    }
+                } else {
+                    using Traits = MemberFunctionTraits<decltype(Setter)>;
+                    using ArgumentType = std::remove_cvref_t<std::tuple_element_t<0, typename Traits::ArgumentTuple>>;
+                    if (const auto* typed = std::any_cast<ArgumentType>(&value)) {
+                        std::invoke(Setter, owner, *typed);
+                        assigned = true;
+                    }
+                }
+            }
+        });
+        return visited && assigned;
+    }
+};
+
 } // namespace detail
 
 template<typename Owner, typename Getter>
@@ -197,6 +341,37 @@ void PropertyAccessorRegistry::RegisterProperty(std::string name, Getter getter)
     RegisterPropertyGetter<Owner>(std::move(name), std::move(getter));
 }
 
+template<auto Getter, auto Setter>
+void PropertyAccessorRegistry::RegisterMember(std::string name) {
+    using Owner = detail::MemberOwner<Getter>;
+    // typeid 忽略顶层 const，const Owner 与 Owner 共用同一个键；只注册可写的值持有方式
+    RegisterMemberVariant<Owner, Owner, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, Owner*, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, const Owner*, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, std::shared_ptr<Owner>, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, std::shared_ptr<const Owner>, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, std::weak_ptr<Owner>, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, std::weak_ptr<const Owner>, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, std::reference_wrapper<Owner>, Getter, Setter>(name);
+    RegisterMemberVariant<Owner, std::reference_wrapper<const Owner>, Getter, Setter>(name);
+}
+
+template<typename Owner, typename Holder, auto Getter, auto Setter>
+void PropertyAccessorRegistry::RegisterMemberVariant(const std::string& name) {
+    using Thunks = detail::MemberThunks<Owner, Holder, Getter, Setter>;
+    constexpr bool hasSetter = !std::is_null_pointer_v<decltype(Setter)> ||
+                               std::is_member_object_pointer_v<decltype(Getter)>;
+
+    Accessor accessor;
+    accessor.getterThunk = &Thunks::Get;
+    accessor.getter = accessor.getterThunk;
+    if constexpr (hasSetter) {
+        accessor.setterThunk = &Thunks::Set;
+        accessor.setter = accessor.setterThunk;
+    }
+    RegisterAccessor(TypeIndex<Holder>(), name, accessor);
+}
+
 template<typename Owner>
 void PropertyAccessorRegistry::RegisterVariants(const std::string& name, const Accessor& accessor) {
     RegisterAccessor(TypeIndex<Owner>(), name, accessor);
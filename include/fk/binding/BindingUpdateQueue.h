@@ -0,0 +1,92 @@
+#pragma once
+
+#include "fk/core/Dispatcher.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fk::binding {
+
+class BindingExpression;
+
+/**
+ * @brief 绑定更新队列（Phase 5.1）
+ *
+ * 收集待执行的绑定更新，每帧在 UI 线程上统一执行一次：
+ * - 按绑定表达式去重：两次刷新之间源属性变化多少次，目标都只更新一次
+ * - 通过 UI 线程的 Dispatcher 投递一次刷新任务，消息循环在布局和渲染之前执行；
+ *   Window 在布局前也会主动刷新一次
+ * - 可以在任意线程入队（例如在工作线程中修改 ViewModel）
+ *
+ * 没有设置 Dispatcher 时（如单元测试、无头渲染工具），入队的更新需要调用 Flush 执行。
+ */
+class BindingUpdateQueue {
+public:
+    static BindingUpdateQueue& Instance();
+
+    BindingUpdateQueue(const BindingUpdateQueue&) = delete;
+    BindingUpdateQueue& operator=(const BindingUpdateQueue&) = delete;
+
+    /**
+     * @brief 设置执行刷新的 UI 线程调度器（Application 构造时设置）
+     */
+    void SetDispatcher(std::shared_ptr<core::Dispatcher> dispatcher);
+    std::shared_ptr<core::Dispatcher> GetDispatcher() const;
+
+    /**
+     * @brief 刷新任务的投递优先级（默认 Normal）
+     */
+    void SetPriority(core::Dispatcher::Priority priority);
+    core::Dispatcher::Priority GetPriority() const;
+
+    /**
+     * @brief 当前线程能否直接执行绑定更新（UI 线程或未设置 Dispatcher）
+     */
+    bool HasThreadAccess() const;
+
+    /**
+     * @brief 将源 → 目标的更新加入队列（同一表达式已在队列中时忽略）
+     */
+    void EnqueueTargetUpdate(const std::shared_ptr<BindingExpression>& expression);
+
+    /**
+     * @brief 将目标 → 源的更新加入队列（同一表达式已在队列中时忽略）
+     */
+    void EnqueueSourceUpdate(const std::shared_ptr<BindingExpression>& expression);
+
+    /**
+     * @brief 立即执行所有排队的更新，必须在 UI 线程调用
+     * @return 执行的更新数量
+     *
+     * 执行过程中新入队的更新留到下一次刷新。
+     */
+    std::size_t Flush();
+
+    bool HasPendingUpdates() const { return pendingCount_.load(std::memory_order_acquire) > 0; }
+
+private:
+    BindingUpdateQueue() = default;
+
+    struct PendingUpdate {
+        std::weak_ptr<BindingExpression> expression;
+        bool updateTarget;
+    };
+
+    void Enqueue(const std::shared_ptr<BindingExpression>& expression, bool updateTarget);
+
+    mutable std::mutex mutex_;
+    std::vector<PendingUpdate> pending_;
+    std::atomic<std::size_t> pendingCount_{0};
+    bool flushScheduled_{false};
+    std::weak_ptr<core::Dispatcher> dispatcher_;
+    core::Dispatcher::Priority priority_{core::Dispatcher::Priority::Normal};
+};
+
+} // namespace fk::binding
+
+namespace fk {
+    using binding::BindingUpdateQueue;
+}
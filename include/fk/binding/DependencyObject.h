@@ -27,6 +27,13 @@ public:
 
     template<typename T>
     T GetValue(const DependencyProperty& property) const {
+        // Phase 5.1: 类型化快速路径，内联值直接读取，不经过 std::any_cast
+        if constexpr (!std::is_reference_v<T>) {
+            if (const T* value = propertyStore_.TryGetValue<T>(property)) {
+                return *value;
+            }
+        }
+        // 类型不匹配时与之前一样抛出 std::bad_any_cast
         return std::any_cast<T>(GetValue(property));
     }
 
@@ -35,7 +42,18 @@ public:
     template<typename T>
     std::enable_if_t<!std::is_same_v<std::decay_t<T>, Binding>, void>
     SetValue(const DependencyProperty& property, T&& value) {
-        SetValue(property, std::any(std::forward<T>(value)));
+        using ValueType = std::decay_t<T>;
+        if constexpr (PropertyValue::IsInlineType<ValueType>) {
+            // 小型 POD 直接写入内联槽，不构造 std::any
+            ValidateValueType(property, typeid(ValueType));
+            if (property.Metadata().validateCallback) {
+                ValidateValue(property, std::any(value));
+            }
+            propertyStore_.BindOwnerType(typeid(*this));
+            propertyStore_.SetValue(property, PropertyValue::FromInline<ValueType>(value), ValueSource::Local);
+        } else {
+            SetValue(property, std::any(std::forward<T>(value)));
+        }
     }
 
     void SetValue(const DependencyProperty& property, Binding binding);
@@ -79,9 +97,10 @@ public:
     BindingContext& GetBindingContext() noexcept { return bindingContext_; }
     const BindingContext& GetBindingContext() const noexcept { return bindingContext_; }
 
-    PropertyChangedEvent PropertyChanged;
-    BindingChangedEvent BindingChanged;
-    DataContextChangedEvent DataContextChanged;
+    // Phase 5.1: 依赖对象只在 UI 线程中使用，事件不加锁
+    PropertyChangedEvent PropertyChanged{core::EventThreading::SingleThreaded};
+    BindingChangedEvent BindingChanged{core::EventThreading::SingleThreaded};
+    DataContextChangedEvent DataContextChanged{core::EventThreading::SingleThreaded};
 
 protected:
     DependencyObject();
@@ -98,6 +117,7 @@ private:
     void HandleStoreValueChanged(const DependencyProperty& property, const std::any& oldValue, const std::any& newValue, ValueSource oldSource, ValueSource newSource);
 
     static void ValidateValue(const DependencyProperty& property, const std::any& value);
+    static void ValidateValueType(const DependencyProperty& property, const std::type_info& type);
 
     BindingContext bindingContext_;
     DataContextChangedEvent::Connection dataContextChangedConnection_{};
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "fk/binding/INotifyPropertyChanged.h"
+#include "fk/binding/PropertyChangedMarshaller.h"
 
+#include <memory>
 #include <string>
 
 namespace fk::binding {
@@ -10,20 +12,57 @@ namespace fk::binding {
 template<typename T, typename Owner>
 class ObservableProperty;
 
-class ObservableObject : public INotifyPropertyChanged {
+/**
+ * @brief 属性变更通知的线程模式（Phase 5.1）
+ */
+enum class PropertyNotificationMode {
+    Direct,      // 在调用 RaisePropertyChanged 的线程上立即触发
+    Dispatcher   // 非 UI 线程触发的通知经 PropertyChangedMarshaller 封送到 UI 线程，并按属性合并
+};
+
+/**
+ * @note Dispatcher 模式下，可能在工作线程上销毁的对象应由 shared_ptr 持有，
+ *       封送的通知在 UI 线程投递期间通过 weak_from_this 保持对象存活。
+ */
+class ObservableObject : public INotifyPropertyChanged,
+                         public std::enable_shared_from_this<ObservableObject> {
 public:
     ObservableObject() = default;
-    ~ObservableObject() override = default;
+    explicit ObservableObject(PropertyNotificationMode mode) { SetNotificationMode(mode); }
+    ~ObservableObject() override {
+        if (marshalTarget_) {
+            marshalTarget_->owner.store(nullptr, std::memory_order_release);
+        }
+    }
 
     PropertyChangedEvent& PropertyChanged() override { return propertyChanged_; }
 
+    /**
+     * @brief 设置通知模式，应在对象交给其他线程使用之前设置
+     */
+    void SetNotificationMode(PropertyNotificationMode mode) {
+        if (mode == PropertyNotificationMode::Dispatcher && !marshalTarget_) {
+            marshalTarget_ = std::make_shared<PropertyChangedTarget>(this);
+        }
+        mode_ = mode;
+    }
+
+    PropertyNotificationMode GetNotificationMode() const { return mode_; }
+
 protected:
     void RaisePropertyChanged(std::string_view propertyName) {
+        if (mode_ == PropertyNotificationMode::Dispatcher) {
+            auto& marshaller = PropertyChangedMarshaller::Instance();
+            if (!marshaller.HasThreadAccess()) {
+                marshaller.Post(marshalTarget_, propertyName, weak_from_this());
+                return;
+            }
+        }
         propertyChanged_(propertyName);
     }
 
     void RaisePropertyChanged(const std::string& propertyName) {
-        propertyChanged_(propertyName);
+        RaisePropertyChanged(std::string_view(propertyName));
     }
     
     // Allow ObservableProperty to call RaisePropertyChanged
@@ -32,10 +71,13 @@ protected:
 
 private:
     PropertyChangedEvent propertyChanged_;
+    PropertyNotificationMode mode_{PropertyNotificationMode::Direct};
+    std::shared_ptr<PropertyChangedTarget> marshalTarget_;
 };
 
 } // namespace fk::binding
 
 namespace fk {
     using binding::ObservableObject;
+    using binding::PropertyNotificationMode;
 }
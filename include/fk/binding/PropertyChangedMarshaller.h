@@ -0,0 +1,108 @@
+#pragma once
+
+#include "fk/core/Dispatcher.h"
+#include "fk/core/MpscQueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace fk::binding {
+
+class INotifyPropertyChanged;
+struct PropertyIdTable;
+
+/**
+ * @brief 属性变更通知的封送目标（Phase 5.1）
+ *
+ * 由 ObservableObject 持有；对象析构时清空 owner，队列中尚未投递的通知随之失效。
+ */
+struct PropertyChangedTarget {
+    explicit PropertyChangedTarget(INotifyPropertyChanged* owner) : owner(owner) {}
+
+    // 析构线程写入、UI 线程读取
+    std::atomic<INotifyPropertyChanged*> owner;
+    // 所属类型的属性名编号表，第一次投递时按对象的动态类型取得
+    std::atomic<PropertyIdTable*> propertyIds{nullptr};
+    // 已在队列中的属性（按属性名编号的位集合），用于在生产者端合并重复通知
+    std::atomic<std::uint64_t> pendingProperties{0};
+};
+
+/**
+ * @brief 跨线程属性变更通知封送器（Phase 5.1）
+ *
+ * 工作线程触发的 PropertyChanged 通知不在调用线程执行，而是：
+ * - 写入无锁 MPSC 队列（生产者只做原子操作，不获取 UI 线程的锁）
+ * - 按（对象，属性名）合并：同一属性已在队列中时生产者直接返回，
+ *   两次处理之间同一属性变化多少次都只通知一次
+ * - 每批通知只向 UI 线程的 Dispatcher 投递一次处理任务
+ *
+ * 属性名按对象类型编号，每个类型的前 64 个属性可以在生产者端合并。
+ * 由 shared_ptr 持有的对象在投递期间保持强引用；可能在工作线程上销毁的对象
+ * 必须由 shared_ptr 持有。
+ *
+ * 没有设置 Dispatcher 时通知在调用线程直接触发（原先的行为）。
+ * 销毁 Dispatcher 之前需要先调用 SetDispatcher(nullptr)（Application 析构时处理）。
+ */
+class PropertyChangedMarshaller {
+public:
+    static PropertyChangedMarshaller& Instance();
+
+    PropertyChangedMarshaller(const PropertyChangedMarshaller&) = delete;
+    PropertyChangedMarshaller& operator=(const PropertyChangedMarshaller&) = delete;
+
+    /**
+     * @brief 设置 UI 线程调度器（Application 构造时设置）
+     */
+    void SetDispatcher(std::shared_ptr<core::Dispatcher> dispatcher);
+    std::shared_ptr<core::Dispatcher> GetDispatcher() const;
+
+    /**
+     * @brief 当前线程能否直接触发通知（UI 线程或未设置 Dispatcher）
+     */
+    bool HasThreadAccess() const;
+
+    /**
+     * @brief 将一条通知加入队列，任意线程可调用
+     * @param lifetime 对象的弱引用（对象不由 shared_ptr 持有时为空），投递期间据此保持对象存活
+     */
+    void Post(const std::shared_ptr<PropertyChangedTarget>& target, std::string_view propertyName,
+              std::weak_ptr<INotifyPropertyChanged> lifetime = {});
+
+    /**
+     * @brief 在 UI 线程投递所有排队的通知（按对象和属性合并）
+     * @return 实际触发的通知数量
+     */
+    std::size_t Flush();
+
+    bool HasPendingNotifications() const { return !queue_.Empty(); }
+
+private:
+    PropertyChangedMarshaller() = default;
+
+    struct Notification {
+        std::weak_ptr<PropertyChangedTarget> target;
+        std::weak_ptr<INotifyPropertyChanged> lifetime;
+        std::uint32_t propertyId;
+        std::string propertyName;
+    };
+
+    void ScheduleFlush();
+
+    core::MpscQueue<Notification> queue_;
+    std::atomic<bool> flushScheduled_{false};
+    // 生产者每次通知都要判断线程，使用裸指针避免共享引用计数的竞争
+    std::atomic<core::Dispatcher*> uiDispatcher_{nullptr};
+    mutable std::mutex dispatcherMutex_;
+    std::weak_ptr<core::Dispatcher> dispatcher_;
+};
+
+} // namespace fk::binding
+
+namespace fk {
+    using binding::PropertyChangedMarshaller;
+}
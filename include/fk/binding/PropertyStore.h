@@ -2,10 +2,20 @@
 
 #include "fk/binding/DependencyProperty.h"
 
+#include <algorithm>
 #include <any>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
-#include <unordered_map>
+#include <new>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace fk::binding {
 
@@ -19,6 +29,161 @@ enum class ValueSource {
     Local
 };
 
+/**
+ * @brief 属性值槽（Phase 5.1）
+ *
+ * 小型可平凡复制类型（float、double、bool、枚举、指针、Color、Thickness 等，
+ * 不超过 16 字节）直接内联存储，读写都不经过 std::any，也不分配堆内存；
+ * 其他类型退回 std::any。需要 std::any 视图时（变更通知、无类型 GetValue），
+ * 内联值按需装箱并缓存。
+ */
+class PropertyValue {
+public:
+    static constexpr std::size_t kInlineSize = 16;
+
+    template<typename T>
+    static constexpr bool IsInlineType = std::is_trivially_copyable_v<T> &&
+                                         sizeof(T) <= kInlineSize &&
+                                         alignof(T) <= alignof(std::max_align_t);
+
+    PropertyValue() = default;
+    explicit PropertyValue(std::any value);
+
+    /**
+     * @brief 构造内联值（T 必须满足 IsInlineType）
+     */
+    template<typename T>
+    static PropertyValue FromInline(const T& value) {
+        static_assert(IsInlineType<T>, "Type cannot be stored inline");
+        PropertyValue result;
+        result.type_ = &typeid(T);
+        result.tag_ = &kTypeTag<T>;
+        result.isInline_ = true;
+        result.box_ = [](const unsigned char* storage) {
+            return std::any(*std::launder(reinterpret_cast<const T*>(storage)));
+        };
+        result.equals_ = [](const unsigned char* lhs, const unsigned char* rhs) {
+            const T& a = *std::launder(reinterpret_cast<const T*>(lhs));
+            const T& b = *std::launder(reinterpret_cast<const T*>(rhs));
+            if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+                // 指针可能指向被原地修改的对象，与装箱值一样视为已改变
+                return false;
+            } else if constexpr (requires { { a == b } -> std::convertible_to<bool>; }) {
+                // 算术类型、枚举以及定义了 == 的结构体（Thickness、Color 等）
+                return static_cast<bool>(a == b);
+            } else if constexpr (std::has_unique_object_representations_v<T>) {
+                // 没有填充与浮点成员，逐字节比较与逐成员比较等价
+                return std::memcmp(&a, &b, sizeof(T)) == 0;
+            } else {
+                return false;
+            }
+        };
+        ::new (static_cast<void*>(result.storage_)) T(value);
+        return result;
+    }
+
+    bool HasValue() const noexcept { return type_ != nullptr; }
+    bool IsInline() const noexcept { return isInline_; }
+
+    /**
+     * @brief 类型匹配时返回值的指针，否则返回 nullptr（不抛异常）
+     */
+    template<typename T>
+    const T* TryGet() const noexcept {
+        if constexpr (IsInlineType<T>) {
+            // 快速路径：比较类型标签地址，避免 type_info 的字符串比较
+            if (tag_ == &kTypeTag<T>) {
+                return std::launder(reinterpret_cast<const T*>(storage_));
+            }
+        }
+        if (!type_ || *type_ != typeid(T)) {
+            return nullptr;
+        }
+        if constexpr (IsInlineType<T>) {
+            if (isInline_) {
+                return std::launder(reinterpret_cast<const T*>(storage_));
+            }
+        }
+        return std::any_cast<T>(&boxed_);
+    }
+
+    /**
+     * @brief std::any 视图（内联值首次调用时装箱）
+     */
+    const std::any& AsAny() const;
+
+    /**
+     * @brief 值是否相同
+     *
+     * 内联值按 == 比较（没有 == 时无填充类型逐字节比较），指针与无法比较的类型
+     * 总视为已改变；装箱值与原先一样只比较少数标量类型与字符串。
+     */
+    bool Equals(const PropertyValue& other) const;
+
+private:
+    using BoxFunction = std::any (*)(const unsigned char* storage);
+    using EqualsFunction = bool (*)(const unsigned char* lhs, const unsigned char* rhs);
+
+    // 每个内联类型一个唯一地址（跨共享库时可能不唯一，此时退回 type_info 比较）
+    template<typename T>
+    static constexpr char kTypeTag = 0;
+
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize]{};
+    const std::type_info* type_{nullptr};
+    const void* tag_{nullptr};
+    BoxFunction box_{nullptr};
+    EqualsFunction equals_{nullptr};
+    bool isInline_{false};
+    mutable bool boxedValid_{false};
+    mutable std::any boxed_;
+};
+
+/**
+ * @brief 按类型共享的属性索引表（Phase 5.1）
+ *
+ * 把全局属性 Id 映射为该类型对象内的紧凑槽位编号。同一类型的对象通常设置
+ * 相同的一组属性，共享一张表后每个对象只需一个按槽位索引的数组，
+ * 查找只是两次数组访问，不需要哈希。
+ *
+ * 注意：与 DependencyObject 一样只能在 UI 线程中使用。
+ */
+class PropertyIndexTable {
+public:
+    /**
+     * @brief 获取指定类型的索引表（不存在时创建）
+     */
+    static PropertyIndexTable& ForType(std::type_index type);
+
+    /**
+     * @brief 查找属性的槽位编号，未分配时返回 -1
+     */
+    int Find(std::size_t propertyId) const noexcept {
+        return propertyId < slots_.size() ? slots_[propertyId] : -1;
+    }
+
+    /**
+     * @brief 查找或分配属性的槽位编号
+     */
+    int GetOrAdd(std::size_t propertyId);
+
+    std::size_t GetSlotCount() const noexcept { return static_cast<std::size_t>(slotCount_); }
+
+    /**
+     * @brief 槽位对应的全局属性 Id
+     */
+    std::size_t GetPropertyId(std::size_t slot) const noexcept { return propertyIds_[slot]; }
+
+    std::type_index GetOwnerType() const noexcept { return ownerType_; }
+
+    explicit PropertyIndexTable(std::type_index ownerType) : ownerType_(ownerType) {}
+
+private:
+    std::type_index ownerType_;
+    std::vector<std::int16_t> slots_;   // 属性 Id -> 槽位编号（-1 表示未分配）
+    std::vector<std::size_t> propertyIds_;  // 槽位编号 -> 属性 Id
+    int slotCount_{0};
+};
+
 class PropertyStore {
 public:
     using ValueChangedCallback = std::function<void(const DependencyProperty&, const std::any& oldValue, const std::any& newValue, ValueSource oldSource, ValueSource newSource)>;
@@ -29,7 +194,22 @@ public:
     const std::any& GetValue(const DependencyProperty& property) const;
     ValueSource GetValueSource(const DependencyProperty& property) const;
 
+    /**
+     * @brief 类型化读取（热路径）：类型匹配时返回有效值的指针，否则返回 nullptr
+     */
+    template<typename T>
+    const T* TryGetValue(const DependencyProperty& property) const noexcept {
+        if (const auto* entry = FindEntry(property)) {
+            const auto* value = EffectiveLayer(*entry);
+            if (value && value->HasValue()) {
+                return value->TryGet<T>();
+            }
+        }
+        return std::any_cast<T>(&property.Metadata().defaultValue);
+    }
+
     void SetValue(const DependencyProperty& property, std::any value, ValueSource source);
+    void SetValue(const DependencyProperty& property, PropertyValue value, ValueSource source);
     void ClearValue(const DependencyProperty& property, ValueSource source);
 
     void SetBinding(const DependencyProperty& property, std::shared_ptr<BindingExpression> binding);
@@ -42,37 +222,87 @@ public:
 
     void SetValueChangedCallback(ValueChangedCallback callback);
 
+    /**
+     * @brief 绑定所属对象的类型，使用该类型共享的索引表
+     *
+     * 基类构造函数中写入时对象的动态类型还是基类，构造完成后第一次以最终类型写入时
+     * 把已有条目迁移到最终类型的表；未绑定时使用公共索引表。
+     */
+    void BindOwnerType(std::type_index type) {
+        if (!table_ || table_->GetOwnerType() != type) {
+            RebindTable(type);
+        }
+    }
+
+    /**
+     * @brief 当前使用的索引表（尚未写入时为 nullptr）
+     */
+    const PropertyIndexTable* GetIndexTable() const noexcept { return table_; }
+
 private:
-    struct Layer {
-        bool hasValue{false};
-        std::any value;
+    // 不常用的层（绑定 / 样式 / 继承）只在第一次写入时分配
+    struct ExtraLayers {
+        PropertyValue binding;
+        PropertyValue style;
+        PropertyValue inherited;
+        std::shared_ptr<BindingExpression> bindingExpression;
     };
 
     struct PropertyEntry {
-        Layer local;
-        Layer binding;
-        Layer style;
-        Layer inherited;
-        std::shared_ptr<BindingExpression> bindingExpression;
-        std::any effectiveValue;
-        bool hasEffective{false};
+        PropertyValue local;
+        std::unique_ptr<ExtraLayers> extra;
+        std::uint8_t layerMask{0};          // 已设置的层（按 ValueSource 位）
         ValueSource effectiveSource{ValueSource::Default};
     };
 
     PropertyEntry& EnsureEntry(const DependencyProperty& property);
-    PropertyEntry* FindEntry(const DependencyProperty& property);
-    const PropertyEntry* FindEntry(const DependencyProperty& property) const;
 
-    void UpdateEffectiveValue(const DependencyProperty& property, PropertyEntry& entry);
-    static Layer& SelectLayer(PropertyEntry& entry, ValueSource source);
-    static const Layer& SelectLayer(const PropertyEntry& entry, ValueSource source);
+    PropertyEntry* FindEntry(const DependencyProperty& property) noexcept {
+        return const_cast<PropertyEntry*>(std::as_const(*this).FindEntry(property));
+    }
+
+    const PropertyEntry* FindEntry(const DependencyProperty& property) const noexcept {
+        if (!table_) {
+            return nullptr;
+        }
+        const int slot = table_->Find(property.Id());
+        if (slot < 0 || static_cast<std::size_t>(slot) >= entries_.size()) {
+            return nullptr;
+        }
+        return entries_[static_cast<std::size_t>(slot)].get();
+    }
+
+    void EraseEntry(const DependencyProperty& property);
+    void RebindTable(std::type_index type);
+
+    void UpdateEffectiveValue(const DependencyProperty& property, PropertyEntry& entry,
+                              const PropertyValue& oldValue, ValueSource oldSource);
+    static PropertyValue& SelectLayer(PropertyEntry& entry, ValueSource source);
     static ValueSource DetermineEffectiveSource(const PropertyEntry& entry);
-    static const std::any* TryGetLayerValue(const PropertyEntry& entry, ValueSource source);
-    static bool AreEquivalent(const std::any& lhs, const std::any& rhs);
-    static bool EntryHasAnyValue(const PropertyEntry& entry);
+
+    static const PropertyValue* EffectiveLayer(const PropertyEntry& entry) noexcept {
+        switch (entry.effectiveSource) {
+        case ValueSource::Local:
+            return &entry.local;
+        case ValueSource::Binding:
+            return &entry.extra->binding;
+        case ValueSource::Style:
+            return &entry.extra->style;
+        case ValueSource::Inherited:
+            return &entry.extra->inherited;
+        default:
+            return nullptr;
+        }
+    }
+
+    static constexpr std::uint8_t LayerBit(ValueSource source) noexcept {
+        return static_cast<std::uint8_t>(1u << static_cast<unsigned>(source));
+    }
 
     ValueChangedCallback valueChangedCallback_{};
-    std::unordered_map<std::size_t, PropertyEntry> entries_;
+    PropertyIndexTable* table_{nullptr};
+    // 按槽位编号索引；条目单独分配，变更回调中写入其他属性不会使其地址失效
+    std::vector<std::unique_ptr<PropertyEntry>> entries_;
 };
 
 } // namespace fk::binding
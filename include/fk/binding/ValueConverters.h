@@ -19,6 +19,33 @@ namespace fk::binding {
  */
 bool TryDefaultConvert(const std::any& value, std::type_index targetType, std::any& outResult);
 
+/**
+ * @brief 默认转换函数：返回 false 表示无法转换
+ */
+using DefaultConverter = bool (*)(const std::any& value, std::any& outResult);
+
+/**
+ * @brief 选择 (源类型, 目标类型) 对应的默认转换函数（Phase 5.1）
+ * @return nullptr 表示没有适用的默认规则
+ */
+DefaultConverter FindDefaultConverter(std::type_index sourceType, std::type_index targetType);
+
+/**
+ * @brief 缓存上一次选出的默认转换函数（Phase 5.1）
+ *
+ * 绑定每次刷新时源值类型和目标类型通常都不变，只需比较类型即可复用
+ * 上次选择的转换函数，不必再逐个比较 std::type_index。结果与 TryDefaultConvert 相同。
+ */
+class DefaultConverterCache {
+public:
+    bool Convert(const std::any& value, std::type_index targetType, std::any& outResult);
+
+private:
+    const std::type_info* sourceType_{nullptr};
+    std::type_index targetType_{typeid(void)};
+    DefaultConverter converter_{nullptr};
+};
+
 /**
  * @brief 默认的类型转换器实现，配合 IValueConverter 接口供开发者直接使用。
  */
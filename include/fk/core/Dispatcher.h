@@ -4,13 +4,12 @@
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
-#include <deque>
+#include <cstdint>
 #include <functional>
 #include <exception>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <string>
 #include <thread>
 
@@ -30,6 +29,34 @@ public:
     virtual void WaitForEvents(std::chrono::milliseconds timeout) = 0;
 };
 
+/**
+ * @brief Dispatcher 运行统计（Phase 5.1）
+ *
+ * 计数从构造或上次 ResetStatistics 开始累计；队列深度为读取时的近似值。
+ */
+struct DispatcherStatistics {
+    std::uint64_t posted{0};            // 投递的任务数（含延迟任务）
+    std::uint64_t executed{0};          // 出队的任务数（含已取消而跳过的）
+    std::size_t queueDepth{0};          // 当前就绪队列中的任务数
+    std::size_t queueDepthByPriority[3]{};  // 按 Priority 分别统计
+    std::size_t maxQueueDepth{0};       // 消息循环观察到的最大就绪队列深度
+    std::size_t delayedPending{0};      // 尚未到期的延迟任务数
+    std::chrono::nanoseconds averageLatency{0};  // 从就绪到开始执行的平均等待（抽样统计）
+    std::chrono::nanoseconds maxLatency{0};
+};
+
+/**
+ * @brief 线程消息调度器
+ *
+ * Phase 5.1：
+ * - 每个优先级一条无锁 MPSC 环形队列（满时退回到无锁链表），投递不加锁、不阻塞；
+ *   出队时按 High → Normal → Low 的顺序执行
+ * - 延迟任务先进入无锁收件队列，再由调度线程放入分层时间轮
+ * - DispatcherOperation 的状态对象从对象池分配，等待使用原子等待而非互斥量和条件变量
+ * - 只有调度线程正在等待时，投递才会唤醒它
+ *
+ * ProcessPendingTasks、HasPendingTasks、NextDueTime、WaitForEvents 只能在调度线程调用。
+ */
 class Dispatcher : public std::enable_shared_from_this<Dispatcher> {
 public:
     using Task = std::function<void()>;
@@ -55,38 +82,38 @@ public:
     void Run();
     void Shutdown();
 
+    // 由外部消息循环驱动（不调用 Run）时使用
+    void BindToCurrentThread();
+    std::size_t ProcessPendingTasks();
+    bool HasPendingTasks() const;
+    std::optional<std::chrono::steady_clock::time_point> NextDueTime() const;
+    void WaitForEvents(std::chrono::milliseconds maxWait);
+
     bool HasThreadAccess() const;
     void VerifyAccess() const;
 
     const std::string& Name() const { return name_; }
 
+    DispatcherStatistics GetStatistics() const;
+    void ResetStatistics();
+
 private:
     using OperationState = detail::DispatcherOperationState;
 
     struct QueuedTask;
-    struct ScheduledTask {
-        std::chrono::steady_clock::time_point due;
-        Task task;
-        std::shared_ptr<OperationState> state;
-        Priority priority{Priority::Normal};
-        std::size_t sequence{0};
-    };
-
-    struct ScheduledTaskComparer {
-        bool operator()(const ScheduledTask& lhs, const ScheduledTask& rhs) const noexcept {
-            if (lhs.due == rhs.due) {
-                return lhs.sequence > rhs.sequence;
-            }
-            return lhs.due > rhs.due;
-        }
-    };
+    struct TaskQueues;
 
     void EnqueueTask(Task task, std::shared_ptr<OperationState> state, Priority priority);
     DispatcherOperation EnqueueDelayedTask(Task task, std::chrono::steady_clock::time_point due,
         std::shared_ptr<OperationState> state, Priority priority);
 
+    void PushReady(QueuedTask&& task);
     bool TryDequeue(QueuedTask& outTask);
-    void MoveDueTasksLocked(std::chrono::steady_clock::time_point now);
+    std::size_t BeginBatch();
+    void CollectDueTasks(std::chrono::steady_clock::time_point now);
+    std::size_t ReadyCount() const;
+    bool HasIncomingWork() const;
+    void WaitFor(std::optional<std::chrono::steady_clock::time_point> deadline);
     void WaitForWork();
     void ExecuteTask(QueuedTask& task);
     void WakeUp();
@@ -96,14 +123,13 @@ private:
     std::thread::id threadId_{};
     std::atomic<bool> running_{false};
 
-    mutable std::mutex queueMutex_;
+    // 调度线程准备等待时置位；投递方只在置位时唤醒
+    std::atomic<bool> waiting_{false};
+    std::mutex waitMutex_;
     std::condition_variable cv_;
 
-    std::deque<QueuedTask> immediateTasks_;
-    std::priority_queue<ScheduledTask, std::vector<ScheduledTask>, ScheduledTaskComparer> delayedTasks_;
-
+    std::unique_ptr<TaskQueues> queues_;
     std::unique_ptr<IDispatcherBackend> backend_;
-    std::size_t sequenceCounter_{0};
 };
 
 class DispatcherOperation {
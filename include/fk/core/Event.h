@@ -12,6 +12,24 @@
 
 namespace fk::core {
 
+/**
+ * @brief 事件的线程模式（Phase 5.1）
+ *
+ * - MultiThreaded：可在任意线程添加、移除监听器和触发事件（默认）
+ * - SingleThreaded：只在单个线程（通常是 UI 线程）中使用，省去所有加锁
+ */
+enum class EventThreading {
+    MultiThreaded,
+    SingleThreaded
+};
+
+/**
+ * @brief 多播事件
+ *
+ * Phase 5.1: 监听器列表采用写时复制，触发事件只需增加一次引用计数，
+ * 不复制监听器也不分配内存；状态在第一次添加监听器时才分配，
+ * 没有监听器的事件（大多数 DependencyObject 的事件）不占用堆内存。
+ */
 template<typename... Args>
 class Event {
 public:
@@ -25,9 +43,42 @@ private:
         Handler handler;
     };
 
-    struct State {
+    struct ListenerList : std::vector<ListenerEntry> {
+        bool hasOnce{false};  // 是否含一次性监听器（触发后需要修改状态）
+    };
+
+    struct State : std::enable_shared_from_this<State> {
+        explicit State(bool threadSafe) : threadSafe(threadSafe) {}
+
+        // 取得当前监听器列表的快照（不可变，只增加引用计数）
+        std::shared_ptr<const ListenerList> Snapshot() const {
+            if (!threadSafe) {
+                return listeners;
+            }
+            std::shared_lock lock(mutex);
+            return listeners;
+        }
+
+        // 复制当前列表、修改后整体替换，正在触发的快照不受影响
+        template<typename Fn>
+        void Modify(Fn&& fn) {
+            std::unique_lock lock(mutex, std::defer_lock);
+            if (threadSafe) {
+                lock.lock();
+            }
+            auto next = listeners ? std::make_shared<ListenerList>(*listeners) : std::make_shared<ListenerList>();
+            fn(*next);
+            next->hasOnce = std::any_of(next->begin(), next->end(), [](const auto& entry) { return entry.once; });
+            if (next->empty()) {
+                listeners.reset();
+            } else {
+                listeners = std::move(next);
+            }
+        }
+
+        const bool threadSafe;
         mutable std::shared_mutex mutex;
-        std::vector<ListenerEntry> listeners;
+        std::shared_ptr<const ListenerList> listeners;
     };
 
 public:
@@ -64,10 +115,7 @@ public:
                 return;
             }
             if (auto state = state_.lock()) {
-                std::unique_lock lock(state->mutex);
-                auto& listeners = state->listeners;
-                listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
-                    [&](const auto& entry) { return entry.id == id_; }), listeners.end());
+                RemoveById(*state, id_);
             }
             state_.reset();
             id_ = 0;
@@ -78,9 +126,8 @@ public:
                 return false;
             }
             if (auto state = state_.lock()) {
-                std::shared_lock lock(state->mutex);
-                const auto& listeners = state->listeners;
-                return std::any_of(listeners.begin(), listeners.end(),
+                const auto listeners = state->Snapshot();
+                return listeners && std::any_of(listeners->begin(), listeners->end(),
                     [&](const auto& entry) { return entry.id == id_; });
             }
             return false;
@@ -91,24 +138,38 @@ public:
         std::size_t id_{0};
     };
 
-    Event() : state_(std::make_shared<State>()) {}
+    Event() = default;
+
+    explicit Event(EventThreading threading)
+        : threadSafe_(threading == EventThreading::MultiThreaded) {}
+
+    Event(const Event&) = delete;
+    Event& operator=(const Event&) = delete;
 
     void Add(const Handler& handler, int priority = 0) {
         AddInternal(Handler(handler), priority, false);
     }
 
     void Remove(const Handler& handler) {
-        auto state = state_;
-        std::unique_lock lock(state->mutex);
-        auto& listeners = state->listeners;
-        listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
-            [&](const auto& entry) { return AreEquivalent(entry.handler, handler); }), listeners.end());
+        if (State* state = GetState()) {
+            state->Modify([&](ListenerList& listeners) {
+                std::erase_if(listeners, [&](const auto& entry) { return AreEquivalent(entry.handler, handler); });
+            });
+        }
     }
 
     void RemoveAll() {
-        auto state = state_;
-        std::unique_lock lock(state->mutex);
-        state->listeners.clear();
+        if (State* state = GetState()) {
+            state->Modify([](ListenerList& listeners) { listeners.clear(); });
+        }
+    }
+
+    /**
+     * @brief 是否有监听器
+     */
+    bool HasListeners() const {
+        const State* state = GetState();
+        return state && state->Snapshot() != nullptr;
     }
 
     void operator+=(const Handler& handler) { Add(handler); }
@@ -117,76 +178,104 @@ public:
     template<typename Callable>
     Connection Connect(Callable&& callable, int priority = 0) {
         Handler handler(std::forward<Callable>(callable));
-        const auto id = AddInternal(std::move(handler), priority, false);
-        return Connection(state_, id);
+        return MakeConnection(AddInternal(std::move(handler), priority, false));
     }
 
     Connection Connect(const Handler& handler, int priority = 0) {
-        const auto id = AddInternal(Handler(handler), priority, false);
-        return Connection(state_, id);
+        return MakeConnection(AddInternal(Handler(handler), priority, false));
     }
 
     template<typename Callable>
     Connection ConnectOnce(Callable&& callable, int priority = 0) {
         Handler handler(std::forward<Callable>(callable));
-        const auto id = AddInternal(std::move(handler), priority, true);
-        return Connection(state_, id);
+        return MakeConnection(AddInternal(std::move(handler), priority, true));
     }
 
     Connection ConnectOnce(const Handler& handler, int priority = 0) {
-        const auto id = AddInternal(Handler(handler), priority, true);
-        return Connection(state_, id);
+        return MakeConnection(AddInternal(Handler(handler), priority, true));
     }
 
     void operator()(Args... args) const {
-        std::vector<ListenerEntry> snapshot;
-        auto state = state_;
-        {
-            std::shared_lock lock(state->mutex);
-            snapshot = state->listeners;
+        State* state = GetState();
+        if (!state) {
+            return;
+        }
+        // 快照在触发期间保持列表存活，监听器中增删监听器只会替换 state->listeners
+        const auto snapshot = state->Snapshot();
+        if (!snapshot) {
+            return;
+        }
+
+        // 含一次性监听器时触发后还要修改状态；监听器可能销毁事件的所有者，先持有状态的强引用
+        std::shared_ptr<State> keepAlive;
+        if (snapshot->hasOnce) {
+            keepAlive = state->shared_from_this();
         }
 
-        std::vector<std::size_t> onceIds;
-        onceIds.reserve(snapshot.size());
-        for (const auto& entry : snapshot) {
+        for (const auto& entry : *snapshot) {
             if (entry.handler) {
                 entry.handler(args...);
-                if (entry.once) {
+            }
+        }
+
+        if (keepAlive) {
+            std::vector<std::size_t> onceIds;
+            for (const auto& entry : *snapshot) {
+                if (entry.once && entry.handler) {
                     onceIds.push_back(entry.id);
                 }
             }
+            keepAlive->Modify([&](ListenerList& listeners) {
+                std::erase_if(listeners, [&](const auto& entry) {
+                    return std::find(onceIds.begin(), onceIds.end(), entry.id) != onceIds.end();
+                });
+            });
         }
+    }
+
+private:
+    State* GetState() const {
+        return stateRaw_.load(std::memory_order_acquire);
+    }
 
-        if (!onceIds.empty()) {
-            std::sort(onceIds.begin(), onceIds.end());
-            onceIds.erase(std::unique(onceIds.begin(), onceIds.end()), onceIds.end());
+    // 第一次添加监听器时分配状态；多线程同时添加时只有一个线程的状态被采用
+    State* EnsureState() {
+        if (State* state = GetState()) {
+            return state;
+        }
+        auto fresh = std::make_shared<State>(threadSafe_);
+        State* expected = nullptr;
+        if (stateRaw_.compare_exchange_strong(expected, fresh.get(), std::memory_order_acq_rel)) {
+            state_ = std::move(fresh);
+            return state_.get();
+        }
+        return expected;
+    }
 
-            std::unique_lock lock(state->mutex);
-            auto& listeners = state->listeners;
-            listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
-                [&](const auto& entry) {
-                    return std::binary_search(onceIds.begin(), onceIds.end(), entry.id);
-                }), listeners.end());
+    Connection MakeConnection(std::size_t id) {
+        if (id == 0) {
+            return Connection();
         }
+        return Connection(GetState()->weak_from_this(), id);
+    }
+
+    static void RemoveById(State& state, std::size_t id) {
+        state.Modify([&](ListenerList& listeners) {
+            std::erase_if(listeners, [&](const auto& entry) { return entry.id == id; });
+        });
     }
 
-private:
     std::size_t AddInternal(Handler handler, int priority, bool once) {
         if (!handler) {
             return 0;
         }
 
         const auto id = nextId_.fetch_add(1, std::memory_order_relaxed);
-        ListenerEntry entry{id, priority, once, std::move(handler)};
-
-        auto state = state_;
-        {
-            std::unique_lock lock(state->mutex);
-            auto& listeners = state->listeners;
+        EnsureState()->Modify([&](ListenerList& listeners) {
             const auto insertPosition = std::find_if(listeners.begin(), listeners.end(),
-                [&](const auto& existing) { return entry.priority > existing.priority; });
-            listeners.insert(insertPosition, std::move(entry));
-        }
+                [&](const auto& existing) { return priority > existing.priority; });
+            listeners.insert(insertPosition, ListenerEntry{id, priority, once, std::move(handler)});
+        });
 
         return id;
     }
@@ -206,8 +295,10 @@ private:
         return true;
     }
 
-    std::shared_ptr<State> state_;
+    std::atomic<State*> stateRaw_{nullptr};   // 发布后不再改变，触发事件时只读取该指针
+    std::shared_ptr<State> state_;            // 所有权；Connection 通过 weak_ptr 引用
     std::atomic<std::size_t> nextId_{1};
+    bool threadSafe_{true};
 };
 
 } // namespace fk::core
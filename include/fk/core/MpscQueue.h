@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace fk::core {
+
+/**
+ * @brief 无锁多生产者单消费者队列（Phase 5.1）
+ *
+ * 基于 Vyukov 的侵入式 MPSC 链表：
+ * - Push 可在任意线程调用，只有一次原子交换，不加锁
+ * - TryPop 只能由单一消费者线程调用
+ *
+ * 生产者执行到交换与链接之间时，消费者会暂时看不到之后的元素，
+ * TryPop 此时返回空；调用方应在稍后再次消费（例如下一次调度），而不是自旋等待。
+ */
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+    ~MpscQueue() {
+        while (TryPop()) {
+        }
+        Node* tail = tail_.load(std::memory_order_relaxed);
+        if (tail != &stub_) {
+            delete tail;
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief 入队（任意线程）
+     */
+    void Push(T value) {
+        auto* node = new Node(std::move(value));
+        Node* previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief 出队（仅消费者线程）
+     */
+    std::optional<T> TryPop() {
+        Node* tail = tail_.load(std::memory_order_relaxed);
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+        std::optional<T> result(std::move(*next->value));
+        next->value.reset();
+        tail_.store(next, std::memory_order_release);
+        if (tail != &stub_) {
+            delete tail;
+        }
+        return result;
+    }
+
+    /**
+     * @brief 队列是否为空（近似值，任意线程可调用）
+     */
+    bool Empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T&& v) : value(std::move(v)) {}
+
+        std::atomic<Node*> next{nullptr};
+        std::optional<T> value;
+    };
+
+    Node stub_;
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<Node*> tail_;
+};
+
+/**
+ * @brief 有界无锁多生产者单消费者环形队列（Phase 5.1）
+ *
+ * 基于 Vyukov 的有界队列：每个槽位带一个序号，生产者通过 CAS 争用写入位置，
+ * 消费者只读写自己的读取位置。入队、出队都不分配内存。
+ * 队列满时 TryPush 返回 false，由调用方决定退回到其他队列（例如 MpscQueue）。
+ */
+template<typename T>
+class MpscRingQueue {
+public:
+    /**
+     * @param capacity 容量，向上取整为 2 的幂
+     */
+    explicit MpscRingQueue(std::size_t capacity = 1024) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpscRingQueue() {
+        while (TryPop()) {
+        }
+    }
+
+    MpscRingQueue(const MpscRingQueue&) = delete;
+    MpscRingQueue& operator=(const MpscRingQueue&) = delete;
+
+    /**
+     * @brief 入队（任意线程）
+     * @return 队列已满时返回 false，此时 value 保持不变
+     */
+    bool TryPush(T& value) {
+        std::size_t position = enqueuePosition_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (diff == 0) {
+                if (enqueuePosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value.emplace(std::move(value));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = enqueuePosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief 出队（仅消费者线程）
+     */
+    std::optional<T> TryPop() {
+        const std::size_t position = dequeuePosition_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[position & mask_];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1) {
+            return std::nullopt;
+        }
+        std::optional<T> result(std::move(*cell.value));
+        cell.value.reset();
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        // 只有消费者写入，不需要读-改-写
+        dequeuePosition_.store(position + 1, std::memory_order_release);
+        return result;
+    }
+
+    std::size_t Capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief 累计入队、出队数量（近似值，任意线程可调用）
+     */
+    std::size_t PushedCount() const { return enqueuePosition_.load(std::memory_order_acquire); }
+    std::size_t PoppedCount() const { return dequeuePosition_.load(std::memory_order_acquire); }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        std::optional<T> value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_{0};
+    alignas(64) std::atomic<std::size_t> enqueuePosition_{0};
+    alignas(64) std::atomic<std::size_t> dequeuePosition_{0};
+};
+
+} // namespace fk::core
@@ -0,0 +1,420 @@
+#pragma once
+
+#include "fk/core/Dispatcher.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace fk::core {
+
+class TaskPool;
+
+template<typename T>
+class TaskHandle;
+
+enum class TaskStatus {
+    Pending,
+    Running,
+    Completed,
+    Canceled,
+    Faulted
+};
+
+namespace detail {
+
+/**
+ * @brief 后台任务的共享状态（与结果类型无关的部分）
+ */
+struct TaskStateBase {
+    std::atomic<TaskStatus> status{TaskStatus::Pending};
+    std::exception_ptr error{};
+    TaskPool* pool{nullptr};  // 默认的后续任务调度目标
+
+    bool TryStart() {
+        auto expected = TaskStatus::Pending;
+        return status.compare_exchange_strong(expected, TaskStatus::Running, std::memory_order_acq_rel);
+    }
+
+    bool TryCancel() {
+        auto expected = TaskStatus::Pending;
+        if (!status.compare_exchange_strong(expected, TaskStatus::Canceled, std::memory_order_acq_rel)) {
+            return false;
+        }
+        RunContinuations();
+        return true;
+    }
+
+    bool IsDone() const {
+        const auto current = status.load(std::memory_order_acquire);
+        return current != TaskStatus::Pending && current != TaskStatus::Running;
+    }
+
+    // 只能由 TryStart 成功的一方调用
+    void Finish(TaskStatus result) {
+        status.store(result, std::memory_order_release);
+        RunContinuations();
+    }
+
+    // 已完成时立即执行 continuation，否则在完成时执行
+    void AddContinuation(std::function<void()> continuation) {
+        {
+            std::lock_guard lock(continuationMutex_);
+            if (!finished_) {
+                continuations_.push_back(std::move(continuation));
+                return;
+            }
+        }
+        continuation();
+    }
+
+    // 在工作线程调用时执行其他任务而不是阻塞，避免所有工作线程互相等待
+    void Wait() const;
+
+private:
+    void RunContinuations() {
+        status.notify_all();
+        std::vector<std::function<void()>> continuations;
+        {
+            std::lock_guard lock(continuationMutex_);
+            finished_ = true;
+            continuations.swap(continuations_);
+        }
+        for (auto& continuation : continuations) {
+            continuation();
+        }
+    }
+
+    std::mutex continuationMutex_;
+    std::vector<std::function<void()>> continuations_;
+    bool finished_{false};
+};
+
+template<typename T>
+struct TaskState : TaskStateBase {
+    std::optional<T> value;
+};
+
+template<>
+struct TaskState<void> : TaskStateBase {};
+
+/**
+ * @brief 任务在执行之前被丢弃（取消、线程池关闭、Dispatcher 已销毁）时将状态置为 Canceled
+ *
+ * 只随任务函数对象移动，不应被复制。
+ */
+struct CancelOnDrop {
+    explicit CancelOnDrop(std::shared_ptr<TaskStateBase> state) : state(std::move(state)) {}
+    CancelOnDrop(CancelOnDrop&&) noexcept = default;
+    CancelOnDrop(const CancelOnDrop&) = default;
+    CancelOnDrop& operator=(CancelOnDrop&&) noexcept = default;
+    CancelOnDrop& operator=(const CancelOnDrop&) = default;
+    ~CancelOnDrop() {
+        if (state) {
+            state->TryCancel();
+        }
+    }
+
+    std::shared_ptr<TaskStateBase> state;
+};
+
+template<typename T, typename Fn>
+void Execute(TaskState<T>& state, Fn& fn) {
+    if (!state.TryStart()) {
+        return;
+    }
+    try {
+        if constexpr (std::is_void_v<T>) {
+            fn();
+        } else {
+            state.value.emplace(fn());
+        }
+    } catch (...) {
+        state.error = std::current_exception();
+        state.Finish(TaskStatus::Faulted);
+        return;
+    }
+    state.Finish(TaskStatus::Completed);
+}
+
+// 前置任务失败或取消时，后续任务直接继承其结果
+inline void Propagate(TaskStateBase& next, const TaskStateBase& antecedent) {
+    if (!next.TryStart()) {
+        return;
+    }
+    next.error = antecedent.error;
+    next.Finish(antecedent.status.load(std::memory_order_acquire));
+}
+
+template<typename T, typename Fn>
+auto ContinuationResultOf() {
+    if constexpr (std::is_invocable_v<Fn&, TaskHandle<T>>) {
+        return std::type_identity<std::invoke_result_t<Fn&, TaskHandle<T>>>{};
+    } else if constexpr (std::is_void_v<T>) {
+        return std::type_identity<std::invoke_result_t<Fn&>>{};
+    } else {
+        return std::type_identity<std::invoke_result_t<Fn&, T&>>{};
+    }
+}
+
+template<typename T, typename Fn>
+using ContinuationResult = typename decltype(ContinuationResultOf<T, std::decay_t<Fn>>())::type;
+
+} // namespace detail
+
+/**
+ * @brief TaskPool 运行统计
+ */
+struct TaskPoolStatistics {
+    std::uint64_t submitted{0};  // 投递的任务数
+    std::uint64_t executed{0};   // 已执行的任务数
+    std::uint64_t stolen{0};     // 从其他工作线程窃取的任务数
+    std::size_t pending{0};      // 尚未执行的任务数（近似值）
+};
+
+/**
+ * @brief 后台任务线程池（Phase 5.1）
+ *
+ * 用于把图片解码、文本排版、路径细分等耗时工作移出 UI 线程：
+ * - 每个工作线程一个无锁工作窃取双端队列（Chase-Lev）：自己从尾部 LIFO 取，
+ *   空闲线程从其他线程的头部 FIFO 窃取
+ * - 非工作线程（如 UI 线程）投递的任务进入共享队列
+ * - 只有存在休眠的工作线程时，投递才会唤醒它们
+ *
+ * Run 返回 TaskHandle，可用 Then 挂接后续任务；后续任务可以回到指定的 Dispatcher
+ * （通常是 UI 线程）执行，从而在不阻塞 UI 线程的情况下更新界面。
+ */
+class TaskPool {
+public:
+    using Work = std::function<void()>;
+
+    /**
+     * @param workerCount 工作线程数，0 表示硬件线程数减一（至少为 1）
+     */
+    explicit TaskPool(std::size_t workerCount = 0, std::string name = "TaskPool");
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    /**
+     * @brief 框架共享的线程池
+     */
+    static TaskPool& Shared();
+
+    /**
+     * @brief 当前线程所属的线程池（不是工作线程时返回 nullptr）
+     */
+    static TaskPool* Current();
+
+    /**
+     * @brief 投递一个不关心结果的任务（任意线程）
+     */
+    void Post(Work work);
+
+    /**
+     * @brief 在线程池中执行 fn，返回可等待、可挂接后续任务的句柄
+     */
+    template<typename Fn>
+    auto Run(Fn&& fn) -> TaskHandle<std::invoke_result_t<std::decay_t<Fn>&>>;
+
+    /**
+     * @brief 在当前线程执行一个排队的任务
+     * @return 没有可执行的任务时返回 false
+     */
+    bool RunPendingTask();
+
+    /**
+     * @brief 停止接收任务并等待工作线程退出；尚未执行的任务被取消
+     */
+    void Shutdown();
+
+    std::size_t WorkerCount() const { return workers_.size(); }
+    const std::string& Name() const { return name_; }
+
+    TaskPoolStatistics GetStatistics() const;
+
+private:
+    class WorkQueue;
+    struct Worker;
+
+    void WorkerLoop(std::size_t index);
+    std::unique_ptr<Work> TakeWork(Worker* self);
+    std::unique_ptr<Work> TryStealWork(Worker* self);
+    bool HasQueuedWork() const;
+    void WakeWorker();
+    void Execute(std::unique_ptr<Work> work);
+
+    std::string name_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // 非工作线程投递的任务
+    mutable std::mutex sharedMutex_;
+    std::deque<std::unique_ptr<Work>> sharedQueue_;
+    std::atomic<std::size_t> sharedSize_{0};
+
+    // 空闲工作线程在这里休眠
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::atomic<int> sleepers_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> executed_{0};
+    std::atomic<std::uint64_t> stolen_{0};
+};
+
+/**
+ * @brief TaskPool::Run 返回的任务句柄
+ *
+ * 复制句柄共享同一个任务。Then 挂接的后续任务在本任务结束后执行：
+ * - fn 接受 TaskHandle<T>：无论成功、失败还是取消都会调用
+ * - 否则 fn 接受 T&（T 为 void 时无参数），只在成功时调用；
+ *   本任务失败或取消时后续任务直接继承该结果
+ */
+template<typename T>
+class TaskHandle {
+public:
+    TaskHandle() = default;
+
+    bool IsValid() const { return static_cast<bool>(state_); }
+
+    TaskStatus GetStatus() const {
+        return state_ ? state_->status.load(std::memory_order_acquire) : TaskStatus::Canceled;
+    }
+
+    bool IsDone() const { return !state_ || state_->IsDone(); }
+
+    /**
+     * @brief 取消尚未开始执行的任务
+     */
+    bool Cancel() { return state_ && state_->TryCancel(); }
+
+    /**
+     * @brief 等待任务结束。不要在 UI 线程等待，应使用 Then(dispatcher, ...)
+     */
+    void Wait() const {
+        if (state_) {
+            state_->Wait();
+        }
+    }
+
+    /**
+     * @brief 等待并取得结果；任务失败时重新抛出异常，取消时抛出 std::runtime_error
+     */
+    std::add_lvalue_reference_t<T> Get() const {
+        if (!state_) {
+            throw std::runtime_error("TaskHandle is empty");
+        }
+        state_->Wait();
+        if (auto error = state_->error) {
+            std::rethrow_exception(error);
+        }
+        if (state_->status.load(std::memory_order_acquire) == TaskStatus::Canceled) {
+            throw std::runtime_error("Task was canceled");
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return *state_->value;
+        }
+    }
+
+    std::exception_ptr GetException() const { return state_ ? state_->error : nullptr; }
+
+    /**
+     * @brief 本任务结束后在同一线程池中执行 fn
+     */
+    template<typename Fn>
+    auto Then(Fn&& fn) const -> TaskHandle<detail::ContinuationResult<T, Fn>> {
+        TaskPool* pool = state_ && state_->pool ? state_->pool : &TaskPool::Shared();
+        return Chain(std::forward<Fn>(fn), [pool](TaskPool::Work work) { pool->Post(std::move(work)); });
+    }
+
+    /**
+     * @brief 本任务结束后在 dispatcher 的线程执行 fn；dispatcher 已销毁时后续任务被取消
+     */
+    template<typename Fn>
+    auto Then(const std::shared_ptr<Dispatcher>& dispatcher, Fn&& fn,
+              Dispatcher::Priority priority = Dispatcher::Priority::Normal) const
+        -> TaskHandle<detail::ContinuationResult<T, Fn>> {
+        std::weak_ptr<Dispatcher> weakDispatcher = dispatcher;
+        return Chain(std::forward<Fn>(fn), [weakDispatcher, priority](TaskPool::Work work) {
+            if (auto target = weakDispatcher.lock()) {
+                target->Post(std::move(work), priority);
+            }
+        });
+    }
+
+private:
+    friend class TaskPool;
+    template<typename>
+    friend class TaskHandle;
+
+    explicit TaskHandle(std::shared_ptr<detail::TaskState<T>> state) noexcept : state_(std::move(state)) {}
+
+    template<typename Fn, typename Schedule>
+    auto Chain(Fn&& fn, Schedule schedule) const -> TaskHandle<detail::ContinuationResult<T, Fn>> {
+        using R = detail::ContinuationResult<T, Fn>;
+        auto next = std::make_shared<detail::TaskState<R>>();
+        next->pool = state_ ? state_->pool : nullptr;
+        if (!state_) {
+            next->TryCancel();
+            return TaskHandle<R>(next);
+        }
+
+        // 弱引用：continuation 保存在前置任务的状态中，强引用会形成循环
+        std::weak_ptr<detail::TaskState<T>> weakAntecedent = state_;
+        state_->AddContinuation([weakAntecedent, next, fn = std::forward<Fn>(fn), schedule = std::move(schedule)]() mutable {
+            auto antecedent = weakAntecedent.lock();
+            // 未被执行就被丢弃的后续任务（例如 Dispatcher 已关闭）视为取消
+            schedule([antecedent, next, fn = std::move(fn), guard = detail::CancelOnDrop(next)]() mutable {
+                using Callback = std::decay_t<Fn>;
+                if constexpr (std::is_invocable_v<Callback&, TaskHandle<T>>) {
+                    auto invoke = [&]() { return fn(TaskHandle<T>(antecedent)); };
+                    detail::Execute(*next, invoke);
+                } else if (antecedent->status.load(std::memory_order_acquire) != TaskStatus::Completed) {
+                    detail::Propagate(*next, *antecedent);
+                } else if constexpr (std::is_void_v<T>) {
+                    detail::Execute(*next, fn);
+                } else {
+                    auto invoke = [&]() { return fn(*antecedent->value); };
+                    detail::Execute(*next, invoke);
+                }
+            });
+        });
+        return TaskHandle<R>(next);
+    }
+
+    std::shared_ptr<detail::TaskState<T>> state_;
+};
+
+template<typename Fn>
+auto TaskPool::Run(Fn&& fn) -> TaskHandle<std::invoke_result_t<std::decay_t<Fn>&>> {
+    using R = std::invoke_result_t<std::decay_t<Fn>&>;
+    auto state = std::make_shared<detail::TaskState<R>>();
+    state->pool = this;
+    Post([state, fn = std::forward<Fn>(fn), guard = detail::CancelOnDrop(state)]() mutable {
+        detail::Execute(*state, fn);
+    });
+    return TaskHandle<R>(std::move(state));
+}
+
+} // namespace fk::core
+
+namespace fk {
+    using core::TaskHandle;
+    using core::TaskPool;
+    using core::TaskStatus;
+}
@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace fk::core {
+
+/**
+ * @brief 分层时间轮（Phase 5.1）
+ *
+ * 用于 Dispatcher 的延迟任务，替代按到期时间排序的优先队列：
+ * - 第 0 层 256 个槽，每槽一个刻度（默认 1ms）
+ * - 第 1~3 层各 64 个槽，每层的一个槽覆盖下一层的整圈；到期前逐层下放
+ * - 超出约 18 小时的任务放在溢出列表，每转完最高层一圈重新分配一次
+ *
+ * 插入 O(1)，推进时只访问经过的槽。到期时间向上取整到刻度，任务不会提前执行。
+ * 同一刻度内按到期时间执行，到期时间相同的按加入顺序执行。
+ * 非线程安全：只能由拥有它的线程（Dispatcher 线程）访问。
+ */
+template<typename T>
+class TimingWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    explicit TimingWheel(TimePoint start = Clock::now(),
+                         std::chrono::microseconds resolution = std::chrono::milliseconds(1))
+        : start_(start), resolution_(std::max<std::int64_t>(1, resolution.count())) {}
+
+    /**
+     * @brief 加入一个在 due 到期的条目
+     */
+    void Schedule(TimePoint due, T value) {
+        Entry entry{TickFor(due), due, nextSequence_++, std::move(value)};
+        ++size_;
+        Place(std::move(entry));
+    }
+
+    /**
+     * @brief 推进到 now，按到期顺序对每个到期条目调用 onExpired(T&&)
+     * @return 到期条目数量
+     */
+    template<typename Fn>
+    std::size_t Advance(TimePoint now, Fn&& onExpired) {
+        std::size_t expired = ExpireReady(onExpired);
+        const std::uint64_t target = TickFloor(now);
+        if (size_ == 0) {
+            // 空轮直接跳到当前刻度
+            currentTick_ = std::max(currentTick_, target);
+            return expired;
+        }
+        while (currentTick_ < target && size_ > 0) {
+            ++currentTick_;
+            Cascade(currentTick_);
+            // 下放时恰好落在当前刻度的条目已进入 ready_，与本槽条目合并后一起排序
+            auto& slot = slots_[currentTick_ & kLevel0Mask];
+            if (!slot.empty()) {
+                ready_.insert(ready_.end(), std::make_move_iterator(slot.begin()), std::make_move_iterator(slot.end()));
+                slot.clear();
+            }
+            expired += ExpireReady(onExpired);
+        }
+        currentTick_ = std::max(currentTick_, target);
+        return expired;
+    }
+
+    /**
+     * @brief 最早到期时间（按刻度取整），没有条目时返回空
+     */
+    std::optional<TimePoint> NextDue() const {
+        if (size_ == 0) {
+            return std::nullopt;
+        }
+        if (!ready_.empty()) {
+            return TimeOf(currentTick_);
+        }
+
+        std::optional<std::uint64_t> earliest;
+        auto consider = [&](const std::vector<Entry>& entries) {
+            for (const auto& entry : entries) {
+                if (!earliest || entry.tick < *earliest) {
+                    earliest = entry.tick;
+                }
+            }
+        };
+
+        // 每一层只需检查（按轮转顺序）第一个非空槽
+        for (std::uint64_t offset = 1; offset <= kLevel0Slots; ++offset) {
+            const auto& slot = slots_[(currentTick_ + offset) & kLevel0Mask];
+            if (!slot.empty()) {
+                consider(slot);
+                break;
+            }
+        }
+        for (int level = 1; level < kLevels; ++level) {
+            const int shift = LevelShift(level);
+            const std::uint64_t current = currentTick_ >> shift;
+            for (std::uint64_t offset = 1; offset <= kUpperSlots; ++offset) {
+                const auto& slot = slots_[SlotIndex(level, current + offset)];
+                if (!slot.empty()) {
+                    consider(slot);
+                    break;
+                }
+            }
+        }
+        consider(overflow_);
+
+        if (!earliest) {
+            return std::nullopt;
+        }
+        return TimeOf(std::max(*earliest, currentTick_));
+    }
+
+    /**
+     * @brief 移除所有条目，对每个条目调用 onRemoved(T&&)
+     */
+    template<typename Fn>
+    void Clear(Fn&& onRemoved) {
+        auto drain = [&](std::vector<Entry>& entries) {
+            for (auto& entry : entries) {
+                onRemoved(std::move(entry.value));
+            }
+            entries.clear();
+        };
+        drain(ready_);
+        for (auto& slot : slots_) {
+            drain(slot);
+        }
+        drain(overflow_);
+        size_ = 0;
+    }
+
+    std::size_t Size() const { return size_; }
+    bool Empty() const { return size_ == 0; }
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kLevel0Bits = 8;
+    static constexpr int kUpperBits = 6;
+    static constexpr std::uint64_t kLevel0Slots = 1ull << kLevel0Bits;
+    static constexpr std::uint64_t kUpperSlots = 1ull << kUpperBits;
+    static constexpr std::uint64_t kLevel0Mask = kLevel0Slots - 1;
+    static constexpr std::uint64_t kUpperMask = kUpperSlots - 1;
+    static constexpr std::size_t kSlotCount = kLevel0Slots + kUpperSlots * (kLevels - 1);
+
+    struct Entry {
+        std::uint64_t tick;
+        TimePoint due;
+        std::uint64_t sequence;  // 加入顺序；下放会打乱槽内顺序，不能依赖 stable_sort
+        T value;
+    };
+
+    static bool EntryBefore(const Entry& a, const Entry& b) {
+        return a.due != b.due ? a.due < b.due : a.sequence < b.sequence;
+    }
+
+    static constexpr int LevelShift(int level) {
+        return level == 0 ? 0 : kLevel0Bits + kUpperBits * (level - 1);
+    }
+
+    // 第 level 层（level >= 1）中编号为 index（已右移）的槽
+    static constexpr std::size_t SlotIndex(int level, std::uint64_t index) {
+        return kLevel0Slots + kUpperSlots * static_cast<std::size_t>(level - 1) + static_cast<std::size_t>(index & kUpperMask);
+    }
+
+    std::uint64_t TickFloor(TimePoint time) const {
+        if (time <= start_) {
+            return 0;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - start_).count();
+        return static_cast<std::uint64_t>(elapsed / resolution_);
+    }
+
+    std::uint64_t TickFor(TimePoint due) const {
+        if (due <= start_) {
+            return 0;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(due - start_).count();
+        const std::int64_t resolutionNs = resolution_ * 1000;
+        return static_cast<std::uint64_t>((elapsed + resolutionNs - 1) / resolutionNs);
+    }
+
+    TimePoint TimeOf(std::uint64_t tick) const {
+        return start_ + std::chrono::microseconds(static_cast<std::int64_t>(tick) * resolution_);
+    }
+
+    void Place(Entry&& entry) {
+        if (entry.tick <= currentTick_) {
+            ready_.push_back(std::move(entry));
+            return;
+        }
+        const std::uint64_t delta = entry.tick - currentTick_;
+        if (delta < kLevel0Slots) {
+            slots_[entry.tick & kLevel0Mask].push_back(std::move(entry));
+            return;
+        }
+        for (int level = 1; level < kLevels; ++level) {
+            if (delta < (1ull << (LevelShift(level) + kUpperBits))) {
+                slots_[SlotIndex(level, entry.tick >> LevelShift(level))].push_back(std::move(entry));
+                return;
+            }
+        }
+        overflow_.push_back(std::move(entry));
+    }
+
+    // 进入新刻度时，把上层对应的槽下放到下层
+    void Cascade(std::uint64_t tick) {
+        if ((tick & kLevel0Mask) != 0) {
+            return;
+        }
+        int top = 1;
+        while (top < kLevels - 1 && ((tick >> LevelShift(top)) & kUpperMask) == 0) {
+            ++top;
+        }
+        if (top == kLevels - 1 && ((tick >> LevelShift(top)) & kUpperMask) == 0) {
+            Redistribute(overflow_);
+        }
+        for (int level = top; level >= 1; --level) {
+            Redistribute(slots_[SlotIndex(level, tick >> LevelShift(level))]);
+        }
+    }
+
+    void Redistribute(std::vector<Entry>& entries) {
+        if (entries.empty()) {
+            return;
+        }
+        pending_.swap(entries);
+        for (auto& entry : pending_) {
+            Place(std::move(entry));
+        }
+        pending_.clear();
+    }
+
+    template<typename Fn>
+    std::size_t ExpireReady(Fn& onExpired) {
+        if (ready_.empty()) {
+            return 0;
+        }
+        pending_.swap(ready_);
+        std::sort(pending_.begin(), pending_.end(), EntryBefore);
+        const std::size_t count = pending_.size();
+        for (auto& entry : pending_) {
+            --size_;
+            onExpired(std::move(entry.value));
+        }
+        pending_.clear();
+        return count;
+    }
+
+    TimePoint start_;
+    std::int64_t resolution_;  // 微秒
+    std::uint64_t currentTick_{0};
+    std::size_t size_{0};
+    std::uint64_t nextSequence_{0};
+    std::array<std::vector<Entry>, kSlotCount> slots_{};
+    std::vector<Entry> ready_;
+    std::vector<Entry> overflow_;
+    std::vector<Entry> pending_;
+};
+
+} // namespace fk::core
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "fk/ui/graphics/Primitives.h"
+#include <cstddef>
+#include <vector>
+
+namespace fk::render {
+
+/**
+ * @brief 帧损坏区域（Phase 5.1 脏矩形重绘）
+ *
+ * 累积一帧内需要重绘的矩形（全局坐标），合并相交或相邻的矩形，
+ * 并在矩形过多或覆盖面积过大时退化为整帧重绘。
+ */
+class DamageRegion {
+public:
+    /**
+     * @brief 重置为空区域
+     * @param viewportWidth 视口宽度
+     * @param viewportHeight 视口高度
+     */
+    void Reset(float viewportWidth, float viewportHeight);
+
+    /**
+     * @brief 添加损坏矩形（自动对齐到像素并裁剪到视口）
+     */
+    void Add(const ui::Rect& rect);
+
+    /**
+     * @brief 标记整帧重绘
+     */
+    void AddFull() { full_ = true; rects_.clear(); }
+
+    /**
+     * @brief 合并矩形，返回前调用一次
+     */
+    void Merge();
+
+    bool IsFull() const { return full_; }
+    bool IsEmpty() const { return !full_ && rects_.empty(); }
+
+    /**
+     * @brief 获取损坏矩形（IsFull() 时为空）
+     */
+    const std::vector<ui::Rect>& GetRects() const { return rects_; }
+
+private:
+    ui::Rect viewport_;
+    std::vector<ui::Rect> rects_;
+    bool full_{false};
+};
+
+} // namespace fk::render
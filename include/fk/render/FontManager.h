@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct FT_LibraryRec_;
+
+namespace fk::render {
+
+/**
+ * @brief 字体索引中的字体（文件中的一个 face）句柄，-1 表示无效
+ */
+using FontFaceId = std::int32_t;
+
+/**
+ * @brief 索引中一个字体的描述
+ */
+struct FontFaceInfo {
+    std::string path;           // 字体文件路径
+    int faceIndex{0};           // 集合文件（.ttc/.otc）中的 face 索引
+    std::string family;         // 字体族名称
+    std::uint16_t weight{400};  // 字重（100-900，OS/2 usWeightClass）
+    bool italic{false};         // 是否为斜体
+};
+
+/**
+ * @brief 字体管理器统计信息
+ */
+struct FontManagerStatistics {
+    std::size_t faces{0};           // 索引中的字体数
+    std::size_t families{0};        // 字体族数
+    std::size_t files{0};           // 字体文件数
+    std::size_t filesScanned{0};    // 本次用 FreeType 重新读取的文件数（其余来自磁盘缓存）
+    double scanMilliseconds{0.0};   // 建立索引的耗时
+};
+
+/**
+ * @brief 系统字体索引与回退链（Phase 5.1）
+ *
+ * 第一次使用时扫描一次字体目录（Linux 读取 fontconfig 的 <dir> 配置），
+ * 建立字体族/样式索引和每个字体的字符覆盖位图：
+ * - Resolve：(字体族, 字重, 样式) 经一次哈希查找和预先计算的样式槽得到字体句柄，
+ *   未知字体族与 sans-serif/serif/monospace 别名解析到平台默认字体族
+ * - FindFaceForCodepoint：主字体缺少的字符按所在码位块（256 个码点）的回退链查找，
+ *   回退链只包含覆盖该块的字体，并用覆盖位图判断，不需要逐个字体调用 FreeType；
+ *   每个块第一次使用时沿链为块内所有码点解析一次字体，之后的查找只需查表
+ *
+ * 扫描结果（字体描述与覆盖位图）写入磁盘缓存，之后启动时只需要遍历目录并比较
+ * 文件大小与修改时间，变化的文件才重新用 FreeType 读取。
+ *
+ * 管理器不持有打开的字体：TextRenderer 与 SoftwareRenderer 按 FontFaceInfo 自行加载。
+ * 所有方法都需要在 UI 线程调用。
+ */
+class FontManager {
+public:
+    static FontManager& Instance();
+
+    FontManager(const FontManager&) = delete;
+    FontManager& operator=(const FontManager&) = delete;
+
+    /**
+     * @brief 设置磁盘缓存文件路径（需要在第一次使用前调用，空字符串表示不使用缓存）
+     */
+    void SetCachePath(const std::string& path) { cachePath_ = path; }
+    const std::string& GetCachePath() const { return cachePath_; }
+
+    /**
+     * @brief 追加字体目录（需要在第一次使用前调用）
+     */
+    void AddFontDirectory(const std::string& directory);
+
+    /**
+     * @brief 扫描字体目录并建立索引（只执行一次，Resolve 等方法会自动调用）
+     */
+    void Initialize();
+
+    /**
+     * @brief 丢弃索引，下次使用时重新扫描（已安装或删除字体后调用）
+     */
+    void Rescan();
+
+    /**
+     * @brief 解析字体请求
+     * @param family 字体族（大小写不敏感）
+     * @param weight 字重（100-900）
+     * @param italic 是否为斜体
+     * @return 最接近的字体，索引为空时返回 -1
+     */
+    FontFaceId Resolve(std::string_view family, int weight = 400, bool italic = false);
+
+    /**
+     * @brief 字体是否包含字符
+     */
+    bool HasCodepoint(FontFaceId face, char32_t c) const;
+
+    /**
+     * @brief 查找能显示字符的字体
+     * @param c 字符码点
+     * @param preferred 主字体（包含该字符时直接返回）
+     * @return 没有任何字体包含该字符时返回 -1
+     */
+    FontFaceId FindFaceForCodepoint(char32_t c, FontFaceId preferred);
+
+    /**
+     * @brief 字体描述（无效句柄返回 nullptr）
+     */
+    const FontFaceInfo* GetFace(FontFaceId face) const;
+
+    FontManagerStatistics GetStatistics() const { return statistics_; }
+
+private:
+    FontManager();
+    ~FontManager() = default;
+
+    // 一个码位块（256 个码点）的覆盖位图
+    struct BlockCoverage {
+        std::uint32_t block{0};
+        std::array<std::uint64_t, 4> bits{};
+    };
+
+    struct Face {
+        FontFaceInfo info;
+        std::vector<BlockCoverage> coverage;  // 按 block 升序
+    };
+
+    // 字体文件（磁盘缓存以文件为单位校验）
+    struct FontFile {
+        std::string path;
+        std::uint64_t size{0};
+        std::int64_t modified{0};
+        std::vector<Face> faces;
+    };
+
+    // 字重 100-900 共 9 档，乘以正常/斜体 2 种样式
+    static constexpr std::size_t kStyleSlots = 18;
+
+    struct Family {
+        std::array<FontFaceId, kStyleSlots> slots{};  // 每个样式槽最接近的字体
+    };
+
+    // 大小写不敏感、支持 string_view 查找的哈希与比较
+    struct FamilyHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const;
+    };
+    struct FamilyEqual {
+        using is_transparent = void;
+        bool operator()(std::string_view lhs, std::string_view rhs) const;
+    };
+
+    std::vector<std::string> FontDirectories() const;
+    static void ScanFile(FT_LibraryRec_* library, FontFile& file);
+    bool LoadCache(std::unordered_map<std::string, FontFile>& files) const;
+    void SaveCache(const std::vector<FontFile>& files) const;
+    void BuildIndex(std::vector<FontFile>& files);
+    const std::vector<FontFaceId>& BlockFaces(std::uint32_t block);
+
+    std::string cachePath_;
+    std::vector<std::string> extraDirectories_;
+    bool initialized_{false};
+
+    std::vector<Face> faces_;
+    std::unordered_map<std::string, std::size_t, FamilyHash, FamilyEqual> familyIndex_;  // 字体族 -> families_ 索引
+    std::vector<Family> families_;
+    std::size_t defaultFamily_{0};
+    std::vector<FontFaceId> fallbackOrder_;   // 回退优先顺序（平台默认字体族在前）
+
+    std::vector<std::vector<FontFaceId>> blockFaces_;  // 码位块 -> 每个码点的回退字体（按需计算，空表示未计算）
+
+    FontManagerStatistics statistics_;
+};
+
+} // namespace fk::render
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fk::render {
+
+/**
+ * @brief 缓存网格中的一段描边（同一颜色的三角形）
+ */
+struct CachedStrokeBatch {
+    bool hasColor{false};                 // false 时使用命令的描边颜色
+    std::array<float, 4> color{};         // 分段描边颜色（hasColor 为 true 时有效）
+    int first{0};                         // 起始顶点
+    int count{0};                         // 顶点数量
+};
+
+/**
+ * @brief 已上传到 GPU 的三角网格
+ *
+ * 顶点格式与 GlRenderer 的 (x, y, u, v) 一致，坐标相对于网格原点，
+ * 绘制时通过 uMeshOrigin 平移，因此同一形状移动后仍可复用。
+ */
+struct CachedGeometry {
+    unsigned int vao{0};
+    unsigned int vbo{0};
+    int fillFirst{0};                     // 填充三角形起始顶点
+    int fillCount{0};                     // 填充三角形顶点数量（0 表示无填充）
+    std::vector<CachedStrokeBatch> strokeBatches;
+    std::size_t byteSize{0};
+    std::uint64_t lastUsedFrame{0};
+};
+
+/**
+ * @brief 三角剖分几何缓存（Phase 5.1）
+ *
+ * Path / Polygon 的细分、libtess2 三角剖分和描边网格生成开销较大，
+ * 而绝大多数形状（图标等）在帧之间不变。本缓存按几何内容哈希保存
+ * 剖分结果及对应的 VAO/VBO，命中时只需设置 uniform 并绘制。
+ *
+ * 淘汰策略：
+ * - 连续 maxIdleFrames 帧未使用的条目被释放
+ * - 总显存超过 maxBytes 时按 LRU 淘汰（当前帧使用过的条目除外）
+ *
+ * 注意：所有方法都需要在拥有 OpenGL 上下文的线程中调用。
+ */
+class GeometryCache {
+public:
+    /**
+     * @brief 构造缓存
+     * @param maxBytes 顶点数据总字节数软上限
+     * @param maxIdleFrames 条目最多保留的空闲帧数
+     */
+    explicit GeometryCache(std::size_t maxBytes = 32 * 1024 * 1024, std::uint64_t maxIdleFrames = 600);
+    ~GeometryCache();
+
+    // 禁止拷贝
+    GeometryCache(const GeometryCache&) = delete;
+    GeometryCache& operator=(const GeometryCache&) = delete;
+
+    /**
+     * @brief 查找网格并标记为当前帧使用
+     * @return 未命中时返回 nullptr
+     */
+    const CachedGeometry* Find(std::uint64_t key);
+
+    /**
+     * @brief 上传网格并加入缓存
+     * @param key 几何内容哈希
+     * @param fillVertices 填充三角形顶点
+     * @param strokeVertices 描边三角形顶点（batches 中的 first 相对于描边顶点起始位置）
+     * @param strokeBatches 描边分批
+     * @return 新条目；没有任何顶点时返回 nullptr
+     */
+    const CachedGeometry* Insert(std::uint64_t key,
+                                 const std::vector<float>& fillVertices,
+                                 const std::vector<float>& strokeVertices,
+                                 std::vector<CachedStrokeBatch> strokeBatches);
+
+    /**
+     * @brief 开始新的一帧（推进帧计数并释放长时间未使用的条目）
+     */
+    void BeginFrame();
+
+    /**
+     * @brief 释放所有条目
+     */
+    void Clear();
+
+    std::size_t GetEntryCount() const { return entries_.size(); }
+    std::size_t GetByteSize() const { return byteSize_; }
+
+private:
+    void Release(CachedGeometry& geometry);
+    void EvictToBudget();
+
+    std::size_t maxBytes_;
+    std::uint64_t maxIdleFrames_;
+    std::uint64_t frame_{1};
+    std::size_t byteSize_{0};
+    std::unordered_map<std::uint64_t, CachedGeometry> entries_;
+};
+
+} // namespace fk::render
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "fk/render/IRenderer.h"
+#include "fk/render/GeometryCache.h"
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -30,11 +32,16 @@ public:
      * @brief 获取 TextRenderer 实例(用于文本测量)
      */
     TextRenderer* GetTextRenderer() const { return textRenderer_.get(); }
+
+    /**
+     * @brief 排版用的字形度量来源（即 TextRenderer）
+     */
+    GlyphMetricsProvider* GetGlyphMetrics() const override;
     
     /**
      * @brief 检查渲染器是否已初始化
      */
-    bool IsInitialized() const { return initialized_; }
+    bool IsInitialized() const override { return initialized_; }
 
 private:
     /**
@@ -57,13 +64,39 @@ private:
      */
     void DrawRectangle(const struct RectanglePayload& payload);
 
+    /**
+     * @brief 按批次执行命令列表（连续矩形合并为实例化绘制）
+     * @param damage 当前重绘的损坏区域（nullptr 表示整帧）
+     */
+    void ExecuteCommands(const RenderList& list, const ui::Rect* damage);
+
+    /**
+     * @brief 绘制一组连续的矩形命令（一次实例化绘制调用）
+     */
+    void DrawRectangleBatch(const struct RenderCommand* commands, size_t count, const ui::Rect* damage);
+
+    /**
+     * @brief 将矩形追加到实例缓冲（圆角按边长限制后写入）
+     */
+    void AppendRectangleInstance(const struct RectanglePayload& payload);
+
+    /**
+     * @brief 提交累积的矩形实例
+     */
+    void FlushRectangleInstances();
+
     /**
      * @brief 绘制文本（占位）
      */
     void DrawText(const struct TextPayload& payload);
 
     /**
-     * @brief 绘制图像（占位）
+     * @brief 提交累积的文本批次（每个图集页一次绘制调用）
+     */
+    void FlushTextBatches();
+
+    /**
+     * @brief 绘制图像（纹理四边形）
      */
     void DrawImage(const struct ImagePayload& payload);
 
@@ -77,16 +110,99 @@ private:
      */
     void DrawPath(const struct PathPayload& payload);
 
+    /**
+     * @brief 细分、剖分路径并生成描边网格，结果加入几何缓存
+     * @param origin 网格原点（顶点坐标相对于该点）
+     */
+    const CachedGeometry* BuildPathGeometry(std::uint64_t key, const struct PathPayload& payload,
+                                            const ui::Point& origin, bool buildFill, bool buildStroke);
+
+    /**
+     * @brief 绘制缓存的几何网格
+     * @param fillColor 填充颜色（nullptr 表示不绘制填充）
+     * @param strokeColor 描边颜色（nullptr 表示不绘制描边）
+     */
+    void DrawCachedGeometry(const CachedGeometry& geometry, const ui::Point& origin,
+                            const std::array<float, 4>* fillColor,
+                            const std::array<float, 4>* strokeColor);
+
     /**
      * @brief 推入透明度图层
+     * 
+     * Phase 5.1: 图层内容绘制到离屏目标，PopLayer 时按不透明度整体合成。
+     * cacheId 非 0 的图层保留位图，内容版本未变时跳过图层内的命令直接合成。
      */
     void PushLayer(const struct LayerPayload& payload);
 
     /**
-     * @brief 弹出透明度图层
+     * @brief 弹出透明度图层（离屏图层在此合成到父目标）
      */
     void PopLayer();
 
+    /**
+     * @brief 离屏目标（图层池中的目标或缓存位图）
+     */
+    struct LayerTarget {
+        unsigned int fbo{0};
+        unsigned int texture{0};
+        int width{0};
+        int height{0};
+        bool inUse{false};
+        std::uint64_t lastUsedFrame{0};
+    };
+
+    /**
+     * @brief 当前绘制目标：离屏图层的原点是其左上角的全局像素坐标
+     */
+    struct RenderTarget {
+        unsigned int fbo{0};
+        int originX{0};
+        int originY{0};
+        int height{0};
+    };
+
+    /**
+     * @brief 创建 RGBA8 纹理离屏目标，失败时返回 false
+     */
+    static bool CreateLayerTarget(LayerTarget& target, int width, int height);
+    static void DestroyLayerTarget(LayerTarget& target);
+
+    /**
+     * @brief 从图层池中取出至少 width x height 的离屏目标，返回索引（失败返回 -1）
+     */
+    int AcquirePooledTarget(int width, int height);
+
+    /**
+     * @brief 绑定绘制目标并设置视口，使全局坐标的着色器无需修改即可绘制到离屏目标
+     */
+    void BindRenderTarget(const RenderTarget& target);
+
+    /**
+     * @brief 场景绘制目标（持久化离屏目标或默认帧缓冲）
+     */
+    RenderTarget SceneRenderTarget() const;
+
+    /**
+     * @brief 从根状态开始重放：恢复场景目标，归还未配对图层占用的离屏目标
+     */
+    void ResetLayerState();
+
+    /**
+     * @brief 将预乘 alpha 的离屏纹理按不透明度合成到当前目标
+     */
+    void CompositeLayer(unsigned int texture, const ui::Rect& destRect, float u1, float v0, float opacity);
+
+    /**
+     * @brief 释放长时间未使用的图层池目标和缓存位图
+     */
+    void TrimLayerTargets();
+
+    /**
+     * @brief 删除缓存位图（TextureManager 淘汰或长时间未使用）
+     */
+    void ReleaseCachedLayer(std::uint64_t cacheId);
+    void ReleaseAllLayerTargets();
+
     /**
      * @brief 初始化着色器程序
      */
@@ -102,22 +218,74 @@ private:
      */
     void CleanupResources();
 
+    /**
+     * @brief 确保持久化离屏颜色目标与视口尺寸一致
+     * @return 是否（重新）创建了目标（内容无效，需要整帧重绘）
+     */
+    bool EnsureSceneTarget();
+
+    /**
+     * @brief 释放离屏颜色目标
+     */
+    void ReleaseSceneTarget();
+
+    /**
+     * @brief 将离屏颜色目标呈现到默认帧缓冲
+     */
+    void PresentSceneTarget();
+
+    /**
+     * @brief 设置裁剪矩形（全局坐标，空矩形表示全部裁掉）
+     */
+    void SetScissorRect(const ui::Rect& rect);
+
     // OpenGL 资源
     unsigned int borderShaderProgram_{0};     // Border 着色器（圆形圆角）
     unsigned int rectangleShaderProgram_{0};  // Rectangle 着色器（椭圆圆角）
     unsigned int simpleShaderProgram_{0};     // 简单着色器（无SDF，用于多边形）
     unsigned int pathAAShaderProgram_{0};     // Path抗锯齿着色器（边缘羽化）
     unsigned int textShaderProgram_{0};       // 文本渲染着色器
+    unsigned int imageShaderProgram_{0};      // 图像着色器（与文本共用顶点着色器和缓冲区，Phase 5.1）
+    unsigned int rectInstanceShaderProgram_{0}; // 实例化矩形着色器（圆形圆角，Phase 5.1）
     unsigned int vao_{0};
     unsigned int vbo_{0};
     unsigned int pathAAVAO_{0};  // Path抗锯齿 VAO
     unsigned int pathAAVBO_{0};  // Path抗锯齿 VBO
     unsigned int textVAO_{0};  // 文本渲染 VAO
     unsigned int textVBO_{0};  // 文本渲染 VBO
+    std::size_t textVBOCapacity_{0};  // 文本 VBO 容量（float 个数）
+    unsigned int rectInstanceVAO_{0};  // 实例化矩形 VAO
+    unsigned int rectQuadVBO_{0};      // 单位四边形顶点
+    unsigned int rectInstanceVBO_{0};  // 逐实例属性
+    std::size_t rectInstanceCapacity_{0};  // 实例 VBO 容量（实例个数）
+    std::vector<float> rectInstances_;     // 待提交的矩形实例（跨帧复用内存）
+    
+    // Phase 5.1: 文本批次（按图集页分组，跨帧复用内存）
+    struct TextBatch {
+        unsigned int textureID{0};
+        bool isColor{false};
+        float sdfRange{0.0f};       // 距离场字形的距离范围（0 表示位图字形）
+        std::vector<float> vertices;
+    };
+    std::vector<TextBatch> textBatches_;
+    
+    // Phase 5.1: Path / Polygon 三角剖分结果缓存
+    GeometryCache geometryCache_;
     
     // 文本渲染器
     std::unique_ptr<TextRenderer> textRenderer_;
     
+    // Phase 5.1: 持久化离屏颜色目标（脏矩形重绘时保留上一帧内容）
+    unsigned int sceneFBO_{0};            // 单采样解析目标（纹理，用于呈现）
+    unsigned int sceneColorTexture_{0};
+    unsigned int sceneMsaaFBO_{0};        // 多重采样绘制目标（与默认帧缓冲采样数一致）
+    unsigned int sceneMsaaColorRB_{0};
+    Extent2D sceneSize_{};
+    bool fullRedraw_{true};
+    std::vector<ui::Rect> damageRects_;   // 本帧损坏区域（全局坐标）
+    bool hasDamageScissor_{false};        // 是否正在重绘某个损坏区域
+    ui::Rect damageScissor_{};
+    
     // 状态
     Extent2D viewportSize_{};
     FrameContext currentFrame_{};
@@ -128,10 +296,41 @@ private:
     
     // 透明度栈
     struct LayerState {
-        float opacity{1.0f};
+        float opacity{1.0f};             // 图元着色器的不透明度乘子（离屏图层内为 1）
+        
+        // Phase 5.1: 离屏图层
+        bool offscreen{false};           // PopLayer 时合成
+        bool rendering{false};           // 图层内的命令正在绘制到离屏目标（缓存命中时为 false）
+        bool cached{false};              // 绘制到缓存位图
+        float compositeOpacity{1.0f};
+        ui::Rect destRect;               // 合成区域（全局坐标）
+        unsigned int texture{0};
+        float u1{1.0f};                  // 内容在纹理中的范围：u ∈ [0, u1]，v ∈ [v0, 1]
+        float v0{0.0f};
+        int poolIndex{-1};               // 图层池中的目标（缓存位图为 -1）
+        RenderTarget parentTarget;
+        ui::Rect parentClipRect;         // 进入图层时的裁剪（合成前恢复）
+        bool parentClipEnabled{false};
     };
     std::vector<LayerState> layerStack_;
     
+    // Phase 5.1: 离屏图层
+    struct CachedLayer {
+        LayerTarget target;              // 与内容同尺寸
+        std::uint64_t version{0};        // 位图对应的图层内容版本
+        float fractionX{0.0f};           // 内容包围盒原点的小数部分（平移后按原样对齐）
+        float fractionY{0.0f};
+    };
+    std::vector<LayerTarget> layerTargets_;                    // 图层池（跨帧复用）
+    std::unordered_map<std::uint64_t, CachedLayer> layerCache_;  // CacheMode::BitmapCache 的位图
+    RenderTarget currentTarget_;
+    ui::Rect currentClipRect_;           // 最近一次 SetClip（图层合成前恢复）
+    bool currentClipEnabled_{false};
+    int skipDepth_{0};                   // 大于 0 时跳过命令直到对应的 PopLayer（缓存命中或图层为空）
+    int offscreenDepth_{0};              // 正在绘制的离屏图层层数（损坏区域裁剪不作用于离屏目标）
+    int cachedLayerDepth_{0};            // 正在绘制的缓存位图层数（需要完整内容，不按损坏区域剔除）
+    std::uint64_t frameIndex_{0};
+    
     bool initialized_{false};
 };
 
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace fk::render {
+
+/**
+ * @brief 图集页格式
+ */
+enum class AtlasFormat {
+    Gray,   // 单通道灰度（普通字形，GL_RED）
+    Color   // 四通道彩色（emoji 等彩色字形，GL_RGBA）
+};
+
+/**
+ * @brief 上传到图集的源像素格式
+ */
+enum class AtlasPixelFormat {
+    Gray8,  // 8 位灰度
+    RGBA8,  // 32 位 RGBA
+    BGRA8   // 32 位 BGRA（FreeType 彩色位图）
+};
+
+/**
+ * @brief 图集中分配到的区域
+ */
+struct AtlasRegion {
+    unsigned int textureID{0};  // 所在页的 OpenGL 纹理 ID
+    int page{-1};               // 页索引
+    float u0{0.0f};             // 左上角纹理坐标
+    float v0{0.0f};
+    float u1{0.0f};             // 右下角纹理坐标
+    float v1{0.0f};
+};
+
+/**
+ * @brief 字形纹理图集（Phase 5.1）
+ *
+ * 将字形位图打包进少量大尺寸纹理页，替代"每个字形一张纹理"的方式，
+ * 使同一页内的字形可以在一次绘制调用中完成渲染。
+ *
+ * 特性：
+ * - 灰度页与彩色页分开管理
+ * - 每页使用 Skyline（天际线）左下角算法打包，字形之间保留 1 像素间隔
+ * - 超过页数上限时按页进行 LRU 淘汰（当前帧使用过的页不会被淘汰）
+ * - 页被淘汰时通过回调通知使用者清除引用该页的字形
+ * - 页纹理在 TextureManager 中登记，显存超出全局预算时未在当前帧使用的页也会被淘汰
+ *
+ * 注意：所有方法都需要在拥有 OpenGL 上下文的线程中调用。
+ */
+class GlyphAtlas {
+public:
+    using PageEvictedCallback = std::function<void(int page)>;
+
+    /**
+     * @brief 构造图集
+     * @param pageSize 每页的边长（像素）
+     * @param maxPages 页数软上限，超过后开始淘汰最久未使用的页
+     */
+    explicit GlyphAtlas(int pageSize = 1024, std::size_t maxPages = 8);
+    ~GlyphAtlas();
+
+    // 禁止拷贝
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /**
+     * @brief 分配区域并上传像素
+     * @param format 目标页格式
+     * @param width 位图宽度
+     * @param height 位图高度
+     * @param pixels 紧密排列的像素数据
+     * @param pixelFormat 像素数据格式
+     * @param outRegion 输出分配到的区域
+     * @return 是否成功（位图超过页尺寸时失败）
+     */
+    bool Allocate(AtlasFormat format, int width, int height,
+                  const unsigned char* pixels, AtlasPixelFormat pixelFormat,
+                  AtlasRegion& outRegion);
+
+    /**
+     * @brief 标记页在当前帧被使用
+     */
+    void Touch(int page);
+
+    /**
+     * @brief 开始新的一帧（推进 LRU 帧计数）
+     */
+    void BeginFrame() { ++frame_; }
+
+    /**
+     * @brief 设置页淘汰回调
+     */
+    void SetPageEvictedCallback(PageEvictedCallback callback) { onPageEvicted_ = std::move(callback); }
+
+    /**
+     * @brief 释放所有页
+     */
+    void Clear();
+
+    std::size_t GetPageCount() const;
+    int GetPageSize() const { return pageSize_; }
+
+private:
+    struct SkylineNode {
+        int x;
+        int y;
+        int width;
+    };
+
+    struct Page {
+        unsigned int textureID{0};
+        AtlasFormat format{AtlasFormat::Gray};
+        std::vector<SkylineNode> skyline;
+        std::uint64_t lastUsedFrame{0};
+    };
+
+    bool Pack(Page& page, int width, int height, int& outX, int& outY);
+    int FitSkyline(const Page& page, std::size_t index, int width, int height) const;
+    void AddSkylineLevel(Page& page, std::size_t index, int x, int y, int width, int height);
+    int AcquirePage(AtlasFormat format);
+    void ResetPage(int index);
+    void EvictPage(int index);
+
+    int pageSize_;
+    std::size_t maxPages_;
+    std::uint64_t frame_{1};
+    std::vector<std::unique_ptr<Page>> pages_;
+    PageEvictedCallback onPageEvicted_;
+};
+
+} // namespace fk::render
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "fk/ui/graphics/Primitives.h"
+
 #include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace fk::render {
 
@@ -11,12 +14,23 @@ struct Extent2D {
     std::uint32_t height{0};
 };
 
+/**
+ * @brief 字形渲染方式（Phase 5.1）
+ */
+enum class GlyphRenderMode {
+    Bitmap,                 // 每个像素字号单独栅格化（小字号 hinting 效果最好）
+    SignedDistanceField     // 参考字号下生成一次距离场，任意字号缩放绘制（字号动画、可缩放画布）
+};
+
 struct RendererInitParams {
     void* nativeSurfaceHandle{nullptr};
     Extent2D initialSize{};
     float pixelRatio{1.0f};
     bool enableDebugLayer{false};
     std::string rendererName;
+    GlyphRenderMode glyphRenderMode{GlyphRenderMode::Bitmap};
+    // OpenGL 函数地址加载器；为空时 GlRenderer 使用 glfwGetProcAddress（需要 FK_HAS_GLFW）
+    void* (*glProcLoader)(const char* name){nullptr};
 };
 
 struct FrameContext {
@@ -24,10 +38,14 @@ struct FrameContext {
     double deltaSeconds{0.0};
     std::array<float, 4> clearColor{0.0f, 0.0f, 0.0f, 0.0f};
     std::uint64_t frameIndex{0};
+    // 脏矩形重绘：fullRedraw 为 false 时只重绘 damageRects 覆盖的区域（全局坐标）
+    bool fullRedraw{true};
+    std::vector<ui::Rect> damageRects;
 };
 
 class RenderList;
 class TextRenderer;
+class GlyphMetricsProvider;
 
 class IRenderer {
 public:
@@ -39,12 +57,19 @@ public:
     virtual void Draw(const RenderList& list) = 0;
     virtual void EndFrame() = 0;
     virtual void Shutdown() = 0;
+    virtual bool IsInitialized() const = 0;
     
     /**
      * @brief 获取 TextRenderer 实例(用于文本测量等)
      * @return TextRenderer 指针,如果渲染器不支持则返回 nullptr
      */
     virtual TextRenderer* GetTextRenderer() const { return nullptr; }
+
+    /**
+     * @brief 获取排版用的字形度量来源（Phase 5.1，TextBlock 用它创建 TextLayout）
+     * @return 度量来源指针,如果渲染器不绘制文本则返回 nullptr
+     */
+    virtual GlyphMetricsProvider* GetGlyphMetrics() const { return nullptr; }
 };
 
 } // namespace fk::render
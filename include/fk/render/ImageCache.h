@@ -0,0 +1,179 @@
+#pragma once
+
+#include "fk/core/Dispatcher.h"
+#include "fk/core/Event.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fk::render {
+
+/**
+ * @brief 图像加载状态
+ */
+enum class ImageLoadState {
+    Decoding,   // 正在后台解码，尺寸未知
+    Uploading,  // 已解码，正在分批上传纹理（尺寸已知，显示占位）
+    Ready,      // 纹理可用
+    Failed,     // 解码失败
+    Evicted     // 纹理被 TextureManager 淘汰（尺寸保留），再次显示时调用 ImageCache::Reload
+};
+
+/**
+ * @brief 共享的图像资源（Phase 5.1）
+ *
+ * 由 ImageCache 按（路径，解码尺寸）共享；最后一个使用者释放后纹理在下一帧退役，
+ * 渲染列表不再引用时删除。
+ * 状态变化与 StateChanged 事件都在 UI 线程发生。
+ */
+class ImageResource {
+public:
+    ImageResource(std::string path, int decodeWidth, int decodeHeight);
+    ~ImageResource();
+
+    ImageResource(const ImageResource&) = delete;
+    ImageResource& operator=(const ImageResource&) = delete;
+
+    const std::string& Path() const { return path_; }
+    ImageLoadState GetState() const { return state_; }
+    bool IsReady() const { return state_ == ImageLoadState::Ready; }
+
+    /**
+     * @brief 图像文件的原始尺寸（解码完成前为 0），布局使用该尺寸
+     */
+    int SourceWidth() const { return sourceWidth_; }
+    int SourceHeight() const { return sourceHeight_; }
+
+    /**
+     * @brief 纹理尺寸（按解码尺寸缩小后的尺寸）
+     */
+    int Width() const { return width_; }
+    int Height() const { return height_; }
+
+    /**
+     * @brief OpenGL 纹理 ID，Ready 之前为 0
+     */
+    std::uint32_t TextureId() const { return state_ == ImageLoadState::Ready ? textureId_ : 0; }
+
+    /**
+     * @brief 状态变化（Uploading / Ready / Failed / Evicted）
+     */
+    core::Event<ImageLoadState> StateChanged;
+
+private:
+    friend class ImageCache;
+
+    void SetState(ImageLoadState state);
+
+    std::string path_;
+    int decodeWidth_{0};   // 请求的解码尺寸（0 表示不限制）
+    int decodeHeight_{0};
+    ImageLoadState state_{ImageLoadState::Decoding};
+    int sourceWidth_{0};
+    int sourceHeight_{0};
+    int width_{0};
+    int height_{0};
+
+    // 上传进度（仅 UI 线程）
+    std::vector<unsigned char> pixels_;  // RGBA8，上传完成后释放
+    int uploadedRows_{0};
+    std::uint32_t textureId_{0};
+};
+
+/**
+ * @brief 异步图像加载与纹理上传管线（Phase 5.1）
+ *
+ * 替代在 UI 线程同步 stbi_load + glTexImage2D 的方式：
+ * - 解码在 core::TaskPool 中执行，完成后通过 UI 线程的 Dispatcher 回到 UI 线程
+ * - 元素尺寸小于图像时按 2 的幂缩小解码结果，减少纹理内存与上传量
+ * - 纹理按行分批用 glTexSubImage2D 上传，每帧不超过上传预算，大图不会造成单帧卡顿
+ * - 相同（路径，解码尺寸）的请求共享同一个 ImageResource
+ * - 纹理在 TextureManager 中登记，超出显存预算时可被淘汰，需要时重新解码
+ *
+ * 没有设置 Dispatcher 时（如单元测试、无头渲染工具）在调用线程同步解码。
+ * ProcessUploads 需要在拥有 OpenGL 上下文的 UI 线程调用（Window 在布局前调用）。
+ */
+class ImageCache {
+public:
+    static ImageCache& Instance();
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    /**
+     * @brief 设置 UI 线程调度器（Application 构造时设置）
+     */
+    void SetDispatcher(std::shared_ptr<core::Dispatcher> dispatcher);
+
+    /**
+     * @brief 每帧纹理上传的字节数上限（默认 4MB，至少上传一行）
+     */
+    void SetUploadBudget(std::size_t bytesPerFrame) { uploadBudget_ = bytesPerFrame; }
+    std::size_t GetUploadBudget() const { return uploadBudget_; }
+
+    /**
+     * @brief 请求加载图像（UI 线程）
+     * @param decodeWidth 期望的解码宽度（显示尺寸），0 表示原始尺寸
+     * @param decodeHeight 期望的解码高度，0 表示原始尺寸
+     */
+    std::shared_ptr<ImageResource> Load(const std::string& path, int decodeWidth = 0, int decodeHeight = 0);
+
+    /**
+     * @brief 重新加载纹理已被淘汰的资源（UI 线程，状态回到 Decoding）
+     */
+    void Reload(const std::shared_ptr<ImageResource>& resource);
+
+    /**
+     * @brief 删除已释放的纹理，并在预算内上传排队的纹理数据（UI 线程，需要 OpenGL 上下文）
+     * @return 本次上传的字节数
+     */
+    std::size_t ProcessUploads();
+
+    /**
+     * @brief 是否有等待上传或删除的纹理（需要继续渲染帧）
+     */
+    bool HasPendingUploads() const;
+
+    /**
+     * @brief 缓存中仍被使用的资源数量
+     */
+    std::size_t Size() const;
+
+private:
+    friend class ImageResource;
+
+    ImageCache() = default;
+
+    struct DecodedImage {
+        std::vector<unsigned char> pixels;  // RGBA8
+        int sourceWidth{0};
+        int sourceHeight{0};
+        int width{0};
+        int height{0};
+    };
+
+    void StartDecode(const std::shared_ptr<ImageResource>& resource);
+    static DecodedImage Decode(const std::string& path, int decodeWidth, int decodeHeight);
+    void OnDecoded(const std::shared_ptr<ImageResource>& resource, DecodedImage& image);
+    void OnResourceReleased(std::uint32_t textureId);
+    static void OnTextureEvicted(ImageResource& resource);
+
+    // 键：路径 + 解码尺寸
+    std::unordered_map<std::string, std::weak_ptr<ImageResource>> resources_;
+    std::deque<std::weak_ptr<ImageResource>> uploadQueue_;
+    std::weak_ptr<core::Dispatcher> dispatcher_;
+    std::size_t uploadBudget_{4 * 1024 * 1024};
+
+    // 资源可能在任意线程析构，纹理留到 ProcessUploads 中退役，同时清理失效的缓存项
+    mutable std::mutex releaseMutex_;
+    std::vector<std::uint32_t> releasedTextures_;
+    bool hasReleasedResources_{false};
+};
+
+} // namespace fk::render
@@ -3,11 +3,14 @@
 #include <cstdint>
 #include <variant>
 #include <array>
+#include <memory>
 #include <vector>
 #include "fk/ui/base/UIElement.h"
 
 namespace fk::render {
 
+class TextLayout;
+
 /**
  * @brief 渲染命令类型
  */
@@ -75,20 +78,16 @@ struct RectanglePayload {
 struct TextPayload {
     ui::Rect bounds;
     std::array<float, 4> color;
-    std::string text;           // 文本内容
-    int fontId{0};              // 字体 ID
-    float fontSize{14.0f};      // 字体大小
-    std::string fontFamily;     // 字体?可?
-    bool textWrapping{false};   // 是否自动换行
-    float maxWidth{0.0f};       // 换行时的最大宽?
+    std::shared_ptr<const TextLayout> layout;   // Phase 5.1: 元素上保存的排版结果（共享，不复制文本）
 };
 
 /**
- * @brief 图像绘制载荷（占位）
+ * @brief 图像绘制载荷
  */
 struct ImagePayload {
     ui::Rect destRect;
     std::uint32_t textureId{0};
+    std::array<float, 4> tint{1.0f, 1.0f, 1.0f, 1.0f};  // 着色（已乘透明度）
 };
 
 /**
@@ -96,6 +95,11 @@ struct ImagePayload {
  */
 struct LayerPayload {
     float opacity{1.0f};
+
+    // Phase 5.1: 离屏图层
+    ui::Rect bounds;                    // 图层内容的全局包围盒（PopLayer 时回填）
+    std::uint64_t cacheId{0};           // 非 0 时渲染器跨帧保留图层位图（CacheMode::BitmapCache）
+    std::uint64_t contentVersion{0};    // 图层内容版本，与缓存位图一致时无需重新执行图层内的命令
 };
 
 /**
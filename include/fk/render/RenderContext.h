@@ -6,12 +6,15 @@
 #include <vector>
 #include <stack>
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 
 namespace fk::render {
 
 // 前向声明
 class RenderList;
 class TextRenderer;
+class DamageRegion;
 
 /**
  * @brief 变换状?
@@ -35,6 +38,24 @@ struct ClipState {
  */
 struct LayerState {
     float opacity{1.0f};
+    std::size_t commandIndex{0};   // PushLayer 命令的索引（弹出时回填包围盒，Phase 5.1）
+    ClipState clip;                // 进入图层时的裁剪
+    bool cached{false};            // 是否为缓存位图图层
+};
+
+/**
+ * @brief 子树渲染命令缓存条目（Phase 5.1）
+ * 
+ * 记录元素子树在某个 RenderList 中生成的命令区间，以及进入该子树时的
+ * 上下文状态。命令使用全局坐标并已应用裁剪，因此只有进入状态完全一致时
+ * 才能直接复用。透明度由图层整体合成，祖先透明度变化不影响子树命令。
+ */
+struct RenderCacheEntry {
+    std::uint64_t generation{0};   // 命令所在 RenderList 的代数（0 表示无缓存）
+    std::size_t start{0};          // 起始命令索引
+    std::size_t count{0};          // 命令数量
+    TransformState transform;      // 进入时的变换
+    ClipState clip;                // 进入时的裁剪
 };
 
 /**
@@ -127,8 +148,12 @@ public:
     /**
      * @brief 推入透明度图?
      * @param opacity 透明?(0.0-1.0)
+     * @param cacheId 非 0 时渲染器跨帧保留图层位图（Phase 5.1，CacheMode::BitmapCache）
+     * @param contentVersion 图层内容版本；与缓存位图的版本相同时渲染器直接合成位图
+     * 
+     * 图层内容绘制到离屏目标后按 opacity 整体合成，重叠的子元素不会互相透出。
      */
-    void PushLayer(float opacity);
+    void PushLayer(float opacity, std::uint64_t cacheId = 0, std::uint64_t contentVersion = 0);
     
     /**
      * @brief 弹出透明度图?
@@ -140,6 +165,67 @@ public:
      */
     float GetCurrentOpacity() const;
 
+    // ========== 子树命令缓存（Phase 5.1） ==========
+
+    /**
+     * @brief 设置上一帧的渲染列表（缓存命令的来源）
+     */
+    void SetPreviousFrame(const RenderList* previous) { previousList_ = previous; }
+
+    /**
+     * @brief 尝试复用上一帧的子树命令
+     * @param entry 缓存条目
+     * @return 是否已将缓存命令追加到当前列表
+     */
+    bool ReplayCachedCommands(RenderCacheEntry& entry);
+
+    /**
+     * @brief 开始记录子树命令（保存进入状态和起始位置）
+     * @param entry 缓存条目
+     * @param contentChanged 子树内容是否发生变化（需要计入损坏区域）
+     * @return 是否由该子树负责上报损坏区域，需原样传给 EndCacheRecord
+     */
+    bool BeginCacheRecord(RenderCacheEntry& entry, bool contentChanged);
+
+    /**
+     * @brief 结束记录子树命令
+     * @param entry 缓存条目
+     * @param trackDamage BeginCacheRecord 的返回值
+     */
+    void EndCacheRecord(RenderCacheEntry& entry, bool trackDamage);
+
+    /**
+     * @brief 设置损坏区域收集器（Phase 5.1 脏矩形重绘）
+     */
+    void SetDamageRegion(DamageRegion* damage) { damage_ = damage; }
+
+    /**
+     * @brief 将子树上一帧的绘制区域计入损坏区域（子树被隐藏时使用）
+     */
+    void AddPreviousDamage(const RenderCacheEntry& entry);
+
+    /**
+     * @brief 是否需要上报损坏区域（设置了收集器且祖先没有上报整棵子树）
+     */
+    bool IsTrackingDamage() const { return damage_ && damageTrackingDepth_ == 0; }
+
+    /**
+     * @brief 将局部矩形计入损坏区域（与当前裁剪求交）
+     */
+    void AddDamage(const ui::Rect& rect);
+
+    // ========== 合成滚动（Phase 5.1） ==========
+
+    /**
+     * @brief 追加保留的命令并整体平移
+     * @param source 保留的命令（内容坐标系）
+     * @param offsetX 内容原点的 X 坐标（局部坐标）
+     * @param offsetY 内容原点的 Y 坐标（局部坐标）
+     * 
+     * 平移后的裁剪命令与当前裁剪求交，追加完成后恢复当前变换与裁剪。
+     */
+    void AppendTranslated(const RenderList& source, float offsetX, float offsetY);
+
     // ========== 绘制 API ==========
     
     /**
@@ -190,22 +276,14 @@ public:
     
     /**
      * @brief 绘制文本
-     * @param bounds 文本边界矩形（局部坐标），用于裁?
-     * @param text 文本内容
+     * @param bounds 文本边界矩形（局部坐标），用于裁剪
+     * @param layout 排版结果（TextLayout，绘制命令共享同一对象）
      * @param color 文本颜色
-     * @param fontSize 字体大小
-     * @param fontFamily 字体?
-     * @param maxWidth 最大宽度（用于自动换行? 表示不限制）
-     * @param textWrapping 是否自动换行
      */
     void DrawText(
         const ui::Rect& bounds,
-        const std::string& text,
-        const std::array<float, 4>& color,
-        float fontSize,
-        const std::string& fontFamily = "Arial",
-        float maxWidth = 0.0f,
-        bool textWrapping = false
+        std::shared_ptr<const TextLayout> layout,
+        const std::array<float, 4>& color
     );
     
     /**
@@ -307,13 +385,11 @@ private:
      */
     void ApplyCurrentClip();
     
-    /**
-     * @brief 应用当前透明度到颜色
-     */
-    std::array<float, 4> ApplyOpacity(const std::array<float, 4>& color) const;
-
 private:
     RenderList* renderList_{nullptr};       // 渲染命令列表
+    const RenderList* previousList_{nullptr};  // 上一帧渲染命令列表（Phase 5.1）
+    DamageRegion* damage_{nullptr};            // 损坏区域收集器（Phase 5.1）
+    int damageTrackingDepth_{0};               // 祖先已上报整棵子树时无需重复计算
     TextRenderer* textRenderer_{nullptr};   // 文本渲染?
     
     // 状态栈
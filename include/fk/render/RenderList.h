@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <cstddef>
+#include <cstdint>
 
 namespace fk::render {
 
@@ -18,6 +19,19 @@ struct CommandBatch {
     CommandType type;         // 批次命令类型
 };
 
+/**
+ * @brief 计算绘制命令的全局包围盒（含描边和抗锯齿余量）
+ * @param command 渲染命令
+ * @param outBounds 输出包围盒
+ * @return 状态命令（裁剪、变换、图层）返回 false
+ */
+bool GetCommandBounds(const RenderCommand& command, ui::Rect& outBounds);
+
+/**
+ * @brief 平移命令的全局坐标（合成滚动复用保留的命令，Phase 5.1）
+ */
+void TranslateCommand(RenderCommand& command, float dx, float dy);
+
 /**
  * @brief 渲染列表统计信息
  */
@@ -43,6 +57,10 @@ public:
     RenderList();
     ~RenderList();
 
+    // 列表持有纹理引用，禁止拷贝
+    RenderList(const RenderList&) = delete;
+    RenderList& operator=(const RenderList&) = delete;
+
     /**
      * @brief 添加渲染命令
      */
@@ -58,6 +76,30 @@ public:
      */
     void AddCommands(const std::vector<RenderCommand>& commands);
 
+    /**
+     * @brief 从另一个列表复制一段命令（用于复用上一帧的子树命令）
+     * @param source 源列表
+     * @param start 起始索引
+     * @param count 命令数量
+     */
+    void AppendRange(const RenderList& source, size_t start, size_t count);
+
+    /**
+     * @brief 从另一个列表复制一段命令并整体平移（合成滚动，Phase 5.1）
+     * @param source 源列表
+     * @param start 起始索引
+     * @param count 命令数量
+     * @param dx 水平平移量
+     * @param dy 垂直平移量
+     * @param clip 目标位置的裁剪
+     * 
+     * 平移后的裁剪命令与 clip 求交，禁用裁剪的命令替换为 clip；完全落在裁剪外的
+     * 绘制命令不会产生像素，直接跳过。缓存位图图层内的命令绘制到图层位图中，只平移。
+     * 变换命令不影响渲染（坐标已是全局坐标），不复制。
+     */
+    void AppendTranslated(const RenderList& source, size_t start, size_t count,
+                          float dx, float dy, const ClipPayload& clip);
+
     /**
      * @brief 获取所有命令（只读）
      */
@@ -83,12 +125,41 @@ public:
      */
     size_t GetCommandCount() const { return commands_.size(); }
 
+    /**
+     * @brief 获取列表代数
+     * 
+     * 每次 Clear() 或 Optimize() 后分配新的全局唯一代数，
+     * 用于判断记录在该列表中的命令区间是否仍然有效
+     */
+    std::uint64_t GetGeneration() const { return generation_; }
+
+    /**
+     * @brief 计算一段命令中所有绘制命令的包围盒并集
+     * 
+     * 包围盒与区间内裁剪命令设置的裁剪区域求交（区间开始前的裁剪未知，不限制）；
+     * 图层内的命令只通过图层合成显示，受进入图层时的裁剪限制。
+     */
+    ui::Rect ComputeBounds(size_t start, size_t count) const;
+
+    /**
+     * @brief 回填 PushLayer 命令的图层包围盒（图层内容记录完成后才能确定）
+     */
+    void SetLayerBounds(size_t index, const ui::Rect& bounds);
+
     /**
      * @brief 优化命令列表（批处理、去重）
      * 
      * 应在所有命令添加完成后调用
      */
     void Optimize();
+
+    /**
+     * @brief 构建命令批次（相同类型的连续绘制命令分为一组）
+     * 
+     * 不改变命令顺序，也不更新列表代数，可以在保留式渲染列表上每帧调用。
+     * 之后再添加命令会使批次失效，需要重新构建。
+     */
+    void BuildBatches();
     
     /**
      * @brief 获取统计信息
@@ -116,11 +187,6 @@ public:
     }
 
 private:
-    /**
-     * @brief 构建命令批次
-     */
-    void BuildBatches();
-    
     /**
      * @brief 去除重复命令
      */
@@ -141,6 +207,11 @@ private:
      */
     bool IsDuplicate(const RenderCommand& a, const RenderCommand& b) const;
 
+    /**
+     * @brief DrawImage 命令引用纹理，防止列表存活期间纹理被 TextureManager 淘汰
+     */
+    void ReferenceTexture(const RenderCommand& command);
+
 private:
     std::vector<RenderCommand> commands_;       // 命令列表
     std::vector<CommandBatch> batches_;         // 命令批次
@@ -151,6 +222,12 @@ private:
     
     // 优化标志
     bool optimized_{false};
+
+    // 列表代数（命令区间缓存校验用）
+    std::uint64_t generation_{0};
+
+    // Phase 5.1: DrawImage 命令引用的纹理（Clear 时释放）
+    std::vector<std::uint32_t> textureRefs_;
 };
 
 } // namespace fk::render
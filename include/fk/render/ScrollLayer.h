@@ -0,0 +1,66 @@
+#pragma once
+
+#include "fk/render/DamageRegion.h"
+#include "fk/ui/graphics/Primitives.h"
+#include <memory>
+
+namespace fk::ui {
+class UIElement;
+}
+
+namespace fk::render {
+
+class RenderContext;
+class RenderList;
+
+/**
+ * @brief 合成滚动图层（Phase 5.1）
+ *
+ * 在内容坐标系中保留滚动内容的绘制命令。滚动偏移变化时不重新排列、也不重新
+ * 收集内容的命令，只把保留的命令平移到内容的当前位置，并与视口裁剪求交。
+ *
+ * 命令按记录窗口（视口向四周各外扩一个视口）剔除：视口移出记录窗口或内容
+ * 变化时才重新记录，此时子树命令缓存仍然有效，只有新进入窗口的元素需要生成命令。
+ *
+ * 图层只保留命令，不保留像素：滚动时整个视口仍计入损坏区域，由渲染器重新光栅化。
+ */
+class ScrollLayer {
+public:
+    ScrollLayer();
+    ~ScrollLayer();
+
+    ScrollLayer(const ScrollLayer&) = delete;
+    ScrollLayer& operator=(const ScrollLayer&) = delete;
+
+    /**
+     * @brief 将滚动内容合成到当前渲染列表
+     * @param context 当前渲染上下文（已推入视口裁剪）
+     * @param content 滚动内容（布局位置为负的滚动偏移）
+     * @param viewportSize 视口大小
+     */
+    void Compose(RenderContext& context, ui::UIElement* content, const ui::Size& viewportSize);
+
+    /**
+     * @brief 丢弃保留的命令，下次合成时重新记录
+     */
+    void Invalidate() { recorded_ = false; }
+
+    /**
+     * @brief 重新记录内容命令的次数（统计用）
+     */
+    std::size_t GetRecordCount() const { return recordCount_; }
+
+private:
+    void Record(RenderContext& context, ui::UIElement* content, const ui::Rect& visible);
+
+    // 交替使用的两个列表：上一次记录的命令供子树命令缓存复用
+    std::unique_ptr<RenderList> current_;
+    std::unique_ptr<RenderList> previous_;
+    DamageRegion damage_;              // 内容变化时的损坏区域（内容坐标）
+    ui::UIElement* content_{nullptr};  // 记录时的内容元素
+    ui::Rect window_;                  // 记录窗口（内容坐标）
+    bool recorded_{false};
+    std::size_t recordCount_{0};
+};
+
+} // namespace fk::render
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fk::render {
+
+/**
+ * @brief 距离场字形
+ *
+ * 度量为参考字号下的值，按 字号 / 参考字号 缩放后使用。
+ * 像素为 8 位有符号距离：减去 128 后正值在轮廓内、负值在轮廓外，
+ * ±128 对应 ±spread 个参考字号像素。
+ */
+struct SdfGlyph {
+    std::uint16_t width{0};             // 距离场宽度（含 spread 边距）
+    std::uint16_t height{0};            // 距离场高度
+    std::int16_t bearingX{0};           // 距离场左边缘相对笔位置的偏移
+    std::int16_t bearingY{0};           // 距离场上边缘相对基线的偏移
+    float advance{0.0f};                // 水平前进值（未 hinting，可按比例缩放）
+    std::vector<std::uint8_t> pixels;   // width * height 个距离值（空白字形为空）
+};
+
+/**
+ * @brief 一个字体的距离场字形集（Phase 5.1）
+ *
+ * 每个字形只在参考字号下用 FreeType 的 SDF 渲染器生成一次，之后任意字号都由
+ * 距离场着色（GlRenderer）或采样（SoftwareRenderer）得到，字号动画与缩放不再为
+ * 每个像素字号重新栅格化字形。
+ *
+ * 字形集可以离线烘焙常用字符并保存为二进制文件，启动时加载并 Register 后这些字符
+ * 不需要生成。文件以字体族与样式名（如 "DejaVu Sans" / "Bold"）标识字体，与字体文件
+ * 路径无关。渲染器按同一标识从进程内注册表取得字形集，多个窗口共享已生成的字形。
+ * 注册表与字形集都需要在 UI 线程使用。
+ *
+ * 彩色字形（emoji）没有轮廓距离场，仍按位图渲染。
+ */
+class SdfGlyphSet {
+public:
+    static constexpr int kDefaultReferenceSize = 48;
+    static constexpr int kDefaultSpread = 6;
+
+    /**
+     * @param family 字体族名称
+     * @param style 样式名称
+     * @param referenceSize 生成距离场的参考字号（像素）
+     * @param spread 距离场覆盖的最大距离（参考字号像素）
+     */
+    SdfGlyphSet(std::string family, std::string style,
+                int referenceSize = kDefaultReferenceSize, int spread = kDefaultSpread);
+
+    /**
+     * @brief 字体的标识（"字体族 样式"），用于匹配预烘焙的字形集
+     */
+    static std::string KeyOf(FT_Face face);
+
+    /**
+     * @brief 字体能否生成距离场（可缩放的轮廓字体，且不是彩色字体）
+     */
+    static bool Supports(FT_Face face);
+
+    /**
+     * @brief 查找已有的字形
+     */
+    const SdfGlyph* Find(char32_t c) const;
+
+    /**
+     * @brief 查找或生成字形
+     * @param face 已设置为参考字号的字体
+     * @return 字体不含该字符或生成失败时返回 nullptr（结果同样缓存）
+     */
+    const SdfGlyph* Generate(FT_Face face, char32_t c);
+
+    /**
+     * @brief 批量生成字形（离线烘焙）
+     * @return 新生成的字形数
+     */
+    std::size_t Bake(FT_Face face, std::u32string_view codepoints);
+
+    /**
+     * @brief 打开字体文件并烘焙字形集
+     * @return 字体无法打开或不支持距离场时返回 nullptr
+     */
+    static std::shared_ptr<SdfGlyphSet> BakeFont(const std::string& fontPath, int faceIndex,
+                                                 std::u32string_view codepoints,
+                                                 int referenceSize = kDefaultReferenceSize,
+                                                 int spread = kDefaultSpread);
+
+    /**
+     * @brief 常用字符集：ASCII 可打印字符与拉丁文补充
+     */
+    static std::u32string CommonCodepoints();
+
+    /**
+     * @brief 注册字形集（替换同一字体的已有字形集，只影响之后加载的字体）
+     */
+    static void Register(std::shared_ptr<SdfGlyphSet> glyphSet);
+
+    /**
+     * @brief 按字体标识（KeyOf）查找已注册的字形集
+     */
+    static std::shared_ptr<SdfGlyphSet> FindRegistered(const std::string& key);
+
+    /**
+     * @brief 清空注册表
+     */
+    static void ClearRegistry();
+
+    /**
+     * @brief 保存为二进制文件
+     */
+    bool Save(const std::string& path) const;
+
+    /**
+     * @brief 从二进制文件加载，格式或版本不符时返回 nullptr
+     */
+    static std::shared_ptr<SdfGlyphSet> Load(const std::string& path);
+
+    const std::string& GetFamily() const { return family_; }
+    const std::string& GetStyle() const { return style_; }
+    std::string GetKey() const { return family_ + " " + style_; }
+    int GetReferenceSize() const { return referenceSize_; }
+    int GetSpread() const { return spread_; }
+    std::size_t GetGlyphCount() const { return glyphs_.size(); }
+
+    /**
+     * @brief 由本对象调用 FreeType 生成的字形数（不含从文件加载的字形）
+     */
+    std::size_t GetGeneratedCount() const { return generated_; }
+
+private:
+    std::string family_;
+    std::string style_;
+    int referenceSize_;
+    int spread_;
+    std::unordered_map<char32_t, SdfGlyph> glyphs_;
+    std::unordered_set<char32_t> missing_;
+    std::size_t generated_{0};
+};
+
+} // namespace fk::render
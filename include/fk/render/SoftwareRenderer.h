@@ -0,0 +1,208 @@
+#pragma once
+
+#include "fk/render/IRenderer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fk::render {
+
+class RenderList;
+struct RenderCommand;
+struct ClipPayload;
+struct RectanglePayload;
+struct TextPayload;
+struct PolygonPayload;
+struct PathPayload;
+struct LayerPayload;
+
+/**
+ * @brief CPU 光栅化渲染器（Phase 5.1）
+ *
+ * 将 RenderList 渲染到内存中的 RGBA8 帧缓冲，不需要 OpenGL 上下文或显示设备。
+ * 供无头窗口使用：CI 中的像素对比回归测试、无 GPU 构建机上的帧耗时基准。
+ *
+ * 语义与 GlRenderer 保持一致：
+ * - 命令坐标均为全局坐标，SetClip 为轴对齐裁剪矩形
+ * - 不透明度小于 1 的图层先绘制到透明的离屏缓冲，再按不透明度整体合成
+ *   （CacheMode 位图缓存只影响 GlRenderer 的性能，这里每帧执行图层内的命令）
+ * - 按 SRC_ALPHA / ONE_MINUS_SRC_ALPHA 混合
+ * - 帧缓冲跨帧保留，FrameContext::fullRedraw 为 false 时只重绘损坏区域
+ *
+ * 矩形使用与着色器相同的 SDF 计算覆盖率；多边形和路径按非零环绕规则
+ * 扫描线填充（每像素 4 条子扫描线，水平方向精确覆盖率）；
+ * 文本由 FreeType 在 CPU 上光栅化字形，距离场模式（GlyphRenderMode::SignedDistanceField）
+ * 下按字号双线性采样共享的距离场字形。
+ *
+ * 使用方式：
+ * ```cpp
+ * SoftwareRenderer renderer;
+ * renderer.Initialize({nullptr, {800, 600}});
+ * renderer.BeginFrame(frameCtx);
+ * renderer.Draw(list);
+ * renderer.EndFrame();
+ * renderer.SavePng("frame.png");
+ * ```
+ */
+class SoftwareRenderer : public IRenderer {
+public:
+    SoftwareRenderer();
+    ~SoftwareRenderer() override;
+
+    // 禁止拷贝
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    // IRenderer 接口实现
+    void Initialize(const RendererInitParams& params) override;
+    void Resize(const Extent2D& size) override;
+    void BeginFrame(const FrameContext& ctx) override;
+    void Draw(const RenderList& list) override;
+    void EndFrame() override;
+    void Shutdown() override;
+    bool IsInitialized() const override { return initialized_; }
+
+    /**
+     * @brief 排版用的字形度量来源（与绘制使用同一字形缓存，初始化后可用）
+     */
+    GlyphMetricsProvider* GetGlyphMetrics() const override;
+
+    // ========== 帧缓冲访问 ==========
+
+    /**
+     * @brief 帧缓冲尺寸
+     */
+    Extent2D GetSize() const { return size_; }
+
+    /**
+     * @brief 帧缓冲像素（RGBA8，自上而下逐行排列，行间无填充）
+     */
+    const std::vector<std::uint8_t>& GetPixels() const { return pixels_; }
+
+    /**
+     * @brief 读取单个像素（越界时返回全 0）
+     */
+    std::array<std::uint8_t, 4> GetPixel(std::uint32_t x, std::uint32_t y) const;
+
+    /**
+     * @brief 已完成的帧数
+     */
+    std::uint64_t GetFrameCount() const { return frameCount_; }
+
+    /**
+     * @brief 已栅格化的位图字形数（距离场模式下的字形计入 SdfGlyphSet::GetGeneratedCount）
+     */
+    std::size_t GetRasterizedGlyphCount() const;
+
+    /**
+     * @brief 将帧缓冲保存为 PNG（不压缩）
+     * @return 是否写入成功
+     */
+    bool SavePng(const std::string& path) const;
+
+    /**
+     * @brief 比较两幅同尺寸的 RGBA8 图像
+     * @param tolerance 单个通道允许的最大差值
+     * @return 任一通道差值超过容差的像素数
+     */
+    static std::size_t CompareImages(const std::uint8_t* lhs, const std::uint8_t* rhs,
+                                     std::size_t pixelCount, int tolerance = 0);
+
+private:
+    // 像素裁剪矩形（半开区间 [x0, x1) x [y0, y1)）
+    struct PixelRect {
+        int x0{0};
+        int y0{0};
+        int x1{0};
+        int y1{0};
+
+        bool IsEmpty() const { return x1 <= x0 || y1 <= y0; }
+        PixelRect Intersect(const PixelRect& other) const;
+    };
+
+    struct FontCache;  // FreeType 字形缓存（不在头文件中暴露 FreeType）
+
+    /**
+     * @brief 逐条执行命令，跳过与损坏区域不相交的绘制命令
+     */
+    void ExecuteCommands(const RenderList& list, const ui::Rect* damage);
+    void ExecuteCommand(const RenderCommand& cmd);
+
+    /**
+     * @brief 从根状态开始重绘 base 区域（裁剪、图层栈复位）
+     */
+    void ResetState(const PixelRect& base);
+
+    void ApplyClip(const ClipPayload& payload);
+    void DrawRectangle(const RectanglePayload& payload);
+    void DrawText(const TextPayload& payload);
+    void DrawSdfGlyph(char32_t codepoint, int fontId, float penX, float baseline,
+                      const PixelRect& area, const std::array<float, 4>& color, float opacity);
+    void DrawPolygon(const PolygonPayload& payload);
+    void DrawPath(const PathPayload& payload);
+    void PushLayer(const LayerPayload& payload);
+    void PopLayer();
+
+    /**
+     * @brief 将离屏图层（预乘 alpha）按不透明度合成到当前帧缓冲的裁剪区域
+     */
+    void CompositeLayer(const std::vector<std::uint8_t>& layer, const PixelRect& rect, float opacity);
+
+    /**
+     * @brief 按非零环绕规则填充一组闭合轮廓
+     */
+    void FillContours(const std::vector<std::vector<ui::Point>>& contours, const std::array<float, 4>& color);
+
+    /**
+     * @brief 描边折线（圆形连接与端点，与 GlRenderer 的路径描边一致）
+     */
+    void StrokePolyline(const std::vector<ui::Point>& points, bool closed, float thickness,
+                        const std::array<float, 4>& color);
+
+    /**
+     * @brief 用清除颜色填充区域
+     */
+    void ClearRect(const PixelRect& rect);
+
+    /**
+     * @brief 混合单个像素（alpha 已包含覆盖率和图层不透明度）
+     */
+    void BlendPixel(int x, int y, float r, float g, float b, float alpha);
+
+    float CurrentOpacity() const { return layerStack_.empty() ? 1.0f : layerStack_.back().opacity; }
+    PixelRect SurfaceRect() const;
+    static PixelRect ToPixelRect(const ui::Rect& rect);
+
+    Extent2D size_{};
+    std::vector<std::uint8_t> pixels_;
+    FrameContext currentFrame_{};
+    bool fullRedraw_{true};
+    bool contentValid_{false};       // 帧缓冲内容是否可以作为脏矩形重绘的基础
+    std::uint64_t frameCount_{0};
+
+    PixelRect baseClip_{};           // 当前重绘区域（整帧或单个损坏区域）
+    PixelRect clip_{};               // 当前有效裁剪（baseClip_ 与 SetClip 的交集）
+
+    // 图层栈：离屏图层绘制期间 pixels_ 与 layerBuffers_ 中的缓冲交换
+    struct LayerState {
+        float opacity{1.0f};             // 图元的不透明度乘子（离屏图层内为 1）
+        bool offscreen{false};           // 是否绘制到离屏缓冲（弹出时合成）
+        float compositeOpacity{1.0f};    // 合成时的不透明度
+        PixelRect rect{};                // 图层区域
+        PixelRect parentClip{};          // 进入图层时的裁剪（弹出时恢复）
+        PixelRect parentBaseClip{};
+        std::size_t buffer{0};           // layerBuffers_ 中的索引
+    };
+    std::vector<LayerState> layerStack_;
+    std::vector<std::vector<std::uint8_t>> layerBuffers_;  // 按嵌套深度复用的离屏缓冲（与帧缓冲同尺寸）
+    std::size_t offscreenDepth_{0};
+
+    std::unique_ptr<FontCache> fonts_;
+    bool initialized_{false};
+};
+
+} // namespace fk::render
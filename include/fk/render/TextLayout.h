@@ -0,0 +1,192 @@
+#pragma once
+
+#include "fk/render/TextShaping.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fk::render {
+
+/**
+ * @brief 排版所需的字形度量来源（Phase 5.1）
+ *
+ * TextRenderer（OpenGL）与 SoftwareRenderer 的字形缓存各自实现。
+ * 字体 ID 只在同一来源内有意义：排版结果记录来源 ID，
+ * 由其他来源绘制时按码点与字号重新查找字形。每个来源持有自己的整形缓存。
+ */
+class GlyphMetricsProvider {
+public:
+    virtual ~GlyphMetricsProvider() = default;
+
+    /**
+     * @brief 来源 ID（进程内唯一，来源销毁后不会被复用）
+     */
+    std::uint64_t GetProviderId() const { return providerId_; }
+
+    /**
+     * @brief 按字体族、字号、字重与样式解析主字体
+     * @param fontWeight 字重（100-900）
+     * @param italic 是否为斜体
+     * @return 字体 ID，失败返回 -1
+     */
+    virtual int ResolveFont(const std::string& fontFamily, float fontSize, int fontWeight, bool italic) = 0;
+
+    /**
+     * @brief 查找字符的字形（含回退字体）
+     * @param c 字符码点
+     * @param fontId 主字体 ID
+     * @param glyphFontId 输出字形实际所在的字体 ID
+     * @param advance 输出水平前进值（像素）
+     * @return 字符不可用时返回 false
+     */
+    virtual bool GetGlyphAdvance(char32_t c, int fontId, int& glyphFontId, float& advance) = 0;
+
+    /**
+     * @brief 同一字体中两个相邻字符的字距调整（像素，字体没有 'kern' 表时为 0）
+     * @param fontId 两个字形所在的字体 ID
+     */
+    virtual float GetKerning(int fontId, char32_t left, char32_t right) = 0;
+
+    /**
+     * @brief 字体文件来源（供 HarfBuzz 整形）
+     * @param path 输出字体文件路径
+     * @param faceIndex 输出集合文件中的 face 索引
+     * @param fontSize 输出字号（像素）
+     * @return 不能按字形索引绘制的字体（距离场字体）返回 false，此时使用内置整形
+     */
+    virtual bool GetFontSource(int /*fontId*/, std::string& /*path*/, int& /*faceIndex*/,
+                               float& /*fontSize*/) const {
+        return false;
+    }
+
+    /**
+     * @brief 整形缓存
+     */
+    ShapeRunCache& GetShapeCache() { return shapeCache_; }
+
+protected:
+    GlyphMetricsProvider();
+
+private:
+    std::uint64_t providerId_;
+    ShapeRunCache shapeCache_;
+};
+
+/**
+ * @brief 排版后的字形
+ */
+struct TextLayoutGlyph {
+    char32_t codepoint{0};
+    int fontId{-1};         // 字形所在字体（已解析回退）
+    float x{0.0f};          // 相对行首的笔位置
+    float advance{0.0f};    // 水平前进值（含字距调整）
+    std::uint32_t cluster{0};   // 对应的第一个字符在文本（UTF-32）中的索引
+    float xOffset{0.0f};    // 相对笔位置的绘制偏移（组合标记定位，y 向下）
+    float yOffset{0.0f};
+};
+
+/**
+ * @brief 排版后的一行
+ */
+struct TextLayoutLine {
+    std::uint32_t firstGlyph{0};    // 第一个字形在 GetGlyphs() 中的索引
+    std::uint32_t glyphCount{0};
+    float width{0.0f};              // 行宽
+    TextDirection direction{TextDirection::LeftToRight};  // 所在段落的方向
+};
+
+/**
+ * @brief 不可变的文本排版结果（Phase 5.1）
+ *
+ * 每个 (文本, 字体, 字号, 换行宽度) 只排版一次：先按 \n 分段，每段经双向文本分段后
+ * 以单词为单位整形（结果由来源的 ShapeRunCache 缓存），换行时再按字形前进值自动换行，
+ * 最后按嵌入层级把每行的字形排成视觉顺序。TextBlock 在测量时创建并保存在元素上，
+ * 绘制命令（TextPayload）共享同一对象，渲染器直接按字形位置绘制，
+ * 不再逐帧分行、转码、换行和计算行宽。
+ *
+ * 第 i 行的顶部位于 i * GetLineHeight()，字形基线在行顶之下 fontSize 处。
+ * 每行的字形按从左到右的视觉顺序排列，x 单调递增。
+ */
+class TextLayout {
+public:
+    /**
+     * @brief 排版文本
+     * @param provider 字形度量来源
+     * @param fontId provider 解析出的主字体 ID
+     * @param fontFamily 字体族（其他来源绘制时用于重新解析字体）
+     * @param text UTF-8 编码的文本
+     * @param fontSize 字体大小
+     * @param maxWidth 自动换行宽度（0 表示不自动换行）
+     * @param features 整形特性
+     */
+    static std::shared_ptr<const TextLayout> Create(
+        GlyphMetricsProvider& provider,
+        int fontId,
+        const std::string& fontFamily,
+        const std::string& text,
+        float fontSize,
+        float maxWidth = 0.0f,
+        ShapingFeatures features = ShapingFeatures::Default
+    );
+
+    /**
+     * @brief 是否为同一来源、字体、文本和整形特性的排版（不比较换行宽度）
+     */
+    bool Matches(const GlyphMetricsProvider& provider, int fontId, const std::string& text,
+                 float fontSize, bool wrapped, ShapingFeatures features = ShapingFeatures::Default) const;
+
+    /**
+     * @brief 以 maxWidth 重新换行时结果是否不变
+     *
+     * 测量时的可用宽度与排列后的宽度通常不同，只要每行仍放得下、
+     * 且被换到下一行的字形仍放不下，就可以继续使用同一排版。
+     */
+    bool FitsWidth(float maxWidth) const;
+
+    std::uint64_t GetProviderId() const { return providerId_; }
+    int GetFontId() const { return fontId_; }
+    const std::string& GetFontFamily() const { return fontFamily_; }
+    const std::string& GetText() const { return text_; }
+    float GetFontSize() const { return fontSize_; }
+    bool IsWrapped() const { return wrapped_; }
+    ShapingFeatures GetFeatures() const { return features_; }
+
+    const std::vector<TextLayoutGlyph>& GetGlyphs() const { return glyphs_; }
+    const std::vector<TextLayoutLine>& GetLines() const { return lines_; }
+
+    float GetLineHeight() const { return fontSize_ * 1.2f; }
+    float GetWidth() const { return width_; }
+    float GetHeight() const { return static_cast<float>(lines_.size()) * GetLineHeight(); }
+
+private:
+    TextLayout() = default;
+
+    // 对一个段落的字形（逻辑顺序）自动换行
+    void AppendParagraph(const std::vector<TextLayoutGlyph>& logical, const std::vector<std::uint8_t>& levels,
+                         TextDirection direction, float maxWidth);
+    // 把 [begin, end) 的字形按视觉顺序加入新的一行
+    void AppendLine(const std::vector<TextLayoutGlyph>& logical, const std::vector<std::uint8_t>& levels,
+                    std::size_t begin, std::size_t end, float width, TextDirection direction);
+
+    std::uint64_t providerId_{0};
+    int fontId_{-1};
+    std::string fontFamily_;
+    std::string text_;
+    float fontSize_{0.0f};
+    bool wrapped_{false};
+    ShapingFeatures features_{ShapingFeatures::Default};
+
+    std::vector<TextLayoutGlyph> glyphs_;
+    std::vector<TextLayoutLine> lines_;
+    float width_{0.0f};
+
+    // 换行结果不变的宽度范围 [requiredWidth_, overflowWidth_)
+    float requiredWidth_{0.0f};
+    float overflowWidth_{std::numeric_limits<float>::infinity()};
+};
+
+} // namespace fk::render
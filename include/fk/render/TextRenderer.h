@@ -1,5 +1,11 @@
 #pragma once
 
+#include "fk/render/FontManager.h"
+#include "fk/render/GlyphAtlas.h"
+#include "fk/render/IRenderer.h"
+#include "fk/render/SdfGlyphSet.h"
+#include "fk/render/TextLayout.h"
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
@@ -13,13 +19,34 @@ namespace fk::render {
 
 // 字形信息
 struct Glyph {
-    unsigned int textureID;  // OpenGL 纹理 ID
-    int width;              // 字形宽度
-    int height;             // 字形高度
-    int bearingX;           // 字形水平偏移
-    int bearingY;           // 字形垂直偏移
-    int advance;            // 水平前进值
-    bool isColor;           // 是否为彩色字形（emoji）
+    unsigned int textureID{0};  // 所在图集页的 OpenGL 纹理 ID（空白字形为 0）
+    int width{0};               // 字形宽度
+    int height{0};              // 字形高度
+    int bearingX{0};            // 字形水平偏移
+    int bearingY{0};            // 字形垂直偏移
+    int advance{0};             // 水平前进值
+    bool isColor{false};        // 是否为彩色字形（emoji）
+    int atlasPage{-1};          // 图集页索引
+    float u0{0.0f};             // 图集纹理坐标（左上）
+    float v0{0.0f};
+    float u1{0.0f};             // 图集纹理坐标（右下）
+    float v1{0.0f};
+
+    // Phase 5.1: 距离场字形（整数度量为取整值，绘制与排版使用下面按字号缩放的精确值）
+    bool isSdf{false};
+    float sdfRange{0.0f};       // 距离值 ±128 对应的屏幕像素数（spread × 缩放比例）
+    float sdfBearingX{0.0f};
+    float sdfBearingY{0.0f};
+    float sdfWidth{0.0f};
+    float sdfHeight{0.0f};
+    float sdfAdvance{0.0f};
+};
+
+// Phase 5.1: 距离场字体（同一字体文件的所有字号共享距离场与图集区域）
+struct SdfFont {
+    FT_Face face{nullptr};                       // 设置为参考字号的字体
+    std::shared_ptr<SdfGlyphSet> glyphSet;       // 距离场字形集（可来自预烘焙文件）
+    std::unordered_map<char32_t, Glyph> glyphs;  // 已上传到图集的字形（参考字号度量）
 };
 
 // 字体信息
@@ -28,33 +55,30 @@ struct FontFace {
     std::unordered_map<char32_t, Glyph> glyphs;  // 字符到字形的映射
     std::string fontPath;                         // 字体文件路径（用于缓存）
     unsigned int fontSize;                        // 字体大小
+    int faceIndex{0};                             // 集合文件中的 face 索引
+    FontFaceId managerFace{-1};                   // Phase 5.1: FontManager 中的字体（-1 表示未索引）
+    SdfFont* sdf{nullptr};                        // Phase 5.1: 距离场字体（face 与其共享）
 };
 
-// 字体缓存键（路径 + 大小）
+// 字体缓存键（路径 + 大小 + face 索引）
 struct FontCacheKey {
     std::string path;
     unsigned int size;
+    int faceIndex{0};
     
     bool operator==(const FontCacheKey& other) const {
-        return path == other.path && size == other.size;
+        return path == other.path && size == other.size && faceIndex == other.faceIndex;
     }
 };
 
 // 字体缓存键哈希函数
 struct FontCacheKeyHash {
     std::size_t operator()(const FontCacheKey& key) const {
-        return std::hash<std::string>()(key.path) ^ (std::hash<unsigned int>()(key.size) << 1);
+        return std::hash<std::string>()(key.path) ^ (std::hash<unsigned int>()(key.size) << 1) ^
+               (std::hash<int>()(key.faceIndex) << 2);
     }
 };
 
-// 多行文本布局信息
-struct TextLayout {
-    std::vector<std::u32string> lines;  // 分行的文本
-    std::vector<int> lineWidths;        // 每行宽度
-    int totalWidth{0};                  // 总宽度
-    int totalHeight{0};                 // 总高度
-};
-
 /**
  * @brief 文本渲染器（Phase 5.0.3 增强版）
  * 
@@ -66,8 +90,14 @@ struct TextLayout {
  * - 默认字体设置
  * - 字体回退机制
  * - 多行文本布局
+ * 
+ * Phase 5.1 新增功能：
+ * - 字形打包进 GlyphAtlas 纹理页，同页字形可批量绘制
+ * - 作为 GlyphMetricsProvider 为 TextLayout 提供字形度量
+ * - 字体解析与按码位块的字体回退由 FontManager 完成
+ * - 距离场模式：字形在参考字号下生成一次，所有字号共享图集区域
  */
-class TextRenderer {
+class TextRenderer : public GlyphMetricsProvider {
 public:
     TextRenderer();
     ~TextRenderer();
@@ -82,14 +112,39 @@ public:
      */
     bool Initialize();
 
+    /**
+     * @brief 开始新的一帧（用于字形图集的 LRU 淘汰）
+     */
+    void BeginFrame() { atlas_.BeginFrame(); }
+
+    /**
+     * @brief 获取字形图集
+     */
+    const GlyphAtlas& GetAtlas() const { return atlas_; }
+
     /**
      * @brief 加载字体（带缓存）
      * @param fontPath 字体文件路径
      * @param fontSize 字体大小(像素)
+     * @param faceIndex 集合文件（.ttc/.otc）中的 face 索引
      * @return 字体 ID,失败返回 -1
      */
-    int LoadFont(const std::string& fontPath, unsigned int fontSize);
+    int LoadFont(const std::string& fontPath, unsigned int fontSize, int faceIndex = 0);
     
+    /**
+     * @brief 设置字形渲染方式（需要在加载字体前调用，已加载的字体保持原方式）
+     *
+     * 距离场模式下同一字体的所有字号共享一个参考字号的 FT_Face 和距离场字形，
+     * 字形集从 SdfGlyphSet 注册表获取（可预先注册离线烘焙的字形集）。
+     */
+    void SetGlyphRenderMode(GlyphRenderMode mode) { glyphRenderMode_ = mode; }
+    GlyphRenderMode GetGlyphRenderMode() const { return glyphRenderMode_; }
+
+    /**
+     * @brief 字体的距离场字形集（位图字体返回 nullptr）
+     */
+    std::shared_ptr<SdfGlyphSet> GetSdfGlyphSet(int fontId) const;
+
     /**
      * @brief 设置默认字体
      * @param fontId 字体 ID
@@ -114,6 +169,27 @@ public:
      */
     void ClearFallbackFonts();
 
+    /**
+     * @brief 按字体族、字重、样式与字号解析字体（经 FontManager 解析，结果缓存）
+     * @return 字体 ID，失败返回 -1
+     */
+    int ResolveFont(const std::string& fontFamily, float fontSize, int fontWeight, bool italic) override;
+
+    /**
+     * @brief 查找字符的字形（带回退），输出字形所在字体与前进值
+     */
+    bool GetGlyphAdvance(char32_t c, int fontId, int& glyphFontId, float& advance) override;
+
+    /**
+     * @brief 字体 'kern' 表中的字距调整（像素）
+     */
+    float GetKerning(int fontId, char32_t left, char32_t right) override;
+
+    /**
+     * @brief 位图字体的字体文件（距离场字体返回 false）
+     */
+    bool GetFontSource(int fontId, std::string& path, int& faceIndex, float& fontSize) const override;
+
     /**
      * @brief 渲染文本到纹理
      * @param text UTF-8 编码的文本
@@ -180,9 +256,9 @@ public:
      * @param text UTF-8 编码的文本
      * @param fontId 字体 ID
      * @param maxWidth 最大宽度（0 表示不换行）
-     * @return 文本布局信息
+     * @return 文本布局信息，字体无效时返回 nullptr
      */
-    TextLayout CalculateTextLayout(
+    std::shared_ptr<const TextLayout> CalculateTextLayout(
         const std::string& text,
         int fontId,
         float maxWidth = 0.0f
@@ -213,6 +289,32 @@ private:
      */
     bool LoadCharacter(char32_t c, int fontId);
 
+    /**
+     * @brief 获取或打开字体文件的距离场字体（字体不支持距离场时返回 nullptr）
+     */
+    SdfFont* AcquireSdfFont(const std::string& fontPath, int faceIndex);
+
+    /**
+     * @brief 加载距离场字形：首次使用时生成并上传到图集，之后按字号缩放度量
+     */
+    bool LoadSdfCharacter(char32_t c, FontFace& font);
+
+    /**
+     * @brief 加载 FontManager 中的字体（按 (字体, 字号) 缓存）
+     */
+    int LoadManagedFont(FontFaceId face, unsigned int fontSize);
+
+    /**
+     * @brief 依次在主字体、FontManager 回退链、回退字体、默认字体中查找字形
+     * @param glyphFontId 输出字形所在的字体 ID
+     */
+    const Glyph* FindGlyph(char32_t c, int fontId, int& glyphFontId);
+
+    /**
+     * @brief 图集页被淘汰时清除引用该页的字形
+     */
+    void OnAtlasPageEvicted(int page);
+
 private:
     FT_Library ftLibrary_;
     std::vector<std::unique_ptr<FontFace>> fonts_;
@@ -222,6 +324,16 @@ private:
     std::unordered_map<FontCacheKey, int, FontCacheKeyHash> fontCache_;  // 字体缓存
     int defaultFontId_{-1};                                               // 默认字体
     std::vector<int> fallbackFonts_;                                     // 回退字体列表
+    
+    // Phase 5.1: 字形图集
+    GlyphAtlas atlas_;
+
+    // Phase 5.1: FontManager 字体缓存（(字体 << 32) | 字号 -> 字体 ID）
+    std::unordered_map<std::uint64_t, int> managedFonts_;
+
+    // Phase 5.1: 距离场模式（"路径#face 索引" -> 距离场字体，nullptr 表示不支持）
+    GlyphRenderMode glyphRenderMode_{GlyphRenderMode::Bitmap};
+    std::unordered_map<std::string, std::unique_ptr<SdfFont>> sdfFonts_;
 };
 
 } // namespace fk::render
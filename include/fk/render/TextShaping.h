@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace fk::render {
+
+class GlyphMetricsProvider;
+
+/**
+ * @brief 文本方向
+ */
+enum class TextDirection : std::uint8_t {
+    LeftToRight,
+    RightToLeft
+};
+
+/**
+ * @brief 整形特性（可按位组合）
+ */
+enum class ShapingFeatures : std::uint32_t {
+    None = 0,
+    Kerning = 1 << 0,     // 字距调整（字体的 'kern' 表）
+    Ligatures = 1 << 1,   // 标准连字（拉丁文 ff/fi/fl、阿拉伯文 lam-alef）
+    Default = Kerning | Ligatures
+};
+
+inline ShapingFeatures operator|(ShapingFeatures a, ShapingFeatures b) {
+    return static_cast<ShapingFeatures>(static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b));
+}
+
+inline ShapingFeatures operator&(ShapingFeatures a, ShapingFeatures b) {
+    return static_cast<ShapingFeatures>(static_cast<std::uint32_t>(a) & static_cast<std::uint32_t>(b));
+}
+
+inline bool HasFeature(ShapingFeatures features, ShapingFeatures feature) {
+    return (features & feature) == feature;
+}
+
+/**
+ * @brief 双向文本中嵌入层级相同的一段（逻辑顺序）
+ */
+struct BidiRun {
+    std::uint32_t start{0};     // 第一个字符的索引
+    std::uint32_t length{0};
+    std::uint8_t level{0};      // 嵌入层级（奇数为从右到左）
+
+    TextDirection GetDirection() const {
+        return (level & 1) != 0 ? TextDirection::RightToLeft : TextDirection::LeftToRight;
+    }
+};
+
+/**
+ * @brief 双向文本分段（Unicode 双向算法 UAX #9 的简化实现）
+ *
+ * 段落方向取第一个强方向字符；数字在从右到左的文本中保持从左到右；
+ * 中性字符（空格、标点）两侧方向相同时取该方向，否则取段落方向；
+ * 组合标记跟随前一个字符。不处理显式嵌入与隔离控制符。
+ *
+ * @param paragraph 一个段落（不含换行符）
+ * @param baseDirection 输出段落方向
+ * @param levels 输出每个字符的嵌入层级
+ * @return 按逻辑顺序排列的分段
+ */
+std::vector<BidiRun> ItemizeBidi(std::u32string_view paragraph, TextDirection& baseDirection,
+                                 std::vector<std::uint8_t>& levels);
+
+/**
+ * @brief 按嵌入层级计算一行的视觉顺序（UAX #9 规则 L2）
+ * @param levels 每个单元的层级（逻辑顺序）
+ * @param order 输出从左到右的单元索引
+ */
+void ReorderByLevels(const std::vector<std::uint8_t>& levels, std::vector<std::uint32_t>& order);
+
+/**
+ * @brief 字形索引标记
+ *
+ * HarfBuzz 整形产生的没有对应字符的字形（连字、上下文形式）以字形索引存入码点，
+ * 最高位作为标记（超出 Unicode 范围），渲染器按索引加载字形。
+ */
+constexpr char32_t kGlyphIndexFlag = 0x80000000u;
+
+inline bool IsGlyphIndex(char32_t codepoint) {
+    return (codepoint & kGlyphIndexFlag) != 0;
+}
+
+inline std::uint32_t GlyphIndexOf(char32_t codepoint) {
+    return static_cast<std::uint32_t>(codepoint & ~kGlyphIndexFlag);
+}
+
+/**
+ * @brief 整形后的字形（逻辑顺序）
+ */
+struct ShapedGlyph {
+    char32_t codepoint{0};      // 实际绘制的字符（可能是表现形式、连字或字形索引）
+    int fontId{-1};             // 字形所在字体（已解析回退）
+    float advance{0.0f};        // 前进值（含字距调整）
+    std::uint32_t cluster{0};   // 对应的第一个字符在整形文本中的索引
+    float xOffset{0.0f};        // 相对笔位置的绘制偏移（GPOS 标记定位，y 向下）
+    float yOffset{0.0f};
+};
+
+/**
+ * @brief 一段文本的整形结果
+ */
+struct ShapedRun {
+    std::vector<ShapedGlyph> glyphs;
+    float width{0.0f};
+};
+
+/**
+ * @brief 文本段整形缓存（Phase 5.1）
+ *
+ * 整形需要为每个字符查找字形、应用阿拉伯文连接形式与连字、查询字距表，
+ * 结果按 (文本段, 字体, 特性, 方向) 缓存，TextLayout 以单词为单位查找，
+ * 同一单词在不同段落、重新换行或重新排版时只整形一次。超过容量时按 LRU 淘汰。
+ *
+ * 每个 GlyphMetricsProvider 持有一个缓存（字体 ID 只在同一来源内有意义）。
+ * 需要在 UI 线程使用。
+ *
+ * 定义 FK_HAS_HARFBUZZ 且来源提供字体文件（GlyphMetricsProvider::GetFontSource）时用 hb_shape
+ * 整形，支持 OpenType GSUB/GPOS（组合标记按 xOffset/yOffset 定位）；主字体缺少字形（需要回退字体）时
+ * 该段改用内置整形。
+ *
+ * 内置整形不依赖 HarfBuzz，只覆盖不需要 OpenType GSUB/GPOS 的部分：
+ * - 字距调整读取字体的 'kern' 表（只有 GPOS 字距的字体不调整）
+ * - 阿拉伯文按连接类型选择 Unicode 表现形式（U+FE70-FEFF），lam-alef 组成连字
+ * - 拉丁文 ff/fi/fl/ffi/ffl 连字（字体包含 U+FB00-FB04 时）
+ * - 天城文前置元音符号 ि 移到辅音之前（半字与合字需要 GSUB，不支持）
+ * - 从右到左文本中的括号等成对字符取镜像字符
+ * 表现形式或连字不在同一字体中时保留原字符。
+ */
+class ShapeRunCache {
+public:
+    static constexpr std::size_t kDefaultCapacity = 8192;
+
+    explicit ShapeRunCache(std::size_t capacity = kDefaultCapacity);
+
+    ShapeRunCache(const ShapeRunCache&) = delete;
+    ShapeRunCache& operator=(const ShapeRunCache&) = delete;
+
+    /**
+     * @brief 查找或整形文本段
+     * @param provider 字形度量来源
+     * @param text 文本段（同一方向）
+     * @param fontId 主字体 ID
+     * @param features 整形特性
+     * @param direction 文本段方向
+     */
+    std::shared_ptr<const ShapedRun> Shape(GlyphMetricsProvider& provider, std::u32string_view text, int fontId,
+                                           ShapingFeatures features, TextDirection direction);
+
+    /**
+     * @brief 不经缓存整形文本段
+     */
+    static std::shared_ptr<ShapedRun> ShapeUncached(GlyphMetricsProvider& provider, std::u32string_view text,
+                                                    int fontId, ShapingFeatures features, TextDirection direction);
+
+    /**
+     * @brief 设置容量（0 表示不缓存）
+     */
+    void SetCapacity(std::size_t capacity);
+    std::size_t GetCapacity() const { return capacity_; }
+
+    void Clear();
+
+    std::size_t GetSize() const { return entries_.size(); }
+    std::uint64_t GetHits() const { return hits_; }
+    std::uint64_t GetMisses() const { return misses_; }
+
+private:
+    // 键的文本指向条目中保存的字符串（链表节点不会移动）
+    struct Key {
+        std::u32string_view text;
+        int fontId{-1};
+        ShapingFeatures features{ShapingFeatures::None};
+        TextDirection direction{TextDirection::LeftToRight};
+
+        bool operator==(const Key& other) const {
+            return fontId == other.fontId && features == other.features && direction == other.direction &&
+                   text == other.text;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+    struct Entry {
+        std::u32string text;
+        Key key;
+        std::shared_ptr<const ShapedRun> run;
+    };
+
+    void Evict();
+
+    std::size_t capacity_;
+    std::list<Entry> entries_;  // 前端最久未使用
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+    std::uint64_t hits_{0};
+    std::uint64_t misses_{0};
+};
+
+} // namespace fk::render
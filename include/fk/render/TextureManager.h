@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+namespace fk::render {
+
+/**
+ * @brief 纹理管理器统计信息
+ */
+struct TextureStatistics {
+    std::size_t residentBytes{0};          // 当前驻留的纹理字节数
+    std::size_t budgetBytes{0};            // 字节预算
+    std::size_t textureCount{0};           // 驻留纹理数量
+    std::size_t pinnedCount{0};            // 被绘制命令引用的纹理数量
+    std::uint64_t evictions{0};            // 累计淘汰次数
+    std::uint64_t evictedBytes{0};         // 累计淘汰字节数
+    std::size_t uploadBytesLastFrame{0};   // 上一帧上传的纹理字节数
+    std::uint64_t uploadBytesTotal{0};     // 累计上传字节数
+};
+
+/**
+ * @brief GPU 纹理预算与 LRU 淘汰（Phase 5.1）
+ *
+ * 图像纹理（ImageCache）与字形图集页（GlyphAtlas）都在这里登记字节数，
+ * 驻留总量超过预算时按最近使用顺序淘汰。管理器本身不调用 OpenGL：
+ * 纹理需要删除时调用所有者登记的回调，由所有者删除纹理并清除自己的引用。
+ *
+ * 不会被淘汰的纹理：
+ * - 被渲染列表中的 DrawImage 命令引用（引用计数大于 0）——保留式渲染会在
+ *   之后的帧复制这些命令，淘汰后命令会指向已删除的纹理
+ * - 当前帧使用过（Touch）的纹理
+ *
+ * 所有方法都需要在 UI 线程（拥有 OpenGL 上下文的线程）调用。
+ */
+class TextureManager {
+public:
+    /**
+     * @brief 纹理需要删除时的回调（淘汰，或所有者退役后引用归零）
+     */
+    using ReleaseCallback = std::function<void(std::uint32_t textureId)>;
+
+    static TextureManager& Instance();
+
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    /**
+     * @brief 设置驻留字节预算（默认 256MB）
+     */
+    void SetBudget(std::size_t bytes) { budget_ = bytes; }
+    std::size_t GetBudget() const { return budget_; }
+
+    /**
+     * @brief 登记新创建的纹理
+     * @param textureId OpenGL 纹理 ID
+     * @param bytes 纹理占用的字节数
+     * @param release 淘汰时调用，所有者在其中删除纹理
+     */
+    void Register(std::uint32_t textureId, std::size_t bytes, ReleaseCallback release);
+
+    /**
+     * @brief 取消登记（所有者自己删除纹理，不调用回调）
+     */
+    void Unregister(std::uint32_t textureId);
+
+    /**
+     * @brief 所有者不再需要纹理：没有引用时立即调用回调，否则等引用归零后调用
+     */
+    void Retire(std::uint32_t textureId);
+
+    /**
+     * @brief 增加 / 减少绘制命令对纹理的引用（未登记的纹理忽略）
+     */
+    void AddRef(std::uint32_t textureId);
+    void Release(std::uint32_t textureId);
+
+    /**
+     * @brief 标记纹理在当前帧被使用（移到 LRU 末尾）
+     */
+    void Touch(std::uint32_t textureId);
+
+    /**
+     * @brief 记录纹理上传字节数（统计用）
+     */
+    void RecordUpload(std::size_t bytes);
+
+    /**
+     * @brief 结束一帧：超出预算时淘汰，并滚动每帧上传统计
+     */
+    void EndFrame();
+
+    /**
+     * @brief 淘汰最久未使用的纹理直到不超过预算
+     * @return 淘汰的纹理数量
+     */
+    std::size_t Trim();
+
+    bool IsResident(std::uint32_t textureId) const { return entries_.count(textureId) > 0; }
+    std::size_t GetResidentBytes() const { return residentBytes_; }
+    TextureStatistics GetStatistics() const;
+
+private:
+    TextureManager() = default;
+
+    struct Entry {
+        std::size_t bytes{0};
+        std::uint32_t refCount{0};
+        std::uint64_t lastUsedFrame{0};
+        bool retired{false};
+        ReleaseCallback release;
+        std::list<std::uint32_t>::iterator lruPosition;
+    };
+
+    void Erase(std::unordered_map<std::uint32_t, Entry>::iterator it, bool evicted);
+
+    std::unordered_map<std::uint32_t, Entry> entries_;
+    std::list<std::uint32_t> lru_;  // 前端最久未使用
+    std::size_t budget_{256 * 1024 * 1024};
+    std::size_t residentBytes_{0};
+    std::uint64_t frame_{1};
+
+    std::uint64_t evictions_{0};
+    std::uint64_t evictedBytes_{0};
+    std::size_t uploadBytesThisFrame_{0};
+    std::size_t uploadBytesLastFrame_{0};
+    std::uint64_t uploadBytesTotal_{0};
+};
+
+} // namespace fk::render
@@ -142,6 +142,12 @@
 #define FK_PROPERTY_SIMPLE_NO_ACTION(PropertyName, Type, Derived) \
     FK_PROPERTY_SIMPLE(PropertyName, Type, Derived, (void)0)
 
+/**
+ * @brief 无额外操作的复杂类型属性（变更由属性元数据的回调处理）
+ */
+#define FK_PROPERTY_COMPLEX_NO_ACTION(PropertyName, Type, Derived) \
+    FK_PROPERTY_COMPLEX(PropertyName, Type, Derived, (void)0)
+
 /**
  * @brief 触发测量失效的属性
  */
@@ -2,14 +2,18 @@
 
 #include "fk/ui/controls/ContentControl.h"
 #include "fk/binding/DependencyProperty.h"
+#include <array>
 #include <string>
 #include <memory>
 
 // 前向声明
 namespace fk::render {
-    class GlRenderer;
+    class DamageRegion;
+    class IRenderer;
+    class SoftwareRenderer;
     class RenderList;
     class TextRenderer;
+    enum class GlyphRenderMode;
 }
 
 namespace fk::ui {
@@ -194,6 +198,42 @@ public:
      */
     void RenderFrame();
     
+    /**
+     * @brief 是否需要渲染新的一帧
+     * 
+     * 内容树有脏节点、内容根变化、帧缓冲尺寸变化或有打开的 Popup 时返回 true。
+     * 消息循环据此决定是否可以进入空闲等待。
+     */
+    bool NeedsRender() const;
+    
+    // ========== 无头模式（Phase 5.1） ==========
+    
+    /**
+     * @brief 设置无头模式（必须在 Show() 之前调用）
+     * 
+     * 无头窗口不创建原生窗口和 OpenGL 上下文，使用 SoftwareRenderer 渲染到内存帧缓冲，
+     * 帧缓冲尺寸取 Width / Height 属性。布局、保留式渲染列表和脏矩形重绘流程与普通窗口相同，
+     * 用于 CI 中的像素对比回归测试和无 GPU 环境下的帧耗时基准。
+     * 
+     * 注意：Popup 有独立的原生窗口，无头模式下不渲染。
+     */
+    void SetHeadless(bool headless);
+    bool IsHeadless() const { return headless_; }
+    
+    /**
+     * @brief 获取无头模式的软件渲染器（用于读取帧缓冲），非无头模式返回 nullptr
+     */
+    render::SoftwareRenderer* GetHeadlessRenderer() const;
+    
+    /**
+     * @brief 设置字形渲染方式（必须在第一次渲染之前调用）
+     * 
+     * GlyphRenderMode::SignedDistanceField 下每个字形只生成一次距离场，字号动画与缩放
+     * 不再为每个像素字号重新栅格化字形；默认为位图字形。
+     */
+    void SetGlyphRenderMode(render::GlyphRenderMode mode);
+    render::GlyphRenderMode GetGlyphRenderMode() const { return glyphRenderMode_; }
+    
     /**
      * @brief 在窗口的内容树中查找指定名称的元素
      * 
@@ -285,14 +325,31 @@ protected:
     virtual void OnClosed() {}
 
 private:
+    /**
+     * @brief 布局、收集绘制命令并交给渲染器绘制一帧（不含缓冲交换）
+     */
+    void RenderContent(int width, int height);
+    
+    /**
+     * @brief 内容根是否变化或内容树是否有脏节点
+     */
+    bool IsContentDirty() const;
+    
     void* nativeHandle_{nullptr};  // 原生窗口句柄
     bool isModal_{false};           // 是否为模态窗口
     volatile bool isClosing_{false};         // 正在关闭标志(volatile防止优化)
     volatile bool isVisible_{false};         // 窗口可见性标志(volatile防止优化)
     
     // 渲染系统
-    std::unique_ptr<render::GlRenderer> renderer_;     // OpenGL 渲染器
+    std::unique_ptr<render::IRenderer> renderer_;      // 渲染器（OpenGL，无头模式下为软件渲染器）
+    bool headless_{false};                             // 无头模式（不创建原生窗口）
+    render::GlyphRenderMode glyphRenderMode_{};        // 字形渲染方式（默认为位图）
     std::unique_ptr<render::RenderList> renderList_;   // 渲染命令列表
+    std::unique_ptr<render::RenderList> previousRenderList_;  // 上一帧渲染命令列表（Phase 5.1 子树命令复用）
+    UIElement* lastRenderedRoot_{nullptr};             // 上一帧渲染的内容根元素
+    std::unique_ptr<render::DamageRegion> damageRegion_;  // 本帧损坏区域（Phase 5.1 脏矩形重绘）
+    std::array<float, 4> lastClearColor_{};            // 上一帧的清除颜色，变化时整帧重绘
+    bool needsFullRedraw_{true};                       // 下一帧是否必须整帧重绘
     
     // 输入管理系统
     std::unique_ptr<class InputManager> inputManager_; // 输入管理器
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace fk::ui {
+
+class UIElement;
+
+/**
+ * @brief 布局管理器（Phase 5.1，单例）
+ *
+ * 收集调用了 InvalidateMeasure / InvalidateArrange 的元素，每帧统一处理一次：
+ * - 测量队列按深度自上而下处理，元素用上次的可用尺寸重新测量；
+ *   只有期望尺寸变化时才让父元素重新测量
+ * - 排列队列同样自上而下处理，元素用上次的最终矩形重新排列
+ *
+ * 配合 UIElement 对上次可用尺寸 / 最终矩形的缓存，未变化的子树完全跳过，
+ * 稳态下布局开销与脏元素数量成正比，而不是与整棵树的大小成正比。
+ *
+ * 注意：只能在 UI 线程中使用。
+ */
+class LayoutManager {
+public:
+    /**
+     * @brief 获取 LayoutManager 单例
+     */
+    static LayoutManager& Instance();
+
+    // 禁止拷贝和赋值
+    LayoutManager(const LayoutManager&) = delete;
+    LayoutManager& operator=(const LayoutManager&) = delete;
+
+    /**
+     * @brief 将元素加入测量队列（重复加入会被忽略）
+     */
+    void EnqueueMeasure(UIElement* element);
+
+    /**
+     * @brief 将元素加入排列队列（重复加入会被忽略）
+     */
+    void EnqueueArrange(UIElement* element);
+
+    /**
+     * @brief 从所有队列中移除元素（元素析构时调用）
+     */
+    void Remove(UIElement* element);
+
+    /**
+     * @brief 处理所有排队的测量和排列（每帧调用一次）
+     */
+    void UpdateLayout();
+
+    /**
+     * @brief 是否有待处理的布局工作
+     */
+    bool HasPendingWork() const { return !measureQueue_.empty() || !arrangeQueue_.empty(); }
+
+    std::size_t GetMeasureQueueSize() const { return measureQueue_.size(); }
+    std::size_t GetArrangeQueueSize() const { return arrangeQueue_.size(); }
+
+private:
+    LayoutManager() = default;
+
+    /**
+     * @brief 取出队列并按视觉树深度从浅到深排序
+     */
+    static std::vector<UIElement*> TakeSorted(std::vector<UIElement*>& queue);
+
+    void ProcessMeasureQueue();
+    void ProcessArrangeQueue();
+
+    std::vector<UIElement*> measureQueue_;
+    std::vector<UIElement*> arrangeQueue_;
+    std::vector<UIElement*> processing_;   // 当前正在处理的批次
+    bool updating_{false};
+};
+
+} // namespace fk::ui
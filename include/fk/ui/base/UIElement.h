@@ -13,6 +13,7 @@
 
 namespace fk::render {
 class RenderContext;
+struct RenderCacheEntry;
 }
 
 namespace fk::ui {
@@ -25,6 +26,7 @@ struct KeyEventArgs;
 class Transform;
 class NameScope;
 class InputManager;
+class HitTestIndex;
 
 /**
  * @brief 可见性枚举
@@ -35,6 +37,14 @@ enum class Visibility {
     Collapsed   // 不可见且不参与布局
 };
 
+/**
+ * @brief 缓存模式枚举（Phase 5.1）
+ */
+enum class CacheMode {
+    None,        // 不缓存，每次都执行子树的绘制命令
+    BitmapCache  // 子树绘制到离屏位图并跨帧保留，只有位置或透明度变化时直接合成位图
+};
+
 /**
  * @brief UI 元素基类
  * 
@@ -78,6 +88,12 @@ public:
      */
     static const binding::DependencyProperty& RenderTransformProperty();
 
+    /**
+     * @brief 缓存模式依赖属性（Phase 5.1）
+     * 值类型：CacheMode
+     */
+    static const binding::DependencyProperty& CacheModeProperty();
+
     // ========== 布局 ==========
     
     /**
@@ -89,14 +105,22 @@ public:
      * @brief 确定最终布局
      */
     void Arrange(const Rect& finalRect);
+
+    /**
+     * @brief 移动已排列的元素（Phase 5.1 合成滚动）
+     * 
+     * 只改变布局位置，不重新排列子树，也不使绘制命令失效：由调用方平移保留的命令。
+     * 元素需要重新排列时退化为 Arrange。
+     */
+    void Reposition(const Point& position);
     
     /**
-     * @brief 标记需要重新测量
+     * @brief 标记需要重新测量（加入 LayoutManager 测量队列，下一帧处理）
      */
     void InvalidateMeasure();
     
     /**
-     * @brief 标记需要重新排列
+     * @brief 标记需要重新排列（加入 LayoutManager 排列队列，下一帧处理）
      */
     void InvalidateArrange();
     
@@ -304,6 +328,27 @@ public:
     
     void SetRenderTransform(Transform* value);
     Transform* GetRenderTransform() const;
+    
+    // ========== 缓存模式 ==========
+    
+    /**
+     * @brief 设置缓存模式（Phase 5.1）
+     * 
+     * BitmapCache 适合内容复杂、只做淡入淡出或平移动画的面板：
+     * 子树内容不变时渲染器直接合成缓存的位图，不再执行子树的绘制命令。
+     */
+    void SetCacheMode(CacheMode value);
+    CacheMode GetCacheMode() const;
+    
+    // ========== 命中测试索引 ==========
+    
+    /**
+     * @brief 获取子元素命中测试空间索引（Phase 5.1）
+     * 
+     * 子元素数量达到 HitTestIndex::kMinChildren 时按需创建，否则返回 nullptr，
+     * 由 InputManager 在命中测试时使用。
+     */
+    HitTestIndex* GetHitTestIndex();
 
     // ========== 路由事件 ==========
     
@@ -460,6 +505,13 @@ protected:
      * @brief 派生类用于绘制自身内容
      */
     virtual void OnRender(render::RenderContext& context);
+
+    /**
+     * @brief 收集子元素的绘制命令（在自身内容和裁剪之后调用，Phase 5.1）
+     * 
+     * 默认遍历可视子元素；ScrollContentPresenter 改为合成保留的滚动内容
+     */
+    virtual void CollectChildDrawCommands(render::RenderContext& context);
     
     /**
      * @brief 核心测量逻辑（派生类覆写）
@@ -495,6 +547,11 @@ protected:
      * @endcode
      */
     virtual bool ShouldClipToBounds() const { return false; }
+
+    /**
+     * @brief 透明度只影响图层合成，变化时不使缓存的图层位图失效
+     */
+    bool IsCompositionProperty(const binding::DependencyProperty& property) const override;
     
     /**
      * @brief 计算裁剪边界（局部坐标）
@@ -557,6 +614,41 @@ private:
     bool measureDirty_{true};
     bool arrangeDirty_{true};
     
+    // Phase 5.1: 布局缓存（参数未变化且不脏时跳过整棵子树），由 LayoutManager 复用
+    friend class LayoutManager;
+    Size previousAvailableSize_;   // 上次测量的可用尺寸
+    Rect previousFinalRect_;       // 上次排列的最终矩形
+    bool hasMeasured_{false};
+    bool hasArranged_{false};
+    bool inMeasureQueue_{false};
+    bool inArrangeQueue_{false};
+    
+    // Phase 5.1: 上一帧子树绘制命令区间（渲染脏标记清除时可直接复用）
+    std::unique_ptr<render::RenderCacheEntry> renderCache_;
+    
+    // Phase 5.1: 子元素命中测试索引（子元素较多时才创建）
+    std::unique_ptr<HitTestIndex> hitTestIndex_;
+    core::Event<>::Connection renderTransformChanged_;  // 当前 RenderTransform 的 Changed 订阅
+    
+    // Phase 5.1: CacheMode::BitmapCache 的图层位图标识与内容版本
+    struct BitmapCacheState {
+        std::uint64_t id{0};              // 渲染器中缓存位图的键（全局唯一，不随元素地址复用）
+        std::uint64_t version{0};         // 图层内容版本
+        std::uint64_t contentVersion{0};  // 上次记录时自身的内容版本
+        Size size;                        // 上次记录时的渲染尺寸
+    };
+    std::unique_ptr<BitmapCacheState> bitmapCache_;
+    
+    /**
+     * @brief 更新缓存位图的内容版本：自身内容、尺寸或子树变化时递增
+     */
+    void UpdateBitmapCacheVersion();
+    
+    /**
+     * @brief 通知父元素的命中测试索引：本元素在父坐标系中的包围盒可能已变化
+     */
+    void NotifyHitTestBoundsChanged();
+    
     // 注意：元素名称现在统一使用继承自DependencyObject的elementName_
     // 这样FindName和ElementName绑定都使用同一个存储，避免冗余
     
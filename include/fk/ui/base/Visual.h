@@ -2,6 +2,7 @@
 
 #include "fk/binding/DependencyObject.h"
 #include "fk/ui/graphics/Primitives.h"
+#include <cstdint>
 #include <vector>
 #include <memory>
 
@@ -57,6 +58,11 @@ public:
      * @brief 按索引获取子节点
      */
     Visual* GetVisualChild(size_t index) const;
+    
+    /**
+     * @brief 子节点集合版本号（增删子节点时递增，供命中测试索引判断是否需要重建）
+     */
+    std::uint64_t GetVisualChildrenVersion() const { return childrenVersion_; }
 
     // ========== 变换 ==========
     
@@ -100,22 +106,77 @@ public:
     
     /**
      * @brief 标记需要重新渲染
+     * 
+     * 设置当前节点及所有祖先节点的渲染脏标记，使其缓存的绘制命令失效
      */
     void InvalidateVisual();
 
+    /**
+     * @brief 标记需要重新合成（Phase 5.1）
+     * 
+     * 与 InvalidateVisual 相同地重新收集绘制命令并计算损坏区域，但不改变内容版本：
+     * 只有位置或透明度变化时，缓存的图层位图仍然可以直接合成
+     */
+    void InvalidateComposition();
+
+    /**
+     * @brief 子树是否需要重新生成绘制命令
+     */
+    bool IsRenderDirty() const { return renderDirty_; }
+
+    /**
+     * @brief 节点自身内容的版本（每次 InvalidateVisual 递增）
+     */
+    std::uint64_t GetContentVersion() const { return contentVersion_; }
+
 protected:
     /**
      * @brief 访问子节点集合（派生类使用）
      */
     std::vector<Visual*>& GetVisualChildrenInternal() { return visualChildren_; }
 
+    /**
+     * @brief 仅标记子树需要重新收集绘制命令（自身内容未变，不计入损坏区域）
+     * 
+     * 用于布局失效等只需要调度新一帧的场景
+     */
+    void MarkSubtreeDirty();
+
+    /**
+     * @brief 清除渲染脏标记（绘制命令重新生成后调用）
+     */
+    void ClearRenderDirty() { renderDirty_ = false; contentDirty_ = false; }
+
+    /**
+     * @brief 节点自身是否被标记为需要重绘（区别于仅因后代变化而变脏）
+     */
+    bool IsContentDirty() const { return contentDirty_; }
+
+    /**
+     * @brief 属性是否只影响合成（如透明度），变更时调用 InvalidateComposition 而不是 InvalidateVisual
+     */
+    virtual bool IsCompositionProperty(const binding::DependencyProperty& /*property*/) const { return false; }
+
+    /**
+     * @brief 属性变更时使绘制命令缓存失效
+     */
+    void OnPropertyChanged(const binding::DependencyProperty& property,
+                           const std::any& oldValue,
+                           const std::any& newValue,
+                           binding::ValueSource oldSource,
+                           binding::ValueSource newSource) override;
+
 private:
     // 友元声明：允许 VisualCollection 访问私有成员
     friend class VisualCollection;
     
     Visual* visualParent_{nullptr};
     std::vector<Visual*> visualChildren_;
+    std::uint64_t childrenVersion_{0};
     Matrix3x2 transform_;
+    bool renderDirty_{true};     // 子树中存在需要重绘的节点
+    bool contentDirty_{true};    // 节点自身需要重绘（用于计算损坏区域）
+    std::uint64_t contentVersion_{0};  // 自身内容版本（仅合成变化时不递增）
 };
 
 } // namespace fk::ui
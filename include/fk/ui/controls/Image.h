@@ -121,9 +121,14 @@ public:
     float GetImageHeight() const;
     
     /**
-     * @brief 检查图像是否已加载
+     * @brief 检查图像是否已加载（纹理可用）
      */
     bool IsLoaded() const;
+    
+    /**
+     * @brief 检查图像是否正在后台解码或上传
+     */
+    bool IsLoading() const;
 
 protected:
     /**
@@ -143,7 +148,8 @@ protected:
 
 private:
     /**
-     * @brief 加载图像
+     * @brief 异步加载图像（后台解码，按帧分批上传纹理）
+     * @return 请求失败时返回 false
      */
     bool LoadImage(const std::string& path);
     
@@ -152,6 +158,11 @@ private:
      */
     void UnloadImage();
     
+    /**
+     * @brief 图像尺寸是否已知（解码完成后即可测量，上传期间显示占位）
+     */
+    bool HasImageSize() const;
+    
     /**
      * @brief 计算渲染尺寸和位置
      * @param containerSize 容器尺寸
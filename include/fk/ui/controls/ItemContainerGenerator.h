@@ -2,6 +2,7 @@
 
 #include <any>
 #include <vector>
+#include <string>
 #include <unordered_map>
 #include <functional>
 #include <memory>
@@ -210,6 +211,11 @@ private:
      */
     UIElement* GetRecycledContainer();
     
+    /**
+     * @brief 解除容器与项的映射并从已生成列表中移除
+     */
+    void UnmapContainer(UIElement* container);
+    
     /**
      * @brief 创建新容器
      */
@@ -228,6 +234,7 @@ private:
     std::vector<UIElement*> containers_;                // 已生成容器列表
     std::unordered_map<std::string, UIElement*> itemToContainer_;  // 项->容器映射
     std::unordered_map<UIElement*, std::any> containerToItem_;     // 容器->项映射
+    std::unordered_map<UIElement*, std::string> containerToKey_;   // 容器->生成时的项键
     
     // 容器池（用于重用）
     std::vector<UIElement*> containerPool_;             // 回收的容器池
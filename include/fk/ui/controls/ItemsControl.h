@@ -3,6 +3,7 @@
 #include "fk/ui/controls/Control.h"
 #include "fk/ui/lists/ObservableCollection.h"
 #include "fk/ui/controls/ItemContainerGenerator.h"
+#include "fk/ui/layouts/VirtualizingStackPanel.h"
 #include "fk/binding/DependencyProperty.h"
 #include <vector>
 #include <any>
@@ -53,7 +54,12 @@ public:
         generator_.SetEnableRecycling(true);  // Enable recycling by default
     }
     
-    virtual ~ItemsControl() = default;
+    virtual ~ItemsControl() {
+        // 虚拟化面板可能比控件存活更久，先交还容器并解除关联
+        if (auto* panel = GetVirtualizingPanel()) {
+            panel->SetItemsHost(nullptr, nullptr);
+        }
+    }
 
     // ========== 项目源 ==========
     
@@ -87,7 +93,14 @@ public:
     
     UIElement* GetItemsPanel() const { return this->template GetValue<UIElement*>(ItemsPanelProperty()); }
     void SetItemsPanel(UIElement* panel) {
+        auto* oldPanel = GetVirtualizingPanel();
+        if (oldPanel && oldPanel != panel) {
+            oldPanel->SetItemsHost(nullptr, nullptr);
+        }
         this->SetValue(ItemsPanelProperty(), panel);
+        if (GetVirtualizingPanel()) {
+            GenerateContainers();
+        }
         this->InvalidateMeasure();
     }
     
@@ -185,6 +198,13 @@ protected:
      * @brief Items 集合变更钩子
      */
     virtual void OnItemsChanged(const CollectionChangedEventArgs& args) {
+        // Phase 5.1: 虚拟化面板只为可见项生成容器，由面板自行处理变更
+        if (auto* panel = GetVirtualizingPanel()) {
+            panel->OnItemsChanged(args);
+            this->InvalidateMeasure();
+            return;
+        }
+        
         // Items 集合变更时，更新显示
         try {
             switch (args.action) {
@@ -232,9 +252,21 @@ protected:
      * @brief 生成项目容器
      */
     virtual void GenerateContainers() {
+        // 虚拟化面板持有的容器先交还生成器，再统一释放
+        auto* virtualizingPanel = GetVirtualizingPanel();
+        if (virtualizingPanel) {
+            virtualizingPanel->SetItemsHost(nullptr, nullptr);
+        }
+        
         // 清除现有容器
         ClearItemContainers();
         
+        // Phase 5.1: 虚拟化面板在测量时按需生成可见项的容器
+        if (virtualizingPanel) {
+            virtualizingPanel->SetItemsHost(&generator_, &GetItems());
+            return;
+        }
+        
         // 从 ItemsSource 或 Items 生成容器
         std::any itemsSource = GetItemsSource();
         
@@ -293,6 +325,13 @@ protected:
         this->InvalidateMeasure();
     }
 
+    /**
+     * @brief 项目面板为 VirtualizingStackPanel 时返回该面板，否则返回 nullptr
+     */
+    VirtualizingStackPanel* GetVirtualizingPanel() const {
+        return dynamic_cast<VirtualizingStackPanel*>(GetItemsPanel());
+    }
+    
 private:
     std::unique_ptr<ObservableCollection> items_;           // 直接项集合
     ItemContainerGenerator generator_;                      // 容器生成器
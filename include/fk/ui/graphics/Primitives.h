@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
 
 namespace fk::ui {
@@ -26,6 +27,8 @@ struct Size {
     Size(float width, float height) : width(width), height(height) {}
     
     bool IsEmpty() const { return width <= 0.0f || height <= 0.0f; }
+    
+    bool operator==(const Size& other) const = default;
 };
 
 /**
@@ -57,6 +60,35 @@ struct Rect {
     }
     
     bool IsEmpty() const { return width <= 0.0f || height <= 0.0f; }
+    
+    bool Intersects(const Rect& other) const {
+        return x < other.Right() && other.x < Right() &&
+               y < other.Bottom() && other.y < Bottom();
+    }
+    
+    /**
+     * @brief 计算交集（不相交时返回空矩形）
+     */
+    Rect Intersect(const Rect& other) const {
+        float left = std::max(x, other.x);
+        float top = std::max(y, other.y);
+        float right = std::min(Right(), other.Right());
+        float bottom = std::min(Bottom(), other.Bottom());
+        return Rect(left, top, std::max(0.0f, right - left), std::max(0.0f, bottom - top));
+    }
+    
+    /**
+     * @brief 计算包含两个矩形的最小矩形（忽略空矩形）
+     */
+    Rect Union(const Rect& other) const {
+        if (IsEmpty()) return other;
+        if (other.IsEmpty()) return *this;
+        float left = std::min(x, other.x);
+        float top = std::min(y, other.y);
+        return Rect(left, top, std::max(Right(), other.Right()) - left, std::max(Bottom(), other.Bottom()) - top);
+    }
+    
+    float Area() const { return IsEmpty() ? 0.0f : width * height; }
 };
 
 /**
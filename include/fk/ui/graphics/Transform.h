@@ -1,6 +1,8 @@
 #pragma once
 
 #include "fk/ui/graphics/Primitives.h"
+#include "fk/core/Event.h"
+#include <cstdint>
 #include <vector>
 
 namespace fk::ui {
@@ -28,6 +30,29 @@ public:
      * @brief 获取逆变换矩阵（用于命中测试）
      */
     virtual Matrix3x2 GetInverseMatrix() const;
+    
+    /**
+     * @brief 获取版本号（Phase 5.1）
+     * 
+     * 每次修改变换参数时递增，命中测试索引据此判断变换是否被原地修改，
+     * 而不必每次查询都重新计算矩阵
+     */
+    virtual std::uint64_t GetVersion() const { return version_; }
+    
+    /**
+     * @brief 变换参数改变时触发（只在 UI 线程使用）
+     * 
+     * 使用该变换的 UIElement 据此通知父元素的命中测试索引
+     */
+    core::Event<> Changed{core::EventThreading::SingleThreaded};
+    
+protected:
+    void Touch() {
+        ++version_;
+        Changed();
+    }
+    
+    std::uint64_t version_{0};
 };
 
 /**
@@ -39,8 +64,8 @@ public:
     
     Matrix3x2 GetMatrix() const override;
     
-    void SetX(float x) { x_ = x; }
-    void SetY(float y) { y_ = y; }
+    void SetX(float x) { x_ = x; Touch(); }
+    void SetY(float y) { y_ = y; Touch(); }
     float GetX() const { return x_; }
     float GetY() const { return y_; }
     
@@ -59,10 +84,10 @@ public:
     
     Matrix3x2 GetMatrix() const override;
     
-    void SetScaleX(float scaleX) { scaleX_ = scaleX; }
-    void SetScaleY(float scaleY) { scaleY_ = scaleY; }
-    void SetCenterX(float x) { centerX_ = x; }
-    void SetCenterY(float y) { centerY_ = y; }
+    void SetScaleX(float scaleX) { scaleX_ = scaleX; Touch(); }
+    void SetScaleY(float scaleY) { scaleY_ = scaleY; Touch(); }
+    void SetCenterX(float x) { centerX_ = x; Touch(); }
+    void SetCenterY(float y) { centerY_ = y; Touch(); }
     
     float GetScaleX() const { return scaleX_; }
     float GetScaleY() const { return scaleY_; }
@@ -86,9 +111,9 @@ public:
     
     Matrix3x2 GetMatrix() const override;
     
-    void SetAngle(float angle) { angle_ = angle; }
-    void SetCenterX(float x) { centerX_ = x; }
-    void SetCenterY(float y) { centerY_ = y; }
+    void SetAngle(float angle) { angle_ = angle; Touch(); }
+    void SetCenterX(float x) { centerX_ = x; Touch(); }
+    void SetCenterY(float y) { centerY_ = y; Touch(); }
     
     float GetAngle() const { return angle_; }
     float GetCenterX() const { return centerX_; }
@@ -110,10 +135,10 @@ public:
     
     Matrix3x2 GetMatrix() const override;
     
-    void SetAngleX(float angle) { angleX_ = angle; }
-    void SetAngleY(float angle) { angleY_ = angle; }
-    void SetCenterX(float x) { centerX_ = x; }
-    void SetCenterY(float y) { centerY_ = y; }
+    void SetAngleX(float angle) { angleX_ = angle; Touch(); }
+    void SetAngleY(float angle) { angleY_ = angle; Touch(); }
+    void SetCenterX(float x) { centerX_ = x; Touch(); }
+    void SetCenterY(float y) { centerY_ = y; Touch(); }
     
     float GetAngleX() const { return angleX_; }
     float GetAngleY() const { return angleY_; }
@@ -138,7 +163,7 @@ public:
     Matrix3x2 GetMatrix() const override { return matrix_; }
     Matrix3x2 GetInverseMatrix() const override;
     
-    void SetMatrix(const Matrix3x2& matrix) { matrix_ = matrix; }
+    void SetMatrix(const Matrix3x2& matrix) { matrix_ = matrix; Touch(); }
     
 private:
     Matrix3x2 matrix_;
@@ -150,6 +175,7 @@ private:
 class TransformGroup : public Transform {
 public:
     Matrix3x2 GetMatrix() const override;
+    std::uint64_t GetVersion() const override;
     
     void AddTransform(Transform* transform);
     void RemoveTransform(Transform* transform);
@@ -159,6 +185,7 @@ public:
     
 private:
     std::vector<Transform*> children_;
+    std::vector<core::Event<>::Connection> childConnections_;  // 与 children_ 一一对应，转发子变换的 Changed
 };
 
 } // namespace fk::ui
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "fk/ui/graphics/Primitives.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace fk::ui {
+
+class UIElement;
+
+/**
+ * @brief 子元素命中测试空间索引（Phase 5.1）
+ *
+ * 为子元素较多的元素维护一张均匀网格，网格覆盖所有子元素在父坐标系中的包围盒
+ * （布局矩形经 RenderTransform 变换后的轴对齐包围盒）。命中测试时只需取出点所在
+ * 网格单元中的候选子元素，按 z 序（视觉子节点顺序，靠后者在上）从上到下精确测试，
+ * 而不必逐个遍历所有子元素。
+ *
+ * 索引按父元素局部坐标建立，祖先移动或滚动不会使其失效：
+ * - 子元素 Arrange 后布局矩形或渲染尺寸变化、RenderTransform 被替换或原地修改
+ *   （Transform::Changed）时调用 MarkDirty，下次查询时只重新放置这些子元素
+ * - 增删子元素（子节点集合版本号变化）或脏子元素过多时整体重建
+ *
+ * 注意：只能在 UI 线程中使用。
+ */
+class HitTestIndex {
+public:
+    /**
+     * @brief 子元素数量达到该值时才建立索引，更少时直接线性遍历
+     */
+    static constexpr std::size_t kMinChildren = 32;
+
+    explicit HitTestIndex(UIElement* owner);
+
+    // 禁止拷贝和赋值
+    HitTestIndex(const HitTestIndex&) = delete;
+    HitTestIndex& operator=(const HitTestIndex&) = delete;
+
+    /**
+     * @brief 子元素的包围盒可能已变化
+     */
+    void MarkDirty(UIElement* child);
+
+    /**
+     * @brief 丢弃索引，下次查询时重建
+     */
+    void Invalidate() { valid_ = false; }
+
+    /**
+     * @brief 查询可能包含该点的子元素
+     * @param point 父元素局部坐标
+     * @param candidates 输出：候选子元素按 z 序从上到下追加到末尾（不清空已有内容）
+     */
+    void Query(const Point& point, std::vector<UIElement*>& candidates);
+
+    /**
+     * @brief 计算子元素在父坐标系中的包围盒（与命中测试使用相同的变换）
+     */
+    static Rect ComputeChildBounds(const UIElement& child);
+
+private:
+    struct Entry {
+        UIElement* child{nullptr};
+        Rect bounds;
+        int cellX0{0};
+        int cellY0{0};
+        int cellX1{-1};                // 闭区间；cellX1 < cellX0 表示未放入网格
+        int cellY1{-1};
+        bool oversized{false};         // 覆盖大量网格单元，放入 oversized_ 列表
+        bool outside{false};           // 包围盒超出网格范围（放在边缘单元中）
+        bool dirty{false};
+    };
+
+    void Rebuild();
+    void Refresh(std::uint32_t slot);
+    void Snapshot(Entry& entry);
+    void Place(std::uint32_t slot);
+    void Unplace(std::uint32_t slot);
+    int CellX(float x) const;
+    int CellY(float y) const;
+    std::vector<std::uint32_t>& Cell(int x, int y) { return cells_[static_cast<std::size_t>(y) * columns_ + x]; }
+
+    UIElement* owner_;
+    bool valid_{false};
+    std::uint64_t childrenVersion_{0};
+
+    std::vector<Entry> entries_;                 // 按视觉子节点索引（即 z 序）排列
+    std::unordered_map<const UIElement*, std::uint32_t> slots_;
+    std::vector<std::vector<std::uint32_t>> cells_;
+    std::vector<std::uint32_t> oversized_;       // 大元素，每次查询都作为候选
+    std::vector<std::uint32_t> dirty_;
+    std::vector<std::uint32_t> scratch_;         // 查询时合并候选的临时缓冲
+    std::size_t outsideCount_{0};                // 重新放置后超出网格范围的子元素数
+
+    Rect extent_;
+    int columns_{0};
+    int rows_{0};
+    float cellWidth_{1.0f};
+    float cellHeight_{1.0f};
+};
+
+} // namespace fk::ui
@@ -156,7 +156,7 @@ private:
     /**
      * @brief 执行递归命中测试
      */
-    UIElement* HitTestRecursive(Visual* visual, const Point& localPoint);
+    UIElement* HitTestRecursive(UIElement* element, const Point& localPoint);
     
     /**
      * @brief 分发指针按下事件
@@ -210,6 +210,7 @@ private:
     UIElement* mouseOverElement_{nullptr};                     // 当前鼠标悬停元素
     Point lastPointerPosition_;                                // 最后指针位置
     std::unordered_map<int, UIElement*> pointerDownTargets_;   // 记录按下的元素
+    std::vector<UIElement*> hitTestCandidates_;                // 命中测试候选缓冲区（各层递归共用）
 };
 
 } // namespace fk::ui
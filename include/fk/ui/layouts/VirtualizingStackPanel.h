@@ -0,0 +1,155 @@
+#pragma once
+
+#include "fk/ui/layouts/Panel.h"
+#include "fk/ui/scrolling/IScrollInfo.h"
+#include "fk/ui/styling/Enums.h"
+#include "fk/binding/DependencyProperty.h"
+#include <vector>
+
+namespace fk::ui {
+
+class ItemContainerGenerator;
+class ObservableCollection;
+struct CollectionChangedEventArgs;
+
+/**
+ * @brief 虚拟化堆栈面板（Phase 5.1）
+ *
+ * 职责：
+ * - 作为 ItemsControl 的 ItemsPanel，只为视口及前后缓存区内的项生成容器
+ * - 离开该窗口的容器通过 ItemContainerGenerator::RecycleContainer 回收复用
+ * - 实现 IScrollInfo：由 ScrollContentPresenter 传入滚动偏移，
+ *   并根据平均项尺寸估算 Extent
+ *
+ * 内存占用和测量耗时只与视口大小相关，与项数量无关。
+ * 不在逻辑滚动宿主中（堆叠方向可用尺寸为无限）时退化为普通 StackPanel，
+ * 会实例化全部项。
+ *
+ * 使用方式：
+ * ```cpp
+ * auto* panel = new VirtualizingStackPanel();
+ * scrollViewer->Content(panel);
+ * listBox->ItemsPanel(panel);
+ * ```
+ *
+ * WPF 对应：VirtualizingStackPanel
+ */
+class VirtualizingStackPanel : public Panel<VirtualizingStackPanel>, public IScrollInfo {
+public:
+    // ========== 依赖属性 ==========
+
+    /// Orientation 属性：堆叠方向
+    static const binding::DependencyProperty& OrientationProperty();
+
+    /// CacheLength 属性：视口前后各额外实例化的长度（以视口长度为单位）
+    static const binding::DependencyProperty& CacheLengthProperty();
+
+public:
+    VirtualizingStackPanel() = default;
+    ~VirtualizingStackPanel() override;
+
+    // ========== 方向 ==========
+
+    Orientation GetOrientation() const { return GetValue<enum ui::Orientation>(OrientationProperty()); }
+    void SetOrientation(Orientation value) {
+        SetValue(OrientationProperty(), value);
+        InvalidateMeasure();
+    }
+
+    VirtualizingStackPanel* SetOrient(enum Orientation value) {
+        SetOrientation(value);
+        return this;
+    }
+
+    // ========== 缓存长度 ==========
+
+    float GetCacheLength() const { return GetValue<float>(CacheLengthProperty()); }
+    void SetCacheLength(float value) {
+        SetValue(CacheLengthProperty(), value);
+        InvalidateMeasure();
+    }
+
+    VirtualizingStackPanel* CacheLength(float value) {
+        SetCacheLength(value);
+        return this;
+    }
+    float CacheLength() const { return GetCacheLength(); }
+
+    // ========== 项宿主 ==========
+
+    /**
+     * @brief 关联项集合与容器生成器（由 ItemsControl 调用）
+     *
+     * 传入 nullptr 时解除关联，已实例化的容器全部交还给原生成器。
+     */
+    void SetItemsHost(ItemContainerGenerator* generator, const ObservableCollection* items);
+
+    /**
+     * @brief 项集合变更（由 ItemsControl 调用）
+     *
+     * 索引可能整体移动，回收所有已实例化的容器并重新测量。
+     */
+    void OnItemsChanged(const CollectionChangedEventArgs& args);
+
+    /**
+     * @brief 已实例化的容器数量
+     */
+    size_t GetRealizedCount() const { return realized_.size(); }
+
+    /**
+     * @brief 第一个已实例化项的索引（没有时为 -1）
+     */
+    int GetFirstRealizedIndex() const { return realized_.empty() ? -1 : realized_.front().index; }
+
+    /**
+     * @brief 根据项索引查找已实例化的容器（未实例化时返回 nullptr）
+     */
+    UIElement* ContainerFromIndex(int index) const;
+
+    // ========== IScrollInfo ==========
+
+    Size GetExtent() const override { return extent_; }
+    void SetScrollOffset(double horizontalOffset, double verticalOffset) override;
+
+protected:
+    Size MeasureOverride(const Size& availableSize) override;
+    Size ArrangeOverride(const Size& finalSize) override;
+    void OnRender(render::RenderContext& context) override;
+
+private:
+    struct RealizedItem {
+        int index;
+        UIElement* container;
+    };
+
+    /**
+     * @brief 为指定索引生成容器并加入可视树
+     */
+    UIElement* Realize(int index);
+
+    /**
+     * @brief 回收 [first, last] 之外的容器
+     */
+    void RecycleOutside(int first, int last);
+
+    /**
+     * @brief 回收全部容器
+     */
+    void RecycleAll();
+
+    void Recycle(UIElement* container);
+
+    float GetEstimatedItemSize() const;
+
+    ItemContainerGenerator* generator_{nullptr};
+    const ObservableCollection* items_{nullptr};
+
+    std::vector<RealizedItem> realized_;     // 按索引升序，连续区间
+
+    double horizontalOffset_{0};
+    double verticalOffset_{0};
+    Size extent_{0, 0};
+    float averageItemSize_{0};               // 堆叠方向平均项尺寸（含 Margin），0 表示尚未测量
+};
+
+} // namespace fk::ui
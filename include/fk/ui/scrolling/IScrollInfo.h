@@ -0,0 +1,31 @@
+#pragma once
+
+#include "fk/ui/graphics/Primitives.h"
+
+namespace fk::ui {
+
+/**
+ * @brief 逻辑滚动接口（Phase 5.1）
+ *
+ * 实现此接口的内容自行管理滚动：ScrollContentPresenter 不再在滚动方向上
+ * 给内容无限空间并整体平移，而是用视口尺寸测量内容、把滚动偏移传给内容，
+ * 并从内容读取 Extent。虚拟化面板借此只实例化视口内的子元素。
+ *
+ * WPF 对应：IScrollInfo（简化版）
+ */
+class IScrollInfo {
+public:
+    virtual ~IScrollInfo() = default;
+
+    /**
+     * @brief 内容总尺寸（可以是估算值）
+     */
+    virtual Size GetExtent() const = 0;
+
+    /**
+     * @brief 设置滚动偏移（由 ScrollContentPresenter 在测量和排列前调用）
+     */
+    virtual void SetScrollOffset(double horizontalOffset, double verticalOffset) = 0;
+};
+
+} // namespace fk::ui
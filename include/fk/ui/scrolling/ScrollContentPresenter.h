@@ -1,8 +1,11 @@
 #pragma once
 
 #include "fk/ui/controls/ContentPresenter.h"
+#include "fk/ui/scrolling/IScrollInfo.h"
 #include "fk/binding/DependencyProperty.h"
 #include "fk/core/Event.h"
+#include "fk/render/ScrollLayer.h"
+#include <memory>
 
 namespace fk::ui {
 
@@ -24,6 +27,11 @@ class ScrollViewer;
  * 1. MeasureOverride：在滚动方向上给内容无限空间
  * 2. ArrangeOverride：根据偏移量定位内容
  * 3. 自动裁剪超出可视区域的内容
+ * 4. 内容实现 IScrollInfo 时改为逻辑滚动：用视口尺寸测量内容，
+ *    偏移交给内容处理，Extent 由内容报告（用于虚拟化）
+ * 5. 合成滚动（Phase 5.1，需显式启用）：偏移变化时只移动内容，不重新排列；
+ *    渲染时平移保留的内容命令并与视口裁剪求交（render::ScrollLayer）。
+ *    只保留命令、不复用像素：每次滚动整个视口仍计入损坏区域并重新光栅化
  * 
  * 使用场景：
  * ```cpp
@@ -67,6 +75,9 @@ public:
     /** @brief 垂直滚动偏移量 */
     static const binding::DependencyProperty& VerticalOffsetProperty();
 
+    /** @brief 是否使用合成滚动（Phase 5.1，默认关闭；只保留命令，视口仍整体重绘） */
+    static const binding::DependencyProperty& CompositedScrollingProperty();
+
     // ========== 事件 ==========
     
     /**
@@ -113,6 +124,32 @@ public:
     
     bool CanVerticallyScroll() const { return GetCanVerticallyScroll(); }
 
+    // ========== CompositedScrolling 属性 ==========
+    
+    bool GetCompositedScrolling() const {
+        return this->template GetValue<bool>(CompositedScrollingProperty());
+    }
+    
+    void SetCompositedScrolling(bool value) {
+        if (value == GetCompositedScrolling()) {
+            return;
+        }
+        this->SetValue(CompositedScrollingProperty(), value);
+        scrollLayer_.reset();
+        this->InvalidateArrange();
+        this->InvalidateVisual();
+    }
+    
+    Self CompositedScrolling(bool value) {
+        SetCompositedScrolling(value);
+        return static_cast<Self>(this);
+    }
+    
+    bool CompositedScrolling() const { return GetCompositedScrolling(); }
+
+    /** @brief 合成滚动图层（未启用合成滚动时为空） */
+    const render::ScrollLayer* GetScrollLayer() const { return scrollLayer_.get(); }
+
     // ========== HorizontalOffset 属性 ==========
     
     double GetHorizontalOffset() const {
@@ -124,7 +161,7 @@ public:
         double clampedValue = std::clamp(value, 0.0, GetScrollableWidth());
         if (clampedValue != GetHorizontalOffset()) {
             this->SetValue(HorizontalOffsetProperty(), clampedValue);
-            this->InvalidateArrange();
+            UpdateContentOffset();
             ScrollInfoChanged();
         }
     }
@@ -147,7 +184,7 @@ public:
         double clampedValue = std::clamp(value, 0.0, GetScrollableHeight());
         if (clampedValue != GetVerticalOffset()) {
             this->SetValue(VerticalOffsetProperty(), clampedValue);
-            this->InvalidateArrange();
+            UpdateContentOffset();
             ScrollInfoChanged();
         }
     }
@@ -335,6 +372,22 @@ protected:
         UIElement* child = this->GetVisualChild();
         Size childDesiredSize(0, 0);
         
+        if (auto* scrollInfo = dynamic_cast<IScrollInfo*>(child)) {
+            // Phase 5.1: 逻辑滚动，内容用视口尺寸测量并自行报告 Extent
+            scrollInfo->SetScrollOffset(GetHorizontalOffset(), GetVerticalOffset());
+            child->Measure(availableSize);
+            Size extent = scrollInfo->GetExtent();
+            bool extentChanged = extentWidth_ != extent.width || extentHeight_ != extent.height;
+            extentWidth_ = extent.width;
+            extentHeight_ = extent.height;
+            if (extentChanged) {
+                ScrollInfoChanged();
+            }
+            Size desired = child->GetDesiredSize();
+            return Size(std::min(desired.width, availableSize.width),
+                        std::min(desired.height, availableSize.height));
+        }
+        
         if (child) {
             // 构建测量约束
             // 关键：只在需要滚动的方向给无限空间
@@ -404,7 +457,11 @@ protected:
         }
         
         // 排列内容
-        if (child) {
+        if (auto* scrollInfo = dynamic_cast<IScrollInfo*>(child)) {
+            // 逻辑滚动：内容占满视口，按偏移自行定位子元素
+            scrollInfo->SetScrollOffset(GetHorizontalOffset(), GetVerticalOffset());
+            child->Arrange(Rect(0, 0, finalSize.width, finalSize.height));
+        } else if (child) {
             // 内容大小：取 Extent 和 Viewport 中的较大值
             Size contentSize(
                 std::max(extentWidth_, (double)finalSize.width),
@@ -435,6 +492,25 @@ protected:
         return finalSize;
     }
     
+    /**
+     * @brief 收集内容的绘制命令
+     * 
+     * 合成滚动时合成保留的内容命令，只有内容变化或视口移出记录窗口时才重新收集
+     */
+    void CollectChildDrawCommands(render::RenderContext& context) override {
+        UIElement* child = this->GetVisualChild();
+        if (!IsCompositedScrollingActive(child)) {
+            scrollLayer_.reset();
+            Base::CollectChildDrawCommands(context);
+            return;
+        }
+        if (!scrollLayer_) {
+            scrollLayer_ = std::make_unique<render::ScrollLayer>();
+        }
+        Rect viewport = CalculateClipBounds();
+        scrollLayer_->Compose(context, child, Size(viewport.width, viewport.height));
+    }
+    
     /**
      * @brief 始终启用裁剪
      * 
@@ -456,6 +532,31 @@ protected:
     }
 
 private:
+    /**
+     * @brief 是否对内容使用合成滚动（逻辑滚动的内容自行定位子元素，不使用）
+     */
+    bool IsCompositedScrollingActive(UIElement* child) const {
+        return child && GetCompositedScrolling() && !dynamic_cast<IScrollInfo*>(child);
+    }
+    
+    /**
+     * @brief 偏移变化后更新内容位置
+     * 
+     * 合成滚动时只移动内容（与 ArrangeOverride 的定位一致）并重新合成，
+     * 否则重新排列内容
+     */
+    void UpdateContentOffset() {
+        UIElement* child = this->GetVisualChild();
+        if (!IsCompositedScrollingActive(child)) {
+            this->InvalidateArrange();
+            return;
+        }
+        double offsetX = GetCanHorizontallyScroll() ? -GetHorizontalOffset() : 0;
+        double offsetY = GetCanVerticallyScroll() ? -GetVerticalOffset() : 0;
+        child->Reposition(Point(static_cast<float>(offsetX), static_cast<float>(offsetY)));
+        this->InvalidateVisual();
+    }
+    
     /**
      * @brief 调整偏移量到有效范围
      * 
@@ -483,6 +584,9 @@ private:
     
     // 单行滚动量（像素）
     double lineScrollAmount_{16.0};
+    
+    // 合成滚动保留的内容命令（Phase 5.1）
+    std::unique_ptr<render::ScrollLayer> scrollLayer_;
 };
 
 // ========== 依赖属性实现 ==========
@@ -504,7 +608,7 @@ const binding::DependencyProperty& ScrollContentPresenter<Derived>::CanVerticall
         "CanVerticallyScroll",
         typeid(bool),
         typeid(ScrollContentPresenter<Derived>),
-        binding::PropertyMetadata{std::any(true)}
+        binding::PropertyMetadata{std::any(false)}
     );
     return property;
 }
@@ -531,6 +635,17 @@ const binding::DependencyProperty& ScrollContentPresenter<Derived>::VerticalOffs
     return property;
 }
 
+template<typename Derived>
+const binding::DependencyProperty& ScrollContentPresenter<Derived>::CompositedScrollingProperty() {
+    static auto& property = binding::DependencyProperty::Register(
+        "CompositedScrolling",
+        typeid(bool),
+        typeid(ScrollContentPresenter<Derived>),
+        binding::PropertyMetadata{std::any(true)}
+    );
+    return property;
+}
+
 // 类型别名
 using ScrollContentPresenter_t = ScrollContentPresenter<>;
 
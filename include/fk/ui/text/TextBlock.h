@@ -4,12 +4,15 @@
 #include "fk/ui/text/TextEnums.h"
 #include "fk/ui/PropertyMacros.h"
 #include "fk/binding/DependencyProperty.h"
+#include <memory>
 #include <string>
 
 namespace fk {
 namespace render { 
     class RenderContext; 
     class TextRenderer;
+    class GlyphMetricsProvider;
+    class TextLayout;
 }
 }
 
@@ -25,6 +28,9 @@ class Brush;
  * - 显示只读文本
  * - 文本样式（字体、颜色等）
  * 
+ * Phase 5.1: 测量时创建 render::TextLayout 并保存在元素上，绘制命令共享同一排版结果。
+ * 文本、字体或换行宽度变化时才重新排版。
+ * 
  * WPF 对应：TextBlock
  */
 class TextBlock : public FrameworkElement<TextBlock> {
@@ -68,6 +74,17 @@ public:
      * @return TextRenderer 实例指针，可能为 nullptr
      */
     static render::TextRenderer* GetGlobalTextRenderer();
+    
+    /**
+     * @brief 设置全局字形度量来源（由 Window 调用，无头窗口使用软件渲染器的字形缓存）
+     * @param provider 度量来源指针，nullptr 时使用估算测量
+     */
+    static void SetGlobalGlyphMetrics(render::GlyphMetricsProvider* provider);
+    
+    /**
+     * @brief 获取全局字形度量来源
+     */
+    static render::GlyphMetricsProvider* GetGlobalGlyphMetrics();
 
 public:
     TextBlock();
@@ -76,30 +93,16 @@ public:
     // ========== 文本内容 ==========
     
     // 使用 PropertyMacros 简化属性声明（从 36 行减少到 3 行）
-    FK_PROPERTY_COMPLEX(Text, std::string, TextBlock, this->InvalidateVisual())
+    // 影响排版的属性由元数据回调使测量和绘制失效，Set 方法不再重复失效
+    FK_PROPERTY_COMPLEX_NO_ACTION(Text, std::string, TextBlock)
 
     // ========== 字体属性 ==========
     
-    FK_PROPERTY_COMPLEX(FontFamily, std::string, TextBlock, this->InvalidateVisual())
-    FK_PROPERTY_VISUAL(FontSize, float, TextBlock)
-    
-    ui::FontWeight GetFontWeight() const { return GetValue<ui::FontWeight>(FontWeightProperty()); }
-    void SetFontWeight(ui::FontWeight value) { SetValue(FontWeightProperty(), value); }
-    
-    TextBlock* FontWeight(ui::FontWeight value) {
-        SetFontWeight(value);
-        return this;
-    }
-    ui::FontWeight FontWeight() const { return GetFontWeight(); }
-    
-    ui::FontStyle GetFontStyle() const { return GetValue<ui::FontStyle>(FontStyleProperty()); }
-    void SetFontStyle(ui::FontStyle value) { SetValue(FontStyleProperty(), value); }
-    
-    TextBlock* FontStyle(ui::FontStyle value) {
-        SetFontStyle(value);
-        return this;
-    }
-    ui::FontStyle FontStyle() const { return GetFontStyle(); }
+    // 字体属性决定解析到的字体和排版结果，同样由元数据回调重新测量
+    FK_PROPERTY_COMPLEX_NO_ACTION(FontFamily, std::string, TextBlock)
+    FK_PROPERTY_SIMPLE_NO_ACTION(FontSize, float, TextBlock)
+    FK_PROPERTY_SIMPLE_NO_ACTION(FontWeight, ui::FontWeight, TextBlock)
+    FK_PROPERTY_SIMPLE_NO_ACTION(FontStyle, ui::FontStyle, TextBlock)
     
     // ========== 文本格式 ==========
     
@@ -112,14 +115,7 @@ public:
     }
     ui::TextAlignment TextAlignment() const { return GetTextAlignment(); }
     
-    ui::TextWrapping GetTextWrapping() const { return GetValue<ui::TextWrapping>(TextWrappingProperty()); }
-    void SetTextWrapping(ui::TextWrapping value) { SetValue(TextWrappingProperty(), value); }
-    
-    TextBlock* TextWrapping(ui::TextWrapping value) {
-        SetTextWrapping(value);
-        return this;
-    }
-    ui::TextWrapping TextWrapping() const { return GetTextWrapping(); }
+    FK_PROPERTY_SIMPLE_NO_ACTION(TextWrapping, ui::TextWrapping, TextBlock)
     
     // ========== 外观 ==========
     
@@ -131,11 +127,28 @@ public:
         return this;
     }
     Brush* Foreground() const { return GetForeground(); }
+    
+    // ========== 排版 ==========
+    
+    /**
+     * @brief 最近一次测量或绘制使用的排版结果（尚未排版时为 nullptr）
+     */
+    const std::shared_ptr<const render::TextLayout>& GetTextLayout() const { return textLayout_; }
 
 protected:
     Size MeasureOverride(const Size& availableSize) override;
     Size ArrangeOverride(const Size& finalSize) override;
     void OnRender(render::RenderContext& context) override;
+
+private:
+    /**
+     * @brief 返回与当前文本、字体和换行宽度一致的排版结果，必要时重新排版
+     * @param maxWidth 可用宽度（不换行时忽略）
+     * @return 没有字形度量来源或字体加载失败时返回 nullptr
+     */
+    const std::shared_ptr<const render::TextLayout>& EnsureTextLayout(float maxWidth);
+
+    std::shared_ptr<const render::TextLayout> textLayout_;
 };
 
 } // namespace fk::ui
@@ -72,6 +72,14 @@ void AnimationManager::Update(std::chrono::milliseconds deltaTime) {
     }
 }
 
+bool AnimationManager::HasActiveAnimations() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    return std::any_of(activeTimelines_.begin(), activeTimelines_.end(), [](Timeline* timeline) {
+        return timeline && timeline->IsActive() && !timeline->IsPaused();
+    });
+}
+
 void AnimationManager::Clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     activeTimelines_.clear();
@@ -1,5 +1,8 @@
 #include "fk/app/Application.h"
 #include "fk/animation/AnimationManager.h"
+#include "fk/binding/BindingUpdateQueue.h"
+#include "fk/binding/PropertyChangedMarshaller.h"
+#include "fk/render/ImageCache.h"
 
 #ifdef FK_HAS_GLFW
 #include <GLFW/glfw3.h>
@@ -9,14 +12,54 @@
 
 namespace fk {
 
+namespace {
+
+// 空闲时单次等待的上限，避免遗漏未通知的状态变化
+constexpr std::chrono::milliseconds kMaxIdleWait{1000};
+
+#ifdef FK_HAS_GLFW
+/**
+ * @brief 基于 GLFW 事件队列的调度器后端
+ * 
+ * 空闲等待阻塞在 glfwWaitEventsTimeout 中；其他线程投递任务时
+ * 通过 glfwPostEmptyEvent 唤醒主线程
+ */
+class GlfwDispatcherBackend : public core::IDispatcherBackend {
+public:
+    void NotifyWorkPending() override {
+        glfwPostEmptyEvent();
+    }
+
+    void WaitForEvents(std::chrono::milliseconds timeout) override {
+        glfwWaitEventsTimeout(static_cast<double>(timeout.count()) / 1000.0);
+    }
+};
+#endif
+
+} // namespace
+
 Application* Application::instance_ = nullptr;
 
 Application::Application()
     : isRunning_(false) {
     instance_ = this;
+#ifdef FK_HAS_GLFW
+    dispatcher_ = std::make_shared<core::Dispatcher>("UI", std::make_unique<GlfwDispatcherBackend>());
+#else
+    dispatcher_ = std::make_shared<core::Dispatcher>("UI");
+#endif
+    dispatcher_->BindToCurrentThread();
+    // 合并后的绑定更新与跨线程属性通知通过 UI 线程调度器投递
+    binding::BindingUpdateQueue::Instance().SetDispatcher(dispatcher_);
+    binding::PropertyChangedMarshaller::Instance().SetDispatcher(dispatcher_);
+    // 图像在线程池中解码，完成后回到 UI 线程
+    render::ImageCache::Instance().SetDispatcher(dispatcher_);
 }
 
 Application::~Application() {
+    binding::PropertyChangedMarshaller::Instance().SetDispatcher(nullptr);
+    binding::BindingUpdateQueue::Instance().SetDispatcher(nullptr);
+    render::ImageCache::Instance().SetDispatcher(nullptr);
     if (instance_ == this) {
         instance_ = nullptr;
     }
@@ -57,19 +100,30 @@ void Application::Run(ui::WindowPtr mainWindow) {
     // 消息循环
     std::cout << "Starting message loop..." << std::endl;
     
+    auto& animations = animation::AnimationManager::Instance();
     auto lastFrameTime = std::chrono::steady_clock::now();
+    bool wasAnimating = false;
+    dispatcher_->BindToCurrentThread();
     
     while (isRunning_) {
-#ifdef FK_HAS_GLFW
-        glfwPollEvents();
-#endif
-        // 计算帧时间
+        // 按需调度：没有动画、没有待执行任务且窗口无需重绘时阻塞等待，
+        // 直到有输入事件、投递的任务或定时器到期
+        if (!wasAnimating && !dispatcher_->HasPendingTasks() && !mainWindow_->NeedsRender()) {
+            dispatcher_->WaitForEvents(kMaxIdleWait);
+        }
+        
+        // 执行投递到 UI 线程的任务和到期的定时器
+        dispatcher_->ProcessPendingTasks();
+        
+        // 计算帧时间（空闲期间启动的动画从 0 开始计时，避免跳帧）
         auto currentTime = std::chrono::steady_clock::now();
-        auto deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastFrameTime);
+        auto deltaTime = wasAnimating
+            ? std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - lastFrameTime)
+            : std::chrono::milliseconds::zero();
         lastFrameTime = currentTime;
         
         // 更新所有活动动画
-        animation::AnimationManager::Instance().Update(deltaTime);
+        animations.Update(deltaTime);
         
         // 处理所有窗口的消息
         if (!mainWindow_->ProcessEvents()) {
@@ -77,8 +131,12 @@ void Application::Run(ui::WindowPtr mainWindow) {
             break;
         }
         
-        // 渲染主窗口 (RenderFrame 内部会在需要时调用 glfwSwapBuffers)
-        mainWindow_->RenderFrame();
+        // 只在内容变化时渲染主窗口 (RenderFrame 内部会在需要时调用 glfwSwapBuffers)
+        if (mainWindow_->NeedsRender()) {
+            mainWindow_->RenderFrame();
+        }
+        
+        wasAnimating = animations.HasActiveAnimations();
     }
     
     std::cout << "Message loop ended" << std::endl;
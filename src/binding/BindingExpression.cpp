@@ -1,6 +1,7 @@
 #include "fk/binding/BindingExpression.h"
 #include "fk/binding/ValueConverters.h"
 #include "fk/binding/TemplateBinding.h"
+#include "fk/binding/BindingUpdateQueue.h"
 #include "fk/core/Dispatcher.h"
 #include "fk/ui/base/UIElement.h"
 
@@ -117,15 +118,12 @@ void BindingExpression::UpdateTarget() {
         return;
     }
 
-    std::any value = resolvedValue;
+    std::any value;
     if (const auto& converter = definition_.GetConverter()) {
         const std::any* parameter = definition_.HasConverterParameter() ? &definition_.GetConverterParameter() : nullptr;
-        value = converter->Convert(value, property_->PropertyType(), parameter);
-    } else {
-        std::any converted;
-        if (TryDefaultConvert(resolvedValue, property_->PropertyType(), converted)) {
-            value = std::move(converted);
-        }
+        value = converter->Convert(resolvedValue, property_->PropertyType(), parameter);
+    } else if (!targetConverterCache_.Convert(resolvedValue, property_->PropertyType(), value)) {
+        value = std::move(resolvedValue);
     }
 
     ApplyTargetValue(std::move(value));
@@ -166,7 +164,7 @@ void BindingExpression::UpdateSource() {
         valueToAssign = converter->ConvertBack(targetValue, sourceType, parameter);
     } else {
         std::any converted;
-        if (TryDefaultConvert(targetValue, sourceType, converted)) {
+        if (sourceConverterCache_.Convert(targetValue, sourceType, converted)) {
             valueToAssign = std::move(converted);
         }
     }
@@ -201,25 +199,8 @@ void BindingExpression::UpdateTargetAsync() {
         UpdateTarget();  // Fall back to synchronous update
         return;
     }
-
-    // Avoid duplicate pending updates
-    if (hasPendingTargetUpdate_) {
-        return;
-    }
-
-    hasPendingTargetUpdate_ = true;
-    auto weakSelf = weak_from_this();
-
-    // Note: Using a simple approach here. In production, this should integrate
-    // with the UI framework's Dispatcher/main thread message loop.
-    // For now, we'll execute immediately but with the async flag for demonstration.
-    // A real implementation would use: Dispatcher::Instance().Post([weakSelf]() { ... });
-    
-    // Immediate execution for now (to avoid threading complexity in demo)
-    if (auto self = weakSelf.lock()) {
-        self->hasPendingTargetUpdate_ = false;
-        self->UpdateTarget();
-    }
+    // Phase 5.1: 交给 BindingUpdateQueue，在 UI 线程下一次刷新时执行（同一表达式只执行一次）
+    BindingUpdateQueue::Instance().EnqueueTargetUpdate(shared_from_this());
 }
 
 void BindingExpression::UpdateSourceAsync() {
@@ -227,20 +208,49 @@ void BindingExpression::UpdateSourceAsync() {
         UpdateSource();  // Fall back to synchronous update
         return;
     }
+    BindingUpdateQueue::Instance().EnqueueSourceUpdate(shared_from_this());
+}
 
-    // Avoid duplicate pending updates
-    if (hasPendingSourceUpdate_) {
+void BindingExpression::RequestTargetUpdate() {
+    if (definition_.GetIsAsync()) {
+        UpdateTargetAsync();
         return;
     }
+    // 在工作线程中触发的变化封送到 UI 线程执行
+    auto& queue = BindingUpdateQueue::Instance();
+    if (!queue.HasThreadAccess()) {
+        queue.EnqueueTargetUpdate(shared_from_this());
+        return;
+    }
+    UpdateTarget();
+}
 
-    hasPendingSourceUpdate_ = true;
-    auto weakSelf = weak_from_this();
+bool BindingExpression::QueueIfOffUiThread(bool targetUpdate) {
+    // isActive_ / isUpdatingTarget_ 只在 UI 线程读写：工作线程中不检查，直接排队，
+    // 由 UI 线程刷新队列时 UpdateTarget / UpdateSource 重新检查
+    auto& queue = BindingUpdateQueue::Instance();
+    if (queue.HasThreadAccess()) {
+        return false;
+    }
+    if (targetUpdate) {
+        queue.EnqueueTargetUpdate(shared_from_this());
+    } else {
+        queue.EnqueueSourceUpdate(shared_from_this());
+    }
+    return true;
+}
 
-    // Immediate execution for now (to avoid threading complexity in demo)
-    if (auto self = weakSelf.lock()) {
-        self->hasPendingSourceUpdate_ = false;
-        self->UpdateSource();
+void BindingExpression::RequestSourceUpdate() {
+    if (definition_.GetIsAsync()) {
+        UpdateSourceAsync();
+        return;
     }
+    auto& queue = BindingUpdateQueue::Instance();
+    if (!queue.HasThreadAccess()) {
+        queue.EnqueueSourceUpdate(shared_from_this());
+        return;
+    }
+    UpdateSource();
 }
 
 void BindingExpression::ApplyTargetValue(std::any value) {
@@ -273,11 +283,7 @@ void BindingExpression::Subscribe() {
             [weakSelf](const std::any&, const std::any&) {
                 if (auto self = weakSelf.lock()) {
                     self->RefreshSourceSubscription();
-                    if (self->definition_.GetIsAsync()) {
-                        self->UpdateTargetAsync();
-                    } else {
-                        self->UpdateTarget();
-                    }
+                    self->RequestTargetUpdate();
                 }
             });
     } else {
@@ -291,6 +297,9 @@ void BindingExpression::Subscribe() {
                     if (&property != self->property_) {
                         return;
                     }
+                    if (self->QueueIfOffUiThread(false)) {
+                        return;
+                    }
                     if (!self->isActive_ || self->isUpdatingTarget_) {
                         return;
                     }
@@ -298,11 +307,7 @@ void BindingExpression::Subscribe() {
                         return;
                     }
                     if (self->effectiveUpdateSourceTrigger_ == UpdateSourceTrigger::PropertyChanged) {
-                        if (self->definition_.GetIsAsync()) {
-                            self->UpdateSourceAsync();
-                        } else {
-                            self->UpdateSource();
-                        }
+                        self->RequestSourceUpdate();
                     }
                 }
             });
@@ -430,6 +435,9 @@ void BindingExpression::RefreshSourceSubscription() {
             sourceDependencyObjectConnection_ = depObj->PropertyChanged.Connect(
                 [weakSelf, this](const DependencyProperty& prop, const std::any&, const std::any&, ValueSource, ValueSource) {
                     if (auto self = weakSelf.lock()) {
+                        if (self->QueueIfOffUiThread(true)) {
+                            return;
+                        }
                         if (!self->isActive_ || self->isUpdatingTarget_) {
                             return;
                         }
@@ -439,11 +447,7 @@ void BindingExpression::RefreshSourceSubscription() {
                                 return;
                             }
                         }
-                        if (self->definition_.GetIsAsync()) {
-                            self->UpdateTargetAsync();
-                        } else {
-                            self->UpdateTarget();
-                        }
+                        self->RequestTargetUpdate();
                     }
                 });
             
@@ -451,11 +455,7 @@ void BindingExpression::RefreshSourceSubscription() {
             if (isTemplateBinding_) {
                 auto weakSelf2 = weak_from_this();
                 if (auto self = weakSelf2.lock()) {
-                    if (self->definition_.GetIsAsync()) {
-                        self->UpdateTargetAsync();
-                    } else {
-                        self->UpdateTarget();
-                    }
+                    self->RequestTargetUpdate();
                 }
             }
             
@@ -475,14 +475,13 @@ void BindingExpression::RefreshSourceSubscription() {
     sourcePropertyConnection_ = notifier->PropertyChanged().Connect(
         [weakSelf](std::string_view propertyName) {
             if (auto self = weakSelf.lock()) {
-                if (!self->isActive_ || self->isUpdatingTarget_) {
+                if (self->QueueIfOffUiThread(true)) {
                     return;
                 }
-                if (self->definition_.GetIsAsync()) {
-                    self->UpdateTargetAsync();
-                } else {
-                    self->UpdateTarget();
+                if (!self->isActive_ || self->isUpdatingTarget_) {
+                    return;
                 }
+                self->RequestTargetUpdate();
             }
         });
 }
@@ -17,6 +17,16 @@ RegistryStorage& GetStorage() {
     return storage;
 }
 
+const std::any* TryGetIndexed(const std::any& current, std::size_t index) {
+    if (const auto* vectorPtr = std::any_cast<const std::vector<std::any>>(&current)) {
+        return index < vectorPtr->size() ? &(*vectorPtr)[index] : nullptr;
+    }
+    if (const auto* vectorPtr = std::any_cast<std::vector<std::any>>(&current)) {
+        return index < vectorPtr->size() ? &(*vectorPtr)[index] : nullptr;
+    }
+    return nullptr;
+}
+
 bool TryParseIndex(std::string_view token, std::size_t& outIndex) {
     const auto begin = token.data();
     const auto end = begin + token.size();
@@ -79,11 +89,13 @@ void PropertyAccessorRegistry::RegisterAccessor(std::type_index ownerType, std::
     std::lock_guard lock(storage.mutex);
     auto& ownerMap = storage.accessors[ownerType];
     auto& entry = ownerMap[std::move(name)];
-    if (accessor.getter) {
+    if (accessor.CanGet()) {
         entry.getter = accessor.getter;
+        entry.getterThunk = accessor.getterThunk;
     }
-    if (accessor.setter) {
+    if (accessor.CanSet()) {
         entry.setter = accessor.setter;
+        entry.setterThunk = accessor.setterThunk;
     }
 }
 
@@ -101,54 +113,168 @@ const PropertyAccessorRegistry::Accessor* PropertyAccessorRegistry::FindAccessor
     return &accessorIt->second;
 }
 
+// Phase 5.1: 编译后的路径——每一段进入时的值类型及解析好的访问器
+struct BindingPath::CompiledPath {
+    struct Step {
+        const std::type_info* type;                             // 该段输入值的类型
+        const PropertyAccessorRegistry::Accessor* accessor;     // 索引段为 nullptr
+    };
+
+    std::vector<Step> steps;
+    bool complete{false};   // 编译时整条路径都解析成功
+};
+
+namespace {
+
+struct CompiledPathKey {
+    std::type_index sourceType;
+    std::string path;
+
+    bool operator==(const CompiledPathKey&) const = default;
+};
+
+struct CompiledPathKeyHash {
+    std::size_t operator()(const CompiledPathKey& key) const noexcept {
+        return key.sourceType.hash_code() ^ (std::hash<std::string>{}(key.path) * 31);
+    }
+};
+
+// 按 (源类型, 路径) 共享编译结果，大量绑定同一路径的单元格只编译一次
+struct CompiledPathCache {
+    std::unordered_map<CompiledPathKey, std::shared_ptr<const void>, CompiledPathKeyHash> entries;
+    std::mutex mutex;
+};
+
+CompiledPathCache& GetCompiledPathCache() {
+    static CompiledPathCache cache;
+    return cache;
+}
+
+} // namespace
+
 BindingPath::BindingPath(std::string path)
     : raw_(std::move(path))
     , segments_(Parse(raw_)) {}
 
+bool BindingPath::ResolveSegment(const Segment& segment, const std::any& current, std::any& next) const {
+    if (segment.kind == Segment::Kind::Property) {
+        const auto* accessor = PropertyAccessorRegistry::FindAccessor(std::type_index(current.type()), segment.name);
+        return accessor && accessor->CanGet() && accessor->Get(current, next);
+    }
+    const auto* element = TryGetIndexed(current, segment.index);
+    if (!element) {
+        return false;
+    }
+    next = *element;
+    return true;
+}
+
 bool BindingPath::Resolve(const std::any& source, std::any& result) const {
     if (segments_.empty()) {
         result = source;
         return true;
     }
 
-    std::any current = source;
+    if (!source.has_value()) {
+        return false;
+    }
 
-    for (const auto& segment : segments_) {
-        if (!current.has_value()) {
+    // 查找 (源类型, 路径) 的编译结果；没有或上次未能完整编译时重新编译
+    if (!compiled_ || compiled_->steps.empty() || *compiled_->steps.front().type != source.type()) {
+        auto& cache = GetCompiledPathCache();
+        std::lock_guard lock(cache.mutex);
+        auto it = cache.entries.find(CompiledPathKey{std::type_index(source.type()), raw_});
+        compiled_ = it != cache.entries.end()
+            ? std::static_pointer_cast<const CompiledPath>(it->second)
+            : nullptr;
+    }
+    if (!compiled_) {
+        return CompileAndResolve(source, result);
+    }
+
+    const auto& steps = compiled_->steps;
+    const std::any* current = &source;
+    std::any buffer;
+    std::any next;
+    for (std::size_t i = 0; i < segments_.size(); ++i) {
+        if (!current->has_value()) {
             return false;
         }
 
-        if (segment.kind == Segment::Kind::Property) {
-            const auto type = std::type_index(current.type());
-            const auto* accessor = PropertyAccessorRegistry::FindAccessor(type, segment.name);
-            if (!accessor || !accessor->getter) {
+        if (i == steps.size()) {
+            // 上次编译在这里中断（例如中间值为空），现在可以继续解析，重新编译整条路径
+            return CompileAndResolve(source, result);
+        }
+
+        const auto& step = steps[i];
+        if (current->type() != *step.type) {
+            // 中间值类型与编译时不同（getter 返回了多态的值），该段按名称查找
+            if (!ResolveSegment(segments_[i], *current, next)) {
                 return false;
             }
-
-            std::any nextValue;
-            if (!accessor->getter(current, nextValue)) {
+        } else if (step.accessor) {
+            if (!step.accessor->Get(*current, next)) {
                 return false;
             }
-
-            current = std::move(nextValue);
         } else {
-            if (const auto* vectorPtr = std::any_cast<const std::vector<std::any>>(&current)) {
-                if (segment.index >= vectorPtr->size()) {
-                    return false;
-                }
-                current = (*vectorPtr)[segment.index];
-            } else if (const auto* vectorPtr = std::any_cast<std::vector<std::any>>(&current)) {
-                if (segment.index >= vectorPtr->size()) {
-                    return false;
-                }
-                current = (*vectorPtr)[segment.index];
-            } else {
+            const auto* element = TryGetIndexed(*current, segments_[i].index);
+            if (!element) {
                 return false;
             }
+            next = *element;
         }
+
+        buffer = std::move(next);
+        current = &buffer;
     }
 
-    result = current;
+    result = std::move(buffer);
+    return true;
+}
+
+bool BindingPath::CompileAndResolve(const std::any& source, std::any& result) const {
+    auto compiled = std::make_shared<CompiledPath>();
+    compiled->steps.reserve(segments_.size());
+
+    std::any current = source;
+    bool resolved = true;
+    for (const auto& segment : segments_) {
+        if (!current.has_value()) {
+            resolved = false;
+            break;
+        }
+
+        const PropertyAccessorRegistry::Accessor* accessor = nullptr;
+        if (segment.kind == Segment::Kind::Property) {
+            accessor = PropertyAccessorRegistry::FindAccessor(std::type_index(current.type()), segment.name);
+            if (!accessor || !accessor->CanGet()) {
+                resolved = false;
+                break;
+            }
+        }
+        compiled->steps.push_back({&current.type(), accessor});
+
+        std::any next;
+        if (!ResolveSegment(segment, current, next)) {
+            resolved = false;
+            break;
+        }
+        current = std::move(next);
+    }
+
+    compiled->complete = resolved;
+    if (!compiled->steps.empty()) {
+        // 部分编译的结果同样缓存，以免源暂时为空时每次都重复查找（下次解析时重试）
+        auto& cache = GetCompiledPathCache();
+        std::lock_guard lock(cache.mutex);
+        cache.entries[CompiledPathKey{std::type_index(source.type()), raw_}] = compiled;
+    }
+    compiled_ = std::move(compiled);
+
+    if (!resolved) {
+        return false;
+    }
+    result = std::move(current);
     return true;
 }
 
@@ -0,0 +1,121 @@
+#include "fk/binding/BindingUpdateQueue.h"
+#include "fk/binding/BindingExpression.h"
+
+#include <utility>
+
+namespace fk::binding {
+
+BindingUpdateQueue& BindingUpdateQueue::Instance() {
+    static BindingUpdateQueue instance;
+    return instance;
+}
+
+void BindingUpdateQueue::SetDispatcher(std::shared_ptr<core::Dispatcher> dispatcher) {
+    bool schedule = false;
+    {
+        std::lock_guard lock(mutex_);
+        dispatcher_ = dispatcher;
+        // 更换调度器后原先投递的刷新任务可能不会再执行
+        flushScheduled_ = false;
+        if (dispatcher && !pending_.empty()) {
+            flushScheduled_ = true;
+            schedule = true;
+        }
+    }
+    if (schedule) {
+        dispatcher->Post([this]() { Flush(); }, GetPriority());
+    }
+}
+
+std::shared_ptr<core::Dispatcher> BindingUpdateQueue::GetDispatcher() const {
+    std::lock_guard lock(mutex_);
+    return dispatcher_.lock();
+}
+
+void BindingUpdateQueue::SetPriority(core::Dispatcher::Priority priority) {
+    std::lock_guard lock(mutex_);
+    priority_ = priority;
+}
+
+core::Dispatcher::Priority BindingUpdateQueue::GetPriority() const {
+    std::lock_guard lock(mutex_);
+    return priority_;
+}
+
+bool BindingUpdateQueue::HasThreadAccess() const {
+    auto dispatcher = GetDispatcher();
+    return !dispatcher || dispatcher->HasThreadAccess();
+}
+
+void BindingUpdateQueue::EnqueueTargetUpdate(const std::shared_ptr<BindingExpression>& expression) {
+    if (expression && !expression->hasPendingTargetUpdate_.exchange(true, std::memory_order_acq_rel)) {
+        Enqueue(expression, true);
+    }
+}
+
+void BindingUpdateQueue::EnqueueSourceUpdate(const std::shared_ptr<BindingExpression>& expression) {
+    if (expression && !expression->hasPendingSourceUpdate_.exchange(true, std::memory_order_acq_rel)) {
+        Enqueue(expression, false);
+    }
+}
+
+void BindingUpdateQueue::Enqueue(const std::shared_ptr<BindingExpression>& expression, bool updateTarget) {
+    std::shared_ptr<core::Dispatcher> dispatcher;
+    core::Dispatcher::Priority priority = core::Dispatcher::Priority::Normal;
+    {
+        std::lock_guard lock(mutex_);
+        pending_.push_back(PendingUpdate{expression, updateTarget});
+        pendingCount_.store(pending_.size(), std::memory_order_release);
+
+        // 每批更新只投递一次刷新任务
+        if (!flushScheduled_) {
+            dispatcher = dispatcher_.lock();
+            if (dispatcher) {
+                flushScheduled_ = true;
+                priority = priority_;
+            }
+        }
+    }
+    if (dispatcher) {
+        dispatcher->Post([this]() { Flush(); }, priority);
+    }
+}
+
+std::size_t BindingUpdateQueue::Flush() {
+    std::vector<PendingUpdate> batch;
+    {
+        std::lock_guard lock(mutex_);
+        batch.swap(pending_);
+        pendingCount_.store(0, std::memory_order_release);
+        flushScheduled_ = false;
+    }
+
+    std::size_t executed = 0;
+    for (auto& update : batch) {
+        auto expression = update.expression.lock();
+        if (!expression) {
+            continue;
+        }
+        // 先清除标记：更新过程中再次变化的值进入下一批
+        if (update.updateTarget) {
+            expression->hasPendingTargetUpdate_.store(false, std::memory_order_release);
+            expression->UpdateTarget();
+        } else {
+            expression->hasPendingSourceUpdate_.store(false, std::memory_order_release);
+            expression->UpdateSource();
+        }
+        ++executed;
+    }
+
+    // 归还缓冲区，下一帧入队时不必重新分配
+    batch.clear();
+    {
+        std::lock_guard lock(mutex_);
+        if (pending_.empty() && pending_.capacity() < batch.capacity()) {
+            pending_.swap(batch);
+        }
+    }
+    return executed;
+}
+
+} // namespace fk::binding
@@ -33,6 +33,8 @@ const std::any& DependencyObject::GetValue(const DependencyProperty& property) c
 
 void DependencyObject::SetValue(const DependencyProperty& property, std::any value) {
     ValidateValue(property, value);
+    // 同类型对象共享属性索引表
+    propertyStore_.BindOwnerType(typeid(*this));
     propertyStore_.SetValue(property, std::move(value), ValueSource::Local);
 }
 
@@ -60,6 +62,7 @@ void DependencyObject::SetBinding(const DependencyProperty& property, const Bind
         current->Detach();
     }
 
+    propertyStore_.BindOwnerType(typeid(*this));
     propertyStore_.SetBinding(property, expression);
 
     if (expression) {
@@ -240,14 +243,7 @@ void DependencyObject::ValidateValue(const DependencyProperty& property, const s
         return;
     }
 
-    const auto expectedType = property.PropertyType();
-    const auto actualType = std::type_index(value.type());
-
-    if (expectedType != actualType && expectedType != std::type_index(typeid(std::any))) {
-        std::ostringstream oss;
-        oss << "Value type mismatch for property '" << property.Name() << "'";
-        throw std::invalid_argument(oss.str());
-    }
+    ValidateValueType(property, value.type());
 
     if (const auto& validate = property.Metadata().validateCallback) {
         if (!validate(value)) {
@@ -258,6 +254,17 @@ void DependencyObject::ValidateValue(const DependencyProperty& property, const s
     }
 }
 
+void DependencyObject::ValidateValueType(const DependencyProperty& property, const std::type_info& type) {
+    const auto expectedType = property.PropertyType();
+    const auto actualType = std::type_index(type);
+
+    if (expectedType != actualType && expectedType != std::type_index(typeid(std::any))) {
+        std::ostringstream oss;
+        oss << "Value type mismatch for property '" << property.Name() << "'";
+        throw std::invalid_argument(oss.str());
+    }
+}
+
 const DependencyProperty* DependencyObject::FindProperty(const std::string& propertyName) const {
     // 使用 Registry 通过对象的实际类型查找属性
     // 这样就不需要在每个派生类中手动重写 FindProperty 了
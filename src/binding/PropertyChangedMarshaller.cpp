@@ -0,0 +1,208 @@
+#include "fk/binding/PropertyChangedMarshaller.h"
+#include "fk/binding/INotifyPropertyChanged.h"
+
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace fk::binding {
+
+namespace {
+
+// 可在生产者端合并的属性编号上限（PropertyChangedTarget::pendingProperties 的位数）
+constexpr std::uint32_t kCollapsibleProperties = 64;
+
+struct NameHash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+};
+
+using NameIdMap = std::unordered_map<std::string, std::uint32_t, NameHash, std::equal_to<>>;
+
+} // namespace
+
+/**
+ * @brief 一个对象类型的属性名 → 编号表
+ *
+ * 编号只在同一类型内唯一，整个程序的属性名再多，每个类型的前 64 个属性都能在生产者端合并。
+ */
+struct PropertyIdTable {
+    std::mutex mutex;
+    NameIdMap ids;
+};
+
+namespace {
+
+PropertyIdTable& PropertyIdTableFor(std::type_index type) {
+    static std::mutex mutex;
+    static std::unordered_map<std::type_index, std::unique_ptr<PropertyIdTable>> tables;
+
+    std::lock_guard lock(mutex);
+    auto& table = tables[type];
+    if (!table) {
+        table = std::make_unique<PropertyIdTable>();
+    }
+    return *table;
+}
+
+/**
+ * @brief 属性名 → 编号（类型内唯一）
+ *
+ * 每个线程缓存查询结果，只有第一次遇到某个（类型，属性名）时才获取表的锁。
+ */
+std::uint32_t InternPropertyName(PropertyIdTable& table, std::string_view name) {
+    thread_local std::unordered_map<const PropertyIdTable*, NameIdMap> cache;
+    auto& names = cache[&table];
+    if (auto it = names.find(name); it != names.end()) {
+        return it->second;
+    }
+
+    std::uint32_t id = 0;
+    {
+        std::lock_guard lock(table.mutex);
+        auto it = table.ids.find(name);
+        if (it == table.ids.end()) {
+            it = table.ids.emplace(std::string(name), static_cast<std::uint32_t>(table.ids.size())).first;
+        }
+        id = it->second;
+    }
+    names.emplace(std::string(name), id);
+    return id;
+}
+
+// 弱引用是否曾指向某个对象（区分"对象不由 shared_ptr 持有"与"对象已销毁"）
+bool HasOwnership(const std::weak_ptr<INotifyPropertyChanged>& lifetime) {
+    const std::weak_ptr<INotifyPropertyChanged> empty;
+    return lifetime.owner_before(empty) || empty.owner_before(lifetime);
+}
+
+struct NotificationKey {
+    const PropertyChangedTarget* target;
+    std::string_view propertyName;
+
+    bool operator==(const NotificationKey&) const = default;
+};
+
+struct NotificationKeyHash {
+    std::size_t operator()(const NotificationKey& key) const noexcept {
+        const std::size_t h1 = std::hash<const void*>{}(key.target);
+        const std::size_t h2 = std::hash<std::string_view>{}(key.propertyName);
+        return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
+    }
+};
+
+} // namespace
+
+PropertyChangedMarshaller& PropertyChangedMarshaller::Instance() {
+    static PropertyChangedMarshaller instance;
+    return instance;
+}
+
+void PropertyChangedMarshaller::SetDispatcher(std::shared_ptr<core::Dispatcher> dispatcher) {
+    {
+        std::lock_guard lock(dispatcherMutex_);
+        dispatcher_ = dispatcher;
+        uiDispatcher_.store(dispatcher.get(), std::memory_order_release);
+    }
+    // 更换调度器后原先投递的任务可能不会再执行
+    flushScheduled_.store(false, std::memory_order_release);
+    if (dispatcher && HasPendingNotifications() && !flushScheduled_.exchange(true, std::memory_order_acq_rel)) {
+        ScheduleFlush();
+    }
+}
+
+std::shared_ptr<core::Dispatcher> PropertyChangedMarshaller::GetDispatcher() const {
+    std::lock_guard lock(dispatcherMutex_);
+    return dispatcher_.lock();
+}
+
+bool PropertyChangedMarshaller::HasThreadAccess() const {
+    auto* dispatcher = uiDispatcher_.load(std::memory_order_acquire);
+    return dispatcher == nullptr || dispatcher->HasThreadAccess();
+}
+
+void PropertyChangedMarshaller::Post(const std::shared_ptr<PropertyChangedTarget>& target, std::string_view propertyName,
+                                     std::weak_ptr<INotifyPropertyChanged> lifetime) {
+    if (!target) {
+        return;
+    }
+    auto* owner = target->owner.load(std::memory_order_acquire);
+    if (!owner) {
+        return;
+    }
+
+    // 调用方正在通知，对象已构造完成，typeid 得到动态类型；并发写入的都是同一张表
+    auto* table = target->propertyIds.load(std::memory_order_acquire);
+    if (!table) {
+        table = &PropertyIdTableFor(typeid(*owner));
+        target->propertyIds.store(table, std::memory_order_release);
+    }
+
+    const std::uint32_t id = InternPropertyName(*table, propertyName);
+    if (id < kCollapsibleProperties) {
+        const std::uint64_t bit = std::uint64_t{1} << id;
+        // 同一属性已在队列中：处理时会读取最新值，无需再次入队
+        if (target->pendingProperties.fetch_or(bit, std::memory_order_acq_rel) & bit) {
+            return;
+        }
+    }
+
+    queue_.Push(Notification{target, std::move(lifetime), id, std::string(propertyName)});
+    // 每批通知只投递一次处理任务
+    if (!flushScheduled_.exchange(true, std::memory_order_acq_rel)) {
+        ScheduleFlush();
+    }
+}
+
+void PropertyChangedMarshaller::ScheduleFlush() {
+    if (auto dispatcher = GetDispatcher()) {
+        dispatcher->Post([this]() { Flush(); });
+    } else {
+        // 没有调度器：等待手动 Flush
+        flushScheduled_.store(false, std::memory_order_release);
+    }
+}
+
+std::size_t PropertyChangedMarshaller::Flush() {
+    // 先清除标记（获取语义保证能看到设置标记的生产者入队的通知），之后入队的通知会重新调度
+    flushScheduled_.exchange(false, std::memory_order_acq_rel);
+
+    std::vector<Notification> batch;
+    while (auto notification = queue_.TryPop()) {
+        batch.push_back(std::move(*notification));
+    }
+    if (batch.empty()) {
+        return 0;
+    }
+
+    // 编号超出位集合的属性无法在生产者端合并，在这里去重
+    std::unordered_set<NotificationKey, NotificationKeyHash> delivered;
+    std::size_t raised = 0;
+    for (const auto& notification : batch) {
+        auto target = notification.target.lock();
+        if (!target) {
+            continue;
+        }
+        if (notification.propertyId < kCollapsibleProperties) {
+            // 先清除标记：通知过程中再次变化的值会重新入队
+            target->pendingProperties.fetch_and(~(std::uint64_t{1} << notification.propertyId), std::memory_order_acq_rel);
+        } else if (!delivered.insert(NotificationKey{target.get(), notification.propertyName}).second) {
+            continue;
+        }
+        // 投递期间持有强引用，其他线程释放最后一个引用时对象不会在处理函数中途析构
+        const auto alive = notification.lifetime.lock();
+        if (!alive && HasOwnership(notification.lifetime)) {
+            continue;
+        }
+        if (auto* owner = target->owner.load(std::memory_order_acquire)) {
+            owner->PropertyChanged()(notification.propertyName);
+            ++raised;
+        }
+    }
+    return raised;
+}
+
+} // namespace fk::binding
@@ -1,12 +1,101 @@
 #include "fk/binding/PropertyStore.h"
 
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
-#include <iostream>
 
 namespace fk::binding {
 
+namespace {
+
+bool AreEquivalent(const std::any& lhs, const std::any& rhs) {
+    if (!lhs.has_value() && !rhs.has_value()) {
+        return true;
+    }
+    if (lhs.type() != rhs.type()) {
+        return false;
+    }
+    if (lhs.has_value()) {
+        if (lhs.type() == typeid(int)) {
+            return std::any_cast<int>(lhs) == std::any_cast<int>(rhs);
+        }
+        if (lhs.type() == typeid(bool)) {
+            return std::any_cast<bool>(lhs) == std::any_cast<bool>(rhs);
+        }
+        if (lhs.type() == typeid(double)) {
+            return std::any_cast<double>(lhs) == std::any_cast<double>(rhs);
+        }
+        if (lhs.type() == typeid(std::string)) {
+            return std::any_cast<std::string>(lhs) == std::any_cast<std::string>(rhs);
+        }
+        if (lhs.type() == typeid(float)) {
+            return std::any_cast<float>(lhs) == std::any_cast<float>(rhs);
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ========== PropertyValue ==========
+
+PropertyValue::PropertyValue(std::any value)
+    : type_(value.has_value() ? &value.type() : nullptr)
+    , boxedValid_(true)
+    , boxed_(std::move(value)) {
+}
+
+const std::any& PropertyValue::AsAny() const {
+    if (!boxedValid_) {
+        boxed_ = box_(storage_);
+        boxedValid_ = true;
+    }
+    return boxed_;
+}
+
+bool PropertyValue::Equals(const PropertyValue& other) const {
+    if (!type_ || !other.type_) {
+        return !type_ && !other.type_;
+    }
+    if (*type_ != *other.type_) {
+        return false;
+    }
+    if (isInline_ && other.isInline_) {
+        return equals_(storage_, other.storage_);
+    }
+    return AreEquivalent(AsAny(), other.AsAny());
+}
+
+// ========== PropertyIndexTable ==========
+
+PropertyIndexTable& PropertyIndexTable::ForType(std::type_index type) {
+    static std::mutex mutex;
+    static std::unordered_map<std::type_index, std::unique_ptr<PropertyIndexTable>> tables;
+
+    std::lock_guard lock(mutex);
+    auto& table = tables[type];
+    if (!table) {
+        table = std::make_unique<PropertyIndexTable>(type);
+    }
+    return *table;
+}
+
+int PropertyIndexTable::GetOrAdd(std::size_t propertyId) {
+    if (propertyId >= slots_.size()) {
+        slots_.resize(propertyId + 1, -1);
+    }
+    auto& slot = slots_[propertyId];
+    if (slot < 0) {
+        slot = static_cast<std::int16_t>(slotCount_++);
+        propertyIds_.push_back(propertyId);
+    }
+    return slot;
+}
+
+// ========== PropertyStore ==========
+
 PropertyStore::PropertyStore() = default;
 
 PropertyStore::PropertyStore(ValueChangedCallback callback)
@@ -14,10 +103,11 @@ PropertyStore::PropertyStore(ValueChangedCallback callback)
 
 const std::any& PropertyStore::GetValue(const DependencyProperty& property) const {
     const auto* entry = FindEntry(property);
-    if (!entry || !entry->hasEffective) {
+    const auto* value = entry ? EffectiveLayer(*entry) : nullptr;
+    if (!value || !value->HasValue()) {
         return property.Metadata().defaultValue;
     }
-    return entry->effectiveValue;
+    return value->AsAny();
 }
 
 ValueSource PropertyStore::GetValueSource(const DependencyProperty& property) const {
@@ -26,53 +116,71 @@ ValueSource PropertyStore::GetValueSource(const DependencyProperty& property) co
 }
 
 void PropertyStore::SetValue(const DependencyProperty& property, std::any value, ValueSource source) {
+    SetValue(property, PropertyValue(std::move(value)), source);
+}
+
+void PropertyStore::SetValue(const DependencyProperty& property, PropertyValue value, ValueSource source) {
     if (source == ValueSource::Binding) {
         throw std::invalid_argument("Use SetBinding to assign binding values");
     }
     auto& entry = EnsureEntry(property);
     auto& layer = SelectLayer(entry, source);
-    layer.hasValue = true;
-    layer.value = std::move(value);
-    UpdateEffectiveValue(property, entry);
+
+    const auto oldSource = entry.effectiveSource;
+    PropertyValue oldValue = std::exchange(layer, std::move(value));
+    if (oldSource != source) {
+        // 被覆盖的层不是有效层，旧的有效值仍在原层中
+        const auto* effective = EffectiveLayer(entry);
+        oldValue = effective ? *effective : PropertyValue();
+    }
+    entry.layerMask |= LayerBit(source);
+    UpdateEffectiveValue(property, entry, oldValue, oldSource);
 }
 
 void PropertyStore::ClearValue(const DependencyProperty& property, ValueSource source) {
     auto* entry = FindEntry(property);
-    if (!entry) {
+    if (!entry || !(entry->layerMask & LayerBit(source))) {
         return;
     }
 
-    auto& layer = SelectLayer(*entry, source);
-    const bool hadValue = layer.hasValue;
-    layer.hasValue = false;
-    layer.value.reset();
+    const auto oldSource = entry->effectiveSource;
+    const auto* effective = EffectiveLayer(*entry);
+    PropertyValue oldValue = effective ? *effective : PropertyValue();
 
-    if (!hadValue) {
-        return;
-    }
+    SelectLayer(*entry, source) = PropertyValue();
+    entry->layerMask &= static_cast<std::uint8_t>(~LayerBit(source));
 
-    UpdateEffectiveValue(property, *entry);
+    UpdateEffectiveValue(property, *entry, oldValue, oldSource);
 
-    if (!EntryHasAnyValue(*entry) && !entry->bindingExpression) {
-        entries_.erase(property.Id());
+    // 回调中可能修改了存储，重新查找
+    entry = FindEntry(property);
+    if (entry && entry->layerMask == 0 && !(entry->extra && entry->extra->bindingExpression)) {
+        EraseEntry(property);
     }
 }
 
 void PropertyStore::SetBinding(const DependencyProperty& property, std::shared_ptr<BindingExpression> binding) {
     auto& entry = EnsureEntry(property);
-    entry.bindingExpression = std::move(binding);
-    auto& layer = entry.binding;
-    layer.hasValue = false;
-    layer.value.reset();
-    UpdateEffectiveValue(property, entry);
+    if (!entry.extra) {
+        entry.extra = std::make_unique<ExtraLayers>();
+    }
+
+    const auto oldSource = entry.effectiveSource;
+    const auto* effective = EffectiveLayer(entry);
+    PropertyValue oldValue = effective ? *effective : PropertyValue();
+
+    entry.extra->bindingExpression = std::move(binding);
+    entry.extra->binding = PropertyValue();
+    entry.layerMask &= static_cast<std::uint8_t>(~LayerBit(ValueSource::Binding));
+    UpdateEffectiveValue(property, entry, oldValue, oldSource);
 }
 
 std::shared_ptr<BindingExpression> PropertyStore::GetBinding(const DependencyProperty& property) const {
     const auto* entry = FindEntry(property);
-    if (!entry) {
+    if (!entry || !entry->extra) {
         return nullptr;
     }
-    return entry->bindingExpression;
+    return entry->extra->bindingExpression;
 }
 
 void PropertyStore::ClearBinding(const DependencyProperty& property) {
@@ -80,25 +188,43 @@ void PropertyStore::ClearBinding(const DependencyProperty& property) {
     if (!entry) {
         return;
     }
-    entry->bindingExpression.reset();
-    entry->binding.hasValue = false;
-    entry->binding.value.reset();
-    UpdateEffectiveValue(property, *entry);
-    if (!EntryHasAnyValue(*entry) && !entry->bindingExpression) {
-        entries_.erase(property.Id());
+
+    const auto oldSource = entry->effectiveSource;
+    const auto* effective = EffectiveLayer(*entry);
+    PropertyValue oldValue = effective ? *effective : PropertyValue();
+
+    if (entry->extra) {
+        entry->extra->bindingExpression.reset();
+        entry->extra->binding = PropertyValue();
+    }
+    entry->layerMask &= static_cast<std::uint8_t>(~LayerBit(ValueSource::Binding));
+    UpdateEffectiveValue(property, *entry, oldValue, oldSource);
+
+    entry = FindEntry(property);
+    if (entry && entry->layerMask == 0 && !(entry->extra && entry->extra->bindingExpression)) {
+        EraseEntry(property);
     }
 }
 
 void PropertyStore::ApplyBindingValue(const DependencyProperty& property, std::any value) {
     auto& entry = EnsureEntry(property);
-    entry.binding.hasValue = true;
-    entry.binding.value = std::move(value);
-    UpdateEffectiveValue(property, entry);
+
+    const auto oldSource = entry.effectiveSource;
+    const auto* effective = EffectiveLayer(entry);
+    PropertyValue oldValue = effective ? *effective : PropertyValue();
+
+    SelectLayer(entry, ValueSource::Binding) = PropertyValue(std::move(value));
+    entry.layerMask |= LayerBit(ValueSource::Binding);
+    UpdateEffectiveValue(property, entry, oldValue, oldSource);
 }
 
 bool PropertyStore::HasValue(const DependencyProperty& property) const {
     const auto* entry = FindEntry(property);
-    return entry && (entry->hasEffective || EntryHasAnyValue(*entry));
+    if (!entry) {
+        return false;
+    }
+    const auto* effective = EffectiveLayer(*entry);
+    return (effective && effective->HasValue()) || entry->layerMask != 0;
 }
 
 void PropertyStore::ClearAll() {
@@ -109,153 +235,118 @@ void PropertyStore::SetValueChangedCallback(ValueChangedCallback callback) {
     valueChangedCallback_ = std::move(callback);
 }
 
-PropertyStore::PropertyEntry& PropertyStore::EnsureEntry(const DependencyProperty& property) {
-    auto [it, inserted] = entries_.try_emplace(property.Id());
-    if (inserted) {
-        it->second.effectiveSource = ValueSource::Default;
-        it->second.hasEffective = false;
+void PropertyStore::RebindTable(std::type_index type) {
+    PropertyIndexTable& table = PropertyIndexTable::ForType(type);
+    if (table_ && !entries_.empty()) {
+        // 条目按属性 Id 重新编号，条目本身只移动所有权，地址不变
+        std::vector<std::unique_ptr<PropertyEntry>> entries;
+        for (std::size_t slot = 0; slot < entries_.size(); ++slot) {
+            if (!entries_[slot]) {
+                continue;
+            }
+            const auto newSlot = static_cast<std::size_t>(table.GetOrAdd(table_->GetPropertyId(slot)));
+            if (newSlot >= entries.size()) {
+                entries.resize(newSlot + 1);
+            }
+            entries[newSlot] = std::move(entries_[slot]);
+        }
+        entries_ = std::move(entries);
     }
-    return it->second;
+    table_ = &table;
 }
 
-PropertyStore::PropertyEntry* PropertyStore::FindEntry(const DependencyProperty& property) {
-    auto it = entries_.find(property.Id());
-    if (it == entries_.end()) {
-        return nullptr;
+PropertyStore::PropertyEntry& PropertyStore::EnsureEntry(const DependencyProperty& property) {
+    if (!table_) {
+        table_ = &PropertyIndexTable::ForType(typeid(void));
+    }
+    const auto slot = static_cast<std::size_t>(table_->GetOrAdd(property.Id()));
+    if (slot >= entries_.size()) {
+        entries_.resize(std::max(slot + 1, table_->GetSlotCount()));
     }
-    return &it->second;
+    auto& entry = entries_[slot];
+    if (!entry) {
+        entry = std::make_unique<PropertyEntry>();
+    }
+    return *entry;
 }
 
-const PropertyStore::PropertyEntry* PropertyStore::FindEntry(const DependencyProperty& property) const {
-    auto it = entries_.find(property.Id());
-    if (it == entries_.end()) {
-        return nullptr;
+void PropertyStore::EraseEntry(const DependencyProperty& property) {
+    const int slot = table_ ? table_->Find(property.Id()) : -1;
+    if (slot >= 0 && static_cast<std::size_t>(slot) < entries_.size()) {
+        entries_[static_cast<std::size_t>(slot)].reset();
     }
-    return &it->second;
 }
 
-void PropertyStore::UpdateEffectiveValue(const DependencyProperty& property, PropertyEntry& entry) {
-    const auto oldSource = entry.effectiveSource;
-    const std::any oldValue = entry.hasEffective ? entry.effectiveValue : property.Metadata().defaultValue;
-
+void PropertyStore::UpdateEffectiveValue(const DependencyProperty& property, PropertyEntry& entry,
+                                         const PropertyValue& oldValue, ValueSource oldSource) {
     const auto newSource = DetermineEffectiveSource(entry);
-    const std::any* layerValue = nullptr;
-    if (newSource == ValueSource::Default) {
-        layerValue = &property.Metadata().defaultValue;
-    } else {
-        layerValue = TryGetLayerValue(entry, newSource);
-    }
+    entry.effectiveSource = newSource;
 
-    const bool hasNewValue = layerValue && layerValue->has_value();
+    const auto* newValue = EffectiveLayer(entry);
+    const bool oldHasValue = oldSource != ValueSource::Default && oldValue.HasValue();
+    const bool newHasValue = newValue && newValue->HasValue();
 
-    if (hasNewValue) {
-        entry.effectiveValue = *layerValue;
-    } else {
-        entry.effectiveValue.reset();
+    if (oldSource == newSource) {
+        // 来源未变时只比较值；两侧都回落到默认值视为未变化
+        if (!oldHasValue && !newHasValue) {
+            return;
+        }
+        if (oldHasValue && newHasValue && oldValue.Equals(*newValue)) {
+            return;
+        }
     }
 
-    entry.hasEffective = hasNewValue;
-    entry.effectiveSource = newSource;
+    if (!valueChangedCallback_) {
+        return;
+    }
 
-    const std::any& newValueRef = entry.hasEffective ? entry.effectiveValue : property.Metadata().defaultValue;
+    // oldValue 是调用方持有的快照，回调期间保持有效，不需要再复制一份 std::any
+    const std::any& defaultValue = property.Metadata().defaultValue;
+    const std::any& oldAny = oldHasValue ? oldValue.AsAny() : defaultValue;
+    const std::any& newAny = newHasValue ? newValue->AsAny() : defaultValue;
 
-    if (!AreEquivalent(oldValue, newValueRef) || oldSource != newSource) {
-        if (valueChangedCallback_) {
-            valueChangedCallback_(property, oldValue, newValueRef, oldSource, newSource);
-        }
+    // 只有一侧回落到默认值时，才需要把它与另一侧比较
+    if (oldSource == newSource && oldHasValue != newHasValue && AreEquivalent(oldAny, newAny)) {
+        return;
     }
+    valueChangedCallback_(property, oldAny, newAny, oldSource, newSource);
 }
 
-PropertyStore::Layer& PropertyStore::SelectLayer(PropertyEntry& entry, ValueSource source) {
-    switch (source) {
-    case ValueSource::Local:
+PropertyValue& PropertyStore::SelectLayer(PropertyEntry& entry, ValueSource source) {
+    if (source == ValueSource::Local) {
         return entry.local;
-    case ValueSource::Binding:
-        return entry.binding;
-    case ValueSource::Style:
-        return entry.style;
-    case ValueSource::Inherited:
-        return entry.inherited;
-    default:
+    }
+    if (source == ValueSource::Default) {
         throw std::invalid_argument("ValueSource::Default cannot be written to");
     }
-}
-
-const PropertyStore::Layer& PropertyStore::SelectLayer(const PropertyEntry& entry, ValueSource source) {
+    if (!entry.extra) {
+        entry.extra = std::make_unique<ExtraLayers>();
+    }
     switch (source) {
-    case ValueSource::Local:
-        return entry.local;
     case ValueSource::Binding:
-        return entry.binding;
+        return entry.extra->binding;
     case ValueSource::Style:
-        return entry.style;
-    case ValueSource::Inherited:
-        return entry.inherited;
+        return entry.extra->style;
     default:
-        throw std::invalid_argument("ValueSource::Default cannot be selected for reading as a layer");
-    }
-}
-
-bool PropertyStore::AreEquivalent(const std::any& lhs, const std::any& rhs) {
-    if (!lhs.has_value() && !rhs.has_value()) {
-        return true;
-    }
-    if (lhs.type() != rhs.type()) {
-        return false;
-    }
-    if (lhs.has_value()) {
-        if (lhs.type() == typeid(int)) {
-            return std::any_cast<int>(lhs) == std::any_cast<int>(rhs);
-        }
-        if (lhs.type() == typeid(bool)) {
-            return std::any_cast<bool>(lhs) == std::any_cast<bool>(rhs);
-        }
-        if (lhs.type() == typeid(double)) {
-            return std::any_cast<double>(lhs) == std::any_cast<double>(rhs);
-        }
-        if (lhs.type() == typeid(std::string)) {
-            return std::any_cast<std::string>(lhs) == std::any_cast<std::string>(rhs);
-        }
-        if (lhs.type() == typeid(float)) {
-            return std::any_cast<float>(lhs) == std::any_cast<float>(rhs);
-        }
+        return entry.extra->inherited;
     }
-    return false;
-}
-
-bool PropertyStore::EntryHasAnyValue(const PropertyEntry& entry) {
-    return entry.local.hasValue || entry.binding.hasValue || entry.style.hasValue || entry.inherited.hasValue;
 }
 
 ValueSource PropertyStore::DetermineEffectiveSource(const PropertyEntry& entry) {
-    if (entry.local.hasValue) {
+    const auto mask = entry.layerMask;
+    if (mask & LayerBit(ValueSource::Local)) {
         return ValueSource::Local;
     }
-    if (entry.binding.hasValue) {
+    if (mask & LayerBit(ValueSource::Binding)) {
         return ValueSource::Binding;
     }
-    if (entry.style.hasValue) {
+    if (mask & LayerBit(ValueSource::Style)) {
         return ValueSource::Style;
     }
-    if (entry.inherited.hasValue) {
+    if (mask & LayerBit(ValueSource::Inherited)) {
         return ValueSource::Inherited;
     }
     return ValueSource::Default;
 }
 
-const std::any* PropertyStore::TryGetLayerValue(const PropertyEntry& entry, ValueSource source) {
-    switch (source) {
-    case ValueSource::Local:
-        return entry.local.hasValue ? &entry.local.value : nullptr;
-    case ValueSource::Binding:
-        return entry.binding.hasValue ? &entry.binding.value : nullptr;
-    case ValueSource::Style:
-        return entry.style.hasValue ? &entry.style.value : nullptr;
-    case ValueSource::Inherited:
-        return entry.inherited.hasValue ? &entry.inherited.value : nullptr;
-    default:
-        return nullptr;
-    }
-}
-
 } // namespace fk::binding
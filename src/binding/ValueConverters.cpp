@@ -312,94 +312,144 @@ std::string ToString(const std::any& value) {
     return std::string("<") + value.type().name() + ">";
 }
 
-} // namespace
+// ========== 按目标类型划分的默认转换函数 ==========
 
-bool TryDefaultConvert(const std::any& value, std::type_index targetType, std::any& outResult) {
-    if (!value.has_value()) {
-        outResult.reset();
+bool ConvertCopy(const std::any& value, std::any& outResult) {
+    outResult = value;
+    return true;
+}
+
+bool ConvertToString(const std::any& value, std::any& outResult) {
+    outResult = ToString(value);
+    return true;
+}
+
+bool ConvertToBool(const std::any& value, std::any& outResult) {
+    bool result = false;
+    if (TryGetBool(value, result)) {
+        outResult = result;
         return true;
     }
+    return false;
+}
 
-    if (targetType == std::type_index(value.type())) {
-        outResult = value;
+bool ConvertToInt(const std::any& value, std::any& outResult) {
+    std::int64_t temp = 0;
+    if (TryGetInt64(value, temp) &&
+        temp >= std::numeric_limits<int>::min() &&
+        temp <= std::numeric_limits<int>::max()) {
+        outResult = static_cast<int>(temp);
         return true;
     }
+    return false;
+}
 
-    if (targetType == std::type_index(typeid(std::string))) {
-        outResult = ToString(value);
+bool ConvertToInt64(const std::any& value, std::any& outResult) {
+    std::int64_t temp = 0;
+    if (TryGetInt64(value, temp)) {
+        outResult = temp;
         return true;
     }
+    return false;
+}
 
-    if (targetType == std::type_index(typeid(bool))) {
-        bool result = false;
-        if (TryGetBool(value, result)) {
-            outResult = result;
-            return true;
-        }
-        return false;
+bool ConvertToUint64(const std::any& value, std::any& outResult) {
+    std::uint64_t temp = 0;
+    if (TryGetUint64(value, temp)) {
+        outResult = temp;
+        return true;
     }
+    return false;
+}
 
-    if (targetType == std::type_index(typeid(int))) {
-        std::int64_t temp = 0;
-        if (TryGetInt64(value, temp) &&
-            temp >= std::numeric_limits<int>::min() &&
-            temp <= std::numeric_limits<int>::max()) {
-            outResult = static_cast<int>(temp);
-            return true;
-        }
-        return false;
+bool ConvertToUint32(const std::any& value, std::any& outResult) {
+    std::uint64_t temp = 0;
+    if (TryGetUint64(value, temp) && temp <= std::numeric_limits<std::uint32_t>::max()) {
+        outResult = static_cast<std::uint32_t>(temp);
+        return true;
     }
+    return false;
+}
 
-    if (targetType == std::type_index(typeid(std::int64_t))) {
-        std::int64_t temp = 0;
-        if (TryGetInt64(value, temp)) {
-            outResult = temp;
-            return true;
+bool ConvertToFloat(const std::any& value, std::any& outResult) {
+    double temp = 0.0;
+    if (TryGetDouble(value, temp)) {
+        if (temp < -std::numeric_limits<float>::max() || temp > std::numeric_limits<float>::max()) {
+            return false;
         }
-        return false;
+        outResult = static_cast<float>(temp);
+        return true;
     }
+    return false;
+}
 
-    if (targetType == std::type_index(typeid(std::uint64_t))) {
-        std::uint64_t temp = 0;
-        if (TryGetUint64(value, temp)) {
-            outResult = temp;
-            return true;
-        }
-        return false;
+bool ConvertToDouble(const std::any& value, std::any& outResult) {
+    double temp = 0.0;
+    if (TryGetDouble(value, temp)) {
+        outResult = temp;
+        return true;
     }
+    return false;
+}
+
+} // namespace
 
+DefaultConverter FindDefaultConverter(std::type_index sourceType, std::type_index targetType) {
+    if (targetType == sourceType) {
+        return &ConvertCopy;
+    }
+    if (targetType == std::type_index(typeid(std::string))) {
+        return &ConvertToString;
+    }
+    if (targetType == std::type_index(typeid(bool))) {
+        return &ConvertToBool;
+    }
+    if (targetType == std::type_index(typeid(int))) {
+        return &ConvertToInt;
+    }
+    if (targetType == std::type_index(typeid(std::int64_t))) {
+        return &ConvertToInt64;
+    }
+    if (targetType == std::type_index(typeid(std::uint64_t))) {
+        return &ConvertToUint64;
+    }
     if (targetType == std::type_index(typeid(std::uint32_t))) {
-        std::uint64_t temp = 0;
-        if (TryGetUint64(value, temp) && temp <= std::numeric_limits<std::uint32_t>::max()) {
-            outResult = static_cast<std::uint32_t>(temp);
-            return true;
-        }
-        return false;
+        return &ConvertToUint32;
     }
-
     if (targetType == std::type_index(typeid(float))) {
-        double temp = 0.0;
-        if (TryGetDouble(value, temp)) {
-            if (temp < -std::numeric_limits<float>::max() || temp > std::numeric_limits<float>::max()) {
-                return false;
-            }
-            outResult = static_cast<float>(temp);
-            return true;
-        }
-        return false;
+        return &ConvertToFloat;
     }
-
     if (targetType == std::type_index(typeid(double))) {
-        double temp = 0.0;
-        if (TryGetDouble(value, temp)) {
-            outResult = temp;
-            return true;
-        }
-        return false;
+        return &ConvertToDouble;
     }
+    // 没有匹配的规则
+    return nullptr;
+}
 
-    // 没有匹配的规则时，返回失败
-    return false;
+bool TryDefaultConvert(const std::any& value, std::type_index targetType, std::any& outResult) {
+    if (!value.has_value()) {
+        outResult.reset();
+        return true;
+    }
+
+    const DefaultConverter converter = FindDefaultConverter(std::type_index(value.type()), targetType);
+    return converter && converter(value, outResult);
+}
+
+bool DefaultConverterCache::Convert(const std::any& value, std::type_index targetType, std::any& outResult) {
+    if (!value.has_value()) {
+        outResult.reset();
+        return true;
+    }
+
+    // 源类型与目标类型都与上次相同时直接使用上次选出的转换函数
+    const std::type_info& sourceType = value.type();
+    if (sourceType_ != &sourceType || targetType_ != targetType) {
+        sourceType_ = &sourceType;
+        targetType_ = targetType;
+        converter_ = FindDefaultConverter(std::type_index(sourceType), targetType);
+    }
+    return converter_ && converter_(value, outResult);
 }
 
 std::any DefaultValueConverter::Convert(const std::any& value, std::type_index targetType, const std::any*) const {
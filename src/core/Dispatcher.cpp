@@ -1,30 +1,152 @@
 #include "fk/core/Dispatcher.h"
+#include "fk/core/MpscQueue.h"
+#include "fk/core/TimingWheel.h"
 
 #include <algorithm>
+#include <array>
+#include <deque>
 #include <exception>
 #include <iostream>
-#include <queue>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace fk::core {
 
 namespace {
 using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t kPriorityCount = 3;
+// 各优先级环形队列容量（High、Normal、Low），满时退回到溢出链表
+constexpr std::size_t kLaneCapacity[kPriorityCount] = {1024, 8192, 1024};
+// 每个投递线程每 N 个任务记录一次就绪时间，用于等待时间统计（读取时钟比入队本身还慢）
+constexpr std::uint32_t kLatencySampleInterval = 64;
+
+bool ShouldSampleLatency() {
+    thread_local std::uint32_t counter = 0;
+    return (counter++ % kLatencySampleInterval) == 0;
+}
+
+/**
+ * @brief 固定大小内存块池（Phase 5.1）
+ *
+ * 每个线程先使用本地缓存，缓存空或满时才以批为单位与全局列表交换，
+ * 因此频繁的 BeginInvoke/PostDelayed 不会每次都经过全局分配器。
+ */
+template<std::size_t Size, std::size_t Align>
+class BlockPool {
+public:
+    static void* Acquire() {
+        auto& local = Local();
+        if (local.blocks.empty()) {
+            Global().Take(local.blocks);
+        }
+        if (local.blocks.empty()) {
+            return ::operator new(Size, std::align_val_t{Align});
+        }
+        void* block = local.blocks.back();
+        local.blocks.pop_back();
+        return block;
+    }
+
+    static void Release(void* block) {
+        auto& local = Local();
+        local.blocks.push_back(block);
+        if (local.blocks.size() >= kLocalLimit) {
+            Global().Give(local.blocks, kBatch);
+        }
+    }
+
+private:
+    static constexpr std::size_t kBatch = 32;
+    static constexpr std::size_t kLocalLimit = kBatch * 2;
+    static constexpr std::size_t kGlobalLimit = 4096;
+
+    struct GlobalList {
+        std::mutex mutex;
+        std::vector<void*> blocks;
+
+        void Take(std::vector<void*>& out) {
+            std::lock_guard lock(mutex);
+            const std::size_t count = std::min(kBatch, blocks.size());
+            out.insert(out.end(), blocks.end() - static_cast<std::ptrdiff_t>(count), blocks.end());
+            blocks.resize(blocks.size() - count);
+        }
+
+        void Give(std::vector<void*>& from, std::size_t count) {
+            count = std::min(count, from.size());
+            std::vector<void*> excess;
+            {
+                std::lock_guard lock(mutex);
+                for (std::size_t i = 0; i < count; ++i) {
+                    if (blocks.size() < kGlobalLimit) {
+                        blocks.push_back(from.back());
+                    } else {
+                        excess.push_back(from.back());
+                    }
+                    from.pop_back();
+                }
+            }
+            for (void* block : excess) {
+                ::operator delete(block, std::align_val_t{Align});
+            }
+        }
+    };
+
+    struct LocalCache {
+        std::vector<void*> blocks;
+        ~LocalCache() { Global().Give(blocks, blocks.size()); }
+    };
+
+    static GlobalList& Global() {
+        // 故意不释放：线程退出时仍可能归还内存块
+        static auto* global = new GlobalList();
+        return *global;
+    }
+
+    static LocalCache& Local() {
+        thread_local LocalCache cache;
+        return cache;
+    }
+};
+
+template<typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(BlockPool<sizeof(T), alignof(T)>::Acquire());
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (n == 1) {
+            BlockPool<sizeof(T), alignof(T)>::Release(p);
+            return;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+};
 } // namespace
 
 namespace detail {
 struct DispatcherOperationState {
     std::atomic<DispatcherOperation::Status> status{DispatcherOperation::Status::Pending};
     std::atomic<bool> canceled{false};
-    std::mutex mutex;
-    std::condition_variable cv;
     std::exception_ptr error{};
 
     bool TryStart() {
         if (canceled.load(std::memory_order_acquire)) {
-            status.store(DispatcherOperation::Status::Canceled, std::memory_order_release);
-            cv.notify_all();
+            MarkCanceled();
             return false;
         }
 
@@ -37,31 +159,95 @@ struct DispatcherOperationState {
 
     void MarkCompleted() {
         status.store(DispatcherOperation::Status::Completed, std::memory_order_release);
-        cv.notify_all();
+        status.notify_all();
     }
 
     void MarkCanceled() {
         status.store(DispatcherOperation::Status::Canceled, std::memory_order_release);
-        cv.notify_all();
+        status.notify_all();
     }
 
     void MarkFaulted(std::exception_ptr ex) {
         error = std::move(ex);
         status.store(DispatcherOperation::Status::Faulted, std::memory_order_release);
-        cv.notify_all();
+        status.notify_all();
     }
 };
 } // namespace detail
 
+namespace {
+std::shared_ptr<detail::DispatcherOperationState> MakeOperationState() {
+    return std::allocate_shared<detail::DispatcherOperationState>(PoolAllocator<detail::DispatcherOperationState>());
+}
+} // namespace
+
 struct Dispatcher::QueuedTask {
     Task task;
     std::shared_ptr<OperationState> state;
     Priority priority{Priority::Normal};
-    std::size_t sequence{0};
+    Clock::time_point readyTime{};
+};
+
+/**
+ * @brief 按优先级划分的就绪队列与延迟任务
+ *
+ * 常规投递只写无锁环形队列。环形队列满时（突发投递）任务进入同一优先级的溢出队列，
+ * 这是唯一加锁的路径；溢出队列非空期间新任务也进入溢出队列，以保持同一投递线程的先后顺序。
+ * 调度线程每次把整个溢出队列换出后在锁外执行。
+ */
+struct Dispatcher::TaskQueues {
+    struct Lane {
+        explicit Lane(std::size_t capacity) : ring(capacity) {}
+
+        // 计数只在溢出路径上修改，常规投递只有环形队列内部的一次 CAS
+        std::size_t Pushed() const {
+            return ring.PushedCount() + static_cast<std::size_t>(overflowPushed.load(std::memory_order_acquire));
+        }
+        std::size_t Popped() const {
+            return ring.PoppedCount() + static_cast<std::size_t>(overflowPopped.load(std::memory_order_acquire));
+        }
+        bool HasOverflow() const {
+            return overflowPushed.load(std::memory_order_acquire) != overflowPopped.load(std::memory_order_acquire);
+        }
+
+        MpscRingQueue<QueuedTask> ring;
+        std::mutex overflowMutex;
+        std::deque<QueuedTask> overflow;
+        std::deque<QueuedTask> overflowBatch;  // 调度线程换出的溢出任务
+        alignas(64) std::atomic<std::uint64_t> overflowPushed{0};
+        alignas(64) std::atomic<std::uint64_t> overflowPopped{0};
+    };
+
+    struct ScheduledTask {
+        Clock::time_point due;
+        QueuedTask task;
+    };
+
+    std::array<Lane, kPriorityCount> lanes{Lane(kLaneCapacity[0]), Lane(kLaneCapacity[1]), Lane(kLaneCapacity[2])};
+
+    // 延迟任务：任意线程写入收件队列，调度线程移入时间轮
+    MpscQueue<ScheduledTask> incomingDelayed;
+    TimingWheel<QueuedTask> timers;
+    std::atomic<std::uint64_t> postedDelayed{0};
+    std::atomic<std::uint64_t> expiredDelayed{0};
+    std::atomic<std::uint64_t> discardedDelayed{0};  // 到期时已取消、未进入就绪队列
+
+    // 统计（只由调度线程写入）
+    std::atomic<std::uint64_t> latencyTotalNs{0};
+    std::atomic<std::uint64_t> latencySamples{0};
+    std::atomic<std::uint64_t> latencyMaxNs{0};
+    std::atomic<std::size_t> maxQueueDepth{0};
+    std::atomic<std::uint64_t> postedBase{0};
+    std::atomic<std::uint64_t> executedBase{0};
+
+    static std::size_t LaneIndex(Priority priority) {
+        const auto index = static_cast<std::size_t>(priority);
+        return index < kPriorityCount ? index : static_cast<std::size_t>(Priority::Normal);
+    }
 };
 
 Dispatcher::Dispatcher(std::string name, std::unique_ptr<IDispatcherBackend> backend)
-    : name_(std::move(name)), backend_(std::move(backend)) {}
+    : name_(std::move(name)), queues_(std::make_unique<TaskQueues>()), backend_(std::move(backend)) {}
 
 Dispatcher::~Dispatcher() {
     Shutdown();
@@ -78,7 +264,7 @@ DispatcherOperation Dispatcher::BeginInvoke(Task task, Priority priority) {
     if (!task) {
         return DispatcherOperation{};
     }
-    auto state = std::make_shared<OperationState>();
+    auto state = MakeOperationState();
     EnqueueTask(std::move(task), state, priority);
     return DispatcherOperation(state);
 }
@@ -87,7 +273,7 @@ DispatcherOperation Dispatcher::PostDelayed(Task task, std::chrono::milliseconds
     if (!task) {
         return DispatcherOperation{};
     }
-    auto state = std::make_shared<OperationState>();
+    auto state = MakeOperationState();
     const auto due = Clock::now() + delay;
     return EnqueueDelayedTask(std::move(task), due, state, priority);
 }
@@ -119,13 +305,20 @@ void Dispatcher::Run() {
 
     threadId_ = std::this_thread::get_id();
 
+    // 按批执行：每批开始时收集到期任务并记录队列深度
+    QueuedTask task;
     while (running_.load(std::memory_order_acquire)) {
-        QueuedTask task;
-        if (TryDequeue(task)) {
-            ExecuteTask(task);
+        const std::size_t budget = BeginBatch();
+        if (budget == 0) {
+            WaitForWork();
             continue;
         }
-        WaitForWork();
+        for (std::size_t executed = 0; executed < budget && running_.load(std::memory_order_acquire); ++executed) {
+            if (!TryDequeue(task)) {
+                break;
+            }
+            ExecuteTask(task);
+        }
     }
 
     CancelPendingTasks();
@@ -139,6 +332,73 @@ void Dispatcher::Shutdown() {
     WakeUp();
 }
 
+void Dispatcher::BindToCurrentThread() {
+    threadId_ = std::this_thread::get_id();
+}
+
+std::size_t Dispatcher::ProcessPendingTasks() {
+    // 只执行调用时已就绪的任务，避免任务反复投递自身导致无法返回
+    const std::size_t budget = BeginBatch();
+
+    std::size_t executed = 0;
+    QueuedTask task;
+    while (executed < budget && TryDequeue(task)) {
+        ExecuteTask(task);
+        ++executed;
+    }
+    return executed;
+}
+
+bool Dispatcher::HasPendingTasks() const {
+    if (ReadyCount() > 0) {
+        return true;
+    }
+    if (auto due = NextDueTime()) {
+        return *due <= Clock::now();
+    }
+    return false;
+}
+
+std::optional<std::chrono::steady_clock::time_point> Dispatcher::NextDueTime() const {
+    if (ReadyCount() > 0) {
+        return Clock::now();
+    }
+    if (!HasThreadAccess() && threadId_ != std::thread::id{}) {
+        // 时间轮只能由调度线程访问
+        return std::nullopt;
+    }
+    // 收件队列只能由调度线程取出，这里先移入时间轮
+    const_cast<Dispatcher*>(this)->CollectDueTasks(Clock::now());
+    if (ReadyCount() > 0) {
+        return Clock::now();
+    }
+    return queues_->timers.NextDue();
+}
+
+void Dispatcher::WaitForEvents(std::chrono::milliseconds maxWait) {
+    // 等待时间不超过下一个延迟任务的到期时间
+    auto timeout = maxWait;
+    if (auto due = NextDueTime()) {
+        auto untilDue = std::chrono::duration_cast<std::chrono::milliseconds>(*due - Clock::now());
+        timeout = std::clamp(untilDue, std::chrono::milliseconds::zero(), maxWait);
+    }
+    if (timeout <= std::chrono::milliseconds::zero()) {
+        return;
+    }
+
+    if (backend_) {
+        waiting_.store(true, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!HasIncomingWork()) {
+            backend_->WaitForEvents(timeout);
+        }
+        waiting_.store(false, std::memory_order_release);
+        return;
+    }
+
+    WaitFor(Clock::now() + timeout);
+}
+
 bool Dispatcher::HasThreadAccess() const {
     return std::this_thread::get_id() == threadId_;
 }
@@ -149,76 +409,182 @@ void Dispatcher::VerifyAccess() const {
     }
 }
 
-void Dispatcher::EnqueueTask(Task task, std::shared_ptr<OperationState> state, Priority priority) {
-    {
-        std::lock_guard lock(queueMutex_);
-        immediateTasks_.push_back(QueuedTask{std::move(task), std::move(state), priority, sequenceCounter_++});
+DispatcherStatistics Dispatcher::GetStatistics() const {
+    auto& queues = *queues_;
+    DispatcherStatistics stats;
+    std::uint64_t pushed = 0;
+    std::uint64_t popped = 0;
+    for (std::size_t i = 0; i < kPriorityCount; ++i) {
+        const auto& lane = queues.lanes[i];
+        const auto lanePopped = lane.Popped();
+        const auto lanePushed = lane.Pushed();
+        stats.queueDepthByPriority[i] = lanePushed > lanePopped ? lanePushed - lanePopped : 0;
+        stats.queueDepth += stats.queueDepthByPriority[i];
+        pushed += lanePushed;
+        popped += lanePopped;
+    }
+
+    const auto postedDelayed = queues.postedDelayed.load(std::memory_order_acquire);
+    const auto expiredDelayed = queues.expiredDelayed.load(std::memory_order_acquire);
+    const auto discardedDelayed = queues.discardedDelayed.load(std::memory_order_acquire);
+    // 到期的延迟任务进入就绪队列时会再计一次，这里扣除
+    const std::uint64_t posted = pushed - (expiredDelayed - discardedDelayed) + postedDelayed;
+    const std::uint64_t executed = popped + discardedDelayed;
+    stats.posted = posted - std::min(posted, queues.postedBase.load(std::memory_order_relaxed));
+    stats.executed = executed - std::min(executed, queues.executedBase.load(std::memory_order_relaxed));
+    stats.delayedPending = postedDelayed > expiredDelayed ? static_cast<std::size_t>(postedDelayed - expiredDelayed) : 0;
+    stats.maxQueueDepth = queues.maxQueueDepth.load(std::memory_order_relaxed);
+
+    const auto samples = queues.latencySamples.load(std::memory_order_relaxed);
+    if (samples > 0) {
+        stats.averageLatency = std::chrono::nanoseconds(queues.latencyTotalNs.load(std::memory_order_relaxed) / samples);
     }
+    stats.maxLatency = std::chrono::nanoseconds(queues.latencyMaxNs.load(std::memory_order_relaxed));
+    return stats;
+}
+
+void Dispatcher::ResetStatistics() {
+    const auto before = GetStatistics();
+    queues_->postedBase.fetch_add(before.posted, std::memory_order_relaxed);
+    queues_->executedBase.fetch_add(before.executed, std::memory_order_relaxed);
+    queues_->latencyTotalNs.store(0, std::memory_order_relaxed);
+    queues_->latencySamples.store(0, std::memory_order_relaxed);
+    queues_->latencyMaxNs.store(0, std::memory_order_relaxed);
+    queues_->maxQueueDepth.store(0, std::memory_order_relaxed);
+}
+
+void Dispatcher::EnqueueTask(Task task, std::shared_ptr<OperationState> state, Priority priority) {
+    PushReady(QueuedTask{std::move(task), std::move(state), priority, ShouldSampleLatency() ? Clock::now() : Clock::time_point{}});
     WakeUp();
 }
 
 DispatcherOperation Dispatcher::EnqueueDelayedTask(Task task, std::chrono::steady_clock::time_point due,
     std::shared_ptr<OperationState> state, Priority priority) {
     auto opState = state;
-    {
-        std::lock_guard lock(queueMutex_);
-        delayedTasks_.push(ScheduledTask{due, std::move(task), std::move(state), priority, sequenceCounter_++});
-    }
+    queues_->postedDelayed.fetch_add(1, std::memory_order_relaxed);
+    queues_->incomingDelayed.Push(TaskQueues::ScheduledTask{due, QueuedTask{std::move(task), std::move(state), priority, {}}});
     WakeUp();
     return DispatcherOperation(std::move(opState));
 }
 
-bool Dispatcher::TryDequeue(QueuedTask& outTask) {
-    std::lock_guard lock(queueMutex_);
-    MoveDueTasksLocked(Clock::now());
-    if (immediateTasks_.empty()) {
-        return false;
+void Dispatcher::PushReady(QueuedTask&& task) {
+    auto& lane = queues_->lanes[TaskQueues::LaneIndex(task.priority)];
+    if (!lane.HasOverflow() && lane.ring.TryPush(task)) {
+        return;
     }
-
-    outTask = std::move(immediateTasks_.front());
-    immediateTasks_.pop_front();
-    return true;
+    std::lock_guard lock(lane.overflowMutex);
+    lane.overflow.push_back(std::move(task));
+    lane.overflowPushed.fetch_add(1, std::memory_order_acq_rel);
 }
 
-void Dispatcher::MoveDueTasksLocked(std::chrono::steady_clock::time_point now) {
-    while (!delayedTasks_.empty()) {
-        const auto& top = delayedTasks_.top();
-        if (top.due > now) {
-            break;
+bool Dispatcher::TryDequeue(QueuedTask& outTask) {
+    for (auto& lane : queues_->lanes) {
+        if (auto task = lane.ring.TryPop()) {
+            outTask = std::move(*task);
+            return true;
+        }
+        if (lane.overflowBatch.empty() && lane.HasOverflow()) {
+            std::lock_guard lock(lane.overflowMutex);
+            lane.overflowBatch.swap(lane.overflow);
+        }
+        if (!lane.overflowBatch.empty()) {
+            outTask = std::move(lane.overflowBatch.front());
+            lane.overflowBatch.pop_front();
+            lane.overflowPopped.store(lane.overflowPopped.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            return true;
         }
-        auto task = delayedTasks_.top();
-        delayedTasks_.pop();
-        immediateTasks_.push_back(QueuedTask{std::move(task.task), std::move(task.state), task.priority, task.sequence});
     }
+    return false;
 }
 
-void Dispatcher::WaitForWork() {
-    std::unique_lock lock(queueMutex_);
-    while (running_.load(std::memory_order_acquire)) {
-        MoveDueTasksLocked(Clock::now());
-        if (!immediateTasks_.empty()) {
+std::size_t Dispatcher::BeginBatch() {
+    CollectDueTasks(Clock::now());
+    const std::size_t depth = ReadyCount();
+    if (depth > queues_->maxQueueDepth.load(std::memory_order_relaxed)) {
+        queues_->maxQueueDepth.store(depth, std::memory_order_relaxed);
+    }
+    return depth;
+}
+
+void Dispatcher::CollectDueTasks(std::chrono::steady_clock::time_point now) {
+    auto& queues = *queues_;
+    while (auto scheduled = queues.incomingDelayed.TryPop()) {
+        queues.timers.Schedule(scheduled->due, std::move(scheduled->task));
+    }
+    if (queues.timers.Empty()) {
+        return;
+    }
+    queues.timers.Advance(now, [&](QueuedTask&& task) {
+        queues.expiredDelayed.fetch_add(1, std::memory_order_relaxed);
+        // 已取消的任务直接丢弃，不再占用就绪队列
+        if (task.state && task.state->canceled.load(std::memory_order_acquire)) {
+            task.state->MarkCanceled();
+            queues.discardedDelayed.fetch_add(1, std::memory_order_relaxed);
             return;
         }
-        if (!running_.load(std::memory_order_acquire)) {
-            return;
+        task.readyTime = ShouldSampleLatency() ? now : Clock::time_point{};
+        PushReady(std::move(task));
+    });
+}
+
+std::size_t Dispatcher::ReadyCount() const {
+    std::size_t count = 0;
+    for (const auto& lane : queues_->lanes) {
+        const auto popped = lane.Popped();
+        const auto pushed = lane.Pushed();
+        if (pushed > popped) {
+            count += pushed - popped;
         }
-        if (!delayedTasks_.empty()) {
-            auto nextDue = delayedTasks_.top().due;
-            cv_.wait_until(lock, nextDue, [this]() {
-                return !running_.load(std::memory_order_acquire) || !immediateTasks_.empty() || delayedTasks_.empty();
-            });
+    }
+    return count;
+}
+
+bool Dispatcher::HasIncomingWork() const {
+    return ReadyCount() > 0 || !queues_->incomingDelayed.Empty();
+}
+
+void Dispatcher::WaitFor(std::optional<std::chrono::steady_clock::time_point> deadline) {
+    // 先声明即将等待，再检查队列；投递方先入队再检查标记（两侧都有全屏障），
+    // 因此要么这里看到新任务，要么投递方看到标记并唤醒
+    std::unique_lock lock(waitMutex_);
+    waiting_.store(true, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto ready = [this]() {
+        return !running_.load(std::memory_order_acquire) || HasIncomingWork();
+    };
+    if (!HasIncomingWork()) {
+        if (deadline) {
+            cv_.wait_until(lock, *deadline, ready);
         } else {
-            cv_.wait(lock, [this]() {
-                return !running_.load(std::memory_order_acquire) || !immediateTasks_.empty() || !delayedTasks_.empty();
-            });
+            cv_.wait(lock, ready);
         }
     }
+    waiting_.store(false, std::memory_order_release);
+}
+
+void Dispatcher::WaitForWork() {
+    // Run 模式：没有到期任务时一直等待
+    WaitFor(queues_->timers.NextDue());
 }
 
 void Dispatcher::ExecuteTask(QueuedTask& task) {
-    auto state = task.state;
+    // 等待时间统计（采样）只由调度线程写入
+    auto& queues = *queues_;
+    const auto latency = task.readyTime == Clock::time_point{} ? -1
+        : std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - task.readyTime).count();
+    if (latency >= 0) {
+        const auto value = static_cast<std::uint64_t>(latency);
+        queues.latencyTotalNs.store(queues.latencyTotalNs.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        queues.latencySamples.store(queues.latencySamples.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (value > queues.latencyMaxNs.load(std::memory_order_relaxed)) {
+            queues.latencyMaxNs.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    auto state = std::move(task.state);
     if (state) {
         if (!state->TryStart()) {
+            task.task = nullptr;
             return;
         }
     }
@@ -235,9 +601,19 @@ void Dispatcher::ExecuteTask(QueuedTask& task) {
             std::cerr << "Unhandled exception in Dispatcher::ExecuteTask" << std::endl;
         }
     }
+    // 尽早释放任务捕获的对象
+    task.task = nullptr;
 }
 
 void Dispatcher::WakeUp() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!waiting_.load(std::memory_order_seq_cst)) {
+        return;
+    }
+    {
+        // 与等待方的加锁配对，避免在其检查队列之后、进入等待之前发出通知
+        std::lock_guard lock(waitMutex_);
+    }
     cv_.notify_one();
     if (backend_) {
         backend_->NotifyWorkPending();
@@ -245,22 +621,24 @@ void Dispatcher::WakeUp() {
 }
 
 void Dispatcher::CancelPendingTasks() {
-    std::lock_guard lock(queueMutex_);
-
-    for (auto& task : immediateTasks_) {
+    QueuedTask task;
+    while (TryDequeue(task)) {
         if (task.state) {
             task.state->MarkCanceled();
         }
     }
-    immediateTasks_.clear();
 
-    while (!delayedTasks_.empty()) {
-        auto task = delayedTasks_.top();
-        delayedTasks_.pop();
-        if (task.state) {
-            task.state->MarkCanceled();
-        }
+    auto& queues = *queues_;
+    while (auto scheduled = queues.incomingDelayed.TryPop()) {
+        queues.timers.Schedule(scheduled->due, std::move(scheduled->task));
     }
+    queues.timers.Clear([&](QueuedTask&& pending) {
+        queues.expiredDelayed.fetch_add(1, std::memory_order_relaxed);
+        queues.discardedDelayed.fetch_add(1, std::memory_order_relaxed);
+        if (pending.state) {
+            pending.state->MarkCanceled();
+        }
+    });
 }
 
 DispatcherOperation::DispatcherOperation() = default;
@@ -280,7 +658,7 @@ bool DispatcherOperation::Cancel() {
     auto expected = DispatcherOperation::Status::Pending;
     if (state_->status.compare_exchange_strong(expected, DispatcherOperation::Status::Canceled, std::memory_order_acq_rel)) {
         state_->canceled.store(true, std::memory_order_release);
-        state_->cv.notify_all();
+        state_->status.notify_all();
         return true;
     }
 
@@ -292,11 +670,11 @@ void DispatcherOperation::Wait() const {
     if (!state_) {
         return;
     }
-    std::unique_lock lock(state_->mutex);
-    state_->cv.wait(lock, [this]() {
-        auto status = state_->status.load(std::memory_order_acquire);
-        return status != Status::Pending && status != Status::Running;
-    });
+    auto status = state_->status.load(std::memory_order_acquire);
+    while (status == Status::Pending || status == Status::Running) {
+        state_->status.wait(status, std::memory_order_acquire);
+        status = state_->status.load(std::memory_order_acquire);
+    }
 }
 
 DispatcherOperation::Status DispatcherOperation::GetStatus() const {
@@ -0,0 +1,353 @@
+#include "fk/core/TaskPool.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace fk::core {
+
+namespace {
+
+thread_local TaskPool* t_currentPool = nullptr;
+thread_local std::size_t t_workerIndex = 0;
+
+// 空闲工作线程休眠前让出时间片的次数
+constexpr int kSpinCount = 16;
+
+} // namespace
+
+/**
+ * @brief Chase-Lev 工作窃取双端队列（固定容量）
+ *
+ * 所属工作线程在尾部 Push/Pop（LIFO，缓存友好），其他线程在头部 Steal（FIFO）。
+ * 容量固定，满时 Push 返回 false，由调用方放入共享队列。
+ */
+class TaskPool::WorkQueue {
+public:
+    static constexpr std::int64_t kCapacity = 4096;
+
+    WorkQueue() : cells_(std::make_unique<std::atomic<Work*>[]>(kCapacity)) {}
+
+    ~WorkQueue() {
+        while (Work* work = Pop()) {
+            delete work;
+        }
+    }
+
+    // 仅所属线程
+    bool Push(Work* work) {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        if (bottom - top >= kCapacity) {
+            return false;
+        }
+        cells_[bottom & kMask].store(work, std::memory_order_relaxed);
+        // 释放语义：窃取者读到新的 bottom 时也能看到任务对象本身
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 仅所属线程（或工作线程退出之后）
+    Work* Pop() {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Work* work = cells_[bottom & kMask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // 最后一个元素：与窃取者竞争
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                work = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return work;
+    }
+
+    // 任意线程；与其他线程竞争失败时返回 nullptr
+    Work* Steal() {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Work* work = cells_[top & kMask].load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return work;
+    }
+
+    std::size_t Size() const {
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+private:
+    static constexpr std::int64_t kMask = kCapacity - 1;
+
+    std::unique_ptr<std::atomic<Work*>[]> cells_;
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+};
+
+struct TaskPool::Worker {
+    WorkQueue queue;
+    std::thread thread;
+    std::uint32_t random{0};  // 选择窃取对象的随机数状态
+
+    std::size_t NextVictim(std::size_t count) {
+        // xorshift32
+        random ^= random << 13;
+        random ^= random >> 17;
+        random ^= random << 5;
+        return random % count;
+    }
+};
+
+TaskPool::TaskPool(std::size_t workerCount, std::string name)
+    : name_(std::move(name)) {
+    if (workerCount == 0) {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->random = static_cast<std::uint32_t>(i * 2654435761u + 1);
+        workers_.push_back(std::move(worker));
+    }
+    // 所有 Worker 创建完成后再启动线程，窃取时可以安全遍历 workers_
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers_[i]->thread = std::thread([this, i]() { WorkerLoop(i); });
+    }
+}
+
+TaskPool::~TaskPool() {
+    Shutdown();
+}
+
+TaskPool& TaskPool::Shared() {
+    static TaskPool pool(0, "Shared");
+    return pool;
+}
+
+TaskPool* TaskPool::Current() {
+    return t_currentPool;
+}
+
+void TaskPool::Post(Work work) {
+    if (!work || stopping_.load(std::memory_order_acquire)) {
+        return;
+    }
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    auto item = std::make_unique<Work>(std::move(work));
+    if (t_currentPool == this && workers_[t_workerIndex]->queue.Push(item.get())) {
+        // 工作线程产生的子任务放入自己的队列，通常由自己接着执行
+        item.release();
+    } else {
+        std::lock_guard lock(sharedMutex_);
+        if (stopping_.load(std::memory_order_acquire)) {
+            return;
+        }
+        sharedQueue_.push_back(std::move(item));
+        sharedSize_.fetch_add(1, std::memory_order_release);
+    }
+    WakeWorker();
+}
+
+bool TaskPool::RunPendingTask() {
+    Worker* self = t_currentPool == this ? workers_[t_workerIndex].get() : nullptr;
+    auto work = TakeWork(self);
+    if (!work) {
+        return false;
+    }
+    Execute(std::move(work));
+    return true;
+}
+
+void TaskPool::Shutdown() {
+    {
+        std::lock_guard lock(sharedMutex_);
+        if (stopping_.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+    }
+    {
+        std::lock_guard lock(sleepMutex_);
+    }
+    sleepCv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+
+    // 丢弃尚未执行的任务（任务状态随之变为 Canceled）
+    std::deque<std::unique_ptr<Work>> remaining;
+    {
+        std::lock_guard lock(sharedMutex_);
+        remaining.swap(sharedQueue_);
+        sharedSize_.store(0, std::memory_order_release);
+    }
+    remaining.clear();
+    for (auto& worker : workers_) {
+        while (Work* work = worker->queue.Pop()) {
+            delete work;
+        }
+    }
+}
+
+TaskPoolStatistics TaskPool::GetStatistics() const {
+    TaskPoolStatistics stats;
+    stats.submitted = submitted_.load(std::memory_order_relaxed);
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.stolen = stolen_.load(std::memory_order_relaxed);
+    stats.pending = sharedSize_.load(std::memory_order_acquire);
+    for (const auto& worker : workers_) {
+        stats.pending += worker->queue.Size();
+    }
+    return stats;
+}
+
+void TaskPool::WorkerLoop(std::size_t index) {
+    t_currentPool = this;
+    t_workerIndex = index;
+    Worker* self = workers_[index].get();
+
+    while (!stopping_.load(std::memory_order_acquire)) {
+        if (auto work = TakeWork(self)) {
+            Execute(std::move(work));
+            continue;
+        }
+
+        // 短暂让出时间片：连续投递的任务通常很快就到
+        bool found = false;
+        for (int i = 0; i < kSpinCount && !found; ++i) {
+            std::this_thread::yield();
+            found = HasQueuedWork();
+        }
+        if (found) {
+            continue;
+        }
+
+        std::unique_lock lock(sleepMutex_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        // 与 WakeWorker 中的栅栏配对：要么投递方看到 sleepers_，要么这里看到新任务
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!stopping_.load(std::memory_order_acquire) && !HasQueuedWork()) {
+            sleepCv_.wait(lock);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    t_currentPool = nullptr;
+}
+
+std::unique_ptr<TaskPool::Work> TaskPool::TakeWork(Worker* self) {
+    if (self) {
+        if (Work* work = self->queue.Pop()) {
+            return std::unique_ptr<Work>(work);
+        }
+    }
+
+    if (sharedSize_.load(std::memory_order_acquire) > 0) {
+        std::lock_guard lock(sharedMutex_);
+        if (!sharedQueue_.empty()) {
+            auto work = std::move(sharedQueue_.front());
+            sharedQueue_.pop_front();
+            sharedSize_.fetch_sub(1, std::memory_order_release);
+            return work;
+        }
+    }
+
+    return TryStealWork(self);
+}
+
+std::unique_ptr<TaskPool::Work> TaskPool::TryStealWork(Worker* self) {
+    const std::size_t count = workers_.size();
+    if (count == 0) {
+        return nullptr;
+    }
+    const std::size_t start = self ? self->NextVictim(count) : 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Worker* victim = workers_[(start + i) % count].get();
+        if (victim == self) {
+            continue;
+        }
+        if (Work* work = victim->queue.Steal()) {
+            stolen_.fetch_add(1, std::memory_order_relaxed);
+            return std::unique_ptr<Work>(work);
+        }
+    }
+    return nullptr;
+}
+
+bool TaskPool::HasQueuedWork() const {
+    if (sharedSize_.load(std::memory_order_acquire) > 0) {
+        return true;
+    }
+    return std::any_of(workers_.begin(), workers_.end(), [](const auto& worker) {
+        return worker->queue.Size() > 0;
+    });
+}
+
+void TaskPool::WakeWorker() {
+    // 与 WorkerLoop 休眠前的栅栏配对
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    {
+        // 获取一次互斥量：确保检查完队列的工作线程已经进入等待
+        std::lock_guard lock(sleepMutex_);
+    }
+    sleepCv_.notify_one();
+}
+
+void TaskPool::Execute(std::unique_ptr<Work> work) {
+    try {
+        (*work)();
+    } catch (...) {
+        // Run 投递的任务自己捕获异常；这里只会是 Post 投递的任务
+        std::cerr << "Unhandled exception in TaskPool task (" << name_ << ")" << std::endl;
+    }
+    // 在计数之前释放任务捕获的对象
+    work.reset();
+    executed_.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace detail {
+
+void TaskStateBase::Wait() const {
+    if (IsDone()) {
+        return;
+    }
+    if (auto* pool = TaskPool::Current()) {
+        while (!IsDone()) {
+            if (!pool->RunPendingTask()) {
+                std::this_thread::yield();
+            }
+        }
+        return;
+    }
+    for (;;) {
+        const auto current = status.load(std::memory_order_acquire);
+        if (current != TaskStatus::Pending && current != TaskStatus::Running) {
+            return;
+        }
+        status.wait(current, std::memory_order_acquire);
+    }
+}
+
+} // namespace detail
+
+} // namespace fk::core
@@ -0,0 +1,84 @@
+#include "fk/render/DamageRegion.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fk::render {
+
+namespace {
+
+// 超过该数量的矩形直接合并为包围盒
+constexpr std::size_t kMaxDamageRects = 8;
+
+// 损坏面积超过视口该比例时整帧重绘更划算
+constexpr float kFullRedrawCoverage = 0.7f;
+
+// 合并后的面积不超过两者面积之和的该倍数时合并（减少 draw pass 数量）
+constexpr float kMergeSlack = 1.25f;
+
+} // namespace
+
+void DamageRegion::Reset(float viewportWidth, float viewportHeight) {
+    viewport_ = ui::Rect(0.0f, 0.0f, viewportWidth, viewportHeight);
+    rects_.clear();
+    full_ = false;
+}
+
+void DamageRegion::Add(const ui::Rect& rect) {
+    if (full_ || rect.IsEmpty()) {
+        return;
+    }
+
+    // 外扩到整数像素，并为抗锯齿边缘留出余量
+    float left = std::floor(rect.x) - 1.0f;
+    float top = std::floor(rect.y) - 1.0f;
+    float right = std::ceil(rect.Right()) + 1.0f;
+    float bottom = std::ceil(rect.Bottom()) + 1.0f;
+
+    ui::Rect clipped = ui::Rect(left, top, right - left, bottom - top).Intersect(viewport_);
+    if (!clipped.IsEmpty()) {
+        rects_.push_back(clipped);
+    }
+}
+
+void DamageRegion::Merge() {
+    if (full_ || rects_.empty()) {
+        return;
+    }
+
+    // 反复合并相交或合并代价较低的矩形对
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (std::size_t i = 0; i < rects_.size() && !merged; ++i) {
+            for (std::size_t j = i + 1; j < rects_.size(); ++j) {
+                ui::Rect combined = rects_[i].Union(rects_[j]);
+                if (rects_[i].Intersects(rects_[j]) ||
+                    combined.Area() <= (rects_[i].Area() + rects_[j].Area()) * kMergeSlack) {
+                    rects_[i] = combined;
+                    rects_.erase(rects_.begin() + j);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (rects_.size() > kMaxDamageRects) {
+        ui::Rect bounds;
+        for (const auto& rect : rects_) {
+            bounds = bounds.Union(rect);
+        }
+        rects_.assign(1, bounds);
+    }
+
+    float area = 0.0f;
+    for (const auto& rect : rects_) {
+        area += rect.Area();
+    }
+    if (area >= viewport_.Area() * kFullRedrawCoverage) {
+        AddFull();
+    }
+}
+
+} // namespace fk::render
@@ -0,0 +1,656 @@
+#include "fk/render/FontManager.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_TRUETYPE_TABLES_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <unordered_set>
+
+namespace fk::render {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr std::uint32_t kCacheMagic = 0x43464b46;  // "FKFC"
+constexpr std::uint32_t kCacheVersion = 1;
+constexpr std::uint32_t kBlockCount = 0x110000 >> 8;
+constexpr std::uint32_t kCodepointsPerBlock = 256;
+
+// 平台默认字体族（按优先顺序），也是回退链的开头
+const std::vector<std::string_view>& PreferredFamilies() {
+    static const std::vector<std::string_view> families = {
+#ifdef _WIN32
+        "Microsoft YaHei", "SimHei", "Segoe UI", "Arial", "Times New Roman", "Segoe UI Emoji"
+#elif __APPLE__
+        "PingFang SC", "Helvetica", "Arial Unicode MS", "Apple Color Emoji"
+#else
+        "DejaVu Sans", "Liberation Sans", "Noto Sans", "Noto Sans CJK SC", "Noto Color Emoji"
+#endif
+    };
+    return families;
+}
+
+// 通用字体族别名
+struct GenericFamily {
+    std::string_view name;
+    std::vector<std::string_view> candidates;
+};
+
+const std::vector<GenericFamily>& GenericFamilies() {
+    static const std::vector<GenericFamily> generics = {
+        {"sans-serif", {"DejaVu Sans", "Liberation Sans", "Noto Sans", "Segoe UI", "Arial", "Helvetica"}},
+        {"serif", {"DejaVu Serif", "Liberation Serif", "Noto Serif", "Times New Roman", "Times"}},
+        {"monospace", {"DejaVu Sans Mono", "Liberation Mono", "Noto Sans Mono", "Consolas", "Courier New", "Menlo"}},
+    };
+    return generics;
+}
+
+std::string HomeDirectory() {
+#ifdef _WIN32
+    const char* home = std::getenv("USERPROFILE");
+#else
+    const char* home = std::getenv("HOME");
+#endif
+    return home ? std::string(home) : std::string();
+}
+
+std::string DefaultCachePath() {
+#ifdef _WIN32
+    const char* base = std::getenv("LOCALAPPDATA");
+    return base ? std::string(base) + "/fk_ui/font-cache.bin" : std::string();
+#elif __APPLE__
+    const std::string home = HomeDirectory();
+    return home.empty() ? std::string() : home + "/Library/Caches/fk_ui/font-cache.bin";
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        return std::string(xdg) + "/fk_ui/font-cache.bin";
+    }
+    const std::string home = HomeDirectory();
+    return home.empty() ? std::string() : home + "/.cache/fk_ui/font-cache.bin";
+#endif
+}
+
+#if !defined(_WIN32) && !defined(__APPLE__)
+// 读取 fontconfig 配置中的 <dir> 元素（不处理 include 与条件）
+std::vector<std::string> FontconfigDirectories(const std::string& configPath) {
+    std::vector<std::string> directories;
+    std::ifstream file(configPath);
+    if (!file) {
+        return directories;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string config = buffer.str();
+
+    // 去掉注释
+    for (std::size_t start; (start = config.find("<!--")) != std::string::npos;) {
+        const std::size_t end = config.find("-->", start);
+        config.erase(start, end == std::string::npos ? std::string::npos : end + 3 - start);
+    }
+
+    const std::string home = HomeDirectory();
+    for (std::size_t pos = 0; (pos = config.find("<dir", pos)) != std::string::npos;) {
+        const std::size_t tagEnd = config.find('>', pos);
+        const std::size_t close = config.find("</dir>", pos);
+        if (tagEnd == std::string::npos || close == std::string::npos || close < tagEnd) {
+            break;
+        }
+        const std::string attributes = config.substr(pos + 4, tagEnd - pos - 4);
+        std::string directory = config.substr(tagEnd + 1, close - tagEnd - 1);
+        pos = close + 6;
+        if (attributes.find("prefix=\"xdg\"") != std::string::npos) {
+            const char* xdg = std::getenv("XDG_DATA_HOME");
+            const std::string base = xdg && *xdg ? std::string(xdg) : home + "/.local/share";
+            directory = base + "/" + directory;
+        } else if (!directory.empty() && directory[0] == '~') {
+            directory = home + directory.substr(1);
+        }
+        if (!directory.empty()) {
+            directories.push_back(directory);
+        }
+    }
+    return directories;
+}
+#endif
+
+// 字体族名称按 ASCII 忽略大小写（与区域设置无关）
+inline unsigned char AsciiLower(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c + ('a' - 'A')) : c;
+}
+
+bool IsFontFile(const fs::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(AsciiLower(c)); });
+    return extension == ".ttf" || extension == ".otf" || extension == ".ttc" || extension == ".otc";
+}
+
+// ========== 磁盘缓存读写 ==========
+
+class CacheWriter {
+public:
+    explicit CacheWriter(std::ostream& out) : out_(out) {}
+
+    template <typename T>
+    void Write(T value) { out_.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+    void WriteString(const std::string& value) {
+        Write(static_cast<std::uint32_t>(value.size()));
+        out_.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+private:
+    std::ostream& out_;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(std::istream& in) : in_(in) {}
+
+    template <typename T>
+    bool Read(T& value) { return static_cast<bool>(in_.read(reinterpret_cast<char*>(&value), sizeof(T))); }
+
+    bool ReadString(std::string& value) {
+        std::uint32_t size = 0;
+        if (!Read(size) || size > 4096) {
+            return false;
+        }
+        value.resize(size);
+        return static_cast<bool>(in_.read(value.data(), size));
+    }
+
+private:
+    std::istream& in_;
+};
+
+} // namespace
+
+// ========== FontManager ==========
+
+FontManager& FontManager::Instance() {
+    static FontManager instance;
+    return instance;
+}
+
+FontManager::FontManager()
+    : cachePath_(DefaultCachePath()) {
+}
+
+void FontManager::AddFontDirectory(const std::string& directory) {
+    extraDirectories_.push_back(directory);
+}
+
+std::size_t FontManager::FamilyHash::operator()(std::string_view name) const {
+    // FNV-1a（按小写字母计算）
+    std::size_t hash = 14695981039346656037ull;
+    for (unsigned char c : name) {
+        hash ^= static_cast<std::size_t>(AsciiLower(c));
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool FontManager::FamilyEqual::operator()(std::string_view lhs, std::string_view rhs) const {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](unsigned char a, unsigned char b) {
+               return AsciiLower(a) == AsciiLower(b);
+           });
+}
+
+std::vector<std::string> FontManager::FontDirectories() const {
+    std::vector<std::string> directories;
+#ifdef _WIN32
+    const char* windows = std::getenv("WINDIR");
+    directories.push_back(std::string(windows ? windows : "C:/Windows") + "/Fonts");
+    if (const char* local = std::getenv("LOCALAPPDATA")) {
+        directories.push_back(std::string(local) + "/Microsoft/Windows/Fonts");
+    }
+#elif __APPLE__
+    directories = {"/System/Library/Fonts", "/Library/Fonts"};
+    if (const std::string home = HomeDirectory(); !home.empty()) {
+        directories.push_back(home + "/Library/Fonts");
+    }
+#else
+    directories = FontconfigDirectories("/etc/fonts/fonts.conf");
+    if (directories.empty()) {
+        directories = {"/usr/share/fonts", "/usr/local/share/fonts"};
+        if (const std::string home = HomeDirectory(); !home.empty()) {
+            directories.push_back(home + "/.local/share/fonts");
+            directories.push_back(home + "/.fonts");
+        }
+    }
+#endif
+    directories.insert(directories.end(), extraDirectories_.begin(), extraDirectories_.end());
+    return directories;
+}
+
+void FontManager::Initialize() {
+    if (initialized_) {
+        return;
+    }
+    initialized_ = true;
+    const auto start = std::chrono::steady_clock::now();
+
+    std::unordered_map<std::string, FontFile> cached;
+    const bool haveCache = LoadCache(cached);
+    bool changed = !haveCache;
+
+    std::vector<FontFile> files;
+    std::unordered_set<std::string> seen;
+    FT_Library library = nullptr;
+    std::size_t scanned = 0;
+    std::size_t reused = 0;
+
+    for (const auto& directory : FontDirectories()) {
+        std::error_code ec;
+        if (!fs::is_directory(directory, ec)) {
+            continue;
+        }
+        const auto options = fs::directory_options::skip_permission_denied | fs::directory_options::follow_directory_symlink;
+        for (auto it = fs::recursive_directory_iterator(directory, options, ec);
+             !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            if (!it->is_regular_file(ec) || !IsFontFile(it->path())) {
+                continue;
+            }
+            std::string path = it->path().generic_string();
+            if (!seen.insert(path).second) {
+                continue;
+            }
+
+            FontFile file;
+            file.path = std::move(path);
+            file.size = static_cast<std::uint64_t>(it->file_size(ec));
+            file.modified = static_cast<std::int64_t>(it->last_write_time(ec).time_since_epoch().count());
+
+            // 大小与修改时间未变的文件直接使用缓存的描述与覆盖位图
+            auto cachedIt = cached.find(file.path);
+            if (cachedIt != cached.end() && cachedIt->second.size == file.size &&
+                cachedIt->second.modified == file.modified) {
+                files.push_back(std::move(cachedIt->second));
+                ++reused;
+                continue;
+            }
+
+            changed = true;
+            if (!library && FT_Init_FreeType(&library) != 0) {
+                std::cerr << "FontManager: failed to initialize FreeType" << std::endl;
+                library = nullptr;
+            }
+            if (library) {
+                ScanFile(library, file);
+                ++scanned;
+            }
+            files.push_back(std::move(file));
+        }
+    }
+    if (library) {
+        FT_Done_FreeType(library);
+    }
+
+    // 缓存中有已删除的文件
+    if (reused != cached.size()) {
+        changed = true;
+    }
+
+    std::sort(files.begin(), files.end(), [](const FontFile& a, const FontFile& b) { return a.path < b.path; });
+    if (changed) {
+        SaveCache(files);
+    }
+    BuildIndex(files);
+
+    statistics_.files = files.size();
+    statistics_.filesScanned = scanned;
+    statistics_.scanMilliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FontManager::Rescan() {
+    initialized_ = false;
+    faces_.clear();
+    families_.clear();
+    familyIndex_.clear();
+    fallbackOrder_.clear();
+    blockFaces_.clear();
+    statistics_ = {};
+}
+
+void FontManager::ScanFile(FT_LibraryRec_* library, FontFile& file) {
+    FT_Face face = nullptr;
+    if (FT_New_Face(library, file.path.c_str(), -1, &face) != 0) {
+        return;
+    }
+    const long faceCount = face->num_faces;
+    FT_Done_Face(face);
+
+    for (long index = 0; index < faceCount; ++index) {
+        if (FT_New_Face(library, file.path.c_str(), index, &face) != 0) {
+            continue;
+        }
+        if (!face->family_name || !*face->family_name) {
+            FT_Done_Face(face);
+            continue;
+        }
+
+        Face entry;
+        entry.info.path = file.path;
+        entry.info.faceIndex = static_cast<int>(index);
+        entry.info.family = face->family_name;
+        entry.info.italic = (face->style_flags & FT_STYLE_FLAG_ITALIC) != 0;
+        entry.info.weight = (face->style_flags & FT_STYLE_FLAG_BOLD) ? 700 : 400;
+        const auto* os2 = static_cast<const TT_OS2*>(FT_Get_Sfnt_Table(face, FT_SFNT_OS2));
+        if (os2 && os2->version != 0xFFFF && os2->usWeightClass >= 1 && os2->usWeightClass <= 1000) {
+            entry.info.weight = static_cast<std::uint16_t>(std::clamp<int>(os2->usWeightClass, 100, 900));
+        }
+
+        // 字符按码点升序返回，逐块建立覆盖位图
+        if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0) {
+            FT_UInt glyphIndex = 0;
+            for (FT_ULong c = FT_Get_First_Char(face, &glyphIndex); glyphIndex != 0;
+                 c = FT_Get_Next_Char(face, c, &glyphIndex)) {
+                if (c > 0x10FFFF) {
+                    break;
+                }
+                const auto block = static_cast<std::uint32_t>(c >> 8);
+                if (entry.coverage.empty() || entry.coverage.back().block != block) {
+                    entry.coverage.push_back(BlockCoverage{block, {}});
+                }
+                entry.coverage.back().bits[(c >> 6) & 3] |= 1ull << (c & 63);
+            }
+        }
+        FT_Done_Face(face);
+        file.faces.push_back(std::move(entry));
+    }
+}
+
+bool FontManager::LoadCache(std::unordered_map<std::string, FontFile>& files) const {
+    if (cachePath_.empty()) {
+        return false;
+    }
+    std::ifstream in(cachePath_, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    CacheReader reader(in);
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t fileCount = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(fileCount) ||
+        magic != kCacheMagic || version != kCacheVersion) {
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < fileCount; ++i) {
+        FontFile file;
+        std::uint32_t faceCount = 0;
+        if (!reader.ReadString(file.path) || !reader.Read(file.size) || !reader.Read(file.modified) ||
+            !reader.Read(faceCount)) {
+            files.clear();
+            return false;
+        }
+        for (std::uint32_t f = 0; f < faceCount; ++f) {
+            Face face;
+            face.info.path = file.path;
+            std::int32_t faceIndex = 0;
+            std::uint8_t italic = 0;
+            std::uint32_t blockCount = 0;
+            if (!reader.Read(faceIndex) || !reader.ReadString(face.info.family) || !reader.Read(face.info.weight) ||
+                !reader.Read(italic) || !reader.Read(blockCount) || blockCount > kBlockCount) {
+                files.clear();
+                return false;
+            }
+            face.info.faceIndex = faceIndex;
+            face.info.italic = italic != 0;
+            face.coverage.resize(blockCount);
+            for (auto& block : face.coverage) {
+                if (!reader.Read(block.block) || !reader.Read(block.bits)) {
+                    files.clear();
+                    return false;
+                }
+            }
+            file.faces.push_back(std::move(face));
+        }
+        std::string path = file.path;
+        files.emplace(std::move(path), std::move(file));
+    }
+    return true;
+}
+
+void FontManager::SaveCache(const std::vector<FontFile>& files) const {
+    if (cachePath_.empty()) {
+        return;
+    }
+    std::error_code ec;
+    fs::create_directories(fs::path(cachePath_).parent_path(), ec);
+
+    // 先写临时文件再替换，避免其他进程读到写了一半的缓存
+    const std::string temporary = cachePath_ + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return;
+        }
+        CacheWriter writer(out);
+        writer.Write(kCacheMagic);
+        writer.Write(kCacheVersion);
+        writer.Write(static_cast<std::uint32_t>(files.size()));
+        for (const auto& file : files) {
+            writer.WriteString(file.path);
+            writer.Write(file.size);
+            writer.Write(file.modified);
+            writer.Write(static_cast<std::uint32_t>(file.faces.size()));
+            for (const auto& face : file.faces) {
+                writer.Write(static_cast<std::int32_t>(face.info.faceIndex));
+                writer.WriteString(face.info.family);
+                writer.Write(face.info.weight);
+                writer.Write(static_cast<std::uint8_t>(face.info.italic ? 1 : 0));
+                writer.Write(static_cast<std::uint32_t>(face.coverage.size()));
+                for (const auto& block : face.coverage) {
+                    writer.Write(block.block);
+                    writer.Write(block.bits);
+                }
+            }
+        }
+        if (!out) {
+            return;
+        }
+    }
+    fs::rename(temporary, cachePath_, ec);
+}
+
+void FontManager::BuildIndex(std::vector<FontFile>& files) {
+    faces_.clear();
+    for (auto& file : files) {
+        for (auto& face : file.faces) {
+            faces_.push_back(std::move(face));
+        }
+    }
+
+    // 按字体族分组（保持扫描顺序）
+    std::unordered_map<std::string, std::size_t, FamilyHash, FamilyEqual> groupIndex;
+    std::vector<std::vector<FontFaceId>> groups;
+    std::vector<std::string> groupNames;
+    for (std::size_t id = 0; id < faces_.size(); ++id) {
+        const auto& family = faces_[id].info.family;
+        auto [it, inserted] = groupIndex.try_emplace(family, groups.size());
+        if (inserted) {
+            groups.emplace_back();
+            groupNames.push_back(family);
+        }
+        groups[it->second].push_back(static_cast<FontFaceId>(id));
+    }
+
+    // 每个样式槽预先选出最接近的字体：样式不符代价最大，其次是字重差
+    // （请求 500 及以上时优先更粗的字体，否则优先更细的字体）
+    families_.clear();
+    familyIndex_.clear();
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        Family family;
+        for (std::size_t slot = 0; slot < kStyleSlots; ++slot) {
+            const int weight = static_cast<int>(slot % 9 + 1) * 100;
+            const bool italic = slot >= 9;
+            FontFaceId best = -1;
+            int bestCost = 0;
+            for (FontFaceId id : groups[g]) {
+                const auto& info = faces_[id].info;
+                const int difference = static_cast<int>(info.weight) - weight;
+                int cost = std::abs(difference) * 2 + (info.italic != italic ? 10000 : 0);
+                if ((weight >= 500 && difference < 0) || (weight < 500 && difference > 0)) {
+                    cost += 1;
+                }
+                if (best < 0 || cost < bestCost) {
+                    best = id;
+                    bestCost = cost;
+                }
+            }
+            family.slots[slot] = best;
+        }
+        familyIndex_.emplace(groupNames[g], families_.size());
+        families_.push_back(family);
+    }
+
+    // 平台默认字体族；没有时使用字体最多的字体族
+    defaultFamily_ = 0;
+    bool haveDefault = false;
+    for (auto name : PreferredFamilies()) {
+        auto it = familyIndex_.find(name);
+        if (it != familyIndex_.end()) {
+            defaultFamily_ = it->second;
+            haveDefault = true;
+            break;
+        }
+    }
+    if (!haveDefault) {
+        for (std::size_t g = 0; g < groups.size(); ++g) {
+            if (groups[g].size() > groups[defaultFamily_].size()) {
+                defaultFamily_ = g;
+            }
+        }
+    }
+
+    // 通用字体族别名（不覆盖同名的真实字体族）
+    for (const auto& generic : GenericFamilies()) {
+        if (familyIndex_.find(generic.name) != familyIndex_.end()) {
+            continue;
+        }
+        std::size_t target = defaultFamily_;
+        for (auto candidate : generic.candidates) {
+            auto it = familyIndex_.find(candidate);
+            if (it != familyIndex_.end()) {
+                target = it->second;
+                break;
+            }
+        }
+        familyIndex_.emplace(std::string(generic.name), target);
+    }
+
+    // 回退顺序：平台默认字体族在前，同一字体族中常规样式在前
+    auto rankOf = [&](FontFaceId id) {
+        const auto& preferred = PreferredFamilies();
+        for (std::size_t i = 0; i < preferred.size(); ++i) {
+            if (FamilyEqual()(faces_[id].info.family, preferred[i])) {
+                return static_cast<int>(i);
+            }
+        }
+        return static_cast<int>(preferred.size());
+    };
+    fallbackOrder_.resize(faces_.size());
+    for (std::size_t id = 0; id < faces_.size(); ++id) {
+        fallbackOrder_[id] = static_cast<FontFaceId>(id);
+    }
+    std::stable_sort(fallbackOrder_.begin(), fallbackOrder_.end(), [&](FontFaceId a, FontFaceId b) {
+        const auto& fa = faces_[a].info;
+        const auto& fb = faces_[b].info;
+        return std::make_tuple(rankOf(a), fa.italic, std::abs(fa.weight - 400)) <
+               std::make_tuple(rankOf(b), fb.italic, std::abs(fb.weight - 400));
+    });
+
+    blockFaces_.assign(kBlockCount, {});
+
+    statistics_.faces = faces_.size();
+    statistics_.families = families_.size();
+}
+
+FontFaceId FontManager::Resolve(std::string_view family, int weight, bool italic) {
+    Initialize();
+    if (families_.empty()) {
+        return -1;
+    }
+    auto it = familyIndex_.find(family);
+    const std::size_t index = it != familyIndex_.end() ? it->second : defaultFamily_;
+    const int weightSlot = std::clamp((weight + 50) / 100, 1, 9) - 1;
+    return families_[index].slots[static_cast<std::size_t>(weightSlot + (italic ? 9 : 0))];
+}
+
+bool FontManager::HasCodepoint(FontFaceId face, char32_t c) const {
+    if (face < 0 || static_cast<std::size_t>(face) >= faces_.size()) {
+        return false;
+    }
+    const auto& coverage = faces_[face].coverage;
+    const auto block = static_cast<std::uint32_t>(c >> 8);
+    auto it = std::lower_bound(coverage.begin(), coverage.end(), block,
+                               [](const BlockCoverage& entry, std::uint32_t value) { return entry.block < value; });
+    return it != coverage.end() && it->block == block && (it->bits[(c >> 6) & 3] >> (c & 63)) & 1;
+}
+
+const std::vector<FontFaceId>& FontManager::BlockFaces(std::uint32_t block) {
+    static const std::vector<FontFaceId> empty;
+    if (block >= blockFaces_.size()) {
+        return empty;
+    }
+    auto& resolved = blockFaces_[block];
+    if (resolved.empty()) {
+        // 回退链：按回退优先顺序排列的、覆盖该块的字体
+        std::vector<const BlockCoverage*> chain;
+        for (FontFaceId id : fallbackOrder_) {
+            const auto& coverage = faces_[id].coverage;
+            auto it = std::lower_bound(coverage.begin(), coverage.end(), block,
+                                       [](const BlockCoverage& entry, std::uint32_t value) { return entry.block < value; });
+            if (it != coverage.end() && it->block == block) {
+                chain.push_back(&*it);
+                resolved.push_back(id);
+            }
+        }
+        // 对块内每个码点沿链找一次，之后的查找直接取表
+        std::vector<FontFaceId> faces(kCodepointsPerBlock, -1);
+        for (std::uint32_t low = 0; low < kCodepointsPerBlock; ++low) {
+            for (std::size_t i = 0; i < chain.size(); ++i) {
+                if ((chain[i]->bits[low >> 6] >> (low & 63)) & 1) {
+                    faces[low] = resolved[i];
+                    break;
+                }
+            }
+        }
+        resolved = std::move(faces);
+    }
+    return resolved;
+}
+
+FontFaceId FontManager::FindFaceForCodepoint(char32_t c, FontFaceId preferred) {
+    Initialize();
+    if (HasCodepoint(preferred, c)) {
+        return preferred;
+    }
+    // 主字体不含该字符，表中的第一个候选不会是主字体
+    const auto& faces = BlockFaces(static_cast<std::uint32_t>(c >> 8));
+    return faces.empty() ? -1 : faces[c & 0xFF];
+}
+
+const FontFaceInfo* FontManager::GetFace(FontFaceId face) const {
+    if (face < 0 || static_cast<std::size_t>(face) >= faces_.size()) {
+        return nullptr;
+    }
+    return &faces_[face].info;
+}
+
+} // namespace fk::render
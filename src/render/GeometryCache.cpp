@@ -0,0 +1,151 @@
+#include "fk/render/GeometryCache.h"
+
+#include <glad/glad.h>
+#include <limits>
+
+namespace fk::render {
+
+namespace {
+
+// 空闲条目清理间隔（帧），避免每帧遍历整个缓存
+constexpr std::uint64_t kSweepInterval = 60;
+
+// 每个顶点 (x, y, u, v)
+constexpr int kFloatsPerVertex = 4;
+
+} // namespace
+
+GeometryCache::GeometryCache(std::size_t maxBytes, std::uint64_t maxIdleFrames)
+    : maxBytes_(maxBytes)
+    , maxIdleFrames_(maxIdleFrames) {
+}
+
+GeometryCache::~GeometryCache() {
+    Clear();
+}
+
+void GeometryCache::Clear() {
+    for (auto& [key, geometry] : entries_) {
+        Release(geometry);
+    }
+    entries_.clear();
+    byteSize_ = 0;
+}
+
+const CachedGeometry* GeometryCache::Find(std::uint64_t key) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+    it->second.lastUsedFrame = frame_;
+    return &it->second;
+}
+
+const CachedGeometry* GeometryCache::Insert(std::uint64_t key,
+                                            const std::vector<float>& fillVertices,
+                                            const std::vector<float>& strokeVertices,
+                                            std::vector<CachedStrokeBatch> strokeBatches) {
+    if (fillVertices.empty() && strokeVertices.empty()) {
+        return nullptr;
+    }
+
+    auto existing = entries_.find(key);
+    if (existing != entries_.end()) {
+        byteSize_ -= existing->second.byteSize;
+        Release(existing->second);
+        entries_.erase(existing);
+    }
+
+    CachedGeometry geometry;
+    geometry.fillFirst = 0;
+    geometry.fillCount = static_cast<int>(fillVertices.size() / kFloatsPerVertex);
+    geometry.strokeBatches = std::move(strokeBatches);
+    for (auto& batch : geometry.strokeBatches) {
+        batch.first += geometry.fillCount;
+    }
+    geometry.byteSize = (fillVertices.size() + strokeVertices.size()) * sizeof(float);
+    geometry.lastUsedFrame = frame_;
+
+    glGenVertexArrays(1, &geometry.vao);
+    glGenBuffers(1, &geometry.vbo);
+    glBindVertexArray(geometry.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.vbo);
+
+    // 填充与描边顶点放在同一个静态缓冲区中
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(geometry.byteSize), nullptr, GL_STATIC_DRAW);
+    const auto fillBytes = static_cast<GLsizeiptr>(fillVertices.size() * sizeof(float));
+    if (!fillVertices.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, fillBytes, fillVertices.data());
+    }
+    if (!strokeVertices.empty()) {
+        glBufferSubData(GL_ARRAY_BUFFER, fillBytes,
+                        static_cast<GLsizeiptr>(strokeVertices.size() * sizeof(float)),
+                        strokeVertices.data());
+    }
+
+    // 与 GlRenderer::InitializeBuffers 中的顶点布局一致
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, kFloatsPerVertex * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, kFloatsPerVertex * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    byteSize_ += geometry.byteSize;
+    auto [it, inserted] = entries_.emplace(key, std::move(geometry));
+
+    EvictToBudget();
+    return &it->second;
+}
+
+void GeometryCache::BeginFrame() {
+    ++frame_;
+    if (frame_ % kSweepInterval != 0) {
+        return;
+    }
+
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.lastUsedFrame + maxIdleFrames_ < frame_) {
+            byteSize_ -= it->second.byteSize;
+            Release(it->second);
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void GeometryCache::EvictToBudget() {
+    while (byteSize_ > maxBytes_) {
+        // 查找当前帧之前最久未使用的条目
+        auto victim = entries_.end();
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->second.lastUsedFrame < frame_ && it->second.lastUsedFrame < oldest) {
+                oldest = it->second.lastUsedFrame;
+                victim = it;
+            }
+        }
+        if (victim == entries_.end()) {
+            // 所有条目都在当前帧使用中，只能暂时超出上限
+            return;
+        }
+        byteSize_ -= victim->second.byteSize;
+        Release(victim->second);
+        entries_.erase(victim);
+    }
+}
+
+void GeometryCache::Release(CachedGeometry& geometry) {
+    if (geometry.vbo != 0) {
+        glDeleteBuffers(1, &geometry.vbo);
+        geometry.vbo = 0;
+    }
+    if (geometry.vao != 0) {
+        glDeleteVertexArrays(1, &geometry.vao);
+        geometry.vao = 0;
+    }
+}
+
+} // namespace fk::render
@@ -3,13 +3,17 @@
 #include "fk/render/RenderCommandBuffer.h"
 #include "fk/render/RenderCommand.h"
 #include "fk/render/TextRenderer.h"
+#include "fk/render/TextureManager.h"
 
 #include <glad/glad.h>
+#ifdef FK_HAS_GLFW
 #include <GLFW/glfw3.h>
+#endif
 #include <tesselator.h>
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <bit>
 #include <iostream>
 #include <iostream>
 #include <unordered_map>
@@ -26,10 +30,11 @@ out vec2 vTexCoord;
 out vec2 vFragPos;
 
 uniform vec2 uViewport;
+uniform vec2 uMeshOrigin;  // 缓存网格的原点（其他图元为 0）
 
 void main() {
-    // aPos 已经是全局坐标，不需要再加 uOffset
-    vec2 pos = aPos;
+    // aPos 已经是全局坐标，不需要再加 uOffset；缓存的几何网格使用相对坐标
+    vec2 pos = aPos + uMeshOrigin;
     // 转换到 NDC (-1 到 1)
     vec2 ndc = (pos / uViewport) * 2.0 - 1.0;
     ndc.y = -ndc.y; // 翻转 Y 轴
@@ -41,7 +46,8 @@ void main() {
 )";
 
 // Border 的片段着色器（圆形圆角，四个独立半径）
-const char* borderFragmentShaderSource = R"(
+// 参数声明与着色器主体分开，实例化版本只替换参数来源
+const char* borderFragmentUniformsSource = R"(
 #version 330 core
 in vec2 vTexCoord;
 in vec2 vFragPos;
@@ -56,7 +62,34 @@ uniform float uAAWidth;       // 抗锯齿宽度
 uniform float uOpacity;
 uniform vec4 uCornerRadius;   // 四个圆角：x=topLeft, y=topRight, z=bottomRight, w=bottomLeft
 uniform vec2 uRectSize;
+)";
+
+// Phase 5.1: 实例化 Border 的参数来源（逐实例属性，经顶点着色器以 flat 传入）
+const char* borderFragmentInstanceInputsSource = R"(
+#version 330 core
+in vec2 vTexCoord;
+in vec2 vFragPos;
+
+flat in vec4 vColor;
+flat in vec4 vStrokeColor;
+flat in vec4 vCornerRadius;
+flat in vec4 vStrokeParams;   // x = 描边宽度, y = strokeInset, z = strokeOutset, w = 抗锯齿宽度
+flat in vec2 vRectSize;
+
+out vec4 FragColor;
+
+uniform float uOpacity;
+
+#define uColor vColor
+#define uStrokeColor vStrokeColor
+#define uStrokeWidth vStrokeParams.x
+#define uStrokeAlignment vStrokeParams.yz
+#define uAAWidth vStrokeParams.w
+#define uCornerRadius vCornerRadius
+#define uRectSize vRectSize
+)";
 
+const char* borderFragmentBodySource = R"(
 // 圆形圆角的 SDF
 float roundedBoxSDF(vec2 p, vec2 size, vec4 radius) {
     // 根据象限选择对应的圆角半径
@@ -126,6 +159,45 @@ void main() {
 }
 )";
 
+// Phase 5.1: 实例化矩形的顶点着色器
+// 每个顶点只有单位四边形角点，矩形参数来自逐实例属性
+const char* rectInstanceVertexShaderSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aCorner;        // 单位四边形角点 (0..1)
+layout (location = 1) in vec4 iRect;          // x, y, width, height（全局坐标）
+layout (location = 2) in vec4 iFillColor;
+layout (location = 3) in vec4 iStrokeColor;
+layout (location = 4) in vec4 iCornerRadius;  // 已按边长限制的四个圆角半径
+layout (location = 5) in vec4 iStrokeParams;  // 描边宽度, inset, outset, 抗锯齿宽度
+
+out vec2 vTexCoord;
+out vec2 vFragPos;
+flat out vec4 vColor;
+flat out vec4 vStrokeColor;
+flat out vec4 vCornerRadius;
+flat out vec4 vStrokeParams;
+flat out vec2 vRectSize;
+
+uniform vec2 uViewport;
+
+void main() {
+    vec2 local = aCorner * iRect.zw;
+    vec2 pos = iRect.xy + local;
+    // 转换到 NDC (-1 到 1)
+    vec2 ndc = (pos / uViewport) * 2.0 - 1.0;
+    ndc.y = -ndc.y; // 翻转 Y 轴
+    gl_Position = vec4(ndc, 0.0, 1.0);
+    
+    vTexCoord = local;
+    vFragPos = local;  // 局部坐标 (0,0 到 w,h)
+    vColor = iFillColor;
+    vStrokeColor = iStrokeColor;
+    vCornerRadius = iCornerRadius;
+    vStrokeParams = iStrokeParams;
+    vRectSize = iRect.zw;
+}
+)";
+
 // Rectangle 的片段着色器(椭圆圆角,radiusX 和 radiusY)
 const char* rectangleFragmentShaderSource = R"(
 #version 330 core
@@ -372,6 +444,7 @@ uniform sampler2D text;
 uniform vec4 textColor;
 uniform float uOpacity;
 uniform bool isColorTexture;  // 是否为彩色纹理（emoji）
+uniform float uSdfRange;      // 距离场字形：距离值 ±128 对应的屏幕像素数（0 表示位图字形）
 
 void main() {
     vec4 texSample = texture(text, TexCoords);
@@ -381,12 +454,159 @@ void main() {
         color = vec4(texSample.rgb, texSample.a * uOpacity);
     } else {
         // 普通灰度文本：使用文本颜色
-        vec4 sampled = vec4(1.0, 1.0, 1.0, texSample.r);
+        float coverage = texSample.r;
+        if (uSdfRange > 0.0) {
+            // 距离场：128 为轮廓，按屏幕像素距离做 1 像素宽的抗锯齿
+            float distance = (texSample.r * 255.0 - 128.0) / 128.0 * uSdfRange;
+            coverage = clamp(distance + 0.5, 0.0, 1.0);
+        }
+        vec4 sampled = vec4(1.0, 1.0, 1.0, coverage);
         color = vec4(textColor.rgb, textColor.a * uOpacity) * sampled;
     }
 }
 )";
 
+// Phase 5.1: 图像的片段着色器（顶点着色器与文本共用）
+const char* imageFragmentShaderSource = R"(
+#version 330 core
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D image;
+uniform vec4 uTint;
+uniform float uOpacity;
+
+void main() {
+    vec4 texSample = texture(image, TexCoords) * uTint;
+    color = vec4(texSample.rgb, texSample.a * uOpacity);
+}
+)";
+
+namespace {
+
+// 几何缓存键的类型标记
+constexpr std::uint64_t kPolygonGeometryTag = 1;
+constexpr std::uint64_t kPathGeometryTag = 2;
+
+// 实例化矩形每个实例的 float 数量：rect(4) + fill(4) + stroke(4) + radius(4) + stroke params(4)
+constexpr int kRectInstanceFloats = 20;
+
+/**
+ * @brief 是否使用椭圆圆角（Rectangle Shape），这类矩形不参与实例化
+ */
+bool HasEllipseCorners(const RectanglePayload& payload) {
+    return payload.radiusX > 0.0001f || payload.radiusY > 0.0001f;
+}
+
+/**
+ * @brief 绘制命令是否完全位于损坏区域之外
+ */
+bool IsOutsideDamage(const RenderCommand& cmd, const ui::Rect* damage) {
+    if (!damage) {
+        return false;
+    }
+    // 状态命令（裁剪、变换、图层）总是执行
+    ui::Rect bounds;
+    return GetCommandBounds(cmd, bounds) && !bounds.Intersects(*damage);
+}
+
+// Phase 5.1: 离屏图层
+constexpr int kMaxCachedLayerSize = 4096;          // 超过此尺寸的缓存图层退化为普通图层（只绘制可见部分）
+constexpr int kLayerTargetGranularity = 128;       // 图层池目标尺寸的取整粒度
+constexpr std::uint64_t kLayerTargetIdleFrames = 60;   // 图层池目标的空闲释放帧数
+constexpr std::uint64_t kCachedLayerIdleFrames = 600;  // 缓存位图的空闲释放帧数
+
+/**
+ * @brief 默认混合：颜色按 SRC_ALPHA / ONE_MINUS_SRC_ALPHA 混合，alpha 按 ONE / ONE_MINUS_SRC_ALPHA 累积
+ * 
+ * 绘制到透明的离屏图层时得到预乘 alpha 的结果，合成时使用 ONE / ONE_MINUS_SRC_ALPHA
+ */
+void SetDefaultBlend() {
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+/**
+ * @brief 几何缓存键（FNV-1a 64 位哈希）
+ */
+class GeometryKeyHasher {
+public:
+    void Add(std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash_ ^= (value >> (i * 8)) & 0xFF;
+            hash_ *= 1099511628211ull;
+        }
+    }
+    
+    // 坐标按 1/256 像素量化，平移带来的浮点误差不会导致缓存未命中
+    void AddCoord(float value) {
+        Add(static_cast<std::uint64_t>(std::llround(static_cast<double>(value) * 256.0)));
+    }
+    
+    void AddFloat(float value) {
+        Add(std::bit_cast<std::uint32_t>(value));
+    }
+    
+    std::uint64_t Get() const { return hash_; }
+    
+private:
+    std::uint64_t hash_{14695981039346656037ull};
+};
+
+/**
+ * @brief 使用 libtess2 三角剖分单个轮廓，支持任意复杂多边形
+ * @param out 输出 (x, y, u, v) 顶点
+ * @return tesselator 是否创建成功
+ */
+bool TessellateContour(const std::vector<ui::Point>& points, std::vector<float>& out) {
+    TESStesselator* tess = tessNewTess(nullptr);
+    if (!tess) {
+        return false;
+    }
+    
+    // 准备顶点数据（libtess2 需要连续的坐标数组）
+    std::vector<TESSreal> coords;
+    coords.reserve(points.size() * 2);
+    for (const auto& pt : points) {
+        coords.push_back(static_cast<TESSreal>(pt.x));
+        coords.push_back(static_cast<TESSreal>(pt.y));
+    }
+    
+    // 添加轮廓到 tesselator
+    tessAddContour(tess, 2, coords.data(), sizeof(TESSreal) * 2, static_cast<int>(points.size()));
+    
+    // 执行三角剖分 - 使用 TESS_WINDING_NONZERO 对顺时针/逆时针都有效
+    int result = tessTesselate(tess, TESS_WINDING_NONZERO, TESS_POLYGONS, 3, 2, nullptr);
+    
+    if (result) {
+        // 获取剖分结果
+        const TESSreal* tessVerts = tessGetVertices(tess);
+        const TESSindex* tessElements = tessGetElements(tess);
+        int numElements = tessGetElementCount(tess);
+        
+        // 将三角形转换为顶点数组
+        out.reserve(out.size() + numElements * 3 * 4);  // 每个三角形3个顶点，每个顶点4个float
+        
+        for (int i = 0; i < numElements; ++i) {
+            const TESSindex* tri = &tessElements[i * 3];
+            
+            for (int j = 0; j < 3; ++j) {
+                TESSindex idx = tri[j];
+                if (idx == TESS_UNDEF) continue;
+                
+                out.push_back(static_cast<float>(tessVerts[idx * 2]));
+                out.push_back(static_cast<float>(tessVerts[idx * 2 + 1]));
+                out.push_back(0.0f);  // 纹理坐标 u
+                out.push_back(0.0f);  // 纹理坐标 v
+            }
+        }
+    }
+    
+    tessDeleteTess(tess);
+    return true;
+}
+
+} // namespace
+
 GlRenderer::GlRenderer() = default;
 
 GlRenderer::~GlRenderer() {
@@ -395,13 +615,26 @@ GlRenderer::~GlRenderer() {
     }
 }
 
+GlyphMetricsProvider* GlRenderer::GetGlyphMetrics() const {
+    return textRenderer_.get();
+}
+
 void GlRenderer::Initialize(const RendererInitParams& params) {
     if (initialized_) {
         throw std::runtime_error("GlRenderer already initialized");
     }
 
-    // 初始化 GLAD
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+    // 初始化 GLAD：优先使用调用方提供的加载器，无头构建不依赖 GLFW
+    GLADloadproc procLoader = params.glProcLoader;
+#ifdef FK_HAS_GLFW
+    if (!procLoader) {
+        procLoader = reinterpret_cast<GLADloadproc>(glfwGetProcAddress);
+    }
+#endif
+    if (!procLoader) {
+        throw std::runtime_error("GlRenderer requires an OpenGL proc loader");
+    }
+    if (!gladLoadGLLoader(procLoader)) {
         throw std::runtime_error("Failed to initialize GLAD");
     }
 
@@ -412,7 +645,7 @@ void GlRenderer::Initialize(const RendererInitParams& params) {
 
     // 启用混合
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    SetDefaultBlend();
     
     // 启用多重采样抗锯齿 (MSAA)
     glEnable(GL_MULTISAMPLE);
@@ -429,47 +662,10 @@ void GlRenderer::Initialize(const RendererInitParams& params) {
 
     // 初始化文本渲染器
     textRenderer_ = std::make_unique<TextRenderer>();
+    textRenderer_->SetGlyphRenderMode(params.glyphRenderMode);
+    // Phase 5.1: 字体与 emoji/符号回退由 FontManager 按码位块解析，不再预加载回退字体
     if (!textRenderer_->Initialize()) {
         std::cerr << "WARNING: Failed to initialize TextRenderer" << std::endl;
-    } else {
-        // 加载 emoji/symbol fallback 字体
-        #ifdef _WIN32
-            // Windows 字体 - 使用彩色 emoji 字体
-            std::vector<std::string> fallbackFontPaths = {
-                "C:/Windows/Fonts/seguiemj.ttf",       // Segoe UI Emoji (彩色 emoji)
-                "C:/Windows/Fonts/seguisym.ttf",       // Segoe UI Symbol (符号支持)
-                "C:/Windows/Fonts/symbol.ttf"          // Symbol 字体
-            };
-        #elif __APPLE__
-            // macOS 字体
-            std::vector<std::string> fallbackFontPaths = {
-                "/System/Library/Fonts/Apple Color Emoji.ttc",
-                "/System/Library/Fonts/Supplemental/Arial Unicode.ttf"
-            };
-        #else
-            // Linux 字体
-            std::vector<std::string> fallbackFontPaths = {
-                "/usr/share/fonts/truetype/noto/NotoColorEmoji.ttf",
-                "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-                "/usr/share/fonts/truetype/ancient-scripts/Symbola.ttf"
-            };
-        #endif
-        
-        // 尝试加载 fallback 字体
-        for (const auto& path : fallbackFontPaths) {
-            // 只加载几个常用大小
-            bool loadedThisFont = false;
-            for (unsigned int size : {14, 16, 20, 24}) {
-                int fontId = textRenderer_->LoadFont(path, size);
-                if (fontId >= 0) {
-                    textRenderer_->AddFallbackFont(fontId);
-                    if (!loadedThisFont) {
-                        std::cout << "Loaded fallback font: " << path << std::endl;
-                        loadedThisFont = true;
-                    }
-                }
-            }
-        }
     }
 
     // 注意：不再需要初始化 uniform 值
@@ -486,26 +682,41 @@ void GlRenderer::Resize(const Extent2D& size) {
 void GlRenderer::BeginFrame(const FrameContext& ctx) {
     currentFrame_ = ctx;
 
-    // 清空颜色缓冲区
+    // Phase 5.1: 推进字形图集的 LRU 帧计数
+    if (textRenderer_) {
+        textRenderer_->BeginFrame();
+    }
+    geometryCache_.BeginFrame();
+
+    // Phase 5.1: 绘制到持久化离屏目标，未损坏区域保留上一帧内容
+    bool targetRecreated = EnsureSceneTarget();
+    fullRedraw_ = ctx.fullRedraw || targetRecreated || sceneFBO_ == 0;
+    damageRects_ = ctx.damageRects;
+    hasDamageScissor_ = false;
+    ++frameIndex_;
+    
+    // 重置状态（绑定场景目标）
+    currentOffsetX_ = 0.0f;
+    currentOffsetY_ = 0.0f;
+    ResetLayerState();
+    
     glClearColor(
         ctx.clearColor[0],
         ctx.clearColor[1],
         ctx.clearColor[2],
         ctx.clearColor[3]
     );
-    glClear(GL_COLOR_BUFFER_BIT);
-
-    // 重置状态
-    currentOffsetX_ = 0.0f;
-    currentOffsetY_ = 0.0f;
-    layerStack_.clear();
-    layerStack_.push_back({1.0f}); // 根图层不透明度为 1
+    if (fullRedraw_) {
+        // 清空颜色缓冲区（损坏区域在 Draw 中逐个清除）
+        glDisable(GL_SCISSOR_TEST);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
 
     // 设置 OpenGL 状态（2D渲染）
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_CULL_FACE);
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    SetDefaultBlend();
 
     // 注意：不再在 BeginFrame 设置着色器程序
     // 每个 Draw 调用会根据需要切换着色器（Border 或 Rectangle）
@@ -516,19 +727,83 @@ void GlRenderer::Draw(const RenderList& list) {
         return;
     }
 
-    if (list.IsEmpty()) {
+    // 空列表在脏矩形模式下仍需清除损坏区域
+    if (list.IsEmpty() && fullRedraw_) {
+        return;
+    }
+
+    if (fullRedraw_) {
+        ExecuteCommands(list, nullptr);
+        ResetLayerState();
         return;
     }
+    
+    // Phase 5.1: 脏矩形重绘 - 每个损坏区域单独裁剪、清除并重放相交的命令
+    for (const auto& damage : damageRects_) {
+        hasDamageScissor_ = true;
+        damageScissor_ = damage;
+        
+        // 每个区域从根状态开始重放
+        currentOffsetX_ = 0.0f;
+        currentOffsetY_ = 0.0f;
+        ResetLayerState();
+        ApplyClip(ClipPayload{ui::Rect{}, false});
+        
+        glClear(GL_COLOR_BUFFER_BIT);
+        
+        // 剔除与损坏区域不相交的绘制命令
+        ExecuteCommands(list, &damage);
+    }
+    
+    hasDamageScissor_ = false;
+    ResetLayerState();
+    glDisable(GL_SCISSOR_TEST);
+}
 
-    // 直接使用 RenderList 的 GetCommands() 方法
+void GlRenderer::ExecuteCommands(const RenderList& list, const ui::Rect* damage) {
     const auto& commands = list.GetCommands();
+    const auto& batches = list.GetBatches();
+    
+    // 批次未构建或构建后又添加了命令时逐条执行
+    bool batchesValid = !batches.empty() &&
+        batches.back().startIndex + batches.back().count == commands.size();
+    
+    // 缓存位图需要完整的图层内容，绘制期间不按损坏区域剔除
+    auto activeDamage = [&]() { return cachedLayerDepth_ > 0 ? nullptr : damage; };
+    if (!batchesValid) {
+        for (const auto& cmd : commands) {
+            if (!IsOutsideDamage(cmd, activeDamage())) {
+                ExecuteCommand(cmd);
+            }
+        }
+        return;
+    }
     
-    for (const auto& cmd : commands) {
-        ExecuteCommand(cmd);
+    // Phase 5.1: 连续的矩形命令之间没有裁剪/图层变化，合并为一次实例化绘制
+    for (const auto& batch : batches) {
+        const RenderCommand* first = commands.data() + batch.startIndex;
+        if (batch.type == CommandType::DrawRectangle && batch.count > 1) {
+            if (skipDepth_ == 0) {
+                DrawRectangleBatch(first, batch.count, activeDamage());
+            }
+            continue;
+        }
+        for (size_t i = 0; i < batch.count; ++i) {
+            if (!IsOutsideDamage(first[i], activeDamage())) {
+                ExecuteCommand(first[i]);
+            }
+        }
     }
 }
 
 void GlRenderer::EndFrame() {
+    // Phase 5.1: 将离屏目标呈现到默认帧缓冲
+    PresentSceneTarget();
+    TrimLayerTargets();
+
+    // Phase 5.1: 纹理超出显存预算时淘汰本帧未使用的纹理
+    TextureManager::Instance().EndFrame();
+    
     // OpenGL 自动交换缓冲区由 GLFW 处理
     // 这里只需要解绑资源
     glUseProgram(0);
@@ -543,6 +818,16 @@ void GlRenderer::Shutdown() {
 }
 
 void GlRenderer::ExecuteCommand(const RenderCommand& cmd) {
+    // Phase 5.1: 跳过缓存命中或空图层内的命令，直到对应的 PopLayer
+    if (skipDepth_ > 0) {
+        if (cmd.type == CommandType::PushLayer) {
+            ++skipDepth_;
+        } else if (cmd.type == CommandType::PopLayer && --skipDepth_ == 0) {
+            PopLayer();
+        }
+        return;
+    }
+
     switch (cmd.type) {
         case CommandType::SetClip:
             if (std::holds_alternative<ClipPayload>(cmd.payload)) {
@@ -599,33 +884,191 @@ void GlRenderer::ExecuteCommand(const RenderCommand& cmd) {
 }
 
 void GlRenderer::ApplyClip(const ClipPayload& payload) {
+    currentClipRect_ = payload.clipRect;
+    currentClipEnabled_ = payload.enabled;
+    
+    // 离屏图层在合成时才受损坏区域限制
+    const bool damageScissor = hasDamageScissor_ && offscreenDepth_ == 0;
     if (payload.enabled) {
-        // 启用裁切
-        glEnable(GL_SCISSOR_TEST);
-        
-        // 计算裁切区域 (需要转换为窗口坐标系)
-        // OpenGL 的裁切坐标系原点在左下角,Y 轴向上
         // clipRect 已经是全局坐标，不需要再加 currentOffset
-        float x = payload.clipRect.x;
-        float y = viewportSize_.height - (payload.clipRect.y + payload.clipRect.height);
-        float width = payload.clipRect.width;
-        float height = payload.clipRect.height;
-        
-        // 确保裁切区域有效
-        if (width > 0 && height > 0) {
-            glScissor(
-                static_cast<GLint>(x),
-                static_cast<GLint>(y),
-                static_cast<GLsizei>(width),
-                static_cast<GLsizei>(height)
-            );
-        }
+        // 重绘损坏区域时还要与损坏区域求交
+        SetScissorRect(damageScissor ? payload.clipRect.Intersect(damageScissor_) : payload.clipRect);
+    } else if (damageScissor) {
+        // 无元素裁剪时仍然限制在损坏区域内
+        SetScissorRect(damageScissor_);
     } else {
         // 禁用裁切
         glDisable(GL_SCISSOR_TEST);
     }
 }
 
+void GlRenderer::SetScissorRect(const ui::Rect& rect) {
+    // 启用裁切
+    glEnable(GL_SCISSOR_TEST);
+    
+    if (rect.IsEmpty()) {
+        // 完全被裁掉
+        glScissor(0, 0, 0, 0);
+        return;
+    }
+    
+    // 计算裁切区域 (需要转换为绘制目标的坐标系)
+    // OpenGL 的裁切坐标系原点在左下角,Y 轴向上；离屏图层的原点在图层左上角
+    float x = rect.x - currentTarget_.originX;
+    float y = currentTarget_.height - (rect.y - currentTarget_.originY + rect.height);
+    glScissor(
+        static_cast<GLint>(x),
+        static_cast<GLint>(y),
+        static_cast<GLsizei>(rect.width),
+        static_cast<GLsizei>(rect.height)
+    );
+}
+
+bool GlRenderer::EnsureSceneTarget() {
+    if (viewportSize_.width == 0 || viewportSize_.height == 0) {
+        return false;
+    }
+    if (sceneFBO_ != 0 &&
+        sceneSize_.width == viewportSize_.width &&
+        sceneSize_.height == viewportSize_.height) {
+        return false;
+    }
+    
+    ReleaseSceneTarget();
+    sceneSize_ = viewportSize_;
+    const auto width = static_cast<GLsizei>(sceneSize_.width);
+    const auto height = static_cast<GLsizei>(sceneSize_.height);
+    
+    // 与默认帧缓冲保持相同的采样数，保证多边形等图元的 MSAA 质量不变
+    GLint samples = 0;
+    GLint maxSamples = 0;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glGetIntegerv(GL_SAMPLES, &samples);
+    glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    samples = std::min(samples, maxSamples);
+    
+    // 单采样颜色纹理：呈现时作为纹理采样
+    glGenTextures(1, &sceneColorTexture_);
+    glBindTexture(GL_TEXTURE_2D, sceneColorTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    glGenFramebuffers(1, &sceneFBO_);
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColorTexture_, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    
+    if (complete && samples > 1) {
+        glGenRenderbuffers(1, &sceneMsaaColorRB_);
+        glBindRenderbuffer(GL_RENDERBUFFER, sceneMsaaColorRB_);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        
+        glGenFramebuffers(1, &sceneMsaaFBO_);
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneMsaaFBO_);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, sceneMsaaColorRB_);
+        complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    }
+    
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    
+    if (!complete) {
+        // 回退到直接绘制默认帧缓冲（每帧整帧重绘）
+        std::cerr << "GlRenderer: offscreen scene target incomplete, falling back to full redraw" << std::endl;
+        ReleaseSceneTarget();
+    }
+    return true;
+}
+
+void GlRenderer::ReleaseSceneTarget() {
+    if (sceneMsaaFBO_ != 0) {
+        glDeleteFramebuffers(1, &sceneMsaaFBO_);
+        sceneMsaaFBO_ = 0;
+    }
+    if (sceneMsaaColorRB_ != 0) {
+        glDeleteRenderbuffers(1, &sceneMsaaColorRB_);
+        sceneMsaaColorRB_ = 0;
+    }
+    if (sceneFBO_ != 0) {
+        glDeleteFramebuffers(1, &sceneFBO_);
+        sceneFBO_ = 0;
+    }
+    if (sceneColorTexture_ != 0) {
+        glDeleteTextures(1, &sceneColorTexture_);
+        sceneColorTexture_ = 0;
+    }
+    sceneSize_ = {};
+}
+
+void GlRenderer::PresentSceneTarget() {
+    if (sceneFBO_ == 0) {
+        return;
+    }
+    
+    const auto width = static_cast<GLint>(sceneSize_.width);
+    const auto height = static_cast<GLint>(sceneSize_.height);
+    glDisable(GL_SCISSOR_TEST);
+    
+    // 解析多重采样目标（只需解析本帧改变的区域）
+    if (sceneMsaaFBO_ != 0) {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneMsaaFBO_);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, sceneFBO_);
+        if (fullRedraw_) {
+            glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        } else {
+            for (const auto& damage : damageRects_) {
+                GLint x0 = static_cast<GLint>(damage.x);
+                GLint y0 = height - static_cast<GLint>(damage.Bottom());
+                GLint x1 = static_cast<GLint>(damage.Right());
+                GLint y1 = height - static_cast<GLint>(damage.y);
+                glBlitFramebuffer(x0, y0, x1, y1, x0, y0, x1, y1, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+            }
+        }
+    }
+    
+    // 默认帧缓冲可能是多重采样的，不能直接 blit，用全屏四边形拷贝
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, width, height);
+    glDisable(GL_BLEND);
+    
+    glUseProgram(textShaderProgram_);
+    glUniform2f(glGetUniformLocation(textShaderProgram_, "uViewport"),
+                static_cast<float>(width), static_cast<float>(height));
+    glUniform4f(glGetUniformLocation(textShaderProgram_, "textColor"), 1.0f, 1.0f, 1.0f, 1.0f);
+    glUniform1f(glGetUniformLocation(textShaderProgram_, "uOpacity"), 1.0f);
+    glUniform1i(glGetUniformLocation(textShaderProgram_, "isColorTexture"), 1);
+    glUniform1i(glGetUniformLocation(textShaderProgram_, "text"), 0);
+    
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sceneColorTexture_);
+    
+    // 帧缓冲纹理的原点在左下角，V 坐标需要翻转
+    const float w = static_cast<float>(width);
+    const float h = static_cast<float>(height);
+    float vertices[6][4] = {
+        { 0.0f, h,    0.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f },
+        { w,    0.0f, 1.0f, 1.0f },
+        
+        { 0.0f, h,    0.0f, 0.0f },
+        { w,    0.0f, 1.0f, 1.0f },
+        { w,    h,    1.0f, 0.0f }
+    };
+    
+    glBindVertexArray(textVAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, textVBO_);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glEnable(GL_BLEND);
+}
+
 void GlRenderer::ApplyTransform(const TransformPayload& payload) {
     currentOffsetX_ = payload.offsetX;
     currentOffsetY_ = payload.offsetY;
@@ -636,17 +1079,21 @@ void GlRenderer::ApplyTransform(const TransformPayload& payload) {
 }
 
 void GlRenderer::DrawRectangle(const RectanglePayload& payload) {
+    // 圆形圆角（Border）走实例化路径，单个矩形即一个实例
+    if (!HasEllipseCorners(payload)) {
+        AppendRectangleInstance(payload);
+        FlushRectangleInstances();
+        return;
+    }
+    
+    // 椭圆圆角（Rectangle Shape）使用单独的着色器
     // 绑定 VAO
     glBindVertexArray(vao_);
 
     const float width = payload.rect.width;
     const float height = payload.rect.height;
-    const float minDimension = std::min(width, height);
-    const float halfMinDimension = std::max(0.0f, minDimension * 0.5f);
 
-    // 根据是否有椭圆圆角选择着色器
-    bool hasEllipseCorners = (payload.radiusX > 0.0001f || payload.radiusY > 0.0001f);
-    unsigned int shaderProgram = hasEllipseCorners ? rectangleShaderProgram_ : borderShaderProgram_;
+    unsigned int shaderProgram = rectangleShaderProgram_;
     glUseProgram(shaderProgram);
 
     // 设置视口 uniform
@@ -672,54 +1119,9 @@ void GlRenderer::DrawRectangle(const RectanglePayload& payload) {
     int rectSizeLoc = glGetUniformLocation(shaderProgram, "uRectSize");
     glUniform2f(rectSizeLoc, width, height);
 
-    if (hasEllipseCorners) {
-        // Rectangle 着色器：只设置椭圆圆角半径
-        int cornerRadiusXYLoc = glGetUniformLocation(shaderProgram, "uCornerRadiusXY");
-        glUniform2f(cornerRadiusXYLoc, payload.radiusX, payload.radiusY);
-    } else {
-        // Border 着色器：设置四个独立圆角半径
-        // 设置圆角半径（需要检查相邻圆角之和不超过对应边长）
-        // 参考 CSS 规范：https://www.w3.org/TR/css-backgrounds-3/#corner-overlap
-        float topLeft = std::max(0.0f, payload.cornerRadiusTopLeft);
-        float topRight = std::max(0.0f, payload.cornerRadiusTopRight);
-        float bottomRight = std::max(0.0f, payload.cornerRadiusBottomRight);
-        float bottomLeft = std::max(0.0f, payload.cornerRadiusBottomLeft);
-        
-        // 计算每条边上相邻圆角的和
-        float topSum = topLeft + topRight;      // 上边
-        float rightSum = topRight + bottomRight; // 右边
-        float bottomSum = bottomRight + bottomLeft; // 下边
-        float leftSum = bottomLeft + topLeft;    // 左边
-        
-        // 计算缩放因子：如果相邻圆角之和超过边长，需要按比例缩小
-        float scaleX = 1.0f;
-        float scaleY = 1.0f;
-        
-        if (topSum > width && topSum > 0.0f) {
-            scaleX = std::min(scaleX, width / topSum);
-        }
-        if (bottomSum > width && bottomSum > 0.0f) {
-            scaleX = std::min(scaleX, width / bottomSum);
-        }
-        if (leftSum > height && leftSum > 0.0f) {
-            scaleY = std::min(scaleY, height / leftSum);
-        }
-        if (rightSum > height && rightSum > 0.0f) {
-            scaleY = std::min(scaleY, height / rightSum);
-        }
-        
-        // 使用最严格的缩放因子（水平和垂直方向取最小值）
-        float scale = std::min(scaleX, scaleY);
-        
-        // 应用缩放并限制在合理范围内
-        float clampedTopLeft = std::clamp(topLeft * scale, 0.0f, halfMinDimension);
-        float clampedTopRight = std::clamp(topRight * scale, 0.0f, halfMinDimension);
-        float clampedBottomRight = std::clamp(bottomRight * scale, 0.0f, halfMinDimension);
-        float clampedBottomLeft = std::clamp(bottomLeft * scale, 0.0f, halfMinDimension);
-        
-        int cornerRadiusLoc = glGetUniformLocation(shaderProgram, "uCornerRadius");
-        glUniform4f(cornerRadiusLoc, clampedTopLeft, clampedTopRight, clampedBottomRight, clampedBottomLeft);
-    }
+    // Rectangle 着色器：只设置椭圆圆角半径
+    int cornerRadiusXYLoc = glGetUniformLocation(shaderProgram, "uCornerRadiusXY");
+    glUniform2f(cornerRadiusXYLoc, payload.radiusX, payload.radiusY);
 
     // 构建矩形顶点（两个三角形，每个顶点包含位置和纹理坐标）
     float x = payload.rect.x;
@@ -744,6 +1146,85 @@ void GlRenderer::DrawRectangle(const RectanglePayload& payload) {
     glBindBuffer(GL_ARRAY_BUFFER, vbo_);
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
+    // 设置描边相关 uniform（描边仅向内）
+    int strokeColorLoc = glGetUniformLocation(shaderProgram, "uStrokeColor");
+    glUniform4f(strokeColorLoc,
+        payload.strokeColor[0],
+        payload.strokeColor[1],
+        payload.strokeColor[2],
+        payload.strokeColor[3]);
+
+    int strokeWidthLoc = glGetUniformLocation(shaderProgram, "uStrokeWidth");
+    glUniform1f(strokeWidthLoc, payload.strokeThickness);
+
+    int aaLoc = glGetUniformLocation(shaderProgram, "uAAWidth");
+    float aaWidth = std::clamp(payload.aaWidth, 0.1f, 2.0f);
+    glUniform1f(aaLoc, aaWidth);
+
+    // 单次绘制：片段着色器基于 SDF 计算填充与描边
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    // 解绑
+    glBindVertexArray(0);
+}
+
+void GlRenderer::DrawRectangleBatch(const RenderCommand* commands, size_t count, const ui::Rect* damage) {
+    for (size_t i = 0; i < count; ++i) {
+        const auto* payload = std::get_if<RectanglePayload>(&commands[i].payload);
+        if (!payload || IsOutsideDamage(commands[i], damage)) {
+            continue;
+        }
+        
+        if (HasEllipseCorners(*payload)) {
+            // 保持绘制顺序：先提交之前累积的实例
+            FlushRectangleInstances();
+            DrawRectangle(*payload);
+            continue;
+        }
+        AppendRectangleInstance(*payload);
+    }
+    FlushRectangleInstances();
+}
+
+void GlRenderer::AppendRectangleInstance(const RectanglePayload& payload) {
+    const float width = payload.rect.width;
+    const float height = payload.rect.height;
+    const float minDimension = std::min(width, height);
+    const float halfMinDimension = std::max(0.0f, minDimension * 0.5f);
+
+    // 设置圆角半径（需要检查相邻圆角之和不超过对应边长）
+    // 参考 CSS 规范：https://www.w3.org/TR/css-backgrounds-3/#corner-overlap
+    float topLeft = std::max(0.0f, payload.cornerRadiusTopLeft);
+    float topRight = std::max(0.0f, payload.cornerRadiusTopRight);
+    float bottomRight = std::max(0.0f, payload.cornerRadiusBottomRight);
+    float bottomLeft = std::max(0.0f, payload.cornerRadiusBottomLeft);
+    
+    // 计算每条边上相邻圆角的和
+    float topSum = topLeft + topRight;      // 上边
+    float rightSum = topRight + bottomRight; // 右边
+    float bottomSum = bottomRight + bottomLeft; // 下边
+    float leftSum = bottomLeft + topLeft;    // 左边
+    
+    // 计算缩放因子：如果相邻圆角之和超过边长，需要按比例缩小
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    
+    if (topSum > width && topSum > 0.0f) {
+        scaleX = std::min(scaleX, width / topSum);
+    }
+    if (bottomSum > width && bottomSum > 0.0f) {
+        scaleX = std::min(scaleX, width / bottomSum);
+    }
+    if (leftSum > height && leftSum > 0.0f) {
+        scaleY = std::min(scaleY, height / leftSum);
+    }
+    if (rightSum > height && rightSum > 0.0f) {
+        scaleY = std::min(scaleY, height / rightSum);
+    }
+    
+    // 使用最严格的缩放因子（水平和垂直方向取最小值）
+    float scale = std::min(scaleX, scaleY);
+
     // 计算描边对齐（inside/outside/center）
     float insetFactor = 0.5f;
     float outsetFactor = 0.5f;
@@ -765,98 +1246,79 @@ void GlRenderer::DrawRectangle(const RectanglePayload& payload) {
 
     float strokeInset = std::min(payload.strokeThickness * insetFactor, halfMinDimension);
     float strokeOutset = std::max(payload.strokeThickness * outsetFactor, 0.0f);
-
-    // 设置描边相关 uniform
-    int strokeColorLoc = glGetUniformLocation(shaderProgram, "uStrokeColor");
-    glUniform4f(strokeColorLoc,
-        payload.strokeColor[0],
-        payload.strokeColor[1],
-        payload.strokeColor[2],
-        payload.strokeColor[3]);
-
-    int strokeWidthLoc = glGetUniformLocation(shaderProgram, "uStrokeWidth");
-    glUniform1f(strokeWidthLoc, payload.strokeThickness);
-
-    int strokeAlignLoc = glGetUniformLocation(shaderProgram, "uStrokeAlignment");
-    glUniform2f(strokeAlignLoc, strokeInset, strokeOutset);
-
-    int aaLoc = glGetUniformLocation(shaderProgram, "uAAWidth");
     float aaWidth = std::clamp(payload.aaWidth, 0.1f, 2.0f);
-    glUniform1f(aaLoc, aaWidth);
 
-    // 单次绘制：片段着色器基于 SDF 计算填充与描边
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    // 如果有描边，则先绘制外部（描边）填充，再绘制内矩形填充（这样可以正确支持圆角描边）
+    // 与 rectInstanceVertexShaderSource 的属性布局一致
+    const float instance[kRectInstanceFloats] = {
+        payload.rect.x, payload.rect.y, width, height,
+        payload.fillColor[0], payload.fillColor[1], payload.fillColor[2], payload.fillColor[3],
+        payload.strokeColor[0], payload.strokeColor[1], payload.strokeColor[2], payload.strokeColor[3],
+        // 应用缩放并限制在合理范围内
+        std::clamp(topLeft * scale, 0.0f, halfMinDimension),
+        std::clamp(topRight * scale, 0.0f, halfMinDimension),
+        std::clamp(bottomRight * scale, 0.0f, halfMinDimension),
+        std::clamp(bottomLeft * scale, 0.0f, halfMinDimension),
+        payload.strokeThickness, strokeInset, strokeOutset, aaWidth
+    };
+    rectInstances_.insert(rectInstances_.end(), std::begin(instance), std::end(instance));
+}
 
-        // 无描边，直接绘制填充矩形
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+void GlRenderer::FlushRectangleInstances() {
+    if (rectInstances_.empty()) {
+        return;
+    }
+    
+    const auto instanceCount = rectInstances_.size() / kRectInstanceFloats;
+    
+    glBindVertexArray(rectInstanceVAO_);
+    glUseProgram(rectInstanceShaderProgram_);
+    
+    // 设置视口 uniform
+    int viewportLoc = glGetUniformLocation(rectInstanceShaderProgram_, "uViewport");
+    glUniform2f(viewportLoc, 
+        static_cast<float>(viewportSize_.width), 
+        static_cast<float>(viewportSize_.height));
+    
+    // 同一批次内图层不变，不透明度仍为 uniform
+    float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
+    int opacityLoc = glGetUniformLocation(rectInstanceShaderProgram_, "uOpacity");
+    glUniform1f(opacityLoc, effectiveOpacity);
+    
+    // 上传实例数据（容量不足时按倍数扩容）
+    glBindBuffer(GL_ARRAY_BUFFER, rectInstanceVBO_);
+    if (instanceCount > rectInstanceCapacity_) {
+        while (rectInstanceCapacity_ < instanceCount) {
+            rectInstanceCapacity_ *= 2;
+        }
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * kRectInstanceFloats * rectInstanceCapacity_, nullptr, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, rectInstances_.size() * sizeof(float), rectInstances_.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    
+    // 片段着色器基于 SDF 计算填充与描边
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(instanceCount));
     
-
-    // 解绑
     glBindVertexArray(0);
+    rectInstances_.clear();
 }
 
 void GlRenderer::DrawText(const TextPayload& payload) {
-    if (!textRenderer_) {
+    const TextLayout* layout = payload.layout.get();
+    if (!textRenderer_ || !layout) {
         return;
     }
 
-    // Phase 5.0.4: 改进字体加载 - 使用字体族名称和跨平台路径
-    // 为每个字体大小加载单独的字体
-    static std::unordered_map<std::string, int> fontCache; // 使用 "family_size" 作为键
-    std::string fontKey = payload.fontFamily + "_" + std::to_string(static_cast<unsigned int>(payload.fontSize));
-    
-    int fontId = -1;
-    auto it = fontCache.find(fontKey);
-    if (it != fontCache.end()) {
-        fontId = it->second;
-    } else {
-        // Phase 5.0.4: 跨平台字体路径
-        std::vector<std::string> fontPaths;
-        
-        #ifdef _WIN32
-            // Windows 字体路径
-            fontPaths = {
-                "C:/Windows/Fonts/msyh.ttc",      // 微软雅黑
-                "C:/Windows/Fonts/simhei.ttf",    // 黑体
-                "C:/Windows/Fonts/arial.ttf",     // Arial
-                "C:/Windows/Fonts/times.ttf"      // Times
-            };
-        #elif __APPLE__
-            // macOS 字体路径
-            fontPaths = {
-                "/System/Library/Fonts/PingFang.ttc",           // 苹方
-                "/System/Library/Fonts/Helvetica.ttc",          // Helvetica
-                "/Library/Fonts/Arial Unicode.ttf"               // Arial Unicode
-            };
-        #else
-            // Linux 字体路径
-            fontPaths = {
-                "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-                "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
-                "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc"
-            };
-        #endif
-        
-        // 尝试加载字体
-        unsigned int fontSizeKey = static_cast<unsigned int>(payload.fontSize);
-        for (const auto& path : fontPaths) {
-            fontId = textRenderer_->LoadFont(path, fontSizeKey);
-            if (fontId >= 0) {
-                break;
-            }
-        }
-        
-        if (fontId < 0) {
-            std::cerr << "Failed to load any font for size " << fontSizeKey << "!" << std::endl;
-            // Phase 5.0.4: 尝试使用默认字体
-            fontId = textRenderer_->GetDefaultFont();
-            if (fontId < 0) {
-                return;
-            }
+    // Phase 5.1: 排版结果由 TextBlock 创建并在帧间共享，字形已解析到具体字体。
+    // 由其他度量来源（如软件渲染器）排版时，按字体族与字号重新查找字形
+    const bool ownLayout = layout->GetProviderId() == textRenderer_->GetProviderId();
+    int fallbackFontId = -1;
+    if (!ownLayout) {
+        fallbackFontId = textRenderer_->ResolveFont(layout->GetFontFamily(), layout->GetFontSize(), 400, false);
+        if (fallbackFontId < 0) {
+            return;
         }
-        fontCache[fontKey] = fontId;
     }
+    const float fontSize = layout->GetFontSize();
     
     // 保存当前着色器程序
     GLint currentProgram;
@@ -868,7 +1330,8 @@ void GlRenderer::DrawText(const TextPayload& payload) {
     // 设置 uniforms
     glUniform4f(glGetUniformLocation(textShaderProgram_, "textColor"), 
                 payload.color[0], payload.color[1], payload.color[2], payload.color[3]);
-    glUniform1f(glGetUniformLocation(textShaderProgram_, "uOpacity"), 1.0f);
+    float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
+    glUniform1f(glGetUniformLocation(textShaderProgram_, "uOpacity"), effectiveOpacity);
     glUniform2f(glGetUniformLocation(textShaderProgram_, "uViewport"), 
                 viewportSize_.width, viewportSize_.height);
     // uOffset 已经从文本着色器中移除（坐标已经是全局的）
@@ -878,161 +1341,54 @@ void GlRenderer::DrawText(const TextPayload& payload) {
     glUniform1i(glGetUniformLocation(textShaderProgram_, "text"), 0);
     glBindVertexArray(textVAO_);
     
-    // 保存混合状态
+    // 保存混合状态（混合函数始终是默认混合）
     GLboolean blendEnabled = glIsEnabled(GL_BLEND);
-    GLint blendSrc, blendDst;
-    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrc);
-    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDst);
     
     // 启用混合
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    // 处理文本换行
-    std::vector<std::string> lines;
-    
-    // 首先按硬换行符 \n 分割文本
-    std::vector<std::string> hardLines;
-    {
-        std::string currentHardLine;
-        for (char c : payload.text) {
-            if (c == '\n') {
-                hardLines.push_back(currentHardLine);
-                currentHardLine.clear();
-            } else {
-                currentHardLine += c;
-            }
-        }
-        if (!currentHardLine.empty() || payload.text.empty() || payload.text.back() == '\n') {
-            hardLines.push_back(currentHardLine);
-        }
-    }
-    
-    // 然后对每个硬换行的行应用自动换行
-    if (payload.textWrapping && payload.maxWidth > 0.0f) {
-        // 自动换行:按字符分割文本
-        float maxLineWidth = payload.maxWidth;
-        
-        for (const auto& hardLine : hardLines) {
-            if (hardLine.empty()) {
-                lines.push_back("");  // 保留空行
-                continue;
-            }
-            
-            std::string currentLine;
-            float currentLineWidth = 0.0f;
-            
-            std::u32string utf32Text = textRenderer_->Utf8ToUtf32(hardLine);
-            std::string utf8Buffer;
-            
-            for (char32_t c : utf32Text) {
-                const auto* glyph = textRenderer_->GetGlyphWithFallback(c, fontId);
-                if (!glyph) continue;
-                
-                // 检查是否需要自动换行
-                if (currentLineWidth + glyph->advance > maxLineWidth && !currentLine.empty()) {
-                    lines.push_back(currentLine);
-                    currentLine.clear();
-                    currentLineWidth = 0.0f;
-                }
-                
-                // 将 UTF-32 字符转换为 UTF-8 并添加到当前行
-            if (c < 0x80) {
-                utf8Buffer = std::string(1, static_cast<char>(c));
-            } else if (c < 0x800) {
-                utf8Buffer = std::string{
-                    static_cast<char>(0xC0 | (c >> 6)),
-                    static_cast<char>(0x80 | (c & 0x3F))
-                };
-            } else if (c < 0x10000) {
-                utf8Buffer = std::string{
-                    static_cast<char>(0xE0 | (c >> 12)),
-                    static_cast<char>(0x80 | ((c >> 6) & 0x3F)),
-                    static_cast<char>(0x80 | (c & 0x3F))
-                };
-            } else {
-                utf8Buffer = std::string{
-                    static_cast<char>(0xF0 | (c >> 18)),
-                    static_cast<char>(0x80 | ((c >> 12) & 0x3F)),
-                    static_cast<char>(0x80 | ((c >> 6) & 0x3F)),
-                    static_cast<char>(0x80 | (c & 0x3F))
-                };
-            }
-            
-                currentLine += utf8Buffer;
-                currentLineWidth += glyph->advance;
-            }
-            
-            // 添加当前硬行的最后一个软行
-            if (!currentLine.empty()) {
-                lines.push_back(currentLine);
-            }
-        }
-    } else {
-        // 不自动换行:只处理硬换行符
-        lines = hardLines;
-    }
+    SetDefaultBlend();
     
     // 渲染每一行
-    float lineHeight = payload.fontSize * 1.2f;
-    float y = payload.bounds.y;  // 修复：使用payload中的全局Y坐标
+    const auto& glyphs = layout->GetGlyphs();
+    const float lineHeight = layout->GetLineHeight();
+    float y = payload.bounds.y;
     float boundsBottom = payload.bounds.y + payload.bounds.height;
     
-    for (const auto& line : lines) {
+    for (const auto& line : layout->GetLines()) {
         // 如果当前行完全超出 bounds 底部，停止渲染后续行
         if (y >= boundsBottom) {
             break;
         }
-        // 将 UTF-8 文本转换为 UTF-32
-        std::u32string utf32Text = textRenderer_->Utf8ToUtf32(line);
-        
-        // Phase 5.0.4: 计算行宽用于对齐
-        float lineWidth = 0.0f;
-        for (char32_t c : utf32Text) {
-            const auto* glyph = textRenderer_->GetGlyphWithFallback(c, fontId);
-            if (glyph) {
-                lineWidth += glyph->advance;
-            }
-        }
-        
-        // Phase 5.0.4: 根据对齐方式计算起始 X 位置
-        float x = payload.bounds.x;  // 修复：使用payload中的全局X坐标
-        float maxWidth = payload.maxWidth > 0.0f ? payload.maxWidth : lineWidth;
-        
-        // TODO: 使用 payload.textAlignment (需要在 TextPayload 中添加)
-        // 暂时默认左对齐
-        // if (alignment == TextAlignment::Center) {
-        //     x += (maxWidth - lineWidth) / 2.0f;
-        // } else if (alignment == TextAlignment::Right) {
-        //     x += maxWidth - lineWidth;
-        // }
         
-        for (char32_t c : utf32Text) {
-            const auto* glyph = textRenderer_->GetGlyphWithFallback(c, fontId);
+        // TODO: 文本对齐（TextAlignment）需要在 TextPayload 中添加，暂时默认左对齐
+        for (std::uint32_t i = line.firstGlyph; i < line.firstGlyph + line.glyphCount; ++i) {
+            const auto& shaped = glyphs[i];
+            const auto* glyph = ownLayout ? textRenderer_->GetGlyph(shaped.codepoint, shaped.fontId)
+                                          : textRenderer_->GetGlyphWithFallback(shaped.codepoint, fallbackFontId);
             if (!glyph) {
                 continue; // 跳过无法加载的字符
             }
+            // 组合标记等字形按整形给出的偏移绘制
+            const float x = payload.bounds.x + shaped.x + shaped.xOffset;
             
-            float xpos = x + glyph->bearingX;
-            float ypos = y + (payload.fontSize - glyph->bearingY); // 基线对齐
-            float w = glyph->width;
-            float h = glyph->height;
+            // Phase 5.1: 距离场字形使用按字号缩放的精确度量
+            float xpos = x + (glyph->isSdf ? glyph->sdfBearingX : glyph->bearingX);
+            float ypos = y + shaped.yOffset + (fontSize - (glyph->isSdf ? glyph->sdfBearingY : glyph->bearingY)); // 基线对齐
+            float w = glyph->isSdf ? glyph->sdfWidth : glyph->width;
+            float h = glyph->isSdf ? glyph->sdfHeight : glyph->height;
             
             // 裁剪检查：跳过完全在 bounds 外的字符
             float charRight = xpos + w;
             float charBottom = ypos + h;
             float boundsRight = payload.bounds.x + payload.bounds.width;
-            float boundsBottom = payload.bounds.y + payload.bounds.height;
             
             // 如果字符完全在右侧或底部之外，跳过
             if (xpos >= boundsRight || ypos >= boundsBottom) {
-                x += glyph->advance;
                 continue;
             }
             
             // 如果字符完全在左侧或顶部之外，跳过
             if (charRight <= payload.bounds.x || charBottom <= payload.bounds.y) {
-                x += glyph->advance;
                 continue;
             }
             
@@ -1078,43 +1434,55 @@ void GlRenderer::DrawText(const TextPayload& payload) {
             
             // 如果裁剪后没有可见区域，跳过
             if (renderW <= 0 || renderH <= 0) {
-                x += glyph->advance;
                 continue;
             }
             
-            // 更新 VBO (翻转纹理 V 坐标以匹配 FreeType 的上下翻转，并应用裁剪)
+            // 空白字形（如空格）没有图集区域
+            if (glyph->textureID == 0) {
+                continue;
+            }
+            
+            // Phase 5.1: 将字形内的纹理坐标映射到图集页坐标
+            float du = glyph->u1 - glyph->u0;
+            float dv = glyph->v1 - glyph->v0;
+            float u0 = glyph->u0 + texLeft * du;
+            float u1 = glyph->u0 + texRight * du;
+            float v0 = glyph->v0 + texTop * dv;
+            float v1 = glyph->v0 + texBottom * dv;
+            
+            // 追加到所在图集页的批次（应用裁剪）
             float vertices[6][4] = {
-                { renderXPos,           renderYPos + renderH,   texLeft,  texBottom },
-                { renderXPos,           renderYPos,             texLeft,  texTop },
-                { renderXPos + renderW, renderYPos,             texRight, texTop },
+                { renderXPos,           renderYPos + renderH,   u0, v1 },
+                { renderXPos,           renderYPos,             u0, v0 },
+                { renderXPos + renderW, renderYPos,             u1, v0 },
                 
-                { renderXPos,           renderYPos + renderH,   texLeft,  texBottom },
-                { renderXPos + renderW, renderYPos,             texRight, texTop },
-                { renderXPos + renderW, renderYPos + renderH,   texRight, texBottom }
+                { renderXPos,           renderYPos + renderH,   u0, v1 },
+                { renderXPos + renderW, renderYPos,             u1, v0 },
+                { renderXPos + renderW, renderYPos + renderH,   u1, v1 }
             };
             
-            // 绑定字形纹理
-            glBindTexture(GL_TEXTURE_2D, glyph->textureID);
-            
-            // 设置是否为彩色纹理
-            glUniform1i(glGetUniformLocation(textShaderProgram_, "isColorTexture"), glyph->isColor ? 1 : 0);
-            
-            // 更新 VBO 内容
-            glBindBuffer(GL_ARRAY_BUFFER, textVBO_);
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-            glBindBuffer(GL_ARRAY_BUFFER, 0);
-            
-            // 渲染四边形
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-            
-            // 前进到下一个字形位置 (advance 已经是像素单位)
-            x += glyph->advance;
+            const float sdfRange = glyph->isSdf ? glyph->sdfRange : 0.0f;
+            TextBatch* batch = nullptr;
+            for (auto& candidate : textBatches_) {
+                if (candidate.textureID == glyph->textureID && candidate.sdfRange == sdfRange) {
+                    batch = &candidate;
+                    break;
+                }
+            }
+            if (!batch) {
+                textBatches_.push_back({glyph->textureID, glyph->isColor, sdfRange, {}});
+                batch = &textBatches_.back();
+            }
+            batch->vertices.insert(batch->vertices.end(), &vertices[0][0], &vertices[0][0] + 6 * 4);
         }
         
         // 移动到下一行
         y += lineHeight;
     }
     
+    // Phase 5.1: 每个图集页一次绘制调用
+    FlushTextBatches();
+    
     // 恢复状态
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -1123,17 +1491,86 @@ void GlRenderer::DrawText(const TextPayload& payload) {
     if (!blendEnabled) {
         glDisable(GL_BLEND);
     }
-    if (blendEnabled) {
-        glBlendFunc(blendSrc, blendDst);
-    }
     
     // 恢复着色器程序
     glUseProgram(currentProgram);
 }
 
+void GlRenderer::FlushTextBatches() {
+    if (textBatches_.empty()) {
+        return;
+    }
+    
+    GLint isColorLoc = glGetUniformLocation(textShaderProgram_, "isColorTexture");
+    GLint sdfRangeLoc = glGetUniformLocation(textShaderProgram_, "uSdfRange");
+    glBindBuffer(GL_ARRAY_BUFFER, textVBO_);
+    
+    for (auto& batch : textBatches_) {
+        if (batch.vertices.empty()) {
+            continue;
+        }
+        
+        // 容量不足时扩容 VBO
+        if (batch.vertices.size() > textVBOCapacity_) {
+            textVBOCapacity_ = std::max(batch.vertices.size(), textVBOCapacity_ * 2);
+            glBufferData(GL_ARRAY_BUFFER, textVBOCapacity_ * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, batch.vertices.size() * sizeof(float), batch.vertices.data());
+        
+        glBindTexture(GL_TEXTURE_2D, batch.textureID);
+        glUniform1i(isColorLoc, batch.isColor ? 1 : 0);
+        glUniform1f(sdfRangeLoc, batch.sdfRange);
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(batch.vertices.size() / 4));
+        
+        // 保留容量供下次复用
+        batch.vertices.clear();
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 void GlRenderer::DrawImage(const ImagePayload& payload) {
-    // TODO: 实现图像渲染
-    // 需要纹理管理
+    if (payload.textureId == 0 || payload.destRect.width <= 0 || payload.destRect.height <= 0) {
+        return;
+    }
+
+    const auto& rect = payload.destRect;
+    const float left = rect.x;
+    const float top = rect.y;
+    const float right = rect.x + rect.width;
+    const float bottom = rect.y + rect.height;
+    const float vertices[6][4] = {
+        { left,  bottom, 0.0f, 1.0f },
+        { left,  top,    0.0f, 0.0f },
+        { right, top,    1.0f, 0.0f },
+
+        { left,  bottom, 0.0f, 1.0f },
+        { right, top,    1.0f, 0.0f },
+        { right, bottom, 1.0f, 1.0f }
+    };
+
+    glUseProgram(imageShaderProgram_);
+    glUniform2f(glGetUniformLocation(imageShaderProgram_, "uViewport"),
+        static_cast<float>(viewportSize_.width),
+        static_cast<float>(viewportSize_.height));
+    glUniform4f(glGetUniformLocation(imageShaderProgram_, "uTint"),
+        payload.tint[0], payload.tint[1], payload.tint[2], payload.tint[3]);
+    float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
+    glUniform1f(glGetUniformLocation(imageShaderProgram_, "uOpacity"), effectiveOpacity);
+    glUniform1i(glGetUniformLocation(imageShaderProgram_, "image"), 0);
+
+    // 与文本共用四分量顶点缓冲（容量至少为一个四边形）
+    glBindVertexArray(textVAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, textVBO_);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, payload.textureId);
+    TextureManager::Instance().Touch(payload.textureId);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
 }
 
 void GlRenderer::DrawPolygon(const PolygonPayload& payload) {
@@ -1246,105 +1683,43 @@ void GlRenderer::DrawPolygon(const PolygonPayload& payload) {
         
         glDrawArrays(GL_TRIANGLES, 0, 6);
         glBindVertexArray(0);
-    } else {
-        // 多边形渲染（3个或更多点）
-        // 使用简单的扇形三角剖分（适用于凸多边形）
-        
-        if (payload.filled && payload.fillColor[3] > 0.0f) {
-            // 绘制填充的多边形 - 使用简单着色器（无SDF）
-            glBindVertexArray(vao_);
-            glUseProgram(simpleShaderProgram_);
-            
-            // 启用混合
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            
-            // 设置视口
-            int viewportLoc = glGetUniformLocation(simpleShaderProgram_, "uViewport");
-            glUniform2f(viewportLoc, 
-                static_cast<float>(viewportSize_.width), 
-                static_cast<float>(viewportSize_.height));
-            
-            // 设置颜色
-            int colorLoc = glGetUniformLocation(simpleShaderProgram_, "uColor");
-            glUniform4f(colorLoc, 
-                payload.fillColor[0], 
-                payload.fillColor[1], 
-                payload.fillColor[2], 
-                payload.fillColor[3]);
-            
-            // 设置不透明度
-            float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
-            int opacityLoc = glGetUniformLocation(simpleShaderProgram_, "uOpacity");
-            glUniform1f(opacityLoc, effectiveOpacity);
-            
-            // 使用 libtess2 进行三角剖分，支持任意复杂多边形
-            TESStesselator* tess = tessNewTess(nullptr);
-            if (!tess) {
-                std::cerr << "Failed to create tesselator" << std::endl;
-                glBindVertexArray(0);
-                return;
-            }
-            
-            // 准备顶点数据（libtess2 需要连续的坐标数组）
-            std::vector<TESSreal> coords;
-            coords.reserve(payload.points.size() * 2);
+    } else {
+        // 多边形渲染（3个或更多点）
+        // 使用简单的扇形三角剖分（适用于凸多边形）
+        
+        if (payload.filled && payload.fillColor[3] > 0.0f) {
+            // Phase 5.1: 剖分结果按几何内容缓存，坐标相对于首个顶点，
+            // 静态或仅平移的多边形不再每帧重新剖分和上传
+            const ui::Point origin = payload.points.front();
+            GeometryKeyHasher hasher;
+            hasher.Add(kPolygonGeometryTag);
+            hasher.Add(payload.points.size());
             for (const auto& pt : payload.points) {
-                coords.push_back(static_cast<TESSreal>(pt.x));
-                coords.push_back(static_cast<TESSreal>(pt.y));
+                hasher.AddCoord(pt.x - origin.x);
+                hasher.AddCoord(pt.y - origin.y);
             }
+            const std::uint64_t key = hasher.Get();
             
-
-            
-            // 添加轮廓到 tesselator
-            tessAddContour(tess, 2, coords.data(), sizeof(TESSreal) * 2, static_cast<int>(payload.points.size()));
-            
-            // 执行三角剖分 - 使用 TESS_WINDING_NONZERO 对顺时针/逆时针都有效
-            int result = tessTesselate(tess, TESS_WINDING_NONZERO, TESS_POLYGONS, 3, 2, nullptr);
-            
-            std::vector<float> vertices;
-            if (result) {
-                // 获取剖分结果
-                const TESSreal* tessVerts = tessGetVertices(tess);
-                const TESSindex* tessElements = tessGetElements(tess);
-                int numElements = tessGetElementCount(tess);
-                
-                // 将三角形转换为顶点数组
-                vertices.reserve(numElements * 3 * 4);  // 每个三角形3个顶点，每个顶点4个float
+            const CachedGeometry* geometry = geometryCache_.Find(key);
+            if (!geometry) {
+                std::vector<ui::Point> localPoints;
+                localPoints.reserve(payload.points.size());
+                for (const auto& pt : payload.points) {
+                    localPoints.emplace_back(pt.x - origin.x, pt.y - origin.y);
+                }
                 
-                for (int i = 0; i < numElements; ++i) {
-                    const TESSindex* tri = &tessElements[i * 3];
-                    
-                    for (int j = 0; j < 3; ++j) {
-                        TESSindex idx = tri[j];
-                        if (idx == TESS_UNDEF) continue;
-                        
-                        float x = static_cast<float>(tessVerts[idx * 2]);
-                        float y = static_cast<float>(tessVerts[idx * 2 + 1]);
-                        
-                        vertices.push_back(x);
-                        vertices.push_back(y);
-                        vertices.push_back(0.0f);  // 纹理坐标 u
-                        vertices.push_back(0.0f);  // 纹理坐标 v
-                    }
+                std::vector<float> vertices;
+                if (!TessellateContour(localPoints, vertices)) {
+                    std::cerr << "Failed to create tesselator" << std::endl;
+                    return;
                 }
+                geometry = geometryCache_.Insert(key, vertices, {}, {});
             }
             
-            tessDeleteTess(tess);
-            
             // 只有在有顶点数据时才绘制
-            if (!vertices.empty()) {
-                glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-                
-                // 动态分配足够大的缓冲区
-                size_t bufferSize = vertices.size() * sizeof(float);
-                glBufferData(GL_ARRAY_BUFFER, bufferSize, vertices.data(), GL_DYNAMIC_DRAW);
-                
-                int triangleCount = static_cast<int>(vertices.size() / 12);  // 每个三角形12个float
-                glDrawArrays(GL_TRIANGLES, 0, triangleCount * 3);
+            if (geometry) {
+                DrawCachedGeometry(*geometry, origin, &payload.fillColor, nullptr);
             }
-            
-            glBindVertexArray(0);
         }
         
         // TODO: 实现多边形描边
@@ -1355,6 +1730,61 @@ void GlRenderer::DrawPolygon(const PolygonPayload& payload) {
 void GlRenderer::DrawPath(const PathPayload& payload) {
     if (payload.segments.empty()) return;
     
+    bool drawFill = payload.filled && payload.fillColor[3] > 0.0f;
+    bool drawStroke = payload.strokeThickness > 0.0f && payload.strokeColor[3] > 0.0f;
+    if (!drawFill && !drawStroke) return;
+    
+    // Phase 5.1: 细分、剖分和描边网格按几何内容缓存
+    // 网格坐标相对于路径起点，颜色和不透明度作为 uniform 设置，不影响缓存键
+    ui::Point origin(0, 0);
+    const auto& first = payload.segments.front();
+    if (first.type == PathSegmentType::MoveTo && !first.points.empty()) {
+        origin = first.points[0];
+    }
+    
+    GeometryKeyHasher hasher;
+    hasher.Add(kPathGeometryTag);
+    hasher.Add(drawFill);
+    hasher.Add(drawStroke);
+    if (drawStroke) {
+        hasher.AddFloat(payload.strokeThickness);
+    }
+    hasher.Add(payload.segments.size());
+    for (const auto& segment : payload.segments) {
+        hasher.Add(static_cast<std::uint64_t>(segment.type));
+        hasher.Add(segment.points.size());
+        for (size_t i = 0; i < segment.points.size(); ++i) {
+            const auto& pt = segment.points[i];
+            if (segment.type == PathSegmentType::ArcTo && i < 3) {
+                // 圆弧的前三个点是半径、旋转角和标志位，不是坐标
+                hasher.AddFloat(pt.x);
+                hasher.AddFloat(pt.y);
+            } else {
+                hasher.AddCoord(pt.x - origin.x);
+                hasher.AddCoord(pt.y - origin.y);
+            }
+        }
+        if (drawStroke && segment.hasStrokeColor) {
+            for (float c : segment.strokeColor) {
+                hasher.AddFloat(c);
+            }
+        }
+    }
+    const std::uint64_t key = hasher.Get();
+    
+    const CachedGeometry* geometry = geometryCache_.Find(key);
+    if (!geometry) {
+        geometry = BuildPathGeometry(key, payload, origin, drawFill, drawStroke);
+    }
+    if (geometry) {
+        DrawCachedGeometry(*geometry, origin,
+                           drawFill ? &payload.fillColor : nullptr,
+                           drawStroke ? &payload.strokeColor : nullptr);
+    }
+}
+
+const CachedGeometry* GlRenderer::BuildPathGeometry(std::uint64_t key, const PathPayload& payload,
+                                                    const ui::Point& origin, bool buildFill, bool buildStroke) {
     // 将 Path 的曲线段转换为多边形点
     std::vector<ui::Point> pathPoints;
     std::vector<size_t> pointSegmentIndices; // 记录每个点属于哪个segment
@@ -1565,7 +1995,7 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
     }
     
     // 如果路径为空,直接返回
-    if (pathPoints.empty()) return;
+    if (pathPoints.empty()) return nullptr;
     
     // 去重连续的重复点,同时保留segment索引
     std::vector<ui::Point> uniquePoints;
@@ -1590,121 +2020,25 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
         }
     }
     
+    // 转换为相对于网格原点的坐标
+    for (auto& pt : uniquePoints) {
+        pt.x -= origin.x;
+        pt.y -= origin.y;
+    }
+    
     // 如果是填充路径,使用 libtess2 三角剖分
-    if (payload.filled && payload.fillColor[3] > 0.0f && uniquePoints.size() >= 3) {
-        glBindVertexArray(vao_);
-        glUseProgram(simpleShaderProgram_);
-        
-        // 启用混合
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        
-        // 设置视口
-        int viewportLoc = glGetUniformLocation(simpleShaderProgram_, "uViewport");
-        glUniform2f(viewportLoc, 
-            static_cast<float>(viewportSize_.width), 
-            static_cast<float>(viewportSize_.height));
-        
-        // 设置颜色
-        int colorLoc = glGetUniformLocation(simpleShaderProgram_, "uColor");
-        glUniform4f(colorLoc, 
-            payload.fillColor[0], 
-            payload.fillColor[1], 
-            payload.fillColor[2], 
-            payload.fillColor[3]);
-        
-        // 设置不透明度
-        float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
-        int opacityLoc = glGetUniformLocation(simpleShaderProgram_, "uOpacity");
-        glUniform1f(opacityLoc, effectiveOpacity);
-        
-        // 使用 libtess2 进行三角剖分
-        TESStesselator* tess = tessNewTess(nullptr);
-        if (!tess) {
+    std::vector<float> vertices;
+    if (buildFill && uniquePoints.size() >= 3) {
+        if (!TessellateContour(uniquePoints, vertices)) {
             std::cerr << "Failed to create tesselator for path" << std::endl;
-            glBindVertexArray(0);
-            return;
-        }
-        
-        // 准备顶点数据
-        std::vector<TESSreal> coords;
-        coords.reserve(uniquePoints.size() * 2);
-        for (const auto& pt : uniquePoints) {
-            coords.push_back(static_cast<TESSreal>(pt.x));
-            coords.push_back(static_cast<TESSreal>(pt.y));
-        }
-        
-        // 添加轮廓到 tesselator
-        tessAddContour(tess, 2, coords.data(), sizeof(TESSreal) * 2, static_cast<int>(uniquePoints.size()));
-        
-        // 执行三角剖分
-        int result = tessTesselate(tess, TESS_WINDING_NONZERO, TESS_POLYGONS, 3, 2, nullptr);
-        
-        std::vector<float> vertices;
-        if (result) {
-            const TESSreal* tessVerts = tessGetVertices(tess);
-            const TESSindex* tessElements = tessGetElements(tess);
-            int numElements = tessGetElementCount(tess);
-            
-            vertices.reserve(numElements * 3 * 4);
-            
-            for (int i = 0; i < numElements; ++i) {
-                const TESSindex* tri = &tessElements[i * 3];
-                
-                for (int j = 0; j < 3; ++j) {
-                    TESSindex idx = tri[j];
-                    if (idx == TESS_UNDEF) continue;
-                    
-                    float x = static_cast<float>(tessVerts[idx * 2]);
-                    float y = static_cast<float>(tessVerts[idx * 2 + 1]);
-                    
-                    vertices.push_back(x);
-                    vertices.push_back(y);
-                    vertices.push_back(0.0f);
-                    vertices.push_back(0.0f);
-                }
-            }
-        }
-        
-        tessDeleteTess(tess);
-        
-        // 绘制填充
-        if (!vertices.empty()) {
-            glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-            size_t bufferSize = vertices.size() * sizeof(float);
-            glBufferData(GL_ARRAY_BUFFER, bufferSize, vertices.data(), GL_DYNAMIC_DRAW);
-            
-            int triangleCount = static_cast<int>(vertices.size() / 12);
-            glDrawArrays(GL_TRIANGLES, 0, triangleCount * 3);
+            return nullptr;
         }
-        
-        glBindVertexArray(0);
     }
     
-    // 绘制路径描边
-    if (payload.strokeThickness > 0.0f && payload.strokeColor[3] > 0.0f && uniquePoints.size() >= 2) {
-        glBindVertexArray(vao_);
-        glUseProgram(simpleShaderProgram_);
-        
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        
-        int viewportLoc = glGetUniformLocation(simpleShaderProgram_, "uViewport");
-        glUniform2f(viewportLoc, 
-            static_cast<float>(viewportSize_.width), 
-            static_cast<float>(viewportSize_.height));
-        
-        int colorLoc = glGetUniformLocation(simpleShaderProgram_, "uColor");
-        glUniform4f(colorLoc, 
-            payload.strokeColor[0], 
-            payload.strokeColor[1], 
-            payload.strokeColor[2], 
-            payload.strokeColor[3]);
-        
-        float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
-        int opacityLoc = glGetUniformLocation(simpleShaderProgram_, "uOpacity");
-        glUniform1f(opacityLoc, effectiveOpacity);
-        
+    // 生成路径描边网格
+    std::vector<float> strokeVertices;
+    std::vector<CachedStrokeBatch> strokeBatches;
+    if (buildStroke && uniquePoints.size() >= 2) {
         float halfThickness = payload.strokeThickness / 2.0f;
         
         // 判断路径是否闭合(最后一点是否等于第一点)
@@ -1714,9 +2048,10 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
         
         size_t segmentCount = isClosed ? uniquePoints.size() : uniquePoints.size() - 1;
         
-        // 按颜色分批绘制
-        std::vector<float> strokeVertices;
+        // 按颜色分批（分段颜色记录在批次中，默认颜色在绘制时取命令的描边颜色）
         std::array<float, 4> currentBatchColor = payload.strokeColor;
+        bool currentBatchHasColor = false;
+        int batchFirst = 0;
         bool batchStarted = false;
         
         // 添加圆形端点的辅助函数
@@ -1747,18 +2082,15 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
         };
         
         auto flushBatch = [&]() {
-            if (!strokeVertices.empty()) {
-                glUniform4f(colorLoc, currentBatchColor[0], currentBatchColor[1], 
-                           currentBatchColor[2], currentBatchColor[3]);
-                
-                glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-                size_t bufferSize = strokeVertices.size() * sizeof(float);
-                glBufferData(GL_ARRAY_BUFFER, bufferSize, strokeVertices.data(), GL_DYNAMIC_DRAW);
-                
-                int vertexCount = static_cast<int>(strokeVertices.size() / 4);
-                glDrawArrays(GL_TRIANGLES, 0, vertexCount);
-                
-                strokeVertices.clear();
+            int vertexCount = static_cast<int>(strokeVertices.size() / 4);
+            if (vertexCount > batchFirst) {
+                CachedStrokeBatch batch;
+                batch.hasColor = currentBatchHasColor;
+                batch.color = currentBatchColor;
+                batch.first = batchFirst;
+                batch.count = vertexCount - batchFirst;
+                strokeBatches.push_back(batch);
+                batchFirst = vertexCount;
             }
         };
         
@@ -1779,10 +2111,11 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
                 }
             }
             
-            // 如果颜色改变,先绘制之前的批次
+            // 如果颜色改变,先结束之前的批次
+            // （默认颜色不参与缓存键，因此从默认颜色切换到分段颜色总是开始新批次）
             if (batchStarted && hasSegmentColor) {
-                bool colorChanged = false;
-                for (int c = 0; c < 4; ++c) {
+                bool colorChanged = !currentBatchHasColor;
+                for (int c = 0; c < 4 && !colorChanged; ++c) {
                     if (std::abs(lineColor[c] - currentBatchColor[c]) > 0.01f) {
                         colorChanged = true;
                         break;
@@ -1791,9 +2124,11 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
                 if (colorChanged) {
                     flushBatch();
                     currentBatchColor = lineColor;
+                    currentBatchHasColor = true;
                 }
             } else if (hasSegmentColor) {
                 currentBatchColor = lineColor;
+                currentBatchHasColor = true;
             }
             
             batchStarted = true;
@@ -1864,28 +2199,408 @@ void GlRenderer::DrawPath(const PathPayload& payload) {
             addRoundCap(uniquePoints.back(), halfThickness);
         }
         
-        // 绘制最后一批
+        // 结束最后一批
         flushBatch();
-        
-        glBindVertexArray(0);
     }
+    
+    return geometryCache_.Insert(key, vertices, strokeVertices, std::move(strokeBatches));
+}
+
+void GlRenderer::DrawCachedGeometry(const CachedGeometry& geometry, const ui::Point& origin,
+                                    const std::array<float, 4>* fillColor,
+                                    const std::array<float, 4>* strokeColor) {
+    // 使用简单着色器（无SDF）
+    glBindVertexArray(geometry.vao);
+    glUseProgram(simpleShaderProgram_);
+    
+    // 启用混合
+    glEnable(GL_BLEND);
+    SetDefaultBlend();
+    
+    // 设置视口
+    int viewportLoc = glGetUniformLocation(simpleShaderProgram_, "uViewport");
+    glUniform2f(viewportLoc, 
+        static_cast<float>(viewportSize_.width), 
+        static_cast<float>(viewportSize_.height));
+    
+    // 网格坐标相对于 origin
+    int originLoc = glGetUniformLocation(simpleShaderProgram_, "uMeshOrigin");
+    glUniform2f(originLoc, origin.x, origin.y);
+    
+    // 设置不透明度
+    float effectiveOpacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
+    int opacityLoc = glGetUniformLocation(simpleShaderProgram_, "uOpacity");
+    glUniform1f(opacityLoc, effectiveOpacity);
+    
+    int colorLoc = glGetUniformLocation(simpleShaderProgram_, "uColor");
+    
+    // 绘制填充
+    if (fillColor && geometry.fillCount > 0) {
+        glUniform4f(colorLoc, (*fillColor)[0], (*fillColor)[1], (*fillColor)[2], (*fillColor)[3]);
+        glDrawArrays(GL_TRIANGLES, geometry.fillFirst, geometry.fillCount);
+    }
+    
+    // 按颜色分批绘制描边
+    if (strokeColor) {
+        for (const auto& batch : geometry.strokeBatches) {
+            const auto& color = batch.hasColor ? batch.color : *strokeColor;
+            glUniform4f(colorLoc, color[0], color[1], color[2], color[3]);
+            glDrawArrays(GL_TRIANGLES, batch.first, batch.count);
+        }
+    }
+    
+    glBindVertexArray(0);
 }
 
 void GlRenderer::PushLayer(const LayerPayload& payload) {
     LayerState state;
-    state.opacity = payload.opacity;
+    state.opacity = layerStack_.empty() ? 1.0f : layerStack_.back().opacity;
+    const float opacity = std::clamp(payload.opacity, 0.0f, 1.0f);
+    
+    // 完全透明或没有内容的图层：跳过图层内的命令
+    if (opacity <= 0.0f || payload.bounds.IsEmpty()) {
+        layerStack_.push_back(state);
+        skipDepth_ = 1;
+        return;
+    }
+    
+    // 不缓存的不透明图层与直接绘制等价
+    if (opacity >= 1.0f && payload.cacheId == 0) {
+        layerStack_.push_back(state);
+        return;
+    }
+    
+    bool cached = payload.cacheId != 0 &&
+                  payload.bounds.width <= kMaxCachedLayerSize &&
+                  payload.bounds.height <= kMaxCachedLayerSize;
+    
+    // 缓存命中：内容与位图一致（只有位置或透明度变化），直接合成
+    if (cached) {
+        auto it = layerCache_.find(payload.cacheId);
+        if (it != layerCache_.end() && it->second.version == payload.contentVersion) {
+            auto& entry = it->second;
+            entry.target.lastUsedFrame = frameIndex_;
+            TextureManager::Instance().Touch(entry.target.texture);
+            
+            state.offscreen = true;
+            state.cached = true;
+            state.compositeOpacity = opacity * state.opacity;
+            state.destRect = ui::Rect{payload.bounds.x - entry.fractionX, payload.bounds.y - entry.fractionY,
+                                      static_cast<float>(entry.target.width),
+                                      static_cast<float>(entry.target.height)};
+            state.texture = entry.target.texture;
+            state.parentClipRect = currentClipRect_;
+            state.parentClipEnabled = currentClipEnabled_;
+            layerStack_.push_back(state);
+            skipDepth_ = 1;
+            return;
+        }
+    }
+    
+    // 普通图层只需要绘制目标内可见的部分
+    ui::Rect area = payload.bounds;
+    if (!cached) {
+        area = area.Intersect(ui::Rect{0.0f, 0.0f, static_cast<float>(viewportSize_.width),
+                                       static_cast<float>(viewportSize_.height)});
+        if (currentClipEnabled_) {
+            area = area.Intersect(currentClipRect_);
+        }
+        if (area.IsEmpty()) {
+            layerStack_.push_back(state);
+            skipDepth_ = 1;
+            return;
+        }
+    }
+    
+    // 离屏区域按整像素对齐
+    const float left = std::floor(area.x);
+    const float top = std::floor(area.y);
+    const int width = static_cast<int>(std::ceil(area.Right()) - left);
+    const int height = static_cast<int>(std::ceil(area.Bottom()) - top);
+    
+    const LayerTarget* target = nullptr;
+    if (cached) {
+        auto& entry = layerCache_[payload.cacheId];
+        if (entry.target.width != width || entry.target.height != height) {
+            TextureManager::Instance().Unregister(entry.target.texture);
+            DestroyLayerTarget(entry.target);
+            if (CreateLayerTarget(entry.target, width, height)) {
+                // 缓存位图计入纹理预算，超出预算时与其他纹理一起按 LRU 淘汰
+                const std::uint64_t cacheId = payload.cacheId;
+                TextureManager::Instance().Register(
+                    entry.target.texture, static_cast<std::size_t>(width) * height * 4,
+                    [this, cacheId](std::uint32_t) { ReleaseCachedLayer(cacheId); });
+            }
+        }
+        if (entry.target.fbo != 0) {
+            entry.version = payload.contentVersion;
+            entry.fractionX = payload.bounds.x - left;
+            entry.fractionY = payload.bounds.y - top;
+            entry.target.lastUsedFrame = frameIndex_;
+            TextureManager::Instance().Touch(entry.target.texture);
+            target = &entry.target;
+        } else {
+            layerCache_.erase(payload.cacheId);
+        }
+    } else {
+        int index = AcquirePooledTarget(width, height);
+        if (index >= 0) {
+            state.poolIndex = index;
+            target = &layerTargets_[index];
+        }
+    }
     
-    // 如果有父图层，累乘不透明度
-    if (!layerStack_.empty()) {
-        state.opacity *= layerStack_.back().opacity;
+    if (!target) {
+        // 无法创建离屏目标：退回逐图元乘不透明度（重叠部分会互相透出）
+        state.opacity *= opacity;
+        layerStack_.push_back(state);
+        return;
     }
     
+    state.offscreen = true;
+    state.rendering = true;
+    state.cached = cached;
+    state.compositeOpacity = opacity * state.opacity;
+    state.destRect = ui::Rect{left, top, static_cast<float>(width), static_cast<float>(height)};
+    state.texture = target->texture;
+    state.u1 = static_cast<float>(width) / static_cast<float>(target->width);
+    state.v0 = 1.0f - static_cast<float>(height) / static_cast<float>(target->height);
+    state.parentTarget = currentTarget_;
+    state.parentClipRect = currentClipRect_;
+    state.parentClipEnabled = currentClipEnabled_;
+    state.opacity = 1.0f;  // 图层内的图元不再乘不透明度，合成时整体应用
     layerStack_.push_back(state);
+    
+    ++offscreenDepth_;
+    if (state.cached) {
+        ++cachedLayerDepth_;
+    }
+    currentTarget_ = RenderTarget{target->fbo, static_cast<int>(left), static_cast<int>(top), target->height};
+    BindRenderTarget(currentTarget_);
+    
+    // 图层从全透明开始
+    glDisable(GL_SCISSOR_TEST);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(currentFrame_.clearColor[0], currentFrame_.clearColor[1],
+                 currentFrame_.clearColor[2], currentFrame_.clearColor[3]);
+    
+    // 缓存位图需要完整内容，外部裁剪在合成时应用；普通图层继续使用进入时的裁剪
+    ClipPayload clip;
+    clip.clipRect = state.parentClipRect;
+    clip.enabled = !state.cached && state.parentClipEnabled;
+    ApplyClip(clip);
 }
 
 void GlRenderer::PopLayer() {
-    if (!layerStack_.empty()) {
-        layerStack_.pop_back();
+    // 根图层不弹出
+    if (layerStack_.size() <= 1) {
+        return;
+    }
+    const LayerState state = layerStack_.back();
+    layerStack_.pop_back();
+    if (!state.offscreen) {
+        return;
+    }
+    
+    if (state.rendering) {
+        --offscreenDepth_;
+        if (state.cached) {
+            --cachedLayerDepth_;
+        }
+        if (state.poolIndex >= 0) {
+            layerTargets_[state.poolIndex].inUse = false;
+        }
+        currentTarget_ = state.parentTarget;
+        BindRenderTarget(currentTarget_);
+    }
+    
+    ClipPayload clip;
+    clip.clipRect = state.parentClipRect;
+    clip.enabled = state.parentClipEnabled;
+    ApplyClip(clip);
+    CompositeLayer(state.texture, state.destRect, state.u1, state.v0, state.compositeOpacity);
+}
+
+bool GlRenderer::CreateLayerTarget(LayerTarget& target, int width, int height) {
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
+    
+    if (!complete) {
+        std::cerr << "GlRenderer: layer target " << width << "x" << height << " incomplete" << std::endl;
+        DestroyLayerTarget(target);
+        return false;
+    }
+    target.width = width;
+    target.height = height;
+    return true;
+}
+
+void GlRenderer::DestroyLayerTarget(LayerTarget& target) {
+    if (target.fbo != 0) {
+        glDeleteFramebuffers(1, &target.fbo);
+    }
+    if (target.texture != 0) {
+        glDeleteTextures(1, &target.texture);
+    }
+    target = LayerTarget{};
+}
+
+int GlRenderer::AcquirePooledTarget(int width, int height) {
+    // 选择能容纳图层的最小空闲目标
+    int best = -1;
+    for (int i = 0; i < static_cast<int>(layerTargets_.size()); ++i) {
+        const auto& target = layerTargets_[i];
+        if (target.inUse || target.width < width || target.height < height) {
+            continue;
+        }
+        if (best < 0 || target.width * target.height < layerTargets_[best].width * layerTargets_[best].height) {
+            best = i;
+        }
+    }
+    
+    if (best < 0) {
+        // 尺寸按粒度向上取整，便于之后不同大小的图层复用
+        auto roundUp = [](int value) {
+            return (value + kLayerTargetGranularity - 1) / kLayerTargetGranularity * kLayerTargetGranularity;
+        };
+        LayerTarget target;
+        if (!CreateLayerTarget(target, roundUp(width), roundUp(height))) {
+            return -1;
+        }
+        layerTargets_.push_back(target);
+        best = static_cast<int>(layerTargets_.size()) - 1;
+    }
+    
+    layerTargets_[best].inUse = true;
+    layerTargets_[best].lastUsedFrame = frameIndex_;
+    return best;
+}
+
+void GlRenderer::BindRenderTarget(const RenderTarget& target) {
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    // 着色器按视口尺寸把全局坐标映射到 NDC；平移视口使图层左上角落在目标的左上角
+    const auto width = static_cast<GLsizei>(viewportSize_.width);
+    const auto height = static_cast<GLsizei>(viewportSize_.height);
+    glViewport(-target.originX, target.height + target.originY - height, width, height);
+}
+
+GlRenderer::RenderTarget GlRenderer::SceneRenderTarget() const {
+    RenderTarget target;
+    target.fbo = sceneMsaaFBO_ != 0 ? sceneMsaaFBO_ : sceneFBO_;
+    target.height = static_cast<int>(viewportSize_.height);
+    return target;
+}
+
+void GlRenderer::ResetLayerState() {
+    for (auto& target : layerTargets_) {
+        target.inUse = false;
+    }
+    layerStack_.clear();
+    layerStack_.push_back({}); // 根图层不透明度为 1
+    skipDepth_ = 0;
+    offscreenDepth_ = 0;
+    cachedLayerDepth_ = 0;
+    currentClipRect_ = ui::Rect{};
+    currentClipEnabled_ = false;
+    currentTarget_ = SceneRenderTarget();
+    BindRenderTarget(currentTarget_);
+}
+
+void GlRenderer::CompositeLayer(unsigned int texture, const ui::Rect& destRect, float u1, float v0, float opacity) {
+    const float left = destRect.x;
+    const float top = destRect.y;
+    const float right = destRect.Right();
+    const float bottom = destRect.Bottom();
+    
+    // 帧缓冲纹理的原点在左下角：图层内容的顶部对应 v = 1
+    const float vertices[6][4] = {
+        { left,  bottom, 0.0f, v0   },
+        { left,  top,    0.0f, 1.0f },
+        { right, top,    u1,   1.0f },
+
+        { left,  bottom, 0.0f, v0   },
+        { right, top,    u1,   1.0f },
+        { right, bottom, u1,   v0   }
+    };
+
+    glUseProgram(imageShaderProgram_);
+    glUniform2f(glGetUniformLocation(imageShaderProgram_, "uViewport"),
+        static_cast<float>(viewportSize_.width),
+        static_cast<float>(viewportSize_.height));
+    // 图层是预乘 alpha：颜色和 alpha 同乘不透明度
+    glUniform4f(glGetUniformLocation(imageShaderProgram_, "uTint"), opacity, opacity, opacity, opacity);
+    glUniform1f(glGetUniformLocation(imageShaderProgram_, "uOpacity"), 1.0f);
+    glUniform1i(glGetUniformLocation(imageShaderProgram_, "image"), 0);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glBindVertexArray(textVAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, textVBO_);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    SetDefaultBlend();
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void GlRenderer::TrimLayerTargets() {
+    // 图层池：淡入淡出结束后不再需要的目标
+    std::erase_if(layerTargets_, [this](LayerTarget& target) {
+        if (target.inUse || frameIndex_ - target.lastUsedFrame <= kLayerTargetIdleFrames) {
+            return false;
+        }
+        DestroyLayerTarget(target);
+        return true;
+    });
+    
+    // 缓存位图：元素已销毁、不可见或不再缓存时不会再被使用
+    std::vector<std::uint64_t> idle;
+    for (const auto& [cacheId, entry] : layerCache_) {
+        if (frameIndex_ - entry.target.lastUsedFrame > kCachedLayerIdleFrames) {
+            idle.push_back(cacheId);
+        }
+    }
+    for (auto cacheId : idle) {
+        ReleaseCachedLayer(cacheId);
+    }
+}
+
+void GlRenderer::ReleaseCachedLayer(std::uint64_t cacheId) {
+    auto it = layerCache_.find(cacheId);
+    if (it == layerCache_.end()) {
+        return;
+    }
+    // TextureManager 淘汰时纹理已取消登记，这里再次取消登记无副作用
+    TextureManager::Instance().Unregister(it->second.target.texture);
+    DestroyLayerTarget(it->second.target);
+    layerCache_.erase(it);
+}
+
+void GlRenderer::ReleaseAllLayerTargets() {
+    for (auto& target : layerTargets_) {
+        DestroyLayerTarget(target);
+    }
+    layerTargets_.clear();
+    while (!layerCache_.empty()) {
+        ReleaseCachedLayer(layerCache_.begin()->first);
     }
 }
 
@@ -1906,7 +2621,8 @@ void GlRenderer::InitializeShaders() {
 
     // === 编译 Border 片段着色器（圆形圆角）===
     unsigned int borderFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(borderFragmentShader, 1, &borderFragmentShaderSource, nullptr);
+    const char* borderFragmentSources[] = { borderFragmentUniformsSource, borderFragmentBodySource };
+    glShaderSource(borderFragmentShader, 2, borderFragmentSources, nullptr);
     glCompileShader(borderFragmentShader);
 
     glGetShaderiv(borderFragmentShader, GL_COMPILE_STATUS, &success);
@@ -1990,6 +2706,42 @@ void GlRenderer::InitializeShaders() {
     glDeleteShader(simpleFragmentShader);
     glDeleteShader(simpleVertexShader);
 
+    // === Phase 5.1: 编译实例化矩形着色器（与 Border 共享 SDF 主体）===
+    unsigned int rectInstanceVertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(rectInstanceVertexShader, 1, &rectInstanceVertexShaderSource, nullptr);
+    glCompileShader(rectInstanceVertexShader);
+
+    glGetShaderiv(rectInstanceVertexShader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(rectInstanceVertexShader, 512, nullptr, infoLog);
+        throw std::runtime_error(std::string("Rect instance vertex shader compilation failed: ") + infoLog);
+    }
+
+    unsigned int rectInstanceFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    const char* rectInstanceFragmentSources[] = { borderFragmentInstanceInputsSource, borderFragmentBodySource };
+    glShaderSource(rectInstanceFragmentShader, 2, rectInstanceFragmentSources, nullptr);
+    glCompileShader(rectInstanceFragmentShader);
+
+    glGetShaderiv(rectInstanceFragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(rectInstanceFragmentShader, 512, nullptr, infoLog);
+        throw std::runtime_error(std::string("Rect instance fragment shader compilation failed: ") + infoLog);
+    }
+
+    rectInstanceShaderProgram_ = glCreateProgram();
+    glAttachShader(rectInstanceShaderProgram_, rectInstanceVertexShader);
+    glAttachShader(rectInstanceShaderProgram_, rectInstanceFragmentShader);
+    glLinkProgram(rectInstanceShaderProgram_);
+
+    glGetProgramiv(rectInstanceShaderProgram_, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(rectInstanceShaderProgram_, 512, nullptr, infoLog);
+        throw std::runtime_error(std::string("Rect instance shader program linking failed: ") + infoLog);
+    }
+
+    glDeleteShader(rectInstanceVertexShader);
+    glDeleteShader(rectInstanceFragmentShader);
+
     // === 编译Path抗锯齿着色器 ===
     unsigned int pathAAVertexShader = glCreateShader(GL_VERTEX_SHADER);
     glShaderSource(pathAAVertexShader, 1, &pathAAVertexShaderSource, nullptr);
@@ -2062,8 +2814,31 @@ void GlRenderer::InitializeShaders() {
         throw std::runtime_error(std::string("Text shader program linking failed: ") + infoLog);
     }
 
+    // === Phase 5.1: 初始化图像着色器（复用文本顶点着色器） ===
+    unsigned int imageFragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(imageFragmentShader, 1, &imageFragmentShaderSource, nullptr);
+    glCompileShader(imageFragmentShader);
+
+    glGetShaderiv(imageFragmentShader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        glGetShaderInfoLog(imageFragmentShader, 512, nullptr, infoLog);
+        throw std::runtime_error(std::string("Image fragment shader compilation failed: ") + infoLog);
+    }
+
+    imageShaderProgram_ = glCreateProgram();
+    glAttachShader(imageShaderProgram_, textVertexShader);
+    glAttachShader(imageShaderProgram_, imageFragmentShader);
+    glLinkProgram(imageShaderProgram_);
+
+    glGetProgramiv(imageShaderProgram_, GL_LINK_STATUS, &success);
+    if (!success) {
+        glGetProgramInfoLog(imageShaderProgram_, 512, nullptr, infoLog);
+        throw std::runtime_error(std::string("Image shader program linking failed: ") + infoLog);
+    }
+
     glDeleteShader(textVertexShader);
     glDeleteShader(textFragmentShader);
+    glDeleteShader(imageFragmentShader);
 }
 
 void GlRenderer::InitializeBuffers() {
@@ -2122,16 +2897,53 @@ void GlRenderer::InitializeBuffers() {
     
     glBindVertexArray(textVAO_);
     glBindBuffer(GL_ARRAY_BUFFER, textVBO_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+    textVBOCapacity_ = 6 * 4;
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * textVBOCapacity_, nullptr, GL_DYNAMIC_DRAW);
     
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
     
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
+
+    // === Phase 5.1: 初始化实例化矩形缓冲区 ===
+    glGenVertexArrays(1, &rectInstanceVAO_);
+    glGenBuffers(1, &rectQuadVBO_);
+    glGenBuffers(1, &rectInstanceVBO_);
+    
+    glBindVertexArray(rectInstanceVAO_);
+    
+    // location = 0: 单位四边形角点（两个三角形，所有实例共享）
+    const float quadCorners[] = {
+        0.0f, 0.0f,  1.0f, 0.0f,  0.0f, 1.0f,
+        1.0f, 0.0f,  1.0f, 1.0f,  0.0f, 1.0f
+    };
+    glBindBuffer(GL_ARRAY_BUFFER, rectQuadVBO_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadCorners), quadCorners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    
+    // location = 1..5: 逐实例属性（矩形、填充色、描边色、圆角、描边参数）
+    glBindBuffer(GL_ARRAY_BUFFER, rectInstanceVBO_);
+    rectInstanceCapacity_ = 64;
+    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * kRectInstanceFloats * rectInstanceCapacity_, nullptr, GL_DYNAMIC_DRAW);
+    for (int i = 0; i < 5; ++i) {
+        GLuint location = static_cast<GLuint>(1 + i);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, kRectInstanceFloats * sizeof(float),
+                              (void*)(static_cast<std::size_t>(i) * 4 * sizeof(float)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
 }
 
 void GlRenderer::CleanupResources() {
+    ReleaseSceneTarget();
+    ReleaseAllLayerTargets();
+    geometryCache_.Clear();
+    
     if (textVBO_ != 0) {
         glDeleteBuffers(1, &textVBO_);
         textVBO_ = 0;
@@ -2142,6 +2954,21 @@ void GlRenderer::CleanupResources() {
         textVAO_ = 0;
     }
 
+    if (rectInstanceVBO_ != 0) {
+        glDeleteBuffers(1, &rectInstanceVBO_);
+        rectInstanceVBO_ = 0;
+    }
+
+    if (rectQuadVBO_ != 0) {
+        glDeleteBuffers(1, &rectQuadVBO_);
+        rectQuadVBO_ = 0;
+    }
+
+    if (rectInstanceVAO_ != 0) {
+        glDeleteVertexArrays(1, &rectInstanceVAO_);
+        rectInstanceVAO_ = 0;
+    }
+
     if (vbo_ != 0) {
         glDeleteBuffers(1, &vbo_);
         vbo_ = 0;
@@ -2157,6 +2984,11 @@ void GlRenderer::CleanupResources() {
         textShaderProgram_ = 0;
     }
 
+    if (imageShaderProgram_ != 0) {
+        glDeleteProgram(imageShaderProgram_);
+        imageShaderProgram_ = 0;
+    }
+
     if (simpleShaderProgram_ != 0) {
         glDeleteProgram(simpleShaderProgram_);
         simpleShaderProgram_ = 0;
@@ -2171,6 +3003,11 @@ void GlRenderer::CleanupResources() {
         glDeleteProgram(borderShaderProgram_);
         borderShaderProgram_ = 0;
     }
+
+    if (rectInstanceShaderProgram_ != 0) {
+        glDeleteProgram(rectInstanceShaderProgram_);
+        rectInstanceShaderProgram_ = 0;
+    }
 }
 
 } // namespace fk::render
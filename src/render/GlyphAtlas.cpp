@@ -0,0 +1,295 @@
+#include "fk/render/GlyphAtlas.h"
+#include "fk/render/TextureManager.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace fk::render {
+
+namespace {
+
+// 字形之间的间隔，避免线性过滤时采样到相邻字形
+constexpr int kGlyphPadding = 1;
+
+std::size_t BytesPerPixel(AtlasFormat format) {
+    return format == AtlasFormat::Color ? 4 : 1;
+}
+
+} // namespace
+
+GlyphAtlas::GlyphAtlas(int pageSize, std::size_t maxPages)
+    : pageSize_(pageSize)
+    , maxPages_(std::max<std::size_t>(1, maxPages)) {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    Clear();
+}
+
+void GlyphAtlas::Clear() {
+    auto& textures = TextureManager::Instance();
+    for (auto& page : pages_) {
+        if (page && page->textureID != 0) {
+            textures.Unregister(page->textureID);
+            glDeleteTextures(1, &page->textureID);
+        }
+    }
+    pages_.clear();
+}
+
+std::size_t GlyphAtlas::GetPageCount() const {
+    return static_cast<std::size_t>(std::count_if(pages_.begin(), pages_.end(),
+        [](const auto& page) { return page->textureID != 0; }));
+}
+
+bool GlyphAtlas::Allocate(AtlasFormat format, int width, int height,
+                          const unsigned char* pixels, AtlasPixelFormat pixelFormat,
+                          AtlasRegion& outRegion) {
+    if (width <= 0 || height <= 0 || !pixels) {
+        return false;
+    }
+
+    if (width + kGlyphPadding > pageSize_ || height + kGlyphPadding > pageSize_) {
+        std::cerr << "GlyphAtlas: glyph " << width << "x" << height
+                  << " exceeds atlas page size " << pageSize_ << std::endl;
+        return false;
+    }
+
+    int x = 0;
+    int y = 0;
+    int pageIndex = -1;
+
+    // 先在已有的同格式页中查找空间
+    for (std::size_t i = 0; i < pages_.size(); ++i) {
+        auto& page = *pages_[i];
+        if (page.textureID != 0 && page.format == format && Pack(page, width, height, x, y)) {
+            pageIndex = static_cast<int>(i);
+            break;
+        }
+    }
+
+    // 没有空间：新建页或淘汰最久未使用的页
+    if (pageIndex < 0) {
+        pageIndex = AcquirePage(format);
+        if (!Pack(*pages_[pageIndex], width, height, x, y)) {
+            return false;
+        }
+    }
+
+    auto& page = *pages_[pageIndex];
+    page.lastUsedFrame = frame_;
+
+    GLenum uploadFormat = GL_RED;
+    if (pixelFormat == AtlasPixelFormat::RGBA8) {
+        uploadFormat = GL_RGBA;
+    } else if (pixelFormat == AtlasPixelFormat::BGRA8) {
+        uploadFormat = GL_BGRA;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, page.textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, uploadFormat, GL_UNSIGNED_BYTE, pixels);
+    TextureManager::Instance().RecordUpload(static_cast<std::size_t>(width) * height * BytesPerPixel(format));
+
+    const float invSize = 1.0f / static_cast<float>(pageSize_);
+    outRegion.textureID = page.textureID;
+    outRegion.page = pageIndex;
+    outRegion.u0 = x * invSize;
+    outRegion.v0 = y * invSize;
+    outRegion.u1 = (x + width) * invSize;
+    outRegion.v1 = (y + height) * invSize;
+    return true;
+}
+
+void GlyphAtlas::Touch(int page) {
+    if (page >= 0 && page < static_cast<int>(pages_.size())) {
+        auto& target = *pages_[page];
+        if (target.lastUsedFrame != frame_) {
+            target.lastUsedFrame = frame_;
+            TextureManager::Instance().Touch(target.textureID);
+        }
+    }
+}
+
+int GlyphAtlas::AcquirePage(AtlasFormat format) {
+    if (GetPageCount() >= maxPages_) {
+        // 查找当前帧之前最久未使用的页
+        int victim = -1;
+        std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t i = 0; i < pages_.size(); ++i) {
+            const auto& page = *pages_[i];
+            if (page.textureID != 0 && page.lastUsedFrame < frame_ && page.lastUsedFrame < oldest) {
+                oldest = page.lastUsedFrame;
+                victim = static_cast<int>(i);
+            }
+        }
+
+        if (victim >= 0) {
+            if (onPageEvicted_) {
+                onPageEvicted_(victim);
+            }
+            pages_[victim]->format = format;
+            ResetPage(victim);
+            return victim;
+        }
+        // 所有页都在当前帧使用中，只能暂时超出上限
+    }
+
+    // 优先复用被 TextureManager 淘汰后空出的槽位，页索引保持稳定
+    int index = -1;
+    for (std::size_t i = 0; i < pages_.size(); ++i) {
+        if (pages_[i]->textureID == 0) {
+            index = static_cast<int>(i);
+            break;
+        }
+    }
+    if (index < 0) {
+        pages_.push_back(std::make_unique<Page>());
+        index = static_cast<int>(pages_.size() - 1);
+    }
+
+    auto& page = *pages_[index];
+    page.format = format;
+    glGenTextures(1, &page.textureID);
+    ResetPage(index);
+    return index;
+}
+
+void GlyphAtlas::EvictPage(int index) {
+    auto& page = *pages_[index];
+    if (onPageEvicted_) {
+        onPageEvicted_(index);
+    }
+    glDeleteTextures(1, &page.textureID);
+    page.textureID = 0;
+    page.skyline.clear();
+}
+
+void GlyphAtlas::ResetPage(int index) {
+    auto& page = *pages_[index];
+    page.skyline.clear();
+    page.skyline.push_back({0, 0, pageSize_});
+    page.lastUsedFrame = frame_;
+
+    const bool color = page.format == AtlasFormat::Color;
+    const std::size_t channels = color ? 4 : 1;
+    std::vector<unsigned char> zeros(static_cast<std::size_t>(pageSize_) * pageSize_ * channels, 0);
+
+    glBindTexture(GL_TEXTURE_2D, page.textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        color ? GL_RGBA : GL_RED,
+        pageSize_,
+        pageSize_,
+        0,
+        color ? GL_RGBA : GL_RED,
+        GL_UNSIGNED_BYTE,
+        zeros.data()
+    );
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // 页格式可能改变，每次重置都重新登记字节数
+    const std::size_t bytes = static_cast<std::size_t>(pageSize_) * pageSize_ * channels;
+    auto& textures = TextureManager::Instance();
+    textures.Register(page.textureID, bytes, [this, index](std::uint32_t) { EvictPage(index); });
+    textures.RecordUpload(bytes);
+}
+
+// ========== Skyline 打包 ==========
+
+bool GlyphAtlas::Pack(Page& page, int width, int height, int& outX, int& outY) {
+    const int paddedWidth = width + kGlyphPadding;
+    const int paddedHeight = height + kGlyphPadding;
+
+    int bestY = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    std::size_t bestIndex = page.skyline.size();
+
+    // 左下角策略：选择放置后顶边最低的位置，相同时选择更窄的节点
+    for (std::size_t i = 0; i < page.skyline.size(); ++i) {
+        int y = FitSkyline(page, i, paddedWidth, paddedHeight);
+        if (y < 0) {
+            continue;
+        }
+        int top = y + paddedHeight;
+        if (top < bestY || (top == bestY && page.skyline[i].width < bestWidth)) {
+            bestY = top;
+            bestWidth = page.skyline[i].width;
+            bestIndex = i;
+            outX = page.skyline[i].x;
+            outY = y;
+        }
+    }
+
+    if (bestIndex == page.skyline.size()) {
+        return false;
+    }
+
+    AddSkylineLevel(page, bestIndex, outX, outY, paddedWidth, paddedHeight);
+    return true;
+}
+
+int GlyphAtlas::FitSkyline(const Page& page, std::size_t index, int width, int height) const {
+    int x = page.skyline[index].x;
+    if (x + width > pageSize_) {
+        return -1;
+    }
+
+    int y = page.skyline[index].y;
+    int widthLeft = width;
+    std::size_t i = index;
+    while (widthLeft > 0) {
+        if (i >= page.skyline.size()) {
+            return -1;
+        }
+        y = std::max(y, page.skyline[i].y);
+        if (y + height > pageSize_) {
+            return -1;
+        }
+        widthLeft -= page.skyline[i].width;
+        ++i;
+    }
+    return y;
+}
+
+void GlyphAtlas::AddSkylineLevel(Page& page, std::size_t index, int x, int y, int width, int height) {
+    auto& skyline = page.skyline;
+    skyline.insert(skyline.begin() + index, SkylineNode{x, y + height, width});
+
+    // 裁掉被新节点覆盖的后续节点
+    for (std::size_t i = index + 1; i < skyline.size();) {
+        const auto& prev = skyline[i - 1];
+        auto& node = skyline[i];
+        int prevRight = prev.x + prev.width;
+        if (node.x >= prevRight) {
+            break;
+        }
+        int shrink = prevRight - node.x;
+        node.x += shrink;
+        node.width -= shrink;
+        if (node.width > 0) {
+            break;
+        }
+        skyline.erase(skyline.begin() + i);
+    }
+
+    // 合并相同高度的相邻节点
+    for (std::size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            ++i;
+        }
+    }
+}
+
+} // namespace fk::render
@@ -0,0 +1,316 @@
+#include "fk/render/ImageCache.h"
+#include "fk/render/TextureManager.h"
+#include "fk/core/TaskPool.h"
+
+#include "stb_image.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace fk::render {
+
+namespace {
+
+constexpr int kBytesPerPixel = 4;
+
+// 请求尺寸向上取整到 2 的幂，相近尺寸的元素共享同一份解码结果
+int BucketDecodeSize(int size) {
+    if (size <= 0) {
+        return 0;
+    }
+    int bucket = 1;
+    while (bucket < size) {
+        bucket <<= 1;
+    }
+    return bucket;
+}
+
+/**
+ * @brief RGBA8 图像长宽各缩小一半（2x2 盒式滤波，按 alpha 加权颜色以避免透明边缘发黑）
+ */
+void HalveImage(std::vector<unsigned char>& pixels, int& width, int& height) {
+    const int newWidth = std::max(1, width / 2);
+    const int newHeight = std::max(1, height / 2);
+    std::vector<unsigned char> result(static_cast<std::size_t>(newWidth) * newHeight * kBytesPerPixel);
+
+    for (int y = 0; y < newHeight; ++y) {
+        const int y0 = std::min(y * 2, height - 1);
+        const int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < newWidth; ++x) {
+            const int x0 = std::min(x * 2, width - 1);
+            const int x1 = std::min(x * 2 + 1, width - 1);
+            const unsigned char* samples[4] = {
+                &pixels[(static_cast<std::size_t>(y0) * width + x0) * kBytesPerPixel],
+                &pixels[(static_cast<std::size_t>(y0) * width + x1) * kBytesPerPixel],
+                &pixels[(static_cast<std::size_t>(y1) * width + x0) * kBytesPerPixel],
+                &pixels[(static_cast<std::size_t>(y1) * width + x1) * kBytesPerPixel],
+            };
+
+            unsigned int alpha = 0;
+            unsigned int rgb[3] = {0, 0, 0};
+            for (const unsigned char* sample : samples) {
+                alpha += sample[3];
+                for (int c = 0; c < 3; ++c) {
+                    rgb[c] += sample[c] * sample[3];
+                }
+            }
+
+            unsigned char* out = &result[(static_cast<std::size_t>(y) * newWidth + x) * kBytesPerPixel];
+            for (int c = 0; c < 3; ++c) {
+                out[c] = alpha > 0 ? static_cast<unsigned char>((rgb[c] + alpha / 2) / alpha) : 0;
+            }
+            out[3] = static_cast<unsigned char>((alpha + 2) / 4);
+        }
+    }
+
+    pixels.swap(result);
+    width = newWidth;
+    height = newHeight;
+}
+
+} // namespace
+
+// ========== ImageResource ==========
+
+ImageResource::ImageResource(std::string path, int decodeWidth, int decodeHeight)
+    : path_(std::move(path)), decodeWidth_(decodeWidth), decodeHeight_(decodeHeight) {}
+
+ImageResource::~ImageResource() {
+    ImageCache::Instance().OnResourceReleased(textureId_);
+}
+
+void ImageResource::SetState(ImageLoadState state) {
+    state_ = state;
+    StateChanged(state);
+}
+
+// ========== ImageCache ==========
+
+ImageCache& ImageCache::Instance() {
+    static ImageCache instance;
+    return instance;
+}
+
+void ImageCache::SetDispatcher(std::shared_ptr<core::Dispatcher> dispatcher) {
+    dispatcher_ = dispatcher;
+}
+
+std::shared_ptr<ImageResource> ImageCache::Load(const std::string& path, int decodeWidth, int decodeHeight) {
+    decodeWidth = BucketDecodeSize(decodeWidth);
+    decodeHeight = BucketDecodeSize(decodeHeight);
+
+    std::string key = path;
+    key += '|';
+    key += std::to_string(decodeWidth);
+    key += 'x';
+    key += std::to_string(decodeHeight);
+
+    auto& entry = resources_[key];
+    if (auto existing = entry.lock()) {
+        return existing;
+    }
+
+    auto resource = std::make_shared<ImageResource>(path, decodeWidth, decodeHeight);
+    entry = resource;
+    StartDecode(resource);
+    return resource;
+}
+
+void ImageCache::Reload(const std::shared_ptr<ImageResource>& resource) {
+    if (!resource || resource->state_ != ImageLoadState::Evicted) {
+        return;
+    }
+    // 不触发 StateChanged：尺寸不变，纹理就绪后由 Ready 通知重绘
+    resource->state_ = ImageLoadState::Decoding;
+    StartDecode(resource);
+}
+
+void ImageCache::StartDecode(const std::shared_ptr<ImageResource>& resource) {
+    auto dispatcher = dispatcher_.lock();
+    if (!dispatcher) {
+        // 没有 UI 线程调度器：在调用线程解码（纹理仍在 ProcessUploads 中分批上传）
+        auto image = Decode(resource->path_, resource->decodeWidth_, resource->decodeHeight_);
+        OnDecoded(resource, image);
+        return;
+    }
+
+    std::weak_ptr<ImageResource> weakResource = resource;
+    core::TaskPool::Shared()
+        .Run([path = resource->path_, decodeWidth = resource->decodeWidth_, decodeHeight = resource->decodeHeight_]() {
+            return Decode(path, decodeWidth, decodeHeight);
+        })
+        .Then(dispatcher, [this, weakResource](DecodedImage& image) {
+            // 等待解码期间所有使用者都已释放时直接丢弃结果
+            if (auto target = weakResource.lock()) {
+                OnDecoded(target, image);
+            }
+        });
+}
+
+ImageCache::DecodedImage ImageCache::Decode(const std::string& path, int decodeWidth, int decodeHeight) {
+    DecodedImage image;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    // 统一解码为 RGBA，纹理格式与着色器不需要区分通道数
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, kBytesPerPixel);
+    if (!data) {
+        std::cerr << "Failed to load image: " << path << std::endl;
+        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
+        return image;
+    }
+    image.pixels.assign(data, data + static_cast<std::size_t>(width) * height * kBytesPerPixel);
+    stbi_image_free(data);
+
+    image.sourceWidth = width;
+    image.sourceHeight = height;
+
+    // 缩小到不小于请求尺寸的最小 2 的幂分之一
+    auto canHalve = [&]() {
+        if (decodeWidth == 0 && decodeHeight == 0) {
+            return false;
+        }
+        const bool widthFits = decodeWidth == 0 || width / 2 >= decodeWidth;
+        const bool heightFits = decodeHeight == 0 || height / 2 >= decodeHeight;
+        return widthFits && heightFits && width > 1 && height > 1;
+    };
+    while (canHalve()) {
+        HalveImage(image.pixels, width, height);
+    }
+
+    image.width = width;
+    image.height = height;
+    return image;
+}
+
+void ImageCache::OnDecoded(const std::shared_ptr<ImageResource>& resource, DecodedImage& image) {
+    if (image.pixels.empty()) {
+        resource->SetState(ImageLoadState::Failed);
+        return;
+    }
+
+    resource->sourceWidth_ = image.sourceWidth;
+    resource->sourceHeight_ = image.sourceHeight;
+    resource->width_ = image.width;
+    resource->height_ = image.height;
+    resource->pixels_ = std::move(image.pixels);
+    resource->uploadedRows_ = 0;
+    uploadQueue_.push_back(resource);
+    resource->SetState(ImageLoadState::Uploading);
+}
+
+void ImageCache::OnTextureEvicted(ImageResource& resource) {
+    resource.textureId_ = 0;
+    resource.uploadedRows_ = 0;
+    std::vector<unsigned char>().swap(resource.pixels_);
+    resource.SetState(ImageLoadState::Evicted);
+}
+
+void ImageCache::OnResourceReleased(std::uint32_t textureId) {
+    std::lock_guard lock(releaseMutex_);
+    if (textureId != 0) {
+        releasedTextures_.push_back(textureId);
+    }
+    hasReleasedResources_ = true;
+}
+
+std::size_t ImageCache::ProcessUploads() {
+    std::vector<std::uint32_t> released;
+    bool sweep = false;
+    {
+        std::lock_guard lock(releaseMutex_);
+        released.swap(releasedTextures_);
+        sweep = hasReleasedResources_;
+        hasReleasedResources_ = false;
+    }
+    auto& textures = TextureManager::Instance();
+    for (auto textureId : released) {
+        // 渲染列表中的 DrawImage 命令仍引用时推迟到引用归零后删除
+        textures.Retire(textureId);
+    }
+    if (sweep) {
+        std::erase_if(resources_, [](const auto& entry) { return entry.second.expired(); });
+    }
+
+    std::size_t uploaded = 0;
+    bool bound = false;
+    while (!uploadQueue_.empty() && uploaded < uploadBudget_) {
+        auto resource = uploadQueue_.front().lock();
+        if (!resource || resource->state_ != ImageLoadState::Uploading) {
+            uploadQueue_.pop_front();
+            continue;
+        }
+
+        if (!bound) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            bound = true;
+        }
+
+        if (resource->textureId_ == 0) {
+            GLuint texture = 0;
+            glGenTextures(1, &texture);
+            glBindTexture(GL_TEXTURE_2D, texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            // 只分配存储，像素按行分批上传
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, resource->width_, resource->height_, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            resource->textureId_ = texture;
+
+            const std::size_t bytes = static_cast<std::size_t>(resource->width_) * resource->height_ * kBytesPerPixel;
+            std::weak_ptr<ImageResource> weakResource = resource;
+            textures.Register(texture, bytes, [weakResource](std::uint32_t textureId) {
+                glDeleteTextures(1, &textureId);
+                if (auto target = weakResource.lock()) {
+                    OnTextureEvicted(*target);
+                }
+            });
+        } else {
+            glBindTexture(GL_TEXTURE_2D, resource->textureId_);
+        }
+        // 上传中的纹理不参与本帧淘汰
+        textures.Touch(resource->textureId_);
+
+        const std::size_t rowBytes = static_cast<std::size_t>(resource->width_) * kBytesPerPixel;
+        const int remainingRows = resource->height_ - resource->uploadedRows_;
+        const int budgetRows = static_cast<int>(std::max<std::size_t>(1, (uploadBudget_ - uploaded) / rowBytes));
+        const int rows = std::min(remainingRows, budgetRows);
+
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, resource->uploadedRows_, resource->width_, rows,
+                        GL_RGBA, GL_UNSIGNED_BYTE,
+                        resource->pixels_.data() + rowBytes * static_cast<std::size_t>(resource->uploadedRows_));
+        resource->uploadedRows_ += rows;
+        uploaded += rowBytes * static_cast<std::size_t>(rows);
+        textures.RecordUpload(rowBytes * static_cast<std::size_t>(rows));
+
+        if (resource->uploadedRows_ >= resource->height_) {
+            std::vector<unsigned char>().swap(resource->pixels_);
+            uploadQueue_.pop_front();
+            resource->SetState(ImageLoadState::Ready);
+        }
+    }
+
+    if (bound) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    return uploaded;
+}
+
+bool ImageCache::HasPendingUploads() const {
+    if (!uploadQueue_.empty()) {
+        return true;
+    }
+    std::lock_guard lock(releaseMutex_);
+    return !releasedTextures_.empty();
+}
+
+std::size_t ImageCache::Size() const {
+    return static_cast<std::size_t>(std::count_if(resources_.begin(), resources_.end(),
+        [](const auto& entry) { return !entry.second.expired(); }));
+}
+
+} // namespace fk::render
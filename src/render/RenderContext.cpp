@@ -1,6 +1,7 @@
 #include "fk/render/RenderContext.h"
 #include "fk/render/RenderList.h"
 #include "fk/render/TextRenderer.h"
+#include "fk/render/DamageRegion.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -129,30 +130,57 @@ bool RenderContext::IsClipped(const ui::Rect& rect) const {
 
 // ========== 图层管理 ==========
 
-void RenderContext::PushLayer(float opacity) {
+void RenderContext::PushLayer(float opacity, std::uint64_t cacheId, std::uint64_t contentVersion) {
     // 保存当前状态
-    layerStack_.push(LayerState{currentOpacity_});
-    
-    // 累积透明度
+    LayerState state;
+    state.opacity = currentOpacity_;
+    state.clip = currentClip_;
+    state.cached = cacheId != 0;
+    state.commandIndex = renderList_ ? renderList_->GetCommandCount() : 0;
+    layerStack_.push(state);
+    
+    // 累积透明度（仅供查询：图层由渲染器离屏绘制后整体合成，颜色不再预乘透明度）
     currentOpacity_ *= opacity;
     
-    // 生成 PushLayer 命令
+    // 缓存位图需要完整的图层内容：图层内不继承外部裁剪，合成时再裁剪
+    if (state.cached) {
+        currentClip_ = ClipState{ui::Rect{0, 0, 10000, 10000}, false};
+    }
+    
+    // 生成 PushLayer 命令（包围盒在 PopLayer 时回填）
     if (renderList_) {
         LayerPayload payload;
         payload.opacity = opacity;
+        payload.cacheId = cacheId;
+        payload.contentVersion = contentVersion;
         renderList_->AddCommand(RenderCommand(CommandType::PushLayer, payload));
     }
 }
 
 void RenderContext::PopLayer() {
     if (!layerStack_.empty()) {
-        currentOpacity_ = layerStack_.top().opacity;
+        LayerState state = layerStack_.top();
         layerStack_.pop();
+        currentOpacity_ = state.opacity;
         
-        // 生成 PopLayer 命令
         if (renderList_) {
+            // 图层内容的包围盒决定离屏目标的大小；非缓存图层只需要可见部分
+            std::size_t start = state.commandIndex + 1;
+            ui::Rect bounds = renderList_->ComputeBounds(start, renderList_->GetCommandCount() - start);
+            if (!state.cached && state.clip.enabled) {
+                bounds = bounds.Intersect(state.clip.clipRect);
+            }
+            renderList_->SetLayerBounds(state.commandIndex, bounds);
+            
+            // 生成 PopLayer 命令
             renderList_->AddCommand(RenderCommand(CommandType::PopLayer, std::monostate{}));
         }
+        
+        // 恢复缓存图层外部的裁剪
+        if (state.cached) {
+            currentClip_ = state.clip;
+            ApplyCurrentClip();
+        }
     }
 }
 
@@ -160,6 +188,100 @@ float RenderContext::GetCurrentOpacity() const {
     return currentOpacity_;
 }
 
+// ========== 子树命令缓存（Phase 5.1） ==========
+
+bool RenderContext::ReplayCachedCommands(RenderCacheEntry& entry) {
+    if (!renderList_ || !previousList_ || entry.generation == 0 ||
+        entry.generation != previousList_->GetGeneration() ||
+        entry.start + entry.count > previousList_->GetCommandCount()) {
+        return false;
+    }
+
+    // 命令已烘焙全局坐标和裁剪，进入状态必须完全一致（透明度由外层图层合成，不影响命令）
+    if (entry.transform.offsetX != currentTransform_.offsetX ||
+        entry.transform.offsetY != currentTransform_.offsetY ||
+        entry.clip.enabled != currentClip_.enabled ||
+        entry.clip.clipRect.x != currentClip_.clipRect.x ||
+        entry.clip.clipRect.y != currentClip_.clipRect.y ||
+        entry.clip.clipRect.width != currentClip_.clipRect.width ||
+        entry.clip.clipRect.height != currentClip_.clipRect.height) {
+        return false;
+    }
+
+    std::size_t start = renderList_->GetCommandCount();
+    renderList_->AppendRange(*previousList_, entry.start, entry.count);
+
+    // 命令区间迁移到当前列表，供下一帧继续复用
+    entry.start = start;
+    entry.generation = renderList_->GetGeneration();
+    return true;
+}
+
+bool RenderContext::BeginCacheRecord(RenderCacheEntry& entry, bool contentChanged) {
+    // 内容变化的子树：旧命令覆盖的区域需要重绘（新区域在结束时计入）
+    bool trackDamage = damage_ && contentChanged && damageTrackingDepth_ == 0;
+    if (trackDamage) {
+        AddPreviousDamage(entry);
+        ++damageTrackingDepth_;
+    }
+
+    entry.generation = 0;
+    entry.start = renderList_ ? renderList_->GetCommandCount() : 0;
+    entry.count = 0;
+    entry.transform = currentTransform_;
+    entry.clip = currentClip_;
+    return trackDamage;
+}
+
+void RenderContext::EndCacheRecord(RenderCacheEntry& entry, bool trackDamage) {
+    if (!renderList_) {
+        return;
+    }
+    entry.count = renderList_->GetCommandCount() - entry.start;
+    entry.generation = renderList_->GetGeneration();
+
+    if (trackDamage) {
+        damage_->Add(renderList_->ComputeBounds(entry.start, entry.count));
+        --damageTrackingDepth_;
+    }
+}
+
+void RenderContext::AddPreviousDamage(const RenderCacheEntry& entry) {
+    // 只有上一帧绘制过的命令才在屏幕上留下了像素
+    if (!damage_ || !previousList_ || entry.generation == 0 ||
+        entry.generation != previousList_->GetGeneration()) {
+        return;
+    }
+    damage_->Add(previousList_->ComputeBounds(entry.start, entry.count));
+}
+
+void RenderContext::AddDamage(const ui::Rect& rect) {
+    if (!IsTrackingDamage()) {
+        return;
+    }
+    ui::Rect globalRect = TransformRect(rect);
+    damage_->Add(currentClip_.enabled ? globalRect.Intersect(currentClip_.clipRect) : globalRect);
+}
+
+// ========== 合成滚动 ==========
+
+void RenderContext::AppendTranslated(const RenderList& source, float offsetX, float offsetY) {
+    if (!renderList_ || source.IsEmpty()) {
+        return;
+    }
+
+    ClipPayload clip;
+    clip.clipRect = currentClip_.clipRect;
+    clip.enabled = currentClip_.enabled;
+    renderList_->AppendTranslated(source, 0, source.GetCommandCount(),
+                                  currentTransform_.offsetX + offsetX,
+                                  currentTransform_.offsetY + offsetY, clip);
+
+    // 保留的命令以自身的变换和裁剪结束
+    ApplyCurrentTransform();
+    ApplyCurrentClip();
+}
+
 // ========== 绘制 API ==========
 
 void RenderContext::DrawBorder(
@@ -186,15 +308,11 @@ void RenderContext::DrawBorder(
     // 变换到全局坐标
     ui::Rect globalRect = TransformRect(rect);
     
-    // 应用透明度
-    auto finalFillColor = ApplyOpacity(fillColor);
-    auto finalStrokeColor = ApplyOpacity(strokeColor);
-    
     // 生成绘制命令
     RectanglePayload payload;
     payload.rect = globalRect;
-    payload.fillColor = finalFillColor;
-    payload.strokeColor = finalStrokeColor;
+    payload.fillColor = fillColor;
+    payload.strokeColor = strokeColor;
     payload.strokeThickness = strokeWidth;
     payload.cornerRadiusTopLeft = cornerRadiusTopLeft;
     payload.cornerRadiusTopRight = cornerRadiusTopRight;
@@ -228,15 +346,11 @@ void RenderContext::DrawRectangle(
     // 变换到全局坐标
     ui::Rect globalRect = TransformRect(rect);
     
-    // 应用透明度
-    auto finalFillColor = ApplyOpacity(fillColor);
-    auto finalStrokeColor = ApplyOpacity(strokeColor);
-    
     // 生成绘制命令 - 使用椭圆圆角
     RectanglePayload payload;
     payload.rect = globalRect;
-    payload.fillColor = finalFillColor;
-    payload.strokeColor = finalStrokeColor;
+    payload.fillColor = fillColor;
+    payload.strokeColor = strokeColor;
     payload.strokeThickness = strokeWidth;
     payload.cornerRadiusTopLeft = 0.0f;   // 不使用独立圆角
     payload.cornerRadiusTopRight = 0.0f;
@@ -252,14 +366,10 @@ void RenderContext::DrawRectangle(
 
 void RenderContext::DrawText(
     const ui::Rect& bounds,
-    const std::string& text,
-    const std::array<float, 4>& color,
-    float fontSize,
-    const std::string& fontFamily,
-    float maxWidth,
-    bool textWrapping)
+    std::shared_ptr<const TextLayout> layout,
+    const std::array<float, 4>& color)
 {
-    if (text.empty() || !renderList_) {
+    if (!layout || layout->GetGlyphs().empty() || !renderList_) {
         return;
     }
     
@@ -268,21 +378,11 @@ void RenderContext::DrawText(
         return;
     }
     
-    // 变换到全局坐标
-    ui::Rect globalBounds = TransformRect(bounds);
-    
-    // 应用透明度
-    auto finalColor = ApplyOpacity(color);
-    
-    // Phase 5.0.5: 生成完整的文本绘制命令,包含边界用于裁剪
+    // Phase 5.1: 命令只引用排版结果，渲染器按字形位置绘制并裁剪到 bounds
     TextPayload payload;
-    payload.bounds = globalBounds; // 使用完整边界
-    payload.color = finalColor;
-    payload.text = text;
-    payload.fontSize = fontSize;
-    payload.fontFamily = fontFamily;
-    payload.maxWidth = maxWidth > 0 ? maxWidth : globalBounds.width; // 如果没指定maxWidth则使用bounds宽度
-    payload.textWrapping = textWrapping;
+    payload.bounds = TransformRect(bounds);
+    payload.color = color;
+    payload.layout = std::move(layout);
     
     renderList_->AddCommand(RenderCommand(CommandType::DrawText, payload));
 }
@@ -328,13 +428,10 @@ void RenderContext::DrawLine(
     ui::Point globalStart = TransformPoint(start);
     ui::Point globalEnd = TransformPoint(end);
     
-    // 应用透明度
-    auto finalColor = ApplyOpacity(color);
-    
     // 使用多边形绘制线条（2个点）
     PolygonPayload payload;
     payload.points = {globalStart, globalEnd};
-    payload.strokeColor = finalColor;
+    payload.strokeColor = color;
     payload.strokeThickness = width;
     payload.filled = false;
     
@@ -358,15 +455,11 @@ void RenderContext::DrawPolygon(
         globalPoints.push_back(TransformPoint(point));
     }
     
-    // 应用透明度
-    auto finalFillColor = ApplyOpacity(fillColor);
-    auto finalStrokeColor = ApplyOpacity(strokeColor);
-    
     // 生成绘制命令
     PolygonPayload payload;
     payload.points = globalPoints;
-    payload.fillColor = finalFillColor;
-    payload.strokeColor = finalStrokeColor;
+    payload.fillColor = fillColor;
+    payload.strokeColor = strokeColor;
     payload.strokeThickness = strokeWidth;
     payload.filled = true;
     
@@ -434,15 +527,11 @@ void RenderContext::DrawPath(
         globalSegments.push_back(globalSegment);
     }
     
-    // 应用透明度
-    auto finalFillColor = ApplyOpacity(fillColor);
-    auto finalStrokeColor = ApplyOpacity(strokeColor);
-    
     // 生成绘制命令
     PathPayload payload;
     payload.segments = globalSegments;
-    payload.fillColor = finalFillColor;
-    payload.strokeColor = finalStrokeColor;
+    payload.fillColor = fillColor;
+    payload.strokeColor = strokeColor;
     payload.strokeThickness = strokeWidth;
     payload.filled = true;
     
@@ -466,13 +555,11 @@ void RenderContext::DrawImage(
     // 变换到全局坐标
     ui::Rect globalBounds = TransformRect(bounds);
     
-    // 应用透明度到着色
-    auto finalTint = ApplyOpacity(tint);
-    
     // 生成绘制命令
     ImagePayload payload;
     payload.destRect = globalBounds;
     payload.textureId = textureId;
+    payload.tint = tint;
     
     renderList_->AddCommand(RenderCommand(CommandType::DrawImage, payload));
 }
@@ -543,13 +630,4 @@ void RenderContext::ApplyCurrentClip() {
     renderList_->AddCommand(RenderCommand(CommandType::SetClip, payload));
 }
 
-std::array<float, 4> RenderContext::ApplyOpacity(const std::array<float, 4>& color) const {
-    return {
-        color[0],
-        color[1],
-        color[2],
-        color[3] * currentOpacity_  // 应用透明度
-    };
-}
-
 } // namespace fk::render
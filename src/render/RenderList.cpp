@@ -1,10 +1,127 @@
 #include "fk/render/RenderList.h"
+#include "fk/render/TextureManager.h"
 #include <algorithm>
+#include <atomic>
+#include <optional>
 #include <unordered_set>
 
 namespace fk::render {
 
-RenderList::RenderList() {
+namespace {
+
+std::uint64_t NextGeneration() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
+
+} // namespace
+
+bool GetCommandBounds(const RenderCommand& command, ui::Rect& outBounds) {
+    auto inflate = [](const ui::Rect& rect, float amount) {
+        return ui::Rect(rect.x - amount, rect.y - amount, rect.width + amount * 2.0f, rect.height + amount * 2.0f);
+    };
+    auto pointsBounds = [](const std::vector<ui::Point>& points, ui::Rect& bounds) {
+        for (const auto& point : points) {
+            bounds = bounds.Union(ui::Rect(point.x, point.y, 0.001f, 0.001f));
+        }
+    };
+
+    switch (command.type) {
+        case CommandType::DrawRectangle: {
+            const auto& payload = std::get<RectanglePayload>(command.payload);
+            outBounds = inflate(payload.rect, payload.strokeThickness + payload.aaWidth + 1.0f);
+            return true;
+        }
+        case CommandType::DrawText:
+            // DrawText 会裁剪到 bounds 内
+            outBounds = std::get<TextPayload>(command.payload).bounds;
+            return true;
+        case CommandType::DrawImage:
+            outBounds = std::get<ImagePayload>(command.payload).destRect;
+            return true;
+        case CommandType::DrawPolygon: {
+            const auto& payload = std::get<PolygonPayload>(command.payload);
+            ui::Rect bounds;
+            pointsBounds(payload.points, bounds);
+            outBounds = inflate(bounds, payload.strokeThickness + 1.0f);
+            return true;
+        }
+        case CommandType::DrawPath: {
+            const auto& payload = std::get<PathPayload>(command.payload);
+            ui::Rect bounds;
+            float stroke = payload.strokeThickness;
+            float arcRadius = 0.0f;
+            for (const auto& segment : payload.segments) {
+                stroke = std::max(stroke, segment.subPathStrokeThickness);
+                if (segment.type == PathSegmentType::ArcTo) {
+                    // ArcTo 的点布局: [0] 半径, [1] 角度, [2] 标志, [3] 终点
+                    // 只有终点是坐标；圆弧可能超出端点范围，按半径外扩
+                    if (segment.points.size() >= 4) {
+                        const auto& end = segment.points[3];
+                        bounds = bounds.Union(ui::Rect(end.x, end.y, 0.001f, 0.001f));
+                        arcRadius = std::max({arcRadius, segment.points[0].x, segment.points[0].y});
+                    }
+                    continue;
+                }
+                pointsBounds(segment.points, bounds);
+            }
+            outBounds = inflate(bounds, stroke + arcRadius + 1.0f);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void TranslateCommand(RenderCommand& command, float dx, float dy) {
+    auto translate = [dx, dy](ui::Rect& rect) {
+        rect.x += dx;
+        rect.y += dy;
+    };
+    auto translatePoints = [dx, dy](std::vector<ui::Point>& points) {
+        for (auto& point : points) {
+            point.x += dx;
+            point.y += dy;
+        }
+    };
+
+    switch (command.type) {
+        case CommandType::SetClip:
+            translate(std::get<ClipPayload>(command.payload).clipRect);
+            break;
+        case CommandType::SetTransform: {
+            auto& payload = std::get<TransformPayload>(command.payload);
+            payload.offsetX += dx;
+            payload.offsetY += dy;
+            break;
+        }
+        case CommandType::DrawRectangle:
+            translate(std::get<RectanglePayload>(command.payload).rect);
+            break;
+        case CommandType::DrawText:
+            translate(std::get<TextPayload>(command.payload).bounds);
+            break;
+        case CommandType::DrawImage:
+            translate(std::get<ImagePayload>(command.payload).destRect);
+            break;
+        case CommandType::DrawPolygon:
+            translatePoints(std::get<PolygonPayload>(command.payload).points);
+            break;
+        case CommandType::DrawPath:
+            for (auto& segment : std::get<PathPayload>(command.payload).segments) {
+                translatePoints(segment.points);
+            }
+            break;
+        case CommandType::PushLayer:
+            translate(std::get<LayerPayload>(command.payload).bounds);
+            break;
+        default:
+            break;
+    }
+}
+
+RenderList::RenderList()
+    : generation_(NextGeneration()) {
     // 预分配合理的初始容量
     commands_.reserve(256);
     batches_.reserve(32);
@@ -15,25 +132,157 @@ RenderList::~RenderList() {
 }
 
 void RenderList::AddCommand(const RenderCommand& command) {
+    ReferenceTexture(command);
     commands_.push_back(command);
     optimized_ = false;
 }
 
 void RenderList::AddCommand(RenderCommand&& command) {
+    ReferenceTexture(command);
     commands_.push_back(std::move(command));
     optimized_ = false;
 }
 
 void RenderList::AddCommands(const std::vector<RenderCommand>& commands) {
+    for (const auto& command : commands) {
+        ReferenceTexture(command);
+    }
     commands_.insert(commands_.end(), commands.begin(), commands.end());
     optimized_ = false;
 }
 
+void RenderList::AppendRange(const RenderList& source, size_t start, size_t count) {
+    if (start >= source.commands_.size()) {
+        return;
+    }
+    auto first = source.commands_.begin() + start;
+    auto last = first + std::min(count, source.commands_.size() - start);
+    for (auto it = first; it != last; ++it) {
+        ReferenceTexture(*it);
+    }
+    commands_.insert(commands_.end(), first, last);
+    optimized_ = false;
+}
+
+void RenderList::AppendTranslated(const RenderList& source, size_t start, size_t count,
+                                  float dx, float dy, const ClipPayload& clip) {
+    if (start >= source.commands_.size()) {
+        return;
+    }
+    size_t end = start + std::min(count, source.commands_.size() - start);
+
+    ClipPayload active = clip;            // 当前生效的裁剪（目标坐标）
+    std::vector<bool> layerCached;        // 图层栈：是否为缓存位图图层
+    size_t cachedDepth = 0;
+    for (size_t i = start; i < end; ++i) {
+        const auto& sourceCommand = source.commands_[i];
+        switch (sourceCommand.type) {
+            case CommandType::SetTransform:
+                // 命令坐标已经是全局坐标，渲染器不使用变换命令
+                continue;
+            case CommandType::PushLayer: {
+                bool cached = std::get<LayerPayload>(sourceCommand.payload).cacheId != 0;
+                layerCached.push_back(cached);
+                cachedDepth += cached ? 1 : 0;
+                break;
+            }
+            case CommandType::PopLayer:
+                if (!layerCached.empty()) {
+                    cachedDepth -= layerCached.back() ? 1 : 0;
+                    layerCached.pop_back();
+                }
+                break;
+            default: {
+                ui::Rect bounds;
+                if (cachedDepth == 0 && active.enabled && GetCommandBounds(sourceCommand, bounds)) {
+                    bounds.x += dx;
+                    bounds.y += dy;
+                    if (!bounds.Intersects(active.clipRect)) {
+                        continue;
+                    }
+                }
+                break;
+            }
+        }
+
+        RenderCommand command = sourceCommand;
+        TranslateCommand(command, dx, dy);
+        if (command.type == CommandType::SetClip && cachedDepth == 0) {
+            auto& payload = std::get<ClipPayload>(command.payload);
+            if (!payload.enabled) {
+                payload = clip;
+            } else if (clip.enabled) {
+                payload.clipRect = payload.clipRect.Intersect(clip.clipRect);
+            }
+            active = payload;
+        }
+        ReferenceTexture(command);
+        commands_.push_back(std::move(command));
+    }
+    optimized_ = false;
+}
+
+ui::Rect RenderList::ComputeBounds(size_t start, size_t count) const {
+    ui::Rect bounds;
+    std::optional<ui::Rect> clip;
+    std::vector<std::optional<ui::Rect>> layerClips;  // 进入各层图层时的裁剪
+    size_t end = std::min(commands_.size(), start + count);
+    for (size_t i = start; i < end; ++i) {
+        const auto& command = commands_[i];
+        switch (command.type) {
+            case CommandType::SetClip: {
+                const auto& payload = std::get<ClipPayload>(command.payload);
+                std::optional<ui::Rect> limit = layerClips.empty() ? std::nullopt : layerClips.back();
+                if (payload.enabled) {
+                    clip = limit ? payload.clipRect.Intersect(*limit) : payload.clipRect;
+                } else {
+                    clip = limit;
+                }
+                break;
+            }
+            case CommandType::PushLayer:
+                layerClips.push_back(clip);
+                break;
+            case CommandType::PopLayer:
+                if (!layerClips.empty()) {
+                    clip = layerClips.back();
+                    layerClips.pop_back();
+                }
+                break;
+            default: {
+                ui::Rect commandBounds;
+                if (GetCommandBounds(command, commandBounds)) {
+                    bounds = bounds.Union(clip ? commandBounds.Intersect(*clip) : commandBounds);
+                }
+                break;
+            }
+        }
+    }
+    return bounds;
+}
+
+void RenderList::SetLayerBounds(size_t index, const ui::Rect& bounds) {
+    if (index >= commands_.size()) {
+        return;
+    }
+    if (auto* payload = std::get_if<LayerPayload>(&commands_[index].payload)) {
+        payload->bounds = bounds;
+    }
+}
+
 void RenderList::Clear() {
+    if (!textureRefs_.empty()) {
+        auto& textures = TextureManager::Instance();
+        for (auto textureId : textureRefs_) {
+            textures.Release(textureId);
+        }
+        textureRefs_.clear();
+    }
     commands_.clear();
     batches_.clear();
     stats_ = RenderListStats{};
     optimized_ = false;
+    generation_ = NextGeneration();
 }
 
 void RenderList::Reserve(size_t capacity) {
@@ -58,6 +307,11 @@ void RenderList::Optimize() {
     stats_.duplicatesRemoved = beforeCount - commands_.size();
     UpdateStats();
     
+    // 去重会移动命令位置，之前记录的命令区间失效
+    if (stats_.duplicatesRemoved > 0) {
+        generation_ = NextGeneration();
+    }
+    
     optimized_ = true;
 }
 
@@ -114,6 +368,17 @@ void RenderList::RemoveDuplicates() {
     commands_ = std::move(uniqueCommands);
 }
 
+void RenderList::ReferenceTexture(const RenderCommand& command) {
+    if (command.type != CommandType::DrawImage) {
+        return;
+    }
+    const auto* payload = std::get_if<ImagePayload>(&command.payload);
+    if (payload && payload->textureId != 0) {
+        TextureManager::Instance().AddRef(payload->textureId);
+        textureRefs_.push_back(payload->textureId);
+    }
+}
+
 void RenderList::UpdateStats() {
     stats_.totalCommands = commands_.size();
     stats_.batchCount = batches_.size();
@@ -0,0 +1,85 @@
+#include "fk/render/ScrollLayer.h"
+#include "fk/render/RenderContext.h"
+#include "fk/render/RenderList.h"
+#include "fk/ui/base/UIElement.h"
+
+#include <utility>
+
+namespace fk::render {
+
+namespace {
+
+bool ContainsRect(const ui::Rect& outer, const ui::Rect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.Right() <= outer.Right() && inner.Bottom() <= outer.Bottom();
+}
+
+} // namespace
+
+ScrollLayer::ScrollLayer()
+    : current_(std::make_unique<RenderList>())
+    , previous_(std::make_unique<RenderList>()) {
+}
+
+ScrollLayer::~ScrollLayer() = default;
+
+void ScrollLayer::Compose(RenderContext& context, ui::UIElement* content, const ui::Size& viewportSize) {
+    if (!content) {
+        return;
+    }
+
+    // 内容的布局位置为负的滚动偏移，据此得到视口在内容坐标系中的位置
+    const ui::Rect layout = content->GetLayoutRect();
+    const ui::Rect visible(-layout.x, -layout.y, viewportSize.width, viewportSize.height);
+
+    bool windowValid = recorded_ && content == content_ && ContainsRect(window_, visible);
+    if (!windowValid) {
+        // 视口向四周各外扩一个视口：滚动一个视口以内不需要重新记录
+        window_ = ui::Rect(visible.x - visible.width, visible.y - visible.height,
+                           visible.width * 3.0f, visible.height * 3.0f);
+    }
+    if (!windowValid || content->IsRenderDirty()) {
+        Record(context, content, visible);
+    }
+
+    context.AppendTranslated(*current_, layout.x, layout.y);
+}
+
+void ScrollLayer::Record(RenderContext& context, ui::UIElement* content, const ui::Rect& visible) {
+    std::swap(current_, previous_);
+    current_->Clear();
+
+    RenderContext recorder(current_.get(), context.GetTextRenderer());
+    recorder.SetPreviousFrame(previous_.get());
+
+    // 视口未整体重绘时（只有内容中的部分元素变化），把内容的损坏区域换算到视口
+    bool trackDamage = context.IsTrackingDamage();
+    if (trackDamage) {
+        damage_.Reset(window_.Right(), window_.Bottom());
+        recorder.SetDamageRegion(&damage_);
+    }
+
+    // 内容原点位于内容坐标系原点：抵消内容自身的布局偏移
+    const ui::Rect layout = content->GetLayoutRect();
+    recorder.PushClip(window_);
+    recorder.PushTransform(-layout.x, -layout.y);
+    content->CollectDrawCommands(recorder);
+    recorder.PopTransform();
+    recorder.PopClip();
+
+    content_ = content;
+    recorded_ = true;
+    ++recordCount_;
+
+    if (trackDamage) {
+        if (damage_.IsFull()) {
+            context.AddDamage(ui::Rect(visible.x + layout.x, visible.y + layout.y, visible.width, visible.height));
+        } else {
+            for (const auto& rect : damage_.GetRects()) {
+                context.AddDamage(ui::Rect(rect.x + layout.x, rect.y + layout.y, rect.width, rect.height));
+            }
+        }
+    }
+}
+
+} // namespace fk::render
@@ -0,0 +1,260 @@
+#include "fk/render/SdfGlyphSet.h"
+
+#include FT_MODULE_H
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+namespace fk::render {
+
+namespace {
+
+constexpr std::uint32_t kFileMagic = 0x44534b46;  // "FKSD"
+constexpr std::uint32_t kFileVersion = 1;
+// 码位 + 宽 + 高 + 两个 bearing + advance，每个字形记录至少占用的字节数
+constexpr std::size_t kGlyphRecordBytes = sizeof(std::uint32_t) + 4 * sizeof(std::uint16_t) + sizeof(float);
+constexpr std::uint32_t kMaxGlyphs = 0x110000;  // Unicode 码位总数
+
+template <typename T>
+void WriteValue(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void WriteString(std::ostream& out, const std::string& value) {
+    WriteValue(out, static_cast<std::uint32_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+template <typename T>
+bool ReadValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool ReadString(std::istream& in, std::string& value) {
+    std::uint32_t size = 0;
+    if (!ReadValue(in, size) || size > 4096) {
+        return false;
+    }
+    value.resize(size);
+    return static_cast<bool>(in.read(value.data(), size));
+}
+
+std::unordered_map<std::string, std::shared_ptr<SdfGlyphSet>>& Registry() {
+    static std::unordered_map<std::string, std::shared_ptr<SdfGlyphSet>> registry;
+    return registry;
+}
+
+} // namespace
+
+SdfGlyphSet::SdfGlyphSet(std::string family, std::string style, int referenceSize, int spread)
+    : family_(std::move(family))
+    , style_(std::move(style))
+    , referenceSize_(referenceSize)
+    , spread_(spread) {
+}
+
+std::string SdfGlyphSet::KeyOf(FT_Face face) {
+    std::string key = face && face->family_name ? face->family_name : "";
+    key += " ";
+    key += face && face->style_name ? face->style_name : "";
+    return key;
+}
+
+bool SdfGlyphSet::Supports(FT_Face face) {
+    return face && FT_IS_SCALABLE(face) && !FT_HAS_COLOR(face);
+}
+
+const SdfGlyph* SdfGlyphSet::Find(char32_t c) const {
+    auto it = glyphs_.find(c);
+    return it != glyphs_.end() ? &it->second : nullptr;
+}
+
+const SdfGlyph* SdfGlyphSet::Generate(FT_Face face, char32_t c) {
+    if (const SdfGlyph* glyph = Find(c)) {
+        return glyph;
+    }
+    if (!face || missing_.count(c) != 0) {
+        return nullptr;
+    }
+
+    // 距离场在未 hinting 的轮廓上生成，缩放到任意字号时形状与前进值保持一致
+    const FT_UInt index = FT_Get_Char_Index(face, c);
+    if (index == 0 || FT_Load_Glyph(face, index, FT_LOAD_NO_HINTING | FT_LOAD_NO_BITMAP) != 0) {
+        missing_.insert(c);
+        return nullptr;
+    }
+
+    FT_GlyphSlot slot = face->glyph;
+    SdfGlyph glyph;
+    glyph.advance = static_cast<float>(slot->linearHoriAdvance) / 65536.0f;
+
+    // 空白字形（如空格）只有前进值
+    if (slot->format == FT_GLYPH_FORMAT_OUTLINE && slot->outline.n_points > 0) {
+        FT_Property_Set(slot->library, "sdf", "spread", &spread_);
+        if (FT_Render_Glyph(slot, FT_RENDER_MODE_SDF) != 0) {
+            missing_.insert(c);
+            return nullptr;
+        }
+        const FT_Bitmap& bitmap = slot->bitmap;
+        glyph.width = static_cast<std::uint16_t>(bitmap.width);
+        glyph.height = static_cast<std::uint16_t>(bitmap.rows);
+        glyph.bearingX = static_cast<std::int16_t>(slot->bitmap_left);
+        glyph.bearingY = static_cast<std::int16_t>(slot->bitmap_top);
+        glyph.pixels.resize(static_cast<std::size_t>(bitmap.width) * bitmap.rows);
+        for (unsigned int row = 0; row < bitmap.rows; ++row) {
+            const unsigned char* src = bitmap.pitch >= 0
+                ? bitmap.buffer + row * bitmap.pitch
+                : bitmap.buffer + (bitmap.rows - 1 - row) * (-bitmap.pitch);
+            std::copy(src, src + bitmap.width, glyph.pixels.begin() + row * bitmap.width);
+        }
+    }
+
+    ++generated_;
+    return &glyphs_.emplace(c, std::move(glyph)).first->second;
+}
+
+std::size_t SdfGlyphSet::Bake(FT_Face face, std::u32string_view codepoints) {
+    const std::size_t before = generated_;
+    for (char32_t c : codepoints) {
+        Generate(face, c);
+    }
+    return generated_ - before;
+}
+
+std::shared_ptr<SdfGlyphSet> SdfGlyphSet::BakeFont(const std::string& fontPath, int faceIndex,
+                                                   std::u32string_view codepoints,
+                                                   int referenceSize, int spread) {
+    FT_Library library = nullptr;
+    if (FT_Init_FreeType(&library) != 0) {
+        return nullptr;
+    }
+    std::shared_ptr<SdfGlyphSet> set;
+    FT_Face face = nullptr;
+    if (FT_New_Face(library, fontPath.c_str(), faceIndex, &face) == 0) {
+        if (Supports(face) && FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(referenceSize)) == 0) {
+            set = std::make_shared<SdfGlyphSet>(face->family_name ? face->family_name : "",
+                                                face->style_name ? face->style_name : "",
+                                                referenceSize, spread);
+            set->Bake(face, codepoints);
+        }
+        FT_Done_Face(face);
+    }
+    FT_Done_FreeType(library);
+    return set;
+}
+
+std::u32string SdfGlyphSet::CommonCodepoints() {
+    std::u32string codepoints;
+    for (char32_t c = 0x20; c < 0x7F; ++c) {
+        codepoints.push_back(c);
+    }
+    for (char32_t c = 0xA0; c <= 0xFF; ++c) {
+        codepoints.push_back(c);
+    }
+    return codepoints;
+}
+
+void SdfGlyphSet::Register(std::shared_ptr<SdfGlyphSet> glyphSet) {
+    if (glyphSet) {
+        auto key = glyphSet->GetKey();
+        Registry()[std::move(key)] = std::move(glyphSet);
+    }
+}
+
+std::shared_ptr<SdfGlyphSet> SdfGlyphSet::FindRegistered(const std::string& key) {
+    auto it = Registry().find(key);
+    return it != Registry().end() ? it->second : nullptr;
+}
+
+void SdfGlyphSet::ClearRegistry() {
+    Registry().clear();
+}
+
+bool SdfGlyphSet::Save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    WriteValue(out, kFileMagic);
+    WriteValue(out, kFileVersion);
+    WriteString(out, family_);
+    WriteString(out, style_);
+    WriteValue(out, static_cast<std::int32_t>(referenceSize_));
+    WriteValue(out, static_cast<std::int32_t>(spread_));
+    WriteValue(out, static_cast<std::uint32_t>(glyphs_.size()));
+    for (const auto& [codepoint, glyph] : glyphs_) {
+        WriteValue(out, static_cast<std::uint32_t>(codepoint));
+        WriteValue(out, glyph.width);
+        WriteValue(out, glyph.height);
+        WriteValue(out, glyph.bearingX);
+        WriteValue(out, glyph.bearingY);
+        WriteValue(out, glyph.advance);
+        out.write(reinterpret_cast<const char*>(glyph.pixels.data()),
+                  static_cast<std::streamsize>(glyph.pixels.size()));
+    }
+    return static_cast<bool>(out);
+}
+
+std::shared_ptr<SdfGlyphSet> SdfGlyphSet::Load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        return nullptr;
+    }
+    const auto fileSize = static_cast<std::uint64_t>(in.tellg());
+    in.seekg(0);
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::string family;
+    std::string style;
+    std::int32_t referenceSize = 0;
+    std::int32_t spread = 0;
+    std::uint32_t count = 0;
+    if (!ReadValue(in, magic) || !ReadValue(in, version) || magic != kFileMagic || version != kFileVersion ||
+        !ReadString(in, family) || !ReadString(in, style) || !ReadValue(in, referenceSize) ||
+        !ReadValue(in, spread) || !ReadValue(in, count) || referenceSize <= 0 || spread <= 0) {
+        std::cerr << "SdfGlyphSet: invalid glyph set file: " << path << std::endl;
+        return nullptr;
+    }
+
+    // 字形数和像素尺寸来自文件，分配前按剩余字节数检查，损坏的文件不会触发巨量分配
+    std::uint64_t remaining = fileSize - static_cast<std::uint64_t>(in.tellg());
+    if (count > kMaxGlyphs || count > remaining / kGlyphRecordBytes) {
+        std::cerr << "SdfGlyphSet: invalid glyph count in glyph set file: " << path << std::endl;
+        return nullptr;
+    }
+
+    try {
+        auto set = std::make_shared<SdfGlyphSet>(std::move(family), std::move(style), referenceSize, spread);
+        set->glyphs_.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::uint32_t codepoint = 0;
+            SdfGlyph glyph;
+            if (!ReadValue(in, codepoint) || !ReadValue(in, glyph.width) || !ReadValue(in, glyph.height) ||
+                !ReadValue(in, glyph.bearingX) || !ReadValue(in, glyph.bearingY) || !ReadValue(in, glyph.advance)) {
+                std::cerr << "SdfGlyphSet: truncated glyph set file: " << path << std::endl;
+                return nullptr;
+            }
+            const std::uint64_t pixelCount = static_cast<std::uint64_t>(glyph.width) * glyph.height;
+            remaining -= kGlyphRecordBytes;
+            if (pixelCount > remaining) {
+                std::cerr << "SdfGlyphSet: truncated glyph set file: " << path << std::endl;
+                return nullptr;
+            }
+            remaining -= pixelCount;
+            glyph.pixels.resize(static_cast<std::size_t>(pixelCount));
+            if (!in.read(reinterpret_cast<char*>(glyph.pixels.data()), static_cast<std::streamsize>(glyph.pixels.size()))) {
+                std::cerr << "SdfGlyphSet: truncated glyph set file: " << path << std::endl;
+                return nullptr;
+            }
+            set->glyphs_.emplace(static_cast<char32_t>(codepoint), std::move(glyph));
+        }
+        return set;
+    } catch (const std::bad_alloc&) {
+        std::cerr << "SdfGlyphSet: out of memory loading glyph set file: " << path << std::endl;
+        return nullptr;
+    }
+}
+
+} // namespace fk::render
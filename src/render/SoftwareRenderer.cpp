@@ -0,0 +1,1538 @@
+#include "fk/render/SoftwareRenderer.h"
+#include "fk/render/RenderList.h"
+#include "fk/render/RenderCommand.h"
+#include "fk/render/FontManager.h"
+#include "fk/render/SdfGlyphSet.h"
+#include "fk/render/TextLayout.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace fk::render {
+
+namespace {
+
+constexpr float kPi = 3.14159265f;
+
+// 每个像素行的子扫描线数（垂直方向抗锯齿）
+constexpr int kSubScanlines = 4;
+
+// 与 GlRenderer 的路径细分精度一致
+constexpr int kBezierSteps = 20;
+
+float Clamp01(float value) {
+    return std::clamp(value, 0.0f, 1.0f);
+}
+
+// GLSL smoothstep（允许 edge0 > edge1，此时为递减过渡）
+float SmoothStep(float edge0, float edge1, float x) {
+    float t = Clamp01((x - edge0) / (edge1 - edge0));
+    return t * t * (3.0f - 2.0f * t);
+}
+
+std::uint8_t ToByte(float value) {
+    return static_cast<std::uint8_t>(std::lround(Clamp01(value) * 255.0f));
+}
+
+// 圆形圆角矩形的 SDF（与 Border 着色器的 roundedBoxSDF 一致）
+// radius 顺序：左上、右上、右下、左下
+float RoundedBoxSdf(float px, float py, float halfW, float halfH, const std::array<float, 4>& radius) {
+    float r = px > 0.0f ? (py > 0.0f ? radius[2] : radius[1])
+                        : (py > 0.0f ? radius[3] : radius[0]);
+    float dx = std::abs(px) - halfW + r;
+    float dy = std::abs(py) - halfH + r;
+    float outside = std::hypot(std::max(dx, 0.0f), std::max(dy, 0.0f));
+    return outside + std::min(std::max(dx, dy), 0.0f) - r;
+}
+
+// 椭圆圆角矩形的 SDF（角区域使用椭圆距离的一阶近似）
+float EllipseCornerBoxSdf(float px, float py, float halfW, float halfH, float radiusX, float radiusY) {
+    float rx = std::min(radiusX, halfW);
+    float ry = std::min(radiusY, halfH);
+    float qx = std::abs(px);
+    float qy = std::abs(py);
+
+    if (qx > halfW || qy > halfH) {
+        return std::hypot(std::max(qx - halfW, 0.0f), std::max(qy - halfH, 0.0f));
+    }
+
+    float dx = qx - (halfW - rx);
+    float dy = qy - (halfH - ry);
+    if (dx <= 0.0f || dy <= 0.0f) {
+        return -std::min(halfW - qx, halfH - qy);
+    }
+    if (rx < 1e-6f || ry < 1e-6f) {
+        return std::hypot(dx, dy) - std::min(rx, ry);
+    }
+
+    float k0 = std::hypot(dx / rx, dy / ry);
+    float k1 = std::hypot(dx / (rx * rx), dy / (ry * ry));
+    return k1 > 1e-6f ? k0 * (k0 - 1.0f) / k1 : -std::min(rx, ry);
+}
+
+void EnsureOrientation(std::vector<ui::Point>& contour) {
+    // 所有描边片段统一为同一方向，非零环绕规则下重叠部分取并集
+    float area = 0.0f;
+    for (std::size_t i = 0, n = contour.size(); i < n; ++i) {
+        const auto& a = contour[i];
+        const auto& b = contour[(i + 1) % n];
+        area += a.x * b.y - b.x * a.y;
+    }
+    if (area < 0.0f) {
+        std::reverse(contour.begin(), contour.end());
+    }
+}
+
+/**
+ * @brief 非零环绕规则的扫描线覆盖率光栅化
+ *
+ * 每个像素行取 kSubScanlines 条子扫描线，子扫描线上的跨度在水平方向
+ * 按精确的小数覆盖率累加，结果逐行交给回调混合。
+ */
+class ScanlineRasterizer {
+public:
+    void AddContour(const std::vector<ui::Point>& points) {
+        const std::size_t n = points.size();
+        if (n < 3) {
+            return;
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& a = points[i];
+            const auto& b = points[(i + 1) % n];
+            if (a.y == b.y) {
+                continue;  // 水平边不产生交点
+            }
+            Edge edge = a.y < b.y ? Edge{a.x, a.y, b.x, b.y, 1} : Edge{b.x, b.y, a.x, a.y, -1};
+            minX_ = std::min({minX_, a.x, b.x});
+            maxX_ = std::max({maxX_, a.x, b.x});
+            minY_ = std::min(minY_, edge.y0);
+            maxY_ = std::max(maxY_, edge.y1);
+            edges_.push_back(edge);
+        }
+    }
+
+    template<typename EmitRow>
+    void Rasterize(int clipX0, int clipY0, int clipX1, int clipY1, EmitRow&& emitRow) {
+        if (edges_.empty()) {
+            return;
+        }
+        const int x0 = std::max(clipX0, static_cast<int>(std::floor(minX_)));
+        const int x1 = std::min(clipX1, static_cast<int>(std::ceil(maxX_)) + 1);
+        const int y0 = std::max(clipY0, static_cast<int>(std::floor(minY_)));
+        const int y1 = std::min(clipY1, static_cast<int>(std::ceil(maxY_)));
+        if (x1 <= x0 || y1 <= y0) {
+            return;
+        }
+
+        std::sort(edges_.begin(), edges_.end(), [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+
+        std::vector<float> coverage(static_cast<std::size_t>(x1 - x0), 0.0f);
+        std::vector<const Edge*> active;
+        std::vector<Crossing> crossings;
+        std::size_t nextEdge = 0;
+        const float weight = 1.0f / kSubScanlines;
+
+        for (int y = y0; y < y1; ++y) {
+            const float rowTop = static_cast<float>(y);
+            const float rowBottom = rowTop + 1.0f;
+            while (nextEdge < edges_.size() && edges_[nextEdge].y0 < rowBottom) {
+                active.push_back(&edges_[nextEdge++]);
+            }
+            std::erase_if(active, [&](const Edge* edge) { return edge->y1 <= rowTop; });
+            if (active.empty()) {
+                continue;
+            }
+
+            int touchedMin = x1;
+            int touchedMax = x0 - 1;
+            for (int s = 0; s < kSubScanlines; ++s) {
+                const float sy = rowTop + (static_cast<float>(s) + 0.5f) * weight;
+                crossings.clear();
+                for (const Edge* edge : active) {
+                    if (sy >= edge->y0 && sy < edge->y1) {
+                        float t = (sy - edge->y0) / (edge->y1 - edge->y0);
+                        crossings.push_back({edge->x0 + (edge->x1 - edge->x0) * t, edge->winding});
+                    }
+                }
+                std::sort(crossings.begin(), crossings.end(),
+                          [](const Crossing& a, const Crossing& b) { return a.x < b.x; });
+
+                int winding = 0;
+                float spanStart = 0.0f;
+                for (const auto& crossing : crossings) {
+                    const int previous = winding;
+                    winding += crossing.winding;
+                    if (previous == 0 && winding != 0) {
+                        spanStart = crossing.x;
+                    } else if (previous != 0 && winding == 0) {
+                        AddSpan(coverage, x0, x1, spanStart, crossing.x, weight, touchedMin, touchedMax);
+                    }
+                }
+            }
+
+            if (touchedMin <= touchedMax) {
+                emitRow(y, touchedMin, touchedMax + 1, coverage.data() + (touchedMin - x0));
+                std::fill(coverage.begin() + (touchedMin - x0), coverage.begin() + (touchedMax - x0 + 1), 0.0f);
+            }
+        }
+    }
+
+private:
+    struct Edge {
+        float x0;
+        float y0;
+        float x1;
+        float y1;
+        int winding;
+    };
+
+    struct Crossing {
+        float x;
+        int winding;
+    };
+
+    static void AddSpan(std::vector<float>& coverage, int x0, int x1, float a, float b, float weight,
+                        int& touchedMin, int& touchedMax) {
+        a = std::max(a, static_cast<float>(x0));
+        b = std::min(b, static_cast<float>(x1));
+        if (b <= a) {
+            return;
+        }
+        const int ia = static_cast<int>(std::floor(a));
+        const int ib = std::min(static_cast<int>(std::floor(b)), x1 - 1);
+        touchedMin = std::min(touchedMin, ia);
+        touchedMax = std::max(touchedMax, ib);
+        if (ia == ib) {
+            coverage[ia - x0] += (b - a) * weight;
+            return;
+        }
+        coverage[ia - x0] += (static_cast<float>(ia + 1) - a) * weight;
+        for (int x = ia + 1; x < ib; ++x) {
+            coverage[x - x0] += weight;
+        }
+        coverage[ib - x0] += (b - static_cast<float>(ib)) * weight;
+    }
+
+    std::vector<Edge> edges_;
+    float minX_{std::numeric_limits<float>::max()};
+    float maxX_{std::numeric_limits<float>::lowest()};
+    float minY_{std::numeric_limits<float>::max()};
+    float maxY_{std::numeric_limits<float>::lowest()};
+};
+
+/**
+ * @brief 展平后的子路径
+ */
+struct FlattenedSubPath {
+    std::vector<ui::Point> points;
+    std::vector<std::size_t> segmentIndices;  // 每个点所属的路径段（用于分段描边颜色）
+    bool closed{false};
+};
+
+void AppendPoint(FlattenedSubPath& subPath, const ui::Point& point, std::size_t segmentIndex) {
+    if (!subPath.points.empty()) {
+        const auto& last = subPath.points.back();
+        if (std::abs(point.x - last.x) <= 0.001f && std::abs(point.y - last.y) <= 0.001f) {
+            return;
+        }
+    }
+    subPath.points.push_back(point);
+    subPath.segmentIndices.push_back(segmentIndex);
+}
+
+// 展平 SVG 椭圆弧（参数约定与 GlRenderer::BuildPathGeometry 一致）
+void FlattenArc(FlattenedSubPath& subPath, const ui::Point& from, const PathSegment& segment, std::size_t segmentIndex) {
+    float rx = segment.points[0].x;
+    float ry = segment.points[0].y;
+    const float rotation = segment.points[1].x * kPi / 180.0f;
+    const bool largeArc = segment.points[2].x > 0.5f;
+    const bool sweep = segment.points[2].y > 0.5f;
+    const ui::Point end = segment.points[3];
+
+    if (std::abs(from.x - end.x) < 0.001f && std::abs(from.y - end.y) < 0.001f) {
+        return;
+    }
+    if (rx < 0.001f || ry < 0.001f) {
+        AppendPoint(subPath, end, segmentIndex);
+        return;
+    }
+    rx = std::abs(rx);
+    ry = std::abs(ry);
+
+    const float cosRot = std::cos(rotation);
+    const float sinRot = std::sin(rotation);
+    const float dx = (from.x - end.x) / 2.0f;
+    const float dy = (from.y - end.y) / 2.0f;
+    const float x1p = cosRot * dx + sinRot * dy;
+    const float y1p = -sinRot * dx + cosRot * dy;
+
+    const float lambda = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry);
+    if (lambda > 1.0f) {
+        rx *= std::sqrt(lambda);
+        ry *= std::sqrt(lambda);
+    }
+
+    const float sign = (largeArc != sweep) ? -1.0f : 1.0f;
+    const float sq = std::max(0.0f, (rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p) /
+                                    (rx * rx * y1p * y1p + ry * ry * x1p * x1p));
+    const float coef = sign * std::sqrt(sq);
+    const float cxp = coef * rx * y1p / ry;
+    const float cyp = -coef * ry * x1p / rx;
+    const float cx = cosRot * cxp - sinRot * cyp + (from.x + end.x) / 2.0f;
+    const float cy = sinRot * cxp + cosRot * cyp + (from.y + end.y) / 2.0f;
+
+    auto vectorAngle = [](float ux, float uy, float vx, float vy) {
+        return std::atan2(ux * vy - uy * vx, ux * vx + uy * vy);
+    };
+    const float theta1 = vectorAngle(1.0f, 0.0f, (x1p - cxp) / rx, (y1p - cyp) / ry);
+    float dtheta = vectorAngle((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry);
+    if (!sweep && dtheta < 0) {
+        dtheta += 2.0f * kPi;
+    } else if (sweep && dtheta > 0) {
+        dtheta -= 2.0f * kPi;
+    }
+
+    const int steps = std::max(4, static_cast<int>(std::abs(dtheta) * 10.0f));
+    for (int i = 0; i <= steps; ++i) {
+        const float angle = theta1 + dtheta * static_cast<float>(i) / static_cast<float>(steps);
+        const float x = rx * std::cos(angle);
+        const float y = ry * std::sin(angle);
+        AppendPoint(subPath, ui::Point(cosRot * x - sinRot * y + cx, sinRot * x + cosRot * y + cy), segmentIndex);
+    }
+}
+
+std::vector<FlattenedSubPath> FlattenPath(const PathPayload& payload) {
+    std::vector<FlattenedSubPath> subPaths;
+    ui::Point current(0, 0);
+    ui::Point start(0, 0);
+
+    auto currentSubPath = [&](std::size_t segmentIndex) -> FlattenedSubPath& {
+        if (subPaths.empty() || subPaths.back().closed) {
+            // 没有 MoveTo 或闭合后继续绘制时，从当前点开始新的子路径
+            subPaths.emplace_back();
+            AppendPoint(subPaths.back(), current, segmentIndex);
+            start = current;
+        }
+        return subPaths.back();
+    };
+
+    for (std::size_t index = 0; index < payload.segments.size(); ++index) {
+        const auto& segment = payload.segments[index];
+        switch (segment.type) {
+            case PathSegmentType::MoveTo:
+                if (!segment.points.empty()) {
+                    current = segment.points[0];
+                    start = current;
+                    subPaths.emplace_back();
+                    AppendPoint(subPaths.back(), current, index);
+                }
+                break;
+
+            case PathSegmentType::LineTo:
+                if (!segment.points.empty()) {
+                    auto& subPath = currentSubPath(index);
+                    current = segment.points[0];
+                    AppendPoint(subPath, current, index);
+                }
+                break;
+
+            case PathSegmentType::QuadraticBezierTo:
+                if (segment.points.size() >= 2) {
+                    auto& subPath = currentSubPath(index);
+                    const ui::Point p0 = current;
+                    const ui::Point& c = segment.points[0];
+                    const ui::Point& p1 = segment.points[1];
+                    for (int i = 1; i <= kBezierSteps; ++i) {
+                        const float t = static_cast<float>(i) / kBezierSteps;
+                        const float u = 1.0f - t;
+                        AppendPoint(subPath, ui::Point(u * u * p0.x + 2 * u * t * c.x + t * t * p1.x,
+                                                       u * u * p0.y + 2 * u * t * c.y + t * t * p1.y), index);
+                    }
+                    current = p1;
+                }
+                break;
+
+            case PathSegmentType::CubicBezierTo:
+                if (segment.points.size() >= 3) {
+                    auto& subPath = currentSubPath(index);
+                    const ui::Point p0 = current;
+                    const ui::Point& c1 = segment.points[0];
+                    const ui::Point& c2 = segment.points[1];
+                    const ui::Point& p1 = segment.points[2];
+                    for (int i = 1; i <= kBezierSteps; ++i) {
+                        const float t = static_cast<float>(i) / kBezierSteps;
+                        const float u = 1.0f - t;
+                        const float a = u * u * u;
+                        const float b = 3 * u * u * t;
+                        const float c = 3 * u * t * t;
+                        const float d = t * t * t;
+                        AppendPoint(subPath, ui::Point(a * p0.x + b * c1.x + c * c2.x + d * p1.x,
+                                                       a * p0.y + b * c1.y + c * c2.y + d * p1.y), index);
+                    }
+                    current = p1;
+                }
+                break;
+
+            case PathSegmentType::ArcTo:
+                if (segment.points.size() >= 4) {
+                    auto& subPath = currentSubPath(index);
+                    FlattenArc(subPath, current, segment, index);
+                    current = segment.points[3];
+                }
+                break;
+
+            case PathSegmentType::Close:
+                if (!subPaths.empty() && !subPaths.back().closed) {
+                    auto& subPath = subPaths.back();
+                    // 闭合边使用 Close 段的颜色
+                    if (!subPath.segmentIndices.empty()) {
+                        subPath.segmentIndices.back() = std::max(subPath.segmentIndices.back(), index);
+                    }
+                    subPath.closed = true;
+                }
+                current = start;
+                break;
+        }
+    }
+
+    // 首尾重合的子路径视为闭合
+    for (auto& subPath : subPaths) {
+        if (subPath.points.size() >= 3) {
+            const auto& first = subPath.points.front();
+            const auto& last = subPath.points.back();
+            if (std::abs(first.x - last.x) < 0.1f && std::abs(first.y - last.y) < 0.1f) {
+                subPath.points.pop_back();
+                subPath.segmentIndices.pop_back();
+                subPath.closed = true;
+            }
+        }
+    }
+    return subPaths;
+}
+
+// 跨平台字体路径（与 GlRenderer / TextBlock 的查找顺序一致，后面的字体作为回退）
+
+} // namespace
+
+// ========== 字形缓存 ==========
+
+struct SoftwareRenderer::FontCache : GlyphMetricsProvider {
+    struct Glyph {
+        int width{0};
+        int height{0};
+        int bearingX{0};
+        int bearingY{0};
+        int advance{0};
+        bool isColor{false};              // BGRA 彩色位图（emoji）
+        std::vector<std::uint8_t> pixels; // 灰度为每像素 1 字节，彩色为 BGRA 4 字节
+    };
+
+    // 距离场字体：同一字体的所有字号共享参考字号的 FT_Face 与字形集
+    struct SdfFace {
+        FT_Face face{nullptr};
+        std::shared_ptr<SdfGlyphSet> glyphSet;
+    };
+
+    // 按 (FontManager 字体, 字号) 打开的字体，字体 ID 为在 fonts 中的索引
+    struct Font {
+        FT_Face face{nullptr};        // 位图字体（距离场字体为 nullptr）
+        FontFaceId managerFace{-1};
+        unsigned int size{0};
+        SdfFace* sdf{nullptr};
+    };
+
+    GlyphRenderMode mode{GlyphRenderMode::Bitmap};
+    FT_Library library{nullptr};
+    bool initialized{false};
+    std::vector<Font> fonts;
+    std::unordered_map<std::uint64_t, int> fontIds;                   // (字体 << 32) | 字号 -> 字体 ID（-1 表示加载失败）
+    std::unordered_map<std::uint64_t, std::unique_ptr<Glyph>> glyphs; // (字体 ID, 码点) -> 字形（nullptr 表示缺失）
+    std::unordered_map<FontFaceId, std::unique_ptr<SdfFace>> sdfFaces; // nullptr 表示字体不支持距离场
+    std::size_t rasterized{0};                                        // 栅格化的位图字形数
+
+    ~FontCache() {
+        for (auto& font : fonts) {
+            if (font.face) {
+                FT_Done_Face(font.face);
+            }
+        }
+        for (auto& [id, sdf] : sdfFaces) {
+            if (sdf) {
+                FT_Done_Face(sdf->face);
+            }
+        }
+        if (library) {
+            FT_Done_FreeType(library);
+        }
+    }
+
+    bool EnsureLibrary() {
+        if (!initialized) {
+            initialized = true;
+            if (FT_Init_FreeType(&library) != 0) {
+                std::cerr << "SoftwareRenderer: failed to initialize FreeType" << std::endl;
+                library = nullptr;
+            }
+        }
+        return library != nullptr;
+    }
+
+    SdfFace* AcquireSdfFace(FontFaceId managerFace, const FontFaceInfo& info) {
+        auto it = sdfFaces.find(managerFace);
+        if (it != sdfFaces.end()) {
+            return it->second.get();
+        }
+        std::unique_ptr<SdfFace> sdf;
+        FT_Face face = nullptr;
+        if (EnsureLibrary() && FT_New_Face(library, info.path.c_str(), info.faceIndex, &face) == 0) {
+            if (SdfGlyphSet::Supports(face)) {
+                auto glyphSet = SdfGlyphSet::FindRegistered(SdfGlyphSet::KeyOf(face));
+                if (!glyphSet) {
+                    glyphSet = std::make_shared<SdfGlyphSet>(face->family_name ? face->family_name : "",
+                                                             face->style_name ? face->style_name : "");
+                    SdfGlyphSet::Register(glyphSet);
+                }
+                FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(glyphSet->GetReferenceSize()));
+                sdf = std::make_unique<SdfFace>(SdfFace{face, std::move(glyphSet)});
+            } else {
+                FT_Done_Face(face);
+            }
+        }
+        SdfFace* result = sdf.get();
+        sdfFaces.emplace(managerFace, std::move(sdf));
+        return result;
+    }
+
+    bool IsSdf(int fontId) const {
+        return fontId >= 0 && fontId < static_cast<int>(fonts.size()) && fonts[fontId].sdf;
+    }
+
+    static float SdfScale(const Font& font) {
+        return static_cast<float>(font.size) / static_cast<float>(font.sdf->glyphSet->GetReferenceSize());
+    }
+
+    const SdfGlyph* GetSdfGlyph(char32_t codepoint, const Font& font) {
+        return font.sdf->glyphSet->Generate(font.sdf->face, codepoint);
+    }
+
+    int OpenFont(FontFaceId managerFace, unsigned int size) {
+        const FontFaceInfo* info = FontManager::Instance().GetFace(managerFace);
+        if (!info) {
+            return -1;
+        }
+        const std::uint64_t key = (static_cast<std::uint64_t>(managerFace) << 32) | size;
+        auto it = fontIds.find(key);
+        if (it != fontIds.end()) {
+            return it->second;
+        }
+
+        // 距离场模式下不为每个字号打开字体（彩色字体仍按位图处理）
+        int fontId = -1;
+        SdfFace* sdf = mode == GlyphRenderMode::SignedDistanceField ? AcquireSdfFace(managerFace, *info) : nullptr;
+        FT_Face face = nullptr;
+        if (sdf) {
+            fontId = static_cast<int>(fonts.size());
+            fonts.push_back(Font{nullptr, managerFace, size, sdf});
+        } else if (EnsureLibrary() && FT_New_Face(library, info->path.c_str(), info->faceIndex, &face) == 0) {
+            if (FT_Set_Pixel_Sizes(face, 0, size) == 0) {
+                fontId = static_cast<int>(fonts.size());
+                fonts.push_back(Font{face, managerFace, size, nullptr});
+            } else {
+                FT_Done_Face(face);
+            }
+        }
+        fontIds.emplace(key, fontId);
+        return fontId;
+    }
+
+    // 位图字形（距离场字体返回 nullptr，使用 GetSdfGlyph）
+    const Glyph* GetGlyph(char32_t codepoint, int fontId) {
+        if (fontId < 0 || fontId >= static_cast<int>(fonts.size()) || fonts[fontId].sdf) {
+            return nullptr;
+        }
+        const std::uint64_t key = (static_cast<std::uint64_t>(fontId) << 32) | codepoint;
+        auto it = glyphs.find(key);
+        if (it != glyphs.end()) {
+            return it->second.get();
+        }
+
+        std::unique_ptr<Glyph> glyph;
+        const FT_Face face = fonts[fontId].face;
+        // HarfBuzz 整形输出的字形索引直接使用
+        const FT_UInt index = IsGlyphIndex(codepoint) ? GlyphIndexOf(codepoint) : FT_Get_Char_Index(face, codepoint);
+        if (index != 0 &&
+            (FT_Load_Glyph(face, index, FT_LOAD_RENDER | FT_LOAD_COLOR) == 0 ||
+             FT_Load_Glyph(face, index, FT_LOAD_RENDER) == 0)) {
+
+            const FT_GlyphSlot slot = face->glyph;
+            const FT_Bitmap& bitmap = slot->bitmap;
+            glyph = std::make_unique<Glyph>();
+            glyph->advance = static_cast<int>(slot->advance.x >> 6);
+            glyph->bearingX = slot->bitmap_left;
+            glyph->bearingY = slot->bitmap_top;
+            glyph->width = static_cast<int>(bitmap.width);
+            glyph->height = static_cast<int>(bitmap.rows);
+            glyph->isColor = bitmap.pixel_mode == FT_PIXEL_MODE_BGRA;
+
+            // 按 pitch 重新排列为紧密缓冲区
+            const std::size_t rowBytes = static_cast<std::size_t>(bitmap.width) * (glyph->isColor ? 4 : 1);
+            if (bitmap.buffer && rowBytes > 0) {
+                glyph->pixels.resize(rowBytes * bitmap.rows);
+                for (unsigned int row = 0; row < bitmap.rows; ++row) {
+                    const unsigned char* src = bitmap.pitch >= 0
+                        ? bitmap.buffer + row * bitmap.pitch
+                        : bitmap.buffer + (bitmap.rows - 1 - row) * (-bitmap.pitch);
+                    std::memcpy(glyph->pixels.data() + row * rowBytes, src, rowBytes);
+                }
+            }
+            ++rasterized;
+        }
+
+        const Glyph* result = glyph.get();
+        glyphs.emplace(key, std::move(glyph));
+        return result;
+    }
+
+    // 字体包含该字符时输出前进值（距离场字体按字号缩放）
+    bool GlyphAdvance(char32_t c, int fontId, float& advance) {
+        if (fontId < 0 || fontId >= static_cast<int>(fonts.size())) {
+            return false;
+        }
+        const Font& font = fonts[fontId];
+        if (font.sdf) {
+            const SdfGlyph* glyph = GetSdfGlyph(c, font);
+            if (!glyph) {
+                return false;
+            }
+            advance = glyph->advance * SdfScale(font);
+            return true;
+        }
+        const Glyph* glyph = GetGlyph(c, fontId);
+        if (!glyph) {
+            return false;
+        }
+        advance = static_cast<float>(glyph->advance);
+        return true;
+    }
+
+    // 主字体不含该字符时按 FontManager 的码位块回退链查找，返回字形所在字体（-1 表示缺失）
+    int FindFont(char32_t c, int fontId, float& advance) {
+        if (fontId < 0 || fontId >= static_cast<int>(fonts.size())) {
+            return -1;
+        }
+        // 缺失的字形也会缓存，命中主字体时只需一次哈希查找
+        if (GlyphAdvance(c, fontId, advance)) {
+            return fontId;
+        }
+        // 字形索引只在整形所用的字体中有意义，不回退
+        if (IsGlyphIndex(c)) {
+            return -1;
+        }
+        const FontFaceId mainFace = fonts[fontId].managerFace;
+        const unsigned int size = fonts[fontId].size;
+        const FontFaceId fallbackFace = FontManager::Instance().FindFaceForCodepoint(c, mainFace);
+        if (fallbackFace < 0 || fallbackFace == mainFace) {
+            return -1;
+        }
+        const int fallbackId = OpenFont(fallbackFace, size);
+        return GlyphAdvance(c, fallbackId, advance) ? fallbackId : -1;
+    }
+
+    int ResolveFont(const std::string& fontFamily, float fontSize, int fontWeight, bool italic) override {
+        const FontFaceId face = FontManager::Instance().Resolve(fontFamily, fontWeight, italic);
+        return OpenFont(face, std::max(1u, static_cast<unsigned int>(fontSize)));
+    }
+
+    bool GetGlyphAdvance(char32_t c, int fontId, int& glyphFontId, float& advance) override {
+        const int found = FindFont(c, fontId, advance);
+        if (found < 0) {
+            return false;
+        }
+        glyphFontId = found;
+        return true;
+    }
+
+    float GetKerning(int fontId, char32_t left, char32_t right) override {
+        if (fontId < 0 || fontId >= static_cast<int>(fonts.size())) {
+            return 0.0f;
+        }
+        const Font& font = fonts[fontId];
+        FT_Face face = font.sdf ? font.sdf->face : font.face;
+        if (!face || !FT_HAS_KERNING(face)) {
+            return 0.0f;
+        }
+        // 与 TextRenderer 相同：未缩放的字体单位按字号换算
+        FT_Vector kerning{};
+        if (FT_Get_Kerning(face, FT_Get_Char_Index(face, left), FT_Get_Char_Index(face, right),
+                           FT_KERNING_UNSCALED, &kerning) != 0) {
+            return 0.0f;
+        }
+        return static_cast<float>(kerning.x) * static_cast<float>(font.size) / face->units_per_EM;
+    }
+
+    bool GetFontSource(int fontId, std::string& path, int& faceIndex, float& fontSize) const override {
+        if (fontId < 0 || fontId >= static_cast<int>(fonts.size()) || fonts[fontId].sdf) {
+            return false;
+        }
+        const FontFaceInfo* info = FontManager::Instance().GetFace(fonts[fontId].managerFace);
+        if (!info) {
+            return false;
+        }
+        path = info->path;
+        faceIndex = info->faceIndex;
+        fontSize = static_cast<float>(fonts[fontId].size);
+        return true;
+    }
+};
+
+// ========== SoftwareRenderer ==========
+
+SoftwareRenderer::PixelRect SoftwareRenderer::PixelRect::Intersect(const PixelRect& other) const {
+    return PixelRect{std::max(x0, other.x0), std::max(y0, other.y0),
+                     std::min(x1, other.x1), std::min(y1, other.y1)};
+}
+
+SoftwareRenderer::SoftwareRenderer() = default;
+
+SoftwareRenderer::~SoftwareRenderer() = default;
+
+GlyphMetricsProvider* SoftwareRenderer::GetGlyphMetrics() const {
+    return fonts_.get();
+}
+
+void SoftwareRenderer::Initialize(const RendererInitParams& params) {
+    if (initialized_) {
+        throw std::runtime_error("SoftwareRenderer already initialized");
+    }
+    fonts_ = std::make_unique<FontCache>();
+    fonts_->mode = params.glyphRenderMode;
+    initialized_ = true;
+    Resize(params.initialSize);
+}
+
+void SoftwareRenderer::Resize(const Extent2D& size) {
+    size_ = size;
+    pixels_.assign(static_cast<std::size_t>(size.width) * size.height * 4, 0);
+    contentValid_ = false;
+}
+
+void SoftwareRenderer::BeginFrame(const FrameContext& ctx) {
+    currentFrame_ = ctx;
+
+    // 帧缓冲刚创建或尺寸变化后没有可保留的内容，必须整帧重绘
+    fullRedraw_ = ctx.fullRedraw || !contentValid_;
+    if (fullRedraw_) {
+        ClearRect(SurfaceRect());
+    }
+    ResetState(SurfaceRect());
+}
+
+void SoftwareRenderer::Draw(const RenderList& list) {
+    if (!initialized_) {
+        return;
+    }
+
+    if (fullRedraw_) {
+        ExecuteCommands(list, nullptr);
+        ResetState(SurfaceRect());
+        return;
+    }
+
+    // 脏矩形重绘：每个损坏区域单独裁剪、清除并重放相交的命令
+    for (const auto& damage : currentFrame_.damageRects) {
+        const PixelRect area = ToPixelRect(damage).Intersect(SurfaceRect());
+        if (area.IsEmpty()) {
+            continue;
+        }
+        ResetState(area);
+        ClearRect(area);
+        ExecuteCommands(list, &damage);
+    }
+    ResetState(SurfaceRect());
+}
+
+void SoftwareRenderer::EndFrame() {
+    contentValid_ = true;
+    ++frameCount_;
+}
+
+void SoftwareRenderer::Shutdown() {
+    fonts_.reset();
+    pixels_.clear();
+    size_ = {};
+    contentValid_ = false;
+    initialized_ = false;
+}
+
+std::array<std::uint8_t, 4> SoftwareRenderer::GetPixel(std::uint32_t x, std::uint32_t y) const {
+    if (x >= size_.width || y >= size_.height) {
+        return {0, 0, 0, 0};
+    }
+    const std::size_t offset = (static_cast<std::size_t>(y) * size_.width + x) * 4;
+    return {pixels_[offset], pixels_[offset + 1], pixels_[offset + 2], pixels_[offset + 3]};
+}
+
+std::size_t SoftwareRenderer::GetRasterizedGlyphCount() const {
+    return fonts_ ? fonts_->rasterized : 0;
+}
+
+std::size_t SoftwareRenderer::CompareImages(const std::uint8_t* lhs, const std::uint8_t* rhs,
+                                            std::size_t pixelCount, int tolerance) {
+    std::size_t differing = 0;
+    for (std::size_t i = 0; i < pixelCount; ++i) {
+        for (std::size_t c = 0; c < 4; ++c) {
+            if (std::abs(static_cast<int>(lhs[i * 4 + c]) - static_cast<int>(rhs[i * 4 + c])) > tolerance) {
+                ++differing;
+                break;
+            }
+        }
+    }
+    return differing;
+}
+
+bool SoftwareRenderer::SavePng(const std::string& path) const {
+    if (size_.width == 0 || size_.height == 0) {
+        return false;
+    }
+
+    static const auto crcTable = [] {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t n = 0; n < 256; ++n) {
+            std::uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        return table;
+    }();
+
+    auto appendU32 = [](std::vector<std::uint8_t>& out, std::uint32_t value) {
+        out.push_back(static_cast<std::uint8_t>(value >> 24));
+        out.push_back(static_cast<std::uint8_t>(value >> 16));
+        out.push_back(static_cast<std::uint8_t>(value >> 8));
+        out.push_back(static_cast<std::uint8_t>(value));
+    };
+
+    std::vector<std::uint8_t> file = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    auto appendChunk = [&](const char* type, const std::vector<std::uint8_t>& data) {
+        appendU32(file, static_cast<std::uint32_t>(data.size()));
+        const std::size_t crcStart = file.size();
+        file.insert(file.end(), type, type + 4);
+        file.insert(file.end(), data.begin(), data.end());
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = crcStart; i < file.size(); ++i) {
+            crc = crcTable[(crc ^ file[i]) & 0xFF] ^ (crc >> 8);
+        }
+        appendU32(file, crc ^ 0xFFFFFFFFu);
+    };
+
+    // IHDR：8 位 RGBA，无隔行
+    std::vector<std::uint8_t> header;
+    appendU32(header, size_.width);
+    appendU32(header, size_.height);
+    header.insert(header.end(), {8, 6, 0, 0, 0});
+    appendChunk("IHDR", header);
+
+    // 每行前加过滤类型 0，再以不压缩的 deflate 块封装为 zlib 流
+    const std::size_t rowBytes = static_cast<std::size_t>(size_.width) * 4;
+    std::vector<std::uint8_t> raw;
+    raw.reserve((rowBytes + 1) * size_.height);
+    for (std::uint32_t y = 0; y < size_.height; ++y) {
+        raw.push_back(0);
+        const auto* row = pixels_.data() + y * rowBytes;
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    std::vector<std::uint8_t> zlib = {0x78, 0x01};
+    std::uint32_t adlerA = 1;
+    std::uint32_t adlerB = 0;
+    for (std::size_t offset = 0; offset < raw.size() || offset == 0;) {
+        const std::size_t blockSize = std::min<std::size_t>(65535, raw.size() - offset);
+        const bool last = offset + blockSize >= raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<std::uint8_t>(blockSize & 0xFF));
+        zlib.push_back(static_cast<std::uint8_t>(blockSize >> 8));
+        zlib.push_back(static_cast<std::uint8_t>(~blockSize & 0xFF));
+        zlib.push_back(static_cast<std::uint8_t>((~blockSize >> 8) & 0xFF));
+        for (std::size_t i = 0; i < blockSize; ++i) {
+            const std::uint8_t byte = raw[offset + i];
+            zlib.push_back(byte);
+            adlerA = (adlerA + byte) % 65521u;
+            adlerB = (adlerB + adlerA) % 65521u;
+        }
+        offset += blockSize;
+        if (last) {
+            break;
+        }
+    }
+    appendU32(zlib, (adlerB << 16) | adlerA);
+    appendChunk("IDAT", zlib);
+    appendChunk("IEND", {});
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    return static_cast<bool>(out);
+}
+
+// ========== 命令执行 ==========
+
+void SoftwareRenderer::ExecuteCommands(const RenderList& list, const ui::Rect* damage) {
+    for (const auto& cmd : list.GetCommands()) {
+        // 状态命令（裁剪、变换、图层）总是执行
+        ui::Rect bounds;
+        if (damage && GetCommandBounds(cmd, bounds) && !bounds.Intersects(*damage)) {
+            continue;
+        }
+        ExecuteCommand(cmd);
+    }
+}
+
+void SoftwareRenderer::ExecuteCommand(const RenderCommand& cmd) {
+    switch (cmd.type) {
+        case CommandType::SetClip:
+            if (const auto* payload = std::get_if<ClipPayload>(&cmd.payload)) {
+                ApplyClip(*payload);
+            }
+            break;
+
+        case CommandType::SetTransform:
+            // 命令坐标已经是全局坐标
+            break;
+
+        case CommandType::DrawRectangle:
+            if (const auto* payload = std::get_if<RectanglePayload>(&cmd.payload)) {
+                DrawRectangle(*payload);
+            }
+            break;
+
+        case CommandType::DrawText:
+            if (const auto* payload = std::get_if<TextPayload>(&cmd.payload)) {
+                DrawText(*payload);
+            }
+            break;
+
+        case CommandType::DrawImage:
+            // 图像纹理只存在于 GPU，软件渲染器不绘制图像
+            break;
+
+        case CommandType::DrawPolygon:
+            if (const auto* payload = std::get_if<PolygonPayload>(&cmd.payload)) {
+                DrawPolygon(*payload);
+            }
+            break;
+
+        case CommandType::DrawPath:
+            if (const auto* payload = std::get_if<PathPayload>(&cmd.payload)) {
+                DrawPath(*payload);
+            }
+            break;
+
+        case CommandType::PushLayer:
+            if (const auto* payload = std::get_if<LayerPayload>(&cmd.payload)) {
+                PushLayer(*payload);
+            }
+            break;
+
+        case CommandType::PopLayer:
+            PopLayer();
+            break;
+    }
+}
+
+void SoftwareRenderer::ResetState(const PixelRect& base) {
+    // 命令列表中未配对的离屏图层：换回帧缓冲，丢弃图层内容
+    while (!layerStack_.empty()) {
+        if (layerStack_.back().offscreen) {
+            pixels_.swap(layerBuffers_[layerStack_.back().buffer]);
+        }
+        layerStack_.pop_back();
+    }
+    offscreenDepth_ = 0;
+    baseClip_ = base;
+    clip_ = base;
+    layerStack_.push_back(LayerState{});
+}
+
+void SoftwareRenderer::ApplyClip(const ClipPayload& payload) {
+    // clipRect 已经是全局坐标；重绘损坏区域时还要与损坏区域求交
+    clip_ = payload.enabled ? ToPixelRect(payload.clipRect).Intersect(baseClip_) : baseClip_;
+}
+
+void SoftwareRenderer::PushLayer(const LayerPayload& payload) {
+    LayerState state;
+    state.opacity = CurrentOpacity();
+    state.parentClip = clip_;
+    state.parentBaseClip = baseClip_;
+
+    // 不透明（或完全透明）的图层与直接绘制等价，不需要离屏缓冲
+    const float opacity = std::clamp(payload.opacity, 0.0f, 1.0f);
+    const PixelRect rect = ToPixelRect(payload.bounds).Intersect(clip_);
+    if (opacity >= 1.0f || opacity <= 0.0f || rect.IsEmpty()) {
+        state.opacity *= opacity;
+        layerStack_.push_back(state);
+        return;
+    }
+
+    state.offscreen = true;
+    state.compositeOpacity = opacity * state.opacity;
+    state.rect = rect;
+    state.buffer = offscreenDepth_++;
+    if (layerBuffers_.size() <= state.buffer) {
+        layerBuffers_.resize(state.buffer + 1);
+    }
+    auto& buffer = layerBuffers_[state.buffer];
+    buffer.resize(pixels_.size());
+    pixels_.swap(buffer);
+
+    // 图层从全透明开始，内容只会落在图层区域内
+    const std::size_t rowBytes = static_cast<std::size_t>(rect.x1 - rect.x0) * 4;
+    for (int y = rect.y0; y < rect.y1; ++y) {
+        std::memset(pixels_.data() + (static_cast<std::size_t>(y) * size_.width + rect.x0) * 4, 0, rowBytes);
+    }
+
+    state.opacity = 1.0f;
+    baseClip_ = rect;
+    clip_ = rect;
+    layerStack_.push_back(state);
+}
+
+void SoftwareRenderer::PopLayer() {
+    if (layerStack_.size() <= 1) {
+        return;
+    }
+    const LayerState state = layerStack_.back();
+    layerStack_.pop_back();
+    if (!state.offscreen) {
+        return;
+    }
+
+    auto& layer = layerBuffers_[state.buffer];
+    pixels_.swap(layer);
+    --offscreenDepth_;
+    baseClip_ = state.parentBaseClip;
+    clip_ = state.parentClip;
+    CompositeLayer(layer, state.rect, state.compositeOpacity);
+}
+
+void SoftwareRenderer::CompositeLayer(const std::vector<std::uint8_t>& layer, const PixelRect& rect, float opacity) {
+    const PixelRect area = rect.Intersect(clip_);
+    for (int y = area.y0; y < area.y1; ++y) {
+        const std::size_t offset = (static_cast<std::size_t>(y) * size_.width + area.x0) * 4;
+        const std::uint8_t* src = layer.data() + offset;
+        std::uint8_t* dst = pixels_.data() + offset;
+        for (int x = area.x0; x < area.x1; ++x, src += 4, dst += 4) {
+            if (src[3] == 0) {
+                continue;
+            }
+            // 图层是预乘 alpha：ONE / ONE_MINUS_SRC_ALPHA
+            const float alpha = src[3] / 255.0f * opacity;
+            const float inverse = 1.0f - alpha;
+            dst[0] = ToByte(src[0] / 255.0f * opacity + dst[0] / 255.0f * inverse);
+            dst[1] = ToByte(src[1] / 255.0f * opacity + dst[1] / 255.0f * inverse);
+            dst[2] = ToByte(src[2] / 255.0f * opacity + dst[2] / 255.0f * inverse);
+            dst[3] = ToByte(alpha + dst[3] / 255.0f * inverse);
+        }
+    }
+}
+
+// ========== 矩形 ==========
+
+void SoftwareRenderer::DrawRectangle(const RectanglePayload& payload) {
+    const float width = payload.rect.width;
+    const float height = payload.rect.height;
+    if (width <= 0.0f || height <= 0.0f || clip_.IsEmpty()) {
+        return;
+    }
+
+    const float opacity = CurrentOpacity();
+    const bool ellipseCorners = payload.radiusX > 0.0001f || payload.radiusY > 0.0001f;
+    const float halfW = width * 0.5f;
+    const float halfH = height * 0.5f;
+    const float centerX = payload.rect.x + halfW;
+    const float centerY = payload.rect.y + halfH;
+    const auto& fill = payload.fillColor;
+    const auto& stroke = payload.strokeColor;
+
+    // 圆形圆角：相邻圆角之和超过边长时按比例缩小（与 GlRenderer::AppendRectangleInstance 一致）
+    std::array<float, 4> radius{
+        std::max(0.0f, payload.cornerRadiusTopLeft),
+        std::max(0.0f, payload.cornerRadiusTopRight),
+        std::max(0.0f, payload.cornerRadiusBottomRight),
+        std::max(0.0f, payload.cornerRadiusBottomLeft)
+    };
+    const float halfMin = std::max(0.0f, std::min(width, height) * 0.5f);
+    float scale = 1.0f;
+    for (float sum : {radius[0] + radius[1], radius[3] + radius[2]}) {
+        if (sum > width && sum > 0.0f) {
+            scale = std::min(scale, width / sum);
+        }
+    }
+    for (float sum : {radius[3] + radius[0], radius[1] + radius[2]}) {
+        if (sum > height && sum > 0.0f) {
+            scale = std::min(scale, height / sum);
+        }
+    }
+    for (auto& r : radius) {
+        r = std::clamp(r * scale, 0.0f, halfMin);
+    }
+
+    float insetFactor = 0.5f;
+    float outsetFactor = 0.5f;
+    if (payload.strokeAlignment == StrokeAlignment::Inside) {
+        insetFactor = 1.0f;
+        outsetFactor = 0.0f;
+    } else if (payload.strokeAlignment == StrokeAlignment::Outside) {
+        insetFactor = 0.0f;
+        outsetFactor = 1.0f;
+    }
+    const float strokeInset = std::min(payload.strokeThickness * insetFactor, halfMin);
+    const float strokeOutset = std::max(payload.strokeThickness * outsetFactor, 0.0f);
+    const bool hasStroke = !ellipseCorners && (strokeInset + strokeOutset) > 0.0001f;
+    const float aa = std::max(std::clamp(payload.aaWidth, 0.1f, 2.0f), 0.0001f);
+
+    // 椭圆圆角（Rectangle 着色器）：描边仅向内
+    const float ellipseHalfAA = std::max(std::max(0.5f * payload.aaWidth, 0.5f), 0.25f);
+    const float ellipseStroke = std::max(payload.strokeThickness, 0.0f);
+    const float ellipseInnerHalfAA = std::max(std::min(ellipseHalfAA, std::max(0.5f * ellipseStroke, 0.5f * ellipseHalfAA)), 0.0f);
+
+    // 像素着色：返回颜色和 alpha（未乘图层不透明度）
+    auto shade = [&](float px, float py, float& r, float& g, float& b, float& a) {
+        const float lx = px - centerX;
+        const float ly = py - centerY;
+        if (ellipseCorners) {
+            const float dist = EllipseCornerBoxSdf(lx, ly, halfW, halfH, payload.radiusX, payload.radiusY);
+            const float outerMask = 1.0f - SmoothStep(-ellipseHalfAA, ellipseHalfAA, dist);
+            const float innerMask = 1.0f - SmoothStep(-ellipseStroke - ellipseInnerHalfAA,
+                                                      -ellipseStroke + ellipseInnerHalfAA, dist);
+            const float strokeMask = Clamp01(outerMask - innerMask);
+            const float fillMask = Clamp01(innerMask);
+            a = stroke[3] * strokeMask + fill[3] * fillMask;
+            if (a > 0.0f) {
+                r = (stroke[0] * stroke[3] * strokeMask + fill[0] * fill[3] * fillMask) / a;
+                g = (stroke[1] * stroke[3] * strokeMask + fill[1] * fill[3] * fillMask) / a;
+                b = (stroke[2] * stroke[3] * strokeMask + fill[2] * fill[3] * fillMask) / a;
+            }
+            return;
+        }
+
+        const float dist = RoundedBoxSdf(lx, ly, halfW, halfH, radius);
+        if (!hasStroke) {
+            r = fill[0];
+            g = fill[1];
+            b = fill[2];
+            a = fill[3] * SmoothStep(aa, -aa, dist);
+            return;
+        }
+        const float fillAlpha = SmoothStep(aa, -aa, dist + strokeInset);
+        const float strokeAlpha = SmoothStep(aa, -aa, dist - strokeOutset) - fillAlpha;
+        r = stroke[0] + (fill[0] - stroke[0]) * fillAlpha;
+        g = stroke[1] + (fill[1] - stroke[1]) * fillAlpha;
+        b = stroke[2] + (fill[2] - stroke[2]) * fillAlpha;
+        a = std::max(fill[3] * fillAlpha, stroke[3] * strokeAlpha);
+    };
+
+    // 包围盒（含外描边和抗锯齿余量）
+    const float extent = strokeOutset + aa + 1.0f;
+    const PixelRect area = ToPixelRect(ui::Rect(payload.rect.x - extent, payload.rect.y - extent,
+                                                width + extent * 2.0f, height + extent * 2.0f)).Intersect(clip_);
+    if (area.IsEmpty()) {
+        return;
+    }
+
+    // 内部实心区域：离所有边和圆角足够远的像素直接使用填充色
+    const float maxRadius = ellipseCorners
+        ? std::max(payload.radiusX, payload.radiusY)
+        : *std::max_element(radius.begin(), radius.end());
+    const float margin = maxRadius + std::max(strokeInset, ellipseCorners ? ellipseStroke : 0.0f) + aa + ellipseHalfAA + 1.0f;
+    const float solidLeft = payload.rect.x + margin;
+    const float solidRight = payload.rect.x + width - margin;
+    const float solidTop = payload.rect.y + margin;
+    const float solidBottom = payload.rect.y + height - margin;
+
+    for (int y = area.y0; y < area.y1; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        const bool solidRow = py >= solidTop && py <= solidBottom;
+        for (int x = area.x0; x < area.x1; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            if (solidRow && px >= solidLeft && px <= solidRight) {
+                BlendPixel(x, y, fill[0], fill[1], fill[2], fill[3] * opacity);
+                continue;
+            }
+            float r = 0.0f;
+            float g = 0.0f;
+            float b = 0.0f;
+            float a = 0.0f;
+            shade(px, py, r, g, b, a);
+            BlendPixel(x, y, r, g, b, a * opacity);
+        }
+    }
+}
+
+// ========== 多边形与路径 ==========
+
+void SoftwareRenderer::FillContours(const std::vector<std::vector<ui::Point>>& contours,
+                                    const std::array<float, 4>& color) {
+    if (clip_.IsEmpty() || color[3] <= 0.0f) {
+        return;
+    }
+    ScanlineRasterizer rasterizer;
+    for (const auto& contour : contours) {
+        rasterizer.AddContour(contour);
+    }
+    const float alpha = color[3] * CurrentOpacity();
+    rasterizer.Rasterize(clip_.x0, clip_.y0, clip_.x1, clip_.y1,
+        [&](int y, int x0, int x1, const float* coverage) {
+            for (int x = x0; x < x1; ++x) {
+                const float cover = std::min(coverage[x - x0], 1.0f);
+                if (cover > 0.0f) {
+                    BlendPixel(x, y, color[0], color[1], color[2], alpha * cover);
+                }
+            }
+        });
+}
+
+void SoftwareRenderer::StrokePolyline(const std::vector<ui::Point>& points, bool closed, float thickness,
+                                      const std::array<float, 4>& color) {
+    if (points.size() < 2 || thickness <= 0.0f) {
+        return;
+    }
+    const float half = thickness * 0.5f;
+    std::vector<std::vector<ui::Point>> contours;
+
+    // 连接点与端点使用圆形（与 GlRenderer 的路径描边一致）
+    const int roundSegments = std::clamp(static_cast<int>(half * 4.0f), 8, 32);
+    auto addRound = [&](const ui::Point& center) {
+        std::vector<ui::Point> circle;
+        circle.reserve(static_cast<std::size_t>(roundSegments));
+        for (int i = 0; i < roundSegments; ++i) {
+            const float angle = 2.0f * kPi * static_cast<float>(i) / static_cast<float>(roundSegments);
+            circle.emplace_back(center.x + std::cos(angle) * half, center.y + std::sin(angle) * half);
+        }
+        EnsureOrientation(circle);
+        contours.push_back(std::move(circle));
+    };
+
+    const std::size_t segmentCount = closed ? points.size() : points.size() - 1;
+    for (std::size_t i = 0; i < segmentCount; ++i) {
+        const ui::Point& p1 = points[i];
+        const ui::Point& p2 = points[(i + 1) % points.size()];
+        const float dx = p2.x - p1.x;
+        const float dy = p2.y - p1.y;
+        const float length = std::hypot(dx, dy);
+        if (length < 0.001f) {
+            continue;
+        }
+        const float nx = -dy / length * half;
+        const float ny = dx / length * half;
+        std::vector<ui::Point> quad = {
+            ui::Point(p1.x + nx, p1.y + ny), ui::Point(p2.x + nx, p2.y + ny),
+            ui::Point(p2.x - nx, p2.y - ny), ui::Point(p1.x - nx, p1.y - ny)
+        };
+        EnsureOrientation(quad);
+        contours.push_back(std::move(quad));
+    }
+
+    if (half > 0.5f) {
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            addRound(points[i]);
+        }
+    }
+    FillContours(contours, color);
+}
+
+void SoftwareRenderer::DrawPolygon(const PolygonPayload& payload) {
+    if (payload.points.size() < 2) {
+        return;
+    }
+
+    // 两个点且不填充：按线宽绘制线段（无端点）
+    if (payload.points.size() == 2 && !payload.filled) {
+        const auto& p1 = payload.points[0];
+        const auto& p2 = payload.points[1];
+        const float length = std::hypot(p2.x - p1.x, p2.y - p1.y);
+        if (length < 0.001f) {
+            return;
+        }
+        const float half = payload.strokeThickness * 0.5f;
+        const float nx = -(p2.y - p1.y) / length * half;
+        const float ny = (p2.x - p1.x) / length * half;
+        FillContours({{ui::Point(p1.x + nx, p1.y + ny), ui::Point(p2.x + nx, p2.y + ny),
+                       ui::Point(p2.x - nx, p2.y - ny), ui::Point(p1.x - nx, p1.y - ny)}},
+                     payload.strokeColor);
+        return;
+    }
+
+    if (payload.filled && payload.fillColor[3] > 0.0f) {
+        FillContours({payload.points}, payload.fillColor);
+    }
+    if (payload.strokeThickness > 0.0f && payload.strokeColor[3] > 0.0f) {
+        StrokePolyline(payload.points, true, payload.strokeThickness, payload.strokeColor);
+    }
+}
+
+void SoftwareRenderer::DrawPath(const PathPayload& payload) {
+    if (payload.segments.empty()) {
+        return;
+    }
+    const bool drawFill = payload.filled && payload.fillColor[3] > 0.0f;
+    const bool drawStroke = payload.strokeThickness > 0.0f && payload.strokeColor[3] > 0.0f;
+    if (!drawFill && !drawStroke) {
+        return;
+    }
+
+    const auto subPaths = FlattenPath(payload);
+
+    if (drawFill) {
+        std::vector<std::vector<ui::Point>> contours;
+        contours.reserve(subPaths.size());
+        for (const auto& subPath : subPaths) {
+            if (subPath.points.size() >= 3) {
+                contours.push_back(subPath.points);
+            }
+        }
+        FillContours(contours, payload.fillColor);
+    }
+
+    if (!drawStroke) {
+        return;
+    }
+
+    // 描边按分段颜色拆分为连续的折线，每条折线一次覆盖率填充（重叠处不重复混合）
+    for (const auto& subPath : subPaths) {
+        const auto& points = subPath.points;
+        if (points.size() < 2) {
+            continue;
+        }
+        auto colorOf = [&](std::size_t pointIndex) -> const std::array<float, 4>& {
+            const std::size_t segment = subPath.segmentIndices[pointIndex];
+            if (segment < payload.segments.size() && payload.segments[segment].hasStrokeColor) {
+                return payload.segments[segment].strokeColor;
+            }
+            return payload.strokeColor;
+        };
+
+        // 第 i 条边（points[i] -> points[i+1]）的颜色取终点所属路径段
+        const std::size_t edgeCount = subPath.closed ? points.size() : points.size() - 1;
+        bool uniform = true;
+        for (std::size_t i = 1; i < edgeCount && uniform; ++i) {
+            uniform = colorOf((i + 1) % points.size()) == colorOf(1 % points.size());
+        }
+        if (uniform) {
+            StrokePolyline(points, subPath.closed, payload.strokeThickness, colorOf(1 % points.size()));
+            continue;
+        }
+
+        std::vector<ui::Point> run{points[0]};
+        const std::array<float, 4>* runColor = &colorOf(1 % points.size());
+        for (std::size_t i = 0; i < edgeCount; ++i) {
+            const std::size_t next = (i + 1) % points.size();
+            const auto& edgeColor = colorOf(next);
+            if (edgeColor != *runColor) {
+                StrokePolyline(run, false, payload.strokeThickness, *runColor);
+                run.assign(1, points[i]);
+                runColor = &edgeColor;
+            }
+            run.push_back(points[next]);
+        }
+        StrokePolyline(run, false, payload.strokeThickness, *runColor);
+    }
+}
+
+// ========== 文本 ==========
+
+void SoftwareRenderer::DrawText(const TextPayload& payload) {
+    const TextLayout* layout = payload.layout.get();
+    if (!layout || clip_.IsEmpty() || !fonts_) {
+        return;
+    }
+    // 字形已解析到具体字体；其他度量来源（TextRenderer）的排版按字体族与字号重新查找
+    const bool ownLayout = layout->GetProviderId() == fonts_->GetProviderId();
+    const float fontSize = layout->GetFontSize();
+    const int fallbackFontId = ownLayout ? -1 : fonts_->ResolveFont(layout->GetFontFamily(), fontSize, 400, false);
+    if (!ownLayout && fallbackFontId < 0) {
+        return;
+    }
+
+    // 字形裁剪到 bounds 与当前裁剪的交集
+    const PixelRect area = ToPixelRect(payload.bounds).Intersect(clip_);
+    if (area.IsEmpty()) {
+        return;
+    }
+    const float boundsBottom = payload.bounds.y + payload.bounds.height;
+    const float opacity = CurrentOpacity() * payload.color[3];
+    const float lineHeight = layout->GetLineHeight();
+    const auto& glyphs = layout->GetGlyphs();
+
+    float lineY = payload.bounds.y;
+    for (const auto& line : layout->GetLines()) {
+        if (lineY >= boundsBottom) {
+            break;
+        }
+        for (std::uint32_t i = line.firstGlyph; i < line.firstGlyph + line.glyphCount; ++i) {
+            const auto& shaped = glyphs[i];
+            int glyphFontId = shaped.fontId;
+            if (!ownLayout) {
+                float advance = 0.0f;
+                glyphFontId = fonts_->FindFont(shaped.codepoint, fallbackFontId, advance);
+            }
+            // 组合标记等字形按整形给出的偏移绘制
+            const float penX = payload.bounds.x + shaped.x + shaped.xOffset;
+            // 基线对齐：与 GlRenderer 相同，以 fontSize 作为基线偏移
+            const float baseline = lineY + fontSize + shaped.yOffset;
+            if (fonts_->IsSdf(glyphFontId)) {
+                DrawSdfGlyph(shaped.codepoint, glyphFontId, penX, baseline, area, payload.color, opacity);
+                continue;
+            }
+            const auto* glyph = fonts_->GetGlyph(shaped.codepoint, glyphFontId);
+            if (!glyph) {
+                continue;
+            }
+            const int left = static_cast<int>(std::lround(penX)) + glyph->bearingX;
+            const int top = static_cast<int>(std::lround(baseline)) - glyph->bearingY;
+            const int x0 = std::max(left, area.x0);
+            const int x1 = std::min(left + glyph->width, area.x1);
+            const int y0 = std::max(top, area.y0);
+            const int y1 = std::min(top + glyph->height, area.y1);
+
+            for (int y = y0; y < y1; ++y) {
+                for (int x = x0; x < x1; ++x) {
+                    const std::size_t index = static_cast<std::size_t>(y - top) * glyph->width + (x - left);
+                    if (glyph->isColor) {
+                        const std::uint8_t* bgra = glyph->pixels.data() + index * 4;
+                        const float alpha = bgra[3] / 255.0f;
+                        if (alpha > 0.0f) {
+                            // BGRA 位图为预乘 alpha
+                            BlendPixel(x, y, bgra[2] / 255.0f / alpha, bgra[1] / 255.0f / alpha,
+                                       bgra[0] / 255.0f / alpha, alpha * CurrentOpacity());
+                        }
+                    } else {
+                        const float coverage = glyph->pixels[index] / 255.0f;
+                        if (coverage > 0.0f) {
+                            BlendPixel(x, y, payload.color[0], payload.color[1], payload.color[2], coverage * opacity);
+                        }
+                    }
+                }
+            }
+        }
+        lineY += lineHeight;
+    }
+}
+
+void SoftwareRenderer::DrawSdfGlyph(char32_t codepoint, int fontId, float penX, float baseline,
+                                    const PixelRect& area, const std::array<float, 4>& color, float opacity) {
+    const auto& font = fonts_->fonts[fontId];
+    const SdfGlyph* glyph = fonts_->GetSdfGlyph(codepoint, font);
+    if (!glyph || glyph->pixels.empty()) {
+        return;
+    }
+    // 距离场按字号缩放后放在未取整的笔位置上，与 GlRenderer 的距离场着色器一致
+    const float scale = FontCache::SdfScale(font);
+    const float left = penX + glyph->bearingX * scale;
+    const float top = baseline - glyph->bearingY * scale;
+    const int x0 = std::max(static_cast<int>(std::floor(left)), area.x0);
+    const int x1 = std::min(static_cast<int>(std::ceil(left + glyph->width * scale)), area.x1);
+    const int y0 = std::max(static_cast<int>(std::floor(top)), area.y0);
+    const int y1 = std::min(static_cast<int>(std::ceil(top + glyph->height * scale)), area.y1);
+    const float range = static_cast<float>(font.sdf->glyphSet->GetSpread()) * scale;  // ±128 对应的屏幕像素距离
+    const float inverseScale = 1.0f / scale;
+    const int width = glyph->width;
+    const int height = glyph->height;
+
+    // 距离场外视为最远的外部距离
+    auto texel = [&](int tx, int ty) -> float {
+        if (tx < 0 || ty < 0 || tx >= width || ty >= height) {
+            return 0.0f;
+        }
+        return glyph->pixels[static_cast<std::size_t>(ty) * width + tx];
+    };
+
+    for (int y = y0; y < y1; ++y) {
+        // 双线性采样：像素中心映射到距离场坐标（纹素中心在 +0.5 处）
+        const float v = (y + 0.5f - top) * inverseScale - 0.5f;
+        const int ty = static_cast<int>(std::floor(v));
+        const float fy = v - ty;
+        for (int x = x0; x < x1; ++x) {
+            const float u = (x + 0.5f - left) * inverseScale - 0.5f;
+            const int tx = static_cast<int>(std::floor(u));
+            const float fx = u - tx;
+            const float top0 = texel(tx, ty) + (texel(tx + 1, ty) - texel(tx, ty)) * fx;
+            const float bottom0 = texel(tx, ty + 1) + (texel(tx + 1, ty + 1) - texel(tx, ty + 1)) * fx;
+            const float value = top0 + (bottom0 - top0) * fy;
+            const float distance = (value - 128.0f) / 128.0f * range;
+            const float coverage = std::clamp(distance + 0.5f, 0.0f, 1.0f);
+            if (coverage > 0.0f) {
+                BlendPixel(x, y, color[0], color[1], color[2], coverage * opacity);
+            }
+        }
+    }
+}
+
+// ========== 像素操作 ==========
+
+void SoftwareRenderer::ClearRect(const PixelRect& rect) {
+    const PixelRect area = rect.Intersect(SurfaceRect());
+    if (area.IsEmpty()) {
+        return;
+    }
+    const std::array<std::uint8_t, 4> color{
+        ToByte(currentFrame_.clearColor[0]), ToByte(currentFrame_.clearColor[1]),
+        ToByte(currentFrame_.clearColor[2]), ToByte(currentFrame_.clearColor[3])
+    };
+    for (int y = area.y0; y < area.y1; ++y) {
+        std::uint8_t* row = pixels_.data() + (static_cast<std::size_t>(y) * size_.width + area.x0) * 4;
+        for (int x = area.x0; x < area.x1; ++x, row += 4) {
+            std::memcpy(row, color.data(), 4);
+        }
+    }
+}
+
+void SoftwareRenderer::BlendPixel(int x, int y, float r, float g, float b, float alpha) {
+    if (alpha <= 0.0f || x < clip_.x0 || x >= clip_.x1 || y < clip_.y0 || y >= clip_.y1) {
+        return;
+    }
+    std::uint8_t* pixel = pixels_.data() + (static_cast<std::size_t>(y) * size_.width + x) * 4;
+    if (alpha >= 1.0f) {
+        pixel[0] = ToByte(r);
+        pixel[1] = ToByte(g);
+        pixel[2] = ToByte(b);
+        pixel[3] = 255;
+        return;
+    }
+    // SRC_ALPHA / ONE_MINUS_SRC_ALPHA
+    const float inverse = 1.0f - alpha;
+    pixel[0] = ToByte(r * alpha + pixel[0] / 255.0f * inverse);
+    pixel[1] = ToByte(g * alpha + pixel[1] / 255.0f * inverse);
+    pixel[2] = ToByte(b * alpha + pixel[2] / 255.0f * inverse);
+    pixel[3] = ToByte(alpha + pixel[3] / 255.0f * inverse);
+}
+
+SoftwareRenderer::PixelRect SoftwareRenderer::SurfaceRect() const {
+    return PixelRect{0, 0, static_cast<int>(size_.width), static_cast<int>(size_.height)};
+}
+
+SoftwareRenderer::PixelRect SoftwareRenderer::ToPixelRect(const ui::Rect& rect) {
+    if (rect.IsEmpty()) {
+        return PixelRect{};
+    }
+    return PixelRect{
+        static_cast<int>(std::floor(rect.x)),
+        static_cast<int>(std::floor(rect.y)),
+        static_cast<int>(std::ceil(rect.x + rect.width)),
+        static_cast<int>(std::ceil(rect.y + rect.height))
+    };
+}
+
+} // namespace fk::render
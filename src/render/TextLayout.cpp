@@ -0,0 +1,209 @@
+#include "fk/render/TextLayout.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace fk::render {
+
+namespace {
+
+// 与 TextRenderer::Utf8ToUtf32 相同：跳过非法序列与不可见的变体选择符、零宽字符
+void DecodeUtf8(const std::string& text, std::u32string& out) {
+    out.clear();
+    out.reserve(text.size());
+    for (std::size_t i = 0; i < text.size();) {
+        auto c = static_cast<unsigned char>(text[i]);
+        char32_t codepoint = 0;
+        std::size_t length = 1;
+        if (c < 0x80) {
+            codepoint = c;
+        } else if ((c & 0xE0) == 0xC0) {
+            codepoint = c & 0x1F;
+            length = 2;
+        } else if ((c & 0xF0) == 0xE0) {
+            codepoint = c & 0x0F;
+            length = 3;
+        } else if ((c & 0xF8) == 0xF0) {
+            codepoint = c & 0x07;
+            length = 4;
+        } else {
+            ++i;
+            continue;
+        }
+        if (i + length > text.size()) {
+            break;
+        }
+        for (std::size_t k = 1; k < length; ++k) {
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+        }
+        i += length;
+
+        const bool invisible = (codepoint >= 0xFE00 && codepoint <= 0xFE0F) ||
+                               (codepoint >= 0xE0100 && codepoint <= 0xE01EF) ||
+                               (codepoint >= 0x200B && codepoint <= 0x200D);
+        if (!invisible) {
+            out.push_back(codepoint);
+        }
+    }
+}
+
+std::atomic<std::uint64_t> g_nextProviderId{1};
+
+} // namespace
+
+GlyphMetricsProvider::GlyphMetricsProvider()
+    : providerId_(g_nextProviderId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+std::shared_ptr<const TextLayout> TextLayout::Create(
+    GlyphMetricsProvider& provider,
+    int fontId,
+    const std::string& fontFamily,
+    const std::string& text,
+    float fontSize,
+    float maxWidth,
+    ShapingFeatures features)
+{
+    std::shared_ptr<TextLayout> layout(new TextLayout());
+    layout->providerId_ = provider.GetProviderId();
+    layout->fontId_ = fontId;
+    layout->fontFamily_ = fontFamily;
+    layout->text_ = text;
+    layout->fontSize_ = fontSize;
+    layout->wrapped_ = maxWidth > 0.0f;
+    layout->features_ = features;
+
+    std::u32string codepoints;
+    DecodeUtf8(text, codepoints);
+    layout->glyphs_.reserve(codepoints.size());
+
+    auto& cache = provider.GetShapeCache();
+    std::vector<std::uint8_t> charLevels;
+    std::vector<TextLayoutGlyph> logical;
+    std::vector<std::uint8_t> glyphLevels;
+
+    // 按 \n 分段（保留空行）
+    for (std::size_t start = 0;;) {
+        const std::size_t end = std::min(codepoints.find(U'\n', start), codepoints.size());
+        const std::u32string_view paragraph(codepoints.data() + start, end - start);
+        TextDirection direction = TextDirection::LeftToRight;
+        logical.clear();
+        glyphLevels.clear();
+        for (const auto& run : ItemizeBidi(paragraph, direction, charLevels)) {
+            // 以单词为单位整形，单词与空格分别缓存
+            const std::uint32_t runEnd = run.start + run.length;
+            for (std::uint32_t i = run.start; i < runEnd;) {
+                std::uint32_t wordEnd = i + 1;
+                if (paragraph[i] != U' ') {
+                    while (wordEnd < runEnd && paragraph[wordEnd] != U' ') {
+                        ++wordEnd;
+                    }
+                }
+                const auto shaped = cache.Shape(provider, paragraph.substr(i, wordEnd - i), fontId, features,
+                                                run.GetDirection());
+                for (const auto& glyph : shaped->glyphs) {
+                    logical.push_back(TextLayoutGlyph{glyph.codepoint, glyph.fontId, 0.0f, glyph.advance,
+                                                      static_cast<std::uint32_t>(start + i + glyph.cluster),
+                                                      glyph.xOffset, glyph.yOffset});
+                    glyphLevels.push_back(run.level);
+                }
+                i = wordEnd;
+            }
+        }
+        layout->AppendParagraph(logical, glyphLevels, direction, maxWidth);
+        if (end == codepoints.size()) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    return layout;
+}
+
+void TextLayout::AppendParagraph(const std::vector<TextLayoutGlyph>& logical, const std::vector<std::uint8_t>& levels,
+                                 TextDirection direction, float maxWidth) {
+    // 按逻辑顺序自动换行
+    std::size_t lineStart = 0;
+    float lineWidth = 0.0f;
+    for (std::size_t i = 0; i < logical.size(); ++i) {
+        const float advance = logical[i].advance;
+        if (wrapped_ && i != lineStart && lineWidth + advance > maxWidth) {
+            overflowWidth_ = std::min(overflowWidth_, lineWidth + advance);
+            AppendLine(logical, levels, lineStart, i, lineWidth, direction);
+            lineStart = i;
+            lineWidth = 0.0f;
+        }
+        lineWidth += advance;
+    }
+    AppendLine(logical, levels, lineStart, logical.size(), lineWidth, direction);
+}
+
+void TextLayout::AppendLine(const std::vector<TextLayoutGlyph>& logical, const std::vector<std::uint8_t>& levels,
+                            std::size_t begin, std::size_t end, float width, TextDirection direction) {
+    TextLayoutLine line;
+    line.firstGlyph = static_cast<std::uint32_t>(glyphs_.size());
+    line.glyphCount = static_cast<std::uint32_t>(end - begin);
+    line.width = width;
+    line.direction = direction;
+    width_ = std::max(width_, width);
+    if (line.glyphCount >= 2) {
+        requiredWidth_ = std::max(requiredWidth_, width);
+    }
+    lines_.push_back(line);
+
+    const bool leftToRight = std::all_of(levels.begin() + static_cast<std::ptrdiff_t>(begin),
+                                         levels.begin() + static_cast<std::ptrdiff_t>(end),
+                                         [](std::uint8_t level) { return level == 0; });
+    float x = 0.0f;
+    if (leftToRight) {
+        for (std::size_t i = begin; i < end; ++i) {
+            glyphs_.push_back(logical[i]);
+            glyphs_.back().x = x;
+            x += logical[i].advance;
+        }
+        return;
+    }
+
+    // 重排单位：基本字形与其后的零宽字形（组合标记），标记在视觉顺序中仍跟随基本字形；
+    // 行尾空白取段落层级（规则 L1）
+    const std::uint8_t baseLevel = direction == TextDirection::RightToLeft ? 1 : 0;
+    std::size_t trailing = end;
+    while (trailing > begin && logical[trailing - 1].codepoint == U' ') {
+        --trailing;
+    }
+    std::vector<std::uint32_t> unitStarts;
+    std::vector<std::uint8_t> unitLevels;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (i == begin || logical[i].advance != 0.0f) {
+            unitStarts.push_back(static_cast<std::uint32_t>(i));
+            unitLevels.push_back(i >= trailing ? baseLevel : levels[i]);
+        }
+    }
+    std::vector<std::uint32_t> order;
+    ReorderByLevels(unitLevels, order);
+    for (std::uint32_t unit : order) {
+        const std::size_t unitEnd = unit + 1 < unitStarts.size() ? unitStarts[unit + 1] : end;
+        for (std::size_t i = unitStarts[unit]; i < unitEnd; ++i) {
+            glyphs_.push_back(logical[i]);
+            glyphs_.back().x = x;
+            x += logical[i].advance;
+        }
+    }
+}
+
+bool TextLayout::Matches(const GlyphMetricsProvider& provider, int fontId, const std::string& text,
+                         float fontSize, bool wrapped, ShapingFeatures features) const {
+    return providerId_ == provider.GetProviderId() && fontId_ == fontId && fontSize_ == fontSize &&
+           wrapped_ == wrapped && features_ == features && text_ == text;
+}
+
+bool TextLayout::FitsWidth(float maxWidth) const {
+    if (!wrapped_) {
+        return true;
+    }
+    // 没有自动换行的行时，任何放得下最宽行的宽度（包括无限宽）结果都相同
+    const bool noSoftBreak = overflowWidth_ == std::numeric_limits<float>::infinity();
+    return maxWidth > 0.0f && maxWidth >= requiredWidth_ && (noSoftBreak || maxWidth < overflowWidth_);
+}
+
+} // namespace fk::render
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <vector>
 #include <cstring>
+#include <cmath>
 
 #include FT_COLOR_H
 #include FT_GLYPH_H
@@ -118,21 +119,22 @@ static bool RenderCOLRLayers(FT_Face face, FT_UInt glyphIndex, int& outWidth, in
 TextRenderer::TextRenderer()
     : ftLibrary_(nullptr)
     , initialized_(false) {
+    atlas_.SetPageEvictedCallback([this](int page) { OnAtlasPageEvicted(page); });
 }
 
 TextRenderer::~TextRenderer() {
     // 清理字体
     for (auto& font : fonts_) {
-        if (font && font->face) {
-            // 清理字形纹理
-            for (auto& pair : font->glyphs) {
-                if (pair.second.textureID != 0) {
-                    glDeleteTextures(1, &pair.second.textureID);
-                }
-            }
+        if (font && font->face && !font->sdf) {
+            // 字形纹理由图集统一释放
             FT_Done_Face(font->face);
         }
     }
+    for (auto& [key, sdf] : sdfFonts_) {
+        if (sdf) {
+            FT_Done_Face(sdf->face);
+        }
+    }
 
     // 清理 FreeType 库
     if (ftLibrary_) {
@@ -156,14 +158,14 @@ bool TextRenderer::Initialize() {
     return true;
 }
 
-int TextRenderer::LoadFont(const std::string& fontPath, unsigned int fontSize) {
+int TextRenderer::LoadFont(const std::string& fontPath, unsigned int fontSize, int faceIndex) {
     if (!initialized_) {
         std::cerr << "ERROR::FREETYPE: TextRenderer not initialized" << std::endl;
         return -1;
     }
 
     // Phase 5.0.3: 检查缓存
-    FontCacheKey cacheKey{fontPath, fontSize};
+    FontCacheKey cacheKey{fontPath, fontSize, faceIndex};
     auto cacheIt = fontCache_.find(cacheKey);
     if (cacheIt != fontCache_.end()) {
         std::cout << "Font loaded from cache: " << fontPath << " (ID: " << cacheIt->second << ")" << std::endl;
@@ -173,18 +175,28 @@ int TextRenderer::LoadFont(const std::string& fontPath, unsigned int fontSize) {
     // 创建新的字体
     auto fontFace = std::make_unique<FontFace>();
 
-    // 加载字体文件
-    if (FT_New_Face(ftLibrary_, fontPath.c_str(), 0, &fontFace->face)) {
-        std::cerr << "ERROR::FREETYPE: Failed to load font: " << fontPath << std::endl;
-        return -1;
+    // Phase 5.1: 距离场模式下所有字号共享参考字号的字体（彩色字体仍按位图加载）
+    if (glyphRenderMode_ == GlyphRenderMode::SignedDistanceField) {
+        fontFace->sdf = AcquireSdfFont(fontPath, faceIndex);
     }
 
-    // 设置字体大小
-    FT_Set_Pixel_Sizes(fontFace->face, 0, fontSize);
+    if (fontFace->sdf) {
+        fontFace->face = fontFace->sdf->face;
+    } else {
+        // 加载字体文件
+        if (FT_New_Face(ftLibrary_, fontPath.c_str(), faceIndex, &fontFace->face)) {
+            std::cerr << "ERROR::FREETYPE: Failed to load font: " << fontPath << std::endl;
+            return -1;
+        }
+
+        // 设置字体大小
+        FT_Set_Pixel_Sizes(fontFace->face, 0, fontSize);
+    }
     
     // Phase 5.0.3: 存储字体信息
     fontFace->fontPath = fontPath;
     fontFace->fontSize = fontSize;
+    fontFace->faceIndex = faceIndex;
 
     // 先添加到fonts_向量,获取fontId
     int fontId = static_cast<int>(fonts_.size());
@@ -225,15 +237,19 @@ bool TextRenderer::LoadCharacter(char32_t c, int fontId) {
         return true;
     }
 
-    // 先检查字体是否包含该字符
-    FT_UInt glyph_index = FT_Get_Char_Index(font->face, c);
-    if (glyph_index == 0) {
+    // 距离场字体不参与 HarfBuzz 整形，不会收到字形索引
+    if (font->sdf) {
+        return !IsGlyphIndex(c) && LoadSdfCharacter(c, *font);
+    }
+
+    // 先检查字体是否包含该字符（HarfBuzz 整形输出的字形索引直接使用）
+    const FT_UInt glyphIndex = IsGlyphIndex(c) ? GlyphIndexOf(c) : FT_Get_Char_Index(font->face, c);
+    if (glyphIndex == 0) {
         // 字体不包含该字符（这是正常的，不是错误）
         return false;
     }
 
     // 检查是否为 COLR 字形
-    FT_UInt glyphIndex = FT_Get_Char_Index(font->face, c);
     bool isColorGlyph = false;
     std::vector<unsigned char> colorBuffer;
     int colorWidth = 0, colorHeight = 0;
@@ -249,9 +265,9 @@ bool TextRenderer::LoadCharacter(char32_t c, int fontId) {
     
     // 如果 COLR 失败，尝试 BGRA 位图
     if (!isColorGlyph) {
-        FT_Error error = FT_Load_Char(font->face, c, FT_LOAD_COLOR | FT_LOAD_RENDER);
+        FT_Error error = FT_Load_Glyph(font->face, glyphIndex, FT_LOAD_COLOR | FT_LOAD_RENDER);
         if (error) {
-            error = FT_Load_Char(font->face, c, FT_LOAD_RENDER);
+            error = FT_Load_Glyph(font->face, glyphIndex, FT_LOAD_RENDER);
             if (error) {
                 return false;
             }
@@ -262,72 +278,67 @@ bool TextRenderer::LoadCharacter(char32_t c, int fontId) {
         }
     }
 
-    // 生成纹理
-    unsigned int texture;
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    
-    // 根据像素格式选择纹理格式
+    FT_GlyphSlot slot = font->face->glyph;
+
+    Glyph glyph;
+    glyph.isColor = isColorGlyph;
+    glyph.advance = static_cast<int>(slot->advance.x >> 6);  // 转换为像素 (1/64 像素)
+
+    // Phase 5.1: 上传到字形图集而不是为每个字形单独生成纹理
+    const unsigned char* pixels = nullptr;
+    AtlasPixelFormat pixelFormat = AtlasPixelFormat::Gray8;
+    std::vector<unsigned char> packed;
+
     if (!colorBuffer.empty()) {
         // COLR 渲染的 RGBA 缓冲区
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RGBA,
-            colorWidth,
-            colorHeight,
-            0,
-            GL_RGBA,
-            GL_UNSIGNED_BYTE,
-            colorBuffer.data()
-        );
-    } else if (font->face->glyph->bitmap.pixel_mode == FT_PIXEL_MODE_BGRA) {
-        // SBIX/CBDT 位图格式
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RGBA,
-            font->face->glyph->bitmap.width,
-            font->face->glyph->bitmap.rows,
-            0,
-            GL_BGRA,
-            GL_UNSIGNED_BYTE,
-            font->face->glyph->bitmap.buffer
-        );
+        glyph.width = colorWidth;
+        glyph.height = colorHeight;
+        glyph.bearingX = colorBearingX;
+        glyph.bearingY = colorBearingY;
+        pixels = colorBuffer.data();
+        pixelFormat = AtlasPixelFormat::RGBA8;
     } else {
-        // 灰度字形
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            font->face->glyph->bitmap.width,
-            font->face->glyph->bitmap.rows,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            font->face->glyph->bitmap.buffer
-        );
-    }
-
-    // 设置纹理选项
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // 存储字形信息
-    Glyph glyph{
-        texture,
-        !colorBuffer.empty() ? colorWidth : static_cast<int>(font->face->glyph->bitmap.width),
-        !colorBuffer.empty() ? colorHeight : static_cast<int>(font->face->glyph->bitmap.rows),
-        !colorBuffer.empty() ? colorBearingX : font->face->glyph->bitmap_left,
-        !colorBuffer.empty() ? colorBearingY : font->face->glyph->bitmap_top,
-        static_cast<int>(font->face->glyph->advance.x >> 6),  // 转换为像素 (1/64 像素)
-        isColorGlyph  // 标记是否为彩色字形
-    };
+        const FT_Bitmap& bitmap = slot->bitmap;
+        glyph.width = static_cast<int>(bitmap.width);
+        glyph.height = static_cast<int>(bitmap.rows);
+        glyph.bearingX = slot->bitmap_left;
+        glyph.bearingY = slot->bitmap_top;
+
+        // SBIX/CBDT 位图为 BGRA，其余为灰度
+        const bool bgra = bitmap.pixel_mode == FT_PIXEL_MODE_BGRA;
+        pixelFormat = bgra ? AtlasPixelFormat::BGRA8 : AtlasPixelFormat::Gray8;
+
+        // 按 pitch 重新排列为紧密缓冲区
+        const std::size_t rowBytes = static_cast<std::size_t>(bitmap.width) * (bgra ? 4 : 1);
+        if (bitmap.buffer && rowBytes > 0 && bitmap.rows > 0) {
+            if (bitmap.pitch == static_cast<int>(rowBytes)) {
+                pixels = bitmap.buffer;
+            } else {
+                packed.resize(rowBytes * bitmap.rows);
+                for (unsigned int row = 0; row < bitmap.rows; ++row) {
+                    const unsigned char* src = bitmap.pitch >= 0
+                        ? bitmap.buffer + row * bitmap.pitch
+                        : bitmap.buffer + (bitmap.rows - 1 - row) * (-bitmap.pitch);
+                    std::memcpy(packed.data() + row * rowBytes, src, rowBytes);
+                }
+                pixels = packed.data();
+            }
+        }
+    }
+
+    // 空白字形（如空格）只保留度量信息
+    if (pixels && glyph.width > 0 && glyph.height > 0) {
+        AtlasRegion region;
+        if (atlas_.Allocate(isColorGlyph ? AtlasFormat::Color : AtlasFormat::Gray,
+                            glyph.width, glyph.height, pixels, pixelFormat, region)) {
+            glyph.textureID = region.textureID;
+            glyph.atlasPage = region.page;
+            glyph.u0 = region.u0;
+            glyph.v0 = region.v0;
+            glyph.u1 = region.u1;
+            glyph.v1 = region.v1;
+        }
+    }
 
     font->glyphs[c] = glyph;
     return true;
@@ -382,6 +393,12 @@ int TextRenderer::GetLineHeight(int fontId) const {
         return 0;
     }
 
+    if (font->sdf) {
+        // 共享的字体设置为参考字号
+        const float scale = static_cast<float>(font->fontSize) /
+                            static_cast<float>(font->sdf->glyphSet->GetReferenceSize());
+        return static_cast<int>(std::lround(static_cast<float>(font->face->size->metrics.height >> 6) * scale));
+    }
     return font->face->size->metrics.height >> 6;  // 转换为像素
 }
 
@@ -466,7 +483,128 @@ const Glyph* TextRenderer::GetGlyph(char32_t c, int fontId) {
     }
 
     auto it = font->glyphs.find(c);
-    return (it != font->glyphs.end()) ? &it->second : nullptr;
+    if (it == font->glyphs.end()) {
+        return nullptr;
+    }
+
+    atlas_.Touch(it->second.atlasPage);
+    return &it->second;
+}
+
+void TextRenderer::OnAtlasPageEvicted(int page) {
+    // 被淘汰页上的字形需要在下次使用时重新光栅化
+    auto evict = [page](std::unordered_map<char32_t, Glyph>& glyphs) {
+        for (auto it = glyphs.begin(); it != glyphs.end();) {
+            if (it->second.atlasPage == page) {
+                it = glyphs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    };
+    for (auto& font : fonts_) {
+        if (font) {
+            evict(font->glyphs);
+        }
+    }
+    // 距离场保留在字形集中，重新上传即可
+    for (auto& [key, sdf] : sdfFonts_) {
+        if (sdf) {
+            evict(sdf->glyphs);
+        }
+    }
+}
+
+// ========== Phase 5.1: 距离场字形 ==========
+
+std::shared_ptr<SdfGlyphSet> TextRenderer::GetSdfGlyphSet(int fontId) const {
+    if (fontId < 0 || fontId >= static_cast<int>(fonts_.size()) || !fonts_[fontId]->sdf) {
+        return nullptr;
+    }
+    return fonts_[fontId]->sdf->glyphSet;
+}
+
+SdfFont* TextRenderer::AcquireSdfFont(const std::string& fontPath, int faceIndex) {
+    const std::string key = fontPath + "#" + std::to_string(faceIndex);
+    auto it = sdfFonts_.find(key);
+    if (it != sdfFonts_.end()) {
+        return it->second.get();
+    }
+
+    std::unique_ptr<SdfFont> sdf;
+    FT_Face face = nullptr;
+    if (FT_New_Face(ftLibrary_, fontPath.c_str(), faceIndex, &face) == 0) {
+        if (SdfGlyphSet::Supports(face)) {
+            // 同一字体的字形集在渲染器之间共享（也可能是预先注册的烘焙结果）
+            const std::string setKey = SdfGlyphSet::KeyOf(face);
+            auto glyphSet = SdfGlyphSet::FindRegistered(setKey);
+            if (!glyphSet) {
+                glyphSet = std::make_shared<SdfGlyphSet>(face->family_name ? face->family_name : "",
+                                                         face->style_name ? face->style_name : "");
+                SdfGlyphSet::Register(glyphSet);
+            }
+            FT_Set_Pixel_Sizes(face, 0, static_cast<FT_UInt>(glyphSet->GetReferenceSize()));
+            sdf = std::make_unique<SdfFont>();
+            sdf->face = face;
+            sdf->glyphSet = std::move(glyphSet);
+        } else {
+            FT_Done_Face(face);
+        }
+    }
+
+    SdfFont* result = sdf.get();
+    sdfFonts_.emplace(key, std::move(sdf));
+    return result;
+}
+
+bool TextRenderer::LoadSdfCharacter(char32_t c, FontFace& font) {
+    SdfFont& sdf = *font.sdf;
+    auto it = sdf.glyphs.find(c);
+    if (it == sdf.glyphs.end()) {
+        const SdfGlyph* source = sdf.glyphSet->Generate(sdf.face, c);
+        if (!source) {
+            return false;
+        }
+
+        Glyph glyph;
+        glyph.isSdf = true;
+        glyph.width = source->width;
+        glyph.height = source->height;
+        glyph.bearingX = source->bearingX;
+        glyph.bearingY = source->bearingY;
+        glyph.sdfAdvance = source->advance;
+        if (!source->pixels.empty()) {
+            AtlasRegion region;
+            if (atlas_.Allocate(AtlasFormat::Gray, glyph.width, glyph.height, source->pixels.data(),
+                                AtlasPixelFormat::Gray8, region)) {
+                glyph.textureID = region.textureID;
+                glyph.atlasPage = region.page;
+                glyph.u0 = region.u0;
+                glyph.v0 = region.v0;
+                glyph.u1 = region.u1;
+                glyph.v1 = region.v1;
+            }
+        }
+        it = sdf.glyphs.emplace(c, glyph).first;
+    }
+
+    // 按字号缩放参考字号下的度量，图集区域共享
+    const Glyph& reference = it->second;
+    const float scale = static_cast<float>(font.fontSize) / static_cast<float>(sdf.glyphSet->GetReferenceSize());
+    Glyph glyph = reference;
+    glyph.sdfRange = static_cast<float>(sdf.glyphSet->GetSpread()) * scale;
+    glyph.sdfBearingX = static_cast<float>(reference.bearingX) * scale;
+    glyph.sdfBearingY = static_cast<float>(reference.bearingY) * scale;
+    glyph.sdfWidth = static_cast<float>(reference.width) * scale;
+    glyph.sdfHeight = static_cast<float>(reference.height) * scale;
+    glyph.sdfAdvance = reference.sdfAdvance * scale;
+    glyph.width = static_cast<int>(std::lround(glyph.sdfWidth));
+    glyph.height = static_cast<int>(std::lround(glyph.sdfHeight));
+    glyph.bearingX = static_cast<int>(std::lround(glyph.sdfBearingX));
+    glyph.bearingY = static_cast<int>(std::lround(glyph.sdfBearingY));
+    glyph.advance = static_cast<int>(std::lround(glyph.sdfAdvance));
+    font.glyphs[c] = glyph;
+    return true;
 }
 
 // ========== Phase 5.0.3 新增方法 ==========
@@ -488,16 +626,67 @@ void TextRenderer::ClearFallbackFonts() {
 }
 
 const Glyph* TextRenderer::GetGlyphWithFallback(char32_t c, int fontId) {
-    // 尝试主字体
-    const Glyph* glyph = GetGlyph(c, fontId);
-    if (glyph) {
-        return glyph;
+    int glyphFontId = -1;
+    return FindGlyph(c, fontId, glyphFontId);
+}
+
+int TextRenderer::LoadManagedFont(FontFaceId face, unsigned int fontSize) {
+    const FontFaceInfo* info = FontManager::Instance().GetFace(face);
+    if (!info) {
+        return -1;
+    }
+    const std::uint64_t key = (static_cast<std::uint64_t>(face) << 32) | fontSize;
+    auto it = managedFonts_.find(key);
+    if (it != managedFonts_.end()) {
+        return it->second;
+    }
+    const int fontId = LoadFont(info->path, fontSize, info->faceIndex);
+    if (fontId >= 0) {
+        fonts_[fontId]->managerFace = face;
+    }
+    managedFonts_[key] = fontId;
+    return fontId;
+}
+
+const Glyph* TextRenderer::FindGlyph(char32_t c, int fontId, int& glyphFontId) {
+    if (fontId < 0 || fontId >= static_cast<int>(fonts_.size())) {
+        return nullptr;
+    }
+    // 字形索引只在整形所用的字体中有意义，不回退
+    if (IsGlyphIndex(c)) {
+        glyphFontId = fontId;
+        return GetGlyph(c, fontId);
+    }
+
+    auto& manager = FontManager::Instance();
+    const FontFaceId mainFace = fonts_[fontId]->managerFace;
+
+    // 尝试主字体（已知不含该字符时跳过）
+    const Glyph* glyph = nullptr;
+    if (mainFace < 0 || manager.HasCodepoint(mainFace, c)) {
+        glyph = GetGlyph(c, fontId);
+        if (glyph) {
+            glyphFontId = fontId;
+            return glyph;
+        }
+    }
+
+    // Phase 5.1: 按码位块回退链查找包含该字符的系统字体
+    const FontFaceId fallbackFace = manager.FindFaceForCodepoint(c, mainFace);
+    if (fallbackFace >= 0 && fallbackFace != mainFace) {
+        const int fallbackId = LoadManagedFont(fallbackFace, fonts_[fontId]->fontSize);
+        glyph = fallbackId >= 0 ? GetGlyph(c, fallbackId) : nullptr;
+        if (glyph) {
+            glyphFontId = fallbackId;
+            return glyph;
+        }
     }
     
     // 尝试回退字体
     for (int fallbackId : fallbackFonts_) {
         glyph = GetGlyph(c, fallbackId);
         if (glyph) {
+            glyphFontId = fallbackId;
             return glyph;
         }
     }
@@ -506,6 +695,7 @@ const Glyph* TextRenderer::GetGlyphWithFallback(char32_t c, int fontId) {
     if (defaultFontId_ != -1 && defaultFontId_ != fontId) {
         glyph = GetGlyph(c, defaultFontId_);
         if (glyph) {
+            glyphFontId = defaultFontId_;
             return glyph;
         }
     }
@@ -513,90 +703,71 @@ const Glyph* TextRenderer::GetGlyphWithFallback(char32_t c, int fontId) {
     return nullptr;
 }
 
-TextLayout TextRenderer::CalculateTextLayout(
+// ========== Phase 5.1: 排版 ==========
+
+int TextRenderer::ResolveFont(const std::string& fontFamily, float fontSize, int fontWeight, bool italic) {
+    const auto size = static_cast<unsigned int>(fontSize);
+    const FontFaceId face = FontManager::Instance().Resolve(fontFamily, fontWeight, italic);
+    const int fontId = LoadManagedFont(face, size);
+    if (fontId >= 0) {
+        return fontId;
+    }
+    std::cerr << "Failed to resolve font '" << fontFamily << "' for size " << size << "!" << std::endl;
+    return defaultFontId_;
+}
+
+bool TextRenderer::GetGlyphAdvance(char32_t c, int fontId, int& glyphFontId, float& advance) {
+    const Glyph* glyph = FindGlyph(c, fontId, glyphFontId);
+    if (!glyph) {
+        return false;
+    }
+    advance = glyph->isSdf ? glyph->sdfAdvance : static_cast<float>(glyph->advance);
+    return true;
+}
+
+float TextRenderer::GetKerning(int fontId, char32_t left, char32_t right) {
+    if (fontId < 0 || fontId >= static_cast<int>(fonts_.size()) || !fonts_[fontId]) {
+        return 0.0f;
+    }
+    const FontFace& font = *fonts_[fontId];
+    if (!font.face || !FT_HAS_KERNING(font.face)) {
+        return 0.0f;
+    }
+    // 未缩放的字体单位按字号换算，位图与距离场字体（共享参考字号的 FT_Face）结果相同
+    FT_Vector kerning{};
+    if (FT_Get_Kerning(font.face, FT_Get_Char_Index(font.face, left), FT_Get_Char_Index(font.face, right),
+                       FT_KERNING_UNSCALED, &kerning) != 0) {
+        return 0.0f;
+    }
+    return static_cast<float>(kerning.x) * static_cast<float>(font.fontSize) / font.face->units_per_EM;
+}
+
+bool TextRenderer::GetFontSource(int fontId, std::string& path, int& faceIndex, float& fontSize) const {
+    if (fontId < 0 || fontId >= static_cast<int>(fonts_.size()) || !fonts_[fontId] || fonts_[fontId]->sdf) {
+        return false;
+    }
+    const FontFace& font = *fonts_[fontId];
+    path = font.fontPath;
+    faceIndex = font.faceIndex;
+    fontSize = static_cast<float>(font.fontSize);
+    return true;
+}
+
+std::shared_ptr<const TextLayout> TextRenderer::CalculateTextLayout(
     const std::string& text,
     int fontId,
     float maxWidth
 ) {
-    TextLayout layout;
-    
-    if (fontId < 0 || fontId >= fonts_.size() || text.empty()) {
-        return layout;
+    if (fontId < 0 || fontId >= static_cast<int>(fonts_.size())) {
+        return nullptr;
     }
     
     auto& font = fonts_[fontId];
     if (!font || !font->face) {
-        return layout;
-    }
-    
-    // 转换为 UTF-32
-    auto utf32Text = Utf8ToUtf32(text);
-    
-    if (maxWidth <= 0) {
-        // 不换行，单行文本
-        layout.lines.push_back(utf32Text);
-        
-        int lineWidth = 0;
-        for (char32_t c : utf32Text) {
-            const Glyph* glyph = GetGlyphWithFallback(c, fontId);
-            if (glyph) {
-                lineWidth += glyph->advance;
-            }
-        }
-        
-        layout.lineWidths.push_back(lineWidth);
-        layout.totalWidth = lineWidth;
-        layout.totalHeight = GetLineHeight(fontId);
-    } else {
-        // 换行模式
-        std::u32string currentLine;
-        int currentWidth = 0;
-        int lineHeight = GetLineHeight(fontId);
-        
-        for (size_t i = 0; i < utf32Text.length(); ++i) {
-            char32_t c = utf32Text[i];
-            
-            // 处理换行符
-            if (c == U'\n') {
-                layout.lines.push_back(currentLine);
-                layout.lineWidths.push_back(currentWidth);
-                layout.totalWidth = std::max(layout.totalWidth, currentWidth);
-                
-                currentLine.clear();
-                currentWidth = 0;
-                continue;
-            }
-            
-            const Glyph* glyph = GetGlyphWithFallback(c, fontId);
-            if (!glyph) {
-                continue;
-            }
-            
-            // 检查是否需要换行
-            if (currentWidth + glyph->advance > maxWidth && !currentLine.empty()) {
-                layout.lines.push_back(currentLine);
-                layout.lineWidths.push_back(currentWidth);
-                layout.totalWidth = std::max(layout.totalWidth, currentWidth);
-                
-                currentLine.clear();
-                currentWidth = 0;
-            }
-            
-            currentLine += c;
-            currentWidth += glyph->advance;
-        }
-        
-        // 添加最后一行
-        if (!currentLine.empty()) {
-            layout.lines.push_back(currentLine);
-            layout.lineWidths.push_back(currentWidth);
-            layout.totalWidth = std::max(layout.totalWidth, currentWidth);
-        }
-        
-        layout.totalHeight = static_cast<int>(layout.lines.size()) * lineHeight;
+        return nullptr;
     }
     
-    return layout;
+    return TextLayout::Create(*this, fontId, std::string(), text, static_cast<float>(font->fontSize), maxWidth);
 }
 
 void TextRenderer::MeasureTextMultiline(
@@ -606,9 +777,16 @@ void TextRenderer::MeasureTextMultiline(
     int& outWidth,
     int& outHeight
 ) {
+    outWidth = 0;
+    outHeight = 0;
+    if (text.empty()) {
+        return;
+    }
     auto layout = CalculateTextLayout(text, fontId, maxWidth);
-    outWidth = layout.totalWidth;
-    outHeight = layout.totalHeight;
+    if (layout) {
+        outWidth = static_cast<int>(layout->GetWidth());
+        outHeight = static_cast<int>(std::ceil(layout->GetHeight()));
+    }
 }
 
 } // namespace fk::render
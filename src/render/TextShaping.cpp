@@ -0,0 +1,733 @@
+#include "fk/render/TextShaping.h"
+#include "fk/render/TextLayout.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#ifdef FK_HAS_HARFBUZZ
+#include <hb.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#endif
+
+namespace fk::render {
+
+namespace {
+
+// ========== 双向文本 ==========
+
+// UAX #9 双向类别（只保留简化算法用到的类别）
+enum class BidiClass : std::uint8_t {
+    L,      // 从左到右
+    R,      // 从右到左（希伯来文等）
+    AL,     // 阿拉伯字母
+    EN,     // 欧洲数字
+    AN,     // 阿拉伯数字
+    ES,     // 数字分隔符（+ -）
+    ET,     // 数字终止符（# $ % 货币符号）
+    CS,     // 通用数字分隔符（, . / :）
+    NSM,    // 组合标记
+    WS,     // 空白
+    ON      // 其他中性字符
+};
+
+BidiClass Classify(char32_t c) {
+    if (c < 0x80) {
+        if (c >= U'0' && c <= U'9') {
+            return BidiClass::EN;
+        }
+        if ((c >= U'A' && c <= U'Z') || (c >= U'a' && c <= U'z')) {
+            return BidiClass::L;
+        }
+        switch (c) {
+            case U'+': case U'-': return BidiClass::ES;
+            case U'#': case U'$': case U'%': return BidiClass::ET;
+            case U',': case U'.': case U'/': case U':': return BidiClass::CS;
+            case U' ': case U'\t': return BidiClass::WS;
+            default: return BidiClass::ON;
+        }
+    }
+    if (c < 0x100) {
+        if (c == 0xA0) {
+            return BidiClass::CS;
+        }
+        if ((c >= 0xA2 && c <= 0xA5) || c == 0xB0 || c == 0xB1) {
+            return BidiClass::ET;
+        }
+        if (c == 0xB2 || c == 0xB3 || c == 0xB9) {
+            return BidiClass::EN;
+        }
+        const bool letter = c == 0xAA || c == 0xB5 || c == 0xBA || (c >= 0xC0 && c != 0xD7 && c != 0xF7);
+        return letter ? BidiClass::L : BidiClass::ON;
+    }
+    if (c >= 0x0300 && c <= 0x036F) {
+        return BidiClass::NSM;
+    }
+    if (c >= 0x0590 && c <= 0x05FF) {
+        return c >= 0x0591 && c <= 0x05BD ? BidiClass::NSM : BidiClass::R;
+    }
+    if (c >= 0x0600 && c <= 0x08FF) {
+        if ((c >= 0x0660 && c <= 0x0669) || c == 0x066B || c == 0x066C) {
+            return BidiClass::AN;
+        }
+        if (c >= 0x06F0 && c <= 0x06F9) {
+            return BidiClass::EN;
+        }
+        if ((c >= 0x064B && c <= 0x065F) || c == 0x0670 || (c >= 0x06D6 && c <= 0x06DC) ||
+            (c >= 0x06DF && c <= 0x06E4) || c == 0x06E7 || c == 0x06E8 || (c >= 0x06EA && c <= 0x06ED)) {
+            return BidiClass::NSM;
+        }
+        // NKo、撒玛利亚文、曼达文为 R，其余（阿拉伯文、叙利亚文、它拿文）为 AL
+        return c >= 0x07C0 && c <= 0x085F ? BidiClass::R : BidiClass::AL;
+    }
+    if (c >= 0x0900 && c <= 0x0DFF) {
+        // 印度系文字的上下方元音符号与 virama 为组合标记
+        const char32_t offset = c & 0x7F;
+        const bool mark = offset <= 0x02 || offset == 0x3A || offset == 0x3C || (offset >= 0x41 && offset <= 0x48) ||
+                          offset == 0x4D || (offset >= 0x51 && offset <= 0x57) || offset == 0x62 || offset == 0x63;
+        return mark ? BidiClass::NSM : BidiClass::L;
+    }
+    if (c >= 0x2000 && c <= 0x200A) {
+        return BidiClass::WS;
+    }
+    if (c == 0x200E) {
+        return BidiClass::L;
+    }
+    if (c == 0x200F) {
+        return BidiClass::R;
+    }
+    if (c >= 0x20A0 && c <= 0x20CF) {
+        return BidiClass::ET;
+    }
+    if (c >= 0x2010 && c <= 0x2BFF) {
+        return BidiClass::ON;
+    }
+    if (c == 0x3000) {
+        return BidiClass::WS;
+    }
+    if (c >= 0x3001 && c <= 0x303F) {
+        return BidiClass::ON;
+    }
+    if (c >= 0xFB1D && c <= 0xFB4F) {
+        return BidiClass::R;
+    }
+    if ((c >= 0xFB50 && c <= 0xFDFF) || (c >= 0xFE70 && c <= 0xFEFE)) {
+        return BidiClass::AL;
+    }
+    if ((c >= 0xFE00 && c <= 0xFE0F) || (c >= 0xFE20 && c <= 0xFE2F)) {
+        return BidiClass::NSM;
+    }
+    if (c >= 0xFF10 && c <= 0xFF19) {
+        return BidiClass::EN;
+    }
+    if (c >= 0x10800 && c <= 0x10FFF) {
+        return BidiClass::R;
+    }
+    if (c >= 0x1F000 && c <= 0x1FAFF) {
+        return BidiClass::ON;
+    }
+    return BidiClass::L;
+}
+
+bool IsNeutral(BidiClass value) {
+    return value == BidiClass::WS || value == BidiClass::ON;
+}
+
+// 规则 N1：数字按从右到左处理
+BidiClass StrongDirection(BidiClass value) {
+    return value == BidiClass::L ? BidiClass::L : BidiClass::R;
+}
+
+// UAX #9 规则 L4 的常用成对字符
+char32_t MirrorCodepoint(char32_t c) {
+    switch (c) {
+        case U'(': return U')';
+        case U')': return U'(';
+        case U'<': return U'>';
+        case U'>': return U'<';
+        case U'[': return U']';
+        case U']': return U'[';
+        case U'{': return U'}';
+        case U'}': return U'{';
+        case 0xAB: return 0xBB;     // « »
+        case 0xBB: return 0xAB;
+        case 0x2039: return 0x203A; // ‹ ›
+        case 0x203A: return 0x2039;
+        case 0x2264: return 0x2265; // ≤ ≥
+        case 0x2265: return 0x2264;
+        default: return c;
+    }
+}
+
+// ========== 阿拉伯文连接 ==========
+
+enum class Joining : std::uint8_t {
+    None,           // 不连接
+    Right,          // 只与前一个字母连接（alef、dal、reh、waw 等）
+    Dual,           // 与两侧连接
+    Causing,        // tatweel：使两侧连接，本身没有表现形式
+    Transparent     // 组合标记：连接时跳过
+};
+
+struct ArabicLetter {
+    char32_t isolated;  // Presentation Forms-B 中的独立形式（0 表示没有表现形式）
+    Joining joining;
+};
+
+// U+0621-U+064A；表现形式依次为 独立、词尾、词首、词中
+constexpr ArabicLetter kArabicLetters[] = {
+    {0xFE80, Joining::None},  {0xFE81, Joining::Right}, {0xFE83, Joining::Right}, {0xFE85, Joining::Right},
+    {0xFE87, Joining::Right}, {0xFE89, Joining::Dual},  {0xFE8D, Joining::Right}, {0xFE8F, Joining::Dual},
+    {0xFE93, Joining::Right}, {0xFE95, Joining::Dual},  {0xFE99, Joining::Dual},  {0xFE9D, Joining::Dual},
+    {0xFEA1, Joining::Dual},  {0xFEA5, Joining::Dual},  {0xFEA9, Joining::Right}, {0xFEAB, Joining::Right},
+    {0xFEAD, Joining::Right}, {0xFEAF, Joining::Right}, {0xFEB1, Joining::Dual},  {0xFEB5, Joining::Dual},
+    {0xFEB9, Joining::Dual},  {0xFEBD, Joining::Dual},  {0xFEC1, Joining::Dual},  {0xFEC5, Joining::Dual},
+    {0xFEC9, Joining::Dual},  {0xFECD, Joining::Dual},  {0, Joining::Dual},       {0, Joining::Dual},
+    {0, Joining::Dual},       {0, Joining::Dual},       {0, Joining::Dual},       {0, Joining::Causing},
+    {0xFED1, Joining::Dual},  {0xFED5, Joining::Dual},  {0xFED9, Joining::Dual},  {0xFEDD, Joining::Dual},
+    {0xFEE1, Joining::Dual},  {0xFEE5, Joining::Dual},  {0xFEE9, Joining::Dual},  {0xFEED, Joining::Right},
+    {0xFEEF, Joining::Right}, {0xFEF1, Joining::Dual},
+};
+
+constexpr char32_t kArabicLam = 0x0644;
+
+const ArabicLetter* FindArabicLetter(char32_t c) {
+    return c >= 0x0621 && c <= 0x064A ? &kArabicLetters[c - 0x0621] : nullptr;
+}
+
+Joining JoiningOf(char32_t c) {
+    if (const ArabicLetter* letter = FindArabicLetter(c)) {
+        return letter->joining;
+    }
+    return Classify(c) == BidiClass::NSM ? Joining::Transparent : Joining::None;
+}
+
+// lam 与 alef 的连字（独立形式，词尾形式为 +1），不是 alef 时返回 0
+char32_t LamAlefLigature(char32_t alef) {
+    switch (alef) {
+        case 0x0622: return 0xFEF5;
+        case 0x0623: return 0xFEF7;
+        case 0x0625: return 0xFEF9;
+        case 0x0627: return 0xFEFB;
+        default: return 0;
+    }
+}
+
+// ========== 整形 ==========
+
+struct Character {
+    char32_t codepoint;
+    std::uint32_t cluster;
+};
+
+bool IsDevanagariConsonant(char32_t c) {
+    return (c >= 0x0915 && c <= 0x0939) || (c >= 0x0958 && c <= 0x095F);
+}
+
+// 天城文前置元音符号 ि（U+093F）在字形顺序中位于所在音节（辅音 + 可选 nukta，virama 连接的辅音串）之前
+void ReorderDevanagari(std::vector<Character>& chars) {
+    for (std::size_t i = 1; i < chars.size(); ++i) {
+        if (chars[i].codepoint != 0x093F) {
+            continue;
+        }
+        std::size_t start = i;
+        std::size_t k = i;
+        if (k > 0 && chars[k - 1].codepoint == 0x093C) {
+            --k;
+        }
+        if (k == 0 || !IsDevanagariConsonant(chars[k - 1].codepoint)) {
+            continue;
+        }
+        start = k - 1;
+        while (start >= 2 && chars[start - 1].codepoint == 0x094D && IsDevanagariConsonant(chars[start - 2].codepoint)) {
+            start -= 2;
+        }
+        chars[i].cluster = chars[start].cluster;
+        std::rotate(chars.begin() + static_cast<std::ptrdiff_t>(start), chars.begin() + static_cast<std::ptrdiff_t>(i),
+                    chars.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+    }
+}
+
+// 为阿拉伯字母选择表现形式（逻辑顺序；不需要替换的位置为 0），返回是否包含阿拉伯字母
+bool ArabicForms(const std::vector<Character>& chars, std::vector<char32_t>& forms, std::vector<bool>& joinsPrevious) {
+    const bool hasArabic = std::any_of(chars.begin(), chars.end(), [](const Character& c) {
+        return FindArabicLetter(c.codepoint) != nullptr;
+    });
+    if (!hasArabic) {
+        return false;
+    }
+    forms.assign(chars.size(), 0);
+    joinsPrevious.assign(chars.size(), false);
+    Joining previous = Joining::None;
+    for (std::size_t i = 0; i < chars.size(); ++i) {
+        const Joining joining = JoiningOf(chars[i].codepoint);
+        if (joining == Joining::Transparent) {
+            continue;
+        }
+        Joining next = Joining::None;
+        for (std::size_t k = i + 1; k < chars.size(); ++k) {
+            next = JoiningOf(chars[k].codepoint);
+            if (next != Joining::Transparent) {
+                break;
+            }
+            next = Joining::None;
+        }
+        const bool joinsRight = joining != Joining::None &&
+                                (previous == Joining::Dual || previous == Joining::Causing);
+        const bool joinsLeft = (joining == Joining::Dual || joining == Joining::Causing) &&
+                               (next == Joining::Right || next == Joining::Dual || next == Joining::Causing);
+        joinsPrevious[i] = joinsRight;
+        const ArabicLetter* letter = FindArabicLetter(chars[i].codepoint);
+        if (letter && letter->isolated != 0) {
+            int form = 0;
+            if (joinsRight && joinsLeft && joining == Joining::Dual) {
+                form = 3;
+            } else if (joinsLeft && joining == Joining::Dual) {
+                form = 2;
+            } else if (joinsRight) {
+                form = 1;
+            }
+            forms[i] = letter->isolated + static_cast<char32_t>(form);
+        }
+        previous = joining;
+    }
+    return true;
+}
+
+// 拉丁文 f 连字（U+FB00-FB04），输出连字与消耗的字符数
+char32_t LatinLigature(const std::vector<Character>& chars, std::size_t i, std::size_t& consumed) {
+    auto at = [&](std::size_t k) { return i + k < chars.size() ? chars[i + k].codepoint : U'\0'; };
+    if (at(0) != U'f') {
+        return 0;
+    }
+    if (at(1) == U'f') {
+        if (at(2) == U'i') {
+            consumed = 3;
+            return 0xFB03;
+        }
+        if (at(2) == U'l') {
+            consumed = 3;
+            return 0xFB04;
+        }
+        consumed = 2;
+        return 0xFB00;
+    }
+    if (at(1) == U'i' || at(1) == U'l') {
+        consumed = 2;
+        return at(1) == U'i' ? 0xFB01 : 0xFB02;
+    }
+    return 0;
+}
+
+#ifdef FK_HAS_HARFBUZZ
+
+// ========== HarfBuzz 整形 ==========
+
+// 按 (字体文件, face 索引) 缓存的 HarfBuzz 字体，缩放为字体单位（upem），所有字号共享，
+// 数量受字体文件数限制（nullptr 表示加载失败）
+hb_font_t* AcquireHarfBuzzFont(const std::string& path, int faceIndex) {
+    static std::mutex mutex;
+    static std::map<std::pair<std::string, int>, hb_font_t*> fonts;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto key = std::make_pair(path, faceIndex);
+    auto it = fonts.find(key);
+    if (it != fonts.end()) {
+        return it->second;
+    }
+
+    hb_blob_t* blob = hb_blob_create_from_file(path.c_str());
+    hb_face_t* face = hb_face_create(blob, static_cast<unsigned int>(faceIndex));
+    hb_blob_destroy(blob);
+    // hb_font_create 的默认缩放即 upem，字体持有 face 的引用
+    hb_font_t* font = hb_face_get_glyph_count(face) > 0 ? hb_font_create(face) : nullptr;
+    hb_face_destroy(face);
+    fonts.emplace(std::move(key), font);
+    return font;
+}
+
+// 用 HarfBuzz 整形；来源不提供字体文件或主字体缺少字形（需要回退字体）时返回 nullptr
+std::shared_ptr<ShapedRun> ShapeWithHarfBuzz(GlyphMetricsProvider& provider, std::u32string_view text, int fontId,
+                                             ShapingFeatures features, TextDirection direction) {
+    std::string path;
+    int faceIndex = 0;
+    float fontSize = 0.0f;
+    if (text.empty() || !provider.GetFontSource(fontId, path, faceIndex, fontSize)) {
+        return nullptr;
+    }
+    hb_font_t* font = AcquireHarfBuzzFont(path, faceIndex);
+    if (!font) {
+        return nullptr;
+    }
+    // 字体单位换算为像素
+    int upem = 0;
+    hb_font_get_scale(font, &upem, nullptr);
+    const float scale = upem > 0 ? fontSize / static_cast<float>(upem) : 0.0f;
+
+    const bool rightToLeft = direction == TextDirection::RightToLeft;
+    hb_buffer_t* buffer = hb_buffer_create();
+    hb_buffer_add_utf32(buffer, reinterpret_cast<const std::uint32_t*>(text.data()), static_cast<int>(text.size()),
+                        0, static_cast<int>(text.size()));
+    hb_buffer_set_direction(buffer, rightToLeft ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
+    hb_buffer_guess_segment_properties(buffer);
+
+    // 只关闭未请求的特性，其余使用字体与文字的默认特性
+    hb_feature_t disabled[3];
+    unsigned int disabledCount = 0;
+    auto disable = [&](hb_tag_t tag) {
+        disabled[disabledCount++] = hb_feature_t{tag, 0, HB_FEATURE_GLOBAL_START, HB_FEATURE_GLOBAL_END};
+    };
+    if (!HasFeature(features, ShapingFeatures::Kerning)) {
+        disable(HB_TAG('k', 'e', 'r', 'n'));
+    }
+    if (!HasFeature(features, ShapingFeatures::Ligatures)) {
+        disable(HB_TAG('l', 'i', 'g', 'a'));
+        disable(HB_TAG('c', 'l', 'i', 'g'));
+    }
+    hb_shape(font, buffer, disabled, disabledCount);
+
+    unsigned int count = 0;
+    const hb_glyph_info_t* infos = hb_buffer_get_glyph_infos(buffer, &count);
+    const hb_glyph_position_t* positions = hb_buffer_get_glyph_positions(buffer, &count);
+
+    auto run = std::make_shared<ShapedRun>();
+    auto& glyphs = run->glyphs;
+    glyphs.reserve(count);
+    bool complete = true;
+    for (unsigned int k = 0; k < count; ++k) {
+        // 从右到左时 HarfBuzz 输出视觉顺序，反转为逻辑顺序
+        const unsigned int i = rightToLeft ? count - 1 - k : k;
+        if (infos[i].codepoint == 0) {
+            complete = false;
+            break;
+        }
+        ShapedGlyph glyph;
+        glyph.codepoint = kGlyphIndexFlag | static_cast<char32_t>(infos[i].codepoint);
+        glyph.fontId = fontId;
+        glyph.advance = static_cast<float>(positions[i].x_advance) * scale;
+        glyph.cluster = infos[i].cluster;
+        // HarfBuzz 的 y 轴向上
+        glyph.xOffset = static_cast<float>(positions[i].x_offset) * scale;
+        glyph.yOffset = -static_cast<float>(positions[i].y_offset) * scale;
+        glyphs.push_back(glyph);
+    }
+    hb_buffer_destroy(buffer);
+    if (!complete) {
+        return nullptr;
+    }
+
+    // 独占一个字符且就是该字符默认字形的，恢复为码点（与内置整形共享字形缓存，空格仍可识别）
+    for (std::size_t i = 0; i < glyphs.size(); ++i) {
+        const std::uint32_t cluster = glyphs[i].cluster;
+        const bool sharesCluster = (i > 0 && glyphs[i - 1].cluster == cluster) ||
+                                   (i + 1 < glyphs.size() && glyphs[i + 1].cluster == cluster);
+        const std::size_t clusterEnd = i + 1 < glyphs.size() ? glyphs[i + 1].cluster : text.size();
+        hb_codepoint_t nominal = 0;
+        if (!sharesCluster && clusterEnd == cluster + 1 &&
+            hb_font_get_nominal_glyph(font, text[cluster], &nominal) &&
+            nominal == GlyphIndexOf(glyphs[i].codepoint)) {
+            glyphs[i].codepoint = text[cluster];
+        }
+        run->width += glyphs[i].advance;
+    }
+    return run;
+}
+
+#endif
+
+} // namespace
+
+// ========== 双向文本 ==========
+
+std::vector<BidiRun> ItemizeBidi(std::u32string_view paragraph, TextDirection& baseDirection,
+                                 std::vector<std::uint8_t>& levels) {
+    const std::size_t count = paragraph.size();
+    std::vector<BidiRun> runs;
+    levels.assign(count, 0);
+
+    // P2/P3：段落方向取第一个强方向字符；全部为 L 与中性字符时不需要后续步骤
+    std::vector<BidiClass> classes(count);
+    baseDirection = TextDirection::LeftToRight;
+    bool foundStrong = false;
+    bool hasRightToLeft = false;
+    for (std::size_t i = 0; i < count; ++i) {
+        classes[i] = Classify(paragraph[i]);
+        const bool rightToLeft = classes[i] == BidiClass::R || classes[i] == BidiClass::AL;
+        if (!foundStrong && (rightToLeft || classes[i] == BidiClass::L)) {
+            baseDirection = rightToLeft ? TextDirection::RightToLeft : TextDirection::LeftToRight;
+            foundStrong = true;
+        }
+        hasRightToLeft = hasRightToLeft || rightToLeft || classes[i] == BidiClass::AN;
+    }
+    if (!hasRightToLeft) {
+        if (count > 0) {
+            runs.push_back(BidiRun{0, static_cast<std::uint32_t>(count), 0});
+        }
+        return runs;
+    }
+
+    const std::uint8_t baseLevel = baseDirection == TextDirection::RightToLeft ? 1 : 0;
+    const BidiClass sor = baseLevel != 0 ? BidiClass::R : BidiClass::L;
+
+    // W1-W3：组合标记取前一个字符的类别；阿拉伯字母之后的欧洲数字为阿拉伯数字；AL 视为 R
+    BidiClass previous = sor;
+    BidiClass lastStrong = sor;
+    for (std::size_t i = 0; i < count; ++i) {
+        BidiClass& value = classes[i];
+        if (value == BidiClass::NSM) {
+            value = previous;
+        }
+        if (value == BidiClass::EN && lastStrong == BidiClass::AL) {
+            value = BidiClass::AN;
+        }
+        if (value == BidiClass::L || value == BidiClass::R || value == BidiClass::AL) {
+            lastStrong = value;
+        }
+        previous = value;
+    }
+    for (auto& value : classes) {
+        if (value == BidiClass::AL) {
+            value = BidiClass::R;
+        }
+    }
+
+    // W4：两个同类数字之间的单个分隔符取数字类别
+    for (std::size_t i = 1; i + 1 < count; ++i) {
+        const BidiClass before = classes[i - 1];
+        const BidiClass after = classes[i + 1];
+        if (classes[i] == BidiClass::ES && before == BidiClass::EN && after == BidiClass::EN) {
+            classes[i] = BidiClass::EN;
+        } else if (classes[i] == BidiClass::CS && before == after &&
+                   (before == BidiClass::EN || before == BidiClass::AN)) {
+            classes[i] = before;
+        }
+    }
+
+    // W5：与欧洲数字相邻的终止符序列为欧洲数字；W6：其余分隔符与终止符为中性
+    for (std::size_t i = 0; i < count;) {
+        if (classes[i] != BidiClass::ET) {
+            ++i;
+            continue;
+        }
+        std::size_t end = i;
+        while (end < count && classes[end] == BidiClass::ET) {
+            ++end;
+        }
+        const bool adjacent = (i > 0 && classes[i - 1] == BidiClass::EN) || (end < count && classes[end] == BidiClass::EN);
+        std::fill(classes.begin() + static_cast<std::ptrdiff_t>(i), classes.begin() + static_cast<std::ptrdiff_t>(end),
+                  adjacent ? BidiClass::EN : BidiClass::ON);
+        i = end;
+    }
+    for (auto& value : classes) {
+        if (value == BidiClass::ES || value == BidiClass::CS) {
+            value = BidiClass::ON;
+        }
+    }
+
+    // W7：前一个强方向为 L 的欧洲数字视为 L
+    lastStrong = sor;
+    for (auto& value : classes) {
+        if (value == BidiClass::L || value == BidiClass::R) {
+            lastStrong = value;
+        } else if (value == BidiClass::EN && lastStrong == BidiClass::L) {
+            value = BidiClass::L;
+        }
+    }
+
+    // N1/N2：中性字符序列两侧方向相同时取该方向，否则取段落方向
+    for (std::size_t i = 0; i < count;) {
+        if (!IsNeutral(classes[i])) {
+            ++i;
+            continue;
+        }
+        std::size_t end = i;
+        while (end < count && IsNeutral(classes[end])) {
+            ++end;
+        }
+        const BidiClass before = i > 0 ? StrongDirection(classes[i - 1]) : sor;
+        const BidiClass after = end < count ? StrongDirection(classes[end]) : sor;
+        std::fill(classes.begin() + static_cast<std::ptrdiff_t>(i), classes.begin() + static_cast<std::ptrdiff_t>(end),
+                  before == after ? before : sor);
+        i = end;
+    }
+
+    // I1/I2：解析嵌入层级
+    for (std::size_t i = 0; i < count; ++i) {
+        const BidiClass value = classes[i];
+        if (baseLevel == 0) {
+            levels[i] = value == BidiClass::R ? 1 : (value == BidiClass::L ? 0 : 2);
+        } else {
+            levels[i] = value == BidiClass::R ? 1 : 2;
+        }
+    }
+
+    for (std::size_t i = 0; i < count;) {
+        std::size_t end = i + 1;
+        while (end < count && levels[end] == levels[i]) {
+            ++end;
+        }
+        runs.push_back(BidiRun{static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(end - i), levels[i]});
+        i = end;
+    }
+    return runs;
+}
+
+void ReorderByLevels(const std::vector<std::uint8_t>& levels, std::vector<std::uint32_t>& order) {
+    order.resize(levels.size());
+    std::iota(order.begin(), order.end(), 0u);
+    if (levels.empty()) {
+        return;
+    }
+    const auto [lowest, highest] = std::minmax_element(levels.begin(), levels.end());
+    const std::uint8_t lowestOdd = static_cast<std::uint8_t>(*lowest | 1);
+
+    // 从最高层级到最低奇数层级，依次反转层级不低于当前值的连续序列
+    for (int level = *highest; level >= lowestOdd; --level) {
+        for (std::size_t i = 0; i < order.size();) {
+            if (levels[order[i]] < level) {
+                ++i;
+                continue;
+            }
+            std::size_t end = i;
+            while (end < order.size() && levels[order[end]] >= level) {
+                ++end;
+            }
+            std::reverse(order.begin() + static_cast<std::ptrdiff_t>(i), order.begin() + static_cast<std::ptrdiff_t>(end));
+            i = end;
+        }
+    }
+}
+
+// ========== ShapeRunCache ==========
+
+std::size_t ShapeRunCache::KeyHash::operator()(const Key& key) const {
+    std::size_t hash = std::hash<std::u32string_view>{}(key.text);
+    hash ^= (static_cast<std::size_t>(static_cast<std::uint32_t>(key.fontId)) << 8) ^
+            (static_cast<std::size_t>(key.features) << 2) ^ static_cast<std::size_t>(key.direction);
+    return hash;
+}
+
+ShapeRunCache::ShapeRunCache(std::size_t capacity)
+    : capacity_(capacity) {
+}
+
+std::shared_ptr<const ShapedRun> ShapeRunCache::Shape(GlyphMetricsProvider& provider, std::u32string_view text,
+                                                      int fontId, ShapingFeatures features, TextDirection direction) {
+    if (capacity_ == 0) {
+        ++misses_;
+        return ShapeUncached(provider, text, fontId, features, direction);
+    }
+
+    auto it = index_.find(Key{text, fontId, features, direction});
+    if (it != index_.end()) {
+        ++hits_;
+        entries_.splice(entries_.end(), entries_, it->second);
+        return it->second->run;
+    }
+
+    ++misses_;
+    std::shared_ptr<const ShapedRun> run = ShapeUncached(provider, text, fontId, features, direction);
+    auto& entry = entries_.emplace_back(Entry{std::u32string(text), Key{}, run});
+    entry.key = Key{entry.text, fontId, features, direction};
+    index_.emplace(entry.key, std::prev(entries_.end()));
+    Evict();
+    return run;
+}
+
+std::shared_ptr<ShapedRun> ShapeRunCache::ShapeUncached(GlyphMetricsProvider& provider, std::u32string_view text,
+                                                        int fontId, ShapingFeatures features, TextDirection direction) {
+#ifdef FK_HAS_HARFBUZZ
+    if (auto shaped = ShapeWithHarfBuzz(provider, text, fontId, features, direction)) {
+        return shaped;
+    }
+#endif
+
+    auto run = std::make_shared<ShapedRun>();
+    const bool rightToLeft = direction == TextDirection::RightToLeft;
+    const bool ligatures = HasFeature(features, ShapingFeatures::Ligatures);
+    const bool kerning = HasFeature(features, ShapingFeatures::Kerning);
+
+    std::vector<Character> chars(text.size());
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        chars[i] = Character{rightToLeft ? MirrorCodepoint(text[i]) : text[i], static_cast<std::uint32_t>(i)};
+    }
+    ReorderDevanagari(chars);
+    std::vector<char32_t> forms;
+    std::vector<bool> joinsPrevious;
+    const bool arabic = ArabicForms(chars, forms, joinsPrevious);
+
+    auto& glyphs = run->glyphs;
+    glyphs.reserve(chars.size());
+    for (std::size_t i = 0; i < chars.size();) {
+        const char32_t c = chars[i].codepoint;
+        ShapedGlyph glyph;
+        glyph.cluster = chars[i].cluster;
+        if (!provider.GetGlyphAdvance(c, fontId, glyph.fontId, glyph.advance)) {
+            ++i;
+            continue;  // 跳过无法加载的字符
+        }
+        glyph.codepoint = c;
+
+        // 表现形式与连字只在与原字符同一字体中存在时使用
+        std::size_t consumed = 1;
+        char32_t substitute = 0;
+        if (arabic && ligatures && c == kArabicLam && i + 1 < chars.size() &&
+            LamAlefLigature(chars[i + 1].codepoint) != 0) {
+            substitute = LamAlefLigature(chars[i + 1].codepoint) + (joinsPrevious[i] ? 1 : 0);
+            consumed = 2;
+        } else if (arabic && forms[i] != 0) {
+            substitute = forms[i];
+        } else if (ligatures && !rightToLeft) {
+            substitute = LatinLigature(chars, i, consumed);
+        }
+        int substituteFont = -1;
+        float substituteAdvance = 0.0f;
+        if (substitute != 0 && provider.GetGlyphAdvance(substitute, fontId, substituteFont, substituteAdvance) &&
+            substituteFont == glyph.fontId) {
+            glyph.codepoint = substitute;
+            glyph.advance = substituteAdvance;
+            i += consumed;
+        } else {
+            ++i;
+        }
+
+        // 字距调整作用于视觉上靠左的字形
+        if (kerning && !glyphs.empty() && glyphs.back().fontId == glyph.fontId) {
+            ShapedGlyph& previous = glyphs.back();
+            if (rightToLeft) {
+                glyph.advance += provider.GetKerning(glyph.fontId, glyph.codepoint, previous.codepoint);
+            } else {
+                previous.advance += provider.GetKerning(glyph.fontId, previous.codepoint, glyph.codepoint);
+            }
+        }
+        glyphs.push_back(glyph);
+    }
+
+    for (const auto& glyph : glyphs) {
+        run->width += glyph.advance;
+    }
+    return run;
+}
+
+void ShapeRunCache::SetCapacity(std::size_t capacity) {
+    capacity_ = capacity;
+    Evict();
+}
+
+void ShapeRunCache::Clear() {
+    index_.clear();
+    entries_.clear();
+}
+
+void ShapeRunCache::Evict() {
+    while (entries_.size() > capacity_) {
+        index_.erase(entries_.front().key);
+        entries_.pop_front();
+    }
+}
+
+} // namespace fk::render
@@ -0,0 +1,165 @@
+#include "fk/render/TextureManager.h"
+
+#include <utility>
+#include <vector>
+
+namespace fk::render {
+
+TextureManager& TextureManager::Instance() {
+    static TextureManager instance;
+    return instance;
+}
+
+void TextureManager::Register(std::uint32_t textureId, std::size_t bytes, ReleaseCallback release) {
+    if (textureId == 0) {
+        return;
+    }
+
+    auto [it, inserted] = entries_.try_emplace(textureId);
+    auto& entry = it->second;
+    if (inserted) {
+        entry.lruPosition = lru_.insert(lru_.end(), textureId);
+    } else {
+        // 纹理 ID 被重新使用（旧纹理已由所有者删除）
+        residentBytes_ -= entry.bytes;
+        lru_.splice(lru_.end(), lru_, entry.lruPosition);
+        entry.retired = false;
+    }
+    entry.bytes = bytes;
+    entry.lastUsedFrame = frame_;
+    entry.release = std::move(release);
+    residentBytes_ += bytes;
+}
+
+void TextureManager::Unregister(std::uint32_t textureId) {
+    auto it = entries_.find(textureId);
+    if (it == entries_.end()) {
+        return;
+    }
+    residentBytes_ -= it->second.bytes;
+    lru_.erase(it->second.lruPosition);
+    entries_.erase(it);
+}
+
+void TextureManager::Retire(std::uint32_t textureId) {
+    auto it = entries_.find(textureId);
+    if (it == entries_.end()) {
+        return;
+    }
+    if (it->second.refCount > 0) {
+        it->second.retired = true;
+        return;
+    }
+    Erase(it, false);
+}
+
+void TextureManager::AddRef(std::uint32_t textureId) {
+    auto it = entries_.find(textureId);
+    if (it != entries_.end()) {
+        ++it->second.refCount;
+    }
+}
+
+void TextureManager::Release(std::uint32_t textureId) {
+    auto it = entries_.find(textureId);
+    if (it == entries_.end() || it->second.refCount == 0) {
+        return;
+    }
+    if (--it->second.refCount == 0 && it->second.retired) {
+        Erase(it, false);
+    }
+}
+
+void TextureManager::Touch(std::uint32_t textureId) {
+    auto it = entries_.find(textureId);
+    if (it == entries_.end()) {
+        return;
+    }
+    auto& entry = it->second;
+    if (entry.lastUsedFrame != frame_) {
+        entry.lastUsedFrame = frame_;
+        lru_.splice(lru_.end(), lru_, entry.lruPosition);
+    }
+}
+
+void TextureManager::RecordUpload(std::size_t bytes) {
+    uploadBytesThisFrame_ += bytes;
+    uploadBytesTotal_ += bytes;
+}
+
+void TextureManager::EndFrame() {
+    Trim();
+    uploadBytesLastFrame_ = uploadBytesThisFrame_;
+    uploadBytesThisFrame_ = 0;
+    ++frame_;
+}
+
+std::size_t TextureManager::Trim() {
+    if (residentBytes_ <= budget_) {
+        return 0;
+    }
+
+    // 先选出淘汰对象再逐个释放：回调中所有者可能调用 Unregister 等方法
+    std::vector<std::uint32_t> victims;
+    std::size_t remaining = residentBytes_;
+    for (auto id : lru_) {
+        if (remaining <= budget_) {
+            break;
+        }
+        const auto& entry = entries_.find(id)->second;
+        if (entry.lastUsedFrame == frame_) {
+            // 之后的纹理都在当前帧使用过
+            break;
+        }
+        if (entry.refCount > 0) {
+            continue;
+        }
+        victims.push_back(id);
+        remaining -= entry.bytes;
+    }
+
+    std::size_t evicted = 0;
+    for (auto id : victims) {
+        auto it = entries_.find(id);
+        if (it != entries_.end()) {
+            Erase(it, true);
+            ++evicted;
+        }
+    }
+    return evicted;
+}
+
+TextureStatistics TextureManager::GetStatistics() const {
+    TextureStatistics stats;
+    stats.residentBytes = residentBytes_;
+    stats.budgetBytes = budget_;
+    stats.textureCount = entries_.size();
+    for (const auto& [id, entry] : entries_) {
+        if (entry.refCount > 0) {
+            ++stats.pinnedCount;
+        }
+    }
+    stats.evictions = evictions_;
+    stats.evictedBytes = evictedBytes_;
+    stats.uploadBytesLastFrame = uploadBytesLastFrame_;
+    stats.uploadBytesTotal = uploadBytesTotal_;
+    return stats;
+}
+
+void TextureManager::Erase(std::unordered_map<std::uint32_t, Entry>::iterator it, bool evicted) {
+    const std::uint32_t textureId = it->first;
+    auto release = std::move(it->second.release);
+    residentBytes_ -= it->second.bytes;
+    if (evicted) {
+        ++evictions_;
+        evictedBytes_ += it->second.bytes;
+    }
+    lru_.erase(it->second.lruPosition);
+    entries_.erase(it);
+
+    if (release) {
+        release(textureId);
+    }
+}
+
+} // namespace fk::render
@@ -1,14 +1,20 @@
 #include "fk/ui/Window.h"
+#include "fk/ui/base/LayoutManager.h"
 #include "fk/ui/graphics/Brush.h"
 #include "fk/render/DrawCommand.h"
 #include "fk/ui/input/InputManager.h"
 #include "fk/ui/input/FocusManager.h"
 #include "fk/ui/text/TextBlock.h"
 #include "fk/render/GlRenderer.h"
+#include "fk/render/SoftwareRenderer.h"
 #include "fk/render/RenderList.h"
 #include "fk/render/RenderContext.h"
+#include "fk/render/DamageRegion.h"
 #include "fk/render/TextRenderer.h"
+#include "fk/render/ImageCache.h"
 #include "fk/ui/PopupService.h"
+#include "fk/binding/BindingUpdateQueue.h"
+#include "fk/binding/PropertyChangedMarshaller.h"
 
 #ifdef FK_HAS_GLFW
 #include <GLFW/glfw3.h>
@@ -171,6 +177,8 @@ Window::Window() {
     // 初始化渲染系统（仅在支持OpenGL时）
 #ifdef FK_HAS_OPENGL
     renderList_ = std::make_unique<render::RenderList>();
+    previousRenderList_ = std::make_unique<render::RenderList>();
+    damageRegion_ = std::make_unique<render::DamageRegion>();
     renderer_ = std::make_unique<render::GlRenderer>();
 #endif
     
@@ -189,6 +197,12 @@ Window::Window() {
 }
 
 Window::~Window() {
+    // 渲染器随窗口销毁，不再作为 TextBlock 的字形度量来源
+    if (renderer_ && renderer_->GetGlyphMetrics() &&
+        TextBlock::GetGlobalGlyphMetrics() == renderer_->GetGlyphMetrics()) {
+        TextBlock::SetGlobalGlyphMetrics(nullptr);
+    }
+    
     if (nativeHandle_) {
 #ifdef FK_HAS_GLFW
         GLFWwindow* window = static_cast<GLFWwindow*>(nativeHandle_);
@@ -244,8 +258,8 @@ void Window::Show() {
         return; // 模态窗口不能用 Show()
     }
     
-    // 创建窗口（如果还未创建）
-    if (!nativeHandle_) {
+    // 创建窗口（如果还未创建；无头窗口没有原生窗口）
+    if (!nativeHandle_ && !headless_) {
 #ifdef FK_HAS_GLFW
         if (!InitializeGLFW()) {
             std::cerr << "Cannot create window: GLFW not initialized" << std::endl;
@@ -522,6 +536,11 @@ void Window::Hide() {
 }
 
 bool Window::ProcessEvents() {
+    if (headless_) {
+        // 无头窗口没有原生事件，也不做帧率限制
+        return isVisible_ && !isClosing_;
+    }
+    
 #ifdef FK_HAS_GLFW
     if (!nativeHandle_) {
         return false;
@@ -572,6 +591,14 @@ bool Window::ProcessEvents() {
 }
 
 void Window::RenderFrame() {
+    if (headless_) {
+        // 无头模式：渲染到软件帧缓冲，尺寸取 Width / Height 属性
+        if (isVisible_) {
+            RenderContent(static_cast<int>(GetWidth()), static_cast<int>(GetHeight()));
+        }
+        return;
+    }
+    
 #ifdef FK_HAS_GLFW
     if (!nativeHandle_) {
         return;
@@ -587,97 +614,13 @@ void Window::RenderFrame() {
     glfwGetFramebufferSize(window, &width, &height);
     
 #ifdef FK_HAS_OPENGL
-    // 设置视口
+    // 设置视口（清屏由渲染器负责，脏矩形重绘时只清除损坏区域）
     glViewport(0, 0, width, height);
-    
-    // 清除屏幕
-    glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
 #endif
     
     // 渲染UI内容
 #ifdef FK_HAS_OPENGL
-    if (renderer_ && renderList_) {
-        // 初始化渲染器（如果还没初始化�?
-        if (!renderer_->IsInitialized()) {
-            render::RendererInitParams params;
-            params.initialSize.width = static_cast<std::uint32_t>(width);
-            params.initialSize.height = static_cast<std::uint32_t>(height);
-            renderer_->Initialize(params);
-            
-            // 设置全局 TextRenderer，供 TextBlock �?Measure 阶段使用
-            TextBlock::SetGlobalTextRenderer(renderer_->GetTextRenderer());
-            
-            // 记录初始视口大小
-            lastViewportWidth_ = width;
-            lastViewportHeight_ = height;
-        }
-        
-        // 只在窗口大小改变时更新渲染器视口（性能优化�?
-        if (width != lastViewportWidth_ || height != lastViewportHeight_) {
-            render::Extent2D newSize{
-                static_cast<std::uint32_t>(width),
-                static_cast<std::uint32_t>(height)
-            };
-            renderer_->Resize(newSize);
-            
-            // 更新缓存的视口大�?
-            lastViewportWidth_ = width;
-            lastViewportHeight_ = height;
-        }
-        
-        // 清空渲染命令列表
-        renderList_->Clear();
-        
-        // 创建渲染上下�?
-        render::RenderContext context(renderList_.get(), renderer_->GetTextRenderer());
-        
-
-        
-        // 从Content开始收集绘制命�? 
-        auto content = GetContent();
-        
-        if (content.has_value() && content.type() == typeid(UIElement*)) {
-            auto* element = std::any_cast<UIElement*>(content);
-            
-            if (element) {
-                // 执行布局
-                auto availableSize = Size(static_cast<float>(width), static_cast<float>(height));
-                element->Measure(availableSize);
-                
-                // 从左上角开始布局（移除居中逻辑�?
-                element->Arrange(Rect(0, 0, static_cast<float>(width), static_cast<float>(height)));
-                
-                // 收集绘制命令（不需要额外的变换偏移�?
-                element->CollectDrawCommands(context);
-            }
-        }
-        
-        // 渲染所有命�?
-        render::FrameContext frameCtx;
-        frameCtx.elapsedSeconds = 0.0;
-        frameCtx.deltaSeconds = 0.016;
-        
-        // �?Window �?Background 属性读取清除颜�?
-        auto* background = GetBackground();
-        if (background) {
-            // 尝试转换�?SolidColorBrush
-            if (auto* solidBrush = dynamic_cast<SolidColorBrush*>(background)) {
-                Color color = solidBrush->GetColor();
-                frameCtx.clearColor = {color.r, color.g, color.b, color.a};
-            } else {
-                // 其他类型的画刷，使用默认浅灰色背�?
-                frameCtx.clearColor = {0.94f, 0.94f, 0.94f, 1.0f};
-            }
-        } else {
-            // 没有设置背景，使用默认浅灰色背景
-            frameCtx.clearColor = {0.94f, 0.94f, 0.94f, 1.0f};
-        }
-        
-        renderer_->BeginFrame(frameCtx);
-        renderer_->Draw(*renderList_);
-        renderer_->EndFrame();
-    }
+    RenderContent(width, height);
 #endif
     
     // 交换缓冲�?
@@ -703,6 +646,256 @@ void Window::RenderFrame() {
 #endif
 }
 
+void Window::RenderContent(int width, int height) {
+    if (!renderer_ || !renderList_) {
+        return;
+    }
+    
+    // 初始化渲染器（如果还没初始化�?
+    if (!renderer_->IsInitialized()) {
+        render::RendererInitParams params;
+        params.initialSize.width = static_cast<std::uint32_t>(width);
+        params.initialSize.height = static_cast<std::uint32_t>(height);
+        params.glyphRenderMode = glyphRenderMode_;
+        renderer_->Initialize(params);
+        
+        // 设置全局 TextRenderer，供 TextBlock 在 Measure 阶段使用
+        // Phase 5.1: 软件渲染器没有 TextRenderer，TextBlock 使用它的字形缓存排版
+        if (auto* textRenderer = renderer_->GetTextRenderer()) {
+            TextBlock::SetGlobalTextRenderer(textRenderer);
+        } else if (auto* glyphMetrics = renderer_->GetGlyphMetrics()) {
+            TextBlock::SetGlobalGlyphMetrics(glyphMetrics);
+        }
+        
+        // 记录初始视口大小
+        lastViewportWidth_ = width;
+        lastViewportHeight_ = height;
+        needsFullRedraw_ = true;
+    }
+    
+    // 只在窗口大小改变时更新渲染器视口（性能优化�?
+    if (width != lastViewportWidth_ || height != lastViewportHeight_) {
+        render::Extent2D newSize{
+            static_cast<std::uint32_t>(width),
+            static_cast<std::uint32_t>(height)
+        };
+        renderer_->Resize(newSize);
+        
+        // 更新缓存的视口大�?
+        lastViewportWidth_ = width;
+        lastViewportHeight_ = height;
+        needsFullRedraw_ = true;
+    }
+    
+    // 布局前投递工作线程的属性通知并执行本帧排队的绑定更新，使布局看到最新的值
+    auto& notifications = binding::PropertyChangedMarshaller::Instance();
+    if (notifications.HasPendingNotifications() && notifications.HasThreadAccess()) {
+        notifications.Flush();
+    }
+    auto& bindingUpdates = binding::BindingUpdateQueue::Instance();
+    if (bindingUpdates.HasPendingUpdates() && bindingUpdates.HasThreadAccess()) {
+        bindingUpdates.Flush();
+    }
+    
+    // Phase 5.1: 在本帧上传预算内继续上传解码完成的图像（完成的图像在布局前使其元素重绘）
+    // 软件渲染器（无头模式）没有 OpenGL 上下文
+    if (!headless_) {
+        auto& images = render::ImageCache::Instance();
+        if (images.HasPendingUploads()) {
+            images.ProcessUploads();
+        }
+    }
+
+    // 从Content开始执行布局并收集绘制命令
+    UIElement* element = nullptr;
+    auto content = GetContent();
+    if (content.has_value() && content.type() == typeid(UIElement*)) {
+        element = std::any_cast<UIElement*>(content);
+    }
+    
+    if (element) {
+        // 执行布局
+        auto availableSize = Size(static_cast<float>(width), static_cast<float>(height));
+        element->Measure(availableSize);
+        
+        // 从左上角开始布局
+        element->Arrange(Rect(0, 0, static_cast<float>(width), static_cast<float>(height)));
+    }
+    
+    // Phase 5.1: 处理排队的局部布局（根元素不脏且尺寸未变时上面两步直接跳过）
+    LayoutManager::Instance().UpdateLayout();
+    
+    // Phase 5.1: 保留式渲染列表
+    // 内容树没有任何变化时直接沿用上一帧的命令列表；否则交换双缓冲，
+    // 未变化的子树从上一帧列表中按区间复制，只有脏子树重新生成命令
+    // 收集过程中同时记录损坏区域：变化元素的旧包围盒与新包围盒
+    damageRegion_->Reset(static_cast<float>(width), static_cast<float>(height));
+    if (element != lastRenderedRoot_) {
+        needsFullRedraw_ = true;
+    }
+    
+    bool reuseList = element && element == lastRenderedRoot_ && !element->IsRenderDirty();
+    if (!reuseList) {
+        std::swap(renderList_, previousRenderList_);
+        renderList_->Clear();
+        
+        render::RenderContext context(renderList_.get(), renderer_->GetTextRenderer());
+        context.SetPreviousFrame(previousRenderList_.get());
+        context.SetDamageRegion(damageRegion_.get());
+        
+        if (element) {
+            // 收集绘制命令（不需要额外的变换偏移）
+            element->CollectDrawCommands(context);
+        }
+        lastRenderedRoot_ = element;
+        
+        // 连续的同类绘制命令分组，渲染器据此合并绘制调用
+        renderList_->BuildBatches();
+    }
+    
+    // 渲染所有命�?
+    render::FrameContext frameCtx;
+    frameCtx.elapsedSeconds = 0.0;
+    frameCtx.deltaSeconds = 0.016;
+    
+    // �?Window �?Background 属性读取清除颜�?
+    auto* background = GetBackground();
+    if (background) {
+        // 尝试转换�?SolidColorBrush
+        if (auto* solidBrush = dynamic_cast<SolidColorBrush*>(background)) {
+            Color color = solidBrush->GetColor();
+            frameCtx.clearColor = {color.r, color.g, color.b, color.a};
+        } else {
+            // 其他类型的画刷，使用默认浅灰色背�?
+            frameCtx.clearColor = {0.94f, 0.94f, 0.94f, 1.0f};
+        }
+    } else {
+        // 没有设置背景，使用默认浅灰色背景
+        frameCtx.clearColor = {0.94f, 0.94f, 0.94f, 1.0f};
+    }
+    
+    // 背景色变化会影响所有未覆盖的像素
+    if (frameCtx.clearColor != lastClearColor_) {
+        lastClearColor_ = frameCtx.clearColor;
+        needsFullRedraw_ = true;
+    }
+    
+    if (needsFullRedraw_) {
+        damageRegion_->AddFull();
+    }
+    damageRegion_->Merge();
+    frameCtx.fullRedraw = damageRegion_->IsFull();
+    frameCtx.damageRects = damageRegion_->GetRects();
+    needsFullRedraw_ = false;
+    
+    renderer_->BeginFrame(frameCtx);
+    renderer_->Draw(*renderList_);
+    renderer_->EndFrame();
+}
+
+bool Window::NeedsRender() const {
+    if (headless_) {
+        if (!isVisible_) {
+            return false;
+        }
+        if (!renderer_->IsInitialized()) {
+            return true;
+        }
+        if (static_cast<int>(GetWidth()) != lastViewportWidth_ ||
+            static_cast<int>(GetHeight()) != lastViewportHeight_) {
+            return true;
+        }
+        return IsContentDirty();
+    }
+    
+#ifdef FK_HAS_GLFW
+    if (!nativeHandle_) {
+        return false;
+    }
+    
+#ifdef FK_HAS_OPENGL
+    if (!renderer_ || !renderer_->IsInitialized()) {
+        return true;
+    }
+#endif
+    
+    // 帧缓冲尺寸变化
+    int width = 0, height = 0;
+    glfwGetFramebufferSize(static_cast<GLFWwindow*>(nativeHandle_), &width, &height);
+    if (width != lastViewportWidth_ || height != lastViewportHeight_) {
+        return true;
+    }
+    
+    // Popup 有独立的渲染流程，打开时保守地持续渲染
+    if (!PopupService::Instance().GetActivePopups().empty()) {
+        return true;
+    }
+    
+    // 图像纹理分批上传，每帧上传一部分
+    if (render::ImageCache::Instance().HasPendingUploads()) {
+        return true;
+    }
+    
+    return IsContentDirty();
+#else
+    // 模拟窗口没有真实渲染，按固定帧率运行
+    return nativeHandle_ != nullptr;
+#endif
+}
+
+bool Window::IsContentDirty() const {
+    // 内容根变化或内容树有脏节点
+    UIElement* element = nullptr;
+    auto content = GetContent();
+    if (content.has_value() && content.type() == typeid(UIElement*)) {
+        element = std::any_cast<UIElement*>(content);
+    }
+    if (element != lastRenderedRoot_) {
+        return true;
+    }
+    return element && element->IsRenderDirty();
+}
+
+void Window::SetHeadless(bool headless) {
+    if (headless == headless_) {
+        return;
+    }
+    if (nativeHandle_ || isVisible_) {
+        std::cerr << "Window::SetHeadless must be called before Show()" << std::endl;
+        return;
+    }
+    
+    headless_ = headless;
+    if (headless_) {
+        renderer_ = std::make_unique<render::SoftwareRenderer>();
+        if (!renderList_) {
+            renderList_ = std::make_unique<render::RenderList>();
+            previousRenderList_ = std::make_unique<render::RenderList>();
+            damageRegion_ = std::make_unique<render::DamageRegion>();
+        }
+    } else {
+#ifdef FK_HAS_OPENGL
+        renderer_ = std::make_unique<render::GlRenderer>();
+#else
+        renderer_.reset();
+#endif
+    }
+    lastRenderedRoot_ = nullptr;
+    needsFullRedraw_ = true;
+}
+
+render::SoftwareRenderer* Window::GetHeadlessRenderer() const {
+    return headless_ ? static_cast<render::SoftwareRenderer*>(renderer_.get()) : nullptr;
+}
+
+void Window::SetGlyphRenderMode(render::GlyphRenderMode mode) {
+    if (renderer_ && renderer_->IsInitialized()) {
+        std::cerr << "Window::SetGlyphRenderMode must be called before the first render" << std::endl;
+        return;
+    }
+    glyphRenderMode_ = mode;
+}
+
 UIElement* Window::FindName(const std::string& name) {
     if (name.empty()) {
         return nullptr;
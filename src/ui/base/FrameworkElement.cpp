@@ -9,6 +9,7 @@
 #include "fk/ui/Window.h"
 #include "fk/ui/layouts/StackPanel.h"
 #include "fk/ui/layouts/Grid.h"
+#include "fk/ui/layouts/VirtualizingStackPanel.h"
 #include "fk/ui/graphics/Shape.h"
 #include "fk/ui/controls/Popup.h"
 
@@ -162,6 +163,7 @@ template class fk::ui::FrameworkElement<fk::ui::Button>;
 template class fk::ui::FrameworkElement<fk::ui::Window>;
 template class fk::ui::FrameworkElement<fk::ui::StackPanel>;
 template class fk::ui::FrameworkElement<fk::ui::Grid>;
+template class fk::ui::FrameworkElement<fk::ui::VirtualizingStackPanel>;
 // Shape 现在是模板类，需要实例化具体�?Shape 子类
 template class fk::ui::FrameworkElement<fk::ui::Rectangle>;
 template class fk::ui::FrameworkElement<fk::ui::Ellipse>;
@@ -0,0 +1,171 @@
+#include "fk/ui/base/LayoutManager.h"
+#include "fk/ui/base/UIElement.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace fk::ui {
+
+namespace {
+
+// 单次 UpdateLayout 中测量/排列循环的最大轮数，防止布局振荡导致死循环
+constexpr int kMaxLayoutPasses = 64;
+
+UIElement* GetParentElement(UIElement* element) {
+    return dynamic_cast<UIElement*>(element->GetVisualParent());
+}
+
+} // namespace
+
+LayoutManager& LayoutManager::Instance() {
+    static LayoutManager instance;
+    return instance;
+}
+
+void LayoutManager::EnqueueMeasure(UIElement* element) {
+    if (!element || element->inMeasureQueue_) {
+        return;
+    }
+    element->inMeasureQueue_ = true;
+    measureQueue_.push_back(element);
+}
+
+void LayoutManager::EnqueueArrange(UIElement* element) {
+    if (!element || element->inArrangeQueue_) {
+        return;
+    }
+    element->inArrangeQueue_ = true;
+    arrangeQueue_.push_back(element);
+}
+
+void LayoutManager::Remove(UIElement* element) {
+    if (element->inMeasureQueue_) {
+        std::erase(measureQueue_, element);
+        element->inMeasureQueue_ = false;
+    }
+    if (element->inArrangeQueue_) {
+        std::erase(arrangeQueue_, element);
+        element->inArrangeQueue_ = false;
+    }
+    // 正在处理的批次中只置空，避免迭代器失效
+    std::replace(processing_.begin(), processing_.end(), element, static_cast<UIElement*>(nullptr));
+}
+
+void LayoutManager::UpdateLayout() {
+    if (updating_) {
+        return;  // 布局过程中再次调用（如在 MeasureOverride 中）直接忽略
+    }
+    updating_ = true;
+
+    int pass = 0;
+    for (; pass < kMaxLayoutPasses && HasPendingWork(); ++pass) {
+        ProcessMeasureQueue();
+        ProcessArrangeQueue();
+    }
+
+    if (pass == kMaxLayoutPasses && HasPendingWork()) {
+        std::cerr << "LayoutManager: layout did not converge after " << kMaxLayoutPasses
+                  << " passes, deferring to next frame" << std::endl;
+    }
+
+    updating_ = false;
+}
+
+std::vector<UIElement*> LayoutManager::TakeSorted(std::vector<UIElement*>& queue) {
+    std::vector<std::pair<int, UIElement*>> byDepth;
+    byDepth.reserve(queue.size());
+    for (auto* element : queue) {
+        int depth = 0;
+        for (auto* visual = element->GetVisualParent(); visual; visual = visual->GetVisualParent()) {
+            ++depth;
+        }
+        byDepth.emplace_back(depth, element);
+    }
+    queue.clear();
+
+    // 祖先先于后代处理：祖先重新布局时会顺带处理脏的后代，后代出队时即可跳过
+    std::stable_sort(byDepth.begin(), byDepth.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<UIElement*> sorted;
+    sorted.reserve(byDepth.size());
+    for (const auto& [depth, element] : byDepth) {
+        sorted.push_back(element);
+    }
+    return sorted;
+}
+
+void LayoutManager::ProcessMeasureQueue() {
+    while (!measureQueue_.empty()) {
+        processing_ = TakeSorted(measureQueue_);
+
+        for (size_t i = 0; i < processing_.size(); ++i) {
+            UIElement* element = processing_[i];
+            if (!element) {
+                continue;  // 处理过程中被销毁
+            }
+            element->inMeasureQueue_ = false;
+
+            if (!element->measureDirty_) {
+                continue;  // 已在祖先的测量中处理
+            }
+
+            UIElement* parent = GetParentElement(element);
+            if (!element->hasMeasured_) {
+                // 从未测量过，没有可复用的可用尺寸，交给父元素测量
+                if (parent) {
+                    parent->InvalidateMeasure();
+                }
+                continue;
+            }
+
+            Size oldDesired = element->desiredSize_;
+            element->Measure(element->previousAvailableSize_);
+
+            // 期望尺寸变化才需要父元素重新测量，否则只需重新排列自身
+            // （父元素从未参与布局时，如承载内容根的 Window，自身即为布局根）
+            if (parent && parent->hasMeasured_ && !(element->desiredSize_ == oldDesired)) {
+                parent->InvalidateMeasure();
+            } else {
+                EnqueueArrange(element);
+            }
+        }
+        processing_.clear();
+    }
+}
+
+void LayoutManager::ProcessArrangeQueue() {
+    while (!arrangeQueue_.empty()) {
+        processing_ = TakeSorted(arrangeQueue_);
+
+        for (size_t i = 0; i < processing_.size(); ++i) {
+            UIElement* element = processing_[i];
+            if (!element) {
+                continue;  // 处理过程中被销毁
+            }
+            element->inArrangeQueue_ = false;
+
+            if (!element->arrangeDirty_ || element->measureDirty_) {
+                continue;  // 已在祖先的排列中处理，或等待下一轮测量
+            }
+
+            if (!element->hasArranged_) {
+                // 从未排列过，没有可复用的最终矩形，交给父元素排列
+                if (auto* parent = GetParentElement(element)) {
+                    parent->InvalidateArrange();
+                }
+                continue;
+            }
+
+            element->Arrange(element->previousFinalRect_);
+        }
+        processing_.clear();
+
+        // 排列过程中产生的测量请求留给下一轮
+        if (!measureQueue_.empty()) {
+            return;
+        }
+    }
+}
+
+} // namespace fk::ui
@@ -1,6 +1,9 @@
 #include "fk/ui/base/UIElement.h"
+#include "fk/ui/base/LayoutManager.h"
 #include "fk/ui/input/NameScope.h"
 #include "fk/ui/input/InputManager.h"
+#include "fk/ui/input/HitTestIndex.h"
+#include "fk/ui/graphics/Transform.h"
 #include "fk/ui/Window.h"
 #include "fk/render/RenderContext.h"
 #include <algorithm>
@@ -38,7 +41,8 @@ const binding::DependencyProperty& UIElement::OpacityProperty() {
             1.0f,
             [](binding::DependencyObject& d, const binding::DependencyProperty& prop, const std::any& oldValue, const std::any& newValue) {
                 if (auto* element = dynamic_cast<UIElement*>(&d)) {
-                    element->InvalidateVisual();
+                    // 透明度在图层合成时应用，缓存的图层位图仍然有效
+                    element->InvalidateComposition();
                 }
             }
         )
@@ -61,7 +65,28 @@ const binding::DependencyProperty& UIElement::RenderTransformProperty() {
         "RenderTransform",
         typeid(Transform*),
         typeid(UIElement),
-        binding::PropertyMetadata{static_cast<Transform*>(nullptr)}
+        binding::PropertyMetadata{
+            .defaultValue = static_cast<Transform*>(nullptr),
+            .propertyChangedCallback = [](binding::DependencyObject& d, const binding::DependencyProperty&,
+                                          const std::any&, const std::any& newValue) {
+                // 订阅新变换的 Changed：原地修改变换参数时同样通知父元素的命中测试索引
+                auto& element = static_cast<UIElement&>(d);
+                auto* transform = std::any_cast<Transform*>(newValue);
+                element.renderTransformChanged_ = transform
+                    ? transform->Changed.Connect([&element]() { element.NotifyHitTestBoundsChanged(); })
+                    : core::Event<>::Connection();
+                element.NotifyHitTestBoundsChanged();
+            }}
+    );
+    return property;
+}
+
+const binding::DependencyProperty& UIElement::CacheModeProperty() {
+    static auto& property = binding::DependencyProperty::Register(
+        "CacheMode",
+        typeid(CacheMode),
+        typeid(UIElement),
+        binding::PropertyMetadata{CacheMode::None}
     );
     return property;
 }
@@ -79,6 +104,19 @@ UIElement::UIElement()
 }
 
 UIElement::~UIElement() {
+    // 从布局队列中移除，避免 LayoutManager 持有悬空指针
+    if (inMeasureQueue_ || inArrangeQueue_) {
+        LayoutManager::Instance().Remove(this);
+    }
+    
+    // 子元素析构时不再需要更新本元素的索引
+    hitTestIndex_.reset();
+    
+    // 父元素的命中测试索引可能仍引用本元素
+    if (auto* parent = dynamic_cast<UIElement*>(GetVisualParent()); parent && parent->hitTestIndex_) {
+        parent->hitTestIndex_->Invalidate();
+    }
+    
     // 释放所有指针捕获，防止InputManager持有悬空指针
     // 注意：通常只会捕获pointerId=0（主指针�?
     // 如果有更多的pointerId被捕获，它们也应该在控件逻辑中被显式释放
@@ -102,10 +140,14 @@ void UIElement::SetName(const std::string& name) {
 }
 
 void UIElement::Measure(const Size& availableSize) {
-    if (!measureDirty_ && desiredSize_.width > 0 && desiredSize_.height > 0) {
-        return; // 已经测量过且有效
+    // Phase 5.1: 不脏且可用尺寸未变化时，整棵子树的测量结果仍然有效
+    if (!measureDirty_ && hasMeasured_ && availableSize == previousAvailableSize_) {
+        return;
     }
     
+    previousAvailableSize_ = availableSize;
+    hasMeasured_ = true;
+    
     auto visibility = GetValue<Visibility>(VisibilityProperty());
     if (visibility == Visibility::Collapsed) {
         desiredSize_ = Size(0, 0);
@@ -121,21 +163,45 @@ void UIElement::Arrange(const Rect& finalRect) {
     // 检查是否需要重新排�?
     // 注意：如�?arrangeDirty_ �?true，即使位置没变也需要重新排�?
     //       因为子元素可能需要重新排�?
-    bool rectChanged = (layoutRect_.x != finalRect.x || 
-                       layoutRect_.y != finalRect.y ||
-                       layoutRect_.width != finalRect.width ||
-                       layoutRect_.height != finalRect.height);
+    // 与上次传入的最终矩形比较（折叠元素的 layoutRect_ 被清零，不能用于比较）
+    bool sizeChanged = !hasArranged_ ||
+                       previousFinalRect_.width != finalRect.width ||
+                       previousFinalRect_.height != finalRect.height;
+    bool rectChanged = sizeChanged ||
+                       previousFinalRect_.x != finalRect.x || 
+                       previousFinalRect_.y != finalRect.y;
     
     // 只有当既不脏也不需要位置更新时才跳�?
     if (!arrangeDirty_ && !measureDirty_ && !rectChanged) {
         return; // 已经排列过且位置没有改变，且不需要重新排列子元素
     }
     
+    // 记录最终矩形，LayoutManager 单独重新排列该元素时复用
+    previousFinalRect_ = finalRect;
+    hasArranged_ = true;
+    
+    const Rect oldLayoutRect = layoutRect_;
+    const Size oldRenderSize = renderSize_;
+    auto notifyIfMoved = [&]() {
+        if (layoutRect_.x != oldLayoutRect.x || layoutRect_.y != oldLayoutRect.y ||
+            !(renderSize_ == oldRenderSize)) {
+            NotifyHitTestBoundsChanged();
+        }
+    };
+    
+    // 位置或尺寸改变时缓存的绘制命令失效；只移动位置时缓存的图层位图仍然有效
+    if (sizeChanged) {
+        InvalidateVisual();
+    } else if (rectChanged) {
+        InvalidateComposition();
+    }
+    
     auto visibility = GetValue<Visibility>(VisibilityProperty());
     if (visibility == Visibility::Collapsed) {
         renderSize_ = Size(0, 0);
         layoutRect_ = Rect(0, 0, 0, 0);
         arrangeDirty_ = false;
+        notifyIfMoved();
         return;
     }
     
@@ -145,29 +211,49 @@ void UIElement::Arrange(const Rect& finalRect) {
     // ArrangeCore 负责设置 renderSize_ 并排列子元素
     ArrangeCore(finalRect);
     arrangeDirty_ = false;
+    notifyIfMoved();
+}
+
+void UIElement::Reposition(const Point& position) {
+    if (!hasArranged_ || arrangeDirty_ || measureDirty_) {
+        Arrange(Rect(position.x, position.y, previousFinalRect_.width, previousFinalRect_.height));
+        return;
+    }
+
+    float dx = position.x - previousFinalRect_.x;
+    float dy = position.y - previousFinalRect_.y;
+    if (dx == 0.0f && dy == 0.0f) {
+        return;
+    }
+    previousFinalRect_.x = position.x;
+    previousFinalRect_.y = position.y;
+
+    // 折叠元素的 layoutRect_ 保持为零
+    if (GetValue<Visibility>(VisibilityProperty()) != Visibility::Collapsed) {
+        layoutRect_.x += dx;
+        layoutRect_.y += dy;
+        NotifyHitTestBoundsChanged();
+    }
 }
 
 void UIElement::InvalidateMeasure() {
     measureDirty_ = true;
     arrangeDirty_ = true;
     
-    // 向上传播使父节点也失�?
-    if (auto* parent = GetVisualParent()) {
-        if (auto* parentElement = dynamic_cast<UIElement*>(parent)) {
-            parentElement->InvalidateMeasure();
-        }
-    }
+    // 布局失效意味着需要新的一帧（消息循环据此退出空闲等待）
+    MarkSubtreeDirty();
+    
+    // Phase 5.1: 不再立即向上传播，由 LayoutManager 用上次的可用尺寸重新测量，
+    // 只有期望尺寸改变时才使父元素失效
+    LayoutManager::Instance().EnqueueMeasure(this);
 }
 
 void UIElement::InvalidateArrange() {
     arrangeDirty_ = true;
+    MarkSubtreeDirty();
     
-    // 向上传播
-    if (auto* parent = GetVisualParent()) {
-        if (auto* parentElement = dynamic_cast<UIElement*>(parent)) {
-            parentElement->InvalidateArrange();
-        }
-    }
+    // 由 LayoutManager 用上次的最终矩形重新排列
+    LayoutManager::Instance().EnqueueArrange(this);
 }
 
 void UIElement::SetVisibility(Visibility value) {
@@ -194,7 +280,7 @@ void UIElement::SetOpacity(float value) {
     if (value < 0.0f) value = 0.0f;
     if (value > 1.0f) value = 1.0f;
     SetValue(OpacityProperty(), value);
-    InvalidateVisual();
+    InvalidateComposition();
 }
 
 float UIElement::GetOpacity() const {
@@ -236,6 +322,61 @@ Transform* UIElement::GetRenderTransform() const {
     return GetValue<Transform*>(RenderTransformProperty());
 }
 
+void UIElement::SetCacheMode(CacheMode value) {
+    SetValue(CacheModeProperty(), value);
+}
+
+CacheMode UIElement::GetCacheMode() const {
+    return GetValue<CacheMode>(CacheModeProperty());
+}
+
+bool UIElement::IsCompositionProperty(const binding::DependencyProperty& property) const {
+    return &property == &OpacityProperty();
+}
+
+void UIElement::UpdateBitmapCacheVersion() {
+    static std::uint64_t nextCacheId = 1;
+    if (!bitmapCache_) {
+        bitmapCache_ = std::make_unique<BitmapCacheState>();
+        bitmapCache_->id = nextCacheId++;
+        bitmapCache_->version = 1;
+        bitmapCache_->contentVersion = GetContentVersion();
+        bitmapCache_->size = renderSize_;
+        return;
+    }
+    
+    // 只有位置或透明度变化（InvalidateComposition）时版本不变，渲染器直接合成位图
+    bool changed = bitmapCache_->contentVersion != GetContentVersion() ||
+                   !(bitmapCache_->size == renderSize_);
+    for (size_t i = 0; !changed && i < GetVisualChildrenCount(); ++i) {
+        const Visual* child = GetVisualChild(i);
+        changed = child && child->IsRenderDirty();
+    }
+    if (changed) {
+        ++bitmapCache_->version;
+        bitmapCache_->contentVersion = GetContentVersion();
+        bitmapCache_->size = renderSize_;
+    }
+}
+
+HitTestIndex* UIElement::GetHitTestIndex() {
+    if (GetVisualChildrenCount() < HitTestIndex::kMinChildren) {
+        hitTestIndex_.reset();
+        return nullptr;
+    }
+    if (!hitTestIndex_) {
+        hitTestIndex_ = std::make_unique<HitTestIndex>(this);
+    }
+    return hitTestIndex_.get();
+}
+
+void UIElement::NotifyHitTestBoundsChanged() {
+    auto* parent = dynamic_cast<UIElement*>(GetVisualParent());
+    if (parent && parent->hitTestIndex_) {
+        parent->hitTestIndex_->MarkDirty(this);
+    }
+}
+
 void UIElement::RaiseEvent(RoutedEventArgs& args) {
     if (!args.source) {
         args.source = this;
@@ -403,17 +544,42 @@ void UIElement::CollectDrawCommands(render::RenderContext& context) {
     // 检查可见�?
     auto visibility = GetVisibility();
     if (visibility == Visibility::Collapsed || visibility == Visibility::Hidden) {
+        // 刚被隐藏：上一帧绘制的区域需要重绘
+        if (IsContentDirty() && renderCache_) {
+            context.AddPreviousDamage(*renderCache_);
+            renderCache_->generation = 0;
+        }
+        ClearRenderDirty();
         return;  // 不渲染不可见或折叠的元素
     }
     
+    // Phase 5.1: 子树未变化时直接复用上一帧的绘制命令
+    if (!renderCache_) {
+        renderCache_ = std::make_unique<render::RenderCacheEntry>();
+    } else if (!IsRenderDirty() && context.ReplayCachedCommands(*renderCache_)) {
+        return;
+    }
+    
+    // 自身变化或无法复用（进入状态改变）时，整棵子树的新旧区域都计入损坏区域
+    bool contentChanged = IsContentDirty() || !IsRenderDirty();
+    bool trackDamage = context.BeginCacheRecord(*renderCache_, contentChanged);
+    
     // 推入布局偏移
     context.PushTransform(layoutRect_.x, layoutRect_.y);
 
-    // 应用不透明度（Opacity属性）
+    // 应用不透明度（Opacity属性）与位图缓存（CacheMode属性）：子树绘制到离屏图层后整体合成
     float opacity = GetOpacity();
-    bool hasOpacity = (opacity < 1.0f);
-    if (hasOpacity) {
-        context.PushLayer(opacity);
+    bool cacheBitmap = GetCacheMode() == CacheMode::BitmapCache;
+    if (cacheBitmap) {
+        UpdateBitmapCacheVersion();
+    } else {
+        bitmapCache_.reset();
+    }
+    bool hasLayer = opacity < 1.0f || cacheBitmap;
+    if (hasLayer) {
+        context.PushLayer(opacity,
+                          cacheBitmap ? bitmapCache_->id : 0,
+                          cacheBitmap ? bitmapCache_->version : 0);
     }
 
     // TODO: 应用渲染变换（RenderTransform属性）
@@ -433,7 +599,7 @@ void UIElement::CollectDrawCommands(render::RenderContext& context) {
     }
 
     // 收集子元素绘制命�?
-    Visual::CollectDrawCommands(context);
+    CollectChildDrawCommands(context);
 
     // 弹出裁剪区域
     if (clipRegion.has_value()) {
@@ -441,12 +607,19 @@ void UIElement::CollectDrawCommands(render::RenderContext& context) {
     }
 
     // 弹出不透明度层
-    if (hasOpacity) {
+    if (hasLayer) {
         context.PopLayer();
     }
 
     // 弹出变换
     context.PopTransform();
+    
+    context.EndCacheRecord(*renderCache_, trackDamage);
+    ClearRenderDirty();
+}
+
+void UIElement::CollectChildDrawCommands(render::RenderContext& context) {
+    Visual::CollectDrawCommands(context);
 }
 
 UIElement* UIElement::FindName(const std::string& name) {
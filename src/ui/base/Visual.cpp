@@ -23,7 +23,9 @@ void Visual::AddVisualChild(Visual* child) {
         }
         
         visualChildren_.push_back(child);
+        ++childrenVersion_;
         child->visualParent_ = this;
+        InvalidateVisual();
     }
 }
 
@@ -33,7 +35,9 @@ void Visual::RemoveVisualChild(Visual* child) {
     auto it = std::find(visualChildren_.begin(), visualChildren_.end(), child);
     if (it != visualChildren_.end()) {
         visualChildren_.erase(it);
+        ++childrenVersion_;
         child->visualParent_ = nullptr;
+        InvalidateVisual();
     }
 }
 
@@ -114,12 +118,41 @@ Rect Visual::GetBounds() const {
 }
 
 void Visual::InvalidateVisual() {
-    // 标记当前节点需要重?
-    // 通知父节点向上传播无效化
-    if (visualParent_) {
-        visualParent_->InvalidateVisual();
+    // 自身标记为内容变化，收集绘制命令时据此计算损坏区域（新旧命令包围盒）
+    contentDirty_ = true;
+    ++contentVersion_;
+    MarkSubtreeDirty();
+}
+
+void Visual::InvalidateComposition() {
+    contentDirty_ = true;
+    MarkSubtreeDirty();
+}
+
+void Visual::MarkSubtreeDirty() {
+    // 标记当前节点及祖先节点需要重新生成绘制命令
+    // 祖先已经是脏的说明之前已传播过，可以提前结束
+    for (Visual* visual = this; visual; visual = visual->visualParent_) {
+        if (visual->renderDirty_ && visual != this) {
+            break;
+        }
+        visual->renderDirty_ = true;
+    }
+}
+
+void Visual::OnPropertyChanged(const binding::DependencyProperty& property,
+                               const std::any& oldValue,
+                               const std::any& newValue,
+                               binding::ValueSource oldSource,
+                               binding::ValueSource newSource) {
+    binding::DependencyObject::OnPropertyChanged(property, oldValue, newValue, oldSource, newSource);
+
+    // 任何属性都可能影响绘制结果，保守地使命令缓存失效
+    if (IsCompositionProperty(property)) {
+        InvalidateComposition();
+    } else {
+        InvalidateVisual();
     }
-    // TODO: 与渲染系统集成，加入脏矩形队?
 }
 
 } // namespace fk::ui
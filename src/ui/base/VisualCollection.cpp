@@ -31,7 +31,9 @@ void VisualCollection::Add(Visual* child) {
     // 添加到集合并设置父指?
     children_.push_back(child);
     owner_->visualChildren_.push_back(child);
+    ++owner_->childrenVersion_;
     child->visualParent_ = owner_;
+    owner_->InvalidateVisual();
 }
 
 void VisualCollection::Insert(size_t index, Visual* child) {
@@ -60,7 +62,9 @@ void VisualCollection::Insert(size_t index, Visual* child) {
     // 插入到指定位置并设置父指?
     children_.insert(children_.begin() + index, child);
     owner_->visualChildren_.insert(owner_->visualChildren_.begin() + index, child);
+    ++owner_->childrenVersion_;
     child->visualParent_ = owner_;
+    owner_->InvalidateVisual();
 }
 
 void VisualCollection::Remove(Visual* child) {
@@ -77,10 +81,12 @@ void VisualCollection::Remove(Visual* child) {
                                  owner_->visualChildren_.end(), child);
         if (ownerIt != owner_->visualChildren_.end()) {
             owner_->visualChildren_.erase(ownerIt);
+            ++owner_->childrenVersion_;
         }
         
         // 清除父指?
         child->visualParent_ = nullptr;
+        owner_->InvalidateVisual();
     }
 }
 
@@ -101,12 +107,14 @@ void VisualCollection::RemoveAt(size_t index) {
                              owner_->visualChildren_.end(), child);
     if (ownerIt != owner_->visualChildren_.end()) {
         owner_->visualChildren_.erase(ownerIt);
+        ++owner_->childrenVersion_;
     }
     
     // 清除父指?
     if (child) {
         child->visualParent_ = nullptr;
     }
+    owner_->InvalidateVisual();
 }
 
 void VisualCollection::Clear() {
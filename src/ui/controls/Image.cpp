@@ -3,27 +3,23 @@
 #include "fk/render/DrawCommand.h"
 #include "fk/render/RenderContext.h"
 #include "fk/binding/DependencyProperty.h"
+#include "fk/render/ImageCache.h"
 
-// 集成图像加载?
+// stb_image 的实现放在这里（ImageCache、ImageBrush 共用）
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 
-// OpenGL headers
-#include <glad/glad.h>
-
 namespace fk::ui {
 
 // ========== 图像数据结构（PIMPL?==========
 
 struct ImageData {
-    unsigned int textureId = 0;   // OpenGL 纹理 ID
-    int width = 0;                // 图像宽度
-    int height = 0;               // 图像高度
-    int channels = 0;             // 通道?
-    bool loaded = false;          // 是否已加?
+    std::shared_ptr<render::ImageResource> resource;              // 共享的图像资源（Phase 5.1：异步加载）
+    core::Event<render::ImageLoadState>::Connection stateChanged;  // 加载状态变化订阅
 };
 
 // ========== 依赖属性定?==========
@@ -65,97 +61,78 @@ void Image::SetSource(const std::string& path) {
     UnloadImage();
     
     if (!path.empty()) {
-        if (LoadImage(path)) {
-            InvalidateMeasure();
-            InvalidateVisual();
-        }
+        LoadImage(path);
     }
+    // 加载期间尺寸未知；解码完成后按图像尺寸重新测量
+    InvalidateMeasure();
+    InvalidateVisual();
 }
 
 bool Image::LoadImage(const std::string& path) {
-    // 使用 stb_image 加载图像
-    int width, height, channels;
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-    
-    if (!data) {
-        std::cerr << "Failed to load image: " << path << std::endl;
-        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
-        return false;
-    }
-    
-    // 创建 OpenGL 纹理
-    glGenTextures(1, &imageData_->textureId);
-    glBindTexture(GL_TEXTURE_2D, imageData_->textureId);
-    
-    // 设置纹理参数
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    
-    // 上传纹理数据
-    GLenum format;
-    switch (channels) {
-        case 1: format = GL_RED; break;
-        case 2: format = GL_RG; break;
-        case 3: format = GL_RGB; break;
-        case 4: format = GL_RGBA; break;
-        default:
-            stbi_image_free(data);
-            return false;
-    }
-    
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-    
-    // 生成 mipmap（可选）
-    glGenerateMipmap(GL_TEXTURE_2D);
-    
-    // 释放图像数据
-    stbi_image_free(data);
-    
-    // 保存图像信息
-    imageData_->width = width;
-    imageData_->height = height;
-    imageData_->channels = channels;
-    imageData_->loaded = true;
-    
-    std::cout << "Successfully loaded image: " << path 
-              << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
+    // Phase 5.1: 显示尺寸已知且小于图像时按显示尺寸缩小解码
+    auto decodeHint = [](float explicitSize, float renderSize) {
+        if (!std::isnan(explicitSize) && explicitSize > 0) {
+            return static_cast<int>(std::ceil(explicitSize));
+        }
+        return renderSize > 0 ? static_cast<int>(std::ceil(renderSize)) : 0;
+    };
+    const auto renderSize = GetRenderSize();
+    const int decodeWidth = decodeHint(GetWidth(), renderSize.width);
+    const int decodeHeight = decodeHint(GetHeight(), renderSize.height);
+
+    // 解码在线程池中进行，纹理按帧预算分批上传；相同的源共享同一份纹理
+    imageData_->resource = render::ImageCache::Instance().Load(path, decodeWidth, decodeHeight);
+    imageData_->stateChanged = imageData_->resource->StateChanged.Connect([this](render::ImageLoadState state) {
+        if (state == render::ImageLoadState::Ready) {
+            // 尺寸在解码完成时已经确定，只需要重绘
+            InvalidateVisual();
+        } else if (state == render::ImageLoadState::Evicted) {
+            // 只有不在渲染列表中的纹理才会被淘汰，再次显示时在 OnRender 中重新加载
+        } else {
+            InvalidateMeasure();
+            InvalidateVisual();
+        }
+    });
     
-    return true;
+    return imageData_->resource->GetState() != render::ImageLoadState::Failed;
 }
 
 void Image::UnloadImage() {
-    if (imageData_->loaded && imageData_->textureId != 0) {
-        // 删除 OpenGL 纹理
-        glDeleteTextures(1, &imageData_->textureId);
-        
-        imageData_->textureId = 0;
-        imageData_->loaded = false;
-        imageData_->width = 0;
-        imageData_->height = 0;
-        imageData_->channels = 0;
-    }
+    // 纹理由 ImageCache 在最后一个使用者释放后删除
+    imageData_->stateChanged.Disconnect();
+    imageData_->resource.reset();
 }
 
 // ========== 图像信息查询 ==========
 
 float Image::GetImageWidth() const {
-    return static_cast<float>(imageData_->width);
+    return imageData_->resource ? static_cast<float>(imageData_->resource->SourceWidth()) : 0.0f;
 }
 
 float Image::GetImageHeight() const {
-    return static_cast<float>(imageData_->height);
+    return imageData_->resource ? static_cast<float>(imageData_->resource->SourceHeight()) : 0.0f;
 }
 
 bool Image::IsLoaded() const {
-    return imageData_->loaded;
+    return imageData_->resource && imageData_->resource->IsReady();
+}
+
+bool Image::IsLoading() const {
+    if (!imageData_->resource) {
+        return false;
+    }
+    auto state = imageData_->resource->GetState();
+    return state == render::ImageLoadState::Decoding || state == render::ImageLoadState::Uploading;
+}
+
+bool Image::HasImageSize() const {
+    return GetImageWidth() > 0 && GetImageHeight() > 0;
 }
 
 // ========== 布局测量 ==========
 
 Size Image::MeasureOverride(const Size& availableSize) {
-    if (!IsLoaded()) {
+    if (!HasImageSize()) {
         return Size(0, 0);
     }
     
@@ -219,7 +196,7 @@ Size Image::ArrangeOverride(const Size& finalSize) {
 // ========== 渲染计算 ==========
 
 Rect Image::CalculateRenderBounds(const Size& containerSize) const {
-    if (!IsLoaded()) {
+    if (!HasImageSize()) {
         return Rect(0, 0, 0, 0);
     }
     
@@ -282,15 +259,26 @@ Rect Image::CalculateRenderBounds(const Size& containerSize) const {
 // ========== 渲染 ==========
 
 void Image::OnRender(render::RenderContext& context) {
-    // Phase 5.0.5: Image 渲染将在后续实现（Phase 5.0.6?
-    // 当前使用新的 RenderContext API，需要更新实?
-    // TODO: 使用 context.DrawImage() 替代旧的 DrawCommand::GetRenderer()->Submit()
+    if (!HasImageSize()) {
+        return;
+    }
     
-    if (!IsLoaded()) {
+    Rect bounds = CalculateRenderBounds(GetRenderSize());
+    if (bounds.width <= 0 || bounds.height <= 0) {
         return;
     }
     
-    // 暂时跳过渲染，等?Phase 5.0.6 完成 Image 控件的新 API 适配
+    if (IsLoaded()) {
+        context.DrawImage(bounds, imageData_->resource->TextureId());
+    } else {
+        // Phase 5.1: 纹理被 TextureManager 淘汰后，重新可见时再解码上传
+        if (imageData_->resource && imageData_->resource->GetState() == render::ImageLoadState::Evicted &&
+            !context.IsClipped(bounds)) {
+            render::ImageCache::Instance().Reload(imageData_->resource);
+        }
+        // Phase 5.1: 纹理上传完成之前显示占位
+        context.DrawRectangle(bounds, {0.85f, 0.85f, 0.85f, 1.0f});
+    }
 }
 
 } // namespace fk::ui
@@ -46,6 +46,7 @@ UIElement* ItemContainerGenerator::GenerateContainer(const std::any& item, bool&
         // 建立映射关系
         itemToContainer_[itemKey] = container;
         containerToItem_[container] = item;
+        containerToKey_[container] = itemKey;
         containers_.push_back(container);
         
         // 准备容器
@@ -121,18 +122,15 @@ void ItemContainerGenerator::RecycleContainer(UIElement* container) {
         return;
     }
     
-    // 从映射中移除
+    // 项本身就是容器时只解除映射，不能放入池中复用给其他项
     auto itemIt = containerToItem_.find(container);
-    if (itemIt != containerToItem_.end()) {
-        std::string itemKey = GenerateItemKey(itemIt->second);
-        itemToContainer_.erase(itemKey);
-        containerToItem_.erase(itemIt);
-    }
+    bool isOwnContainer = itemIt != containerToItem_.end() &&
+                          itemIt->second.type() == typeid(UIElement*) &&
+                          std::any_cast<UIElement*>(itemIt->second) == container;
     
-    // 从容器列表中移除
-    auto it = std::find(containers_.begin(), containers_.end(), container);
-    if (it != containers_.end()) {
-        containers_.erase(it);
+    UnmapContainer(container);
+    if (isOwnContainer) {
+        return;
     }
     
     // 清理容器
@@ -161,19 +159,7 @@ void ItemContainerGenerator::ClearContainerPool() {
 void ItemContainerGenerator::RemoveContainer(UIElement* container) {
     if (!container) return;
     
-    // 从映射中移除
-    auto itemIt = containerToItem_.find(container);
-    if (itemIt != containerToItem_.end()) {
-        std::string itemKey = GenerateItemKey(itemIt->second);
-        itemToContainer_.erase(itemKey);
-        containerToItem_.erase(itemIt);
-    }
-    
-    // 从容器列表中移除
-    auto it = std::find(containers_.begin(), containers_.end(), container);
-    if (it != containers_.end()) {
-        containers_.erase(it);
-    }
+    UnmapContainer(container);
     
     // 释放容器
     delete container;
@@ -196,6 +182,7 @@ void ItemContainerGenerator::RemoveAll() {
     containers_.clear();
     itemToContainer_.clear();
     containerToItem_.clear();
+    containerToKey_.clear();
     
     // 清空?
     ClearContainerPool();
@@ -262,6 +249,21 @@ UIElement* ItemContainerGenerator::GetRecycledContainer() {
     return container;
 }
 
+void ItemContainerGenerator::UnmapContainer(UIElement* container) {
+    // 使用生成时记录的键：值类型项的键依赖于项的地址，无法从映射中保存的副本重新计算
+    auto keyIt = containerToKey_.find(container);
+    if (keyIt != containerToKey_.end()) {
+        itemToContainer_.erase(keyIt->second);
+        containerToKey_.erase(keyIt);
+    }
+    containerToItem_.erase(container);
+    
+    auto it = std::find(containers_.begin(), containers_.end(), container);
+    if (it != containers_.end()) {
+        containers_.erase(it);
+    }
+}
+
 UIElement* ItemContainerGenerator::CreateNewContainer(const std::any& item) {
     // 优先使用自定义工?
     if (containerFactory_) {
@@ -120,21 +120,44 @@ Matrix3x2 TransformGroup::GetMatrix() const {
     return result;
 }
 
+std::uint64_t TransformGroup::GetVersion() const {
+    // 自身版本号加上各子变换的版本号；移除子变换时把其版本号计入自身，保证单调递增
+    std::uint64_t version = version_;
+    for (Transform* child : children_) {
+        if (child) {
+            version += child->GetVersion();
+        }
+    }
+    return version;
+}
+
 void TransformGroup::AddTransform(Transform* transform) {
     if (transform) {
         children_.push_back(transform);
+        childConnections_.push_back(transform->Changed.Connect([this]() { Changed(); }));
+        Touch();
     }
 }
 
 void TransformGroup::RemoveTransform(Transform* transform) {
     auto it = std::find(children_.begin(), children_.end(), transform);
     if (it != children_.end()) {
+        version_ += (*it)->GetVersion();
+        childConnections_.erase(childConnections_.begin() + (it - children_.begin()));
         children_.erase(it);
+        Touch();
     }
 }
 
 void TransformGroup::ClearTransforms() {
+    for (Transform* child : children_) {
+        if (child) {
+            version_ += child->GetVersion();
+        }
+    }
     children_.clear();
+    childConnections_.clear();
+    Touch();
 }
 
 } // namespace fk::ui
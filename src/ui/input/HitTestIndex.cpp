@@ -0,0 +1,261 @@
+#include "fk/ui/input/HitTestIndex.h"
+#include "fk/ui/base/UIElement.h"
+#include "fk/ui/graphics/Transform.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace fk::ui {
+
+namespace {
+
+// 网格每个维度的最大单元数
+constexpr int kMaxCellsPerAxis = 1024;
+
+} // namespace
+
+HitTestIndex::HitTestIndex(UIElement* owner)
+    : owner_(owner) {
+}
+
+Rect HitTestIndex::ComputeChildBounds(const UIElement& child) {
+    const Rect layout = child.GetLayoutRect();
+    const Size size = child.GetRenderSize();
+    Rect bounds(layout.x, layout.y, size.width, size.height);
+
+    Transform* transform = child.GetRenderTransform();
+    if (!transform) {
+        return bounds;
+    }
+
+    const Matrix3x2 matrix = transform->GetMatrix();
+    // 奇异矩阵的逆矩阵退化为单位矩阵（见 Matrix3x2::Inverse），命中测试按未变换处理
+    if (std::abs(matrix.m11 * matrix.m22 - matrix.m12 * matrix.m21) < 1e-6f) {
+        return bounds;
+    }
+
+    // 命中测试把父坐标减去布局偏移后再做逆变换，因此包围盒是 偏移 + 变换(局部矩形)
+    const Point corners[4] = {
+        matrix.TransformPoint(Point(0, 0)),
+        matrix.TransformPoint(Point(size.width, 0)),
+        matrix.TransformPoint(Point(0, size.height)),
+        matrix.TransformPoint(Point(size.width, size.height)),
+    };
+    float minX = corners[0].x;
+    float maxX = corners[0].x;
+    float minY = corners[0].y;
+    float maxY = corners[0].y;
+    for (const auto& corner : corners) {
+        minX = std::min(minX, corner.x);
+        maxX = std::max(maxX, corner.x);
+        minY = std::min(minY, corner.y);
+        maxY = std::max(maxY, corner.y);
+    }
+    return Rect(layout.x + minX, layout.y + minY, maxX - minX, maxY - minY);
+}
+
+void HitTestIndex::MarkDirty(UIElement* child) {
+    if (!valid_) {
+        return;
+    }
+    auto it = slots_.find(child);
+    if (it == slots_.end()) {
+        return;
+    }
+    auto& entry = entries_[it->second];
+    if (entry.dirty) {
+        return;
+    }
+    entry.dirty = true;
+    dirty_.push_back(it->second);
+
+    // 大量子元素同时变化（如整体重新布局）时直接重建更快
+    if (dirty_.size() > entries_.size() / 4) {
+        valid_ = false;
+    }
+}
+
+void HitTestIndex::Query(const Point& point, std::vector<UIElement*>& candidates) {
+    if (!valid_ || childrenVersion_ != owner_->GetVisualChildrenVersion()) {
+        Rebuild();
+    }
+
+    if (!dirty_.empty()) {
+        if (dirty_.size() > entries_.size() / 4) {
+            Rebuild();
+        } else {
+            for (std::uint32_t slot : dirty_) {
+                Refresh(slot);
+            }
+            dirty_.clear();
+            // 子元素移出网格范围过多时单元格划分已不合适
+            if (outsideCount_ > entries_.size() / 4) {
+                Rebuild();
+            }
+        }
+    }
+
+    if (columns_ == 0) {
+        return;
+    }
+    if (outsideCount_ == 0 && !extent_.Contains(point)) {
+        return;
+    }
+
+    const auto& cell = Cell(CellX(point.x), CellY(point.y));
+    auto& slots = scratch_;
+    slots.assign(cell.begin(), cell.end());
+    slots.insert(slots.end(), oversized_.begin(), oversized_.end());
+
+    // 视觉子节点索引越大越靠上
+    std::sort(slots.begin(), slots.end(), std::greater<>());
+    candidates.reserve(candidates.size() + slots.size());
+    for (std::uint32_t slot : slots) {
+        candidates.push_back(entries_[slot].child);
+    }
+}
+
+void HitTestIndex::Rebuild() {
+    entries_.clear();
+    slots_.clear();
+    cells_.clear();
+    oversized_.clear();
+    dirty_.clear();
+    outsideCount_ = 0;
+    columns_ = 0;
+    rows_ = 0;
+
+    const std::size_t count = owner_->GetVisualChildrenCount();
+    entries_.resize(count);
+
+    bool hasExtent = false;
+    float minX = 0.0f;
+    float minY = 0.0f;
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto* child = dynamic_cast<UIElement*>(owner_->GetVisualChild(i));
+        if (!child) {
+            continue;
+        }
+        auto& entry = entries_[i];
+        entry.child = child;
+        Snapshot(entry);
+        slots_[child] = static_cast<std::uint32_t>(i);
+
+        const Rect& b = entry.bounds;
+        if (!hasExtent) {
+            minX = b.x;
+            minY = b.y;
+            maxX = b.x + b.width;
+            maxY = b.y + b.height;
+            hasExtent = true;
+        } else {
+            minX = std::min(minX, b.x);
+            minY = std::min(minY, b.y);
+            maxX = std::max(maxX, b.x + b.width);
+            maxY = std::max(maxY, b.y + b.height);
+        }
+    }
+
+    childrenVersion_ = owner_->GetVisualChildrenVersion();
+    valid_ = true;
+    if (!hasExtent) {
+        return;
+    }
+
+    // 单元数约等于子元素数，按包围范围的宽高比分配行列
+    extent_ = Rect(minX, minY, maxX - minX, maxY - minY);
+    const float width = std::max(extent_.width, 1.0f);
+    const float height = std::max(extent_.height, 1.0f);
+    const double target = static_cast<double>(slots_.size());
+    columns_ = std::clamp(static_cast<int>(std::lround(std::sqrt(target * width / height))), 1, kMaxCellsPerAxis);
+    rows_ = std::clamp(static_cast<int>(std::lround(target / columns_)), 1, kMaxCellsPerAxis);
+    cellWidth_ = width / static_cast<float>(columns_);
+    cellHeight_ = height / static_cast<float>(rows_);
+    cells_.resize(static_cast<std::size_t>(columns_) * rows_);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        Place(static_cast<std::uint32_t>(i));
+    }
+}
+
+void HitTestIndex::Refresh(std::uint32_t slot) {
+    auto& entry = entries_[slot];
+    entry.dirty = false;
+    Unplace(slot);
+    Snapshot(entry);
+    Place(slot);
+}
+
+void HitTestIndex::Snapshot(Entry& entry) {
+    entry.bounds = ComputeChildBounds(*entry.child);
+}
+
+void HitTestIndex::Place(std::uint32_t slot) {
+    auto& entry = entries_[slot];
+    if (!entry.child || columns_ == 0) {
+        return;
+    }
+
+    const Rect& b = entry.bounds;
+    entry.outside = b.x < extent_.x || b.y < extent_.y ||
+                    b.x + b.width > extent_.x + extent_.width ||
+                    b.y + b.height > extent_.y + extent_.height;
+    if (entry.outside) {
+        ++outsideCount_;
+    }
+
+    // 端点使用与查询相同的单元计算方式，边界上的点也能找到该元素
+    entry.cellX0 = CellX(b.x);
+    entry.cellX1 = CellX(b.x + b.width);
+    entry.cellY0 = CellY(b.y);
+    entry.cellY1 = CellY(b.y + b.height);
+
+    const std::size_t covered = static_cast<std::size_t>(entry.cellX1 - entry.cellX0 + 1) *
+                                static_cast<std::size_t>(entry.cellY1 - entry.cellY0 + 1);
+    entry.oversized = covered > 16 && covered > cells_.size() / 4;
+    if (entry.oversized) {
+        oversized_.push_back(slot);
+        return;
+    }
+    for (int y = entry.cellY0; y <= entry.cellY1; ++y) {
+        for (int x = entry.cellX0; x <= entry.cellX1; ++x) {
+            Cell(x, y).push_back(slot);
+        }
+    }
+}
+
+void HitTestIndex::Unplace(std::uint32_t slot) {
+    auto& entry = entries_[slot];
+    if (!entry.child || columns_ == 0) {
+        return;
+    }
+    if (entry.outside) {
+        --outsideCount_;
+        entry.outside = false;
+    }
+    if (entry.oversized) {
+        std::erase(oversized_, slot);
+        entry.oversized = false;
+        return;
+    }
+    for (int y = entry.cellY0; y <= entry.cellY1; ++y) {
+        for (int x = entry.cellX0; x <= entry.cellX1; ++x) {
+            std::erase(Cell(x, y), slot);
+        }
+    }
+}
+
+int HitTestIndex::CellX(float x) const {
+    const double cell = std::floor((static_cast<double>(x) - extent_.x) / cellWidth_);
+    return static_cast<int>(std::clamp(cell, 0.0, static_cast<double>(columns_ - 1)));
+}
+
+int HitTestIndex::CellY(float y) const {
+    const double cell = std::floor((static_cast<double>(y) - extent_.y) / cellHeight_);
+    return static_cast<int>(std::clamp(cell, 0.0, static_cast<double>(rows_ - 1)));
+}
+
+} // namespace fk::ui
@@ -2,6 +2,7 @@
 #include "fk/ui/base/Visual.h"
 #include "fk/ui/graphics/Transform.h"
 #include "fk/ui/input/FocusManager.h"
+#include "fk/ui/input/HitTestIndex.h"
 #include <iostream>
 
 namespace fk::ui {
@@ -28,59 +29,70 @@ UIElement* InputManager::HitTest(const Point& screenPoint, Visual* root) {
         return nullptr;
     }
     
-    // TODO: 考虑窗口坐标转换
-    // 目前假设 screenPoint 已经是相对于 root 的局部坐?
-    return HitTestRecursive(testRoot, screenPoint);
-}
-
-UIElement* InputManager::HitTestRecursive(Visual* visual, const Point& localPoint) {
-    if (!visual) {
-        return nullptr;
-    }
-    
-    // 尝试转换?UIElement
-    auto* element = dynamic_cast<UIElement*>(visual);
+    auto* element = dynamic_cast<UIElement*>(testRoot);
     if (!element) {
         return nullptr;
     }
     
-    // 检查可见性和启用状?
+    // TODO: 考虑窗口坐标转换
+    // 目前假设 screenPoint 已经是相对于 root 的局部坐标
+    return HitTestRecursive(element, screenPoint);
+}
+
+UIElement* InputManager::HitTestRecursive(UIElement* element, const Point& localPoint) {
+    // 检查可见性和启用状态
     if (element->GetVisibility() != Visibility::Visible || !element->GetIsEnabled()) {
         return nullptr;
     }
     
-    // 检查是否在边界?
+    // 检查是否在边界内
     Rect bounds(0, 0, element->GetRenderSize().width, element->GetRenderSize().height);
     if (!bounds.Contains(localPoint)) {
         return nullptr;
     }
     
-    // 递归检查子元素（从后向前，因为后面的元素在视觉上更靠前?
-    size_t childCount = visual->GetVisualChildrenCount();
-    for (int i = static_cast<int>(childCount) - 1; i >= 0; --i) {
-        Visual* child = visual->GetVisualChild(i);
-        if (!child) continue;
-        
-        UIElement* childElement = dynamic_cast<UIElement*>(child);
-        if (!childElement) continue;
-        
-        // 获取子元素的布局矩形（在父元素坐标系中的位置?
+    // 将点转换到子元素局部空间后递归测试
+    auto hitTestChild = [&](UIElement* childElement) -> UIElement* {
+        // 首先减去子元素在父元素坐标系中的偏移
         Rect childLayoutRect = childElement->GetLayoutRect();
-        
-        // 转换坐标到子元素局部空?
-        // 首先减去子元素的偏移?
         Point childLocalPoint(localPoint.x - childLayoutRect.x, 
                              localPoint.y - childLayoutRect.y);
         
-        // 如果子元素有 RenderTransform，应用逆变?
+        // 如果子元素有 RenderTransform，应用逆变换
         Transform* transform = childElement->GetRenderTransform();
         if (transform) {
             Matrix3x2 inverseMatrix = transform->GetInverseMatrix();
             childLocalPoint = inverseMatrix.TransformPoint(childLocalPoint);
         }
         
-        UIElement* hitChild = HitTestRecursive(child, childLocalPoint);
-        if (hitChild) {
+        return HitTestRecursive(childElement, childLocalPoint);
+    };
+    
+    // Phase 5.1: 子元素较多时通过空间索引只测试包围盒包含该点的子元素
+    if (HitTestIndex* index = element->GetHitTestIndex()) {
+        // 各层递归共用同一缓冲区：本层候选追加在末尾，返回前截断回原长度
+        const size_t base = hitTestCandidates_.size();
+        index->Query(localPoint, hitTestCandidates_);
+        
+        // 候选已按 z 序从上到下排列；递归可能使缓冲区重新分配，按下标访问
+        UIElement* hit = element;
+        for (size_t i = base; i < hitTestCandidates_.size(); ++i) {
+            if (UIElement* hitChild = hitTestChild(hitTestCandidates_[i])) {
+                hit = hitChild;
+                break;
+            }
+        }
+        hitTestCandidates_.resize(base);
+        return hit;
+    }
+    
+    // 递归检查子元素（从后向前，因为后面的元素在视觉上更靠前）
+    size_t childCount = element->GetVisualChildrenCount();
+    for (int i = static_cast<int>(childCount) - 1; i >= 0; --i) {
+        UIElement* childElement = dynamic_cast<UIElement*>(element->GetVisualChild(i));
+        if (!childElement) continue;
+        
+        if (UIElement* hitChild = hitTestChild(childElement)) {
             return hitChild;
         }
     }
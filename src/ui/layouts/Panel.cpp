@@ -1,5 +1,6 @@
 #include "fk/ui/layouts/Panel.h"
 #include "fk/ui/layouts/StackPanel.h"
+#include "fk/ui/layouts/VirtualizingStackPanel.h"
 #include "fk/ui/layouts/Grid.h"
 
 namespace fk::ui {
@@ -42,3 +43,4 @@ const binding::DependencyProperty& Panel<Derived>::ClipToBoundsProperty() {
 // 显式实例?Panel 模板（必须在命名空间之外?
 template class fk::ui::Panel<fk::ui::StackPanel>;
 template class fk::ui::Panel<fk::ui::Grid>;
+template class fk::ui::Panel<fk::ui::VirtualizingStackPanel>;
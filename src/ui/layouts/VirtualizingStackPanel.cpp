@@ -0,0 +1,311 @@
+#include "fk/ui/layouts/VirtualizingStackPanel.h"
+#include "fk/ui/controls/ItemContainerGenerator.h"
+#include "fk/ui/lists/ObservableCollection.h"
+#include "fk/ui/graphics/Brush.h"
+#include "fk/render/RenderContext.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace fk::ui {
+
+namespace {
+
+// 尚未测量任何项时假定的项尺寸（像素）
+constexpr float kDefaultItemSize = 24.0f;
+
+// 在 available 内按对齐方式放置 size：0 起始，1 居中，2 末尾，3 拉伸
+void AlignSpan(float available, float desired, int mode, float& offset, float& size) {
+    if (mode == 3) {
+        offset = 0.0f;
+        size = available;
+        return;
+    }
+    size = std::min(desired, available);
+    offset = mode == 1 ? (available - size) / 2.0f : mode == 2 ? available - size : 0.0f;
+}
+
+int AlignMode(HorizontalAlignment alignment) {
+    switch (alignment) {
+        case HorizontalAlignment::Left:   return 0;
+        case HorizontalAlignment::Center: return 1;
+        case HorizontalAlignment::Right:  return 2;
+        default:                          return 3;
+    }
+}
+
+int AlignMode(VerticalAlignment alignment) {
+    switch (alignment) {
+        case VerticalAlignment::Top:    return 0;
+        case VerticalAlignment::Center: return 1;
+        case VerticalAlignment::Bottom: return 2;
+        default:                        return 3;
+    }
+}
+
+} // namespace
+
+// ========== 依赖属性注册 ==========
+
+const binding::DependencyProperty& VirtualizingStackPanel::OrientationProperty() {
+    static auto& property = binding::DependencyProperty::Register(
+        "Orientation",
+        typeid(ui::Orientation),
+        typeid(VirtualizingStackPanel),
+        {ui::Orientation::Vertical}
+    );
+    return property;
+}
+
+const binding::DependencyProperty& VirtualizingStackPanel::CacheLengthProperty() {
+    static auto& property = binding::DependencyProperty::Register(
+        "CacheLength",
+        typeid(float),
+        typeid(VirtualizingStackPanel),
+        {1.0f}
+    );
+    return property;
+}
+
+VirtualizingStackPanel::~VirtualizingStackPanel() {
+    RecycleAll();
+}
+
+// ========== 项宿主 ==========
+
+void VirtualizingStackPanel::SetItemsHost(ItemContainerGenerator* generator, const ObservableCollection* items) {
+    RecycleAll();
+    generator_ = generator;
+    items_ = items;
+    averageItemSize_ = 0.0f;
+    InvalidateMeasure();
+}
+
+void VirtualizingStackPanel::OnItemsChanged(const CollectionChangedEventArgs& /*args*/) {
+    // 插入/删除会移动后续项的索引，且集合重新分配后生成器中的项键失效，
+    // 因此回收全部容器；重新实例化的数量只与视口大小相关
+    RecycleAll();
+    InvalidateMeasure();
+}
+
+UIElement* VirtualizingStackPanel::ContainerFromIndex(int index) const {
+    auto it = std::lower_bound(realized_.begin(), realized_.end(), index,
+                               [](const RealizedItem& item, int i) { return item.index < i; });
+    return (it != realized_.end() && it->index == index) ? it->container : nullptr;
+}
+
+// ========== IScrollInfo ==========
+
+void VirtualizingStackPanel::SetScrollOffset(double horizontalOffset, double verticalOffset) {
+    bool vertical = GetOrientation() == Orientation::Vertical;
+    double oldAlong = vertical ? verticalOffset_ : horizontalOffset_;
+    double oldCross = vertical ? horizontalOffset_ : verticalOffset_;
+
+    horizontalOffset_ = horizontalOffset;
+    verticalOffset_ = verticalOffset;
+
+    double newAlong = vertical ? verticalOffset_ : horizontalOffset_;
+    double newCross = vertical ? horizontalOffset_ : verticalOffset_;
+
+    if (newAlong != oldAlong) {
+        InvalidateMeasure();  // 可见区间变化，需要重新实例化
+    } else if (newCross != oldCross) {
+        InvalidateArrange();
+    }
+}
+
+// ========== 布局 ==========
+
+Size VirtualizingStackPanel::MeasureOverride(const Size& availableSize) {
+    bool vertical = GetOrientation() == Orientation::Vertical;
+    int count = (generator_ && items_) ? items_->Count() : 0;
+
+    if (count == 0) {
+        RecycleAll();
+        if (extent_.width != 0 || extent_.height != 0) {
+            extent_ = Size(0, 0);
+            if (auto* parent = dynamic_cast<UIElement*>(GetVisualParent())) {
+                parent->InvalidateMeasure();
+            }
+        }
+        return Size(0, 0);
+    }
+
+    float viewport = vertical ? availableSize.height : availableSize.width;
+    double offset = vertical ? verticalOffset_ : horizontalOffset_;
+    float itemSize = GetEstimatedItemSize();
+
+    // 计算需要实例化的索引区间：视口加上前后各 CacheLength 个视口
+    int first = 0;
+    int last = count - 1;
+    if (std::isfinite(viewport)) {
+        double cache = viewport * std::max(0.0f, GetCacheLength());
+        first = std::clamp(static_cast<int>(std::floor((offset - cache) / itemSize)), 0, count - 1);
+        last = std::clamp(static_cast<int>(std::ceil((offset + viewport + cache) / itemSize)), first, count - 1);
+    }
+
+    RecycleOutside(first, last);
+
+    // 堆叠方向给无限空间，非堆叠方向传递约束（与 StackPanel 一致）
+    Size childAvailable = availableSize;
+    if (vertical) {
+        childAvailable.height = std::numeric_limits<float>::infinity();
+    } else {
+        childAvailable.width = std::numeric_limits<float>::infinity();
+    }
+
+    float totalAlong = 0.0f;
+    float maxCross = 0.0f;
+    int measuredCount = 0;
+    for (int i = first; i <= last; ++i) {
+        UIElement* container = ContainerFromIndex(i);
+        if (!container) {
+            container = Realize(i);
+        }
+        if (!container || container->GetVisibility() == Visibility::Collapsed) {
+            continue;
+        }
+
+        container->Measure(childAvailable);
+        Size desired = container->GetDesiredSize();
+        auto margin = container->GetMargin();
+        if (vertical) {
+            totalAlong += desired.height + margin.top + margin.bottom;
+            maxCross = std::max(maxCross, desired.width + margin.left + margin.right);
+        } else {
+            totalAlong += desired.width + margin.left + margin.right;
+            maxCross = std::max(maxCross, desired.height + margin.top + margin.bottom);
+        }
+        ++measuredCount;
+    }
+
+    if (measuredCount > 0 && totalAlong > 0.0f) {
+        averageItemSize_ = totalAlong / static_cast<float>(measuredCount);
+    }
+
+    // Extent 按平均项尺寸估算，非堆叠方向取已实例化项的最大值
+    float extentAlong = GetEstimatedItemSize() * static_cast<float>(count);
+    Size extent = vertical ? Size(maxCross, extentAlong) : Size(extentAlong, maxCross);
+    if (!(extent == extent_)) {
+        extent_ = extent;
+        // 单独重新测量时通知滚动宿主读取新的 Extent
+        if (auto* parent = dynamic_cast<UIElement*>(GetVisualParent())) {
+            parent->InvalidateMeasure();
+        }
+    }
+
+    float desiredAlong = std::isfinite(viewport) ? std::min(extentAlong, viewport) : extentAlong;
+    return vertical ? Size(maxCross, desiredAlong) : Size(desiredAlong, maxCross);
+}
+
+Size VirtualizingStackPanel::ArrangeOverride(const Size& finalSize) {
+    if (realized_.empty()) {
+        return finalSize;
+    }
+
+    bool vertical = GetOrientation() == Orientation::Vertical;
+    float itemSize = GetEstimatedItemSize();
+
+    // 第一个已实例化项按估算位置放置，其后按实际尺寸依次堆叠
+    double alongOffset = vertical ? verticalOffset_ : horizontalOffset_;
+    double crossOffset = vertical ? horizontalOffset_ : verticalOffset_;
+    float position = static_cast<float>(realized_.front().index * static_cast<double>(itemSize) - alongOffset);
+
+    for (const auto& item : realized_) {
+        UIElement* child = item.container;
+        if (!child || child->GetVisibility() == Visibility::Collapsed) {
+            continue;
+        }
+
+        Size desired = child->GetDesiredSize();
+        auto margin = child->GetMargin();
+        float crossPos = 0.0f;
+        float crossSize = 0.0f;
+
+        if (vertical) {
+            float available = std::max(0.0f, finalSize.width - margin.left - margin.right);
+            AlignSpan(available, desired.width, AlignMode(child->GetHorizontalAlignment()), crossPos, crossSize);
+            position += margin.top;
+            child->Arrange(Rect(margin.left + crossPos - static_cast<float>(crossOffset), position,
+                                crossSize, desired.height));
+            position += desired.height + margin.bottom;
+        } else {
+            float available = std::max(0.0f, finalSize.height - margin.top - margin.bottom);
+            AlignSpan(available, desired.height, AlignMode(child->GetVerticalAlignment()), crossPos, crossSize);
+            position += margin.left;
+            child->Arrange(Rect(position, margin.top + crossPos - static_cast<float>(crossOffset),
+                                desired.width, crossSize));
+            position += desired.width + margin.right;
+        }
+    }
+
+    return finalSize;
+}
+
+void VirtualizingStackPanel::OnRender(render::RenderContext& context) {
+    auto* solidBrush = dynamic_cast<SolidColorBrush*>(GetBackground());
+    if (!solidBrush) {
+        return;
+    }
+
+    auto color = solidBrush->GetColor();
+    auto layoutRect = GetLayoutRect();
+    auto cornerRadius = GetCornerRadius();
+    context.DrawBorder(Rect(0, 0, layoutRect.width, layoutRect.height),
+                       {{color.r, color.g, color.b, color.a}}, {{0.0f, 0.0f, 0.0f, 0.0f}}, 0.0f,
+                       cornerRadius.topLeft, cornerRadius.topRight,
+                       cornerRadius.bottomRight, cornerRadius.bottomLeft);
+}
+
+// ========== 容器实例化与回收 ==========
+
+UIElement* VirtualizingStackPanel::Realize(int index) {
+    // 传入集合内元素的引用：生成器以项的地址区分值类型项
+    const std::any& item = items_->GetItems()[static_cast<size_t>(index)];
+    bool isNew = false;
+    UIElement* container = generator_->GenerateContainer(item, isNew);
+    if (!container) {
+        return nullptr;
+    }
+
+    // 容器由生成器拥有，这里只加入可视树
+    AddVisualChild(container);
+    children_.push_back(container);
+
+    auto it = std::lower_bound(realized_.begin(), realized_.end(), index,
+                               [](const RealizedItem& realized, int i) { return realized.index < i; });
+    realized_.insert(it, RealizedItem{index, container});
+    return container;
+}
+
+void VirtualizingStackPanel::RecycleOutside(int first, int last) {
+    auto keep = std::remove_if(realized_.begin(), realized_.end(), [&](const RealizedItem& item) {
+        if (item.index >= first && item.index <= last) {
+            return false;
+        }
+        Recycle(item.container);
+        return true;
+    });
+    realized_.erase(keep, realized_.end());
+}
+
+void VirtualizingStackPanel::RecycleAll() {
+    for (const auto& item : realized_) {
+        Recycle(item.container);
+    }
+    realized_.clear();
+}
+
+void VirtualizingStackPanel::Recycle(UIElement* container) {
+    RemoveVisualChild(container);
+    std::erase(children_, container);
+    if (generator_) {
+        generator_->RecycleContainer(container);
+    }
+}
+
+float VirtualizingStackPanel::GetEstimatedItemSize() const {
+    return averageItemSize_ > 0.0f ? averageItemSize_ : kDefaultItemSize;
+}
+
+} // namespace fk::ui
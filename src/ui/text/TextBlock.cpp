@@ -7,17 +7,32 @@
 
 namespace fk::ui {
 
-// 全局 TextRenderer 实例（用?Measure 阶段的文本度量）
+// 全局 TextRenderer 实例（用于 Measure 阶段的文本度量）
 static render::TextRenderer* g_textRenderer = nullptr;
 
+// Phase 5.1: 全局字形度量来源（用于创建 TextLayout）
+static render::GlyphMetricsProvider* g_glyphMetrics = nullptr;
+
 void TextBlock::SetGlobalTextRenderer(render::TextRenderer* renderer) {
     g_textRenderer = renderer;
+    g_glyphMetrics = renderer;
 }
 
 render::TextRenderer* TextBlock::GetGlobalTextRenderer() {
     return g_textRenderer;
 }
 
+void TextBlock::SetGlobalGlyphMetrics(render::GlyphMetricsProvider* provider) {
+    g_glyphMetrics = provider;
+    if (g_textRenderer && static_cast<render::GlyphMetricsProvider*>(g_textRenderer) != provider) {
+        g_textRenderer = nullptr;
+    }
+}
+
+render::GlyphMetricsProvider* TextBlock::GetGlobalGlyphMetrics() {
+    return g_glyphMetrics;
+}
+
 // ========== 构造函?==========
 
 TextBlock::TextBlock() {
@@ -26,6 +41,14 @@ TextBlock::TextBlock() {
     SetVerticalAlignment(VerticalAlignment::Top);
 }
 
+// 影响排版的属性只在这里失效：Set 方法、绑定和样式都经过元数据回调，值未变化时不会调用
+static void OnLayoutPropertyChanged(binding::DependencyObject& d, const binding::DependencyProperty&,
+                                    const std::any&, const std::any&) {
+    auto& textBlock = static_cast<TextBlock&>(d);
+    textBlock.InvalidateMeasure();
+    textBlock.InvalidateVisual();
+}
+
 // ========== 依赖属性注?==========
 
 const binding::DependencyProperty& TextBlock::TextProperty() {
@@ -33,7 +56,9 @@ const binding::DependencyProperty& TextBlock::TextProperty() {
         "Text",
         typeid(std::string),
         typeid(TextBlock),
-        {std::string("")}
+        binding::PropertyMetadata{
+            .defaultValue = std::string(""),
+            .propertyChangedCallback = &OnLayoutPropertyChanged}
     );
     return property;
 }
@@ -43,7 +68,9 @@ const binding::DependencyProperty& TextBlock::FontFamilyProperty() {
         "FontFamily",
         typeid(std::string),
         typeid(TextBlock),
-        {std::string("Segoe UI")}  // Windows 默认字体，支持中英文
+        binding::PropertyMetadata{
+            .defaultValue = std::string("Segoe UI"),  // Windows 默认字体，支持中英文
+            .propertyChangedCallback = &OnLayoutPropertyChanged}
     );
     return property;
 }
@@ -53,7 +80,9 @@ const binding::DependencyProperty& TextBlock::FontSizeProperty() {
         "FontSize",
         typeid(float),
         typeid(TextBlock),
-        {12.0f}
+        binding::PropertyMetadata{
+            .defaultValue = 12.0f,
+            .propertyChangedCallback = &OnLayoutPropertyChanged}
     );
     return property;
 }
@@ -63,7 +92,9 @@ const binding::DependencyProperty& TextBlock::FontWeightProperty() {
         "FontWeight",
         typeid(ui::FontWeight),
         typeid(TextBlock),
-        {ui::FontWeight::Normal}
+        binding::PropertyMetadata{
+            .defaultValue = ui::FontWeight::Normal,
+            .propertyChangedCallback = &OnLayoutPropertyChanged}
     );
     return property;
 }
@@ -73,7 +104,9 @@ const binding::DependencyProperty& TextBlock::FontStyleProperty() {
         "FontStyle",
         typeid(ui::FontStyle),
         typeid(TextBlock),
-        {ui::FontStyle::Normal}
+        binding::PropertyMetadata{
+            .defaultValue = ui::FontStyle::Normal,
+            .propertyChangedCallback = &OnLayoutPropertyChanged}
     );
     return property;
 }
@@ -103,7 +136,9 @@ const binding::DependencyProperty& TextBlock::TextWrappingProperty() {
         "TextWrapping",
         typeid(ui::TextWrapping),
         typeid(TextBlock),
-        {ui::TextWrapping::NoWrap}
+        binding::PropertyMetadata{
+            .defaultValue = ui::TextWrapping::NoWrap,
+            .propertyChangedCallback = &OnLayoutPropertyChanged}
     );
     return property;
 }
@@ -111,101 +146,20 @@ const binding::DependencyProperty& TextBlock::TextWrappingProperty() {
 Size TextBlock::MeasureOverride(const Size& availableSize) {
     auto text = GetText();
     if (text.empty()) {
-        return Size(0, GetFontSize() * 1.2f); // 空文本返回一行高?
+        return Size(0, GetFontSize() * 1.2f); // 空文本返回一行高度
     }
     
     auto fontSize = GetFontSize();
-    auto fontFamily = GetFontFamily();
     auto textWrapping = GetTextWrapping();
     
-    // 获取全局 TextRenderer 进行精确测量
-    render::TextRenderer* textRenderer = GetGlobalTextRenderer();
-    
-    if (textRenderer) {
-        // 使用与渲染相同的字体查找逻辑
-        // 尝试加载跨平台字体路径列表中的第一个可用字?
-        int fontId = -1;
-        std::vector<std::string> fontPaths;
-        
-        #ifdef _WIN32
-            // Windows 字体路径
-            fontPaths = {
-                "C:/Windows/Fonts/msyh.ttc",      // 微软雅黑
-                "C:/Windows/Fonts/simhei.ttf",    // 黑体
-                "C:/Windows/Fonts/arial.ttf",     // Arial
-                "C:/Windows/Fonts/times.ttf"      // Times
-            };
-        #elif __APPLE__
-            // macOS 字体路径
-            fontPaths = {
-                "/System/Library/Fonts/PingFang.ttc",
-                "/System/Library/Fonts/Helvetica.ttc",
-                "/Library/Fonts/Arial Unicode.ttf"
-            };
-        #else
-            // Linux 字体路径
-            fontPaths = {
-                "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-                "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
-                "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc"
-            };
-        #endif
-        
-        // 尝试加载字体
-        unsigned int fontSizeKey = static_cast<unsigned int>(fontSize);
-        for (const auto& path : fontPaths) {
-            fontId = textRenderer->LoadFont(path, fontSizeKey);
-            if (fontId >= 0) {
-                break;
-            }
-        }
-        
-        // 如果都加载失败，尝试使用默认字体
-        if (fontId < 0) {
-            fontId = textRenderer->GetDefaultFont();
-        }
-        
-        // 检查字体是否加载成功（fontId >= 0 表示成功?
-        if (fontId >= 0) {
-            if (textWrapping == TextWrapping::Wrap && availableSize.width > 0) {
-                // 自动换行：使?MeasureTextMultiline
-                int measuredWidth = 0;
-                int measuredHeight = 0;
-                textRenderer->MeasureTextMultiline(
-                    text,
-                    fontId,
-                    availableSize.width,
-                    measuredWidth,
-                    measuredHeight
-                );
-                
-                // 确保测量结果有效
-                if (measuredHeight > 0) {
-                    return Size(static_cast<float>(measuredWidth), static_cast<float>(measuredHeight));
-                }
-            } else {
-                // 不换行：使用 MeasureText 单行测量
-                int measuredWidth = 0;
-                int measuredHeight = 0;
-                textRenderer->MeasureText(
-                    text,
-                    fontId,
-                    measuredWidth,
-                    measuredHeight
-                );
-                
-                // 确保测量结果有效
-                if (measuredHeight > 0) {
-                    // 如果有宽度限制且文本超宽，裁剪到可用宽度
-                    if (availableSize.width > 0 && measuredWidth > availableSize.width) {
-                        return Size(availableSize.width, static_cast<float>(measuredHeight));
-                    }
-                    
-                    return Size(static_cast<float>(measuredWidth), static_cast<float>(measuredHeight));
-                }
-            }
+    // Phase 5.1: 排版结果保存在元素上，绘制时直接复用（不再在渲染器中重新排版）
+    if (const auto& layout = EnsureTextLayout(availableSize.width)) {
+        float width = layout->GetWidth();
+        // 不换行时如果文本超宽，裁剪到可用宽度
+        if (textWrapping != TextWrapping::Wrap && availableSize.width > 0 && width > availableSize.width) {
+            width = availableSize.width;
         }
-        // 如果字体加载失败或测量返回无效结果，继续执行下面?fallback
+        return Size(width, layout->GetHeight());
     }
     
     // Fallback：使用简单估?
@@ -245,10 +199,7 @@ void TextBlock::OnRender(render::RenderContext& context) {
         return; // 空文本不绘制
     }
 
-    auto fontSize = GetFontSize();
-    auto fontFamily = GetFontFamily();
     auto textAlignment = GetTextAlignment();
-    auto textWrapping = GetTextWrapping();
     auto foreground = GetForeground();
     
     std::array<float, 4> textColor{{0.0f, 0.0f, 0.0f, 1.0f}}; // 默认黑色
@@ -265,20 +216,45 @@ void TextBlock::OnRender(render::RenderContext& context) {
 
     auto renderSize = GetRenderSize();
     
+    // 与测量使用同一排版结果；排列后的宽度改变了换行位置时才重新排版
+    const auto& layout = EnsureTextLayout(renderSize.width);
+    if (!layout) {
+        return;
+    }
+    
     // 使用renderSize作为绘制边界,防止文本超出范围
     ui::Rect bounds(0.0f, 0.0f, renderSize.width, renderSize.height);
-    float maxWidth = (textWrapping == TextWrapping::Wrap) ? renderSize.width : renderSize.width;
-    (void)textAlignment; // 对齐支持将在 RenderContext 中实?
+    (void)textAlignment; // 对齐支持将在 RenderContext 中实现
     
-    context.DrawText(
-        bounds,
-        text,
-        textColor,
-        fontSize,
-        fontFamily,
-        maxWidth,
-        textWrapping == TextWrapping::Wrap
-    );
+    context.DrawText(bounds, layout, textColor);
+}
+
+const std::shared_ptr<const render::TextLayout>& TextBlock::EnsureTextLayout(float maxWidth) {
+    auto* provider = GetGlobalGlyphMetrics();
+    if (!provider) {
+        textLayout_.reset();
+        return textLayout_;
+    }
+    
+    auto text = GetText();
+    auto fontSize = GetFontSize();
+    auto fontFamily = GetFontFamily();
+    const bool wrapped = GetTextWrapping() == TextWrapping::Wrap && maxWidth > 0.0f;
+    
+    const int fontId = provider->ResolveFont(fontFamily, fontSize, static_cast<int>(GetFontWeight()),
+                                             GetFontStyle() != ui::FontStyle::Normal);
+    if (fontId < 0) {
+        textLayout_.reset();
+        return textLayout_;
+    }
+    
+    if (textLayout_ && textLayout_->Matches(*provider, fontId, text, fontSize, wrapped) &&
+        textLayout_->FitsWidth(maxWidth)) {
+        return textLayout_;
+    }
+    
+    textLayout_ = render::TextLayout::Create(*provider, fontId, fontFamily, text, fontSize, wrapped ? maxWidth : 0.0f);
+    return textLayout_;
 }
 
 } // namespace fk::ui
@@ -1,5 +1,6 @@
 #include "fk/ui/window/PopupRoot.h"
 #include "fk/ui/base/UIElement.h"
+#include "fk/ui/base/LayoutManager.h"
 #include "fk/render/GlRenderer.h"
 #include "fk/render/RenderList.h"
 #include "fk/render/RenderContext.h"
@@ -378,6 +379,7 @@ void PopupRoot::RenderFrame() {
         auto availableSize = Size(static_cast<float>(width), static_cast<float>(height));
         content_->Measure(availableSize);
         content_->Arrange(Rect(0, 0, static_cast<float>(width), static_cast<float>(height)));
+        LayoutManager::Instance().UpdateLayout();
         
         // 收集绘制命令
         content_->CollectDrawCommands(context);